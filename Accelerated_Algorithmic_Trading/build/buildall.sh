@@ -67,6 +67,11 @@ make clean
 make all
 popd
 
+pushd ${BASE_DIR}/../hw/riskEngine
+make clean
+make all
+popd
+
 pushd ${BASE_DIR}/../hw/orderEntry
 make clean
 make all
@@ -88,3 +93,21 @@ pushd ${BASE_DIR}/../sw/applications/aat/aat_shell_exe
 make clean
 make all
 popd
+
+# software feed decoder benchmark
+pushd ${BASE_DIR}/../sw/applications/aat/aat_feed_decoder_bench
+make clean
+make all
+popd
+
+# capture segment extraction tool
+pushd ${BASE_DIR}/../sw/applications/aat/aat_capture_extract
+make clean
+make all
+popd
+
+# software shell with emulated kernels
+pushd ${BASE_DIR}/../sw/applications/aat/aat_shell_emu
+make clean
+make all
+popd
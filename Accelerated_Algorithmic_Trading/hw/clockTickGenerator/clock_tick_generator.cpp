@@ -27,17 +27,22 @@ void ClockTickGenerator::tickProcess(ap_uint<32> &regControl,
                                      ap_uint<32> &regInterval02,
                                      ap_uint<32> &regInterval03,
                                      ap_uint<32> &regInterval04,
+                                     ap_uint<32> &regInterval05,
                                      ap_uint<32> &regTickCount,
                                      ap_uint<32> &regTxCount00,
                                      ap_uint<32> &regTxCount01,
                                      ap_uint<32> &regTxCount02,
                                      ap_uint<32> &regTxCount03,
                                      ap_uint<32> &regTxCount04,
+                                     ap_uint<32> &regTxCount05,
                                      hls::stream<clockTickGeneratorEvent_t> &eventStream00,
                                      hls::stream<clockTickGeneratorEvent_t> &eventStream01,
                                      hls::stream<clockTickGeneratorEvent_t> &eventStream02,
                                      hls::stream<clockTickGeneratorEvent_t> &eventStream03,
-                                     hls::stream<clockTickGeneratorEvent_t> &eventStream04)
+                                     hls::stream<clockTickGeneratorEvent_t> &eventStream04,
+                                     hls::stream<clockTickGeneratorEvent_t> &eventStream05,
+                                     ap_uint<32> &regTimerDrop,
+                                     hls::stream<clockTickGeneratorTimer_t> &timerEventStream)
 
 {
 #pragma HLS PIPELINE II=1 style=flp
@@ -47,6 +52,12 @@ void ClockTickGenerator::tickProcess(ap_uint<32> &regControl,
     clockTickGeneratorEvent_t eventTick02;
     clockTickGeneratorEvent_t eventTick03;
     clockTickGeneratorEvent_t eventTick04;
+    clockTickGeneratorEvent_t eventTick05;
+    clockTickGeneratorEvent_t eventTimer;
+    clockTickGeneratorTimerEvent_t timerEventData;
+    mmInterface intf;
+    bool tickFired[CTG_NUM_TARGET] = {false, false, false, false, false, false};
+#pragma HLS ARRAY_PARTITION variable=tickFired complete
 
     static ap_uint<32> freeCount = 0;
     static ap_uint<32> tickCount00 = 0;
@@ -54,19 +65,32 @@ void ClockTickGenerator::tickProcess(ap_uint<32> &regControl,
     static ap_uint<32> tickCount02 = 0;
     static ap_uint<32> tickCount03 = 0;
     static ap_uint<32> tickCount04 = 0;
+    static ap_uint<32> tickCount05 = 0;
     static ap_uint<32> txCount00 = 0;
     static ap_uint<32> txCount01 = 0;
     static ap_uint<32> txCount02 = 0;
     static ap_uint<32> txCount03 = 0;
     static ap_uint<32> txCount04 = 0;
+    static ap_uint<32> txCount05 = 0;
+    static ap_uint<32> timerDrop = 0;
+    static clockTickGeneratorTimer_t timerEvent;
+    static bool timerPending = false;
+
+    // timer wheel events share the per kernel event streams with the periodic
+    // ticks, a single expired timer is held here until its stream is free
+    if(!timerPending && !timerEventStream.empty())
+    {
+        timerEvent = timerEventStream.read();
+        timerPending = true;
+    }
 
     if(TICK_ENABLE_00 & regControl)
     {
         if(tickCount00 == regInterval00)
         {
-            // TODO: add enocoding for different event types?
-            eventTick00.data = 1;
+            eventTick00.data = CTG_EVENT_TICK;
             eventStream00.write(eventTick00);
+            tickFired[0] = true;
             tickCount00 = 0;
             ++txCount00;
         }
@@ -84,8 +108,9 @@ void ClockTickGenerator::tickProcess(ap_uint<32> &regControl,
     {
         if(tickCount01 == regInterval01)
         {
-            eventTick01.data = 1;
+            eventTick01.data = CTG_EVENT_TICK;
             eventStream01.write(eventTick01);
+            tickFired[1] = true;
             tickCount01 = 0;
             ++txCount01;
         }
@@ -103,8 +128,9 @@ void ClockTickGenerator::tickProcess(ap_uint<32> &regControl,
     {
         if(tickCount02 == regInterval02)
         {
-            eventTick02.data = 1;
+            eventTick02.data = CTG_EVENT_TICK;
             eventStream02.write(eventTick02);
+            tickFired[2] = true;
             tickCount02 = 0;
             ++txCount02;
         }
@@ -122,8 +148,9 @@ void ClockTickGenerator::tickProcess(ap_uint<32> &regControl,
     {
         if(tickCount03 == regInterval03)
         {
-            eventTick03.data = 1;
+            eventTick03.data = CTG_EVENT_TICK;
             eventStream03.write(eventTick03);
+            tickFired[3] = true;
             tickCount03 = 0;
             ++txCount03;
         }
@@ -139,10 +166,11 @@ void ClockTickGenerator::tickProcess(ap_uint<32> &regControl,
 
     if(TICK_ENABLE_04 & regControl)
     {
-        if(tickCount04 == regInterval03)
+        if(tickCount04 == regInterval04)
         {
-            eventTick04.data = 1;
+            eventTick04.data = CTG_EVENT_TICK;
             eventStream04.write(eventTick04);
+            tickFired[4] = true;
             tickCount04 = 0;
             ++txCount04;
         }
@@ -156,12 +184,200 @@ void ClockTickGenerator::tickProcess(ap_uint<32> &regControl,
         tickCount04 = 0;
     }
 
+    if(TICK_ENABLE_05 & regControl)
+    {
+        if(tickCount05 == regInterval05)
+        {
+            eventTick05.data = CTG_EVENT_TICK;
+            eventStream05.write(eventTick05);
+            tickFired[5] = true;
+            tickCount05 = 0;
+            ++txCount05;
+        }
+        else
+        {
+            ++tickCount05;
+        }
+    }
+    else
+    {
+        tickCount05 = 0;
+    }
+
+    // forward held timer event unless a periodic tick has just been issued on
+    // the target stream, events addressed to an unknown target are dropped
+    if(timerPending)
+    {
+        timerEventData.timerIndex = timerEvent.timerIndex;
+        timerEventData.eventCode = timerEvent.eventCode;
+        timerEventData.symbolIndex = timerEvent.symbolIndex;
+        intf.clockTickGeneratorEventPack(&timerEventData, &eventTimer);
+
+        if(timerEvent.target >= CTG_NUM_TARGET)
+        {
+            ++timerDrop;
+            timerPending = false;
+        }
+        else if(!tickFired[timerEvent.target])
+        {
+            switch(timerEvent.target)
+            {
+                case(CTG_TARGET_FEED_HANDLER):
+                    eventStream00.write(eventTimer);
+                    break;
+                case(CTG_TARGET_ORDER_BOOK):
+                    eventStream01.write(eventTimer);
+                    break;
+                case(CTG_TARGET_PRICING_ENGINE):
+                    eventStream02.write(eventTimer);
+                    break;
+                case(CTG_TARGET_ORDER_ENTRY):
+                    eventStream03.write(eventTimer);
+                    break;
+                case(CTG_TARGET_LINE_HANDLER):
+                    eventStream04.write(eventTimer);
+                    break;
+                default:
+                    eventStream05.write(eventTimer);
+                    break;
+            }
+            timerPending = false;
+        }
+    }
+
     regTickCount = ++freeCount;
     regTxCount00 = txCount00;
     regTxCount01 = txCount01;
     regTxCount02 = txCount02;
     regTxCount03 = txCount03;
     regTxCount04 = txCount04;
+    regTxCount05 = txCount05;
+    regTimerDrop = timerDrop;
+
+    return;
+}
+
+void ClockTickGenerator::timerProcess(ap_uint<32> &regTimerInterval,
+                                      ap_uint<32> &regTimerConfig,
+                                      ap_uint<32> &regTimerArm,
+                                      ap_uint<32> &regTimerCancel,
+                                      ap_uint<32> &regTimerFire,
+                                      hls::stream<clockTickGeneratorTimerPack_t> &timerArmStreamPack,
+                                      hls::stream<clockTickGeneratorTimer_t> &timerEventStream)
+{
+#pragma HLS PIPELINE II=1 style=flp
+
+    mmInterface intf;
+    clockTickGeneratorTimerPack_t timerPack;
+    clockTickGeneratorTimer_t timer;
+    clockTickGeneratorTimer_t timerExpired;
+    clockTickGeneratorTimerEntry_t entry;
+    clockTickGeneratorTimerEntry_t armEntry;
+    clockTickGeneratorTimerState_t state;
+    bool armValid=false;
+
+    static ap_uint<48> cycleCount=0;
+    static ap_uint<32> armSequence=0;
+    static ap_uint<CTG_TIMER_INDEX_WIDTH> cursor=0;
+    static ap_uint<1> strobeLast=0;
+    static ap_uint<32> countArm=0;
+    static ap_uint<32> countCancel=0;
+    static ap_uint<32> countFire=0;
+
+// configuration is written by the arm port and read by the sweep, expiry state
+// is read and written by the sweep only, one read and one write port each
+#pragma HLS BIND_STORAGE variable=timerTable type=ram_2p
+#pragma HLS BIND_STORAGE variable=timerState type=ram_2p
+#pragma HLS DEPENDENCE variable=timerTable inter false
+#pragma HLS DEPENDENCE variable=timerState inter false
+
+    // sweep, the slot under the cursor fires once the cycle count reaches its
+    // deadline, periodic timers move their deadline on by a whole period so
+    // lateness on one expiry does not carry into the next
+    entry = timerTable[cursor];
+    state = timerState[cursor];
+
+    if(state.sequence != entry.sequence)
+    {
+        state.deadline = entry.deadline;
+        state.sequence = entry.sequence;
+        state.expired = 0;
+    }
+
+    if(entry.active && !state.expired && ((ap_int<48>)(cycleCount - state.deadline) >= 0))
+    {
+        timerExpired.interval = entry.period;
+        timerExpired.timerIndex = cursor;
+        timerExpired.eventCode = entry.eventCode;
+        timerExpired.symbolIndex = entry.symbolIndex;
+        timerExpired.target = entry.target;
+        timerExpired.periodic = entry.periodic;
+        timerExpired.arm = entry.periodic;
+        timerEventStream.write(timerExpired);
+        ++countFire;
+
+        if(entry.periodic)
+        {
+            state.deadline = state.deadline + ((ap_uint<48>)(entry.period + 1) << CTG_TIMER_INDEX_WIDTH);
+        }
+        else
+        {
+            state.expired = 1;
+        }
+
+        timerState[cursor] = state;
+    }
+
+    ++cursor;
+
+    // arm/cancel requests are accepted from host (strobe toggle) with priority
+    // over requests streamed from other kernels, timer index selects the slot
+    if(regTimerConfig.range(31,31) != strobeLast)
+    {
+        strobeLast = regTimerConfig.range(31,31);
+
+        timerPack.data.range(63,32) = regTimerConfig;
+        timerPack.data.range(31,0) = regTimerInterval;
+        intf.clockTickGeneratorTimerUnpack(&timerPack, &timer);
+        armValid = true;
+    }
+    else if(!timerArmStreamPack.empty())
+    {
+        timerPack = timerArmStreamPack.read();
+        intf.clockTickGeneratorTimerUnpack(&timerPack, &timer);
+        armValid = true;
+    }
+
+    if(armValid)
+    {
+        // a new sequence number marks the expiry state held by the sweep for
+        // this slot as stale, the sweep picks up the new deadline on its visit
+        ++armSequence;
+        armEntry.deadline = cycleCount + ((ap_uint<48>)timer.interval << CTG_TIMER_INDEX_WIDTH);
+        armEntry.period = timer.interval;
+        armEntry.sequence = armSequence;
+        armEntry.eventCode = timer.eventCode;
+        armEntry.symbolIndex = timer.symbolIndex;
+        armEntry.target = timer.target;
+        armEntry.periodic = timer.periodic;
+        armEntry.active = timer.arm;
+        timerTable[timer.timerIndex.range(CTG_TIMER_INDEX_WIDTH-1,0)] = armEntry;
+
+        if(timer.arm)
+        {
+            ++countArm;
+        }
+        else
+        {
+            ++countCancel;
+        }
+    }
+
+    ++cycleCount;
+
+    regTimerArm = countArm;
+    regTimerCancel = countCancel;
+    regTimerFire = countFire;
 
     return;
 }
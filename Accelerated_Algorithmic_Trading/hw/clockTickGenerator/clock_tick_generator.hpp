@@ -22,12 +22,33 @@
 #include "aat_defines.hpp"
 #include "aat_interfaces.hpp"
 
+#define TICK_ENABLE_05  (1<<5)
 #define TICK_ENABLE_04  (1<<4)
 #define TICK_ENABLE_03  (1<<3)
 #define TICK_ENABLE_02  (1<<2)
 #define TICK_ENABLE_01  (1<<1)
 #define TICK_ENABLE_00  (1<<0)
 
+// timer wheel, the sweep visits one timer slot per clock cycle so a single
+// revolution of the wheel (and the timer resolution) is CTG_NUM_TIMER cycles,
+// timer intervals are programmed as a number of revolutions
+//
+// arm requests are written through a port of their own and never stall the
+// sweep, so every slot is visited exactly once per revolution whatever the arm
+// load, expiry is held as an absolute cycle deadline and a timer fires on the
+// first visit at or after its deadline, an interval of N revolutions fires
+// between N and N+1 revolutions after the arm and periodic timers repeat every
+// N+1 revolutions from the first expiry without accumulating slip, worst case
+// lateness against the deadline is one revolution (CTG_NUM_TIMER cycles) plus
+// any backpressure from the event streams
+#define CTG_NUM_TIMER           (512)
+#define CTG_TIMER_INDEX_WIDTH   (9)
+#define CTG_NUM_TARGET          (6)
+
+// host timer arm port, host sets interval and config fields then toggles
+// strobe, kernel applies the request on detection of the toggle
+#define CTG_TIMER_ARM_STROBE    (1<<31)
+
 // TODO: typically use a struct for control/status registers, this might be an
 //       instance where it's better to use seperate arrays for intervals and
 //       thresholds and use a single define to set the number of timers
@@ -39,7 +60,7 @@ typedef struct clockTickGeneratorRegControl_t
     ap_uint<32> interval02;
     ap_uint<32> interval03;
     ap_uint<32> interval04;
-    ap_uint<32> reserved06;
+    ap_uint<32> interval05;
     ap_uint<32> reserved07;
 } clockTickGeneratorRegControl_t;
 
@@ -52,12 +73,49 @@ typedef struct clockTickGeneratorRegStatus_t
     ap_uint<32> txCount02;
     ap_uint<32> txCount03;
     ap_uint<32> txCount04;
-    ap_uint<32> reserved07;
+    ap_uint<32> txCount05;
 } clockTickGeneratorRegStatus_t;
 
 /**
  * ClockTickGenerator Core
  */
+typedef struct clockTickGeneratorRegTimerControl_t
+{
+    ap_uint<32> interval;   // revolutions until expiry (and period if periodic)
+    ap_uint<32> config;     // [7:0] code, [15:8] symbol, [19:16] target,
+                            // [20] periodic, [21] arm, [30:22] timer, [31] strobe
+} clockTickGeneratorRegTimerControl_t;
+
+typedef struct clockTickGeneratorRegTimerStatus_t
+{
+    ap_uint<32> armCount;
+    ap_uint<32> cancelCount;
+    ap_uint<32> fireCount;
+    ap_uint<32> dropCount;
+} clockTickGeneratorRegTimerStatus_t;
+
+// timer configuration, written by the arm port only
+typedef struct clockTickGeneratorTimerEntry_t
+{
+    ap_uint<48> deadline;   // cycle of first expiry
+    ap_uint<32> period;     // revolutions
+    ap_uint<32> sequence;   // arm request this entry was written by
+    ap_uint<8>  eventCode;
+    ap_uint<8>  symbolIndex;
+    ap_uint<4>  target;
+    ap_uint<1>  periodic;
+    ap_uint<1>  active;
+} clockTickGeneratorTimerEntry_t;
+
+// timer expiry state, written by the sweep only, stale once the entry has
+// been re-armed with a new sequence
+typedef struct clockTickGeneratorTimerState_t
+{
+    ap_uint<48> deadline;   // cycle of next expiry
+    ap_uint<32> sequence;
+    ap_uint<1>  expired;    // one-shot timer has fired
+} clockTickGeneratorTimerState_t;
+
 class ClockTickGenerator
 {
 public:
@@ -68,20 +126,36 @@ public:
                      ap_uint<32> &regInterval02,
                      ap_uint<32> &regInterval03,
                      ap_uint<32> &regInterval04,
+                     ap_uint<32> &regInterval05,
                      ap_uint<32> &regTickCount,
                      ap_uint<32> &regTxCount00,
                      ap_uint<32> &regTxCount01,
                      ap_uint<32> &regTxCount02,
                      ap_uint<32> &regTxCount03,
                      ap_uint<32> &regTxCount04,
+                     ap_uint<32> &regTxCount05,
                      hls::stream<clockTickGeneratorEvent_t> &eventStream00,
                      hls::stream<clockTickGeneratorEvent_t> &eventStream01,
                      hls::stream<clockTickGeneratorEvent_t> &eventStream02,
                      hls::stream<clockTickGeneratorEvent_t> &eventStream03,
-                     hls::stream<clockTickGeneratorEvent_t> &eventStream04);
+                     hls::stream<clockTickGeneratorEvent_t> &eventStream04,
+                     hls::stream<clockTickGeneratorEvent_t> &eventStream05,
+                     ap_uint<32> &regTimerDrop,
+                     hls::stream<clockTickGeneratorTimer_t> &timerEventStream);
+
+    void timerProcess(ap_uint<32> &regTimerInterval,
+                      ap_uint<32> &regTimerConfig,
+                      ap_uint<32> &regTimerArm,
+                      ap_uint<32> &regTimerCancel,
+                      ap_uint<32> &regTimerFire,
+                      hls::stream<clockTickGeneratorTimerPack_t> &timerArmStreamPack,
+                      hls::stream<clockTickGeneratorTimer_t> &timerEventStream);
 
 private:
 
+    clockTickGeneratorTimerEntry_t timerTable[CTG_NUM_TIMER];
+    clockTickGeneratorTimerState_t timerState[CTG_NUM_TIMER];
+
 };
 
 #endif
@@ -25,6 +25,10 @@ extern "C" void clockTickGeneratorTop(clockTickGeneratorRegControl_t &regControl
                                       hls::stream<clockTickGeneratorEvent_t> &eventStream01,
                                       hls::stream<clockTickGeneratorEvent_t> &eventStream02,
                                       hls::stream<clockTickGeneratorEvent_t> &eventStream03,
-                                      hls::stream<clockTickGeneratorEvent_t> &eventStream04);
+                                      hls::stream<clockTickGeneratorEvent_t> &eventStream04,
+                                      hls::stream<clockTickGeneratorEvent_t> &eventStream05,
+                                      clockTickGeneratorRegTimerControl_t &regTimerControl,
+                                      clockTickGeneratorRegTimerStatus_t &regTimerStatus,
+                                      hls::stream<clockTickGeneratorTimerPack_t> &timerArmStreamPack);
 
 #endif
@@ -23,40 +23,67 @@ extern "C" void clockTickGeneratorTop(clockTickGeneratorRegControl_t &regControl
                                       hls::stream<clockTickGeneratorEvent_t> &eventStream01,
                                       hls::stream<clockTickGeneratorEvent_t> &eventStream02,
                                       hls::stream<clockTickGeneratorEvent_t> &eventStream03,
-                                      hls::stream<clockTickGeneratorEvent_t> &eventStream04)
+                                      hls::stream<clockTickGeneratorEvent_t> &eventStream04,
+                                      hls::stream<clockTickGeneratorEvent_t> &eventStream05,
+                                      clockTickGeneratorRegTimerControl_t &regTimerControl,
+                                      clockTickGeneratorRegTimerStatus_t &regTimerStatus,
+                                      hls::stream<clockTickGeneratorTimerPack_t> &timerArmStreamPack)
 {
 #pragma HLS INTERFACE s_axilite port=regControl bundle=control
 #pragma HLS INTERFACE s_axilite port=regStatus bundle=control
 #pragma HLS INTERFACE ap_none port=regControl
 #pragma HLS INTERFACE ap_none port=regStatus
+#pragma HLS INTERFACE s_axilite port=regTimerControl bundle=control
+#pragma HLS INTERFACE s_axilite port=regTimerStatus bundle=control
+#pragma HLS INTERFACE ap_none port=regTimerControl
+#pragma HLS INTERFACE ap_none port=regTimerStatus
 #pragma HLS INTERFACE axis port=eventStream00
 #pragma HLS INTERFACE axis port=eventStream01
 #pragma HLS INTERFACE axis port=eventStream02
 #pragma HLS INTERFACE axis port=eventStream03
 #pragma HLS INTERFACE axis port=eventStream04
+#pragma HLS INTERFACE axis port=eventStream05
+#pragma HLS INTERFACE axis port=timerArmStreamPack
 #pragma HLS INTERFACE ap_ctrl_none port=return
 
+    static hls::stream<clockTickGeneratorTimer_t> timerEventStreamFIFO;
     static ClockTickGenerator kernel;
 
+#pragma HLS STREAM variable=timerEventStreamFIFO depth=4
 #pragma HLS STABLE variable=regControl
+#pragma HLS DISAGGREGATE variable=regTimerControl
+#pragma HLS DISAGGREGATE variable=regTimerStatus
 #pragma HLS DATAFLOW disable_start_propagation
 
+    kernel.timerProcess(regTimerControl.interval,
+                        regTimerControl.config,
+                        regTimerStatus.armCount,
+                        regTimerStatus.cancelCount,
+                        regTimerStatus.fireCount,
+                        timerArmStreamPack,
+                        timerEventStreamFIFO);
+
     kernel.tickProcess(regControl.control,
                        regControl.interval00,
                        regControl.interval01,
                        regControl.interval02,
                        regControl.interval03,
                        regControl.interval04,
+                       regControl.interval05,
                        regStatus.tickCount,
                        regStatus.txCount00,
                        regStatus.txCount01,
                        regStatus.txCount02,
                        regStatus.txCount03,
                        regStatus.txCount04,
+                       regStatus.txCount05,
                        eventStream00,
                        eventStream01,
                        eventStream02,
                        eventStream03,
-                       eventStream04);
+                       eventStream04,
+                       eventStream05,
+                       regTimerStatus.dropCount,
+                       timerEventStreamFIFO);
 
 }
@@ -0,0 +1,123 @@
+/*
+ * Copyright 2021 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+
+#include "clock_tick_generator_kernels.hpp"
+#include "aat_bench.hpp"
+
+// arm requests have a port of their own so one is offered every call, calls
+// made after the last request let the sweep reach every armed timer
+#define BENCH_DRAIN_CALLS  (2*CTG_NUM_TIMER)
+
+static AatBench bench("clockTickGenerator", 1000000);
+
+static clockTickGeneratorRegControl_t regControl={0};
+static clockTickGeneratorRegStatus_t regStatus={0};
+static clockTickGeneratorRegTimerControl_t regTimerControl={0};
+static clockTickGeneratorRegTimerStatus_t regTimerStatus={0};
+
+static hls::stream<clockTickGeneratorEvent_t> eventStreamFIFO[CTG_NUM_TARGET];
+static hls::stream<clockTickGeneratorTimerPack_t> timerArmStreamPackFIFO;
+
+static void clockTickGeneratorCall(void)
+{
+    mmInterface intf;
+    clockTickGeneratorEvent_t event;
+    clockTickGeneratorTimerEvent_t timerEvent;
+
+    clockTickGeneratorTop(regControl,
+                          regStatus,
+                          eventStreamFIFO[0],
+                          eventStreamFIFO[1],
+                          eventStreamFIFO[2],
+                          eventStreamFIFO[3],
+                          eventStreamFIFO[4],
+                          eventStreamFIFO[5],
+                          regTimerControl,
+                          regTimerStatus,
+                          timerArmStreamPackFIFO);
+    bench.call();
+
+    // ticks are not counted, only timer events delivered
+    for(int i=0; i<CTG_NUM_TARGET; i++)
+    {
+        while(!eventStreamFIFO[i].empty())
+        {
+            event = eventStreamFIFO[i].read();
+            intf.clockTickGeneratorEventUnpack(&event, &timerEvent);
+
+            if(CTG_EVENT_TICK != timerEvent.eventCode)
+            {
+                bench.output();
+            }
+        }
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    mmInterface intf;
+    clockTickGeneratorTimer_t timer;
+    clockTickGeneratorTimerPack_t timerPack;
+    uint64_t sequence=0;
+
+    if(!bench.parseArgs(argc, argv))
+    {
+        return 1;
+    }
+
+    // periodic tick on first stream running alongside the timer wheel
+    regControl.control = TICK_ENABLE_00;
+    regControl.interval00 = 99;
+
+    bench.start();
+
+    while(bench.running())
+    {
+        // one-shot cancel timers armed from stream as PricingEngine would,
+        // walking the wheel so each slot has expired before it is reused
+        timer.interval = 0;
+        timer.timerIndex = (sequence % CTG_NUM_TIMER);
+        timer.eventCode = CTG_EVENT_ORDER_CANCEL;
+        timer.symbolIndex = (sequence % NUM_SYMBOL);
+        timer.target = (sequence % CTG_NUM_TARGET);
+        timer.periodic = 0;
+        timer.arm = 1;
+        intf.clockTickGeneratorTimerPack(&timer, &timerPack);
+        timerArmStreamPackFIFO.write(timerPack);
+        bench.event();
+        ++sequence;
+
+        clockTickGeneratorCall();
+    }
+
+    for(int i=0; i<BENCH_DRAIN_CALLS; i++)
+    {
+        clockTickGeneratorCall();
+    }
+
+    bench.stop();
+
+    while(!timerArmStreamPackFIFO.empty())
+    {
+        timerArmStreamPackFIFO.read();
+    }
+
+    return bench.report();
+}
@@ -0,0 +1,233 @@
+/*
+ * Copyright 2021 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+
+#include "clock_tick_generator_kernels.hpp"
+
+#define NUM_TEST_REVOLUTION_CTG (4)
+#define NUM_TEST_BURST_SLOT_CTG (64)
+
+static clockTickGeneratorRegControl_t regControl={0};
+static clockTickGeneratorRegStatus_t regStatus={0};
+static clockTickGeneratorRegTimerControl_t regTimerControl={0};
+static clockTickGeneratorRegTimerStatus_t regTimerStatus={0};
+
+static hls::stream<clockTickGeneratorEvent_t> eventStreamFIFO[CTG_NUM_TARGET];
+static hls::stream<clockTickGeneratorTimerPack_t> timerArmStreamPackFIFO;
+
+static int numTick[CTG_NUM_TARGET];
+static int numTimer[CTG_NUM_TARGET];
+static int numCall=0;
+static int timerFireCall[CTG_NUM_TIMER];
+
+static void clockTickGeneratorCall(void)
+{
+    mmInterface intf;
+    clockTickGeneratorEvent_t event;
+    clockTickGeneratorTimerEvent_t timerEvent;
+
+    ++numCall;
+    clockTickGeneratorTop(regControl,
+                          regStatus,
+                          eventStreamFIFO[0],
+                          eventStreamFIFO[1],
+                          eventStreamFIFO[2],
+                          eventStreamFIFO[3],
+                          eventStreamFIFO[4],
+                          eventStreamFIFO[5],
+                          regTimerControl,
+                          regTimerStatus,
+                          timerArmStreamPackFIFO);
+
+    for(int i=0; i<CTG_NUM_TARGET; i++)
+    {
+        while(!eventStreamFIFO[i].empty())
+        {
+            event = eventStreamFIFO[i].read();
+            intf.clockTickGeneratorEventUnpack(&event, &timerEvent);
+
+            if(CTG_EVENT_TICK == timerEvent.eventCode)
+            {
+                ++numTick[i];
+            }
+            else
+            {
+                ++numTimer[i];
+                if(0 == timerFireCall[timerEvent.timerIndex])
+                {
+                    timerFireCall[timerEvent.timerIndex] = numCall;
+                }
+                std::cout << "TIMER_EVENT[" << i << "]: {"
+                          << timerEvent.timerIndex << ","
+                          << timerEvent.eventCode << ","
+                          << timerEvent.symbolIndex << "}"
+                          << std::endl;
+            }
+        }
+    }
+}
+
+static void clockTickGeneratorTimerWrite(ap_uint<9> timerIndex,
+                                         ap_uint<32> interval,
+                                         ap_uint<4> target,
+                                         ap_uint<8> symbolIndex,
+                                         ap_uint<8> eventCode,
+                                         ap_uint<1> periodic,
+                                         ap_uint<1> arm)
+{
+    ap_uint<32> strobe = (regTimerControl.config & CTG_TIMER_ARM_STROBE) ^ CTG_TIMER_ARM_STROBE;
+
+    regTimerControl.interval = interval;
+    regTimerControl.config = strobe |
+                             ((ap_uint<32>)timerIndex << 22) |
+                             ((ap_uint<32>)arm << 21) |
+                             ((ap_uint<32>)periodic << 20) |
+                             ((ap_uint<32>)target << 16) |
+                             ((ap_uint<32>)symbolIndex << 8) |
+                             eventCode;
+    clockTickGeneratorCall();
+}
+
+int main()
+{
+    mmInterface intf;
+    clockTickGeneratorTimer_t timer;
+    clockTickGeneratorTimerPack_t timerPack;
+    bool testPassed=true;
+    int armCall=0;
+    int fireDelay=0;
+
+    std::cout << "ClockTickGenerator Test" << std::endl;
+    std::cout << "-----------------------" << std::endl;
+
+    // periodic tick on first stream only
+    regControl.control = TICK_ENABLE_00;
+    regControl.interval00 = 99;
+
+    // one-shot quote refresh to pricing engine armed from host, expires on the
+    // second visit of the sweep to its slot
+    clockTickGeneratorTimerWrite(5, 1, CTG_TARGET_PRICING_ENGINE, 7, CTG_EVENT_QUOTE_REFRESH, 0, 1);
+
+    // periodic cancel to risk engine armed from stream, expires every visit
+    timer.interval = 0;
+    timer.timerIndex = 300;
+    timer.eventCode = CTG_EVENT_ORDER_CANCEL;
+    timer.symbolIndex = 3;
+    timer.target = CTG_TARGET_RISK_ENGINE;
+    timer.periodic = 1;
+    timer.arm = 1;
+    intf.clockTickGeneratorTimerPack(&timer, &timerPack);
+    timerArmStreamPackFIFO.write(timerPack);
+
+    for(int i=0; i<(NUM_TEST_REVOLUTION_CTG * CTG_NUM_TIMER); i++)
+    {
+        clockTickGeneratorCall();
+    }
+
+    // cancel periodic timer, no further events expected
+    clockTickGeneratorTimerWrite(300, 0, CTG_TARGET_RISK_ENGINE, 0, CTG_EVENT_NONE, 0, 0);
+
+    for(int i=0; i<(NUM_TEST_REVOLUTION_CTG * CTG_NUM_TIMER); i++)
+    {
+        clockTickGeneratorCall();
+    }
+
+    if(1 != numTimer[CTG_TARGET_PRICING_ENGINE])
+    {
+        std::cout << "ERROR: expected single one-shot timer event" << std::endl;
+        testPassed = false;
+    }
+
+    if(NUM_TEST_REVOLUTION_CTG != numTimer[CTG_TARGET_RISK_ENGINE])
+    {
+        std::cout << "ERROR: expected periodic timer event each revolution until cancelled" << std::endl;
+        testPassed = false;
+    }
+
+    if((0 == numTick[CTG_TARGET_FEED_HANDLER]) || (0 != numTick[CTG_TARGET_ORDER_BOOK]))
+    {
+        std::cout << "ERROR: periodic tick not confined to enabled stream" << std::endl;
+        testPassed = false;
+    }
+
+    // one-shot and periodic timers armed ahead of a sustained burst of arm
+    // requests to other slots, one request is accepted every cycle for the
+    // whole run and expiry must still land inside its revolution
+    clockTickGeneratorTimerWrite(100, 2, CTG_TARGET_ORDER_ENTRY, 1, CTG_EVENT_ORDER_CANCEL, 0, 1);
+    armCall = numCall;
+    clockTickGeneratorTimerWrite(101, 0, CTG_TARGET_LINE_HANDLER, 2, CTG_EVENT_QUOTE_REFRESH, 1, 1);
+
+    timer.interval = 1000;
+    timer.eventCode = CTG_EVENT_ORDER_CANCEL;
+    timer.target = CTG_TARGET_RISK_ENGINE;
+    timer.periodic = 0;
+    timer.arm = 1;
+
+    for(int i=0; i<(NUM_TEST_REVOLUTION_CTG * CTG_NUM_TIMER); i++)
+    {
+        timer.timerIndex = 200 + (i % NUM_TEST_BURST_SLOT_CTG);
+        timer.symbolIndex = i;
+        intf.clockTickGeneratorTimerPack(&timer, &timerPack);
+        timerArmStreamPackFIFO.write(timerPack);
+        clockTickGeneratorCall();
+    }
+
+    clockTickGeneratorTimerWrite(101, 0, CTG_TARGET_LINE_HANDLER, 0, CTG_EVENT_NONE, 0, 0);
+
+    // interval of 2 revolutions fires between 2 and 3 revolutions after the
+    // arm, allowing a couple of calls for the event to reach the output
+    fireDelay = timerFireCall[100] - armCall;
+    std::cout << "TIMER_FIRE_DELAY: " << fireDelay << std::endl;
+
+    if((0 == timerFireCall[100]) || (fireDelay < (2 * CTG_NUM_TIMER)) || (fireDelay > ((3 * CTG_NUM_TIMER) + 2)))
+    {
+        std::cout << "ERROR: one-shot timer expiry outside its revolution under arm burst" << std::endl;
+        testPassed = false;
+    }
+
+    if((1 != numTimer[CTG_TARGET_ORDER_ENTRY]) || (NUM_TEST_REVOLUTION_CTG != numTimer[CTG_TARGET_LINE_HANDLER]))
+    {
+        std::cout << "ERROR: timer events lost or delayed under arm burst" << std::endl;
+        testPassed = false;
+    }
+
+    // log final status
+    std::cout << "--" << std::hex << std::endl;
+    std::cout << "STATUS: ";
+    std::cout << "CTG_TICK_COUNT=" << regStatus.tickCount << " ";
+    std::cout << "CTG_TX_COUNT00=" << regStatus.txCount00 << " ";
+    std::cout << "CTG_TIMER_ARM=" << regTimerStatus.armCount << " ";
+    std::cout << "CTG_TIMER_CANCEL=" << regTimerStatus.cancelCount << " ";
+    std::cout << "CTG_TIMER_FIRE=" << regTimerStatus.fireCount << " ";
+    std::cout << "CTG_TIMER_DROP=" << regTimerStatus.dropCount << " ";
+    std::cout << std::endl;
+
+    std::cout << std::endl;
+
+    if(!testPassed)
+    {
+        std::cout << "FAIL!" << std::endl;
+        return 1;
+    }
+
+    std::cout << "Done!" << std::endl;
+
+    return 0;
+}
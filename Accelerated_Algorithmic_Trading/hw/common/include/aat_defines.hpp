@@ -68,6 +68,41 @@ enum ORDERENTRY_OPCODES
     ORDERENTRY_DELETE
 };
 
+// execution report types extracted by OrderEntry from inbound FIX messages
+// (MsgType 35=8), derived from OrdStatus (39)
+enum ORDERENTRY_EXEC_TYPES
+{
+    ORDERENTRY_EXEC_NEW = 0,
+    ORDERENTRY_EXEC_PARTIAL_FILL,
+    ORDERENTRY_EXEC_FILL,
+    ORDERENTRY_EXEC_CANCELED,
+    ORDERENTRY_EXEC_REJECTED,
+    ORDERENTRY_EXEC_UNKNOWN
+};
+
+// event codes carried on ClockTickGenerator event streams, periodic interval
+// ticks use CTG_EVENT_TICK, timer wheel events carry the code supplied when
+// the timer was armed
+enum CLOCKTICKGENERATOR_EVENT_CODES
+{
+    CTG_EVENT_NONE = 0,
+    CTG_EVENT_TICK = 1,
+    CTG_EVENT_QUOTE_REFRESH = 0x10,
+    CTG_EVENT_ORDER_CANCEL = 0x11
+};
+
+// timer wheel event targets, index matches the ClockTickGenerator event
+// stream connected to that kernel
+enum CLOCKTICKGENERATOR_TARGETS
+{
+    CTG_TARGET_FEED_HANDLER = 0,
+    CTG_TARGET_ORDER_BOOK,
+    CTG_TARGET_PRICING_ENGINE,
+    CTG_TARGET_ORDER_ENTRY,
+    CTG_TARGET_LINE_HANDLER,
+    CTG_TARGET_RISK_ENGINE
+};
+
 enum TCP_TXSTATUS_CODES
 {
     TXSTATUS_SUCCESS = 0,
@@ -31,6 +31,7 @@ void mmInterface::orderBookOperationPack(orderBookOperation_t *src,
     dest->data.range(47,16)   = src->price;
     dest->data.range(15,8)    = src->direction;
     dest->data.range(7,0)     = src->level;
+    dest->user                = src->ingressTimestamp;
 
     return;
 }
@@ -49,6 +50,7 @@ void mmInterface::orderBookOperationUnpack(orderBookOperationPack_t *src,
     dest->price       = src->data.range(47,16);
     dest->direction   = src->data.range(15,8);
     dest->level       = src->data.range(7,0);
+    dest->ingressTimestamp = src->user;
 
     return;
 }
@@ -66,6 +68,7 @@ void mmInterface::orderBookResponsePack(orderBookResponse_t *src,
     dest->data.range(479,320)  = src->askCount;
     dest->data.range(319,160)  = src->askPrice;
     dest->data.range(159,0)    = src->askQuantity;
+    dest->user                 = src->ingressTimestamp;
 
     return;
 }
@@ -83,6 +86,7 @@ void mmInterface::orderBookResponseUnpack(orderBookResponsePack_t *src,
     dest->askCount    = src->data.range(479,320);
     dest->askPrice    = src->data.range(319,160);
     dest->askQuantity = src->data.range(159,0);
+    dest->ingressTimestamp = src->user;
 
     return;
 }
@@ -99,6 +103,7 @@ void mmInterface::orderEntryOperationPack(orderEntryOperation_t *src,
     dest->data.range(71,40)   = src->quantity;
     dest->data.range(39,8)    = src->price;
     dest->data.range(7,0)     = src->direction;
+    dest->user                = src->ingressTimestamp;
 
     return;
 }
@@ -115,6 +120,91 @@ void mmInterface::orderEntryOperationUnpack(orderEntryOperationPack_t *src,
     dest->quantity    = src->data.range(71,40);
     dest->price       = src->data.range(39,8);
     dest->direction   = src->data.range(7,0);
+    dest->ingressTimestamp = src->user;
+
+    return;
+}
+
+void mmInterface::orderEntryExecReportPack(orderEntryExecReport_t *src,
+                                           orderEntryExecReportPack_t *dest)
+{
+#pragma HLS INLINE
+
+    dest->data.range(103,96) = src->execType;
+    dest->data.range(95,64)  = src->orderId;
+    dest->data.range(63,32)  = src->quantity;
+    dest->data.range(31,0)   = src->price;
+
+    return;
+}
+
+void mmInterface::orderEntryExecReportUnpack(orderEntryExecReportPack_t *src,
+                                             orderEntryExecReport_t *dest)
+{
+#pragma HLS INLINE
+
+    dest->execType = src->data.range(103,96);
+    dest->orderId  = src->data.range(95,64);
+    dest->quantity = src->data.range(63,32);
+    dest->price    = src->data.range(31,0);
+
+    return;
+}
+
+void mmInterface::clockTickGeneratorTimerPack(clockTickGeneratorTimer_t *src,
+                                              clockTickGeneratorTimerPack_t *dest)
+{
+#pragma HLS INLINE
+
+    // upper word matches the host timer config register layout (less strobe)
+    dest->data.range(63,63) = 0;
+    dest->data.range(62,54) = src->timerIndex;
+    dest->data.range(53,53) = src->arm;
+    dest->data.range(52,52) = src->periodic;
+    dest->data.range(51,48) = src->target;
+    dest->data.range(47,40) = src->symbolIndex;
+    dest->data.range(39,32) = src->eventCode;
+    dest->data.range(31,0)  = src->interval;
+
+    return;
+}
+
+void mmInterface::clockTickGeneratorTimerUnpack(clockTickGeneratorTimerPack_t *src,
+                                                clockTickGeneratorTimer_t *dest)
+{
+#pragma HLS INLINE
+
+    dest->timerIndex  = src->data.range(62,54);
+    dest->arm         = src->data.range(53,53);
+    dest->periodic    = src->data.range(52,52);
+    dest->target      = src->data.range(51,48);
+    dest->symbolIndex = src->data.range(47,40);
+    dest->eventCode   = src->data.range(39,32);
+    dest->interval    = src->data.range(31,0);
+
+    return;
+}
+
+void mmInterface::clockTickGeneratorEventPack(clockTickGeneratorTimerEvent_t *src,
+                                              clockTickGeneratorEvent_t *dest)
+{
+#pragma HLS INLINE
+
+    dest->data.range(31,16) = src->timerIndex;
+    dest->data.range(15,8)  = src->symbolIndex;
+    dest->data.range(7,0)   = src->eventCode;
+
+    return;
+}
+
+void mmInterface::clockTickGeneratorEventUnpack(clockTickGeneratorEvent_t *src,
+                                                clockTickGeneratorTimerEvent_t *dest)
+{
+#pragma HLS INLINE
+
+    dest->timerIndex  = src->data.range(31,16);
+    dest->symbolIndex = src->data.range(15,8);
+    dest->eventCode   = src->data.range(7,0);
 
     return;
 }
@@ -31,6 +31,7 @@ typedef struct orderBookOperation_t
     ap_uint<32> price;
     ap_uint<8>  direction;
     ap_int<8>   level;
+    ap_uint<64> ingressTimestamp;
 } orderBookOperation_t;
 
 // TODO: 56b timestamp to pack within 1024b total, review if 64b required
@@ -44,6 +45,7 @@ typedef struct orderBookResponse_t
     ap_uint<160> askCount;
     ap_uint<160> askPrice;
     ap_uint<160> askQuantity;
+    ap_uint<64>  ingressTimestamp;
 } orderBookResponse_t;
 
 typedef struct orderBookResponseVerify_t
@@ -66,6 +68,7 @@ typedef struct orderEntryOperation_t
     ap_uint<32> quantity;
     ap_uint<32> price;
     ap_uint<8>  direction;
+    ap_uint<64> ingressTimestamp;
 } orderEntryOperation_t;
 
 typedef struct orderEntryOperationEncode_t
@@ -77,8 +80,35 @@ typedef struct orderEntryOperationEncode_t
     ap_uint<80> quantity;
     ap_uint<80> price;
     ap_uint<8>  direction;
+    ap_uint<64> ingressTimestamp;
 } orderEntryOperationEncode_t;
 
+typedef struct orderEntryExecReport_t
+{
+    ap_uint<8>  execType;
+    ap_uint<32> orderId;
+    ap_uint<32> quantity;   // last fill quantity
+    ap_uint<32> price;      // last fill price
+} orderEntryExecReport_t;
+
+typedef struct clockTickGeneratorTimer_t
+{
+    ap_uint<32> interval;
+    ap_uint<16> timerIndex;
+    ap_uint<8>  eventCode;
+    ap_uint<8>  symbolIndex;
+    ap_uint<4>  target;
+    ap_uint<1>  periodic;
+    ap_uint<1>  arm;
+} clockTickGeneratorTimer_t;
+
+typedef struct clockTickGeneratorTimerEvent_t
+{
+    ap_uint<16> timerIndex;
+    ap_uint<8>  eventCode;
+    ap_uint<8>  symbolIndex;
+} clockTickGeneratorTimerEvent_t;
+
 typedef struct ipTuple_t
 {
     ap_uint<32> address;
@@ -227,11 +257,16 @@ struct axis
 // packed data structures
 typedef ap_uint<16> templateId_t;
 typedef ap_uint<32> securityId_t;
-typedef ap_axiu<224,0,0,0> orderBookOperationPack_t;
-typedef ap_axiu<1024,0,0,0> orderBookResponsePack_t;
-typedef ap_axiu<184,0,0,0> orderEntryOperationPack_t;
+// ingress timestamp of the packet an operation or response originated from is
+// carried in TUSER alongside the payload, zero where there is no such packet
+typedef ap_axiu<224,64,0,0> orderBookOperationPack_t;
+typedef ap_axiu<1024,64,0,0> orderBookResponsePack_t;
+typedef ap_axiu<184,64,0,0> orderEntryOperationPack_t;
 typedef ap_axiu<1024,0,0,0> orderEntryMessagePack_t;
-typedef ap_axiu<8,0,0,0> clockTickGeneratorEvent_t;
+typedef ap_axiu<32,0,0,0> clockTickGeneratorEvent_t;
+typedef ap_axiu<64,0,0,0> clockTickGeneratorTimerPack_t;
+typedef ap_axiu<8,0,0,0> orderEntryCredit_t;
+typedef ap_axiu<104,0,0,0> orderEntryExecReportPack_t;
 
 // network facing packed data structures
 typedef ap_uint<16> ipTcpListenPort_t;
@@ -240,6 +275,7 @@ typedef ap_uint<16> ipTcpCloseConnection_t;
 typedef axis<64> axiWord_t;
 typedef axiu<256> ipUdpMetaPack_t;
 typedef ap_axis<64,0,0,0> axiWordExt_t;
+typedef ap_axis<64,64,0,0> axiWordTimestampExt_t;
 typedef ap_axiu<256,0,0,0> ipUdpMetaPackExt_t;
 typedef ap_axiu<64,0,0,0> ipTuplePack_t;
 typedef ap_axiu<16,0,0,0> ipTcpListenPortPack_t;
@@ -279,6 +315,24 @@ public:
     void orderEntryOperationUnpack(orderEntryOperationPack_t *src,
                                    orderEntryOperation_t *dest);
 
+    void orderEntryExecReportPack(orderEntryExecReport_t *src,
+                                  orderEntryExecReportPack_t *dest);
+
+    void orderEntryExecReportUnpack(orderEntryExecReportPack_t *src,
+                                    orderEntryExecReport_t *dest);
+
+    void clockTickGeneratorTimerPack(clockTickGeneratorTimer_t *src,
+                                     clockTickGeneratorTimerPack_t *dest);
+
+    void clockTickGeneratorTimerUnpack(clockTickGeneratorTimerPack_t *src,
+                                       clockTickGeneratorTimer_t *dest);
+
+    void clockTickGeneratorEventPack(clockTickGeneratorTimerEvent_t *src,
+                                     clockTickGeneratorEvent_t *dest);
+
+    void clockTickGeneratorEventUnpack(clockTickGeneratorEvent_t *src,
+                                       clockTickGeneratorTimerEvent_t *dest);
+
     void ipTuplePack(ipTuple_t *src,
                      ipTuplePack_t *dest);
 
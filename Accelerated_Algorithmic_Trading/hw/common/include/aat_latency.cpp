@@ -0,0 +1,174 @@
+/*
+ * Copyright 2021 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "aat_latency.hpp"
+
+LatencyTimeBase::LatencyTimeBase()
+{
+#pragma HLS INLINE
+
+    // counter starts at one so a valid timestamp is never zero
+    countCycles = 1;
+}
+
+template<int N>
+void LatencyTimeBase::count(hls::stream<ap_uint<64> > timeStream[N])
+{
+#pragma HLS PIPELINE II=1 style=flp
+
+    // never blocks, each consumer reads one count per cycle so whatever is
+    // queued is at most the FIFO depth old
+loop_time_stream:
+    for(int i=0; i<N; i++)
+    {
+#pragma HLS UNROLL
+        if(!timeStream[i].full())
+        {
+            timeStream[i].write(countCycles);
+        }
+    }
+
+    ++countCycles;
+
+    return;
+}
+
+template void LatencyTimeBase::count<2>(hls::stream<ap_uint<64> > timeStream[2]);
+template void LatencyTimeBase::count<3>(hls::stream<ap_uint<64> > timeStream[3]);
+
+LatencyClock::LatencyClock()
+{
+#pragma HLS INLINE
+
+    timeNow = 0;
+}
+
+ap_uint<64> LatencyClock::now(hls::stream<ap_uint<64> > &timeStream)
+{
+#pragma HLS INLINE
+
+    if(!timeStream.empty())
+    {
+        timeNow = timeStream.read();
+    }
+
+    return timeNow;
+}
+
+LatencyHistogram::LatencyHistogram()
+{
+#pragma HLS INLINE
+#pragma HLS ARRAY_PARTITION variable=countBin complete
+
+    countSample = 0;
+    latencyMin = 0xFFFFFFFF;
+    latencyMax = 0;
+    latencySum = 0;
+
+loop_bin_init:
+    for(int i=0; i<LATENCY_NUM_BIN; i++)
+    {
+        countBin[i] = 0;
+    }
+}
+
+void LatencyHistogram::record(ap_uint<32> regControl,
+                              ap_uint<64> timeNow,
+                              ap_uint<64> ingressTimestamp)
+{
+#pragma HLS INLINE
+
+    ap_uint<64> delta;
+    ap_uint<32> latency;
+    ap_uint<64> binIndex;
+    ap_uint<5> binShift = (regControl & LATENCY_BIN_SHIFT_MASK);
+
+    if((0 == ingressTimestamp) || (LATENCY_RESET & regControl))
+    {
+        return;
+    }
+
+    // saturate rather than wrap on a sample beyond the 32b register range,
+    // a consumer reading the time base a cycle or two behind the stamping
+    // process can see a timestamp slightly ahead of its own time
+    delta = (timeNow - ingressTimestamp);
+    if(timeNow < ingressTimestamp)
+    {
+        latency = 0;
+    }
+    else
+    {
+        latency = (delta > 0xFFFFFFFF) ? ap_uint<32>(0xFFFFFFFF) : ap_uint<32>(delta);
+    }
+
+    binIndex = (latency >> binShift);
+    if(binIndex > (LATENCY_NUM_BIN-1))
+    {
+        binIndex = (LATENCY_NUM_BIN-1);
+    }
+
+    ++countSample;
+    ++countBin[binIndex];
+    latencySum += latency;
+
+    if(latency < latencyMin)
+    {
+        latencyMin = latency;
+    }
+
+    if(latency > latencyMax)
+    {
+        latencyMax = latency;
+    }
+
+    return;
+}
+
+void LatencyHistogram::update(ap_uint<32> regControl,
+                              ap_uint<32> &regCount,
+                              ap_uint<32> &regMin,
+                              ap_uint<32> &regMax,
+                              ap_uint<32> &regBin,
+                              ap_uint<32> &regSumLower,
+                              ap_uint<32> &regSumUpper)
+{
+#pragma HLS INLINE
+
+    ap_uint<4> binSelect = ((regControl >> LATENCY_BIN_SELECT_LSB) & LATENCY_BIN_SELECT_MASK);
+
+    if(LATENCY_RESET & regControl)
+    {
+        countSample = 0;
+        latencyMin = 0xFFFFFFFF;
+        latencyMax = 0;
+        latencySum = 0;
+
+loop_bin_reset:
+        for(int i=0; i<LATENCY_NUM_BIN; i++)
+        {
+            countBin[i] = 0;
+        }
+    }
+
+    regCount = countSample;
+    regMin = latencyMin;
+    regMax = latencyMax;
+    regBin = countBin[binSelect];
+    regSumLower = latencySum.range(31,0);
+    regSumUpper = latencySum.range(63,32);
+
+    return;
+}
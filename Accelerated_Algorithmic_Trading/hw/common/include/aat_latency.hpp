@@ -0,0 +1,145 @@
+/*
+ * Copyright 2021 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef AAT_LATENCY_H
+#define AAT_LATENCY_H
+
+#include "ap_int.h"
+#include "hls_stream.h"
+
+// number of bins in each stage latency histogram, the last bin also collects
+// any sample beyond the histogram range
+#define LATENCY_NUM_BIN (16)
+
+// latency control register
+#define LATENCY_BIN_SHIFT_MASK  (0x1F)  // [4:0] bin width as log2 cycles
+#define LATENCY_BIN_SELECT_LSB  (8)     // [11:8] bin presented in status
+#define LATENCY_BIN_SELECT_MASK (0xF)
+#define LATENCY_RESET           (1<<31) // statistics held in reset while set
+
+typedef struct latencyRegStatus_t
+{
+    ap_uint<32> count;
+    ap_uint<32> min;
+    ap_uint<32> max;
+    ap_uint<32> bin;
+    ap_uint<32> sumLower;   // 64b sum of all samples, mean is sum / count
+    ap_uint<32> sumUpper;
+} latencyRegStatus_t;
+
+/**
+ * LatencyTimeBase
+ *
+ * Cycle counter for the latency probes of a kernel, run as its own dataflow
+ * process with no blocking I/O so it advances on every clock from reset. The
+ * count is offered to each consumer process on a shallow FIFO only while
+ * there is room. A consumer can take no more than one entry per cycle, so the
+ * count is only current if the consumer is itself called on every cycle: a
+ * process holding a LatencyClock checks its outputs for space before taking
+ * an input and never blocks on a stream, the count it reads is then at most
+ * the FIFO depth behind. A process that did block would resume with the
+ * counts queued before the stall and under report every sample taken until
+ * the FIFO had turned over.
+ *
+ * Each kernel runs its own time base from its own reset release and nothing
+ * aligns the counters of different kernels, so a timestamp is only exact
+ * against the time base of the kernel that took it (the LineHandler). Any
+ * other kernel measures it with a fixed but unknown offset.
+ */
+class LatencyTimeBase
+{
+public:
+
+    LatencyTimeBase();
+
+    template<int N>
+    void count(hls::stream<ap_uint<64> > timeStream[N]);
+
+private:
+
+    ap_uint<64> countCycles;
+};
+
+/**
+ * LatencyClock
+ *
+ * Consumer side of the time base, one per process, taking the next count
+ * offered on the FIFO each call without blocking. The owning process must not
+ * block on any stream access, see LatencyTimeBase.
+ */
+class LatencyClock
+{
+public:
+
+    LatencyClock();
+
+    ap_uint<64> now(hls::stream<ap_uint<64> > &timeStream);
+
+private:
+
+    ap_uint<64> timeNow;
+};
+
+/**
+ * LatencyHistogram
+ *
+ * Wire to stage latency, the ingress timestamp is taken from the kernel time
+ * base by the LineHandler port filter on arrival of the packet and compared
+ * here against the time base of the kernel holding the probe. A timestamp of
+ * zero marks operations that did not originate from a received packet (host,
+ * timer) and is not recorded.
+ *
+ * Each kernel places one histogram where a message is read from its input
+ * stream (ingress probe) and one where the result is written to its output
+ * stream (egress probe). Both probes of a kernel measure from the same wire
+ * timestamp against the same time base, so the offset of that time base
+ * cancels in the difference of their means, which approximates the time
+ * spent inside the kernel. Differences between probes of different kernels
+ * keep the offset of both time bases and are not meaningful, so the time
+ * spent queued between kernels is not measured. The difference is only as
+ * good as the time base,
+ * each probe may read it up to the FIFO depth late, and consecutive probes do
+ * not always sample the same messages (an ingress probe also counts those
+ * later dropped or rejected), so a delta of a few cycles is within the error.
+ */
+class LatencyHistogram
+{
+public:
+
+    LatencyHistogram();
+
+    void record(ap_uint<32> regControl,
+                ap_uint<64> timeNow,
+                ap_uint<64> ingressTimestamp);
+
+    void update(ap_uint<32> regControl,
+                ap_uint<32> &regCount,
+                ap_uint<32> &regMin,
+                ap_uint<32> &regMax,
+                ap_uint<32> &regBin,
+                ap_uint<32> &regSumLower,
+                ap_uint<32> &regSumUpper);
+
+private:
+
+    ap_uint<32> countSample;
+    ap_uint<32> latencyMin;
+    ap_uint<32> latencyMax;
+    ap_uint<64> latencySum;
+    ap_uint<32> countBin[LATENCY_NUM_BIN];
+};
+
+#endif
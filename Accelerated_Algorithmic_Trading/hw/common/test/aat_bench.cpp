@@ -0,0 +1,293 @@
+/*
+ * Copyright 2021 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+
+#include "aat_bench.hpp"
+
+#define PCAP_MAGIC_MICROSECONDS (0xA1B2C3D4)
+#define PCAP_MAGIC_NANOSECONDS  (0xA1B23C4D)
+#define PCAP_FILE_HEADER_LENGTH (24)
+#define PCAP_RECORD_LENGTH      (16)
+#define PCAP_LINKTYPE_ETHERNET  (1)
+#define PCAP_LINKTYPE_RAW       (101)
+#define PCAP_LINKTYPE_IPV4      (228)
+
+AatBench::AatBench(const char *kernelName, uint64_t defaultEvents)
+{
+    kernel = kernelName;
+    modeName = "csim";
+    bCosim = false;
+    targetEvents = defaultEvents;
+    callLimit = defaultEvents * AAT_BENCH_CALL_LIMIT_PER_EVENT;
+    countEvent = 0;
+    countOutput = 0;
+    countCall = 0;
+    elapsedSeconds = 0;
+}
+
+bool AatBench::parseArgs(int argc, char *argv[])
+{
+    bool valid=true;
+
+    for(int i=1; (i<argc) && valid; i++)
+    {
+        if((0 == strcmp(argv[i], "-n")) && ((i+1) < argc))
+        {
+            targetEvents = strtoull(argv[++i], NULL, 0);
+            valid = (targetEvents > 0);
+        }
+        else if((0 == strcmp(argv[i], "-o")) && ((i+1) < argc))
+        {
+            outputFile = argv[++i];
+        }
+        else if((0 == strcmp(argv[i], "-m")) && ((i+1) < argc))
+        {
+            modeName = argv[++i];
+            valid = ((modeName == "csim") || (modeName == "cosim"));
+        }
+        else if((0 == strcmp(argv[i], "-p")) && ((i+1) < argc))
+        {
+            pcapFile = argv[++i];
+        }
+        else
+        {
+            valid = false;
+        }
+    }
+
+    if(!valid)
+    {
+        std::cout << "Usage: " << argv[0] << " [-n <events>] [-o <json>] [-m csim|cosim] [-p <pcap>]" << std::endl;
+    }
+
+    callLimit = targetEvents * AAT_BENCH_CALL_LIMIT_PER_EVENT;
+    bCosim = (modeName == "cosim");
+
+    return valid;
+}
+
+void AatBench::start(void)
+{
+    std::cout << "Benchmark " << kernel << " (" << modeName << "): "
+              << targetEvents << " events ..." << std::endl;
+
+    startTime = std::chrono::steady_clock::now();
+}
+
+void AatBench::stop(void)
+{
+    std::chrono::steady_clock::time_point endTime = std::chrono::steady_clock::now();
+
+    elapsedSeconds = std::chrono::duration<double>(endTime - startTime).count();
+}
+
+void AatBench::probe(const char *name, const latencyRegStatus_t &regStatus)
+{
+    Probe p;
+
+    p.name = name;
+    p.count = regStatus.count;
+    p.sum = ((uint64_t)regStatus.sumUpper << 32) | (uint64_t)regStatus.sumLower;
+
+    probes.push_back(p);
+}
+
+bool AatBench::transitMean(double &mean) const
+{
+    const Probe *ingress=NULL, *egress=NULL;
+
+    for(unsigned i=0; i<probes.size(); i++)
+    {
+        if(probes[i].name == "INGRESS") ingress = &probes[i];
+        if(probes[i].name == "EGRESS") egress = &probes[i];
+    }
+
+    if((NULL == ingress) || (NULL == egress) || (0 == ingress->count) || (0 == egress->count))
+    {
+        return false;
+    }
+
+    // the means are only comparable over the same messages, a kernel that
+    // drops some (duplicates, no trade) skews whichever probe saw the extra
+    int64_t unmatched = (int64_t)ingress->count - (int64_t)egress->count;
+
+    if((((unmatched < 0) ? -unmatched : unmatched) * 100) > (int64_t)ingress->count)
+    {
+        return false;
+    }
+
+    mean = ((double)egress->sum / egress->count) - ((double)ingress->sum / ingress->count);
+
+    return true;
+}
+
+int AatBench::report(void)
+{
+    double eventsPerSecond = (elapsedSeconds > 0) ? (countEvent / elapsedSeconds) : 0;
+    double callsPerEvent = (countEvent > 0) ? ((double)countCall / countEvent) : 0;
+    const char *transitUnit = bCosim ? "cycles" : "calls";
+    double transit = 0;
+    bool transitValid = transitMean(transit);
+    char line[256];
+
+    // single line summary for log scraping
+    snprintf(line, sizeof(line), "BENCH: KERNEL=%s MODE=%s EVENTS=%llu OUTPUTS=%llu CALLS=%llu SECONDS=%.3f EVENTS_PER_SEC=%.0f CALLS_PER_EVENT=%.3f",
+             kernel.c_str(), modeName.c_str(),
+             (unsigned long long)countEvent, (unsigned long long)countOutput, (unsigned long long)countCall,
+             elapsedSeconds, eventsPerSecond, callsPerEvent);
+    std::cout << line;
+
+    for(unsigned i=0; i<probes.size(); i++)
+    {
+        snprintf(line, sizeof(line), " %s_COUNT=%u", probes[i].name.c_str(), probes[i].count);
+        std::cout << line;
+    }
+    if(transitValid)
+    {
+        snprintf(line, sizeof(line), " TRANSIT_MEAN=%.2f TRANSIT_UNIT=%s", transit, transitUnit);
+        std::cout << line;
+    }
+    std::cout << std::endl;
+
+    if(!outputFile.empty())
+    {
+        std::ofstream json(outputFile.c_str());
+
+        if(!json.is_open())
+        {
+            std::cout << "ERROR: unable to write " << outputFile << std::endl;
+            return 1;
+        }
+
+        json << "{" << std::endl;
+        json << "  \"kernel\": \"" << kernel << "\"," << std::endl;
+        json << "  \"mode\": \"" << modeName << "\"," << std::endl;
+        json << "  \"events\": " << countEvent << "," << std::endl;
+        json << "  \"outputs\": " << countOutput << "," << std::endl;
+        json << "  \"calls\": " << countCall << "," << std::endl;
+        snprintf(line, sizeof(line), "  \"seconds\": %.6f,", elapsedSeconds);
+        json << line << std::endl;
+        snprintf(line, sizeof(line), "  \"eventsPerSecond\": %.1f,", eventsPerSecond);
+        json << line << std::endl;
+        snprintf(line, sizeof(line), "  \"callsPerEvent\": %.4f,", callsPerEvent);
+        json << line << std::endl;
+        json << "  \"probes\": {";
+
+        for(unsigned i=0; i<probes.size(); i++)
+        {
+            snprintf(line, sizeof(line), "\"%s\": {\"count\": %u}", probes[i].name.c_str(), probes[i].count);
+            json << ((0 == i) ? "" : ",") << std::endl << "    " << line;
+        }
+
+        json << std::endl << "  }," << std::endl;
+
+        if(transitValid)
+        {
+            snprintf(line, sizeof(line), "  \"transitLatency\": {\"unit\": \"%s\", \"mean\": %.2f}", transitUnit, transit);
+            json << line << std::endl;
+        }
+        else
+        {
+            json << "  \"transitLatency\": null" << std::endl;
+        }
+
+        json << "}" << std::endl;
+    }
+
+    return 0;
+}
+
+static uint32_t pcapRead32(const uint8_t *p)
+{
+    return p[0] | (p[1] << 8) | (p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+bool aatBenchLoadPcap(const char *path, std::vector<std::vector<uint8_t> > &payloads)
+{
+    std::ifstream file(path, std::ios::binary);
+    std::vector<uint8_t> data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    uint32_t magic, linkType, recordLength;
+    size_t offset=PCAP_FILE_HEADER_LENGTH;
+
+    if(!file.is_open() || (data.size() < PCAP_FILE_HEADER_LENGTH))
+    {
+        return false;
+    }
+
+    magic = pcapRead32(&data[0]);
+    linkType = pcapRead32(&data[20]);
+
+    if(((PCAP_MAGIC_MICROSECONDS != magic) && (PCAP_MAGIC_NANOSECONDS != magic)) ||
+       ((PCAP_LINKTYPE_ETHERNET != linkType) && (PCAP_LINKTYPE_RAW != linkType) && (PCAP_LINKTYPE_IPV4 != linkType)))
+    {
+        return false;
+    }
+
+    while((offset + PCAP_RECORD_LENGTH) <= data.size())
+    {
+        recordLength = pcapRead32(&data[offset+8]);
+        offset += PCAP_RECORD_LENGTH;
+
+        if((offset + recordLength) > data.size())
+        {
+            break;
+        }
+
+        const uint8_t *frame = &data[offset];
+        uint32_t ip=0, etherType=0x0800;
+
+        offset += recordLength;
+
+        if(PCAP_LINKTYPE_ETHERNET == linkType)
+        {
+            ip = 14;
+            if(recordLength >= 18)
+            {
+                etherType = (frame[12] << 8) | frame[13];
+                if(0x8100 == etherType)
+                {
+                    etherType = (frame[16] << 8) | frame[17];
+                    ip += 4;
+                }
+            }
+        }
+
+        // IPv4 carrying UDP only
+        if((0x0800 != etherType) || ((ip + 28) > recordLength) ||
+           (4 != (frame[ip] >> 4)) || (17 != frame[ip+9]))
+        {
+            continue;
+        }
+
+        uint32_t udp = ip + ((frame[ip] & 0x0F) * 4);
+        uint32_t udpLength = ((udp + 8) <= recordLength) ? ((frame[udp+4] << 8) | frame[udp+5]) : 0;
+
+        if((udpLength < 8) || ((udp + udpLength) > recordLength))
+        {
+            continue;
+        }
+
+        payloads.push_back(std::vector<uint8_t>(&frame[udp+8], &frame[udp+udpLength]));
+    }
+
+    return true;
+}
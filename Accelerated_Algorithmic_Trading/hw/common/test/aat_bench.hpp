@@ -0,0 +1,127 @@
+/*
+ * Copyright 2021 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef AAT_BENCH_H
+#define AAT_BENCH_H
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "aat_latency.hpp"
+
+// bench gives up once the top has been called this many times per event
+// offered, stops a stalled kernel hanging the simulation
+#define AAT_BENCH_CALL_LIMIT_PER_EVENT (64)
+
+/**
+ * AatBench
+ *
+ * Throughput harness shared by the kernel benchmark testbenches. Each bench
+ * streams events into its top function, counting the events offered, outputs
+ * drained and top calls made, then reports events per second of simulation
+ * time alongside the number of samples each stage latency probe recorded.
+ *
+ * In C simulation each top call models one pass of the II=1 processes, so
+ * calls per event approximates the achieved II. Cycle accurate II comes from
+ * the co-simulation report, which run_bench.tcl extracts after running the
+ * same bench under cosim_design.
+ *
+ * Transaction latency is taken from the kernel's own INGRESS and EGRESS
+ * probes, as the difference of their mean samples. Both measure from the
+ * same ingress timestamp, so the difference is the mean time from the input
+ * stream read to the output stream write, in units of the kernel time base:
+ * top calls in C simulation and clock cycles under co-simulation. The top
+ * functions are free running (ap_ctrl_none), so the co-simulation report
+ * itself has no transaction latency to offer for them. The RTL time base
+ * counts clocks rather than calls, which the bench cannot predict, so under
+ * co-simulation every event is stamped 1 and the probes record absolute
+ * kernel time, which cancels out of the difference. The difference is only
+ * reported while the two probes sampled the same messages, to within 1% for
+ * events still in flight: kernels that drop some of their input (LineHandler
+ * duplicates, PricingEngine events with no order) report no transit latency.
+ *
+ * Options, passed through csim_design/cosim_design -argv:
+ *   -n <events>   number of input events to offer
+ *   -o <file>     JSON result file for regression tracking
+ *   -m <mode>     csim (default) or cosim, recorded in the result
+ *   -p <pcap>     capture file to source packet payloads from (where supported)
+ */
+class AatBench
+{
+public:
+
+    AatBench(const char *kernelName, uint64_t defaultEvents);
+
+    bool parseArgs(int argc, char *argv[]);
+
+    const char *pcapPath(void) const { return pcapFile.empty() ? NULL : pcapFile.c_str(); }
+
+    bool running(void) const { return (countEvent < targetEvents) && (countCall < callLimit); }
+
+    void start(void);
+    void stop(void);
+
+    // ingress timestamp for the next event, the value of the kernel latency
+    // counter on the next top call in C simulation, see above for cosim
+    ap_uint<64> timestamp(void) const { return bCosim ? ap_uint<64>(1) : ap_uint<64>(countCall + 1); }
+
+    void event(uint64_t n=1) { countEvent += n; }
+    void output(uint64_t n=1) { countOutput += n; }
+    void call(void) { ++countCall; }
+
+    uint64_t numOffered(void) const { return countEvent; }
+    uint64_t numOutput(void) const { return countOutput; }
+    uint64_t numCalls(void) const { return countCall; }
+
+    void probe(const char *name, const latencyRegStatus_t &regStatus);
+
+    int report(void);
+
+private:
+
+    struct Probe
+    {
+        std::string name;
+        uint32_t count;
+        uint64_t sum;
+    };
+
+    bool transitMean(double &mean) const;
+
+    std::string kernel;
+    std::string modeName;
+    bool bCosim;
+    std::string outputFile;
+    std::string pcapFile;
+    uint64_t targetEvents;
+    uint64_t callLimit;
+    uint64_t countEvent;
+    uint64_t countOutput;
+    uint64_t countCall;
+    double elapsedSeconds;
+    std::chrono::steady_clock::time_point startTime;
+    std::vector<Probe> probes;
+};
+
+/**
+ * UDP payloads of every IPv4 packet in a classic pcap file (Ethernet or raw
+ * IP link type, native byte order), returns false if the file is unreadable.
+ */
+bool aatBenchLoadPcap(const char *path, std::vector<std::vector<uint8_t> > &payloads);
+
+#endif
@@ -0,0 +1,41 @@
+#
+# Copyright 2021 Xilinx, Inc.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+
+# "make bench" for a kernel test directory, included after the kernel
+# Makefile has set BENCH_KERNEL, BENCH_TOP, BENCH_SOURCES and BENCH_TB (and
+# optionally BENCH_CFLAGS, BENCH_ARGS). C-sim throughput of the bench
+# testbench, and with COSIM=1 the achieved II and transaction latency,
+# results in bench_<name>*.json. See common/test/run_bench.tcl.
+
+HLS ?= vitis_hls
+
+BENCH_EVENTS ?= 1000000
+BENCH_COSIM_EVENTS ?= 1000
+BENCH_CFLAGS ?=
+BENCH_ARGS ?=
+
+bench: setup
+	@echo 'set BENCH_EVENTS $(BENCH_EVENTS)' >> ./settings.tcl
+	@echo 'set BENCH_COSIM_EVENTS $(BENCH_COSIM_EVENTS)' >> ./settings.tcl
+	@echo 'set BENCH_KERNEL $(BENCH_KERNEL)' >> ./settings.tcl
+	@echo 'set BENCH_TOP $(BENCH_TOP)' >> ./settings.tcl
+	@echo 'set BENCH_SOURCES "$(BENCH_SOURCES)"' >> ./settings.tcl
+	@echo 'set BENCH_TB $(BENCH_TB)' >> ./settings.tcl
+	@echo 'set BENCH_CFLAGS "$(BENCH_CFLAGS)"' >> ./settings.tcl
+	@echo 'set BENCH_ARGS "$(BENCH_ARGS)"' >> ./settings.tcl
+	$(HLS) -f ../../common/test/run_bench.tcl;
+
+.PHONY: bench
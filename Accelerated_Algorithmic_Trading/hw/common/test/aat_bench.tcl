@@ -0,0 +1,119 @@
+#
+# Copyright 2021 Xilinx, Inc.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+
+# Benchmark helpers for run_bench.tcl
+
+# value of a co-simulation report field for the JSON result, NA as null
+proc aatBenchValue {field} {
+  set field [string trim $field]
+  if {$field == "" || $field == "NA"} {
+    return "null"
+  }
+  if {[string is double -strict $field]} {
+    return $field
+  }
+  return "\"$field\""
+}
+
+# field of the result the bench itself wrote, null if it is not there
+proc aatBenchResult {tbJsonFile pattern} {
+  if {![file exists $tbJsonFile]} {
+    return "null"
+  }
+
+  set fd [open $tbJsonFile r]
+  set text [read $fd]
+  close $fd
+
+  if {[regexp $pattern $text -> value]} {
+    return $value
+  }
+  return "null"
+}
+
+# extracts the Verilog row of the co-simulation report, transaction latency
+# and achieved II in clock cycles, and writes it out alongside the C-sim
+# result of the same bench. The free running (ap_ctrl_none) tops leave the
+# report latency and interval as NA. The latency then comes from the kernel's
+# own probes as recorded by the bench during the RTL run (tbJsonFile, see
+# aat_bench.hpp), and the interval is the total simulated cycles over the
+# events the bench offered.
+proc aatBenchCosimReport {kernel top jsonFile tbJsonFile} {
+  global PROJ SOLN
+
+  set rptFile "${PROJ}/${SOLN}/sim/report/${top}_cosim.rpt"
+  if {![file exists $rptFile]} {
+    puts "ERROR: co-simulation report $rptFile not found"
+    return
+  }
+
+  set fd [open $rptFile r]
+  set lines [split [read $fd] "\n"]
+  close $fd
+
+  set row {}
+  foreach line $lines {
+    if {[regexp {^\|\s*Verilog\s*\|} $line]} {
+      set row [lrange [split $line "|"] 2 9]
+    }
+  }
+
+  if {[llength $row] != 8} {
+    puts "ERROR: no Verilog result in $rptFile"
+    return
+  }
+
+  set latencyMin [aatBenchValue [lindex $row 1]]
+  set latencyAvg [aatBenchValue [lindex $row 2]]
+  set latencyMax [aatBenchValue [lindex $row 3]]
+  set latencySource "report"
+
+  set intervalMin [aatBenchValue [lindex $row 4]]
+  set intervalAvg [aatBenchValue [lindex $row 5]]
+  set intervalMax [aatBenchValue [lindex $row 6]]
+  set intervalSource "report"
+  set totalCycles [aatBenchValue [lindex $row 7]]
+
+  if {$latencyAvg == "null"} {
+    set latencyAvg [aatBenchResult $tbJsonFile {"transitLatency":\s*\{[^\}]*"mean":\s*([-0-9.eE+]+)}]
+    set latencySource [expr {($latencyAvg == "null") ? "none" : "probes"}]
+  }
+
+  if {$intervalAvg == "null"} {
+    set events [aatBenchResult $tbJsonFile {"events":\s*([0-9]+)}]
+    set intervalSource "none"
+    if {($events != "null") && ($events > 0) && [string is double -strict $totalCycles]} {
+      set intervalAvg [format "%.3f" [expr {double($totalCycles) / $events}]]
+      set intervalSource "totalCycles"
+    }
+  }
+
+  set fd [open $jsonFile w]
+  puts $fd "\{"
+  puts $fd "  \"kernel\": \"$kernel\","
+  puts $fd "  \"mode\": \"cosim\","
+  puts $fd "  \"status\": [aatBenchValue [lindex $row 0]],"
+  puts $fd "  \"latencyUnit\": \"cycles\","
+  puts $fd "  \"latencySource\": \"$latencySource\","
+  puts $fd "  \"latency\": \{\"min\": $latencyMin, \"avg\": $latencyAvg, \"max\": $latencyMax\},"
+  puts $fd "  \"intervalSource\": \"$intervalSource\","
+  puts $fd "  \"interval\": \{\"min\": $intervalMin, \"avg\": $intervalAvg, \"max\": $intervalMax\},"
+  puts $fd "  \"totalCycles\": $totalCycles"
+  puts $fd "\}"
+  close $fd
+
+  puts "BENCH: KERNEL=$kernel MODE=cosim STATUS=[string trim [lindex $row 0]] II_AVG=$intervalAvg LATENCY_AVG=$latencyAvg LATENCY_SOURCE=$latencySource"
+}
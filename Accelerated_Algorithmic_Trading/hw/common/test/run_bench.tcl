@@ -0,0 +1,69 @@
+#
+# Copyright 2021 Xilinx, Inc.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+
+# Benchmark project for any kernel, run from the kernel test directory by
+# "make bench" (aat_bench.mk). The kernel is described by settings.tcl:
+#   BENCH_KERNEL   kernel name recorded in the results
+#   BENCH_TOP      top function
+#   BENCH_SOURCES  kernel sources, relative to the kernel directory
+#   BENCH_TB       bench testbench, results are named after it
+#   BENCH_CFLAGS   extra kernel and testbench compile flags
+#   BENCH_ARGS     extra bench arguments
+
+source settings.tcl
+
+set PROJ "prj_bench"
+set SOLN "sol"
+set CLKP 300MHz
+set CASE_ROOT [pwd]
+set KERNEL_ROOT "${CASE_ROOT}/../"
+set COMMON_ROOT "${CASE_ROOT}/../../common"
+set CFLAGS "-I${COMMON_ROOT}/include -std=c++14 ${BENCH_CFLAGS}"
+set TBFLAGS "-I${KERNEL_ROOT} -I${COMMON_ROOT}/test ${CFLAGS}"
+set RESULT [file rootname [file tail $BENCH_TB]]
+
+source "${COMMON_ROOT}/test/aat_bench.tcl"
+
+open_project -reset $PROJ
+
+add_files "${COMMON_ROOT}/include/aat_interfaces.cpp" -cflags ${CFLAGS}
+add_files "${COMMON_ROOT}/include/aat_latency.cpp" -cflags ${CFLAGS}
+foreach source $BENCH_SOURCES {
+  add_files "${KERNEL_ROOT}/${source}" -cflags ${CFLAGS}
+}
+add_files -tb $BENCH_TB -cflags "${TBFLAGS}"
+add_files -tb "${COMMON_ROOT}/test/aat_bench.cpp" -cflags "${TBFLAGS}"
+
+set_top $BENCH_TOP
+
+open_solution -reset $SOLN -flow_target vitis
+
+set_part $XPART
+create_clock -period $CLKP -name default
+
+if {$CSIM == 1} {
+  csim_design -argv "-n ${BENCH_EVENTS} -o ${CASE_ROOT}/${RESULT}.json ${BENCH_ARGS}"
+}
+
+# cycle accurate II and transaction latency from a shorter run of the bench,
+# the bench result written during the RTL run carries the probe latencies
+if {$COSIM == 1} {
+  csynth_design
+  cosim_design -argv "-n ${BENCH_COSIM_EVENTS} -m cosim -o ${CASE_ROOT}/${RESULT}_cosim_tb.json ${BENCH_ARGS}"
+  aatBenchCosimReport $BENCH_KERNEL $BENCH_TOP "${CASE_ROOT}/${RESULT}_cosim.json" "${CASE_ROOT}/${RESULT}_cosim_tb.json"
+}
+
+exit
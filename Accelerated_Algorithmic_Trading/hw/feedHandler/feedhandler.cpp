@@ -22,8 +22,17 @@
  */
 void FeedHandler::udpPacketHandler(ap_uint<32> &regProcessWord,
                                    ap_uint<32> &regProcessPacket,
-                                   hls::stream<axiWordExt_t> &inputStream,
-                                   hls::stream<axiWord_t> &outputStream)
+                                   ap_uint<32> &regLatencyControl,
+                                   ap_uint<32> &regLatencyCount,
+                                   ap_uint<32> &regLatencyMin,
+                                   ap_uint<32> &regLatencyMax,
+                                   ap_uint<32> &regLatencyBin,
+                                   ap_uint<32> &regLatencySumLower,
+                                   ap_uint<32> &regLatencySumUpper,
+                                   hls::stream<ap_uint<64> > &timeStream,
+                                   hls::stream<axiWordTimestampExt_t> &inputStream,
+                                   hls::stream<axiWord_t> &outputStream,
+                                   hls::stream<ap_uint<64> > &timestampStream)
 
 {
 #pragma HLS PIPELINE II=1 style=flp
@@ -31,7 +40,7 @@ void FeedHandler::udpPacketHandler(ap_uint<32> &regProcessWord,
     enum stateIdType {DECODE, FWDUDP, REMAINDER};
     static stateIdType stateId=DECODE;
 
-    axiWordExt_t currWordExt;
+    axiWordTimestampExt_t currWordExt;
     axiWord_t currWord, sendWord, prevData;
 
     static ap_shift_reg<axiWord_t, 1> Sreg;
@@ -39,12 +48,16 @@ void FeedHandler::udpPacketHandler(ap_uint<32> &regProcessWord,
 
     static ap_uint<32> countProcessWord=0;
     static ap_uint<32> countProcessPacket=0;
+    static LatencyHistogram latency;
+    static LatencyClock latencyClock;
+
+    ap_uint<64> timeNow = latencyClock.now(timeStream);
 
     switch(stateId)
     {
         case DECODE:
         {
-            if(!inputStream.empty())
+            if(!inputStream.empty() && ((1 == wordCount) || !timestampStream.full()))
             {
                 inputStream.read(currWordExt);
                 currWord.data = currWordExt.data;
@@ -59,6 +72,10 @@ void FeedHandler::udpPacketHandler(ap_uint<32> &regProcessWord,
                     stateId = FWDUDP;
                 } else
                 {
+                    // ingress timestamp from LineHandler is passed on once
+                    // per packet, ahead of any of its payload
+                    timestampStream.write(currWordExt.user);
+                    latency.record(regLatencyControl, timeNow, currWordExt.user);
                     wordCount++;
                 }
             }
@@ -91,14 +108,17 @@ void FeedHandler::udpPacketHandler(ap_uint<32> &regProcessWord,
         }
         case REMAINDER:
         {
-            prevData = Sreg.read(0);
-            sendWord.data.range(31,0) = prevData.data.range(63,32);
-            sendWord.data.range(63,32) = 0x0;
-            sendWord.last = 0x1;
-            sendWord.keep = 0xF;
-            outputStream.write(sendWord);
-            ++countProcessPacket;
-            stateId = DECODE;
+            if(!outputStream.full())
+            {
+                prevData = Sreg.read(0);
+                sendWord.data.range(31,0) = prevData.data.range(63,32);
+                sendWord.data.range(63,32) = 0x0;
+                sendWord.last = 0x1;
+                sendWord.keep = 0xF;
+                outputStream.write(sendWord);
+                ++countProcessPacket;
+                stateId = DECODE;
+            }
             break;
         }
     }
@@ -106,13 +126,23 @@ void FeedHandler::udpPacketHandler(ap_uint<32> &regProcessWord,
     regProcessWord = countProcessWord;
     regProcessPacket = countProcessPacket;
 
+    latency.update(regLatencyControl,
+                   regLatencyCount,
+                   regLatencyMin,
+                   regLatencyMax,
+                   regLatencyBin,
+                   regLatencySumLower,
+                   regLatencySumUpper);
+
     return;
 }
 
 void FeedHandler::binaryPacketHandler(ap_uint<32> &regProcessBinary,
                                       hls::stream<axiWord_t> &inputStream,
                                       hls::stream<axiWord_t> &outputStream,
-                                      hls::stream<templateId_t> &templateIdStream)
+                                      hls::stream<templateId_t> &templateIdStream,
+                                      hls::stream<ap_uint<64> > &packetTimestampStream,
+                                      hls::stream<ap_uint<64> > &messageTimestampStream)
 {
 #pragma HLS PIPELINE II=1 style=flp
 
@@ -127,6 +157,8 @@ void FeedHandler::binaryPacketHandler(ap_uint<32> &regProcessBinary,
     static ap_uint<16> receivedBytes=0;
     static ap_uint<16> blockLength;
     static ap_uint<8> offset=0;
+    static bool packetStart=true;
+    static ap_uint<64> packetTimestamp=0;
 
     static ap_uint<32> countProcessBinary=0;
 
@@ -151,6 +183,14 @@ void FeedHandler::binaryPacketHandler(ap_uint<32> &regProcessBinary,
                         tmplID = currWord.data.range(47,32);
                         // TODO: add a check here for a valid template, go to drop state if not supported
                         templateIdStream.write(tmplID);
+
+                        // all messages of a packet share its ingress timestamp
+                        if(packetStart)
+                        {
+                            packetTimestamp = packetTimestampStream.read();
+                            packetStart = false;
+                        }
+                        messageTimestampStream.write(packetTimestamp);
                         schemaID = currWord.data.range(63,48);
                         break;
                     case 1:
@@ -188,6 +228,7 @@ void FeedHandler::binaryPacketHandler(ap_uint<32> &regProcessBinary,
                     if(currWord.last)
                     {
                         offset = 0;
+                        packetStart = true;
                     }
                     else
                     {
@@ -218,6 +259,7 @@ void FeedHandler::binaryPacketHandler(ap_uint<32> &regProcessBinary,
 void FeedHandler::fixDecoderTop(ap_uint<32> &regProcessFix,
                                 hls::stream<axiWord_t> &inputStream,
                                 hls::stream<templateId_t> &templateIdStream,
+                                hls::stream<ap_uint<64> > &timestampStream,
                                 hls::stream<securityId_t> &securityIdStream,
                                 hls::stream<orderBookOperation_t> &operationStream)
 {
@@ -232,6 +274,7 @@ void FeedHandler::fixDecoderTop(ap_uint<32> &regProcessFix,
     fixDecoder(regProcessFix,
                fixMsgFifoAlign,
                templateIdStream,
+               timestampStream,
                securityIdStream,
                operationStream);
 
@@ -242,6 +285,14 @@ void FeedHandler::symbolLookup(ap_uint<32> &regCaptureControl,
                                ap_uint<32> &regTxOperation,
                                ap_uint<32> regSymbolMap[NUM_SYMBOL],
                                ap_uint<256> &regCaptureBuffer,
+                               ap_uint<32> &regLatencyControl,
+                               ap_uint<32> &regLatencyCount,
+                               ap_uint<32> &regLatencyMin,
+                               ap_uint<32> &regLatencyMax,
+                               ap_uint<32> &regLatencyBin,
+                               ap_uint<32> &regLatencySumLower,
+                               ap_uint<32> &regLatencySumUpper,
+                               hls::stream<ap_uint<64> > &timeStream,
                                hls::stream<securityId_t> &securityIdStream,
                                hls::stream<orderBookOperation_t> &operationStream,
                                hls::stream<orderBookOperationPack_t> &operationStreamPack)
@@ -255,8 +306,12 @@ void FeedHandler::symbolLookup(ap_uint<32> &regCaptureControl,
     bool indexMatch;
 
     static ap_uint<32> countTxOperation=0;
+    static LatencyHistogram latency;
+    static LatencyClock latencyClock;
+
+    ap_uint<64> timeNow = latencyClock.now(timeStream);
 
-    if(!securityIdStream.empty() && !operationStream.empty())
+    if(!securityIdStream.empty() && !operationStream.empty() && !operationStreamPack.full())
     {
         securityIdStream.read(securityId);
         operationStream.read(operation);
@@ -283,11 +338,20 @@ void FeedHandler::symbolLookup(ap_uint<32> &regCaptureControl,
             }
 
             ++countTxOperation;
+            latency.record(regLatencyControl, timeNow, operation.ingressTimestamp);
         }
     }
 
     regTxOperation = countTxOperation;
 
+    latency.update(regLatencyControl,
+                   regLatencyCount,
+                   regLatencyMin,
+                   regLatencyMax,
+                   regLatencyBin,
+                   regLatencySumLower,
+                   regLatencySumUpper);
+
     return;
 }
 
@@ -319,6 +383,7 @@ void FeedHandler::eventHandler(ap_uint<32> &regRxEvent,
 void FeedHandler::fixDecoder(ap_uint<32> &regProcessFix,
                              hls::stream<axiWord_t> &inputStream,
                              hls::stream<templateId_t> &templateIdStream,
+                             hls::stream<ap_uint<64> > &timestampStream,
                              hls::stream<securityId_t> &securityIdStream,
                              hls::stream<orderBookOperation_t> &operationStream)
 {
@@ -330,6 +395,7 @@ void FeedHandler::fixDecoder(ap_uint<32> &regProcessFix,
     axiWord_t currWord;
 
     static ap_uint<16> currTmplID=0;
+    static ap_uint<64> currTimestamp=0;
     static ap_uint<32> countProcessFix=0;
 
     switch(stateId)
@@ -339,6 +405,7 @@ void FeedHandler::fixDecoder(ap_uint<32> &regProcessFix,
             if(!templateIdStream.empty())
             {
                 templateIdStream.read(currTmplID);
+                timestampStream.read(currTimestamp);
                 stateId = DECODE;
             }
 
@@ -354,6 +421,7 @@ void FeedHandler::fixDecoder(ap_uint<32> &regProcessFix,
                     // support currently limited to single message type
                     case 32:
                         MDIncrementalRefreshBook32(currWord,
+                                                   currTimestamp,
                                                    securityIdStream,
                                                    operationStream);
                         break;
@@ -378,6 +446,7 @@ void FeedHandler::fixDecoder(ap_uint<32> &regProcessFix,
 }
 
 void FeedHandler::MDIncrementalRefreshBook32(axiWord_t &fixData,
+                                             ap_uint<64> ingressTimestamp,
                                              hls::stream<securityId_t> &securityIdStream,
                                              hls::stream<orderBookOperation_t> &operationStream)
 {
@@ -500,6 +569,7 @@ void FeedHandler::MDIncrementalRefreshBook32(axiWord_t &fixData,
                     Sreg.shift(fixData);
                     // process previous word
                     operation.timestamp = time;
+                    operation.ingressTimestamp = ingressTimestamp;
                     operation.direction = (entryType-0x30); // ascii to OB decimal encoding
                     operation.level = priceLevel;
                     operation.opCode = updateAction;
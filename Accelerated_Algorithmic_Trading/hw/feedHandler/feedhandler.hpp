@@ -22,6 +22,7 @@
 #include "ap_shift_reg.h"
 #include "aat_defines.hpp"
 #include "aat_interfaces.hpp"
+#include "aat_latency.hpp"
 
 #define FH_LOOKUP_DISABLE (1<<5)
 #define FH_FILTER_DISABLE (1<<4)
@@ -35,7 +36,7 @@ typedef struct feedHandlerRegControl_t
 {
     ap_uint<32> control;
     ap_uint<32> capture;
-    ap_uint<32> reserved02;
+    ap_uint<32> latency;
     ap_uint<32> reserved03;
     ap_uint<32> reserved04;
     ap_uint<32> reserved05;
@@ -75,17 +76,29 @@ public:
 
     void udpPacketHandler(ap_uint<32> &regProcessWord,
                           ap_uint<32> &regProcessPacket,
-                          hls::stream<axiWordExt_t> &inputStream,
-                          hls::stream<axiWord_t> &outputStream);
+                          ap_uint<32> &regLatencyControl,
+                          ap_uint<32> &regLatencyCount,
+                          ap_uint<32> &regLatencyMin,
+                          ap_uint<32> &regLatencyMax,
+                          ap_uint<32> &regLatencyBin,
+                          ap_uint<32> &regLatencySumLower,
+                          ap_uint<32> &regLatencySumUpper,
+                          hls::stream<ap_uint<64> > &timeStream,
+                          hls::stream<axiWordTimestampExt_t> &inputStream,
+                          hls::stream<axiWord_t> &outputStream,
+                          hls::stream<ap_uint<64> > &timestampStream);
 
     void binaryPacketHandler(ap_uint<32> &regProcessBinary,
                              hls::stream<axiWord_t> &inputStream,
                              hls::stream<axiWord_t> &outputStream,
-                             hls::stream<templateId_t> &templateIdStream);
+                             hls::stream<templateId_t> &templateIdStream,
+                             hls::stream<ap_uint<64> > &packetTimestampStream,
+                             hls::stream<ap_uint<64> > &messageTimestampStream);
 
     void fixDecoderTop(ap_uint<32> &regProcessFix,
                        hls::stream<axiWord_t> &inputStream,
                        hls::stream<templateId_t> &templateIdStream,
+                       hls::stream<ap_uint<64> > &timestampStream,
                        hls::stream<securityId_t> &securityIdStream,
                        hls::stream<orderBookOperation_t> &operationStream);
 
@@ -93,6 +106,14 @@ public:
                       ap_uint<32> &regTxOperation,
                       ap_uint<32> regSymbolMap[NUM_SYMBOL],
                       ap_uint<256> &regCaptureBuffer,
+                      ap_uint<32> &regLatencyControl,
+                      ap_uint<32> &regLatencyCount,
+                      ap_uint<32> &regLatencyMin,
+                      ap_uint<32> &regLatencyMax,
+                      ap_uint<32> &regLatencyBin,
+                      ap_uint<32> &regLatencySumLower,
+                      ap_uint<32> &regLatencySumUpper,
+                      hls::stream<ap_uint<64> > &timeStream,
                       hls::stream<securityId_t> &securityIdStream,
                       hls::stream<orderBookOperation_t> &operationStream,
                       hls::stream<orderBookOperationPack_t> &operationStreamPack);
@@ -105,10 +126,12 @@ private:
     void fixDecoder(ap_uint<32> &regProcessFix,
                     hls::stream<axiWord_t> &inputStream,
                     hls::stream<templateId_t> &templateIdStream,
+                    hls::stream<ap_uint<64> > &timestampStream,
                     hls::stream<securityId_t> &securityIdStream,
                     hls::stream<orderBookOperation_t> &operationStream);
 
     void MDIncrementalRefreshBook32(axiWord_t &fixData,
+                                    ap_uint<64> ingressTimestamp,
                                     hls::stream<securityId_t> &securityIdStream,
                                     hls::stream<orderBookOperation_t> &operationStream);
 
@@ -23,8 +23,10 @@ extern "C" void feedHandlerTop(feedHandlerRegControl_t &regControl,
                                feedHandlerRegStatus_t &regStatus,
                                regSymbolMapContainer_t &regSymbolMap,
                                ap_uint<256> &regCapture,
-                               hls::stream<axiWordExt_t> &inputDataFeed,
+                               hls::stream<axiWordTimestampExt_t> &inputDataFeed,
                                hls::stream<orderBookOperationPack_t> &operationStreamPack,
-                               hls::stream<clockTickGeneratorEvent_t> &eventStream);
+                               hls::stream<clockTickGeneratorEvent_t> &eventStream,
+                               latencyRegStatus_t &regLatencyStatus,
+                               latencyRegStatus_t &regIngressLatencyStatus);
 
 #endif
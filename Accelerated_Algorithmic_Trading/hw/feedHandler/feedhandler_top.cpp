@@ -20,18 +20,24 @@ extern "C" void feedHandlerTop(feedHandlerRegControl_t &regControl,
                                feedHandlerRegStatus_t &regStatus,
                                regSymbolMapContainer_t &regSymbolMap,
                                ap_uint<256> &regCapture,
-                               hls::stream<axiWordExt_t> &inputDataStream,
+                               hls::stream<axiWordTimestampExt_t> &inputDataStream,
                                hls::stream<orderBookOperationPack_t> &operationStreamPack,
-                               hls::stream<clockTickGeneratorEvent_t> &eventStream)
+                               hls::stream<clockTickGeneratorEvent_t> &eventStream,
+                               latencyRegStatus_t &regLatencyStatus,
+                               latencyRegStatus_t &regIngressLatencyStatus)
 {
 #pragma HLS INTERFACE s_axilite port=regControl bundle=control
 #pragma HLS INTERFACE s_axilite port=regStatus bundle=control
 #pragma HLS INTERFACE s_axilite port=regSymbolMap bundle=control
 #pragma HLS INTERFACE s_axilite port=regCapture bundle=control
+#pragma HLS INTERFACE s_axilite port=regLatencyStatus bundle=control
+#pragma HLS INTERFACE s_axilite port=regIngressLatencyStatus bundle=control
 #pragma HLS INTERFACE ap_none port=regControl
 #pragma HLS INTERFACE ap_none port=regStatus
 #pragma HLS INTERFACE ap_none port=regSymbolMap
 #pragma HLS INTERFACE ap_none port=regCapture
+#pragma HLS INTERFACE ap_none port=regLatencyStatus
+#pragma HLS INTERFACE ap_none port=regIngressLatencyStatus
 #pragma HLS INTERFACE axis port=inputDataStream
 #pragma HLS INTERFACE axis port=operationStreamPack
 #pragma HLS INTERFACE axis port=eventStream
@@ -40,35 +46,58 @@ extern "C" void feedHandlerTop(feedHandlerRegControl_t &regControl,
     static hls::stream<axiWord_t> mdpDataFifo;
     static hls::stream<axiWord_t> fixMsgFifo;
     static hls::stream<templateId_t> templateIdFifo;
+    static hls::stream<ap_uint<64> > packetTimestampFifo;
+    static hls::stream<ap_uint<64> > messageTimestampFifo;
     static hls::stream<securityId_t> securityIdFifo;
     static hls::stream<orderBookOperation_t> operationFifo;
 
 #pragma HLS STREAM variable=mdpDataFifo
 #pragma HLS STREAM variable=fixMsgFifo
 #pragma HLS STREAM variable=templateIdFifo
+#pragma HLS STREAM variable=packetTimestampFifo
+#pragma HLS STREAM variable=messageTimestampFifo
 #pragma HLS STREAM variable=securityIdFifo
 #pragma HLS STREAM variable=operationFifo
 
     static FeedHandler kernel;
+    static LatencyTimeBase timeBase;
+    static hls::stream<ap_uint<64> > timeStream[2];
 
 #pragma HLS DISAGGREGATE variable=regControl
 #pragma HLS DISAGGREGATE variable=regStatus
+#pragma HLS DISAGGREGATE variable=regLatencyStatus
+#pragma HLS DISAGGREGATE variable=regIngressLatencyStatus
 #pragma HLS STABLE variable=regSymbolMap
+#pragma HLS STREAM variable=timeStream depth=2
 #pragma HLS DATAFLOW disable_start_propagation
 
+    timeBase.count<2>(timeStream);
+
     kernel.udpPacketHandler(regStatus.processWord,
                             regStatus.processPacket,
+                            regControl.latency,
+                            regIngressLatencyStatus.count,
+                            regIngressLatencyStatus.min,
+                            regIngressLatencyStatus.max,
+                            regIngressLatencyStatus.bin,
+                            regIngressLatencyStatus.sumLower,
+                            regIngressLatencyStatus.sumUpper,
+                            timeStream[0],
                             inputDataStream,
-                            mdpDataFifo);
+                            mdpDataFifo,
+                            packetTimestampFifo);
 
     kernel.binaryPacketHandler(regStatus.processBinary,
                                mdpDataFifo,
                                fixMsgFifo,
-                               templateIdFifo);
+                               templateIdFifo,
+                               packetTimestampFifo,
+                               messageTimestampFifo);
 
     kernel.fixDecoderTop(regStatus.processFix,
                          fixMsgFifo,
                          templateIdFifo,
+                         messageTimestampFifo,
                          securityIdFifo,
                          operationFifo);
 
@@ -76,6 +105,14 @@ extern "C" void feedHandlerTop(feedHandlerRegControl_t &regControl,
                         regStatus.txOperation,
                         regSymbolMap.symbols,
                         regCapture,
+                        regControl.latency,
+                        regLatencyStatus.count,
+                        regLatencyStatus.min,
+                        regLatencyStatus.max,
+                        regLatencyStatus.bin,
+                        regLatencyStatus.sumLower,
+                        regLatencyStatus.sumUpper,
+                        timeStream[1],
                         securityIdFifo,
                         operationFifo,
                         operationStreamPack);
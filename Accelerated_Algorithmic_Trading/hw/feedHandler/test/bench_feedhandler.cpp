@@ -0,0 +1,206 @@
+/*
+ * Copyright 2021 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+#include "feedhandler_kernels.hpp"
+#include "aat_bench.hpp"
+
+#define NUM_PACKET           (54)
+#define NUM_FRAME_PER_PACKET (13)
+
+// words held in the input stream ahead of the kernel, and calls made after
+// the last packet to flush the pipeline
+#define BENCH_BACKLOG_WORDS  (4*NUM_FRAME_PER_PACKET)
+#define BENCH_DRAIN_CALLS    (64)
+
+static ap_uint<64> byteReverse(ap_uint<64> inputData)
+{
+    ap_uint<64> reversed = (inputData.range(7,0),
+                            inputData.range(15,8),
+                            inputData.range(23,16),
+                            inputData.range(31,24),
+                            inputData.range(39,32),
+                            inputData.range(47,40),
+                            inputData.range(55,48),
+                            inputData.range(63,56));
+
+    return reversed;
+}
+
+static AatBench bench("feedHandler", 1000000);
+
+static feedHandlerRegControl_t regControl={0};
+static feedHandlerRegStatus_t regStatus={0};
+static regSymbolMapContainer_t regSymbolContainer;
+static ap_uint<256> regCapture=0x0;
+static latencyRegStatus_t regLatencyStatus={0};
+static latencyRegStatus_t regIngressLatencyStatus={0};
+
+static hls::stream<axiWordTimestampExt_t> inputDataStream;
+static hls::stream<orderBookOperationPack_t> operationStreamPack;
+static hls::stream<clockTickGeneratorEvent_t> eventStream;
+
+static void feedHandlerCall(void)
+{
+    feedHandlerTop(regControl,
+                   regStatus,
+                   regSymbolContainer,
+                   regCapture,
+                   inputDataStream,
+                   operationStreamPack,
+                   eventStream,
+                   regLatencyStatus,
+                   regIngressLatencyStatus);
+    bench.call();
+
+    while(!operationStreamPack.empty())
+    {
+        operationStreamPack.read();
+        bench.output();
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    axiWordTimestampExt_t axiw;
+    std::vector<std::vector<axiWordTimestampExt_t> > packets;
+    std::vector<std::vector<uint8_t> > payloads;
+    uint64_t packetIndex=0;
+
+    if(!bench.parseArgs(argc, argv))
+    {
+        return 1;
+    }
+
+    memset(&regSymbolContainer, 0, sizeof(regSymbolContainer));
+
+    axiw.strb = 0xFF;
+    axiw.user = 0;
+
+    if(NULL == bench.pcapPath())
+    {
+        // golden packets from the functional testbench
+        ap_uint<64> inputWords[NUM_PACKET][NUM_FRAME_PER_PACKET] =
+        {
+#include "input_golden.dat"
+        };
+
+        for(int packet=0; packet<NUM_PACKET; packet++)
+        {
+            packets.push_back(std::vector<axiWordTimestampExt_t>());
+            for(int frame=0; frame<NUM_FRAME_PER_PACKET; frame++)
+            {
+                axiw.data = byteReverse(inputWords[packet][frame]);
+                axiw.keep = 0xFF;
+                axiw.last = ((NUM_FRAME_PER_PACKET-1) == frame);
+                packets.back().push_back(axiw);
+            }
+        }
+    }
+    else
+    {
+        // UDP payloads from capture, first byte on the wire in the low lane
+        if(!aatBenchLoadPcap(bench.pcapPath(), payloads))
+        {
+            std::cout << "ERROR: unable to read " << bench.pcapPath() << std::endl;
+            return 1;
+        }
+
+        for(unsigned packet=0; packet<payloads.size(); packet++)
+        {
+            if(payloads[packet].empty())
+            {
+                continue;
+            }
+
+            packets.push_back(std::vector<axiWordTimestampExt_t>());
+            for(unsigned i=0; i<payloads[packet].size(); i+=8)
+            {
+                axiw.data = 0;
+                axiw.keep = 0;
+                for(unsigned j=0; (j<8) && ((i+j)<payloads[packet].size()); j++)
+                {
+                    axiw.data.range((8*j)+7, 8*j) = payloads[packet][i+j];
+                    axiw.keep[j] = 1;
+                }
+                axiw.last = ((i+8) >= payloads[packet].size());
+                packets.back().push_back(axiw);
+            }
+        }
+
+        if(packets.empty())
+        {
+            std::cout << "ERROR: no UDP payloads in " << bench.pcapPath() << std::endl;
+            return 1;
+        }
+    }
+
+    // symbol map as functional testbench, security ID of golden messages at 9
+    regControl.control = 0x00000000;
+    regSymbolContainer.symbols[0] = 0x11111111;
+    regSymbolContainer.symbols[1] = 0x22222222;
+    regSymbolContainer.symbols[2] = 0x33333333;
+    regSymbolContainer.symbols[3] = 0x44444444;
+    regSymbolContainer.symbols[4] = 0x55555555;
+    regSymbolContainer.symbols[5] = 0x66666666;
+    regSymbolContainer.symbols[6] = 0x77777777;
+    regSymbolContainer.symbols[7] = 0x88888888;
+    regSymbolContainer.symbols[8] = 0x99999999;
+    regSymbolContainer.symbols[9] = 0x12345678;
+
+    bench.start();
+
+    while(bench.running())
+    {
+        // replay packets in order, each stamped as it enters the backlog
+        if(inputDataStream.size() < BENCH_BACKLOG_WORDS)
+        {
+            std::vector<axiWordTimestampExt_t> &packet = packets[packetIndex++ % packets.size()];
+
+            for(unsigned frame=0; frame<packet.size(); frame++)
+            {
+                axiw = packet[frame];
+                axiw.user = bench.timestamp();
+                inputDataStream.write(axiw);
+            }
+            bench.event();
+        }
+
+        feedHandlerCall();
+    }
+
+    for(int i=0; i<BENCH_DRAIN_CALLS; i++)
+    {
+        feedHandlerCall();
+    }
+
+    bench.stop();
+
+    // packets left behind in the backlog when the call limit is reached
+    while(!inputDataStream.empty())
+    {
+        inputDataStream.read();
+    }
+
+    bench.probe("INGRESS", regIngressLatencyStatus);
+    bench.probe("EGRESS", regLatencyStatus);
+
+    return bench.report();
+}
@@ -22,6 +22,8 @@
 
 #define NUM_PACKET           (54)
 #define NUM_FRAME_PER_PACKET (13)
+#define NUM_OPERATION        (54)
+#define NUM_OPERATION_FIELD  (10)
 
 // TODO: templated byteReverse function for various widths in common
 ap_uint<64> byteReverse(ap_uint<64> inputData)
@@ -44,13 +46,18 @@ int main()
     feedHandlerRegStatus_t regStatus={0};
     regSymbolMapContainer_t regSymbolContainer;
     ap_uint<256> regCapture=0x0;
+    latencyRegStatus_t regLatencyStatus={0};
+    latencyRegStatus_t regIngressLatencyStatus={0};
+    int numUnstamped=0;
+    int numOperation=0;
+    int numMismatch=0;
 
     mmInterface intf;
-    axiWordExt_t axiw;
+    axiWordTimestampExt_t axiw;
     orderBookOperation_t operation;
     orderBookOperationPack_t operationPack;
 
-    hls::stream<axiWordExt_t> inputDataStream;
+    hls::stream<axiWordTimestampExt_t> inputDataStream;
     hls::stream<orderBookOperationPack_t> operationStreamPack;
     hls::stream<clockTickGeneratorEvent_t> eventStream;
 
@@ -69,6 +76,12 @@ int main()
 #include "input_golden.dat"
     };
 
+    // expected operations, also checked against the software FeedDecoder by aat_unit_test
+    int64_t outputOperations[NUM_OPERATION][NUM_OPERATION_FIELD] =
+    {
+#include "output_golden.dat"
+    };
+
     // configure
     regControl.control = 0x00000000;
 
@@ -95,7 +108,9 @@ int main()
                 axiw.last = 1;
             }
 
+            // ingress timestamp as stamped by LineHandler, never zero
             axiw.data = byteReverse(inputWords[packet][frame]);
+            axiw.user = (packet+1);
             inputDataStream.write(axiw);
         }
 
@@ -108,7 +123,9 @@ int main()
                            regCapture,
                            inputDataStream,
                            operationStreamPack,
-                           eventStream);
+                           eventStream,
+                           regLatencyStatus,
+                           regIngressLatencyStatus);
         }
     }
 
@@ -122,7 +139,9 @@ int main()
                        regCapture,
                        inputDataStream,
                        operationStreamPack,
-                       eventStream);
+                       eventStream,
+                       regLatencyStatus,
+                       regIngressLatencyStatus);
     }
 
     // drain
@@ -140,7 +159,34 @@ int main()
                   << operation.quantity << ","
                   << operation.price << ","
                   << operation.direction << ","
-                  << operation.level << std::endl;
+                  << operation.level << ","
+                  << operation.ingressTimestamp << std::endl;
+
+        if(0 == operation.ingressTimestamp)
+        {
+            ++numUnstamped;
+        }
+
+        if(numOperation < NUM_OPERATION)
+        {
+            int64_t *expected = outputOperations[numOperation];
+
+            if((expected[0] != (int64_t)operation.timestamp) ||
+               (expected[1] != (int64_t)operation.opCode) ||
+               (expected[2] != (int64_t)operation.symbolIndex) ||
+               (expected[3] != (int64_t)operation.orderId) ||
+               (expected[4] != (int64_t)operation.orderCount) ||
+               (expected[5] != (int64_t)operation.quantity) ||
+               (expected[6] != (int64_t)operation.price) ||
+               (expected[7] != (int64_t)operation.direction) ||
+               (expected[8] != (int64_t)operation.level) ||
+               (expected[9] != (int64_t)operation.ingressTimestamp))
+            {
+                std::cout << "MISMATCH: operation " << numOperation << std::endl;
+                ++numMismatch;
+            }
+        }
+        ++numOperation;
     }
 
     // log final status
@@ -152,8 +198,35 @@ int main()
     std::cout << "FH_PROCESS_FIX=" << regStatus.processFix << " ";
     std::cout << "FH_TX_OP=" << regStatus.txOperation << " ";
     std::cout << "FH_RX_EVENT=" << regStatus.rxEvent << " ";
+    std::cout << "FH_LATENCY_COUNT=" << regLatencyStatus.count << " ";
+    std::cout << "FH_LATENCY_MAX=" << regLatencyStatus.max << " ";
+    std::cout << "FH_INGRESS_LATENCY_COUNT=" << regIngressLatencyStatus.count << " ";
+    std::cout << "FH_INGRESS_LATENCY_MAX=" << regIngressLatencyStatus.max << " ";
     std::cout << std::endl;
 
+    // every operation carries the ingress timestamp of its packet through
+    if((0 != numUnstamped) || (regLatencyStatus.count != regStatus.txOperation))
+    {
+        std::cout << "ERROR: operations missing ingress timestamp" << std::endl;
+        return 1;
+    }
+
+    // ingress probe sees every packet once, and always ahead of its operations
+    if((regIngressLatencyStatus.count != regStatus.processPacket) ||
+       (regIngressLatencyStatus.max > regLatencyStatus.max) ||
+       (regIngressLatencyStatus.min > regLatencyStatus.min))
+    {
+        std::cout << "ERROR: ingress probe inconsistent with egress probe" << std::endl;
+        return 1;
+    }
+
+    // decoded operations match output_golden.dat
+    if((NUM_OPERATION != numOperation) || (0 != numMismatch))
+    {
+        std::cout << "ERROR: " << std::dec << numOperation << " operations, " << numMismatch << " differ from golden output" << std::endl;
+        return 1;
+    }
+
     std::cout << std::endl;
     std::cout << "Done!" << std::endl;
 
@@ -20,6 +20,7 @@ set KERNEL_DIR [pwd]
 open_project -reset prj
 
 add_files ${COMMON_DIR}/aat_interfaces.cpp -cflags "-I${COMMON_DIR} -I${KERNEL_DIR}"
+add_files ${COMMON_DIR}/aat_latency.cpp -cflags "-I${COMMON_DIR} -I${KERNEL_DIR}"
 add_files ${KERNEL_DIR}/feedhandler.cpp -cflags "-I${COMMON_DIR} -I${KERNEL_DIR}"
 add_files ${KERNEL_DIR}/feedhandler_top.cpp  -cflags "-I${COMMON_DIR} -I${KERNEL_DIR}"
 
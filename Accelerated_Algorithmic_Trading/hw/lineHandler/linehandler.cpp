@@ -17,6 +17,7 @@
 #include <iostream>
 #include "linehandler.hpp"
 
+template <int W>
 void LineFilter::portFilter(ap_uint<32> regControl,
                             ap_uint<32> regEchoAddress,
                             ap_uint<32> regEchoPort,
@@ -28,90 +29,104 @@ void LineFilter::portFilter(ap_uint<32> regControl,
                             ap_uint<32> &regDropWord,
                             ap_uint<32> &regDebugAddress,
                             ap_uint<32> &regDebugPort,
-                            hls::stream<axiWordExt_t> &inputStream,
+                            hls::stream<ap_uint<64> > &timeStream,
+                            hls::stream<ap_axis<W,0,0,0> > &inputStream,
                             hls::stream<ipUdpMetaPackExt_t> &inputMetaStream,
-                            hls::stream<axiWordExt_t> &echoStream,
+                            hls::stream<ap_axis<W,0,0,0> > &echoStream,
                             hls::stream<ipUdpMetaPackExt_t> &echoMetaStream,
-                            hls::stream<axiWord_t> &outputStream,
-                            hls::stream<lhSplitId_t> &portIdStream)
+                            hls::stream<axis<W> > &outputStream,
+                            hls::stream<lhSplitId_t> &portIdStream,
+                            hls::stream<ap_uint<64> > &timestampStream)
 {
 #pragma HLS pipeline II=1 style=flp
 
     mmInterface intf;
     ipUdpMetaPackExt_t currMetaPackExt, echoMetaPackExt;
-    axiWordExt_t currDataExt;
+    ap_axis<W,0,0,0> currDataExt;
     ipUdpMeta_t currMeta, echoMeta;
     ipUdpMetaPack_t currMetaPack, echoMetaPack;
-    axiWord_t currData;
+    axis<W> currData;
 
     ap_uint<NUM_FILTERS> filterChk=0;
 
-    switch (iid_state)
+    // packet is stamped on the cycle its metadata is accepted as the earliest
+    // point it is visible to the kernels
+    ap_uint<64> timeNow = latencyClock.now(timeStream);
+
+    // echo path is only checked for space while it is in use
+    bool echoReady = ((0 == (LH_ECHO_ENABLE & regControl)) ||
+                      (!echoStream.full() && !echoMetaStream.full()));
+
+    // metadata is taken together with the first word of its datagram, back to
+    // back datagrams are filtered without an idle cycle between them, every
+    // output is checked for space first so the filter never blocks
+    if((GET_VALID == iid_state) && !inputMetaStream.empty() && !inputStream.empty() && !outputStream.full() &&
+       !portIdStream.full() && !timestampStream.full() && echoReady)
     {
-        case GET_VALID:
-            if(!inputMetaStream.empty())
-            {
-                inputMetaStream.read(currMetaPackExt);
-                currMetaPack.data = currMetaPackExt.data;
-                currMetaPack.keep = currMetaPackExt.keep;
-                currMetaPack.last = currMetaPackExt.last;
-                intf.udpMetaUnpack(&currMetaPack, &currMeta);
-                ++countRxMeta;
+        inputMetaStream.read(currMetaPackExt);
+        currMetaPack.data = currMetaPackExt.data;
+        currMetaPack.keep = currMetaPackExt.keep;
+        currMetaPack.last = currMetaPackExt.last;
+        intf.udpMetaUnpack(&currMetaPack, &currMeta);
+        ++countRxMeta;
 
-                regDebugAddress = currMeta.srcAddress;
-                regDebugPort = 0x0000ffff & currMeta.srcPort;
+        regDebugAddress = currMeta.srcAddress;
+        regDebugPort = 0x0000ffff & currMeta.srcPort;
 
-                if(LH_FILTER_DISABLE & regControl)
-                {
-                    // use splitId = 0 by default
-                    portIdStream.write(0);
-                    iid_state = FWD;
-                }
-                else
-                {
-                    // parallel lookup of configured filters for address and port match
-                    for(unsigned i=0; i<NUM_FILTERS; ++i)
-                    {
+        if(LH_FILTER_DISABLE & regControl)
+        {
+            // use splitId = 0 by default
+            portIdStream.write(0);
+            timestampStream.write(timeNow);
+            iid_state = FWD;
+        }
+        else
+        {
+            // parallel lookup of configured filters for address and port match
+            for(unsigned i=0; i<NUM_FILTERS; ++i)
+            {
 #pragma HLS UNROLL
-                        filterChk[(NUM_FILTERS-1)-i] =
-                            ((currMeta.srcAddress == regFilterAddress[i]) && (currMeta.srcPort == regFilterPort[i]));
-                    }
-
-                    if(filterChk != 0)
-                    {
-                        // filterChk register contains a list of all the filters that match the IP addr & port in a way
-                        // that a 1 in position n means that the n-th filter contains a match. To figure out to which
-                        // split id to associate with this packet we perform a leading one detect e.g:
-                        //     filterChk = '0001000' (4th filter from the MSB is valid)
-                        //     filterChk.countLeadingZeros() == 3
-                        const lhSplitId_t chkIdx = lhSplitId_t(filterChk.countLeadingZeros());
-                        portIdStream.write(regFilterSplitIdx[chkIdx]);
-                        iid_state = FWD;
-                    }
-                    else
-                    {
-                        iid_state = DROP;
-                    }
-                }
+                filterChk[(NUM_FILTERS-1)-i] =
+                    ((currMeta.srcAddress == regFilterAddress[i]) && (currMeta.srcPort == regFilterPort[i]));
+            }
 
-                // debug functionality to send all ingress UDP packets back to the tx stream
-                if(LH_ECHO_ENABLE & regControl)
-                {
-                    echoMeta.srcAddress = regEchoAddress;
-                    echoMeta.srcPort = regEchoPort;
-                    intf.udpMetaPack(&echoMeta, &echoMetaPack);
+            if(filterChk != 0)
+            {
+                // filterChk register contains a list of all the filters that match the IP addr & port in a way
+                // that a 1 in position n means that the n-th filter contains a match. To figure out to which
+                // split id to associate with this packet we perform a leading one detect e.g:
+                //     filterChk = '0001000' (4th filter from the MSB is valid)
+                //     filterChk.countLeadingZeros() == 3
+                const lhSplitId_t chkIdx = lhSplitId_t(filterChk.countLeadingZeros());
+                portIdStream.write(regFilterSplitIdx[chkIdx]);
+                timestampStream.write(timeNow);
+                iid_state = FWD;
+            }
+            else
+            {
+                iid_state = DROP;
+            }
+        }
 
-                    echoMetaPackExt.data = echoMetaPack.data;
-                    echoMetaPackExt.keep = -1;
-                    echoMetaPackExt.last = true;
+        // debug functionality to send all ingress UDP packets back to the tx stream
+        if(LH_ECHO_ENABLE & regControl)
+        {
+            echoMeta.srcAddress = regEchoAddress;
+            echoMeta.srcPort = regEchoPort;
+            intf.udpMetaPack(&echoMeta, &echoMetaPack);
 
-                    echoMetaStream.write(echoMetaPackExt);
-                }
-            }
-            break;
+            echoMetaPackExt.data = echoMetaPack.data;
+            echoMetaPackExt.keep = -1;
+            echoMetaPackExt.last = true;
 
+            echoMetaStream.write(echoMetaPackExt);
+        }
+    }
+
+    switch (iid_state)
+    {
         case FWD:
-            if(!inputStream.empty() && !outputStream.full())
+            if(!inputStream.empty() && !outputStream.full() && echoReady)
             {
                 inputStream.read(currDataExt);
                 currData.data = currDataExt.data;
@@ -133,7 +148,7 @@ void LineFilter::portFilter(ap_uint<32> regControl,
             break;
 
         case DROP:
-            if(!inputStream.empty())
+            if(!inputStream.empty() && echoReady)
             {
                 inputStream.read(currDataExt);
                 ++countDropWord;
@@ -149,6 +164,9 @@ void LineFilter::portFilter(ap_uint<32> regControl,
                 }
             }
             break;
+
+        default:
+            break;
     }
 
     regRxWord   = countRxWord;
@@ -158,6 +176,47 @@ void LineFilter::portFilter(ap_uint<32> regControl,
     return;
 }
 
+// 64 bit feed datapath and 512 bit wide receive chain
+template void LineFilter::portFilter<64>(ap_uint<32> regControl,
+                                         ap_uint<32> regEchoAddress,
+                                         ap_uint<32> regEchoPort,
+                                         ap_uint<32> regFilterAddress[NUM_FILTERS],
+                                         ap_uint<32> regFilterPort[NUM_FILTERS],
+                                         ap_uint<32> regFilterSplitIdx[NUM_FILTERS],
+                                         ap_uint<32> &regRxWord,
+                                         ap_uint<32> &regRxMeta,
+                                         ap_uint<32> &regDropWord,
+                                         ap_uint<32> &regDebugAddress,
+                                         ap_uint<32> &regDebugPort,
+                                         hls::stream<ap_uint<64> > &timeStream,
+                                         hls::stream<ap_axis<64,0,0,0> > &inputStream,
+                                         hls::stream<ipUdpMetaPackExt_t> &inputMetaStream,
+                                         hls::stream<ap_axis<64,0,0,0> > &echoStream,
+                                         hls::stream<ipUdpMetaPackExt_t> &echoMetaStream,
+                                         hls::stream<axis<64> > &outputStream,
+                                         hls::stream<lhSplitId_t> &portIdStream,
+                                         hls::stream<ap_uint<64> > &timestampStream);
+
+template void LineFilter::portFilter<512>(ap_uint<32> regControl,
+                                          ap_uint<32> regEchoAddress,
+                                          ap_uint<32> regEchoPort,
+                                          ap_uint<32> regFilterAddress[NUM_FILTERS],
+                                          ap_uint<32> regFilterPort[NUM_FILTERS],
+                                          ap_uint<32> regFilterSplitIdx[NUM_FILTERS],
+                                          ap_uint<32> &regRxWord,
+                                          ap_uint<32> &regRxMeta,
+                                          ap_uint<32> &regDropWord,
+                                          ap_uint<32> &regDebugAddress,
+                                          ap_uint<32> &regDebugPort,
+                                          hls::stream<ap_uint<64> > &timeStream,
+                                          hls::stream<ap_axis<512,0,0,0> > &inputStream,
+                                          hls::stream<ipUdpMetaPackExt_t> &inputMetaStream,
+                                          hls::stream<ap_axis<512,0,0,0> > &echoStream,
+                                          hls::stream<ipUdpMetaPackExt_t> &echoMetaStream,
+                                          hls::stream<axis<512> > &outputStream,
+                                          hls::stream<lhSplitId_t> &portIdStream,
+                                          hls::stream<ap_uint<64> > &timestampStream);
+
 void LineHandler::lineArbitrator(ap_uint<32> regControlArb,
                                  ap_uint<32> regResetTimerInterval,
                                  ap_uint<32> &regTotalSent,
@@ -169,11 +228,27 @@ void LineHandler::lineArbitrator(ap_uint<32> regControlArb,
                                  ap_uint<32> &regTxFeed1,
                                  ap_uint<32> &regDiscarded0,
                                  ap_uint<32> &regDiscarded1,
+                                 ap_uint<32> regLatencyControl,
+                                 ap_uint<32> &regLatencyCount,
+                                 ap_uint<32> &regLatencyMin,
+                                 ap_uint<32> &regLatencyMax,
+                                 ap_uint<32> &regLatencyBin,
+                                 ap_uint<32> &regLatencySumLower,
+                                 ap_uint<32> &regLatencySumUpper,
+                                 ap_uint<32> &regIngressLatencyCount,
+                                 ap_uint<32> &regIngressLatencyMin,
+                                 ap_uint<32> &regIngressLatencyMax,
+                                 ap_uint<32> &regIngressLatencyBin,
+                                 ap_uint<32> &regIngressLatencySumLower,
+                                 ap_uint<32> &regIngressLatencySumUpper,
+                                 hls::stream<ap_uint<64> > &timeStream,
                                  hls::stream<axiWord_t> &port0Strm,
                                  hls::stream<axiWord_t> &port1Strm,
                                  hls::stream<lhSplitId_t> &splitIdStrm0,
                                  hls::stream<lhSplitId_t> &splitIdStrm1,
-                                 hls::stream<axiWordExt_t> &outputFeed)
+                                 hls::stream<ap_uint<64> > &timestampStrm0,
+                                 hls::stream<ap_uint<64> > &timestampStrm1,
+                                 hls::stream<axiWordTimestampExt_t> &outputFeed)
 {
 #pragma HLS PIPELINE II=1 style=flp
 
@@ -189,7 +264,11 @@ void LineHandler::lineArbitrator(ap_uint<32> regControlArb,
     static iid_StateType iid_state = ARB_FETCH;
 
     static axiWord_t wordIn;
-    static axiWordExt_t wordOut;
+    static axiWordTimestampExt_t wordOut;
+    static LatencyHistogram latency;
+    static LatencyHistogram ingressLatency;
+    static LatencyClock latencyClock;
+    static ap_uint<64> ingressTimestamp=0;
     static ap_uint<32> resetTimerCounter=0;
     static ap_uint<1> activePort=1;
     static lhSplitId_t splitId=0;
@@ -197,6 +276,8 @@ void LineHandler::lineArbitrator(ap_uint<32> regControlArb,
     static seqNum_t seqNumExpected[NUM_SPLITS] = {0};
     static bool arbForward=false;
 
+    ap_uint<64> timeNow = latencyClock.now(timeStream);
+
     static ap_uint<32> countTotalSent=0;
     static ap_uint<32> countTotalWordSent=0;
     static ap_uint<32> countTotalMissed=0;
@@ -225,6 +306,12 @@ void LineHandler::lineArbitrator(ap_uint<32> regControlArb,
         }
     }
 
+    // a packet is only fetched while the feed has space for its first frame,
+    // this is the only writer so the space remains when it is forwarded from
+    // ARB_DECODE and the arbitrator does not block on the feed
+    bool fetchReady0 = (!port0Strm.empty() && !splitIdStrm0.empty() && !timestampStrm0.empty() && !outputFeed.full());
+    bool fetchReady1 = (!port1Strm.empty() && !splitIdStrm1.empty() && !timestampStrm1.empty() && !outputFeed.full());
+
     // main state machine for line arbitration
     switch(iid_state)
     {
@@ -235,38 +322,42 @@ void LineHandler::lineArbitrator(ap_uint<32> regControlArb,
             // TODO: better way to do round robin without code duplication?
             if(1 == activePort)
             {
-                if(!port0Strm.empty())
+                if(fetchReady0)
                 {
                     activePort = 0;
                     wordIn = port0Strm.read();
                     splitId = splitIdStrm0.read();
+                    ingressTimestamp = timestampStrm0.read();
                     seqNumReceived = wordIn.data(SEQ_NUM_WIDTH-1, 0);
                     iid_state = ARB_DECODE;
                 }
-                else if(!port1Strm.empty())
+                else if(fetchReady1)
                 {
                     activePort = 1;
                     wordIn = port1Strm.read();
                     splitId = splitIdStrm1.read();
+                    ingressTimestamp = timestampStrm1.read();
                     seqNumReceived = wordIn.data(SEQ_NUM_WIDTH-1, 0);
                     iid_state = ARB_DECODE;
                 }
             }
             else
             {
-                if(!port1Strm.empty())
+                if(fetchReady1)
                 {
                     activePort = 1;
                     wordIn = port1Strm.read();
                     splitId = splitIdStrm1.read();
+                    ingressTimestamp = timestampStrm1.read();
                     seqNumReceived = wordIn.data(SEQ_NUM_WIDTH-1, 0);
                     iid_state = ARB_DECODE;
                 }
-                else if(!port0Strm.empty())
+                else if(fetchReady0)
                 {
                     activePort = 0;
                     wordIn = port0Strm.read();
                     splitId = splitIdStrm0.read();
+                    ingressTimestamp = timestampStrm0.read();
                     seqNumReceived = wordIn.data(SEQ_NUM_WIDTH-1, 0);
                     iid_state = ARB_DECODE;
                 }
@@ -326,7 +417,9 @@ void LineHandler::lineArbitrator(ap_uint<32> regControlArb,
                 }
             }
 
-            // one state transition per packet, can update RX counters here
+            // one state transition per packet, can update RX counters here,
+            // ingress probe samples every arbitrated packet including drops
+            ingressLatency.record(regLatencyControl, timeNow, ingressTimestamp);
             if(0 == activePort)
             {
                 ++countRxFeed0;
@@ -339,12 +432,15 @@ void LineHandler::lineArbitrator(ap_uint<32> regControlArb,
             // forward or drop the first packet frame read in ARB_FETCH
             if(arbForward)
             {
+                // ingress timestamp accompanies every frame of the packet
                 wordOut.data = wordIn.data;
                 wordOut.keep = wordIn.keep;
                 wordOut.last = wordIn.last;
+                wordOut.user = ingressTimestamp;
                 outputFeed.write(wordOut);
                 ++countTotalWordSent;
                 ++countTotalSent;
+                latency.record(regLatencyControl, timeNow, ingressTimestamp);
 
                 // single 'ARB_FORWARD' state could be used here to reduce code
                 // duplication but splitting reduces nested conditional checks
@@ -381,12 +477,13 @@ void LineHandler::lineArbitrator(ap_uint<32> regControlArb,
         case ARB_FORWARD_0:
         {
             // read and forward all frames from physical port 0 up until EOP
-            if(!port0Strm.empty())
+            if(!port0Strm.empty() && !outputFeed.full())
             {
                 wordIn = port0Strm.read();
                 wordOut.data = wordIn.data;
                 wordOut.keep = wordIn.keep;
                 wordOut.last = wordIn.last;
+                wordOut.user = ingressTimestamp;
                 outputFeed.write(wordOut);
                 ++countTotalWordSent;
             }
@@ -403,12 +500,13 @@ void LineHandler::lineArbitrator(ap_uint<32> regControlArb,
         case ARB_FORWARD_1:
         {
             // read and forward all frames from physical port 1 up until EOP
-            if(!port1Strm.empty())
+            if(!port1Strm.empty() && !outputFeed.full())
             {
                 wordIn = port1Strm.read();
                 wordOut.data = wordIn.data;
                 wordOut.keep = wordIn.keep;
                 wordOut.last = wordIn.last;
+                wordOut.user = ingressTimestamp;
                 outputFeed.write(wordOut);
                 ++countTotalWordSent;
             }
@@ -466,6 +564,22 @@ void LineHandler::lineArbitrator(ap_uint<32> regControlArb,
     regTxFeed1       = countTxFeed1;
     regDiscarded0    = countDiscarded0;
     regDiscarded1    = countDiscarded1;
+
+    latency.update(regLatencyControl,
+                   regLatencyCount,
+                   regLatencyMin,
+                   regLatencyMax,
+                   regLatencyBin,
+                   regLatencySumLower,
+                   regLatencySumUpper);
+
+    ingressLatency.update(regLatencyControl,
+                          regIngressLatencyCount,
+                          regIngressLatencyMin,
+                          regIngressLatencyMax,
+                          regIngressLatencyBin,
+                          regIngressLatencySumLower,
+                          regIngressLatencySumUpper);
 }
 
 void LineHandler::eventHandler(ap_uint<32> &regRxEvent,
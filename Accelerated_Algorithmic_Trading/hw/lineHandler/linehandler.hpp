@@ -21,8 +21,9 @@
 #include <ap_int.h>
 #include "aat_defines.hpp"
 #include "aat_interfaces.hpp"
+#include "aat_latency.hpp"
 
-#ifndef __SYNTHESIS__
+#if !defined(__SYNTHESIS__) && !defined(_LH_DEBUG_EN)
 #define _LH_DEBUG_EN 1
 #endif
 
@@ -123,8 +124,11 @@ class LineFilter
     ap_uint<32> countRxWord=0;
     ap_uint<32> countRxMeta=0;
     ap_uint<32> countDropWord=0;
+    LatencyClock latencyClock;
 
   public:
+    // generic over the datagram word width W, instantiated for 64 and 512 bits
+    template <int W>
     void portFilter(ap_uint<32> regControl,
                     ap_uint<32> regEchoAddress,
                     ap_uint<32> regEchoPort,
@@ -136,12 +140,14 @@ class LineFilter
                     ap_uint<32> &regDropWord,
                     ap_uint<32> &regDebugAddress,
                     ap_uint<32> &regDebugPort,
-                    hls::stream<axiWordExt_t> &inputStream,
+                    hls::stream<ap_uint<64> > &timeStream,
+                    hls::stream<ap_axis<W,0,0,0> > &inputStream,
                     hls::stream<ipUdpMetaPackExt_t> &inputMetaStream,
-                    hls::stream<axiWordExt_t> &echoStream,
+                    hls::stream<ap_axis<W,0,0,0> > &echoStream,
                     hls::stream<ipUdpMetaPackExt_t> &echoMetaStream,
-                    hls::stream<axiWord_t> &outputStream,
-                    hls::stream<lhSplitId_t> &splitIdStream);
+                    hls::stream<axis<W> > &outputStream,
+                    hls::stream<lhSplitId_t> &splitIdStream,
+                    hls::stream<ap_uint<64> > &timestampStream);
 };
 
 class LineHandler
@@ -163,11 +169,27 @@ class LineHandler
                         ap_uint<32> &regTxFeed1,
                         ap_uint<32> &regDiscarded0,
                         ap_uint<32> &regDiscarded1,
+                        ap_uint<32> regLatencyControl,
+                        ap_uint<32> &regLatencyCount,
+                        ap_uint<32> &regLatencyMin,
+                        ap_uint<32> &regLatencyMax,
+                        ap_uint<32> &regLatencyBin,
+                        ap_uint<32> &regLatencySumLower,
+                        ap_uint<32> &regLatencySumUpper,
+                        ap_uint<32> &regIngressLatencyCount,
+                        ap_uint<32> &regIngressLatencyMin,
+                        ap_uint<32> &regIngressLatencyMax,
+                        ap_uint<32> &regIngressLatencyBin,
+                        ap_uint<32> &regIngressLatencySumLower,
+                        ap_uint<32> &regIngressLatencySumUpper,
+                        hls::stream<ap_uint<64> > &timeStream,
                         hls::stream<axiWord_t> &port0Strm,
                         hls::stream<axiWord_t> &port1Strm,
                         hls::stream<lhSplitId_t> &splitIdStrm0,
                         hls::stream<lhSplitId_t> &splitIdStrm1,
-                        hls::stream<axiWordExt_t> &outputFeed);
+                        hls::stream<ap_uint<64> > &timestampStrm0,
+                        hls::stream<ap_uint<64> > &timestampStrm1,
+                        hls::stream<axiWordTimestampExt_t> &outputFeed);
 
     void eventHandler(ap_uint<32> &regRxEvent,
                       hls::stream<clockTickGeneratorEvent_t> &eventStream);
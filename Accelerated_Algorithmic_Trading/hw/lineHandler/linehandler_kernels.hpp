@@ -32,7 +32,10 @@ extern "C" void lineHandlerTop(lineHandlerRegControl_t &regControl,
                                hls::stream<ipUdpMetaPackExt_t> &inputMetaPort1,
                                hls::stream<axiWordExt_t> &outputDataPort1,
                                hls::stream<ipUdpMetaPackExt_t> &outputMetaPort1,
-                               hls::stream<axiWordExt_t> &outputArbDataFeed,
-                               hls::stream<clockTickGeneratorEvent_t> &eventStream);
+                               hls::stream<axiWordTimestampExt_t> &outputArbDataFeed,
+                               hls::stream<clockTickGeneratorEvent_t> &eventStream,
+                               ap_uint<32> &regLatencyControl,
+                               latencyRegStatus_t &regLatencyStatus,
+                               latencyRegStatus_t &regIngressLatencyStatus);
 
 #endif // LINEHANDLER_KERNELS_H
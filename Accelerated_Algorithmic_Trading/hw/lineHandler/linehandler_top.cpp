@@ -27,12 +27,18 @@ extern "C" void lineHandlerTop(lineHandlerRegControl_t &regControl,
                                hls::stream<ipUdpMetaPackExt_t> &inputMetaPort1,
                                hls::stream<axiWordExt_t> &outputDataPort1,
                                hls::stream<ipUdpMetaPackExt_t> &outputMetaPort1,
-                               hls::stream<axiWordExt_t> &outputArbDataFeed,
-                               hls::stream<clockTickGeneratorEvent_t> &eventStream)
+                               hls::stream<axiWordTimestampExt_t> &outputArbDataFeed,
+                               hls::stream<clockTickGeneratorEvent_t> &eventStream,
+                               ap_uint<32> &regLatencyControl,
+                               latencyRegStatus_t &regLatencyStatus,
+                               latencyRegStatus_t &regIngressLatencyStatus)
 {
 #pragma HLS INTERFACE s_axilite port=regControl
 #pragma HLS INTERFACE s_axilite port=regStatus
 #pragma HLS INTERFACE s_axilite port=regPortFilter
+#pragma HLS INTERFACE s_axilite port=regLatencyControl
+#pragma HLS INTERFACE s_axilite port=regLatencyStatus
+#pragma HLS INTERFACE s_axilite port=regIngressLatencyStatus
 #pragma HLS INTERFACE axis port=inputDataPort0
 #pragma HLS INTERFACE axis port=inputMetaPort0
 #pragma HLS INTERFACE axis port=outputDataPort0
@@ -47,6 +53,8 @@ extern "C" void lineHandlerTop(lineHandlerRegControl_t &regControl,
 
 #pragma HLS DISAGGREGATE variable=regControl
 #pragma HLS DISAGGREGATE variable=regStatus
+#pragma HLS DISAGGREGATE variable=regLatencyStatus
+#pragma HLS DISAGGREGATE variable=regIngressLatencyStatus
 #pragma HLS STABLE variable=regPortFilter
 #pragma HLS DATAFLOW disable_start_propagation
 
@@ -55,47 +63,60 @@ extern "C" void lineHandlerTop(lineHandlerRegControl_t &regControl,
     static hls::stream<axiWord_t> port1Filtered;
     static hls::stream<lhSplitId_t> port0SplitId;
     static hls::stream<lhSplitId_t> port1SplitId;
+    static hls::stream<ap_uint<64> > port0Timestamp;
+    static hls::stream<ap_uint<64> > port1Timestamp;
+    static LatencyTimeBase timeBase;
+    static hls::stream<ap_uint<64> > timeStream[3];
 
 #pragma HLS STREAM variable=port0Filtered depth=64
 #pragma HLS STREAM variable=port1Filtered depth=64
 #pragma HLS STREAM variable=port0SplitId depth=64
 #pragma HLS STREAM variable=port1SplitId depth=64
+#pragma HLS STREAM variable=port0Timestamp depth=64
+#pragma HLS STREAM variable=port1Timestamp depth=64
+#pragma HLS STREAM variable=timeStream depth=2
 
-    kernel.port0Filter.portFilter(regControl.controlPort0,
-                                  regControl.echoAddress0,
-                                  regControl.echoPort0,
-                                  regPortFilter.filterAddress0,
-                                  regPortFilter.filterPort0,
-                                  regPortFilter.filterSplitId0,
-                                  regStatus.rxWord0,
-                                  regStatus.rxMeta0,
-                                  regStatus.dropWord0,
-                                  regStatus.debugAddress0,
-                                  regStatus.debugPort0,
-                                  inputDataPort0,
-                                  inputMetaPort0,
-                                  outputDataPort0,
-                                  outputMetaPort0,
-                                  port0Filtered,
-                                  port0SplitId);
+    timeBase.count<3>(timeStream);
 
-    kernel.port1Filter.portFilter(regControl.controlPort1,
-                                  regControl.echoAddress1,
-                                  regControl.echoPort1,
-                                  regPortFilter.filterAddress1,
-                                  regPortFilter.filterPort1,
-                                  regPortFilter.filterSplitId1,
-                                  regStatus.rxWord1,
-                                  regStatus.rxMeta1,
-                                  regStatus.dropWord1,
-                                  regStatus.debugAddress1,
-                                  regStatus.debugPort1,
-                                  inputDataPort1,
-                                  inputMetaPort1,
-                                  outputDataPort1,
-                                  outputMetaPort1,
-                                  port1Filtered,
-                                  port1SplitId);
+    kernel.port0Filter.portFilter<64>(regControl.controlPort0,
+                                      regControl.echoAddress0,
+                                      regControl.echoPort0,
+                                      regPortFilter.filterAddress0,
+                                      regPortFilter.filterPort0,
+                                      regPortFilter.filterSplitId0,
+                                      regStatus.rxWord0,
+                                      regStatus.rxMeta0,
+                                      regStatus.dropWord0,
+                                      regStatus.debugAddress0,
+                                      regStatus.debugPort0,
+                                      timeStream[0],
+                                      inputDataPort0,
+                                      inputMetaPort0,
+                                      outputDataPort0,
+                                      outputMetaPort0,
+                                      port0Filtered,
+                                      port0SplitId,
+                                      port0Timestamp);
+
+    kernel.port1Filter.portFilter<64>(regControl.controlPort1,
+                                      regControl.echoAddress1,
+                                      regControl.echoPort1,
+                                      regPortFilter.filterAddress1,
+                                      regPortFilter.filterPort1,
+                                      regPortFilter.filterSplitId1,
+                                      regStatus.rxWord1,
+                                      regStatus.rxMeta1,
+                                      regStatus.dropWord1,
+                                      regStatus.debugAddress1,
+                                      regStatus.debugPort1,
+                                      timeStream[1],
+                                      inputDataPort1,
+                                      inputMetaPort1,
+                                      outputDataPort1,
+                                      outputMetaPort1,
+                                      port1Filtered,
+                                      port1SplitId,
+                                      port1Timestamp);
 
     kernel.lineArbitrator(regControl.controlArb,
                           regControl.resetTimerInterval,
@@ -108,10 +129,26 @@ extern "C" void lineHandlerTop(lineHandlerRegControl_t &regControl,
                           regStatus.txFeed1,
                           regStatus.discarded0,
                           regStatus.discarded1,
+                          regLatencyControl,
+                          regLatencyStatus.count,
+                          regLatencyStatus.min,
+                          regLatencyStatus.max,
+                          regLatencyStatus.bin,
+                          regLatencyStatus.sumLower,
+                          regLatencyStatus.sumUpper,
+                          regIngressLatencyStatus.count,
+                          regIngressLatencyStatus.min,
+                          regIngressLatencyStatus.max,
+                          regIngressLatencyStatus.bin,
+                          regIngressLatencyStatus.sumLower,
+                          regIngressLatencyStatus.sumUpper,
+                          timeStream[2],
                           port0Filtered,
                           port1Filtered,
                           port0SplitId,
                           port1SplitId,
+                          port0Timestamp,
+                          port1Timestamp,
                           outputArbDataFeed);
 
     kernel.eventHandler(regStatus.rxEvent,
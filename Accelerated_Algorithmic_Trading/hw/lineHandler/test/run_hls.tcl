@@ -28,6 +28,7 @@ open_project -reset $PROJ
 add_files "${KERNEL_ROOT}/linehandler.cpp" -cflags ${CFLAGS}
 add_files "${KERNEL_ROOT}/linehandler_top.cpp" -cflags ${CFLAGS}
 add_files "${CASE_ROOT}/../../common/include/aat_interfaces.cpp" -cflags ${CFLAGS}
+add_files "${CASE_ROOT}/../../common/include/aat_latency.cpp" -cflags ${CFLAGS}
 add_files -tb "tb_linehandler.cpp" -cflags "-I${KERNEL_ROOT} ${CFLAGS}"
 
 set_top lineHandlerTop
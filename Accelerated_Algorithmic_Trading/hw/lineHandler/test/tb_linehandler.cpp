@@ -37,7 +37,7 @@ hls::stream<axiWordExt_t> inputDataStrm0;
 hls::stream<axiWordExt_t> outputDataStrm0;
 hls::stream<axiWordExt_t> inputDataStrm1;
 hls::stream<axiWordExt_t> outputDataStrm1;
-hls::stream<axiWordExt_t> arbDataStrm;
+hls::stream<axiWordTimestampExt_t> arbDataStrm;
 hls::stream<ipUdpMetaPackExt_t> inputMetaStrm0;
 hls::stream<ipUdpMetaPackExt_t> outputMetaStrm0;
 hls::stream<ipUdpMetaPackExt_t> inputMetaStrm1;
@@ -77,15 +77,24 @@ static void preparePacket(hls::stream<axiWordExt_t> &data,
     }
 }
 
-static std::vector<uint32_t> gatherArbitratedSeqs(hls::stream<axiWordExt_t> &strm)
+static unsigned numUnstampedWords=0;
+
+static std::vector<uint32_t> gatherArbitratedSeqs(hls::stream<axiWordTimestampExt_t> &strm)
 {
-    axiWord_t axiw;
+    axiWordTimestampExt_t axiw;
     std::vector<uint32_t> ret;
     bool isFirst=true;
 
     while(!strm.empty())
     {
         axiw = strm.read();
+
+        // every arbitrated frame carries the ingress timestamp of its packet
+        if(0 == axiw.user)
+        {
+            ++numUnstampedWords;
+        }
+
         if(isFirst)
         {
             uint32_t seqNum = axiw.data(31, 0);
@@ -124,6 +133,9 @@ int main()
     lineHandlerRegControl_t regControl = {0};
     lineHandlerRegStatus_t regStatus = {0};
     regPortFilterContainer_t regPortFilter;
+    ap_uint<32> regLatencyControl = 0;
+    latencyRegStatus_t regLatencyStatus = {0};
+    latencyRegStatus_t regIngressLatencyStatus = {0};
 
     std::cout << "LineHandler Test" << std::endl;
     std::cout << "----------------" << std::endl;
@@ -183,7 +195,10 @@ int main()
                        outputDataStrm1,
                        outputMetaStrm1,
                        arbDataStrm,
-                       eventStrm);
+                       eventStrm,
+                       regLatencyControl,
+                       regLatencyStatus,
+                       regIngressLatencyStatus);
     }
 
     // dummy drain
@@ -201,7 +216,10 @@ int main()
                        outputDataStrm1,
                        outputMetaStrm1,
                        arbDataStrm,
-                       eventStrm);
+                       eventStrm,
+                       regLatencyControl,
+                       regLatencyStatus,
+                       regIngressLatencyStatus);
     }
 
     // drain and print sequence messages
@@ -235,6 +253,12 @@ int main()
     std::cout << "txFeed1="       << regStatus.txFeed1       << std::endl;
     std::cout << "discarded0="    << regStatus.discarded0    << std::endl;
     std::cout << "discarded1="    << regStatus.discarded1    << std::endl;
+    std::cout << "latencyCount="  << regLatencyStatus.count  << std::endl;
+    std::cout << "latencyMin="    << regLatencyStatus.min    << std::endl;
+    std::cout << "latencyMax="    << regLatencyStatus.max    << std::endl;
+    std::cout << "ingressCount="  << regIngressLatencyStatus.count << std::endl;
+    std::cout << "ingressMin="    << regIngressLatencyStatus.min   << std::endl;
+    std::cout << "ingressMax="    << regIngressLatencyStatus.max   << std::endl;
     std::cout << std::endl;
 
     // check received packets are in expected order
@@ -257,6 +281,22 @@ int main()
         }
     }
 
+    // each forwarded packet contributes one sample to the stage latency
+    if((0 != numUnstampedWords) || (regLatencyStatus.count != expectedPackets.size()))
+    {
+        std::cerr << "ERROR: Ingress timestamp missing from " << numUnstampedWords << " frames, "
+                  << regLatencyStatus.count << " latency samples" << std::endl;
+        error = 1;
+    }
+
+    // every packet reaching the arbitrator is sampled at ingress, forwarded or not
+    if(regIngressLatencyStatus.count != (regStatus.rxFeed0 + regStatus.rxFeed1))
+    {
+        std::cerr << "ERROR: " << regIngressLatencyStatus.count << " ingress latency samples for "
+                  << (regStatus.rxFeed0 + regStatus.rxFeed1) << " arbitrated packets" << std::endl;
+        error = 1;
+    }
+
     if(error)
     {
         std::cout << "FAILURE!" << std::endl;
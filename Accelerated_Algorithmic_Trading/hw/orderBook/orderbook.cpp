@@ -21,6 +21,14 @@
  * OrderBook Core
  */
 void OrderBook::operationPull(ap_uint<32> &regRxOperation,
+                              ap_uint<32> &regLatencyControl,
+                              ap_uint<32> &regLatencyCount,
+                              ap_uint<32> &regLatencyMin,
+                              ap_uint<32> &regLatencyMax,
+                              ap_uint<32> &regLatencyBin,
+                              ap_uint<32> &regLatencySumLower,
+                              ap_uint<32> &regLatencySumUpper,
+                              hls::stream<ap_uint<64> > &timeStream,
                               hls::stream<orderBookOperationPack_t> &operationStreamPack,
                               hls::stream<orderBookOperation_t> &operationStream)
 {
@@ -31,17 +39,30 @@ void OrderBook::operationPull(ap_uint<32> &regRxOperation,
     orderBookOperation_t operation, operationExpected;
 
     static ap_uint<32> countRxOperation=0;
+    static LatencyHistogram latency;
+    static LatencyClock latencyClock;
 
-    if(!operationStreamPack.empty())
+    ap_uint<64> timeNow = latencyClock.now(timeStream);
+
+    if(!operationStreamPack.empty() && !operationStream.full())
     {
         operationPack = operationStreamPack.read();
         intf.orderBookOperationUnpack(&operationPack, &operation);
         operationStream.write(operation);
         ++countRxOperation;
+        latency.record(regLatencyControl, timeNow, operation.ingressTimestamp);
     }
 
     regRxOperation = countRxOperation;
 
+    latency.update(regLatencyControl,
+                   regLatencyCount,
+                   regLatencyMin,
+                   regLatencyMax,
+                   regLatencyBin,
+                   regLatencySumLower,
+                   regLatencySumUpper);
+
     return;
 }
 
@@ -139,6 +160,7 @@ void OrderBook::operationProcess(ap_uint<32> &regProcessOperation,
         // TODO: 56b timestamp to pack within 1024b total, to increase to 64b support may split
         //       bid/ask into separate response messages as book operation should hit one side only
         response.timestamp = timestamp.range(55,0);
+        response.ingressTimestamp = operation.ingressTimestamp;
         response.symbolIndex = symbolIndex;
         response.bidCount = orderBookBidCount[symbolIndex];
         response.bidPrice = orderBookBidPrice[symbolIndex];
@@ -627,6 +649,14 @@ void OrderBook::responsePush(ap_uint<32> &regControl,
                              ap_uint<32> &regCaptureControl,
                              ap_uint<32> &regTxResponse,
                              ap_uint<1024> &regCaptureBuffer,
+                             ap_uint<32> &regLatencyControl,
+                             ap_uint<32> &regLatencyCount,
+                             ap_uint<32> &regLatencyMin,
+                             ap_uint<32> &regLatencyMax,
+                             ap_uint<32> &regLatencyBin,
+                             ap_uint<32> &regLatencySumLower,
+                             ap_uint<32> &regLatencySumUpper,
+                             hls::stream<ap_uint<64> > &timeStream,
                              hls::stream<orderBookResponse_t> &responseStream,
                              hls::stream<orderBookResponsePack_t> &responseStreamPack,
                              hls::stream<orderBookResponsePack_t> &dataMoveStreamPack)
@@ -638,14 +668,23 @@ void OrderBook::responsePush(ap_uint<32> &regControl,
     orderBookResponsePack_t responsePack;
 
     static ap_uint<32> countTxResponse=0;
+    static LatencyHistogram latency;
+    static LatencyClock latencyClock;
+
+    ap_uint<64> timeNow = latencyClock.now(timeStream);
 
-    if(!responseStream.empty())
+    // outputs are checked for space before the response is taken so the
+    // process never blocks and the latency clock is read on every cycle
+    if(!responseStream.empty() &&
+       !responseStreamPack.full() &&
+       ((0 == (OB_DM_FWD_ENABLE & regControl)) || !dataMoveStreamPack.full()))
     {
         response = responseStream.read();
 
         intf.orderBookResponsePack(&response, &responsePack);
         responseStreamPack.write(responsePack);
         ++countTxResponse;
+        latency.record(regLatencyControl, timeNow, response.ingressTimestamp);
 
         if(OB_DM_FWD_ENABLE & regControl)
         {
@@ -662,6 +701,14 @@ void OrderBook::responsePush(ap_uint<32> &regControl,
 
     regTxResponse = countTxResponse;
 
+    latency.update(regLatencyControl,
+                   regLatencyCount,
+                   regLatencyMin,
+                   regLatencyMax,
+                   regLatencyBin,
+                   regLatencySumLower,
+                   regLatencySumUpper);
+
     return;
 }
 
@@ -734,7 +781,7 @@ void OrderBook::responseMove(ap_uint<32> &regControl,
 
 void OrderBook::operationMove(ap_uint<32> &regControl,
                               ap_uint<32> &regIndexTail,
-                              ap_uint<32> &regRxThrottleRate,
+                              ap_uint<32> &regRxCreditLimit,
                               ap_uint<32> &regIndexHead,
                               ap_uint<32> &regRxOperation,
                               ap_uint<32> &regLatencyMin,
@@ -742,23 +789,28 @@ void OrderBook::operationMove(ap_uint<32> &regControl,
                               ap_uint<32> &regLatencySum,
                               ap_uint<32> &regLatencyCount,
                               ap_uint<32> &regCyclesPost,
-                              ap_uint<32> &regRxThrottleCount,
-                              ap_uint<32> &regRxThrottleEvent,
+                              ap_uint<32> &regRxCreditAvailable,
+                              ap_uint<32> &regRxCreditStall,
                               ap_uint<256> ringBuffer[OB_DM_RING_BUF_LEN],
-                              hls::stream<orderEntryOperationPack_t> &operationStreamPack)
+                              hls::stream<orderEntryOperationPack_t> &operationStreamPack,
+                              hls::stream<orderEntryCredit_t> &creditStream)
 {
 #pragma HLS PIPELINE II=1 style=flp
 
     mmInterface intf;
     orderEntryOperationPack_t operationPack;
     orderEntryOperation_t operation;
+    orderEntryCredit_t credit;
     ap_uint<32> latencyDiff;
+    ap_uint<32> creditLimit;
+    ap_uint<32> creditOutstanding;
 
     static ap_uint<32> countCycles=0;
     static ap_uint<16> countIndexHead=0;
     static ap_uint<32> countRxOperation=0;
-    static ap_uint<32> countRxThrottle=0;
-    static ap_uint<32> countRxBackpressure=0;
+    static ap_uint<32> countCreditUsed=0;
+    static ap_uint<32> countCreditReturn=0;
+    static ap_uint<32> countRxCreditStall=0;
 
     static ap_uint<32> latencyMin=0xffffffff;
     static ap_uint<32> latencyMax=0;
@@ -782,19 +834,38 @@ void OrderBook::operationMove(ap_uint<32> &regControl,
         }
     }
 
-    // use rate throttle to account for software stalls where data can back up
-    // in H2C ring buffer, OrderEntry operations expand to minumum of 32 frames
-    // in OrderEntry send, without a throttle this expansion can saturate that
-    // kernel and result in deadlock, alternative approach would be to buffer
-    // operations downstream before the send but data is already buffered here,
-    // simple addition of dispatch rate seems like the logical approach
-    if(0 == countRxThrottle)
+    // credits are returned by OrderEntry as each operation has been expanded
+    // to frames for the TCP kernel, operations expand to minimum of 32 frames
+    // in OrderEntry send so dispatch is gated on capacity being available
+    // downstream rather than a fixed rate sized for the worst case, this
+    // avoids saturating that kernel when software stalls back up data in the
+    // H2C ring buffer while adding no idle cycles when capacity exists
+    if(!creditStream.empty())
+    {
+        credit = creditStream.read();
+        countCreditReturn += credit.data;
+    }
+
+    if(0 == regRxCreditLimit)
+    {
+        creditLimit = OB_DM_CREDIT_DEFAULT;
+    }
+    else
+    {
+        creditLimit = regRxCreditLimit;
+    }
+
+    creditOutstanding = (countCreditUsed - countCreditReturn);
+
+    // TODO: buffer wrap checks needed?
+    if(countIndexHead != regIndexTail)
     {
-        // TODO: buffer wrap checks needed?
-        if(countIndexHead != regIndexTail)
+        if(creditOutstanding < creditLimit)
         {
             // read from ring buffer, advance head pointer
+            // host operations did not originate from a received packet
             operationPack.data = ringBuffer[countIndexHead++];
+            operationPack.user = 0;
             ++countRxOperation;
 
             // debug control to disable forwarding operations
@@ -802,15 +873,13 @@ void OrderBook::operationMove(ap_uint<32> &regControl,
             if(OB_DM_HALT & regControl)
             {
                 // nop
-                countRxThrottle = 0;
             }
             else
             {
-                // forward to OrderEntry
+                // forward to OrderEntry, consuming a credit
                 operationStreamPack.write(operationPack);
-
-                // reset rate throttle, must decrement to 0 before next dispatch
-                countRxThrottle = regRxThrottleRate;
+                ++countCreditUsed;
+                ++creditOutstanding;
             }
 
             // rtt latency measurement
@@ -841,14 +910,10 @@ void OrderBook::operationMove(ap_uint<32> &regControl,
                 }
             }
         }
-    }
-    else
-    {
-        --countRxThrottle;
-        if((countIndexHead != regIndexTail) && (0 == countRxThrottle))
+        else
         {
-            // update received from host while under throttle
-            ++countRxBackpressure;
+            // update received from host while no credit available
+            ++countRxCreditStall;
         }
     }
 
@@ -859,8 +924,8 @@ void OrderBook::operationMove(ap_uint<32> &regControl,
     regLatencySum = latencySum;
     regLatencyCount = latencyCount;
     regCyclesPost = countCycles;
-    regRxThrottleCount = countRxThrottle;
-    regRxThrottleEvent = countRxBackpressure;
+    regRxCreditAvailable = (creditOutstanding < creditLimit) ? (ap_uint<32>)(creditLimit - creditOutstanding) : (ap_uint<32>)0;
+    regRxCreditStall = countRxCreditStall;
 
     return;
 }
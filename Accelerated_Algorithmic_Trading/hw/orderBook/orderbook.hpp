@@ -21,6 +21,7 @@
 #include "ap_int.h"
 #include "aat_defines.hpp"
 #include "aat_interfaces.hpp"
+#include "aat_latency.hpp"
 
 #define OB_DM_RING_BUF_LEN (65536)
 
@@ -36,12 +37,16 @@
 #define OB_DM_RTT_ENABLE (1<<1)
 #define OB_DM_HALT       (1<<0)
 
+// OrderBookDataMover operations in flight to OrderEntry when no credit limit
+// has been programmed by host
+#define OB_DM_CREDIT_DEFAULT (4)
+
 typedef struct orderBookRegControl_t
 {
     ap_uint<32> control;
     ap_uint<32> config;
     ap_uint<32> capture;
-    ap_uint<32> reserved03;
+    ap_uint<32> latency;
     ap_uint<32> reserved04;
     ap_uint<32> reserved05;
     ap_uint<32> reserved06;
@@ -81,7 +86,7 @@ typedef struct orderBookDataMoverRegControl_t
     ap_uint<32> control;
     ap_uint<32> indexTxHead;
     ap_uint<32> indexRxTail;
-    ap_uint<32> rxThrottleRate;
+    ap_uint<32> rxCreditLimit;
     ap_uint<32> reserved04;
     ap_uint<32> reserved05;
     ap_uint<32> reserved06;
@@ -101,8 +106,8 @@ typedef struct orderBookDataMoverRegStatus_t
     ap_uint<32> latencyCount;
     ap_uint<32> cyclesPre;
     ap_uint<32> cyclesPost;
-    ap_uint<32> rxThrottleCount;
-    ap_uint<32> rxThrottleEvent;
+    ap_uint<32> rxCreditAvailable;
+    ap_uint<32> rxCreditStall;
     ap_uint<32> reserved13;
     ap_uint<32> reserved14;
     ap_uint<32> reserved15;
@@ -116,6 +121,14 @@ class OrderBook
 public:
 
     void operationPull(ap_uint<32> &regRxOperation,
+                       ap_uint<32> &regLatencyControl,
+                       ap_uint<32> &regLatencyCount,
+                       ap_uint<32> &regLatencyMin,
+                       ap_uint<32> &regLatencyMax,
+                       ap_uint<32> &regLatencyBin,
+                       ap_uint<32> &regLatencySumLower,
+                       ap_uint<32> &regLatencySumUpper,
+                       hls::stream<ap_uint<64> > &timeStream,
                        hls::stream<orderBookOperationPack_t> &operationStreamPack,
                        hls::stream<orderBookOperation_t> &operationStream);
 
@@ -184,6 +197,14 @@ public:
                       ap_uint<32> &regCaptureControl,
                       ap_uint<32> &regTxResponse,
                       ap_uint<1024> &regCaptureBuffer,
+                      ap_uint<32> &regLatencyControl,
+                      ap_uint<32> &regLatencyCount,
+                      ap_uint<32> &regLatencyMin,
+                      ap_uint<32> &regLatencyMax,
+                      ap_uint<32> &regLatencyBin,
+                      ap_uint<32> &regLatencySumLower,
+                      ap_uint<32> &regLatencySumUpper,
+                      hls::stream<ap_uint<64> > &timeStream,
                       hls::stream<orderBookResponse_t> &responseStream,
                       hls::stream<orderBookResponsePack_t> &responseStreamPack,
                       hls::stream<orderBookResponsePack_t> &dataMoveStreamPack);
@@ -198,7 +219,7 @@ public:
 
     void operationMove(ap_uint<32> &regControl,
                        ap_uint<32> &regIndexTail,
-                       ap_uint<32> &regRxThrottleRate,
+                       ap_uint<32> &regRxCreditLimit,
                        ap_uint<32> &regIndexHead,
                        ap_uint<32> &regRxOperation,
                        ap_uint<32> &regLatencyMin,
@@ -206,10 +227,11 @@ public:
                        ap_uint<32> &regLatencySum,
                        ap_uint<32> &regLatencyCount,
                        ap_uint<32> &regCyclesPost,
-                       ap_uint<32> &rxThrottleCount,
-                       ap_uint<32> &rxThrottleEvent,
+                       ap_uint<32> &regRxCreditAvailable,
+                       ap_uint<32> &regRxCreditStall,
                        ap_uint<256> ringBuffer[OB_DM_RING_BUF_LEN],
-                       hls::stream<orderEntryOperationPack_t> &operationStreamPack);
+                       hls::stream<orderEntryOperationPack_t> &operationStreamPack,
+                       hls::stream<orderEntryCredit_t> &creditStream);
 
     void eventHandler(ap_uint<32> &regRxEvent,
                       hls::stream<clockTickGeneratorEvent_t> &eventStream);
@@ -22,7 +22,8 @@ extern "C" void orderBookDataMoverTop(orderBookDataMoverRegControl_t &regControl
                                       ap_uint<1024> *ringBufferTx,
                                       ap_uint<256> *ringBufferRx,
                                       hls::stream<orderBookResponsePack_t> &responseStreamPack,
-                                      hls::stream<orderEntryOperationPack_t> &operationStreamPack)
+                                      hls::stream<orderEntryOperationPack_t> &operationStreamPack,
+                                      hls::stream<orderEntryCredit_t> &creditStreamPack)
 {
 #pragma HLS INTERFACE m_axi port=ringBufferTx offset=slave
 #pragma HLS INTERFACE m_axi port=ringBufferRx offset=slave
@@ -32,6 +33,7 @@ extern "C" void orderBookDataMoverTop(orderBookDataMoverRegControl_t &regControl
 #pragma HLS INTERFACE ap_none port=regStatus
 #pragma HLS INTERFACE axis port=responseStreamPack
 #pragma HLS INTERFACE axis port=operationStreamPack
+#pragma HLS INTERFACE axis port=creditStreamPack
 #pragma HLS INTERFACE s_axilite port=return
 
     static OrderBook kernel;
@@ -53,7 +55,7 @@ extern "C" void orderBookDataMoverTop(orderBookDataMoverRegControl_t &regControl
 
     kernel.operationMove(regControl.control,
                          regControl.indexRxTail,
-                         regControl.rxThrottleRate,
+                         regControl.rxCreditLimit,
                          regStatus.indexRxHead,
                          regStatus.rxOperation,
                          regStatus.latencyMin,
@@ -61,9 +63,10 @@ extern "C" void orderBookDataMoverTop(orderBookDataMoverRegControl_t &regControl
                          regStatus.latencySum,
                          regStatus.latencyCount,
                          regStatus.cyclesPost,
-                         regStatus.rxThrottleCount,
-                         regStatus.rxThrottleEvent,
+                         regStatus.rxCreditAvailable,
+                         regStatus.rxCreditStall,
                          ringBufferRx,
-                         operationStreamPack);
+                         operationStreamPack,
+                         creditStreamPack);
 
 }
@@ -25,13 +25,16 @@ extern "C" void orderBookTop(orderBookRegControl_t &regControl,
                              hls::stream<orderBookOperationPack_t> &operationStreamPack,
                              hls::stream<orderBookResponsePack_t> &responseStreamPack,
                              hls::stream<orderBookResponsePack_t> &dataMoveStreamPack,
-                             hls::stream<clockTickGeneratorEvent_t> &eventStream);
+                             hls::stream<clockTickGeneratorEvent_t> &eventStream,
+                             latencyRegStatus_t &regLatencyStatus,
+                             latencyRegStatus_t &regIngressLatencyStatus);
 
 extern "C" void orderBookDataMoverTop(orderBookDataMoverRegControl_t &regControl,
                                       orderBookDataMoverRegStatus_t &regStatus,
                                       ap_uint<1024> *ringBufferTx,
                                       ap_uint<256> *ringBufferRx,
                                       hls::stream<orderBookResponsePack_t> &responseStreamPack,
-                                      hls::stream<orderEntryOperationPack_t> &operationStreamPack);
+                                      hls::stream<orderEntryOperationPack_t> &operationStreamPack,
+                                      hls::stream<orderEntryCredit_t> &creditStreamPack);
 
 #endif
@@ -23,14 +23,20 @@ extern "C" void orderBookTop(orderBookRegControl_t &regControl,
                              hls::stream<orderBookOperationPack_t> &operationStreamPack,
                              hls::stream<orderBookResponsePack_t> &responseStreamPack,
                              hls::stream<orderBookResponsePack_t> &dataMoveStreamPack,
-                             hls::stream<clockTickGeneratorEvent_t> &eventStream)
+                             hls::stream<clockTickGeneratorEvent_t> &eventStream,
+                             latencyRegStatus_t &regLatencyStatus,
+                             latencyRegStatus_t &regIngressLatencyStatus)
 {
 #pragma HLS INTERFACE s_axilite port=regControl bundle=control
 #pragma HLS INTERFACE s_axilite port=regStatus bundle=control
 #pragma HLS INTERFACE s_axilite port=regCapture bundle=control
+#pragma HLS INTERFACE s_axilite port=regLatencyStatus bundle=control
+#pragma HLS INTERFACE s_axilite port=regIngressLatencyStatus bundle=control
 #pragma HLS INTERFACE ap_none port=regControl
 #pragma HLS INTERFACE ap_none port=regStatus
 #pragma HLS INTERFACE ap_none port=regCapture
+#pragma HLS INTERFACE ap_none port=regLatencyStatus
+#pragma HLS INTERFACE ap_none port=regIngressLatencyStatus
 #pragma HLS INTERFACE axis port=operationStreamPack
 #pragma HLS INTERFACE axis port=responseStreamPack
 #pragma HLS INTERFACE axis port=dataMoveStreamPack
@@ -41,12 +47,27 @@ extern "C" void orderBookTop(orderBookRegControl_t &regControl,
     static hls::stream<orderBookResponse_t> responseStreamFIFO;
 
     static OrderBook kernel;
+    static LatencyTimeBase timeBase;
+    static hls::stream<ap_uint<64> > timeStream[2];
 
 #pragma HLS DISAGGREGATE variable=regControl
 #pragma HLS DISAGGREGATE variable=regStatus
+#pragma HLS DISAGGREGATE variable=regLatencyStatus
+#pragma HLS DISAGGREGATE variable=regIngressLatencyStatus
+#pragma HLS STREAM variable=timeStream depth=2
 #pragma HLS DATAFLOW disable_start_propagation
 
+    timeBase.count<2>(timeStream);
+
     kernel.operationPull(regStatus.rxOperation,
+                         regControl.latency,
+                         regIngressLatencyStatus.count,
+                         regIngressLatencyStatus.min,
+                         regIngressLatencyStatus.max,
+                         regIngressLatencyStatus.bin,
+                         regIngressLatencyStatus.sumLower,
+                         regIngressLatencyStatus.sumUpper,
+                         timeStream[0],
                          operationStreamPack,
                          operationStreamFIFO);
 
@@ -70,6 +91,14 @@ extern "C" void orderBookTop(orderBookRegControl_t &regControl,
                         regControl.capture,
                         regStatus.txResponse,
                         regCapture,
+                        regControl.latency,
+                        regLatencyStatus.count,
+                        regLatencyStatus.min,
+                        regLatencyStatus.max,
+                        regLatencyStatus.bin,
+                        regLatencyStatus.sumLower,
+                        regLatencyStatus.sumUpper,
+                        timeStream[1],
                         responseStreamFIFO,
                         responseStreamPack,
                         dataMoveStreamPack);
@@ -0,0 +1,139 @@
+/*
+ * Copyright 2021 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+
+#include "orderbook_kernels.hpp"
+#include "aat_bench.hpp"
+
+// symbols the synthetic operations are spread over, operations held in the
+// input stream ahead of the kernel and calls made to flush the pipeline
+#define BENCH_NUM_SYMBOL        (16)
+#define BENCH_BACKLOG_OPERATION (16)
+#define BENCH_DRAIN_CALLS       (64)
+
+static AatBench bench("orderBook", 1000000);
+
+static orderBookRegControl_t regControl={0};
+static orderBookRegStatus_t regStatus={0};
+static ap_uint<1024> regCapture=0x0;
+static latencyRegStatus_t regLatencyStatus={0};
+static latencyRegStatus_t regIngressLatencyStatus={0};
+
+static hls::stream<orderBookOperationPack_t> operationStreamPackFIFO;
+static hls::stream<orderBookResponsePack_t> responseStreamPackFIFO;
+static hls::stream<orderBookResponsePack_t> dataMoveStreamPackFIFO;
+static hls::stream<clockTickGeneratorEvent_t> eventStreamFIFO;
+
+static void orderBookCall(void)
+{
+    orderBookTop(regControl,
+                 regStatus,
+                 regCapture,
+                 operationStreamPackFIFO,
+                 responseStreamPackFIFO,
+                 dataMoveStreamPackFIFO,
+                 eventStreamFIFO,
+                 regLatencyStatus,
+                 regIngressLatencyStatus);
+    bench.call();
+
+    while(!responseStreamPackFIFO.empty())
+    {
+        responseStreamPackFIFO.read();
+        bench.output();
+    }
+
+    while(!dataMoveStreamPackFIFO.empty())
+    {
+        dataMoveStreamPackFIFO.read();
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    mmInterface intf;
+    orderBookOperation_t operation;
+    orderBookOperationPack_t operationPack;
+    uint32_t seed=1;
+    uint64_t sequence=0;
+
+    if(!bench.parseArgs(argc, argv))
+    {
+        return 1;
+    }
+
+    memset(&operation, 0, sizeof(operation));
+
+    regControl.control = 0x00000000;
+    regControl.config = 0xdeadbeef;
+    regControl.capture = 0x00000000;
+
+    bench.start();
+
+    while(bench.running())
+    {
+        // level by level updates of a price ladder either side of 10000,
+        // mostly modifies with adds and deletes mixed in as a feed would
+        if(operationStreamPackFIFO.size() < BENCH_BACKLOG_OPERATION)
+        {
+            seed = (seed * 1103515245) + 12345;
+
+            operation.timestamp = 1571145019318770688 + (sequence * 1000);
+            operation.symbolIndex = (sequence % BENCH_NUM_SYMBOL);
+            operation.orderId = sequence;
+            operation.direction = ((seed >> 8) & 0x1);
+            operation.level = ((seed >> 9) % NUM_LEVEL);
+            operation.orderCount = ((seed >> 12) & 0x7) + 1;
+            operation.quantity = ((seed >> 16) & 0x3FF) + 1;
+            operation.price = operation.direction ? (10100 + (operation.level * 100)) : (10000 - (operation.level * 100));
+
+            switch((seed >> 20) & 0x7)
+            {
+                case 0:  operation.opCode = ORDERBOOK_ADD;    break;
+                case 1:  operation.opCode = ORDERBOOK_DELETE; break;
+                default: operation.opCode = ORDERBOOK_MODIFY; break;
+            }
+
+            operation.ingressTimestamp = bench.timestamp();
+            intf.orderBookOperationPack(&operation, &operationPack);
+            operationStreamPackFIFO.write(operationPack);
+            bench.event();
+            ++sequence;
+        }
+
+        orderBookCall();
+    }
+
+    for(int i=0; i<BENCH_DRAIN_CALLS; i++)
+    {
+        orderBookCall();
+    }
+
+    bench.stop();
+
+    while(!operationStreamPackFIFO.empty())
+    {
+        operationStreamPackFIFO.read();
+    }
+
+    bench.probe("INGRESS", regIngressLatencyStatus);
+    bench.probe("EGRESS", regLatencyStatus);
+
+    return bench.report();
+}
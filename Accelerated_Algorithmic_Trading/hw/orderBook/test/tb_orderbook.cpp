@@ -25,6 +25,9 @@ int main()
     orderBookRegControl_t regControl={0};
     orderBookRegStatus_t regStatus={0};
     ap_uint<1024> regCapture=0x0;
+    latencyRegStatus_t regLatencyStatus={0};
+    latencyRegStatus_t regIngressLatencyStatus={0};
+    int numUnstamped=0;
     ap_uint<32> rangeIndexHigh, rangeIndexLow;
     ap_uint<32> bidCount[5], bidPrice[5], bidQuantity[5];
     ap_uint<32> askCount[5], askPrice[5], askQuantity[5];
@@ -108,6 +111,7 @@ int main()
     for(int i=0; i<NUM_TEST_SAMPLE; i++)
     {
         operation = inputOperations[i];
+        operation.ingressTimestamp = (i+1);
         intf.orderBookOperationPack(&operation, &operationPack);
         operationStreamPackFIFO.write(operationPack);
     }
@@ -126,7 +130,9 @@ int main()
                      operationStreamPackFIFO,
                      responseStreamPackFIFO,
                      dataMoveStreamPackFIFO,
-                     eventStreamFIFO);
+                     eventStreamFIFO,
+                     regLatencyStatus,
+                     regIngressLatencyStatus);
     }
 
     // drain response stream
@@ -135,6 +141,11 @@ int main()
         responsePack = responseStreamPackFIFO.read();
         intf.orderBookResponseUnpack(&responsePack, &response);
 
+        if(0 == response.ingressTimestamp)
+        {
+            ++numUnstamped;
+        }
+
         std::cout << "BOOK_RESPONSE[" << response.symbolIndex << "]: BID";
 
         for(int i=0; i<NUM_LEVEL; i++)
@@ -213,9 +224,28 @@ int main()
     std::cout << "OB_DIRECTION_ERR=" << regStatus.directionError << " ";
     std::cout << "OB_LEVEL_ERR=" << regStatus.levelError << " ";
     std::cout << "OB_RX_EVENT=" << regStatus.rxEvent << " ";
+    std::cout << "OB_LATENCY_COUNT=" << regLatencyStatus.count << " ";
+    std::cout << "OB_LATENCY_MAX=" << regLatencyStatus.max << " ";
+    std::cout << "OB_INGRESS_LATENCY_COUNT=" << regIngressLatencyStatus.count << " ";
+    std::cout << "OB_INGRESS_LATENCY_MAX=" << regIngressLatencyStatus.max << " ";
     std::cout << std::endl;
 
     std::cout << std::endl;
+    // ingress timestamp carried from operation through to response
+    if((0 != numUnstamped) || (regLatencyStatus.count != regStatus.txResponse))
+    {
+        std::cout << "ERROR: responses missing ingress timestamp" << std::endl;
+        return 1;
+    }
+
+    // every operation is sampled on the way in, ahead of its response
+    if((regIngressLatencyStatus.count != regStatus.rxOperation) ||
+       (regIngressLatencyStatus.min > regLatencyStatus.min))
+    {
+        std::cout << "ERROR: ingress probe inconsistent with egress probe" << std::endl;
+        return 1;
+    }
+
     std::cout << "Done!" << std::endl;
 
     return 0;
@@ -21,6 +21,7 @@ set CFLAGS "-I${COMMON_DIR} -I${KERNEL_DIR} -std=c++14"
 
 open_project -reset prj_ob
 add_files ${COMMON_DIR}/aat_interfaces.cpp -cflags ${CFLAGS}
+add_files ${COMMON_DIR}/aat_latency.cpp -cflags ${CFLAGS}
 add_files ${KERNEL_DIR}/orderbook.cpp -cflags ${CFLAGS}
 add_files ${KERNEL_DIR}/orderbook_top.cpp  -cflags ${CFLAGS}
 set_top orderBookTop
@@ -35,6 +36,7 @@ close_project
 
 open_project -reset prj_dm
 add_files ${COMMON_DIR}/aat_interfaces.cpp -cflags ${CFLAGS}
+add_files ${COMMON_DIR}/aat_latency.cpp -cflags ${CFLAGS}
 add_files ${KERNEL_DIR}/orderbook.cpp -cflags ${CFLAGS}
 add_files ${KERNEL_DIR}/orderbook_data_mover_top.cpp  -cflags ${CFLAGS}
 set_top orderBookDataMoverTop
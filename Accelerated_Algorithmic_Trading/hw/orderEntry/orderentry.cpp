@@ -22,9 +22,18 @@
  */
 
 void OrderEntry::operationPull(ap_uint<32> &regRxOperation,
+                               ap_uint<32> &regLatencyControl,
+                               ap_uint<32> &regLatencyCount,
+                               ap_uint<32> &regLatencyMin,
+                               ap_uint<32> &regLatencyMax,
+                               ap_uint<32> &regLatencyBin,
+                               ap_uint<32> &regLatencySumLower,
+                               ap_uint<32> &regLatencySumUpper,
+                               hls::stream<ap_uint<64> > &timeStream,
                                hls::stream<orderEntryOperationPack_t> &operationStreamPack,
                                hls::stream<orderEntryOperationPack_t> &operationHostStreamPack,
-                               hls::stream<orderEntryOperation_t> &operationStream)
+                               hls::stream<orderEntryOperation_t> &operationStream,
+                               hls::stream<ap_uint<1> > &operationSourceStream)
 {
 #pragma HLS PIPELINE II=1 style=flp
 
@@ -33,26 +42,45 @@ void OrderEntry::operationPull(ap_uint<32> &regRxOperation,
     orderEntryOperation_t operation;
 
     static ap_uint<32> countRxOperation=0;
+    static LatencyHistogram latency;
+    static LatencyClock latencyClock;
+
+    ap_uint<64> timeNow = latencyClock.now(timeStream);
 
     // priority to direct path from PricingEngine then host offload path
     // TODO: add register control to enable/disable these different paths?
-    if(!operationStreamPack.empty())
+    // both paths are held while the encoder is backed up rather than block
+    // on the write, the latency clock is then read on every cycle
+    bool outputReady = (!operationStream.full() && !operationSourceStream.full());
+
+    if(outputReady && !operationStreamPack.empty())
     {
         operationPack = operationStreamPack.read();
         ++countRxOperation;
         intf.orderEntryOperationUnpack(&operationPack, &operation);
         operationStream.write(operation);
+        operationSourceStream.write(OE_SOURCE_DIRECT);
+        latency.record(regLatencyControl, timeNow, operation.ingressTimestamp);
     }
-    else if(!operationHostStreamPack.empty())
+    else if(outputReady && !operationHostStreamPack.empty())
     {
         operationPack = operationHostStreamPack.read();
         ++countRxOperation;
         intf.orderEntryOperationUnpack(&operationPack, &operation);
         operationStream.write(operation);
+        operationSourceStream.write(OE_SOURCE_HOST);
     }
 
     regRxOperation = countRxOperation;
 
+    latency.update(regLatencyControl,
+                   regLatencyCount,
+                   regLatencyMin,
+                   regLatencyMax,
+                   regLatencyBin,
+                   regLatencySumLower,
+                   regLatencySumUpper);
+
     return;
 }
 
@@ -80,6 +108,7 @@ void OrderEntry::operationEncode(hls::stream<orderEntryOperation_t> &operationSt
         operationEncode.quantity = quantityEncode;
         operationEncode.price = priceEncode;
         operationEncode.direction = operation.direction;
+        operationEncode.ingressTimestamp = operation.ingressTimestamp;
 
         operationEncodeStream.write(operationEncode);
     }
@@ -305,19 +334,58 @@ void OrderEntry::notificationHandlerTcp(ap_uint<32> &regNotification,
 
 void OrderEntry::serverProcessTcp(ap_uint<32> &regRxData,
                                   ap_uint<32> &regRxMeta,
+                                  ap_uint<32> &regRxExecReport,
+                                  ap_uint<32> &regRxExecReject,
                                   hls::stream<ipTcpRxMetaPack_t> &rxMetaStream,
-                                  hls::stream<ipTcpRxDataPack_t> &rxDataStream)
+                                  hls::stream<ipTcpRxDataPack_t> &rxDataStream,
+                                  hls::stream<orderEntryExecReportPack_t> &execReportStream)
 {
 #pragma HLS PIPELINE II=1 style=flp
 
+    mmInterface intf;
     ipTcpRxMetaPack_t rxMetaPack;
     ap_uint<16> sessionID;
-    ap_axiu<64,0,0,0> currWord;
+    orderEntryExecReport_t execReport;
+    orderEntryExecReportPack_t execReportPack;
+    ap_uint<8> rxByte;
+    ap_uint<4> rxDigit;
+    bool rxIsDigit;
+    ap_uint<48> priceScaled;
+    bool execReportReady=false;
 
     static ap_uint<1> state=0;
 
     static ap_uint<32> countRxData=0;
     static ap_uint<32> countRxMeta=0;
+    static ap_uint<32> countRxExecReport=0;
+    static ap_uint<32> countRxExecReject=0;
+
+    // current data word, consumed one byte lane per call so the decimal
+    // accumulate below (x10 + digit) is the only loop carried arithmetic
+    static ap_axiu<64,0,0,0> rxWord;
+    static ap_uint<1> rxWordValid=0;
+    static ap_uint<3> rxLane=0;
+
+    // FIX tag=value parser state, carried across words and segments so
+    // messages may span TCP segment boundaries
+    static ap_uint<1>  parseValue=0;
+    static ap_uint<1>  parseFirst=0;
+    static ap_uint<1>  parseDigits=0;   // at least one digit seen in value
+    static ap_uint<1>  parsePoint=0;    // decimal point seen in value
+    static ap_uint<1>  parseInvalid=0;  // value is not a well formed number
+    static ap_uint<3>  parseFraction=0; // digits kept after the decimal point
+    static ap_uint<16> parseTag=0;
+    static ap_uint<32> parseNumber=0;
+    static ap_uint<8>  parseChar=0;
+    static ap_uint<8>  msgType=0;
+    static ap_uint<8>  ordStatus=0;
+    static ap_uint<1>  msgInvalid=0;
+    static ap_uint<32> clOrdId=0;
+    static ap_uint<32> lastQty=0;
+    static ap_uint<32> lastPx=0;
+
+    // scale applied to LastPx for digits missing after the decimal point
+    const ap_uint<16> priceScale[OE_FIX_PRICE_DECIMALS+1] = {10000, 1000, 100, 10, 1};
 
     switch(state)
     {
@@ -334,21 +402,168 @@ void OrderEntry::serverProcessTcp(ap_uint<32> &regRxData,
         }
         case 1:
         {
-            if(!rxDataStream.empty())
+            if(!rxWordValid && !rxDataStream.empty())
             {
-                currWord = rxDataStream.read();
+                rxWord = rxDataStream.read();
+                rxWordValid = 1;
+                rxLane = 0;
                 ++countRxData;
-                if(currWord.last)
+            }
+
+            if(rxWordValid)
+            {
+                rxByte = rxWord.data.range(7,0);
+                rxDigit = rxByte.range(3,0);
+                rxIsDigit = ((rxByte >= '0') && (rxByte <= '9'));
+
+                if((OE_FIX_SOH == rxByte) || (OE_FIX_DELIMITER == rxByte))
                 {
-                    state = 0;
+                    // numeric fields must hold digits with at most one
+                    // decimal point (LastPx only), anything else invalidates
+                    // the message rather than forwarding a bad value
+                    if(parseValue)
+                    {
+                        switch(parseTag)
+                        {
+                            case OE_FIX_TAG_BEGIN_STRING:
+                                msgType = 0;
+                                ordStatus = 0;
+                                msgInvalid = 0;
+                                clOrdId = 0;
+                                lastQty = 0;
+                                lastPx = 0;
+                                break;
+                            case OE_FIX_TAG_CL_ORD_ID:
+                                clOrdId = parseNumber;
+                                if(parseInvalid || !parseDigits || parsePoint) msgInvalid = 1;
+                                break;
+                            case OE_FIX_TAG_LAST_PX:
+                                priceScaled = (parseNumber * priceScale[parseFraction]);
+                                lastPx = priceScaled.range(31,0);
+                                if(parseInvalid || !parseDigits || (0 != priceScaled.range(47,32))) msgInvalid = 1;
+                                break;
+                            case OE_FIX_TAG_LAST_QTY:
+                                lastQty = parseNumber;
+                                if(parseInvalid || !parseDigits || parsePoint) msgInvalid = 1;
+                                break;
+                            case OE_FIX_TAG_MSG_TYPE:
+                                msgType = parseChar;
+                                break;
+                            case OE_FIX_TAG_ORD_STATUS:
+                                ordStatus = parseChar;
+                                break;
+                            case OE_FIX_TAG_CHECKSUM:
+                                if(OE_FIX_MSG_TYPE_EXEC == msgType)
+                                {
+                                    if(msgInvalid)
+                                    {
+                                        ++countRxExecReject;
+                                    }
+                                    else
+                                    {
+                                        execReportReady = true;
+                                    }
+                                }
+                                break;
+                            default:
+                                break;
+                        }
+                    }
+                    parseValue = 0;
+                    parseTag = 0;
+                }
+                else if(parseValue)
+                {
+                    if(parseFirst)
+                    {
+                        parseChar = rxByte;
+                        parseFirst = 0;
+                    }
+
+                    if(rxIsDigit)
+                    {
+                        // digits beyond the book precision are truncated,
+                        // a value too large for 32b is invalid
+                        if(!parsePoint || (parseFraction < OE_FIX_PRICE_DECIMALS))
+                        {
+                            if((parseNumber > 429496729) ||
+                               ((parseNumber == 429496729) && (rxDigit > 5)))
+                            {
+                                parseInvalid = 1;
+                            }
+                            parseNumber = (parseNumber << 3) + (parseNumber << 1) + rxDigit;
+                            parseFraction += parsePoint;
+                        }
+                        parseDigits = 1;
+                    }
+                    else if(('.' == rxByte) && !parsePoint)
+                    {
+                        parsePoint = 1;
+                    }
+                    else
+                    {
+                        parseInvalid = 1;
+                    }
+                }
+                else if('=' == rxByte)
+                {
+                    parseValue = 1;
+                    parseFirst = 1;
+                    parseDigits = 0;
+                    parsePoint = 0;
+                    parseInvalid = 0;
+                    parseFraction = 0;
+                    parseNumber = 0;
+                    parseChar = 0;
+                }
+                else if(rxIsDigit)
+                {
+                    parseTag = (parseTag << 3) + (parseTag << 1) + rxDigit;
                 }
+
+                // keep is contiguous from lane 0, the word is done at the
+                // last lane or the first lane not holding data
+                rxWord.data = (rxWord.data >> 8);
+                rxWord.keep = (rxWord.keep >> 1);
+                if((7 == rxLane) || (0 == rxWord.keep[0]))
+                {
+                    rxWordValid = 0;
+                    if(rxWord.last)
+                    {
+                        state = 0;
+                    }
+                }
+                ++rxLane;
             }
             break;
         }
     }
 
+    // at most one execution report completes per call, forwarded for order
+    // state tracking in the RiskEngine and PricingEngine
+    if(execReportReady)
+    {
+        switch(ordStatus)
+        {
+            case '0': execReport.execType = ORDERENTRY_EXEC_NEW; break;
+            case '1': execReport.execType = ORDERENTRY_EXEC_PARTIAL_FILL; break;
+            case '2': execReport.execType = ORDERENTRY_EXEC_FILL; break;
+            case '4': execReport.execType = ORDERENTRY_EXEC_CANCELED; break;
+            case '8': execReport.execType = ORDERENTRY_EXEC_REJECTED; break;
+            default:  execReport.execType = ORDERENTRY_EXEC_UNKNOWN; break;
+        }
+        execReport.orderId = clOrdId;
+        execReport.quantity = lastQty;
+        execReport.price = lastPx;
+        intf.orderEntryExecReportPack(&execReport, &execReportPack);
+        execReportStream.write(execReportPack);
+        ++countRxExecReport;
+    }
+
     regRxData = countRxData;
     regRxMeta = countRxMeta;
+    regRxExecReport = countRxExecReport;
+    regRxExecReject = countRxExecReject;
 }
 
 void OrderEntry::operationProcessTcp(ap_uint<32> &regControl,
@@ -360,25 +575,36 @@ void OrderEntry::operationProcessTcp(ap_uint<32> &regControl,
                                      ap_uint<32> &regTxStatus,
                                      ap_uint<32> &regTxDrop,
                                      ap_uint<1024> &regCaptureBuffer,
+                                     ap_uint<32> &regLatencyControl,
+                                     ap_uint<32> &regLatencyCount,
+                                     ap_uint<32> &regLatencyMin,
+                                     ap_uint<32> &regLatencyMax,
+                                     ap_uint<32> &regLatencyBin,
+                                     ap_uint<32> &regLatencySumLower,
+                                     ap_uint<32> &regLatencySumUpper,
+                                     hls::stream<ap_uint<64> > &timeStream,
                                      hls::stream<orderEntryOperationEncode_t> &operationEncodeStream,
+                                     hls::stream<ap_uint<1> > &operationSourceStream,
                                      hls::stream<ipTcpTxMetaPack_t> &txMetaStream,
-                                     hls::stream<ipTcpTxDataPack_t> &txDataStream)
+                                     hls::stream<ipTcpTxDataPack_t> &txDataStream,
+                                     hls::stream<orderEntryCredit_t> &creditStream,
+                                     hls::stream<orderEntryCredit_t> &creditHostStream)
 {
 #pragma HLS PIPELINE II=1 style=flp
 
     mmInterface intf;
     orderEntryOperationEncode_t operationEncode;
-    orderEntryMessagePack_t messagePack;
     ipTcpTxMeta_t txMeta;
     ipTcpTxMetaPack_t txMetaPack;
 
     ap_uint<16> sessionID;
     ap_uint<16> length;
     ap_uint<64> frameData;
-    ap_uint<32> rangeIndexHigh, rangeIndexLow;
     ap_axiu<64,0,0,0> messageWord;
     ap_uint<24> orderIdSum, timestampSum, quantitySum, priceSum, messageSum;
     ap_uint<1> validSum;
+    ap_uint<1> source;
+    orderEntryCredit_t credit;
 
     static ap_uint<32> countProcessOperation=0;
     static ap_uint<32> countTxOrder=0;
@@ -386,157 +612,265 @@ void OrderEntry::operationProcessTcp(ap_uint<32> &regControl,
     static ap_uint<32> countTxMeta=0;
     static ap_uint<32> countTxDrop=0;
     static ap_uint<32> countDebug=0;
-
-    if(!operationEncodeStream.empty())
+    static ap_uint<8>  creditPending=0;
+    static ap_uint<8>  creditHostPending=0;
+    static ap_uint<16> creditHoldoff=0;
+    static LatencyHistogram latency;
+    static LatencyClock latencyClock;
+
+    enum txStateType {OE_TX_ENCODE, OE_TX_FRAME};
+    static txStateType txState=OE_TX_ENCODE;
+    static ap_uint<8> txFrameCount=0;
+    static ap_uint<1> txSource=0;
+    static ap_uint<64> txIngressTimestamp=0;
+    static orderEntryMessagePack_t messagePack;
+
+    ap_uint<64> timeNow = latencyClock.now(timeStream);
+
+    // egress message is transmitted on data interface as 64b words
+    messageWord.last = 0;
+    messageWord.strb = 0xFF;
+    messageWord.keep = 0xFF;
+
+    // the message is sent one frame per call, with no blocking stream access
+    // the process runs on every cycle and the latency clock stays current
+    // through back pressure from the tcp kernel
+    if(OE_TX_ENCODE == txState)
     {
-        operationEncode = operationEncodeStream.read();
-        ++countProcessOperation;
-
-        // egress message is transmitted on data interface as 64b words
-        messageWord.last = 0;
-        messageWord.strb = 0xFF;
-        messageWord.keep = 0xFF;
-        txMetaPack.last = 0;
-        txMetaPack.keep = 0x7F;
-
-        // currently static as we send a fixed message size
-        sessionID = mConnectionStatus.sessionID;
-        length = OE_MSG_LEN_BYTES;
-
-        // apply field updates to overwrite template fields
-        messageTemplate[3].range(63,0) = operationEncode.orderId.range(79,16);
-        messageTemplate[4].range(63,48) = operationEncode.orderId.range(15,0);
-        messageTemplate[9].range(63,0) = operationEncode.timestamp;
-        messageTemplate[15].range(31,0) = operationEncode.orderId.range(79,48);
-        messageTemplate[16].range(63,16) = operationEncode.orderId.range(47,0);
-        messageTemplate[17].range(47,0) = operationEncode.quantity.range(79,32);
-        messageTemplate[18].range(63,32) = operationEncode.quantity.range(31,0);
-        messageTemplate[19].range(23,0) = operationEncode.price.range(79,56);
-        messageTemplate[20].range(63,8) = operationEncode.price.range(55,0);
-
-        // if checksum generation is enabled we calculate the partial sum for
-        // the payload here and send to TCP kernel via metadata interface, this
-        // reduces latency as TCP can begin sending in cut-through mode rather
-        // than buffer the full packet in store and forward mode
-        if(OE_TCP_GEN_SUM & regControl)
+        if(!operationEncodeStream.empty() &&
+           !operationSourceStream.empty() &&
+           !txMetaStream.full() &&
+           !txDataStream.full())
         {
-            timestampSum = operationEncode.timestamp.range(15,0);
-            timestampSum += operationEncode.timestamp.range(31,16);
-            timestampSum = (timestampSum + (timestampSum>>16)) & 0xFFFF;
-            timestampSum += operationEncode.timestamp.range(47,32);
-            timestampSum = (timestampSum + (timestampSum>>16)) & 0xFFFF;
-            timestampSum += operationEncode.timestamp.range(63,48);
-            timestampSum = (timestampSum + (timestampSum>>16)) & 0xFFFF;
-
-            orderIdSum = operationEncode.orderId.range(15,0);
-            orderIdSum += operationEncode.orderId.range(31,16);
-            orderIdSum = (orderIdSum + (orderIdSum>>16)) & 0xFFFF;
-            orderIdSum += operationEncode.orderId.range(47,32);
-            orderIdSum = (orderIdSum + (orderIdSum>>16)) & 0xFFFF;
-            orderIdSum += operationEncode.orderId.range(63,48);
-            orderIdSum = (orderIdSum + (orderIdSum>>16)) & 0xFFFF;
-            orderIdSum += operationEncode.orderId.range(79,64);
-            orderIdSum = (orderIdSum + (orderIdSum>>16)) & 0xFFFF;
-
-            quantitySum = operationEncode.quantity.range(15,0);
-            quantitySum += operationEncode.quantity.range(31,16);
-            quantitySum = (quantitySum + (quantitySum>>16)) & 0xFFFF;
-            quantitySum += operationEncode.quantity.range(47,32);
-            quantitySum = (quantitySum + (quantitySum>>16)) & 0xFFFF;
-            quantitySum += operationEncode.quantity.range(63,48);
-            quantitySum = (quantitySum + (quantitySum>>16)) & 0xFFFF;
-            quantitySum += operationEncode.quantity.range(79,64);
-            quantitySum = (quantitySum + (quantitySum>>16)) & 0xFFFF;
-
-            // the price field is not 16b aligned, need to shift by one byte
-            priceSum = (operationEncode.price.range(7,0) << 8);
-            priceSum += operationEncode.price.range(23,8);
-            priceSum = (priceSum + (priceSum>>16)) & 0xFFFF;
-            priceSum += operationEncode.price.range(39,24);
-            priceSum = (priceSum + (priceSum>>16)) & 0xFFFF;
-            priceSum += operationEncode.price.range(55,40);
-            priceSum = (priceSum + (priceSum>>16)) & 0xFFFF;
-            priceSum += operationEncode.price.range(71,56);
-            priceSum = (priceSum + (priceSum>>16)) & 0xFFFF;
-            priceSum += operationEncode.price.range(79,72);
-            priceSum = (priceSum + (priceSum>>16)) & 0xFFFF;
-
-            // merge template message partial sum with dynamic field updates
-            messageSum = messageTemplateSum;
-            messageSum += orderIdSum;
-            messageSum = (messageSum + (messageSum>>16)) & 0xFFFF;
-            messageSum += timestampSum;
-            messageSum = (messageSum + (messageSum>>16)) & 0xFFFF;
-            messageSum += orderIdSum;
-            messageSum = (messageSum + (messageSum>>16)) & 0xFFFF;
-            messageSum += quantitySum;
-            messageSum = (messageSum + (messageSum>>16)) & 0xFFFF;
-            messageSum += priceSum;
-            messageSum = (messageSum + (messageSum>>16)) & 0xFFFF;
-            validSum = 1;
+            operationEncode = operationEncodeStream.read();
+            source = operationSourceStream.read();
+            ++countProcessOperation;
+
+            txMetaPack.last = 0;
+            txMetaPack.keep = 0x7F;
+
+            // currently static as we send a fixed message size
+            sessionID = mConnectionStatus.sessionID;
+            length = OE_MSG_LEN_BYTES;
+
+            // apply field updates to overwrite template fields
+            messageTemplate[3].range(63,0) = operationEncode.orderId.range(79,16);
+            messageTemplate[4].range(63,48) = operationEncode.orderId.range(15,0);
+            messageTemplate[9].range(63,0) = operationEncode.timestamp;
+            messageTemplate[15].range(31,0) = operationEncode.orderId.range(79,48);
+            messageTemplate[16].range(63,16) = operationEncode.orderId.range(47,0);
+            messageTemplate[17].range(47,0) = operationEncode.quantity.range(79,32);
+            messageTemplate[18].range(63,32) = operationEncode.quantity.range(31,0);
+            messageTemplate[19].range(23,0) = operationEncode.price.range(79,56);
+            messageTemplate[20].range(63,8) = operationEncode.price.range(55,0);
+
+            // if checksum generation is enabled we calculate the partial sum for
+            // the payload here and send to TCP kernel via metadata interface, this
+            // reduces latency as TCP can begin sending in cut-through mode rather
+            // than buffer the full packet in store and forward mode
+            if(OE_TCP_GEN_SUM & regControl)
+            {
+                timestampSum = operationEncode.timestamp.range(15,0);
+                timestampSum += operationEncode.timestamp.range(31,16);
+                timestampSum = (timestampSum + (timestampSum>>16)) & 0xFFFF;
+                timestampSum += operationEncode.timestamp.range(47,32);
+                timestampSum = (timestampSum + (timestampSum>>16)) & 0xFFFF;
+                timestampSum += operationEncode.timestamp.range(63,48);
+                timestampSum = (timestampSum + (timestampSum>>16)) & 0xFFFF;
+
+                orderIdSum = operationEncode.orderId.range(15,0);
+                orderIdSum += operationEncode.orderId.range(31,16);
+                orderIdSum = (orderIdSum + (orderIdSum>>16)) & 0xFFFF;
+                orderIdSum += operationEncode.orderId.range(47,32);
+                orderIdSum = (orderIdSum + (orderIdSum>>16)) & 0xFFFF;
+                orderIdSum += operationEncode.orderId.range(63,48);
+                orderIdSum = (orderIdSum + (orderIdSum>>16)) & 0xFFFF;
+                orderIdSum += operationEncode.orderId.range(79,64);
+                orderIdSum = (orderIdSum + (orderIdSum>>16)) & 0xFFFF;
+
+                quantitySum = operationEncode.quantity.range(15,0);
+                quantitySum += operationEncode.quantity.range(31,16);
+                quantitySum = (quantitySum + (quantitySum>>16)) & 0xFFFF;
+                quantitySum += operationEncode.quantity.range(47,32);
+                quantitySum = (quantitySum + (quantitySum>>16)) & 0xFFFF;
+                quantitySum += operationEncode.quantity.range(63,48);
+                quantitySum = (quantitySum + (quantitySum>>16)) & 0xFFFF;
+                quantitySum += operationEncode.quantity.range(79,64);
+                quantitySum = (quantitySum + (quantitySum>>16)) & 0xFFFF;
+
+                // the price field is not 16b aligned, need to shift by one byte
+                priceSum = (operationEncode.price.range(7,0) << 8);
+                priceSum += operationEncode.price.range(23,8);
+                priceSum = (priceSum + (priceSum>>16)) & 0xFFFF;
+                priceSum += operationEncode.price.range(39,24);
+                priceSum = (priceSum + (priceSum>>16)) & 0xFFFF;
+                priceSum += operationEncode.price.range(55,40);
+                priceSum = (priceSum + (priceSum>>16)) & 0xFFFF;
+                priceSum += operationEncode.price.range(71,56);
+                priceSum = (priceSum + (priceSum>>16)) & 0xFFFF;
+                priceSum += operationEncode.price.range(79,72);
+                priceSum = (priceSum + (priceSum>>16)) & 0xFFFF;
+
+                // merge template message partial sum with dynamic field updates
+                messageSum = messageTemplateSum;
+                messageSum += orderIdSum;
+                messageSum = (messageSum + (messageSum>>16)) & 0xFFFF;
+                messageSum += timestampSum;
+                messageSum = (messageSum + (messageSum>>16)) & 0xFFFF;
+                messageSum += orderIdSum;
+                messageSum = (messageSum + (messageSum>>16)) & 0xFFFF;
+                messageSum += quantitySum;
+                messageSum = (messageSum + (messageSum>>16)) & 0xFFFF;
+                messageSum += priceSum;
+                messageSum = (messageSum + (messageSum>>16)) & 0xFFFF;
+                validSum = 1;
+            }
+            else
+            {
+                messageSum = 0;
+                validSum = 0;
+            }
+
+            if((mConnectionStatus.connected) &&
+               (length <= mConnectionStatus.space) &&
+               (TXSTATUS_SUCCESS == mConnectionStatus.error))
+            {
+                // send the meta data
+                txMeta.validSum = validSum;
+                txMeta.subSum = messageSum;
+                txMeta.sessionID = sessionID;
+                txMeta.length = length;
+                intf.ipTcpTxMetaPack(&txMeta, &txMetaPack);
+                txMetaPack.last = 1;
+                txMetaStream.write(txMetaPack);
+                ++countTxMeta;
+
+                // first frame leaves alongside the metadata, reversed for
+                // network byte order in egress message payload
+                frameData = messageTemplate[0];
+                messageWord.data = byteReverse(frameData);
+                txDataStream.write(messageWord);
+                ++countTxData;
+
+                // frames are shifted into the message capture as they are
+                // sent, the first 1024b of the message is retained
+                // TODO: add 2048b message capture support, truncate for now
+                messagePack.data = (frameData, messagePack.data.range(1023,64));
+
+                txIngressTimestamp = operationEncode.ingressTimestamp;
+                txSource = source;
+                txFrameCount = 1;
+                txState = OE_TX_FRAME;
+            }
+            else
+            {
+                ++countTxDrop;
+
+                // dropped operation releases its capacity immediately
+                if(OE_SOURCE_HOST == source)
+                {
+                    ++creditHostPending;
+                }
+                else
+                {
+                    ++creditPending;
+                }
+            }
         }
-        else
+    }
+    else
+    {
+        if(!txDataStream.full())
         {
-            messageSum = 0;
-            validSum = 0;
-        }
+            // load frame from template
+            frameData = messageTemplate[txFrameCount];
 
-        if((mConnectionStatus.connected) &&
-           (length <= mConnectionStatus.space) &&
-           (TXSTATUS_SUCCESS == mConnectionStatus.error))
-        {
-            // send the meta data
-            txMeta.validSum = validSum;
-            txMeta.subSum = messageSum;
-            txMeta.sessionID = sessionID;
-            txMeta.length = length;
-            intf.ipTcpTxMetaPack(&txMeta, &txMetaPack);
-            txMetaPack.last = 1;
-            txMetaStream.write(txMetaPack);
-            ++countTxMeta;
-
-loop_message_frame:
-            for(int frameCount=0; frameCount<OE_MSG_NUM_FRAME; frameCount++)
+            // reverse for network byte order in egress message payload
+            messageWord.data = byteReverse(frameData);
+
+            // instruct tcp kernel if this is the last frame in payload
+            if((OE_MSG_NUM_FRAME-1) == txFrameCount)
             {
-                // load frame from template
-                frameData = messageTemplate[frameCount];
+                messageWord.last = 1;
+                ++countDebug;
+            }
 
-                // reverse for network byte order in egress message payload
-                messageWord.data = byteReverse(frameData);
+            // forward frame to tcp kernel
+            txDataStream.write(messageWord);
+            ++countTxData;
+
+            if(txFrameCount < (1024/64))
+            {
+                messagePack.data = (frameData, messagePack.data.range(1023,64));
+            }
 
-                // instruct tcp kernel if this is the last frame in payload
-                if(31 == frameCount)
+            if((OE_MSG_NUM_FRAME-1) == txFrameCount)
+            {
+                ++countTxOrder;
+
+                // wire to wire, market data ingress through to the last frame
+                // of the order leaving for the tcp kernel
+                latency.record(regLatencyControl, timeNow, txIngressTimestamp);
+
+                // message capture recorded in register map for host visibility
+                // check if host has capture freeze control enabled before updating
+                if(0 == (OE_CAPTURE_FREEZE & regCaptureControl))
                 {
-                    messageWord.last = 1;
-                    ++countDebug;
+                    regCaptureBuffer = messagePack.data;
                 }
 
-                // forward frame to tcp kernel
-                txDataStream.write(messageWord);
-                ++countTxData;
-
-                // add frame to message capture
-                rangeIndexLow = (frameCount*64);
-                rangeIndexHigh = (rangeIndexLow+63);
-                if(rangeIndexHigh < 1024)
+                // operation has been fully expanded to frames, capacity is now
+                // available for upstream to dispatch another operation
+                if(OE_SOURCE_HOST == txSource)
                 {
-                    // TODO: add 2048b message capture support, truncate for now
-                    messagePack.data.range(rangeIndexHigh,rangeIndexLow) = frameData;
+                    ++creditHostPending;
                 }
+                else
+                {
+                    ++creditPending;
+                }
+
+                txState = OE_TX_ENCODE;
             }
 
-            ++countTxOrder;
+            ++txFrameCount;
+        }
+    }
 
-            // message capture recorded in register map for host visibility
-            // check if host has capture freeze control enabled before updating
-            if(0 == (OE_CAPTURE_FREEZE & regCaptureControl))
-            {
-                regCaptureBuffer = messagePack.data;
-            }
+    // credits are returned to the data mover (host path) and pricing engine
+    // (direct path) as operations leave this kernel, return is held back while
+    // the connected session reports less transmit space than a full message so
+    // upstream does not dispatch orders that would be dropped, bounded by a
+    // holdoff as the space is only refreshed by status from the next send
+    if((0 != creditPending) || (0 != creditHostPending))
+    {
+        if((mConnectionStatus.connected) &&
+           (TXSTATUS_SUCCESS == mConnectionStatus.error) &&
+           (OE_MSG_LEN_BYTES > mConnectionStatus.space) &&
+           (creditHoldoff < OE_CREDIT_HOLDOFF))
+        {
+            ++creditHoldoff;
         }
-        else
+        else if(!creditStream.full() && !creditHostStream.full())
         {
-            ++countTxDrop;
+            credit.keep = 0x1;
+            credit.last = 1;
+
+            if(0 != creditPending)
+            {
+                credit.data = creditPending;
+                creditStream.write(credit);
+                creditPending = 0;
+            }
+
+            if(0 != creditHostPending)
+            {
+                credit.data = creditHostPending;
+                creditHostStream.write(credit);
+                creditHostPending = 0;
+            }
+
+            creditHoldoff = 0;
         }
     }
 
@@ -550,6 +884,14 @@ loop_message_frame:
     regTxStatus.range(30,29) = mConnectionStatus.error;
     regTxStatus.range(28,0)  = mConnectionStatus.space;
 
+    latency.update(regLatencyControl,
+                   regLatencyCount,
+                   regLatencyMin,
+                   regLatencyMax,
+                   regLatencyBin,
+                   regLatencySumLower,
+                   regLatencySumUpper);
+
     return;
 }
 
@@ -21,6 +21,7 @@
 #include "ap_int.h"
 #include "aat_defines.hpp"
 #include "aat_interfaces.hpp"
+#include "aat_latency.hpp"
 
 #define OE_MSG_LEN_BYTES  (256)
 #define OE_MSG_WORD_BYTES (8)
@@ -33,6 +34,29 @@
 #define OE_TCP_GEN_SUM    (1<<4)
 #define OE_CAPTURE_FREEZE (1<<31)
 
+// operation source, credits are returned on the path the operation arrived on
+#define OE_SOURCE_DIRECT  (0)
+#define OE_SOURCE_HOST    (1)
+
+// maximum cycles credit return is held back waiting on TCP transmit space
+#define OE_CREDIT_HOLDOFF (1024)
+
+// FIX tags used by the inbound execution report parser
+#define OE_FIX_SOH              (0x01)
+#define OE_FIX_DELIMITER        (0x5e) // '^', as used by the egress template
+#define OE_FIX_TAG_BEGIN_STRING (8)
+#define OE_FIX_TAG_CHECKSUM     (10)
+#define OE_FIX_TAG_CL_ORD_ID    (11)
+#define OE_FIX_TAG_LAST_PX      (31)
+#define OE_FIX_TAG_LAST_QTY     (32)
+#define OE_FIX_TAG_MSG_TYPE     (35)
+#define OE_FIX_TAG_ORD_STATUS   (39)
+#define OE_FIX_MSG_TYPE_EXEC    (0x38) // '8'
+
+// decimal places implied in book prices (see PRICE_EXPONENT), a LastPx value
+// is padded or truncated to this many digits after the decimal point
+#define OE_FIX_PRICE_DECIMALS   (4)
+
 typedef struct orderEntryRegControl_t
 {
     ap_uint<32> control;
@@ -40,7 +64,7 @@ typedef struct orderEntryRegControl_t
     ap_uint<32> capture;
     ap_uint<32> destAddress;
     ap_uint<32> destPort;
-    ap_uint<32> reserved05;
+    ap_uint<32> latency;
     ap_uint<32> reserved06;
     ap_uint<32> reserved07;
 } orderEntryRegControl_t;
@@ -61,8 +85,8 @@ typedef struct orderEntryRegStatus_t
     ap_uint<32> notification;
     ap_uint<32> readRequest;
     ap_uint<32> debug;
-    ap_uint<32> reserved14;
-    ap_uint<32> reserved15;
+    ap_uint<32> rxExecReport;
+    ap_uint<32> rxExecReject;   // execution reports dropped on a malformed numeric field
 } orderEntryRegStatus_t;
 
 typedef struct connectionStatus_t
@@ -82,9 +106,18 @@ class OrderEntry
 public:
 
     void operationPull(ap_uint<32> &regRxOperation,
+                       ap_uint<32> &regLatencyControl,
+                       ap_uint<32> &regLatencyCount,
+                       ap_uint<32> &regLatencyMin,
+                       ap_uint<32> &regLatencyMax,
+                       ap_uint<32> &regLatencyBin,
+                       ap_uint<32> &regLatencySumLower,
+                       ap_uint<32> &regLatencySumUpper,
+                       hls::stream<ap_uint<64> > &timeStream,
                        hls::stream<orderEntryOperationPack_t> &operationStreamPack,
                        hls::stream<orderEntryOperationPack_t> &operationHostStreamPack,
-                       hls::stream<orderEntryOperation_t> &operationStream);
+                       hls::stream<orderEntryOperation_t> &operationStream,
+                       hls::stream<ap_uint<1> > &operationSourceStream);
 
     void operationEncode(hls::stream<orderEntryOperation_t> &operationStream,
                          hls::stream<orderEntryOperationEncode_t> &operationEncodeStream);
@@ -108,8 +141,11 @@ public:
 
     void serverProcessTcp(ap_uint<32> &regRxData,
                           ap_uint<32> &regRxMeta,
+                          ap_uint<32> &regRxExecReport,
+                          ap_uint<32> &regRxExecReject,
                           hls::stream<ipTcpRxMetaPack_t> &rxMetaStream,
-                          hls::stream<ipTcpRxDataPack_t> &rxDataStream);
+                          hls::stream<ipTcpRxDataPack_t> &rxDataStream,
+                          hls::stream<orderEntryExecReportPack_t> &execReportStream);
 
     void operationProcessTcp(ap_uint<32> &regControl,
                              ap_uint<32> &regCaptureControl,
@@ -120,9 +156,20 @@ public:
                              ap_uint<32> &regTxStatus,
                              ap_uint<32> &regTxDrop,
                              ap_uint<1024> &regCaptureBuffer,
+                             ap_uint<32> &regLatencyControl,
+                             ap_uint<32> &regLatencyCount,
+                             ap_uint<32> &regLatencyMin,
+                             ap_uint<32> &regLatencyMax,
+                             ap_uint<32> &regLatencyBin,
+                             ap_uint<32> &regLatencySumLower,
+                             ap_uint<32> &regLatencySumUpper,
+                             hls::stream<ap_uint<64> > &timeStream,
                              hls::stream<orderEntryOperationEncode_t> &operationEncodeStream,
+                             hls::stream<ap_uint<1> > &operationSourceStream,
                              hls::stream<ipTcpTxMetaPack_t> &txMetaStream,
-                             hls::stream<ipTcpTxDataPack_t> &txDataStream);
+                             hls::stream<ipTcpTxDataPack_t> &txDataStream,
+                             hls::stream<orderEntryCredit_t> &creditStream,
+                             hls::stream<orderEntryCredit_t> &creditHostStream);
 
     void eventHandler(ap_uint<32> &regRxEvent,
                       hls::stream<clockTickGeneratorEvent_t> &eventStream);
@@ -36,6 +36,11 @@ extern "C" void orderEntryTcpTop(orderEntryRegControl_t &regControl,
                                  hls::stream<ipTcpTxMetaPack_t> &txMetaStreamPack,
                                  hls::stream<ipTcpTxDataPack_t> &txDataStreamPack,
                                  hls::stream<ipTcpTxStatusPack_t> &txStatusStreamPack,
-                                 hls::stream<clockTickGeneratorEvent_t> &eventStream);
+                                 hls::stream<clockTickGeneratorEvent_t> &eventStream,
+                                 hls::stream<orderEntryCredit_t> &creditStreamPack,
+                                 hls::stream<orderEntryCredit_t> &creditHostStreamPack,
+                                 hls::stream<orderEntryExecReportPack_t> &execReportStreamPack,
+                                 latencyRegStatus_t &regLatencyStatus,
+                                 latencyRegStatus_t &regIngressLatencyStatus);
 
 #endif
@@ -33,14 +33,23 @@ extern "C" void orderEntryTcpTop(orderEntryRegControl_t &regControl,
                                  hls::stream<ipTcpTxMetaPack_t> &txMetaStreamPack,
                                  hls::stream<ipTcpTxDataPack_t> &txDataStreamPack,
                                  hls::stream<ipTcpTxStatusPack_t> &txStatusStreamPack,
-                                 hls::stream<clockTickGeneratorEvent_t> &eventStream)
+                                 hls::stream<clockTickGeneratorEvent_t> &eventStream,
+                                 hls::stream<orderEntryCredit_t> &creditStreamPack,
+                                 hls::stream<orderEntryCredit_t> &creditHostStreamPack,
+                                 hls::stream<orderEntryExecReportPack_t> &execReportStreamPack,
+                                 latencyRegStatus_t &regLatencyStatus,
+                                 latencyRegStatus_t &regIngressLatencyStatus)
 {
 #pragma HLS INTERFACE s_axilite port=regControl bundle=control
 #pragma HLS INTERFACE s_axilite port=regStatus bundle=control
 #pragma HLS INTERFACE s_axilite port=regCapture bundle=control
+#pragma HLS INTERFACE s_axilite port=regLatencyStatus bundle=control
+#pragma HLS INTERFACE s_axilite port=regIngressLatencyStatus bundle=control
 #pragma HLS INTERFACE ap_none port=regControl
 #pragma HLS INTERFACE ap_none port=regStatus
 #pragma HLS INTERFACE ap_none port=regCapture
+#pragma HLS INTERFACE ap_none port=regLatencyStatus
+#pragma HLS INTERFACE ap_none port=regIngressLatencyStatus
 #pragma HLS INTERFACE axis register port=operationStreamPack
 #pragma HLS INTERFACE axis register port=operationHostStreamPack
 #pragma HLS INTERFACE axis register port=listenPortStreamPack
@@ -56,17 +65,29 @@ extern "C" void orderEntryTcpTop(orderEntryRegControl_t &regControl,
 #pragma HLS INTERFACE axis register port=txDataStreamPack
 #pragma HLS INTERFACE axis register port=txStatusStreamPack
 #pragma HLS INTERFACE axis register port=eventStream
+#pragma HLS INTERFACE axis register port=creditStreamPack
+#pragma HLS INTERFACE axis register port=creditHostStreamPack
+#pragma HLS INTERFACE axis register port=execReportStreamPack
 #pragma HLS INTERFACE ap_ctrl_none port=return
 
     static hls::stream<orderEntryOperation_t> operationStreamFIFO;
+    static hls::stream<ap_uint<1> > operationSourceStreamFIFO;
     static hls::stream<orderEntryOperationEncode_t> operationEncodeStreamFIFO;
     static hls::stream<ipTcpTxStatus_t> txStatusStreamFIFO;
     static OrderEntry kernel;
+    static LatencyTimeBase timeBase;
+    static hls::stream<ap_uint<64> > timeStream[2];
 
 #pragma HLS DISAGGREGATE variable=regControl
 #pragma HLS DISAGGREGATE variable=regStatus
+#pragma HLS DISAGGREGATE variable=regLatencyStatus
+#pragma HLS DISAGGREGATE variable=regIngressLatencyStatus
+#pragma HLS STREAM variable=operationSourceStreamFIFO depth=8
+#pragma HLS STREAM variable=timeStream depth=2
 #pragma HLS DATAFLOW disable_start_propagation
 
+    timeBase.count<2>(timeStream);
+
     kernel.openListenPortTcp(listenPortStreamPack,
                              listenStatusStreamPack);
 
@@ -80,9 +101,18 @@ extern "C" void orderEntryTcpTop(orderEntryRegControl_t &regControl,
                              txStatusStreamPack);
 
     kernel.operationPull(regStatus.rxOperation,
+                         regControl.latency,
+                         regIngressLatencyStatus.count,
+                         regIngressLatencyStatus.min,
+                         regIngressLatencyStatus.max,
+                         regIngressLatencyStatus.bin,
+                         regIngressLatencyStatus.sumLower,
+                         regIngressLatencyStatus.sumUpper,
+                         timeStream[0],
                          operationStreamPack,
                          operationHostStreamPack,
-                         operationStreamFIFO);
+                         operationStreamFIFO,
+                         operationSourceStreamFIFO);
 
     kernel.operationEncode(operationStreamFIFO,
                            operationEncodeStreamFIFO);
@@ -96,14 +126,28 @@ extern "C" void orderEntryTcpTop(orderEntryRegControl_t &regControl,
                                regStatus.txStatus,
                                regStatus.txDrop,
                                regCapture,
+                               regControl.latency,
+                               regLatencyStatus.count,
+                               regLatencyStatus.min,
+                               regLatencyStatus.max,
+                               regLatencyStatus.bin,
+                               regLatencyStatus.sumLower,
+                               regLatencyStatus.sumUpper,
+                               timeStream[1],
                                operationEncodeStreamFIFO,
+                               operationSourceStreamFIFO,
                                txMetaStreamPack,
-                               txDataStreamPack);
+                               txDataStreamPack,
+                               creditStreamPack,
+                               creditHostStreamPack);
 
     kernel.serverProcessTcp(regStatus.rxData,
                             regStatus.rxMeta,
+                            regStatus.rxExecReport,
+                            regStatus.rxExecReject,
                             rxMetaStreamPack,
-                            rxDataStreamPack);
+                            rxDataStreamPack,
+                            execReportStreamPack);
 
     kernel.notificationHandlerTcp(regStatus.notification,
                                   regStatus.readRequest,
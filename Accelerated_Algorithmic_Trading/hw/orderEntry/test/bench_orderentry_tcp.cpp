@@ -0,0 +1,197 @@
+/*
+ * Copyright 2021 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+
+#include "orderentry_kernels.hpp"
+#include "aat_bench.hpp"
+
+// operations in flight ahead of the tcp interface, calls allowed for
+// the connection to come up and calls made to flush the pipeline
+#define BENCH_BACKLOG_OPERATION (4)
+#define BENCH_CONNECT_CALLS     (16)
+#define BENCH_DRAIN_CALLS       (4*OE_MSG_NUM_FRAME)
+
+static AatBench bench("orderEntry", 1000000);
+
+static orderEntryRegControl_t regControl={0};
+static orderEntryRegStatus_t regStatus={0};
+static ap_uint<1024> regCapture=0x0;
+static latencyRegStatus_t regLatencyStatus={0};
+static latencyRegStatus_t regIngressLatencyStatus={0};
+
+static hls::stream<orderEntryOperationPack_t> operationStreamPackFIFO;
+static hls::stream<orderEntryOperationPack_t> operationHostStreamPackFIFO;
+static hls::stream<clockTickGeneratorEvent_t> eventStreamFIFO;
+static hls::stream<orderEntryCredit_t> creditStreamFIFO;
+static hls::stream<orderEntryCredit_t> creditHostStreamFIFO;
+static hls::stream<ipTcpListenPortPack_t> listenPort;
+static hls::stream<ipTcpListenStatusPack_t> listenStatus;
+static hls::stream<ipTcpNotificationPack_t> notifications;
+static hls::stream<ipTcpReadRequestPack_t> readRequest;
+static hls::stream<ipTcpRxMetaPack_t> rxMetaData;
+static hls::stream<ipTcpRxDataPack_t> rxData;
+static hls::stream<ipTuplePack_t> openConnection;
+static hls::stream<ipTcpConnectionStatusPack_t> openConStatus;
+static hls::stream<ipTcpCloseConnectionPack_t> closeConnection;
+static hls::stream<ipTcpTxMetaPack_t> txMetaData;
+static hls::stream<ipTcpTxDataPack_t> txData;
+static hls::stream<ipTcpTxStatusPack_t> txStatus;
+static hls::stream<orderEntryExecReportPack_t> execReportStreamFIFO;
+
+static void orderEntryCall(void)
+{
+    ipTcpListenStatusPack_t listenStatusPack;
+    ipTcpConnectionStatusPack_t openConStatusPack;
+    ipTcpTxStatusPack_t txStatusPack;
+
+    orderEntryTcpTop(regControl,
+                     regStatus,
+                     regCapture,
+                     operationStreamPackFIFO,
+                     operationHostStreamPackFIFO,
+                     listenPort,
+                     listenStatus,
+                     notifications,
+                     readRequest,
+                     rxMetaData,
+                     rxData,
+                     openConnection,
+                     openConStatus,
+                     closeConnection,
+                     txMetaData,
+                     txData,
+                     txStatus,
+                     eventStreamFIFO,
+                     creditStreamFIFO,
+                     creditHostStreamFIFO,
+                     execReportStreamFIFO,
+                     regLatencyStatus,
+                     regIngressLatencyStatus);
+    bench.call();
+
+    // stand in for the TCP stack, accepting every request immediately
+    if(!listenPort.empty())
+    {
+        listenPort.read();
+        listenStatusPack.data = 0x1;
+        listenStatus.write(listenStatusPack);
+    }
+
+    if(!openConnection.empty())
+    {
+        openConnection.read();
+        openConStatusPack.data = 0x10001;
+        openConStatus.write(openConStatusPack);
+    }
+
+    // each segment acknowledged with the send window left fully open
+    while(!txMetaData.empty())
+    {
+        txMetaData.read();
+        bench.output();
+
+        txStatusPack.data = 0;
+        txStatusPack.data.range(15,0) = 0x0001; // sessionID
+        txStatusPack.data.range(31,16) = OE_MSG_LEN_BYTES; // length
+        txStatusPack.data.range(61,32) = 0xffff; // space
+        txStatusPack.data.range(63,62) = TXSTATUS_SUCCESS;
+        txStatus.write(txStatusPack);
+    }
+
+    while(!txData.empty())
+    {
+        txData.read();
+    }
+
+    while(!creditStreamFIFO.empty())
+    {
+        creditStreamFIFO.read();
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    mmInterface intf;
+    orderEntryOperation_t operation;
+    orderEntryOperationPack_t operationPack;
+    uint32_t seed=1;
+    uint64_t sequence=0;
+
+    if(!bench.parseArgs(argc, argv))
+    {
+        return 1;
+    }
+
+    regControl.control = (OE_TCP_GEN_SUM | OE_TCP_CONNECT);
+    regControl.config = 0xdeadbeef;
+    regControl.capture = 0x00000000;
+    regControl.destAddress = 0x640aa8c0; // 192.168.10.100
+    regControl.destPort = 0x17; // telnet (port 23)
+
+    for(int i=0; i<BENCH_CONNECT_CALLS; i++)
+    {
+        orderEntryCall();
+    }
+
+    bench.start();
+
+    while(bench.running())
+    {
+        // new orders on the direct path from RiskEngine, each takes one call
+        // per frame to leave so the backlog is bounded by orders sent rather
+        // than by the input stream the kernel empties on every call
+        if((bench.numOffered() - bench.numOutput()) < BENCH_BACKLOG_OPERATION)
+        {
+            seed = (seed * 1103515245) + 12345;
+
+            operation.timestamp = sequence;
+            operation.opCode = ORDERENTRY_ADD;
+            operation.symbolIndex = 0;
+            operation.orderId = sequence;
+            operation.quantity = ((seed >> 16) & 0x3FF) + 1;
+            operation.price = 5853400 + (((seed >> 8) & 0xF) * 100);
+            operation.direction = ((seed >> 4) & 0x1);
+            operation.ingressTimestamp = bench.timestamp();
+
+            intf.orderEntryOperationPack(&operation, &operationPack);
+            operationStreamPackFIFO.write(operationPack);
+            bench.event();
+            ++sequence;
+        }
+
+        orderEntryCall();
+    }
+
+    for(int i=0; i<BENCH_DRAIN_CALLS; i++)
+    {
+        orderEntryCall();
+    }
+
+    bench.stop();
+
+    while(!operationStreamPackFIFO.empty())
+    {
+        operationStreamPackFIFO.read();
+    }
+
+    bench.probe("INGRESS", regIngressLatencyStatus);
+    bench.probe("EGRESS", regLatencyStatus);
+
+    return bench.report();
+}
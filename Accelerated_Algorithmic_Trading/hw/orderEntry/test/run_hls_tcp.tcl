@@ -26,6 +26,7 @@ set CFLAGS "-I${CASE_ROOT}/../../common/include -std=c++14"
 open_project -reset $PROJ
 
 add_files "${CASE_ROOT}/../../common/include/aat_interfaces.cpp" -cflags ${CFLAGS}
+add_files "${CASE_ROOT}/../../common/include/aat_latency.cpp" -cflags ${CFLAGS}
 add_files "${KERNEL_ROOT}/orderentry.cpp" -cflags ${CFLAGS}
 add_files "${KERNEL_ROOT}/orderentry_tcp_top.cpp" -cflags ${CFLAGS}
 add_files -tb "tb_orderentry_tcp.cpp" -cflags "-I${KERNEL_ROOT} ${CFLAGS}"
@@ -22,11 +22,43 @@
 
 #define NUM_TEST_SAMPLE_OE (4)
 
+#define NUM_TEST_SAMPLE_EXEC (4)
+
+// execution reports with LastPx given to fewer, more and no decimal places
+// than the book precision, one with a malformed LastQty which must be
+// dropped, LastQty either side of the 32b limit (the larger dropped) and an
+// unrelated heartbeat, delimiter matches the egress template
+static const char* execReportMessage =
+    "8=FIX.4.2^9=140^35=8^34=12^49=CME^56=ABC123N^11=234^17=E1^150=1^39=1^"
+    "55=XLNX^54=1^32=300^31=585.35^151=400^14=300^10=101^"
+    "8=FIX.4.2^9=60^35=0^34=13^49=CME^56=ABC123N^10=202^"
+    "8=FIX.4.2^9=140^35=8^34=14^49=CME^56=ABC123N^11=234^17=E2^150=2^39=2^"
+    "55=XLNX^54=1^32=400^31=585.353719^151=0^14=700^10=103^"
+    "8=FIX.4.2^9=140^35=8^34=15^49=CME^56=ABC123N^11=235^17=E3^150=1^39=1^"
+    "55=XLNX^54=1^32=1x0^31=585.30^151=0^14=100^10=104^"
+    "8=FIX.4.2^9=140^35=8^34=16^49=CME^56=ABC123N^11=236^17=E4^150=2^39=2^"
+    "55=XLNX^54=2^32=50^31=585^151=0^14=50^10=105^"
+    "8=FIX.4.2^9=140^35=8^34=17^49=CME^56=ABC123N^11=237^17=E5^150=1^39=1^"
+    "55=XLNX^54=1^32=4294967295^31=585.10^151=0^14=1^10=106^"
+    "8=FIX.4.2^9=140^35=8^34=18^49=CME^56=ABC123N^11=238^17=E6^150=1^39=1^"
+    "55=XLNX^54=1^32=4294967296^31=585.10^151=0^14=1^10=107^";
+
+static const orderEntryExecReport_t execReportExpected[NUM_TEST_SAMPLE_EXEC] =
+{
+    // execType, orderId, quantity, price
+    {ORDERENTRY_EXEC_PARTIAL_FILL, 234, 300, 5853500},
+    {ORDERENTRY_EXEC_FILL,         234, 400, 5853537},
+    {ORDERENTRY_EXEC_FILL,         236,  50, 5850000},
+    {ORDERENTRY_EXEC_PARTIAL_FILL, 237, 4294967295u, 5851000},
+};
+
 int main()
 {
     orderEntryRegControl_t regControl={0};
     orderEntryRegStatus_t regStatus={0};
     ap_uint<1024> regCapture=0x0;
+    latencyRegStatus_t regLatencyStatus={0};
+    latencyRegStatus_t regIngressLatencyStatus={0};
     ap_uint<32> loopCount;
 
     mmInterface intf;
@@ -39,10 +71,21 @@ int main()
     ipTcpListenPortPack_t port;
     ipTuplePack_t connection;
     ipTcpListenStatusPack_t listenStatus_i;
+    orderEntryCredit_t credit;
+    int numCredit=0;
+    int numCreditHost=0;
+    orderEntryExecReportPack_t execReportPack;
+    orderEntryExecReport_t execReport;
+    ipTcpRxMetaPack_t rxMetaPack;
+    ipTcpRxDataPack_t rxDataPack;
+    int numExecReport=0;
+    int execReportLength;
 
     hls::stream<orderEntryOperationPack_t> operationStreamPackFIFO;
     hls::stream<orderEntryOperationPack_t> operationHostStreamPackFIFO;
     hls::stream<clockTickGeneratorEvent_t> eventStreamFIFO;
+    hls::stream<orderEntryCredit_t> creditStreamFIFO;
+    hls::stream<orderEntryCredit_t> creditHostStreamFIFO;
     hls::stream<ipTcpListenPortPack_t> listenPort;
     hls::stream<ipTcpListenStatusPack_t> listenStatus;
     hls::stream<ipTcpNotificationPack_t> notifications;
@@ -55,6 +98,7 @@ int main()
     hls::stream<ipTcpTxMetaPack_t> txMetaData;
     hls::stream<ipTcpTxDataPack_t> txData;
     hls::stream<ipTcpTxStatusPack_t> txStatus;
+    hls::stream<orderEntryExecReportPack_t> execReportStreamFIFO;
 
     std::cout << "OrderEntryTcp Test" << std::endl;
     std::cout << "------------------" << std::endl;
@@ -96,7 +140,12 @@ int main()
                          txMetaData,
                          txData,
                          txStatus,
-                         eventStreamFIFO);
+                         eventStreamFIFO,
+                         creditStreamFIFO,
+                         creditHostStreamFIFO,
+                         execReportStreamFIFO,
+                         regLatencyStatus,
+                         regIngressLatencyStatus);
 
         if (!listenPort.empty())
         {
@@ -127,13 +176,47 @@ int main()
     for(int i=0; i<NUM_TEST_SAMPLE_OE; i++)
     {
         operation = orderEntryOperations[i];
-        intf.orderEntryOperationPack(&operation, &operationPack);
-        operationStreamPackFIFO.write(operationPack);
+
+        // last operation arrives on host offload path, without an ingress
+        // timestamp as it did not originate from a received packet
+        if(i == (NUM_TEST_SAMPLE_OE-1))
+        {
+            operation.ingressTimestamp = 0;
+            intf.orderEntryOperationPack(&operation, &operationPack);
+            operationHostStreamPackFIFO.write(operationPack);
+        }
+        else
+        {
+            operation.ingressTimestamp = (i+1);
+            intf.orderEntryOperationPack(&operation, &operationPack);
+            operationStreamPackFIFO.write(operationPack);
+        }
     }
 
-    // kernel calls to process operations
+    // inbound execution report, single TCP segment of 64b words
+    rxMetaPack.data = 0x0001;
+    rxMetaPack.keep = 0x3;
+    rxMetaPack.last = 1;
+    rxMetaData.write(rxMetaPack);
+
+    execReportLength = strlen(execReportMessage);
+    for(int i=0; i<execReportLength; i+=OE_MSG_WORD_BYTES)
+    {
+        rxDataPack.data = 0;
+        rxDataPack.keep = 0;
+        for(int j=0; (j<OE_MSG_WORD_BYTES) && ((i+j)<execReportLength); j++)
+        {
+            rxDataPack.data.range((8*j)+7, 8*j) = execReportMessage[i+j];
+            rxDataPack.keep[j] = 1;
+        }
+        rxDataPack.last = ((i+OE_MSG_WORD_BYTES) >= execReportLength);
+        rxData.write(rxDataPack);
+    }
+
+    // kernel calls to process operations, inbound data is parsed a byte per
+    // call so run for at least as many calls as execution report bytes
     std::cout << "Invoking kernel execution ..." << std::endl;
-    for(int i=0; i<(NUM_TEST_SAMPLE_OE*OE_MSG_NUM_FRAME); i++)
+    for(int i=0; i<(NUM_TEST_SAMPLE_OE*OE_MSG_NUM_FRAME)+execReportLength; i++)
     {
         orderEntryTcpTop(regControl,
                          regStatus,
@@ -152,7 +235,12 @@ int main()
                          txMetaData,
                          txData,
                          txStatus,
-                         eventStreamFIFO);
+                         eventStreamFIFO,
+                         creditStreamFIFO,
+                         creditHostStreamFIFO,
+                         execReportStreamFIFO,
+                         regLatencyStatus,
+                         regIngressLatencyStatus);
     }
 
     // drain
@@ -177,6 +265,45 @@ int main()
         }
     }
 
+    // credits returned per path
+    while(!creditStreamFIFO.empty())
+    {
+        credit = creditStreamFIFO.read();
+        numCredit += credit.data;
+    }
+
+    while(!creditHostStreamFIFO.empty())
+    {
+        credit = creditHostStreamFIFO.read();
+        numCreditHost += credit.data;
+    }
+
+    std::cout << std::dec << "CREDIT: direct=" << numCredit << " host=" << numCreditHost << std::endl;
+
+    while(!execReportStreamFIFO.empty())
+    {
+        execReportPack = execReportStreamFIFO.read();
+        intf.orderEntryExecReportUnpack(&execReportPack, &execReport);
+
+        std::cout << std::dec << "EXEC_REPORT: {"
+                  << execReport.execType << ","
+                  << execReport.orderId << ","
+                  << execReport.quantity << ","
+                  << execReport.price << "}"
+                  << std::endl;
+
+        if((numExecReport >= NUM_TEST_SAMPLE_EXEC) ||
+           (execReportExpected[numExecReport].execType != execReport.execType) ||
+           (execReportExpected[numExecReport].orderId != execReport.orderId) ||
+           (execReportExpected[numExecReport].quantity != execReport.quantity) ||
+           (execReportExpected[numExecReport].price != execReport.price))
+        {
+            std::cout << "ERROR: execution report fields not extracted" << std::endl;
+            return 1;
+        }
+        ++numExecReport;
+    }
+
     // log final status
     std::cout << "--" << std::hex << std::endl;
     std::cout << "STATUS: ";
@@ -192,9 +319,27 @@ int main()
     std::cout << "OE_TX_DROP=" << regStatus.txDrop << " ";
     std::cout << "OE_TX_STATUS=" << regStatus.txStatus << " ";
     std::cout << "OE_DEBUG=" << regStatus.debug << " ";
+    std::cout << "OE_RX_EXEC=" << regStatus.rxExecReport << " ";
+    std::cout << "OE_RX_EXEC_REJECT=" << regStatus.rxExecReject << " ";
+    std::cout << "OE_LATENCY_COUNT=" << regLatencyStatus.count << " ";
+    std::cout << "OE_LATENCY_MAX=" << regLatencyStatus.max << " ";
+    std::cout << "OE_INGRESS_LATENCY_COUNT=" << regIngressLatencyStatus.count << " ";
+    std::cout << "OE_INGRESS_LATENCY_MAX=" << regIngressLatencyStatus.max << " ";
     std::cout << std::endl;
 
     std::cout << std::endl;
+
+    // wire to wire latency recorded for every order sent except the host one,
+    // and each of those orders sampled once on the way in as well
+    if((numCredit != (NUM_TEST_SAMPLE_OE-1)) || (numCreditHost != 1) ||
+       (numExecReport != NUM_TEST_SAMPLE_EXEC) || (regStatus.rxExecReject != 2) ||
+       ((regLatencyStatus.count + 1) != regStatus.txOrder) ||
+       (regIngressLatencyStatus.count != regLatencyStatus.count))
+    {
+        std::cout << "FAILED!" << std::endl;
+        return 1;
+    }
+
     std::cout << "Done!" << std::endl;
 
     return 0;
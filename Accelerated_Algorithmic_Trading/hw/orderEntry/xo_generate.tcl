@@ -22,6 +22,7 @@ set CFLAGS "-I${COMMON_DIR} -I${KERNEL_DIR} -std=c++14"
 # TCP variant
 open_project -reset prj_tcp
 add_files ${COMMON_DIR}/aat_interfaces.cpp -cflags ${CFLAGS}
+add_files ${COMMON_DIR}/aat_latency.cpp -cflags ${CFLAGS}
 add_files ${KERNEL_DIR}/orderentry.cpp -cflags ${CFLAGS}
 add_files ${KERNEL_DIR}/orderentry_tcp_top.cpp  -cflags ${CFLAGS}
 set_top orderEntryTcpTop
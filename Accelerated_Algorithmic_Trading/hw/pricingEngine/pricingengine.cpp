@@ -22,6 +22,14 @@
  */
 
 void PricingEngine::responsePull(ap_uint<32> &regRxResponse,
+                                 ap_uint<32> &regLatencyControl,
+                                 ap_uint<32> &regLatencyCount,
+                                 ap_uint<32> &regLatencyMin,
+                                 ap_uint<32> &regLatencyMax,
+                                 ap_uint<32> &regLatencyBin,
+                                 ap_uint<32> &regLatencySumLower,
+                                 ap_uint<32> &regLatencySumUpper,
+                                 hls::stream<ap_uint<64> > &timeStream,
                                  hls::stream<orderBookResponsePack_t> &responseStreamPack,
                                  hls::stream<orderBookResponse_t> &responseStream)
 {
@@ -32,41 +40,77 @@ void PricingEngine::responsePull(ap_uint<32> &regRxResponse,
     orderBookResponse_t response;
 
     static ap_uint<32> countRxResponse=0;
+    static LatencyHistogram latency;
+    static LatencyClock latencyClock;
 
-    if(!responseStreamPack.empty())
+    ap_uint<64> timeNow = latencyClock.now(timeStream);
+
+    if(!responseStreamPack.empty() && !responseStream.full())
     {
         responsePack = responseStreamPack.read();
         intf.orderBookResponseUnpack(&responsePack, &response);
         responseStream.write(response);
         ++countRxResponse;
+        latency.record(regLatencyControl, timeNow, response.ingressTimestamp);
     }
 
     regRxResponse = countRxResponse;
 
+    latency.update(regLatencyControl,
+                   regLatencyCount,
+                   regLatencyMin,
+                   regLatencyMax,
+                   regLatencyBin,
+                   regLatencySumLower,
+                   regLatencySumUpper);
+
     return;
 }
 
 void PricingEngine::pricingProcess(ap_uint<32> &regStrategyControl,
+                                   ap_uint<32> &regOrderLifetime,
                                    ap_uint<32> &regProcessResponse,
                                    ap_uint<32> &regStrategyNone,
                                    ap_uint<32> &regStrategyPeg,
                                    ap_uint<32> &regStrategyLimit,
                                    ap_uint<32> &regStrategyUnknown,
+                                   ap_uint<32> &regStrategyCustom,
+                                   ap_uint<32> &regExecReport,
+                                   ap_uint<32> &regExecFill,
+                                   ap_uint<32> &regExecReject,
+                                   ap_uint<32> &regExecUnmatched,
                                    pricingEngineRegStrategy_t *regStrategies,
                                    hls::stream<orderBookResponse_t> &responseStream,
-                                   hls::stream<orderEntryOperation_t> &operationStream)
+                                   hls::stream<orderEntryExecReportPack_t> &execReportStreamPack,
+                                   hls::stream<clockTickGeneratorTimerEvent_t> &timerActionStream,
+                                   hls::stream<orderEntryOperation_t> &operationStream,
+                                   hls::stream<pricingEngineOperationMeta_t> &operationMetaStream,
+                                   hls::stream<clockTickGeneratorTimerPack_t> &timerArmStreamPack)
 {
 #pragma HLS PIPELINE II=1 style=flp
 
     mmInterface intf;
     orderBookResponse_t response;
     orderEntryOperation_t operation;
+    orderEntryOperation_t operationPeg;
+    orderEntryOperation_t operationLimit;
+    orderEntryOperation_t operationCustom;
+    pricingEngineOperationMeta_t operationMeta;
+    orderEntryExecReport_t execReport;
+    orderEntryExecReportPack_t execReportPack;
+    ap_uint<PE_ORDER_TABLE_INDEX_WIDTH> orderSlot;
+    clockTickGeneratorTimerEvent_t timerAction;
+    clockTickGeneratorTimer_t timer;
+    clockTickGeneratorTimerPack_t timerPack;
 
     ap_uint<8> symbolIndex = 0;
     ap_uint<8> strategySelect = 0;
     ap_uint<8> thresholdEnable = 0;
-    ap_uint<8> thresholdPosition = 0;
+    ap_uint<32> thresholdPosition = 0;
     bool orderExecute = false;
+    bool orderExecutePeg = false;
+    bool orderExecuteLimit = false;
+    bool orderExecuteCustom = false;
 
     static ap_uint<32> orderId = 0;
     static ap_uint<32> countProcessResponse = 0;
@@ -75,6 +119,10 @@ void PricingEngine::pricingProcess(ap_uint<32> &regStrategyControl,
     static ap_uint<32> countStrategyLimit = 0;
     static ap_uint<32> countStrategyCustom = 0;
     static ap_uint<32> countStrategyUnknown = 0;
+    static ap_uint<32> countExecReport = 0;
+    static ap_uint<32> countExecFill = 0;
+    static ap_uint<32> countExecReject = 0;
+    static ap_uint<32> countExecUnmatched = 0;
 
     if (!responseStream.empty())
     {
@@ -85,6 +133,7 @@ void PricingEngine::pricingProcess(ap_uint<32> &regStrategyControl,
         pricingEngineCacheEntry_t &entry = cache[symbolIndex];
 
         thresholdEnable = regStrategies[symbolIndex].enable.range(7, 0);
+        thresholdPosition = regStrategies[symbolIndex].totalBid;
 
         // 选策略
         if (PE_GLOBAL_STRATEGY & regStrategyControl)
@@ -92,6 +141,22 @@ void PricingEngine::pricingProcess(ap_uint<32> &regStrategyControl,
         else
             strategySelect = regStrategies[symbolIndex].select.range(7, 0);
 
+        // ==== 策略并行评估 ====
+
+        // every strategy is evaluated on every response and the result muxed
+        // below so latency is independent of the strategy selected, the fixed
+        // strategies trigger on a change against the cached top of book so
+        // are evaluated ahead of the cache update
+        orderExecutePeg = pricingStrategyPeg(thresholdEnable,
+                                             thresholdPosition,
+                                             response,
+                                             operationPeg);
+
+        orderExecuteLimit = pricingStrategyLimit(thresholdEnable,
+                                                 thresholdPosition,
+                                                 response,
+                                                 operationLimit);
+
         // ==== 状态缓存更新 ====
 
         // 时间状态
@@ -149,62 +214,205 @@ void PricingEngine::pricingProcess(ap_uint<32> &regStrategyControl,
         // 设置系统状态
         entry.systemState = 1; // STATE_RUNNING
 
-        // ==== 策略执行 ====
-
-        // switch (strategySelect)
-        // {
-        //     case (STRATEGY_NONE):
-        //         ++countStrategyNone;
-        //         orderExecute = false;
-        //         break;
-
-        //     case (STRATEGY_PEG):
-        //         ++countStrategyPeg;
-        //         orderExecute = pricingStrategyPeg(thresholdEnable,
-        //                                           thresholdPosition,
-        //                                           response,
-        //                                           operation);
-        //         break;
-
-        //     case (STRATEGY_LIMIT):
-        //         ++countStrategyLimit;
-        //         orderExecute = pricingStrategyLimit(thresholdEnable,
-        //                                             thresholdPosition,
-        //                                             response,
-        //                                             operation);
-        //         break;
-
-        //     case (STRATEGY_CUSTOM):
-        //         ++countStrategyCustom;
-        //         orderExecute = pricingStrategyCustom(response, operation);
-        //         break;
-
-        //     default:
-        //         ++countStrategyUnknown;
-        //         orderExecute = false;
-        //         break;
-        // }
-
-        // 强制执行自定义策略
-        ++countStrategyCustom;
-        orderExecute = pricingStrategyCustom(response, operation);
+        orderExecuteCustom = pricingStrategyCustom(response, operationCustom);
+
+        // ==== 策略选择 ====
+
+        switch (strategySelect)
+        {
+            case (STRATEGY_NONE):
+                ++countStrategyNone;
+                orderExecute = false;
+                break;
+
+            case (STRATEGY_PEG):
+                ++countStrategyPeg;
+                orderExecute = orderExecutePeg;
+                operation = operationPeg;
+                break;
+
+            case (STRATEGY_LIMIT):
+                ++countStrategyLimit;
+                orderExecute = orderExecuteLimit;
+                operation = operationLimit;
+                break;
+
+            case (STRATEGY_CUSTOM):
+                ++countStrategyCustom;
+                orderExecute = orderExecuteCustom;
+                operation = operationCustom;
+                break;
+
+            default:
+                ++countStrategyUnknown;
+                orderExecute = false;
+                break;
+        }
 
         // ==== 下单逻辑 ====
 
         if (orderExecute)
         {
+            // order carries the ingress timestamp of the market data packet
+            // that triggered it through to OrderEntry
             operation.orderId = ++orderId;
+            operation.ingressTimestamp = response.ingressTimestamp;
             entry.lastOrderId = orderId;
+            entry.lastOrderQuantity = operation.quantity;
+            entry.lastOrderPrice = operation.price;
+            entry.lastOrderDirection = operation.direction;
+
+            // position is only moved by fills, the order is tracked until
+            // OrderEntry reports it filled, cancelled or rejected
+            orderSlot = orderId.range(PE_ORDER_TABLE_INDEX_WIDTH-1, 0);
+            orders[orderSlot].orderId = orderId;
+            orders[orderSlot].symbolIndex = symbolIndex;
+            orders[orderSlot].state = PE_ORDER_PENDING;
+            orders[orderSlot].direction = operation.direction;
+            orders[orderSlot].openQuantity = operation.quantity;
 
-            if (operation.direction == ORDER_BID)
-                entry.positionSize += operation.quantity;
-            else
-                entry.positionSize -= operation.quantity;
+            operationStream.write(operation);
+            operationMeta.strategy = strategySelect;
+            operationMetaStream.write(operationMeta);
+
+            // order lifetime, (re)arm the per symbol one-shot cancel timer
+            if(0 != regOrderLifetime)
+            {
+                timer.interval = regOrderLifetime;
+                timer.timerIndex = PE_TIMER_BASE + symbolIndex;
+                timer.eventCode = CTG_EVENT_ORDER_CANCEL;
+                timer.symbolIndex = symbolIndex;
+                timer.target = CTG_TARGET_PRICING_ENGINE;
+                timer.periodic = 0;
+                timer.arm = 1;
+                intf.clockTickGeneratorTimerPack(&timer, &timerPack);
+                timerArmStreamPack.write(timerPack);
+            }
+        }
+    }
+    else if (!execReportStreamPack.empty())
+    {
+        // execution reports from OrderEntry, fills move the true position so
+        // strategies act on it from the next market data response
+        execReportPack = execReportStreamPack.read();
+        intf.orderEntryExecReportUnpack(&execReportPack, &execReport);
+        ++countExecReport;
 
-            // 粗略 PnL = 仓位 × (成交价格 - 当前买价)
-            entry.pnlEstimate = entry.positionSize * (entry.tradePrice - entry.bidPrice[0]);
+        orderSlot = execReport.orderId.range(PE_ORDER_TABLE_INDEX_WIDTH-1, 0);
+        pricingEngineOrderEntry_t &order = orders[orderSlot];
 
-            operationStream.write(operation);
+        if ((PE_ORDER_FREE != order.state) && (order.orderId == execReport.orderId))
+        {
+            symbolIndex = order.symbolIndex;
+            pricingEngineCacheEntry_t &entry = cache[symbolIndex];
+
+            switch (execReport.execType)
+            {
+                case (ORDERENTRY_EXEC_NEW):
+                    order.state = PE_ORDER_ACKED;
+                    break;
+
+                case (ORDERENTRY_EXEC_PARTIAL_FILL):
+                case (ORDERENTRY_EXEC_FILL):
+                    ++countExecFill;
+
+                    if (order.direction == ORDER_BID)
+                        entry.positionSize += execReport.quantity;
+                    else
+                        entry.positionSize -= execReport.quantity;
+
+                    entry.tradePrice = execReport.price;
+                    entry.lastTradeSide = (order.direction == ORDER_BID) ? 1 : 0;
+
+                    // 粗略 PnL = 仓位 × (成交价格 - 当前买价)
+                    entry.pnlEstimate = entry.positionSize * (entry.tradePrice - entry.bidPrice[0]);
+
+                    if (order.openQuantity > execReport.quantity)
+                        order.openQuantity -= execReport.quantity;
+                    else
+                        order.openQuantity = 0;
+
+                    if ((ORDERENTRY_EXEC_FILL == execReport.execType) || (0 == order.openQuantity))
+                    {
+                        order.state = PE_ORDER_FREE;
+
+                        // nothing left resting for the lifetime timer to cancel
+                        if (entry.lastOrderId == order.orderId)
+                            entry.lastOrderId = 0;
+                    }
+                    else
+                    {
+                        order.state = PE_ORDER_PARTIAL;
+                    }
+                    break;
+
+                case (ORDERENTRY_EXEC_REJECTED):
+                    ++countExecReject;
+                    order.state = PE_ORDER_FREE;
+                    if (entry.lastOrderId == order.orderId)
+                        entry.lastOrderId = 0;
+                    break;
+
+                case (ORDERENTRY_EXEC_CANCELED):
+                    order.state = PE_ORDER_FREE;
+                    if (entry.lastOrderId == order.orderId)
+                        entry.lastOrderId = 0;
+                    break;
+
+                default:
+                    break;
+            }
+        }
+        else
+        {
+            ++countExecUnmatched;
+        }
+    }
+    else if (!timerActionStream.empty())
+    {
+        // timer wheel events act on the resting order for the symbol, market
+        // data responses take priority so actions land between updates
+        timerAction = timerActionStream.read();
+
+        symbolIndex = timerAction.symbolIndex;
+        pricingEngineCacheEntry_t &entry = cache[symbolIndex];
+
+        if (0 != entry.lastOrderId)
+        {
+            operation.timestamp = entry.clockUS;
+            operation.ingressTimestamp = 0;
+            operation.symbolIndex = symbolIndex;
+            operation.orderId = entry.lastOrderId;
+            operation.quantity = entry.lastOrderQuantity;
+            operation.direction = entry.lastOrderDirection;
+
+            switch (timerAction.eventCode)
+            {
+                case (CTG_EVENT_QUOTE_REFRESH):
+                    // re-peg the resting order to the current top of book
+                    operation.opCode = ORDERENTRY_MODIFY;
+                    if (ORDER_BID == entry.lastOrderDirection)
+                        operation.price = entry.bidPrice[0];
+                    else
+                        operation.price = entry.askPrice[0];
+                    entry.lastOrderPrice = operation.price;
+                    operationStream.write(operation);
+                    operationMeta.strategy = STRATEGY_NONE;
+                    operationMetaStream.write(operationMeta);
+                    break;
+
+                case (CTG_EVENT_ORDER_CANCEL):
+                    operation.opCode = ORDERENTRY_DELETE;
+                    operation.price = entry.lastOrderPrice;
+                    entry.lastOrderId = 0;
+                    operationStream.write(operation);
+                    operationMeta.strategy = STRATEGY_NONE;
+                    operationMetaStream.write(operationMeta);
+                    break;
+
+                default:
+                    break;
+            }
         }
     }
 
@@ -214,6 +422,11 @@ void PricingEngine::pricingProcess(ap_uint<32> &regStrategyControl,
     regStrategyPeg = countStrategyPeg;
     regStrategyLimit = countStrategyLimit;
     regStrategyUnknown = countStrategyUnknown;
+    regStrategyCustom = countStrategyCustom;
+    regExecReport = countExecReport;
+    regExecFill = countExecFill;
+    regExecReject = countExecReject;
+    regExecUnmatched = countExecUnmatched;
 
     return;
 }
@@ -227,31 +440,34 @@ bool PricingEngine::pricingStrategyPeg(ap_uint<8> thresholdEnable,
 #pragma HLS PIPELINE II=1 style=flp
 
     ap_uint<8> symbolIndex=0;
+    ap_uint<32> quantity=800;
     bool executeOrder=false;
 
     symbolIndex = response.symbolIndex;
 
+    // cache holds the previous top of book (updated by caller after all
+    // strategies are evaluated), strategy has no side effects on the cache
     // TODO: restore valid check when test data updated to trigger top of book update
     //if(cache[symbolIndex].valid)
     {
         if(cache[symbolIndex].bidPrice[0] != response.bidPrice.range(31,0))
         {
-            // create an order, current best bid +100
-            operation.timestamp = response.timestamp;
-            operation.opCode = ORDERENTRY_ADD;
-            operation.symbolIndex = symbolIndex;
-            operation.quantity = 800;
-            operation.price = (response.bidPrice.range(31,0)+100);
-            operation.direction = ORDER_BID;
-            executeOrder = true;
+            // optional per symbol position threshold
+            if((0 == (PE_THRESHOLD_POSITION & thresholdEnable)) ||
+               ((cache[symbolIndex].positionSize + quantity) <= thresholdPosition))
+            {
+                // create an order, current best bid +100
+                operation.timestamp = response.timestamp;
+                operation.opCode = ORDERENTRY_ADD;
+                operation.symbolIndex = symbolIndex;
+                operation.quantity = quantity;
+                operation.price = (response.bidPrice.range(31,0)+100);
+                operation.direction = ORDER_BID;
+                executeOrder = true;
+            }
         }
     }
 
-    // cache top of book prices (used as trigger on next delta if change detected)
-    cache[symbolIndex].bidPrice[0] = response.bidPrice.range(31,0);
-    cache[symbolIndex].askPrice[0] = response.askPrice.range(31,0);
-    cache[symbolIndex].valid = true;
-
     return executeOrder;
 }
 
@@ -263,75 +479,195 @@ bool PricingEngine::pricingStrategyLimit(ap_uint<8> thresholdEnable,
 #pragma HLS PIPELINE II=1 style=flp
 
     ap_uint<8> symbolIndex=0;
+    ap_uint<32> quantity=800;
     bool executeOrder=false;
 
     symbolIndex = response.symbolIndex;
 
+    // cache holds the previous top of book (updated by caller after all
+    // strategies are evaluated), strategy has no side effects on the cache
     // TODO: restore valid check when test data updated to trigger top of book update
     //if(cache[symbolIndex].valid)
     {
         if(cache[symbolIndex].bidPrice[0] != response.bidPrice.range(31,0))
         {
-            // create an order, current best bid +50
-            operation.timestamp = response.timestamp;
-            operation.opCode = ORDERENTRY_ADD;
-            operation.symbolIndex = symbolIndex;
-            operation.quantity = 800;
-            operation.price = (response.bidPrice.range(31,0)+50);
-            operation.direction = ORDER_BID;
-            executeOrder = true;
+            // optional per symbol position threshold
+            if((0 == (PE_THRESHOLD_POSITION & thresholdEnable)) ||
+               ((cache[symbolIndex].positionSize + quantity) <= thresholdPosition))
+            {
+                // create an order, current best bid +50
+                operation.timestamp = response.timestamp;
+                operation.opCode = ORDERENTRY_ADD;
+                operation.symbolIndex = symbolIndex;
+                operation.quantity = quantity;
+                operation.price = (response.bidPrice.range(31,0)+50);
+                operation.direction = ORDER_BID;
+                executeOrder = true;
+            }
         }
     }
 
-    // cache top of book prices (used as trigger on next delta if change detected)
-    cache[symbolIndex].bidPrice[0] = response.bidPrice.range(31,0);
-    cache[symbolIndex].askPrice[0] = response.askPrice.range(31,0);
-    cache[symbolIndex].valid = true;
-
     return executeOrder;
 }
 
 void PricingEngine::operationPush(ap_uint<32> &regCaptureControl,
+                                  ap_uint<32> &regCreditLimit,
                                   ap_uint<32> &regTxOperation,
+                                  ap_uint<32> &regCreditAvailable,
+                                  ap_uint<32> &regCreditStall,
                                   ap_uint<1024> &regCaptureBuffer,
+                                  ap_uint<32> &regLatencyControl,
+                                  ap_uint<32> &regLatencyCount,
+                                  ap_uint<32> &regLatencyMin,
+                                  ap_uint<32> &regLatencyMax,
+                                  ap_uint<32> &regLatencyBin,
+                                  ap_uint<32> &regLatencySumLower,
+                                  ap_uint<32> &regLatencySumUpper,
+                                  latencyRegStatus_t &regPegLatencyStatus,
+                                  latencyRegStatus_t &regLimitLatencyStatus,
+                                  latencyRegStatus_t &regCustomLatencyStatus,
+                                  hls::stream<ap_uint<64> > &timeStream,
                                   hls::stream<orderEntryOperation_t> &operationStream,
-                                  hls::stream<orderEntryOperationPack_t> &operationStreamPack)
+                                  hls::stream<pricingEngineOperationMeta_t> &operationMetaStream,
+                                  hls::stream<orderEntryOperationPack_t> &operationStreamPack,
+                                  hls::stream<orderEntryCredit_t> &creditStream)
 {
 #pragma HLS PIPELINE II=1 style=flp
 
     mmInterface intf;
     orderEntryOperation_t operation;
     orderEntryOperationPack_t operationPack;
+    pricingEngineOperationMeta_t operationMeta;
+    orderEntryCredit_t credit;
+    ap_uint<32> creditLimit;
+    ap_uint<32> creditOutstanding;
 
     static ap_uint<32> countTxOperation=0;
+    static ap_uint<32> countCreditReturn=0;
+    static ap_uint<32> countCreditStall=0;
+    static LatencyHistogram egressLatency;
+    static LatencyHistogram pegLatency;
+    static LatencyHistogram limitLatency;
+    static LatencyHistogram customLatency;
+    static LatencyClock latencyClock;
+
+    ap_uint<64> timeNow = latencyClock.now(timeStream);
+
+    // credits are returned (via RiskEngine) as OrderEntry consumes operations,
+    // operations are held in the FIFO while the downstream limit is reached
+    if(!creditStream.empty())
+    {
+        credit = creditStream.read();
+        countCreditReturn += credit.data;
+    }
 
-    if(!operationStream.empty())
+    if(0 == regCreditLimit)
     {
-        operation = operationStream.read();
+        creditLimit = PE_CREDIT_DEFAULT;
+    }
+    else
+    {
+        creditLimit = regCreditLimit;
+    }
+
+    creditOutstanding = (countTxOperation - countCreditReturn);
 
-        intf.orderEntryOperationPack(&operation, &operationPack);
-        operationStreamPack.write(operationPack);
-        ++countTxOperation;
+    if(!operationStream.empty() &&
+       !operationMetaStream.empty() &&
+       !operationStreamPack.full())
+    {
+        if(creditOutstanding < creditLimit)
+        {
+            operation = operationStream.read();
+            operationMeta = operationMetaStream.read();
+
+            intf.orderEntryOperationPack(&operation, &operationPack);
+            operationStreamPack.write(operationPack);
+            ++countTxOperation;
+            ++creditOutstanding;
+
+            // wire to dispatch, market data ingress through to operation out
+            egressLatency.record(regLatencyControl, timeNow, operation.ingressTimestamp);
+
+            // per strategy split of the egress probe, measured against the
+            // same wire timestamp so the strategy series sum to the egress
+            // series, timer driven operations carry no timestamp
+            switch(operationMeta.strategy)
+            {
+                case (STRATEGY_PEG):
+                    pegLatency.record(regLatencyControl, timeNow, operation.ingressTimestamp);
+                    break;
+                case (STRATEGY_LIMIT):
+                    limitLatency.record(regLatencyControl, timeNow, operation.ingressTimestamp);
+                    break;
+                case (STRATEGY_CUSTOM):
+                    customLatency.record(regLatencyControl, timeNow, operation.ingressTimestamp);
+                    break;
+                default:
+                    break;
+            }
 
-        // check if host has capture freeze control enabled before updating
-        // TODO: filter capture by user supplied symbol
-        if(0 == (PE_CAPTURE_FREEZE & regCaptureControl))
+            // check if host has capture freeze control enabled before updating
+            // TODO: filter capture by user supplied symbol
+            if(0 == (PE_CAPTURE_FREEZE & regCaptureControl))
+            {
+                regCaptureBuffer = operationPack.data;
+            }
+        }
+        else
         {
-            regCaptureBuffer = operationPack.data;
+            ++countCreditStall;
         }
     }
 
     regTxOperation = countTxOperation;
+    regCreditAvailable = (creditOutstanding < creditLimit) ? (ap_uint<32>)(creditLimit - creditOutstanding) : (ap_uint<32>)0;
+    regCreditStall = countCreditStall;
+
+    egressLatency.update(regLatencyControl,
+                         regLatencyCount,
+                         regLatencyMin,
+                         regLatencyMax,
+                         regLatencyBin,
+                         regLatencySumLower,
+                         regLatencySumUpper);
+
+    pegLatency.update(regLatencyControl,
+                      regPegLatencyStatus.count,
+                      regPegLatencyStatus.min,
+                      regPegLatencyStatus.max,
+                      regPegLatencyStatus.bin,
+                      regPegLatencyStatus.sumLower,
+                      regPegLatencyStatus.sumUpper);
+
+    limitLatency.update(regLatencyControl,
+                        regLimitLatencyStatus.count,
+                        regLimitLatencyStatus.min,
+                        regLimitLatencyStatus.max,
+                        regLimitLatencyStatus.bin,
+                        regLimitLatencyStatus.sumLower,
+                        regLimitLatencyStatus.sumUpper);
+
+    customLatency.update(regLatencyControl,
+                         regCustomLatencyStatus.count,
+                         regCustomLatencyStatus.min,
+                         regCustomLatencyStatus.max,
+                         regCustomLatencyStatus.bin,
+                         regCustomLatencyStatus.sumLower,
+                         regCustomLatencyStatus.sumUpper);
 
     return;
 }
 
 void PricingEngine::eventHandler(ap_uint<32> &regRxEvent,
-                                 hls::stream<clockTickGeneratorEvent_t> &eventStream)
+                                 hls::stream<clockTickGeneratorEvent_t> &eventStream,
+                                 hls::stream<clockTickGeneratorTimerEvent_t> &timerActionStream)
 {
 #pragma HLS PIPELINE II=1 style=flp
 
+    mmInterface intf;
     clockTickGeneratorEvent_t tickEvent;
+    clockTickGeneratorTimerEvent_t timerEvent;
 
     static ap_uint<32> countRxEvent=0;
 
@@ -341,8 +677,14 @@ void PricingEngine::eventHandler(ap_uint<32> &regRxEvent,
         ++countRxEvent;
 
         // event notification has been received from programmable clock tick
-        // generator, handling currently limited to incrementing a counter,
-        // placeholder for user to extend with custom event handling code
+        // generator, periodic ticks are counted only (placeholder for user to
+        // extend), timer wheel events are forwarded to pricing process which
+        // owns the per symbol order state they act on
+        intf.clockTickGeneratorEventUnpack(&tickEvent, &timerEvent);
+        if(CTG_EVENT_TICK != timerEvent.eventCode)
+        {
+            timerActionStream.write(timerEvent);
+        }
     }
 
     regRxEvent = countRxEvent;
@@ -22,10 +22,35 @@
 #include "ap_fixed.h"
 #include "aat_defines.hpp"
 #include "aat_interfaces.hpp"
+#include "aat_latency.hpp"
 
 #define PE_GLOBAL_STRATEGY (1<<31)
 #define PE_CAPTURE_FREEZE  (1<<31)
 
+// per symbol strategy threshold enables (pricingEngineRegStrategy_t.enable)
+#define PE_THRESHOLD_POSITION (1<<0)
+
+// operations in flight to OrderEntry when no credit limit has been programmed
+#define PE_CREDIT_DEFAULT  (4)
+
+// ClockTickGenerator timer wheel slots owned by the pricing engine, one per
+// symbol, used to cancel resting orders once the programmed lifetime expires
+#define PE_TIMER_BASE      (256)
+
+// order state table, direct mapped on the low bits of the order id, sized to
+// cover the orders that can be resting at once (an order is only evicted by
+// an order id that aliases to the same slot)
+#define PE_ORDER_TABLE_SIZE        (256)
+#define PE_ORDER_TABLE_INDEX_WIDTH (8)
+
+enum PRICINGENGINE_ORDER_STATES
+{
+    PE_ORDER_FREE = 0,
+    PE_ORDER_PENDING,   // sent, awaiting acknowledgement
+    PE_ORDER_ACKED,
+    PE_ORDER_PARTIAL
+};
+
 // 最多支持 5 档报价
 #define LEVELS 5
 #define MAX_WINDOW 8
@@ -36,9 +61,9 @@ typedef struct pricingEngineRegControl_t
     ap_uint<32> config;
     ap_uint<32> capture;
     ap_uint<32> strategy;
-    ap_uint<32> reserved04;
-    ap_uint<32> reserved05;
-    ap_uint<32> reserved06;
+    ap_uint<32> creditLimit;
+    ap_uint<32> orderLifetime;  // timer wheel revolutions, 0 to disable
+    ap_uint<32> latency;
     ap_uint<32> reserved07;
 } pricingEngineRegControl_t;
 
@@ -54,14 +79,22 @@ typedef struct pricingEngineRegStatus_t
     ap_uint<32> strategyUnknown;
     ap_uint<32> rxEvent;
     ap_uint<32> debug;
-    ap_uint<32> reserved10;
-    ap_uint<32> reserved11;
-    ap_uint<32> reserved12;
+    ap_uint<32> creditAvailable;
+    ap_uint<32> creditStall;
+    ap_uint<32> strategyCustom;
     ap_uint<32> reserved13;
     ap_uint<32> reserved14;
     ap_uint<32> reserved15;
 } pricingEngineRegStatus_t;
 
+typedef struct pricingEngineRegExecStatus_t
+{
+    ap_uint<32> execReport;
+    ap_uint<32> execFill;
+    ap_uint<32> execReject;
+    ap_uint<32> execUnmatched;
+} pricingEngineRegExecStatus_t;
+
 typedef struct pricingEngineRegStrategy_t
 {
     // 32b registers are wider than required here for some fields (e.g. select and enable) but not sure
@@ -69,7 +102,7 @@ typedef struct pricingEngineRegStrategy_t
     // TODO: width appropriate fields when XRT register map packing mechanism is understood
     ap_uint<32> select;  // 8b
     ap_uint<32> enable;  // 8b
-    ap_uint<32> totalBid;
+    ap_uint<32> totalBid;  // position threshold (PE_THRESHOLD_POSITION)
     ap_uint<32> totalAsk;
 } pricingEngineRegStrategy_t;
 
@@ -244,7 +277,7 @@ typedef struct pricingEngineCacheEntry_t
     ap_int<32>  bidSizeDelta[LEVELS];        // 增量（可正负）
     ap_int<32>  askSizeDelta[LEVELS];
 
-    ap_uint<32> positionSize;
+    ap_uint<32> positionSize;   // filled position, updated from execution reports
     ap_uint<32> pnlEstimate;
 
     TimeSeriesBuffer bidPriceHistory;  // 买价历史
@@ -262,9 +295,29 @@ typedef struct pricingEngineCacheEntry_t
     ap_uint<32> tickIndex;
     ap_uint<32> clockUS;
     ap_uint<32> lastOrderId;
+    ap_uint<32> lastOrderQuantity;
+    ap_uint<32> lastOrderPrice;
+    ap_uint<1>  lastOrderDirection;
     ap_uint<8>  systemState = STATE_IDLE;
 } pricingEngineCacheEntry_t;
 
+typedef struct pricingEngineOrderEntry_t
+{
+    ap_uint<32> orderId;
+    ap_uint<8>  symbolIndex;
+    ap_uint<8>  state;
+    ap_uint<1>  direction;
+    ap_uint<32> openQuantity;
+} pricingEngineOrderEntry_t;
+
+// side band to operations, strategy that generated the operation used for per
+// strategy latency measurement at dispatch, the time base is the wire
+// timestamp carried in the operation itself
+typedef struct pricingEngineOperationMeta_t
+{
+    ap_uint<8>  strategy;
+} pricingEngineOperationMeta_t;
+
 // For primitives
 typedef struct BookLevel
 {
@@ -299,18 +352,36 @@ class PricingEngine
 public:
 
     void responsePull(ap_uint<32> &regRxResponse,
+                      ap_uint<32> &regLatencyControl,
+                      ap_uint<32> &regLatencyCount,
+                      ap_uint<32> &regLatencyMin,
+                      ap_uint<32> &regLatencyMax,
+                      ap_uint<32> &regLatencyBin,
+                      ap_uint<32> &regLatencySumLower,
+                      ap_uint<32> &regLatencySumUpper,
+                      hls::stream<ap_uint<64> > &timeStream,
                       hls::stream<orderBookResponsePack_t> &responseStreamPack,
                       hls::stream<orderBookResponse_t> &responseStream);
 
     void pricingProcess(ap_uint<32> &regStrategyControl,
+                        ap_uint<32> &regOrderLifetime,
                         ap_uint<32> &regProcessResponse,
                         ap_uint<32> &regStrategyNone,
                         ap_uint<32> &regStrategyPeg,
                         ap_uint<32> &regStrategyLimit,
                         ap_uint<32> &regStrategyUnknown,
+                        ap_uint<32> &regStrategyCustom,
+                        ap_uint<32> &regExecReport,
+                        ap_uint<32> &regExecFill,
+                        ap_uint<32> &regExecReject,
+                        ap_uint<32> &regExecUnmatched,
                         pricingEngineRegStrategy_t *regStrategies,
                         hls::stream<orderBookResponse_t> &responseStream,
-                        hls::stream<orderEntryOperation_t> &operationStream);
+                        hls::stream<orderEntryExecReportPack_t> &execReportStreamPack,
+                        hls::stream<clockTickGeneratorTimerEvent_t> &timerActionStream,
+                        hls::stream<orderEntryOperation_t> &operationStream,
+                        hls::stream<pricingEngineOperationMeta_t> &operationMetaStream,
+                        hls::stream<clockTickGeneratorTimerPack_t> &timerArmStreamPack);
 
     bool pricingStrategyPeg(ap_uint<8> thresholdEnable,
                             ap_uint<32> thresholdPosition,
@@ -326,18 +397,36 @@ public:
                                orderEntryOperation_t &operation);
 
     void operationPush(ap_uint<32> &regCaptureControl,
+                       ap_uint<32> &regCreditLimit,
                        ap_uint<32> &regTxOperation,
+                       ap_uint<32> &regCreditAvailable,
+                       ap_uint<32> &regCreditStall,
                        ap_uint<1024> &regCaptureBuffer,
+                       ap_uint<32> &regLatencyControl,
+                       ap_uint<32> &regLatencyCount,
+                       ap_uint<32> &regLatencyMin,
+                       ap_uint<32> &regLatencyMax,
+                       ap_uint<32> &regLatencyBin,
+                       ap_uint<32> &regLatencySumLower,
+                       ap_uint<32> &regLatencySumUpper,
+                       latencyRegStatus_t &regPegLatencyStatus,
+                       latencyRegStatus_t &regLimitLatencyStatus,
+                       latencyRegStatus_t &regCustomLatencyStatus,
+                       hls::stream<ap_uint<64> > &timeStream,
                        hls::stream<orderEntryOperation_t> &operationStream,
-                       hls::stream<orderEntryOperationPack_t> &operationStreamPack);
+                       hls::stream<pricingEngineOperationMeta_t> &operationMetaStream,
+                       hls::stream<orderEntryOperationPack_t> &operationStreamPack,
+                       hls::stream<orderEntryCredit_t> &creditStream);
 
     void eventHandler(ap_uint<32> &regRxEvent,
-                      hls::stream<clockTickGeneratorEvent_t> &eventStream);
+                      hls::stream<clockTickGeneratorEvent_t> &eventStream,
+                      hls::stream<clockTickGeneratorTimerEvent_t> &timerActionStream);
 
 private:
 
     //pricingEngineRegThresholds_t thresholds[NUM_SYMBOL];
     pricingEngineCacheEntry_t cache[NUM_SYMBOL];
+    pricingEngineOrderEntry_t orders[PE_ORDER_TABLE_SIZE];
 
     // Primitives
     // 获取订单簿快照：最多返回 depth 档
@@ -25,6 +25,15 @@ extern "C" void pricingEngineTop(pricingEngineRegControl_t &regControl,
                                  pricingEngineRegStrategy_t regStrategies[NUM_SYMBOL],
                                  hls::stream<orderBookResponsePack_t> &responseStreamPack,
                                  hls::stream<orderEntryOperationPack_t> &operationStreamPack,
-                                 hls::stream<clockTickGeneratorEvent_t> &eventStream);
+                                 hls::stream<clockTickGeneratorEvent_t> &eventStream,
+                                 hls::stream<orderEntryCredit_t> &creditStream,
+                                 hls::stream<clockTickGeneratorTimerPack_t> &timerArmStreamPack,
+                                 pricingEngineRegExecStatus_t &regExecStatus,
+                                 hls::stream<orderEntryExecReportPack_t> &execReportStreamPack,
+                                 latencyRegStatus_t &regLatencyStatus,
+                                 latencyRegStatus_t &regIngressLatencyStatus,
+                                 latencyRegStatus_t &regPegLatencyStatus,
+                                 latencyRegStatus_t &regLimitLatencyStatus,
+                                 latencyRegStatus_t &regCustomLatencyStatus);
 
 #endif
@@ -22,52 +22,124 @@ extern "C" void pricingEngineTop(pricingEngineRegControl_t &regControl,
                                  pricingEngineRegStrategy_t regStrategies[NUM_SYMBOL],
                                  hls::stream<orderBookResponsePack_t> &responseStreamPack,
                                  hls::stream<orderEntryOperationPack_t> &operationStreamPack,
-                                 hls::stream<clockTickGeneratorEvent_t> &eventStream)
+                                 hls::stream<clockTickGeneratorEvent_t> &eventStream,
+                                 hls::stream<orderEntryCredit_t> &creditStream,
+                                 hls::stream<clockTickGeneratorTimerPack_t> &timerArmStreamPack,
+                                 pricingEngineRegExecStatus_t &regExecStatus,
+                                 hls::stream<orderEntryExecReportPack_t> &execReportStreamPack,
+                                 latencyRegStatus_t &regLatencyStatus,
+                                 latencyRegStatus_t &regIngressLatencyStatus,
+                                 latencyRegStatus_t &regPegLatencyStatus,
+                                 latencyRegStatus_t &regLimitLatencyStatus,
+                                 latencyRegStatus_t &regCustomLatencyStatus)
 {
 #pragma HLS INTERFACE s_axilite port=regControl bundle=control
 #pragma HLS INTERFACE s_axilite port=regStatus bundle=control
 #pragma HLS INTERFACE s_axilite port=regCapture bundle=control
 #pragma HLS INTERFACE s_axilite port=regStrategies bundle=control
+#pragma HLS INTERFACE s_axilite port=regExecStatus bundle=control
+#pragma HLS INTERFACE s_axilite port=regLatencyStatus bundle=control
+#pragma HLS INTERFACE s_axilite port=regIngressLatencyStatus bundle=control
+#pragma HLS INTERFACE s_axilite port=regPegLatencyStatus bundle=control
+#pragma HLS INTERFACE s_axilite port=regLimitLatencyStatus bundle=control
+#pragma HLS INTERFACE s_axilite port=regCustomLatencyStatus bundle=control
 #pragma HLS INTERFACE ap_none port=regControl
 #pragma HLS INTERFACE ap_none port=regStatus
 #pragma HLS INTERFACE ap_memory port=regCapture
 #pragma HLS INTERFACE ap_memory port=regStrategies
+#pragma HLS INTERFACE ap_none port=regExecStatus
+#pragma HLS INTERFACE ap_none port=regLatencyStatus
+#pragma HLS INTERFACE ap_none port=regIngressLatencyStatus
+#pragma HLS INTERFACE ap_none port=regPegLatencyStatus
+#pragma HLS INTERFACE ap_none port=regLimitLatencyStatus
+#pragma HLS INTERFACE ap_none port=regCustomLatencyStatus
 #pragma HLS INTERFACE axis port=responseStreamPack
 #pragma HLS INTERFACE axis port=operationStreamPack
 #pragma HLS INTERFACE axis port=eventStream
+#pragma HLS INTERFACE axis port=creditStream
+#pragma HLS INTERFACE axis port=timerArmStreamPack
+#pragma HLS INTERFACE axis port=execReportStreamPack
 #pragma HLS INTERFACE ap_ctrl_none port=return
 
     static hls::stream<orderBookResponse_t> responseStreamFIFO;
     static hls::stream<orderEntryOperation_t> operationStreamFIFO;
+    static hls::stream<pricingEngineOperationMeta_t> operationMetaStreamFIFO;
+    static hls::stream<clockTickGeneratorTimerEvent_t> timerActionStreamFIFO;
     static PricingEngine kernel;
     static mmInterface intf;
+    static LatencyTimeBase timeBase;
+    static hls::stream<ap_uint<64> > timeStream[2];
 
 #pragma HLS DISAGGREGATE variable=regControl
 #pragma HLS DISAGGREGATE variable=regStatus
+#pragma HLS DISAGGREGATE variable=regExecStatus
+#pragma HLS DISAGGREGATE variable=regLatencyStatus
+#pragma HLS DISAGGREGATE variable=regIngressLatencyStatus
+#pragma HLS DISAGGREGATE variable=regPegLatencyStatus
+#pragma HLS DISAGGREGATE variable=regLimitLatencyStatus
+#pragma HLS DISAGGREGATE variable=regCustomLatencyStatus
 #pragma HLS STABLE variable=regStrategies
+#pragma HLS STREAM variable=timeStream depth=2
 #pragma HLS DATAFLOW disable_start_propagation
 
+    timeBase.count<2>(timeStream);
+
     kernel.responsePull(regStatus.rxResponse,
+                        regControl.latency,
+                        regIngressLatencyStatus.count,
+                        regIngressLatencyStatus.min,
+                        regIngressLatencyStatus.max,
+                        regIngressLatencyStatus.bin,
+                        regIngressLatencyStatus.sumLower,
+                        regIngressLatencyStatus.sumUpper,
+                        timeStream[0],
                         responseStreamPack,
                         responseStreamFIFO);
 
+    kernel.eventHandler(regStatus.rxEvent,
+                        eventStream,
+                        timerActionStreamFIFO);
+
     kernel.pricingProcess(regControl.strategy,
+                          regControl.orderLifetime,
                           regStatus.processResponse,
                           regStatus.strategyNone,
                           regStatus.strategyPeg,
                           regStatus.strategyLimit,
                           regStatus.strategyUnknown,
+                          regStatus.strategyCustom,
+                          regExecStatus.execReport,
+                          regExecStatus.execFill,
+                          regExecStatus.execReject,
+                          regExecStatus.execUnmatched,
                           regStrategies,
                           responseStreamFIFO,
-                          operationStreamFIFO);
+                          execReportStreamPack,
+                          timerActionStreamFIFO,
+                          operationStreamFIFO,
+                          operationMetaStreamFIFO,
+                          timerArmStreamPack);
 
     kernel.operationPush(regControl.capture,
+                         regControl.creditLimit,
                          regStatus.txOperation,
+                         regStatus.creditAvailable,
+                         regStatus.creditStall,
                          regCapture,
+                         regControl.latency,
+                         regLatencyStatus.count,
+                         regLatencyStatus.min,
+                         regLatencyStatus.max,
+                         regLatencyStatus.bin,
+                         regLatencyStatus.sumLower,
+                         regLatencyStatus.sumUpper,
+                         regPegLatencyStatus,
+                         regLimitLatencyStatus,
+                         regCustomLatencyStatus,
+                         timeStream[1],
                          operationStreamFIFO,
-                         operationStreamPack);
-
-    kernel.eventHandler(regStatus.rxEvent,
-                        eventStream);
+                         operationMetaStreamFIFO,
+                         operationStreamPack,
+                         creditStream);
 
 }
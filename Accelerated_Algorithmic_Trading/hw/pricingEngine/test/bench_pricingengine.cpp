@@ -0,0 +1,167 @@
+/*
+ * Copyright 2021 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+
+#include "pricingengine_kernels.hpp"
+#include "aat_bench.hpp"
+
+// symbols the synthetic responses are spread over, responses held in the
+// input stream ahead of the kernel and calls made to flush the pipeline
+#define BENCH_NUM_SYMBOL       (16)
+#define BENCH_BACKLOG_RESPONSE (16)
+#define BENCH_DRAIN_CALLS      (64)
+
+static AatBench bench("pricingEngine", 1000000);
+
+static pricingEngineRegControl_t regControl={0};
+static pricingEngineRegStatus_t regStatus={0};
+static ap_uint<1024> regCapture=0x0;
+static pricingEngineRegStrategy_t regStrategies[NUM_SYMBOL];
+static pricingEngineRegExecStatus_t regExecStatus={0};
+static latencyRegStatus_t regLatencyStatus={0};
+static latencyRegStatus_t regIngressLatencyStatus={0};
+static latencyRegStatus_t regPegLatencyStatus={0};
+static latencyRegStatus_t regLimitLatencyStatus={0};
+static latencyRegStatus_t regCustomLatencyStatus={0};
+
+static hls::stream<orderBookResponsePack_t> responseStreamPackFIFO;
+static hls::stream<orderEntryOperationPack_t> operationStreamPackFIFO;
+static hls::stream<clockTickGeneratorEvent_t> eventStreamFIFO;
+static hls::stream<orderEntryCredit_t> creditStreamFIFO;
+static hls::stream<clockTickGeneratorTimerPack_t> timerArmStreamPackFIFO;
+static hls::stream<orderEntryExecReportPack_t> execReportStreamPackFIFO;
+
+static void pricingEngineCall(void)
+{
+    orderEntryCredit_t credit;
+
+    pricingEngineTop(regControl,
+                     regStatus,
+                     regCapture,
+                     regStrategies,
+                     responseStreamPackFIFO,
+                     operationStreamPackFIFO,
+                     eventStreamFIFO,
+                     creditStreamFIFO,
+                     timerArmStreamPackFIFO,
+                     regExecStatus,
+                     execReportStreamPackFIFO,
+                     regLatencyStatus,
+                     regIngressLatencyStatus,
+                     regPegLatencyStatus,
+                     regLimitLatencyStatus,
+                     regCustomLatencyStatus);
+    bench.call();
+
+    // drain operation stream, returning credit as OrderEntry would
+    while(!operationStreamPackFIFO.empty())
+    {
+        operationStreamPackFIFO.read();
+        bench.output();
+
+        credit.data = 1;
+        credit.keep = 0x1;
+        credit.last = 1;
+        creditStreamFIFO.write(credit);
+    }
+
+    while(!timerArmStreamPackFIFO.empty())
+    {
+        timerArmStreamPackFIFO.read();
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    mmInterface intf;
+    orderBookResponse_t response;
+    orderBookResponsePack_t responsePack;
+    uint32_t seed=1;
+    uint64_t sequence=0;
+    ap_uint<32> bidPrice, askPrice;
+
+    if(!bench.parseArgs(argc, argv))
+    {
+        return 1;
+    }
+
+    memset(&regStrategies, 0, sizeof(regStrategies));
+    memset(&response, 0, sizeof(response));
+
+    regControl.control = 0x12345678;
+    regControl.config = 0xdeadbeef;
+    regControl.capture = 0x00000000;
+    regControl.strategy = STRATEGY_LIMIT;
+
+    // all three strategies in use across the benchmark symbols
+    for(int i=0; i<BENCH_NUM_SYMBOL; i++)
+    {
+        regStrategies[i].select = STRATEGY_PEG + (i % 3);
+    }
+
+    bench.start();
+
+    while(bench.running())
+    {
+        // five level book stepping a tick either way around 5853300/5859100
+        if(responseStreamPackFIFO.size() < BENCH_BACKLOG_RESPONSE)
+        {
+            seed = (seed * 1103515245) + 12345;
+
+            bidPrice = 5853300 + (((seed >> 16) & 0x7) * 100);
+            askPrice = 5859100 + (((seed >> 20) & 0x7) * 100);
+
+            response.symbolIndex = (sequence % BENCH_NUM_SYMBOL);
+            response.bidCount = (ap_uint<32>(1), ap_uint<32>(1), ap_uint<32>(1), ap_uint<32>(1), ap_uint<32>(1));
+            response.bidPrice = (ap_uint<32>(bidPrice-400), ap_uint<32>(bidPrice-300), ap_uint<32>(bidPrice-200), ap_uint<32>(bidPrice-100), bidPrice);
+            response.bidQuantity = (ap_uint<32>(18), ap_uint<32>(18), ap_uint<32>(18), ap_uint<32>(18), ap_uint<32>(18));
+            response.askCount = (ap_uint<32>(1), ap_uint<32>(1), ap_uint<32>(1), ap_uint<32>(1), ap_uint<32>(1));
+            response.askPrice = (ap_uint<32>(askPrice+400), ap_uint<32>(askPrice+300), ap_uint<32>(askPrice+200), ap_uint<32>(askPrice+100), askPrice);
+            response.askQuantity = (ap_uint<32>(18), ap_uint<32>(18), ap_uint<32>(18), ap_uint<32>(18), ap_uint<32>(18));
+            response.ingressTimestamp = bench.timestamp();
+
+            intf.orderBookResponsePack(&response, &responsePack);
+            responseStreamPackFIFO.write(responsePack);
+            bench.event();
+            ++sequence;
+        }
+
+        pricingEngineCall();
+    }
+
+    for(int i=0; i<BENCH_DRAIN_CALLS; i++)
+    {
+        pricingEngineCall();
+    }
+
+    bench.stop();
+
+    while(!responseStreamPackFIFO.empty())
+    {
+        responseStreamPackFIFO.read();
+    }
+
+    bench.probe("INGRESS", regIngressLatencyStatus);
+    bench.probe("EGRESS", regLatencyStatus);
+    bench.probe("PEG", regPegLatencyStatus);
+    bench.probe("LIMIT", regLimitLatencyStatus);
+    bench.probe("CUSTOM", regCustomLatencyStatus);
+
+    return bench.report();
+}
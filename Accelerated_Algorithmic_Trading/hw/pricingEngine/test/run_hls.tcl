@@ -26,8 +26,11 @@ set CFLAGS "-I${CASE_ROOT}/../../common/include -std=c++14"
 open_project -reset $PROJ
 
 add_files "${CASE_ROOT}/../../common/include/aat_interfaces.cpp" -cflags ${CFLAGS}
+add_files "${CASE_ROOT}/../../common/include/aat_latency.cpp" -cflags ${CFLAGS}
 add_files "${KERNEL_ROOT}/pricingengine.cpp" -cflags ${CFLAGS}
 add_files "${KERNEL_ROOT}/pricingengine_top.cpp" -cflags ${CFLAGS}
+add_files "${KERNEL_ROOT}/pricingstrategy_custom.cpp" -cflags ${CFLAGS}
+add_files "${KERNEL_ROOT}/primitives.cpp" -cflags ${CFLAGS}
 add_files -tb "tb_pricingengine.cpp" -cflags "-I${KERNEL_ROOT} ${CFLAGS}"
 
 set_top pricingEngineTop
@@ -21,6 +21,7 @@
 #include "pricingengine_kernels.hpp"
 
 #define NUM_TEST_SAMPLE_PE (4)
+#define NUM_TEST_SAMPLE_EXEC (5)
 
 int main()
 {
@@ -28,6 +29,12 @@ int main()
     pricingEngineRegStatus_t regStatus={0};
     ap_uint<1024> regCapture=0x0;
     pricingEngineRegStrategy_t regStrategies[NUM_SYMBOL];
+    pricingEngineRegExecStatus_t regExecStatus={0};
+    latencyRegStatus_t regLatencyStatus={0};
+    latencyRegStatus_t regIngressLatencyStatus={0};
+    latencyRegStatus_t regPegLatencyStatus={0};
+    latencyRegStatus_t regLimitLatencyStatus={0};
+    latencyRegStatus_t regCustomLatencyStatus={0};
 
     mmInterface intf;
     orderBookResponseVerify_t responseVerify;
@@ -39,18 +46,43 @@ int main()
     hls::stream<orderBookResponsePack_t> responseStreamPackFIFO;
     hls::stream<orderEntryOperationPack_t> operationStreamPackFIFO;
     hls::stream<clockTickGeneratorEvent_t> eventStreamFIFO;
+    hls::stream<orderEntryCredit_t> creditStreamFIFO;
+    hls::stream<clockTickGeneratorTimerPack_t> timerArmStreamPackFIFO;
+    hls::stream<orderEntryExecReportPack_t> execReportStreamPackFIFO;
+    orderEntryExecReport_t execReport;
+    orderEntryExecReportPack_t execReportPack;
+    clockTickGeneratorEvent_t timerEvent;
+    clockTickGeneratorTimerEvent_t timerEventData;
+    clockTickGeneratorTimerPack_t timerPack;
+    clockTickGeneratorTimer_t timer;
+    int numTimerArm=0;
+    int numDelete=0;
+    orderEntryCredit_t credit;
+    int numTxOperation=0;
 
     std::cout << "PricingEngine Test" << std::endl;
     std::cout << "------------------" << std::endl;
 
     memset(&regStrategies, 0, sizeof(regStrategies));
 
+    // execution reports for the orders placed by the responses below, order
+    // ids are allocated in response order (PEG=1, LIMIT=2, CUSTOM=3)
+    orderEntryExecReport_t execReports[NUM_TEST_SAMPLE_EXEC] =
+    {
+        // execType, orderId, quantity, price
+        {ORDERENTRY_EXEC_NEW,          1,   0,       0},
+        {ORDERENTRY_EXEC_FILL,         1, 800, 5853400},
+        {ORDERENTRY_EXEC_PARTIAL_FILL, 2, 300, 5853350},
+        {ORDERENTRY_EXEC_REJECTED,     3,   0,       0},
+        {ORDERENTRY_EXEC_FILL,        99, 100, 5853300},
+    };
+
     orderBookResponseVerify_t orderBookResponses[NUM_TEST_SAMPLE_PE] =
     {
         // symbolIndex, bidCount[], bidPrice[], bidQuantity[], askCount[], askPrice[], askQuantity[]
         {0,{1,1,1,0,0},{5853300,5853200,5853100,0,0},{18,18,18,0,0},{8,0,0,0,0},{5859100,0,0,0,0},{18,0,0,0,0}},
-        {0,{1,1,1,0,0},{5853300,5853200,5853100,0,0},{18,18,18,0,0},{1,1,0,0,0},{5859100,5859200,0,0,0},{18,18,0,0,0}},
-        {0,{1,1,1,0,0},{5853300,5853200,5853100,0,0},{18,18,18,0,0},{1,1,1,0,0},{5859100,5859200,5859300,0,0},{18,18,18,0,0}},
+        {1,{1,1,1,0,0},{5853300,5853200,5853100,0,0},{18,18,18,0,0},{1,1,0,0,0},{5859100,5859200,0,0,0},{18,18,0,0,0}},
+        {2,{1,1,1,0,0},{5853300,5853200,5853100,0,0},{18,18,18,0,0},{1,1,1,0,0},{5859100,5859200,5859300,0,0},{18,18,18,0,0}},
         {0,{1,1,1,0,0},{5853300,5853200,5853100,0,0},{18,18,18,0,0},{1,1,1,1,0},{5859100,5859200,5859300,5859300,0},{18,18,100,18,0}},
     };
 
@@ -60,6 +92,7 @@ int main()
         responseVerify = orderBookResponses[i];
 
         response.symbolIndex = responseVerify.symbolIndex;
+        response.ingressTimestamp = (i+1);
 
         response.bidCount = (responseVerify.bidCount[4],
                              responseVerify.bidCount[3],
@@ -106,39 +139,184 @@ int main()
     regControl.config = 0xdeadbeef;
     regControl.capture = 0x00000000;
 
-    // strategy select (per symbol)
+    // single operation in flight, each must be credited before the next
+    regControl.creditLimit = 1;
+
+    // orders are cancelled by timer wheel after lifetime expires
+    regControl.orderLifetime = 10;
+
+    // strategy select (per symbol), symbol 0 peg gated on position threshold
     regStrategies[0].select = STRATEGY_PEG;
-    regStrategies[0].enable = 0xff;
+    regStrategies[0].enable = PE_THRESHOLD_POSITION;
+    regStrategies[0].totalBid = 1000;
+    regStrategies[1].select = STRATEGY_LIMIT;
+    regStrategies[2].select = STRATEGY_CUSTOM;
 
-    // strategy select (global override)
-    regControl.strategy = 0x80000002;
+    // global override disabled, per symbol selection applies
+    regControl.strategy = STRATEGY_LIMIT;
 
-    // kernel call to process operations
-    while(!responseStreamPackFIFO.empty())
+    // kernel call to process operations, calls continue past the last
+    // response to allow operations held on credit to be released
+    for(int i=0; i<(4*NUM_TEST_SAMPLE_PE); i++)
     {
+        // execution reports once the orders have been placed
+        if(i == NUM_TEST_SAMPLE_PE)
+        {
+            for(int j=0; j<NUM_TEST_SAMPLE_EXEC; j++)
+            {
+                execReport = execReports[j];
+                intf.orderEntryExecReportPack(&execReport, &execReportPack);
+                execReportStreamPackFIFO.write(execReportPack);
+            }
+        }
+
+        // lifetime timer expiry for symbols 0 (filled, nothing to cancel)
+        // and 1 (partially filled, cancelled), with a new top of book for
+        // symbol 0 which the peg strategy must hold back as the fill has
+        // taken the position past the threshold
+        if(i == (2*NUM_TEST_SAMPLE_PE))
+        {
+            for(int j=0; j<2; j++)
+            {
+                timerEventData.timerIndex = PE_TIMER_BASE + j;
+                timerEventData.eventCode = CTG_EVENT_ORDER_CANCEL;
+                timerEventData.symbolIndex = j;
+                intf.clockTickGeneratorEventPack(&timerEventData, &timerEvent);
+                eventStreamFIFO.write(timerEvent);
+            }
+
+            response.symbolIndex = 0;
+            response.bidPrice.range(31,0) = 5853500;
+            intf.orderBookResponsePack(&response, &responsePack);
+            responseStreamPackFIFO.write(responsePack);
+        }
+
         pricingEngineTop(regControl,
                          regStatus,
                          regCapture,
                          regStrategies,
                          responseStreamPackFIFO,
                          operationStreamPackFIFO,
-                         eventStreamFIFO);
+                         eventStreamFIFO,
+                         creditStreamFIFO,
+                         timerArmStreamPackFIFO,
+                         regExecStatus,
+                         execReportStreamPackFIFO,
+                         regLatencyStatus,
+                         regIngressLatencyStatus,
+                         regPegLatencyStatus,
+                         regLimitLatencyStatus,
+                         regCustomLatencyStatus);
+
+        // limit of 1 means no more than a single operation can be pending
+        if(operationStreamPackFIFO.size() > 1)
+        {
+            std::cout << "ERROR: operation dispatched without credit" << std::endl;
+            return 1;
+        }
+
+        // drain operation stream, returning credit as OrderEntry would
+        while(!operationStreamPackFIFO.empty())
+        {
+            operationPack = operationStreamPackFIFO.read();
+            intf.orderEntryOperationUnpack(&operationPack, &operation);
+            ++numTxOperation;
+
+            if(ORDERENTRY_DELETE == operation.opCode)
+            {
+                ++numDelete;
+            }
+
+            // strategy orders carry the ingress timestamp of the triggering
+            // response, timer driven operations have none
+            if((ORDERENTRY_DELETE == operation.opCode) != (0 == operation.ingressTimestamp))
+            {
+                std::cout << "ERROR: ingress timestamp not carried to operation" << std::endl;
+                return 1;
+            }
+
+            std::cout << "ORDER_ENTRY_OPERATION: {"
+                      << operation.opCode << ","
+                      << operation.symbolIndex << ","
+                      << operation.orderId << ","
+                      << operation.quantity << ","
+                      << operation.price << ","
+                      << operation.direction << "}"
+                      << std::endl;
+
+            credit.data = 1;
+            credit.keep = 0x1;
+            credit.last = 1;
+            creditStreamFIFO.write(credit);
+        }
+    }
+
+    // drain timer arm requests, one per order placed
+    while(!timerArmStreamPackFIFO.empty())
+    {
+        timerPack = timerArmStreamPackFIFO.read();
+        intf.clockTickGeneratorTimerUnpack(&timerPack, &timer);
+        ++numTimerArm;
+
+        if(((PE_TIMER_BASE + timer.symbolIndex) != timer.timerIndex) || (CTG_EVENT_ORDER_CANCEL != timer.eventCode) || (10 != timer.interval))
+        {
+            std::cout << "ERROR: unexpected order lifetime timer request" << std::endl;
+            return 1;
+        }
+    }
+
+    if((3 != numTimerArm) || (1 != numDelete))
+    {
+        std::cout << "ERROR: order lifetime timer not armed or expiry not acted on" << std::endl;
+        return 1;
+    }
+
+    // one response per strategy plus repeat of symbol 0 at unchanged price
+    if((3 != regStatus.strategyPeg) || (1 != regStatus.strategyLimit) ||
+       (1 != regStatus.strategyCustom) || (4 != numTxOperation))
+    {
+        std::cout << "ERROR: per symbol strategy selection not applied" << std::endl;
+        return 1;
+    }
+
+    // one order placed per strategy, strategy latency shares the wire
+    // timestamp time base with the egress probe so the series must add up
+    if((1 != regPegLatencyStatus.count) || (1 != regLimitLatencyStatus.count) ||
+       (1 != regCustomLatencyStatus.count))
+    {
+        std::cout << "ERROR: strategy latency not recorded per strategy" << std::endl;
+        return 1;
+    }
+
+    if((regPegLatencyStatus.sumLower + regLimitLatencyStatus.sumLower + regCustomLatencyStatus.sumLower) != regLatencyStatus.sumLower)
+    {
+        std::cout << "ERROR: strategy latency not measured against wire timestamp" << std::endl;
+        return 1;
+    }
+
+    if((NUM_TEST_SAMPLE_EXEC != regExecStatus.execReport) || (2 != regExecStatus.execFill) ||
+       (1 != regExecStatus.execReject) || (1 != regExecStatus.execUnmatched))
+    {
+        std::cout << "ERROR: execution reports not matched to orders" << std::endl;
+        return 1;
+    }
+
+    if(numTxOperation != (int)regStatus.txOperation)
+    {
+        std::cout << "ERROR: operations held on credit were not released" << std::endl;
+        return 1;
+    }
+
+    if((numTxOperation - numDelete) != (int)regLatencyStatus.count)
+    {
+        std::cout << "ERROR: latency not recorded for strategy orders" << std::endl;
+        return 1;
     }
 
-    // drain response stream
-    while(!operationStreamPackFIFO.empty())
+    if(regIngressLatencyStatus.count != regStatus.rxResponse)
     {
-        operationPack = operationStreamPackFIFO.read();
-        intf.orderEntryOperationUnpack(&operationPack, &operation);
-
-        std::cout << "ORDER_ENTRY_OPERATION: {"
-                  << operation.opCode << ","
-                  << operation.symbolIndex << ","
-                  << operation.orderId << ","
-                  << operation.quantity << ","
-                  << operation.price << ","
-                  << operation.direction << "}"
-                  << std::endl;
+        std::cout << "ERROR: ingress latency not recorded for every response" << std::endl;
+        return 1;
     }
 
     // log final status
@@ -151,9 +329,23 @@ int main()
     std::cout << "PE_STRATEGY_NONE=" << regStatus.strategyNone << " ";
     std::cout << "PE_STRATEGY_PEG=" << regStatus.strategyPeg << " ";
     std::cout << "PE_STRATEGY_LIMIT=" << regStatus.strategyLimit << " ";
+    std::cout << "PE_STRATEGY_CUSTOM=" << regStatus.strategyCustom << " ";
     std::cout << "PE_STRATEGY_NA=" << regStatus.strategyUnknown << " ";
     std::cout << "PE_RX_EVENT=" << regStatus.rxEvent << " ";
     std::cout << "PE_DEBUG=" << regStatus.debug << " ";
+    std::cout << "PE_CREDIT_AVAILABLE=" << regStatus.creditAvailable << " ";
+    std::cout << "PE_CREDIT_STALL=" << regStatus.creditStall << " ";
+    std::cout << "PE_LATENCY_PEG=" << regPegLatencyStatus.max << " ";
+    std::cout << "PE_LATENCY_LIMIT=" << regLimitLatencyStatus.max << " ";
+    std::cout << "PE_LATENCY_CUSTOM=" << regCustomLatencyStatus.max << " ";
+    std::cout << "PE_EXEC_REPORT=" << regExecStatus.execReport << " ";
+    std::cout << "PE_EXEC_FILL=" << regExecStatus.execFill << " ";
+    std::cout << "PE_EXEC_REJECT=" << regExecStatus.execReject << " ";
+    std::cout << "PE_EXEC_UNMATCHED=" << regExecStatus.execUnmatched << " ";
+    std::cout << "PE_LATENCY_COUNT=" << regLatencyStatus.count << " ";
+    std::cout << "PE_LATENCY_MAX=" << regLatencyStatus.max << " ";
+    std::cout << "PE_INGRESS_LATENCY_COUNT=" << regIngressLatencyStatus.count << " ";
+    std::cout << "PE_INGRESS_LATENCY_MAX=" << regIngressLatencyStatus.max << " ";
     std::cout << std::endl;
 
     std::cout << std::endl;
@@ -20,6 +20,7 @@ set CFLAGS "-I${COMMON_DIR} -I${KERNEL_DIR} -std=c++14"
 
 open_project -reset prj_pe
 add_files ${COMMON_DIR}/aat_interfaces.cpp -cflags ${CFLAGS}
+add_files ${COMMON_DIR}/aat_latency.cpp -cflags ${CFLAGS}
 add_files ${KERNEL_DIR}/pricingengine.cpp -cflags ${CFLAGS}
 add_files ${KERNEL_DIR}/pricingengine_top.cpp  -cflags ${CFLAGS}
 add_files ${KERNEL_DIR}/pricingstrategy_custom.cpp  -cflags ${CFLAGS}
@@ -0,0 +1,704 @@
+/*
+ * Copyright 2021 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <iostream>
+#include "riskengine.hpp"
+
+/**
+ * RiskEngine Core
+ */
+
+void RiskEngine::responseForward(ap_uint<32> &regRxResponse,
+                                 hls::stream<orderBookResponsePack_t> &responseInStreamPack,
+                                 hls::stream<orderBookResponsePack_t> &responseOutStreamPack,
+                                 hls::stream<riskEngineTopOfBook_t> &topOfBookStream)
+{
+#pragma HLS PIPELINE II=1 style=flp
+
+    mmInterface intf;
+    orderBookResponsePack_t responsePack;
+    orderBookResponse_t response;
+    riskEngineTopOfBook_t topOfBook;
+
+    static ap_uint<32> countRxResponse=0;
+
+    // responses are forwarded to the pricing engine untouched, we only tap
+    // off the top of book prices to use as reference for price band checks
+    if(!responseInStreamPack.empty())
+    {
+        responsePack = responseInStreamPack.read();
+        responseOutStreamPack.write(responsePack);
+        ++countRxResponse;
+
+        intf.orderBookResponseUnpack(&responsePack, &response);
+        topOfBook.symbolIndex = response.symbolIndex;
+        topOfBook.bidPrice = response.bidPrice.range(31,0);
+        topOfBook.askPrice = response.askPrice.range(31,0);
+        topOfBookStream.write(topOfBook);
+    }
+
+    regRxResponse = countRxResponse;
+
+    return;
+}
+
+void RiskEngine::execReportForward(hls::stream<orderEntryExecReportPack_t> &execReportInStreamPack,
+                                   hls::stream<orderEntryExecReportPack_t> &execReportOutStreamPack,
+                                   hls::stream<orderEntryExecReport_t> &execReportStream)
+{
+#pragma HLS PIPELINE II=1 style=flp
+
+    mmInterface intf;
+    orderEntryExecReportPack_t execReportPack;
+    orderEntryExecReport_t execReport;
+
+    // execution reports are forwarded to the pricing engine untouched, a copy
+    // is tapped off to move the filled position and release open exposure
+    if(!execReportInStreamPack.empty())
+    {
+        execReportPack = execReportInStreamPack.read();
+        execReportOutStreamPack.write(execReportPack);
+
+        intf.orderEntryExecReportUnpack(&execReportPack, &execReport);
+        execReportStream.write(execReport);
+    }
+
+    return;
+}
+
+void RiskEngine::operationPull(ap_uint<32> &regRxOperation,
+                               ap_uint<32> &regLatencyControl,
+                               ap_uint<32> &regLatencyCount,
+                               ap_uint<32> &regLatencyMin,
+                               ap_uint<32> &regLatencyMax,
+                               ap_uint<32> &regLatencyBin,
+                               ap_uint<32> &regLatencySumLower,
+                               ap_uint<32> &regLatencySumUpper,
+                               hls::stream<ap_uint<64> > &timeStream,
+                               hls::stream<orderEntryOperationPack_t> &operationInStreamPack,
+                               hls::stream<orderEntryOperation_t> &operationStream)
+{
+#pragma HLS PIPELINE II=1 style=flp
+
+    mmInterface intf;
+    orderEntryOperationPack_t operationPack;
+    orderEntryOperation_t operation;
+
+    static ap_uint<32> countRxOperation=0;
+    static LatencyHistogram latency;
+    static LatencyClock latencyClock;
+
+    ap_uint<64> timeNow = latencyClock.now(timeStream);
+
+    if(!operationInStreamPack.empty() && !operationStream.full())
+    {
+        operationPack = operationInStreamPack.read();
+        intf.orderEntryOperationUnpack(&operationPack, &operation);
+        operationStream.write(operation);
+        ++countRxOperation;
+        latency.record(regLatencyControl, timeNow, operation.ingressTimestamp);
+    }
+
+    regRxOperation = countRxOperation;
+
+    latency.update(regLatencyControl,
+                   regLatencyCount,
+                   regLatencyMin,
+                   regLatencyMax,
+                   regLatencyBin,
+                   regLatencySumLower,
+                   regLatencySumUpper);
+
+    return;
+}
+
+void RiskEngine::riskProcess(ap_uint<32> &regControl,
+                             ap_uint<32> &regConfig,
+                             ap_uint<32> &regGlobalPositionLimit,
+                             ap_uint<32> &regGlobalRate,
+                             ap_uint<32> &regLimitSelect,
+                             ap_uint<32> &regLimitValue,
+                             ap_uint<32> &regRejectKill,
+                             ap_uint<32> &regRejectQuantity,
+                             ap_uint<32> &regRejectNotional,
+                             ap_uint<32> &regRejectPriceBand,
+                             ap_uint<32> &regRejectPosition,
+                             ap_uint<32> &regRejectGlobalPosition,
+                             ap_uint<32> &regRejectRate,
+                             ap_uint<32> &regRejectGlobalRate,
+                             ap_uint<32> &regRxEvent,
+                             ap_uint<32> &regGlobalPosition,
+                             ap_uint<32> &regLastReject,
+                             hls::stream<riskEngineTopOfBook_t> &topOfBookStream,
+                             hls::stream<orderEntryOperation_t> &operationStream,
+                             hls::stream<orderEntryExecReport_t> &execReportStream,
+                             hls::stream<clockTickGeneratorEvent_t> &eventStream,
+                             hls::stream<orderEntryOperation_t> &operationCheckedStream,
+                             hls::stream<ap_uint<1> > &creditRejectStream)
+{
+#pragma HLS PIPELINE II=1 style=flp
+
+    clockTickGeneratorEvent_t tickEvent;
+    riskEngineTopOfBook_t topOfBook;
+    orderEntryOperation_t operation;
+    orderEntryExecReport_t execReport;
+    riskEngineOrderEntry_t order;
+
+    ap_uint<8> symbolIndex=0;
+    ap_uint<RE_ORDER_TABLE_INDEX_WIDTH> orderSlot=0;
+    ap_uint<4> limitField=0;
+    ap_int<32> currentPosition=0;
+    ap_uint<32> currentOpenBid=0;
+    ap_uint<32> currentOpenAsk=0;
+    ap_uint<32> currentExposure=0;
+    ap_uint<32> newOpenBid=0;
+    ap_uint<32> newOpenAsk=0;
+    ap_uint<32> newExposure=0;
+    ap_uint<32> newGlobalPosition=0;
+    ap_uint<32> oldOpenQuantity=0;
+    ap_uint<32> newOpenQuantity=0;
+    ap_uint<32> releaseQuantity=0;
+    ap_uint<16> tokens=0;
+    ap_uint<32> tokensTick=0;
+    ap_uint<64> notional=0;
+    ap_uint<32> referencePrice=0;
+    ap_uint<32> priceDelta=0;
+    ap_uint<8> rejectCode=RE_REJECT_NONE;
+    bool isDelete=false;
+
+    static ap_uint<32> countRejectKill=0;
+    static ap_uint<32> countRejectQuantity=0;
+    static ap_uint<32> countRejectNotional=0;
+    static ap_uint<32> countRejectPriceBand=0;
+    static ap_uint<32> countRejectPosition=0;
+    static ap_uint<32> countRejectGlobalPosition=0;
+    static ap_uint<32> countRejectRate=0;
+    static ap_uint<32> countRejectGlobalRate=0;
+    static ap_uint<32> countRxEvent=0;
+    static ap_uint<32> lastReject=0;
+
+    static ap_uint<32> tickCount=0;
+    static ap_uint<32> globalPosition=0;
+    static ap_uint<16> globalTokens=0;
+    static ap_uint<1>  limitStrobe=0;
+    static ap_uint<8>  resetIndex=0;
+
+    // single entry forwarding of the per symbol read-modify-write state, covers
+    // back-to-back operations on the same symbol without stalling the pipeline
+    static bool forwardValid=false;
+    static ap_uint<8>  forwardSymbol=0;
+    static ap_int<32>  forwardPosition=0;
+    static ap_uint<32> forwardOpenBid=0;
+    static ap_uint<32> forwardOpenAsk=0;
+    static ap_uint<16> forwardTokens=0;
+    static ap_uint<32> forwardTick=0;
+    static bool forwardOrderValid=false;
+    static ap_uint<RE_ORDER_TABLE_INDEX_WIDTH> forwardOrderSlot=0;
+    static riskEngineOrderEntry_t forwardOrder;
+
+#pragma HLS DEPENDENCE variable=position inter false
+#pragma HLS DEPENDENCE variable=openBid inter false
+#pragma HLS DEPENDENCE variable=openAsk inter false
+#pragma HLS DEPENDENCE variable=orders inter false
+#pragma HLS DEPENDENCE variable=bucketTokens inter false
+#pragma HLS DEPENDENCE variable=bucketTick inter false
+
+    if(RE_RESET_COUNT & regControl)
+    {
+        countRejectKill = 0;
+        countRejectQuantity = 0;
+        countRejectNotional = 0;
+        countRejectPriceBand = 0;
+        countRejectPosition = 0;
+        countRejectGlobalPosition = 0;
+        countRejectRate = 0;
+        countRejectGlobalRate = 0;
+        countRxEvent = 0;
+        lastReject = 0;
+    }
+
+    // limit table write port, applied on toggle of the strobe bit
+    if(limitStrobe != regLimitSelect.range(31,31))
+    {
+        limitStrobe = regLimitSelect.range(31,31);
+        symbolIndex = regLimitSelect.range(7,0);
+        limitField = regLimitSelect.range(11,8);
+
+        switch(limitField)
+        {
+            case(RE_LIMIT_MAX_QUANTITY):
+                limitMaxQuantity[symbolIndex] = regLimitValue;
+                break;
+            case(RE_LIMIT_MAX_NOTIONAL_LO):
+                limitMaxNotional[symbolIndex].range(31,0) = regLimitValue;
+                break;
+            case(RE_LIMIT_MAX_NOTIONAL_HI):
+                limitMaxNotional[symbolIndex].range(63,32) = regLimitValue;
+                break;
+            case(RE_LIMIT_MAX_POSITION):
+                limitMaxPosition[symbolIndex] = regLimitValue;
+                break;
+            case(RE_LIMIT_PRICE_BAND):
+                limitPriceBand[symbolIndex] = regLimitValue;
+                break;
+            case(RE_LIMIT_RATE):
+                limitRate[symbolIndex] = regLimitValue;
+                break;
+            default:
+                break;
+        }
+    }
+
+    // clock tick events advance the token bucket epoch, per symbol buckets are
+    // refilled lazily on access, the global bucket is refilled here directly,
+    // timer wheel events addressed to this kernel are counted only
+    if(!eventStream.empty())
+    {
+        eventStream.read(tickEvent);
+        ++countRxEvent;
+
+        if(CTG_EVENT_TICK == tickEvent.data.range(7,0))
+        {
+            ++tickCount;
+            globalTokens = bucketRefill(globalTokens, 1, regGlobalRate);
+        }
+    }
+
+    if(!topOfBookStream.empty())
+    {
+        topOfBook = topOfBookStream.read();
+        topOfBookBid[topOfBook.symbolIndex] = topOfBook.bidPrice;
+        topOfBookAsk[topOfBook.symbolIndex] = topOfBook.askPrice;
+        topOfBookValid[topOfBook.symbolIndex] = 1;
+    }
+
+    if(RE_RESET_DATA & regControl)
+    {
+        // sweep one symbol and one order slot per cycle while reset is held,
+        // host register access latency guarantees full coverage of the tables
+        position[resetIndex] = 0;
+        openBid[resetIndex] = 0;
+        openAsk[resetIndex] = 0;
+        bucketTokens[resetIndex] = 0;
+        bucketTick[resetIndex] = tickCount;
+        orders[resetIndex].orderId = 0;
+        orders[resetIndex].openQuantity = 0;
+        ++resetIndex;
+        globalPosition = 0;
+        globalTokens = 0;
+        forwardValid = false;
+        forwardOrderValid = false;
+    }
+    else if(!execReportStream.empty())
+    {
+        // execution reports are applied ahead of new operations and also while
+        // halted, fills move the filled position and release the matching open
+        // quantity, cancels and rejects release whatever is still open
+        execReport = execReportStream.read();
+        orderSlot = execReport.orderId.range(RE_ORDER_TABLE_INDEX_WIDTH-1,0);
+
+        order = orders[orderSlot];
+        if(forwardOrderValid && (forwardOrderSlot == orderSlot))
+        {
+            order = forwardOrder;
+        }
+
+        // reports for orders this kernel never passed are ignored, order ID 0
+        // is never issued by the PricingEngine and marks a free slot
+        if((0 != order.orderId) && (order.orderId == execReport.orderId))
+        {
+            symbolIndex = order.symbolIndex;
+
+            currentPosition = position[symbolIndex];
+            currentOpenBid = openBid[symbolIndex];
+            currentOpenAsk = openAsk[symbolIndex];
+            tokens = bucketTokens[symbolIndex];
+            tokensTick = bucketTick[symbolIndex];
+
+            if(forwardValid && (forwardSymbol == symbolIndex))
+            {
+                currentPosition = forwardPosition;
+                currentOpenBid = forwardOpenBid;
+                currentOpenAsk = forwardOpenAsk;
+                tokens = forwardTokens;
+                tokensTick = forwardTick;
+            }
+
+            currentExposure = exposure(currentPosition, currentOpenBid, currentOpenAsk);
+
+            releaseQuantity = 0;
+            switch(execReport.execType)
+            {
+                case(ORDERENTRY_EXEC_PARTIAL_FILL):
+                case(ORDERENTRY_EXEC_FILL):
+                    if(ORDER_BID == order.direction)
+                        currentPosition = currentPosition + (ap_int<32>)execReport.quantity;
+                    else
+                        currentPosition = currentPosition - (ap_int<32>)execReport.quantity;
+
+                    if((ORDERENTRY_EXEC_FILL == execReport.execType) || (execReport.quantity > order.openQuantity))
+                        releaseQuantity = order.openQuantity;
+                    else
+                        releaseQuantity = execReport.quantity;
+                    break;
+                case(ORDERENTRY_EXEC_CANCELED):
+                case(ORDERENTRY_EXEC_REJECTED):
+                    releaseQuantity = order.openQuantity;
+                    break;
+                default:
+                    break;
+            }
+
+            if(ORDER_BID == order.direction)
+                currentOpenBid = currentOpenBid - releaseQuantity;
+            else
+                currentOpenAsk = currentOpenAsk - releaseQuantity;
+            order.openQuantity = order.openQuantity - releaseQuantity;
+
+            newExposure = exposure(currentPosition, currentOpenBid, currentOpenAsk);
+            globalPosition = globalPosition - currentExposure + newExposure;
+
+            position[symbolIndex] = currentPosition;
+            openBid[symbolIndex] = currentOpenBid;
+            openAsk[symbolIndex] = currentOpenAsk;
+            orders[orderSlot] = order;
+
+            forwardValid = true;
+            forwardSymbol = symbolIndex;
+            forwardPosition = currentPosition;
+            forwardOpenBid = currentOpenBid;
+            forwardOpenAsk = currentOpenAsk;
+            forwardTokens = tokens;
+            forwardTick = tokensTick;
+            forwardOrderValid = true;
+            forwardOrderSlot = orderSlot;
+            forwardOrder = order;
+        }
+    }
+    else if((0 == (RE_HALT & regControl)) && !operationStream.empty())
+    {
+        operation = operationStream.read();
+        symbolIndex = operation.symbolIndex;
+        orderSlot = operation.orderId.range(RE_ORDER_TABLE_INDEX_WIDTH-1,0);
+
+        currentPosition = position[symbolIndex];
+        currentOpenBid = openBid[symbolIndex];
+        currentOpenAsk = openAsk[symbolIndex];
+        tokens = bucketTokens[symbolIndex];
+        tokensTick = bucketTick[symbolIndex];
+        order = orders[orderSlot];
+
+        if(forwardValid && (forwardSymbol == symbolIndex))
+        {
+            currentPosition = forwardPosition;
+            currentOpenBid = forwardOpenBid;
+            currentOpenAsk = forwardOpenAsk;
+            tokens = forwardTokens;
+            tokensTick = forwardTick;
+        }
+
+        if(forwardOrderValid && (forwardOrderSlot == orderSlot))
+        {
+            order = forwardOrder;
+        }
+
+        tokens = bucketRefill(tokens, (tickCount - tokensTick), limitRate[symbolIndex]);
+
+        // open quantity of the order before and after this operation, adds open
+        // a new order, modifies replace the open quantity and deletes release
+        // it, a modify for an order no longer tracked is treated as a new one
+        isDelete = (ORDERENTRY_DELETE == operation.opCode);
+        oldOpenQuantity = 0;
+        if((ORDERENTRY_ADD != operation.opCode) && (0 != order.orderId) && (order.orderId == operation.orderId))
+            oldOpenQuantity = order.openQuantity;
+
+        newOpenQuantity = operation.quantity;
+        if(isDelete)
+            newOpenQuantity = 0;
+
+        newOpenBid = currentOpenBid;
+        newOpenAsk = currentOpenAsk;
+        if(ORDER_BID == operation.direction)
+            newOpenBid = currentOpenBid - oldOpenQuantity + newOpenQuantity;
+        else
+            newOpenAsk = currentOpenAsk - oldOpenQuantity + newOpenQuantity;
+
+        // exposure is the worst case position should every open order on one
+        // side of the book fill, checked against the per symbol limit and
+        // summed across symbols for the global limit
+        currentExposure = exposure(currentPosition, currentOpenBid, currentOpenAsk);
+        newExposure = exposure(currentPosition, newOpenBid, newOpenAsk);
+        newGlobalPosition = globalPosition - currentExposure + newExposure;
+
+        notional = (ap_uint<64>)operation.quantity * operation.price;
+
+        if(ORDER_BID == operation.direction)
+            referencePrice = topOfBookBid[symbolIndex];
+        else
+            referencePrice = topOfBookAsk[symbolIndex];
+
+        if(operation.price > referencePrice)
+            priceDelta = operation.price - referencePrice;
+        else
+            priceDelta = referencePrice - operation.price;
+
+        // all checks evaluated in parallel, first failure by priority reported
+        if(isDelete)
+            rejectCode = RE_REJECT_NONE;
+        else if(RE_KILL_SWITCH & regControl)
+            rejectCode = RE_REJECT_KILL_SWITCH;
+        else if((RE_CHECK_QUANTITY & regConfig) && (operation.quantity > limitMaxQuantity[symbolIndex]))
+            rejectCode = RE_REJECT_QUANTITY;
+        else if((RE_CHECK_NOTIONAL & regConfig) && (notional > limitMaxNotional[symbolIndex]))
+            rejectCode = RE_REJECT_NOTIONAL;
+        else if((RE_CHECK_PRICE_BAND & regConfig) && (!topOfBookValid[symbolIndex] || (priceDelta > limitPriceBand[symbolIndex])))
+            rejectCode = RE_REJECT_PRICE_BAND;
+        else if((RE_CHECK_POSITION & regConfig) && (newExposure > limitMaxPosition[symbolIndex]))
+            rejectCode = RE_REJECT_POSITION;
+        else if((RE_CHECK_GLOBAL_POSITION & regConfig) && (newGlobalPosition > regGlobalPositionLimit))
+            rejectCode = RE_REJECT_GLOBAL_POSITION;
+        else if((RE_CHECK_RATE & regConfig) && (0 == tokens))
+            rejectCode = RE_REJECT_RATE;
+        else if((RE_CHECK_GLOBAL_RATE & regConfig) && (0 == globalTokens))
+            rejectCode = RE_REJECT_GLOBAL_RATE;
+
+        switch(rejectCode)
+        {
+            case(RE_REJECT_NONE):
+                if(!isDelete)
+                {
+                    if(RE_CHECK_RATE & regConfig)
+                        --tokens;
+                    if(RE_CHECK_GLOBAL_RATE & regConfig)
+                        --globalTokens;
+                }
+                currentOpenBid = newOpenBid;
+                currentOpenAsk = newOpenAsk;
+                globalPosition = newGlobalPosition;
+                order.orderId = operation.orderId;
+                order.symbolIndex = symbolIndex;
+                order.direction = operation.direction;
+                order.openQuantity = newOpenQuantity;
+                operationCheckedStream.write(operation);
+                break;
+            case(RE_REJECT_KILL_SWITCH):
+                ++countRejectKill;
+                break;
+            case(RE_REJECT_QUANTITY):
+                ++countRejectQuantity;
+                break;
+            case(RE_REJECT_NOTIONAL):
+                ++countRejectNotional;
+                break;
+            case(RE_REJECT_PRICE_BAND):
+                ++countRejectPriceBand;
+                break;
+            case(RE_REJECT_POSITION):
+                ++countRejectPosition;
+                break;
+            case(RE_REJECT_GLOBAL_POSITION):
+                ++countRejectGlobalPosition;
+                break;
+            case(RE_REJECT_RATE):
+                ++countRejectRate;
+                break;
+            case(RE_REJECT_GLOBAL_RATE):
+                ++countRejectGlobalRate;
+                break;
+            default:
+                break;
+        }
+
+        if(RE_REJECT_NONE != rejectCode)
+        {
+            lastReject.range(7,0) = rejectCode;
+            lastReject.range(15,8) = symbolIndex;
+
+            // rejected operation never reaches OrderEntry, return the credit
+            // consumed by PricingEngine locally
+            creditRejectStream.write(1);
+        }
+
+        openBid[symbolIndex] = currentOpenBid;
+        openAsk[symbolIndex] = currentOpenAsk;
+        bucketTokens[symbolIndex] = tokens;
+        bucketTick[symbolIndex] = tickCount;
+        orders[orderSlot] = order;
+
+        forwardValid = true;
+        forwardSymbol = symbolIndex;
+        forwardPosition = currentPosition;
+        forwardOpenBid = currentOpenBid;
+        forwardOpenAsk = currentOpenAsk;
+        forwardTokens = tokens;
+        forwardTick = tickCount;
+        forwardOrderValid = true;
+        forwardOrderSlot = orderSlot;
+        forwardOrder = order;
+    }
+
+    regRejectKill = countRejectKill;
+    regRejectQuantity = countRejectQuantity;
+    regRejectNotional = countRejectNotional;
+    regRejectPriceBand = countRejectPriceBand;
+    regRejectPosition = countRejectPosition;
+    regRejectGlobalPosition = countRejectGlobalPosition;
+    regRejectRate = countRejectRate;
+    regRejectGlobalRate = countRejectGlobalRate;
+    regRxEvent = countRxEvent;
+    regGlobalPosition = globalPosition;
+    regLastReject = lastReject;
+
+    return;
+}
+
+void RiskEngine::operationPush(ap_uint<32> &regCaptureControl,
+                               ap_uint<32> &regTxOperation,
+                               ap_uint<1024> &regCaptureBuffer,
+                               ap_uint<32> &regLatencyControl,
+                               ap_uint<32> &regLatencyCount,
+                               ap_uint<32> &regLatencyMin,
+                               ap_uint<32> &regLatencyMax,
+                               ap_uint<32> &regLatencyBin,
+                               ap_uint<32> &regLatencySumLower,
+                               ap_uint<32> &regLatencySumUpper,
+                               hls::stream<ap_uint<64> > &timeStream,
+                               hls::stream<orderEntryOperation_t> &operationCheckedStream,
+                               hls::stream<orderEntryOperationPack_t> &operationOutStreamPack)
+{
+#pragma HLS PIPELINE II=1 style=flp
+
+    mmInterface intf;
+    orderEntryOperation_t operation;
+    orderEntryOperationPack_t operationPack;
+
+    static ap_uint<32> countTxOperation=0;
+    static LatencyHistogram latency;
+    static LatencyClock latencyClock;
+
+    ap_uint<64> timeNow = latencyClock.now(timeStream);
+
+    if(!operationCheckedStream.empty() && !operationOutStreamPack.full())
+    {
+        operation = operationCheckedStream.read();
+
+        intf.orderEntryOperationPack(&operation, &operationPack);
+        operationOutStreamPack.write(operationPack);
+        ++countTxOperation;
+        latency.record(regLatencyControl, timeNow, operation.ingressTimestamp);
+
+        // check if host has capture freeze control enabled before updating
+        if(0 == (RE_CAPTURE_FREEZE & regCaptureControl))
+        {
+            regCaptureBuffer = operationPack.data;
+        }
+    }
+
+    regTxOperation = countTxOperation;
+
+    latency.update(regLatencyControl,
+                   regLatencyCount,
+                   regLatencyMin,
+                   regLatencyMax,
+                   regLatencyBin,
+                   regLatencySumLower,
+                   regLatencySumUpper);
+
+    return;
+}
+
+void RiskEngine::creditForward(hls::stream<ap_uint<1> > &creditRejectStream,
+                               hls::stream<orderEntryCredit_t> &creditInStream,
+                               hls::stream<orderEntryCredit_t> &creditOutStream)
+{
+#pragma HLS PIPELINE II=1 style=flp
+
+    orderEntryCredit_t credit;
+    ap_uint<8> creditCount=0;
+
+    // merge credits returned from OrderEntry with credits for operations
+    // rejected here before forwarding upstream to PricingEngine
+    if(!creditInStream.empty())
+    {
+        credit = creditInStream.read();
+        creditCount = credit.data;
+    }
+
+    if((!creditRejectStream.empty()) && (creditCount < 255))
+    {
+        creditRejectStream.read();
+        ++creditCount;
+    }
+
+    if(0 != creditCount)
+    {
+        credit.data = creditCount;
+        credit.keep = 0x1;
+        credit.last = 1;
+        creditOutStream.write(credit);
+    }
+
+    return;
+}
+
+ap_uint<32> RiskEngine::absolute(ap_int<32> value)
+{
+#pragma HLS INLINE
+
+    ap_uint<32> result;
+
+    if(value < 0)
+        result = -value;
+    else
+        result = value;
+
+    return result;
+}
+
+ap_uint<32> RiskEngine::exposure(ap_int<32> filledPosition,
+                                  ap_uint<32> openBidQuantity,
+                                  ap_uint<32> openAskQuantity)
+{
+#pragma HLS INLINE
+
+    ap_uint<32> longExposure;
+    ap_uint<32> shortExposure;
+
+    // worst case of all bids filling or all asks filling on top of the
+    // position already filled
+    longExposure = absolute(filledPosition + (ap_int<32>)openBidQuantity);
+    shortExposure = absolute(filledPosition - (ap_int<32>)openAskQuantity);
+
+    return ((longExposure > shortExposure) ? longExposure : shortExposure);
+}
+
+ap_uint<16> RiskEngine::bucketRefill(ap_uint<16> tokens,
+                                     ap_uint<32> elapsedTicks,
+                                     ap_uint<32> rateConfig)
+{
+#pragma HLS INLINE
+
+    ap_uint<16> tokensPerTick = rateConfig.range(15,0);
+    ap_uint<16> bucketDepth = rateConfig.range(31,16);
+    ap_uint<49> total;
+
+    total = tokens + ((ap_uint<48>)elapsedTicks * tokensPerTick);
+
+    if(total > bucketDepth)
+        total = bucketDepth;
+
+    return total.range(15,0);
+}
@@ -0,0 +1,229 @@
+/*
+ * Copyright 2021 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef RISKENGINE_H
+#define RISKENGINE_H
+
+#include "hls_stream.h"
+#include "ap_int.h"
+#include "aat_defines.hpp"
+#include "aat_interfaces.hpp"
+#include "aat_latency.hpp"
+
+// RiskEngine control
+#define RE_HALT           (1<<0)
+#define RE_RESET_DATA     (1<<1)
+#define RE_RESET_COUNT    (1<<2)
+#define RE_KILL_SWITCH    (1<<3)
+#define RE_CAPTURE_FREEZE (1<<31)
+
+// RiskEngine config (check enables)
+#define RE_CHECK_QUANTITY        (1<<0)
+#define RE_CHECK_NOTIONAL        (1<<1)
+#define RE_CHECK_PRICE_BAND      (1<<2)
+#define RE_CHECK_POSITION        (1<<3)
+#define RE_CHECK_GLOBAL_POSITION (1<<4)
+#define RE_CHECK_RATE            (1<<5)
+#define RE_CHECK_GLOBAL_RATE     (1<<6)
+
+// limit table write port, host sets value then toggles strobe with field and
+// symbol selected, kernel applies the write on detection of the toggle
+#define RE_LIMIT_WRITE_STROBE (1<<31)
+
+// open order table, indexed by the low bits of the order ID assigned by the
+// PricingEngine, sized to match the PricingEngine order table
+#define RE_ORDER_TABLE_SIZE        (256)
+#define RE_ORDER_TABLE_INDEX_WIDTH (8)
+
+enum RISKENGINE_LIMIT_FIELDS
+{
+    RE_LIMIT_MAX_QUANTITY = 0,
+    RE_LIMIT_MAX_NOTIONAL_LO,
+    RE_LIMIT_MAX_NOTIONAL_HI,
+    RE_LIMIT_MAX_POSITION,
+    RE_LIMIT_PRICE_BAND,
+    RE_LIMIT_RATE
+};
+
+enum RISKENGINE_REJECT_CODES
+{
+    RE_REJECT_NONE = 0,
+    RE_REJECT_KILL_SWITCH,
+    RE_REJECT_QUANTITY,
+    RE_REJECT_NOTIONAL,
+    RE_REJECT_PRICE_BAND,
+    RE_REJECT_POSITION,
+    RE_REJECT_GLOBAL_POSITION,
+    RE_REJECT_RATE,
+    RE_REJECT_GLOBAL_RATE
+};
+
+typedef struct riskEngineRegControl_t
+{
+    ap_uint<32> control;
+    ap_uint<32> config;
+    ap_uint<32> capture;
+    ap_uint<32> globalPositionLimit;
+    ap_uint<32> globalRate;     // [15:0] tokens per tick, [31:16] bucket depth
+    ap_uint<32> limitSelect;    // [7:0] symbol, [11:8] field, [31] strobe
+    ap_uint<32> limitValue;
+    ap_uint<32> latency;
+} riskEngineRegControl_t;
+
+typedef struct riskEngineRegStatus_t
+{
+    ap_uint<32> status;
+    ap_uint<32> rxResponse;
+    ap_uint<32> rxOperation;
+    ap_uint<32> txOperation;
+    ap_uint<32> rejectKill;
+    ap_uint<32> rejectQuantity;
+    ap_uint<32> rejectNotional;
+    ap_uint<32> rejectPriceBand;
+    ap_uint<32> rejectPosition;
+    ap_uint<32> rejectGlobalPosition;
+    ap_uint<32> rejectRate;
+    ap_uint<32> rxEvent;
+    ap_uint<32> globalPosition; // sum of per symbol worst case exposure
+    ap_uint<32> lastReject;     // [7:0] reject code, [15:8] symbol
+    ap_uint<32> rejectGlobalRate;
+    ap_uint<32> reserved15;
+} riskEngineRegStatus_t;
+
+// top of book snapshot extracted from order book response, used as the
+// reference price for the price band check
+typedef struct riskEngineTopOfBook_t
+{
+    ap_uint<8>  symbolIndex;
+    ap_uint<32> bidPrice;
+    ap_uint<32> askPrice;
+} riskEngineTopOfBook_t;
+
+// order accepted by the risk checks, open quantity is the part of the order
+// still resting at the exchange as far as this kernel knows
+typedef struct riskEngineOrderEntry_t
+{
+    ap_uint<32> orderId;
+    ap_uint<8>  symbolIndex;
+    ap_uint<8>  direction;
+    ap_uint<32> openQuantity;
+} riskEngineOrderEntry_t;
+
+/**
+ * RiskEngine Core
+ */
+class RiskEngine
+{
+public:
+
+    void responseForward(ap_uint<32> &regRxResponse,
+                         hls::stream<orderBookResponsePack_t> &responseInStreamPack,
+                         hls::stream<orderBookResponsePack_t> &responseOutStreamPack,
+                         hls::stream<riskEngineTopOfBook_t> &topOfBookStream);
+
+    void execReportForward(hls::stream<orderEntryExecReportPack_t> &execReportInStreamPack,
+                           hls::stream<orderEntryExecReportPack_t> &execReportOutStreamPack,
+                           hls::stream<orderEntryExecReport_t> &execReportStream);
+
+    void operationPull(ap_uint<32> &regRxOperation,
+                       ap_uint<32> &regLatencyControl,
+                       ap_uint<32> &regLatencyCount,
+                       ap_uint<32> &regLatencyMin,
+                       ap_uint<32> &regLatencyMax,
+                       ap_uint<32> &regLatencyBin,
+                       ap_uint<32> &regLatencySumLower,
+                       ap_uint<32> &regLatencySumUpper,
+                       hls::stream<ap_uint<64> > &timeStream,
+                       hls::stream<orderEntryOperationPack_t> &operationInStreamPack,
+                       hls::stream<orderEntryOperation_t> &operationStream);
+
+    void riskProcess(ap_uint<32> &regControl,
+                     ap_uint<32> &regConfig,
+                     ap_uint<32> &regGlobalPositionLimit,
+                     ap_uint<32> &regGlobalRate,
+                     ap_uint<32> &regLimitSelect,
+                     ap_uint<32> &regLimitValue,
+                     ap_uint<32> &regRejectKill,
+                     ap_uint<32> &regRejectQuantity,
+                     ap_uint<32> &regRejectNotional,
+                     ap_uint<32> &regRejectPriceBand,
+                     ap_uint<32> &regRejectPosition,
+                     ap_uint<32> &regRejectGlobalPosition,
+                     ap_uint<32> &regRejectRate,
+                     ap_uint<32> &regRejectGlobalRate,
+                     ap_uint<32> &regRxEvent,
+                     ap_uint<32> &regGlobalPosition,
+                     ap_uint<32> &regLastReject,
+                     hls::stream<riskEngineTopOfBook_t> &topOfBookStream,
+                     hls::stream<orderEntryOperation_t> &operationStream,
+                     hls::stream<orderEntryExecReport_t> &execReportStream,
+                     hls::stream<clockTickGeneratorEvent_t> &eventStream,
+                     hls::stream<orderEntryOperation_t> &operationCheckedStream,
+                     hls::stream<ap_uint<1> > &creditRejectStream);
+
+    void creditForward(hls::stream<ap_uint<1> > &creditRejectStream,
+                       hls::stream<orderEntryCredit_t> &creditInStream,
+                       hls::stream<orderEntryCredit_t> &creditOutStream);
+
+    void operationPush(ap_uint<32> &regCaptureControl,
+                       ap_uint<32> &regTxOperation,
+                       ap_uint<1024> &regCaptureBuffer,
+                       ap_uint<32> &regLatencyControl,
+                       ap_uint<32> &regLatencyCount,
+                       ap_uint<32> &regLatencyMin,
+                       ap_uint<32> &regLatencyMax,
+                       ap_uint<32> &regLatencyBin,
+                       ap_uint<32> &regLatencySumLower,
+                       ap_uint<32> &regLatencySumUpper,
+                       hls::stream<ap_uint<64> > &timeStream,
+                       hls::stream<orderEntryOperation_t> &operationCheckedStream,
+                       hls::stream<orderEntryOperationPack_t> &operationOutStreamPack);
+
+private:
+
+    // per symbol limits, programmed from host via limit table write port
+    ap_uint<32> limitMaxQuantity[NUM_SYMBOL];
+    ap_uint<64> limitMaxNotional[NUM_SYMBOL];
+    ap_uint<32> limitMaxPosition[NUM_SYMBOL];
+    ap_uint<32> limitPriceBand[NUM_SYMBOL];
+    ap_uint<32> limitRate[NUM_SYMBOL];
+
+    // per symbol state, position is moved by fills only, open quantities by
+    // the operations passing the checks and released by deletes, fills,
+    // cancels and rejects
+    ap_uint<32> topOfBookBid[NUM_SYMBOL];
+    ap_uint<32> topOfBookAsk[NUM_SYMBOL];
+    ap_uint<1>  topOfBookValid[NUM_SYMBOL];
+    ap_int<32>  position[NUM_SYMBOL];
+    ap_uint<32> openBid[NUM_SYMBOL];
+    ap_uint<32> openAsk[NUM_SYMBOL];
+    ap_uint<16> bucketTokens[NUM_SYMBOL];
+    ap_uint<32> bucketTick[NUM_SYMBOL];
+
+    riskEngineOrderEntry_t orders[RE_ORDER_TABLE_SIZE];
+
+    ap_uint<32> absolute(ap_int<32> value);
+
+    ap_uint<32> exposure(ap_int<32> filledPosition,
+                         ap_uint<32> openBidQuantity,
+                         ap_uint<32> openAskQuantity);
+
+    ap_uint<16> bucketRefill(ap_uint<16> tokens,
+                             ap_uint<32> elapsedTicks,
+                             ap_uint<32> rateConfig);
+};
+
+#endif
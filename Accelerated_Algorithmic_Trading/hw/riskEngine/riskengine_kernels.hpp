@@ -0,0 +1,38 @@
+/*
+ * Copyright 2021 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef RISKENGINE_KERNELS_H
+#define RISKENGINE_KERNELS_H
+
+#include "riskengine.hpp"
+
+extern "C" void riskEngineTop(riskEngineRegControl_t &regControl,
+                              riskEngineRegStatus_t &regStatus,
+                              ap_uint<1024> &regCapture,
+                              hls::stream<orderBookResponsePack_t> &responseInStreamPack,
+                              hls::stream<orderBookResponsePack_t> &responseOutStreamPack,
+                              hls::stream<orderEntryOperationPack_t> &operationInStreamPack,
+                              hls::stream<orderEntryOperationPack_t> &operationOutStreamPack,
+                              hls::stream<clockTickGeneratorEvent_t> &eventStream,
+                              hls::stream<orderEntryExecReportPack_t> &execReportInStreamPack,
+                              hls::stream<orderEntryExecReportPack_t> &execReportOutStreamPack,
+                              hls::stream<orderEntryCredit_t> &creditInStream,
+                              hls::stream<orderEntryCredit_t> &creditOutStream,
+                              latencyRegStatus_t &regLatencyStatus,
+                              latencyRegStatus_t &regIngressLatencyStatus);
+
+#endif
@@ -0,0 +1,137 @@
+/*
+ * Copyright 2021 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "riskengine_kernels.hpp"
+
+extern "C" void riskEngineTop(riskEngineRegControl_t &regControl,
+                              riskEngineRegStatus_t &regStatus,
+                              ap_uint<1024> &regCapture,
+                              hls::stream<orderBookResponsePack_t> &responseInStreamPack,
+                              hls::stream<orderBookResponsePack_t> &responseOutStreamPack,
+                              hls::stream<orderEntryOperationPack_t> &operationInStreamPack,
+                              hls::stream<orderEntryOperationPack_t> &operationOutStreamPack,
+                              hls::stream<clockTickGeneratorEvent_t> &eventStream,
+                              hls::stream<orderEntryExecReportPack_t> &execReportInStreamPack,
+                              hls::stream<orderEntryExecReportPack_t> &execReportOutStreamPack,
+                              hls::stream<orderEntryCredit_t> &creditInStream,
+                              hls::stream<orderEntryCredit_t> &creditOutStream,
+                              latencyRegStatus_t &regLatencyStatus,
+                              latencyRegStatus_t &regIngressLatencyStatus)
+{
+#pragma HLS INTERFACE s_axilite port=regControl bundle=control
+#pragma HLS INTERFACE s_axilite port=regStatus bundle=control
+#pragma HLS INTERFACE s_axilite port=regCapture bundle=control
+#pragma HLS INTERFACE s_axilite port=regLatencyStatus bundle=control
+#pragma HLS INTERFACE s_axilite port=regIngressLatencyStatus bundle=control
+#pragma HLS INTERFACE ap_none port=regControl
+#pragma HLS INTERFACE ap_none port=regStatus
+#pragma HLS INTERFACE ap_memory port=regCapture
+#pragma HLS INTERFACE ap_none port=regLatencyStatus
+#pragma HLS INTERFACE ap_none port=regIngressLatencyStatus
+#pragma HLS INTERFACE axis port=responseInStreamPack
+#pragma HLS INTERFACE axis port=responseOutStreamPack
+#pragma HLS INTERFACE axis port=operationInStreamPack
+#pragma HLS INTERFACE axis port=operationOutStreamPack
+#pragma HLS INTERFACE axis port=eventStream
+#pragma HLS INTERFACE axis port=execReportInStreamPack
+#pragma HLS INTERFACE axis port=execReportOutStreamPack
+#pragma HLS INTERFACE axis port=creditInStream
+#pragma HLS INTERFACE axis port=creditOutStream
+#pragma HLS INTERFACE ap_ctrl_none port=return
+
+    static hls::stream<riskEngineTopOfBook_t> topOfBookStreamFIFO;
+    static hls::stream<orderEntryOperation_t> operationStreamFIFO;
+    static hls::stream<orderEntryExecReport_t> execReportStreamFIFO;
+    static hls::stream<orderEntryOperation_t> operationCheckedStreamFIFO;
+    static hls::stream<ap_uint<1> > creditRejectStreamFIFO;
+    static RiskEngine kernel;
+    static LatencyTimeBase timeBase;
+    static hls::stream<ap_uint<64> > timeStream[2];
+
+#pragma HLS DISAGGREGATE variable=regControl
+#pragma HLS DISAGGREGATE variable=regStatus
+#pragma HLS DISAGGREGATE variable=regLatencyStatus
+#pragma HLS DISAGGREGATE variable=regIngressLatencyStatus
+#pragma HLS STREAM variable=timeStream depth=2
+#pragma HLS DATAFLOW disable_start_propagation
+
+    timeBase.count<2>(timeStream);
+
+    kernel.responseForward(regStatus.rxResponse,
+                           responseInStreamPack,
+                           responseOutStreamPack,
+                           topOfBookStreamFIFO);
+
+    kernel.execReportForward(execReportInStreamPack,
+                             execReportOutStreamPack,
+                             execReportStreamFIFO);
+
+    kernel.operationPull(regStatus.rxOperation,
+                         regControl.latency,
+                         regIngressLatencyStatus.count,
+                         regIngressLatencyStatus.min,
+                         regIngressLatencyStatus.max,
+                         regIngressLatencyStatus.bin,
+                         regIngressLatencyStatus.sumLower,
+                         regIngressLatencyStatus.sumUpper,
+                         timeStream[0],
+                         operationInStreamPack,
+                         operationStreamFIFO);
+
+    kernel.riskProcess(regControl.control,
+                       regControl.config,
+                       regControl.globalPositionLimit,
+                       regControl.globalRate,
+                       regControl.limitSelect,
+                       regControl.limitValue,
+                       regStatus.rejectKill,
+                       regStatus.rejectQuantity,
+                       regStatus.rejectNotional,
+                       regStatus.rejectPriceBand,
+                       regStatus.rejectPosition,
+                       regStatus.rejectGlobalPosition,
+                       regStatus.rejectRate,
+                       regStatus.rejectGlobalRate,
+                       regStatus.rxEvent,
+                       regStatus.globalPosition,
+                       regStatus.lastReject,
+                       topOfBookStreamFIFO,
+                       operationStreamFIFO,
+                       execReportStreamFIFO,
+                       eventStream,
+                       operationCheckedStreamFIFO,
+                       creditRejectStreamFIFO);
+
+    kernel.operationPush(regControl.capture,
+                         regStatus.txOperation,
+                         regCapture,
+                         regControl.latency,
+                         regLatencyStatus.count,
+                         regLatencyStatus.min,
+                         regLatencyStatus.max,
+                         regLatencyStatus.bin,
+                         regLatencyStatus.sumLower,
+                         regLatencyStatus.sumUpper,
+                         timeStream[1],
+                         operationCheckedStreamFIFO,
+                         operationOutStreamPack);
+
+    kernel.creditForward(creditRejectStreamFIFO,
+                         creditInStream,
+                         creditOutStream);
+
+}
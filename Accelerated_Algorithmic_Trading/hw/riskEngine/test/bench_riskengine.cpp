@@ -0,0 +1,179 @@
+/*
+ * Copyright 2021 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+
+#include "riskengine_kernels.hpp"
+#include "aat_bench.hpp"
+
+// symbols the synthetic operations are spread over, operations held in the
+// input stream ahead of the kernel and calls made to flush the pipeline
+#define BENCH_NUM_SYMBOL        (16)
+#define BENCH_BACKLOG_OPERATION (16)
+#define BENCH_DRAIN_CALLS       (64)
+
+static AatBench bench("riskEngine", 1000000);
+
+static riskEngineRegControl_t regControl={0};
+static riskEngineRegStatus_t regStatus={0};
+static ap_uint<1024> regCapture=0x0;
+static latencyRegStatus_t regLatencyStatus={0};
+static latencyRegStatus_t regIngressLatencyStatus={0};
+
+static hls::stream<orderBookResponsePack_t> responseInStreamPackFIFO;
+static hls::stream<orderBookResponsePack_t> responseOutStreamPackFIFO;
+static hls::stream<orderEntryOperationPack_t> operationInStreamPackFIFO;
+static hls::stream<orderEntryOperationPack_t> operationOutStreamPackFIFO;
+static hls::stream<clockTickGeneratorEvent_t> eventStreamFIFO;
+static hls::stream<orderEntryExecReportPack_t> execReportInStreamPackFIFO;
+static hls::stream<orderEntryExecReportPack_t> execReportOutStreamPackFIFO;
+static hls::stream<orderEntryCredit_t> creditInStreamFIFO;
+static hls::stream<orderEntryCredit_t> creditOutStreamFIFO;
+
+static void riskEngineCall(void)
+{
+    riskEngineTop(regControl,
+                  regStatus,
+                  regCapture,
+                  responseInStreamPackFIFO,
+                  responseOutStreamPackFIFO,
+                  operationInStreamPackFIFO,
+                  operationOutStreamPackFIFO,
+                  eventStreamFIFO,
+                  execReportInStreamPackFIFO,
+                  execReportOutStreamPackFIFO,
+                  creditInStreamFIFO,
+                  creditOutStreamFIFO,
+                  regLatencyStatus,
+                  regIngressLatencyStatus);
+    bench.call();
+
+    while(!operationOutStreamPackFIFO.empty())
+    {
+        operationOutStreamPackFIFO.read();
+        bench.output();
+    }
+
+    while(!responseOutStreamPackFIFO.empty())
+    {
+        responseOutStreamPackFIFO.read();
+    }
+
+    while(!creditOutStreamFIFO.empty())
+    {
+        creditOutStreamFIFO.read();
+    }
+}
+
+static void riskEngineLimitWrite(ap_uint<8> symbolIndex, ap_uint<4> field, ap_uint<32> value)
+{
+    ap_uint<32> strobe = (regControl.limitSelect & RE_LIMIT_WRITE_STROBE) ^ RE_LIMIT_WRITE_STROBE;
+
+    regControl.limitValue = value;
+    regControl.limitSelect = strobe | ((ap_uint<32>)field << 8) | symbolIndex;
+    riskEngineCall();
+}
+
+int main(int argc, char *argv[])
+{
+    mmInterface intf;
+    orderBookResponse_t response;
+    orderBookResponsePack_t responsePack;
+    orderEntryOperation_t operation;
+    orderEntryOperationPack_t operationPack;
+    uint32_t seed=1;
+    uint64_t sequence=0;
+
+    if(!bench.parseArgs(argc, argv))
+    {
+        return 1;
+    }
+
+    memset(&response, 0, sizeof(response));
+    memset(&operation, 0, sizeof(operation));
+
+    // limits wide enough for every synthetic order to pass all static checks,
+    // so each operation runs the full check pipeline through to the output
+    for(int i=0; i<BENCH_NUM_SYMBOL; i++)
+    {
+        riskEngineLimitWrite(i, RE_LIMIT_MAX_QUANTITY, 1000);
+        riskEngineLimitWrite(i, RE_LIMIT_MAX_NOTIONAL_LO, 0xffffffff);
+        riskEngineLimitWrite(i, RE_LIMIT_MAX_NOTIONAL_HI, 0x00000001);
+        riskEngineLimitWrite(i, RE_LIMIT_MAX_POSITION, 0x7fffffff);
+        riskEngineLimitWrite(i, RE_LIMIT_PRICE_BAND, 5000);
+
+        // top of book reference for the price band check
+        response.symbolIndex = i;
+        response.bidPrice.range(31,0) = 5853300;
+        response.askPrice.range(31,0) = 5859100;
+        intf.orderBookResponsePack(&response, &responsePack);
+        responseInStreamPackFIFO.write(responsePack);
+        riskEngineCall();
+    }
+
+    regControl.globalPositionLimit = 0x7fffffff;
+    regControl.config = RE_CHECK_QUANTITY |
+                        RE_CHECK_NOTIONAL |
+                        RE_CHECK_PRICE_BAND |
+                        RE_CHECK_POSITION |
+                        RE_CHECK_GLOBAL_POSITION;
+
+    bench.start();
+
+    while(bench.running())
+    {
+        // bids and asks alternate per symbol, no fills are fed back so open
+        // exposure only grows and stays well inside the wide limits
+        if(operationInStreamPackFIFO.size() < BENCH_BACKLOG_OPERATION)
+        {
+            seed = (seed * 1103515245) + 12345;
+
+            operation.opCode = ORDERENTRY_ADD;
+            operation.symbolIndex = (sequence % BENCH_NUM_SYMBOL);
+            operation.orderId = sequence;
+            operation.quantity = ((seed >> 16) & 0xFF) + 1;
+            operation.direction = ((sequence / BENCH_NUM_SYMBOL) & 0x1) ? ORDER_ASK : ORDER_BID;
+            operation.price = (ORDER_ASK == operation.direction) ? 5859100 : 5853300;
+            operation.ingressTimestamp = bench.timestamp();
+
+            intf.orderEntryOperationPack(&operation, &operationPack);
+            operationInStreamPackFIFO.write(operationPack);
+            bench.event();
+            ++sequence;
+        }
+
+        riskEngineCall();
+    }
+
+    for(int i=0; i<BENCH_DRAIN_CALLS; i++)
+    {
+        riskEngineCall();
+    }
+
+    bench.stop();
+
+    while(!operationInStreamPackFIFO.empty())
+    {
+        operationInStreamPackFIFO.read();
+    }
+
+    bench.probe("INGRESS", regIngressLatencyStatus);
+    bench.probe("EGRESS", regLatencyStatus);
+
+    return bench.report();
+}
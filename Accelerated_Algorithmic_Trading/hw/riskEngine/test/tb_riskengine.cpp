@@ -0,0 +1,416 @@
+/*
+ * Copyright 2021 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+
+#include "riskengine_kernels.hpp"
+
+#define NUM_TEST_SAMPLE_RE (8)
+#define NUM_TEST_SAMPLE_RE_EXPOSURE (6)
+#define NUM_TEST_SAMPLE_RE_EXEC (2)
+
+// wire to stage delays stamped on the known delay operations
+#define TEST_DELAY_SHORT (100)
+#define TEST_DELAY_LONG (300)
+
+static riskEngineRegControl_t regControl={0};
+static riskEngineRegStatus_t regStatus={0};
+static ap_uint<1024> regCapture=0x0;
+static latencyRegStatus_t regLatencyStatus={0};
+static latencyRegStatus_t regIngressLatencyStatus={0};
+
+static hls::stream<orderBookResponsePack_t> responseInStreamPackFIFO;
+static hls::stream<orderBookResponsePack_t> responseOutStreamPackFIFO;
+static hls::stream<orderEntryOperationPack_t> operationInStreamPackFIFO;
+static hls::stream<orderEntryOperationPack_t> operationOutStreamPackFIFO;
+static hls::stream<clockTickGeneratorEvent_t> eventStreamFIFO;
+static hls::stream<orderEntryExecReportPack_t> execReportInStreamPackFIFO;
+static hls::stream<orderEntryExecReportPack_t> execReportOutStreamPackFIFO;
+static hls::stream<orderEntryCredit_t> creditInStreamFIFO;
+static hls::stream<orderEntryCredit_t> creditOutStreamFIFO;
+
+// in C simulation the kernel time base advances once per top call and the
+// probes read numCall (from 1) during call numCall
+static uint64_t numCall=0;
+
+static void riskEngineCall(void)
+{
+    ++numCall;
+    riskEngineTop(regControl,
+                  regStatus,
+                  regCapture,
+                  responseInStreamPackFIFO,
+                  responseOutStreamPackFIFO,
+                  operationInStreamPackFIFO,
+                  operationOutStreamPackFIFO,
+                  eventStreamFIFO,
+                  execReportInStreamPackFIFO,
+                  execReportOutStreamPackFIFO,
+                  creditInStreamFIFO,
+                  creditOutStreamFIFO,
+                  regLatencyStatus,
+                  regIngressLatencyStatus);
+}
+
+static void riskEngineLimitWrite(ap_uint<8> symbolIndex, ap_uint<4> field, ap_uint<32> value)
+{
+    ap_uint<32> strobe = (regControl.limitSelect & RE_LIMIT_WRITE_STROBE) ^ RE_LIMIT_WRITE_STROBE;
+
+    regControl.limitValue = value;
+    regControl.limitSelect = strobe | ((ap_uint<32>)field << 8) | symbolIndex;
+    riskEngineCall();
+}
+
+static void riskEngineTick(void)
+{
+    clockTickGeneratorEvent_t tickEvent;
+
+    tickEvent.data = CTG_EVENT_TICK;
+    eventStreamFIFO.write(tickEvent);
+    riskEngineCall();
+}
+
+int main()
+{
+    mmInterface intf;
+    orderBookResponse_t response;
+    orderBookResponsePack_t responsePack;
+    orderEntryOperation_t operation;
+    orderEntryOperationPack_t operationPack;
+    orderEntryExecReportPack_t execReportPack;
+    orderEntryCredit_t credit;
+    int numTxExpected=0;
+    int numTxOperation=0;
+    int numCreditReturn=0;
+    int numExecReport=0;
+    int numRxOperation=0;
+    bool testPassed=true;
+
+    std::cout << "RiskEngine Test" << std::endl;
+    std::cout << "---------------" << std::endl;
+
+    orderEntryOperation_t operations[NUM_TEST_SAMPLE_RE] =
+    {
+        // timestamp, opCode, symbolIndex, orderId, quantity, price, direction
+        {0, ORDERENTRY_ADD,    0, 1,  800, 5853400, ORDER_BID}, // pass
+        {0, ORDERENTRY_ADD,    0, 2, 1200, 5853400, ORDER_BID}, // reject quantity
+        {0, ORDERENTRY_ADD,    0, 3,  100, 5863400, ORDER_BID}, // reject price band
+        {0, ORDERENTRY_ADD,    0, 4,  800, 5853400, ORDER_BID}, // reject position
+        {0, ORDERENTRY_ADD,    0, 5,  100, 5859100, ORDER_ASK}, // pass
+        {0, ORDERENTRY_ADD,    0, 6,  100, 5859100, ORDER_ASK}, // reject rate
+        {0, ORDERENTRY_DELETE, 0, 1,  800, 5853400, ORDER_BID}, // pass
+        {0, ORDERENTRY_ADD,    1, 7,  100, 5853400, ORDER_BID}, // reject kill switch
+    };
+
+    bool operationsExpected[NUM_TEST_SAMPLE_RE] = {true, false, false, false, true, false, true, false};
+
+    // deleted, filled and cancelled orders release their open exposure, the
+    // second add lands exactly on the position limit of 1500, the last add is
+    // throttled by the global bucket only
+    orderEntryOperation_t operationsExposure[NUM_TEST_SAMPLE_RE_EXPOSURE] =
+    {
+        // timestamp, opCode, symbolIndex, orderId, quantity, price, direction
+        {0, ORDERENTRY_ADD,    0,  8,  800, 5853400, ORDER_BID}, // pass
+        {0, ORDERENTRY_ADD,    0,  9,  700, 5853400, ORDER_BID}, // pass, at the limit
+        {0, ORDERENTRY_ADD,    0, 10,  100, 5853400, ORDER_BID}, // reject position
+        {0, ORDERENTRY_MODIFY, 0,  9,  600, 5853400, ORDER_BID}, // pass
+        {0, ORDERENTRY_ADD,    0, 11,  100, 5859100, ORDER_ASK}, // pass
+        {0, ORDERENTRY_ADD,    0, 12,  100, 5859100, ORDER_ASK}, // reject global rate
+    };
+
+    bool operationsExposureExpected[NUM_TEST_SAMPLE_RE_EXPOSURE] = {true, true, false, true, true, false};
+
+    orderEntryExecReport_t execReports[NUM_TEST_SAMPLE_RE_EXEC] =
+    {
+        // execType, orderId, quantity, price
+        {ORDERENTRY_EXEC_FILL,     8, 800, 5853400},
+        {ORDERENTRY_EXEC_CANCELED, 9,   0,       0},
+    };
+
+    // configure limits for symbol 0, symbol 1 left at defaults
+    riskEngineLimitWrite(0, RE_LIMIT_MAX_QUANTITY, 1000);
+    riskEngineLimitWrite(0, RE_LIMIT_MAX_NOTIONAL_LO, 0xffffffff);
+    riskEngineLimitWrite(0, RE_LIMIT_MAX_NOTIONAL_HI, 0x00000001);
+    riskEngineLimitWrite(0, RE_LIMIT_MAX_POSITION, 1500);
+    riskEngineLimitWrite(0, RE_LIMIT_PRICE_BAND, 500);
+    riskEngineLimitWrite(0, RE_LIMIT_RATE, (2<<16) | 2);
+
+    regControl.globalPositionLimit = 10000;
+    regControl.globalRate = (100<<16) | 100;
+    regControl.config = RE_CHECK_QUANTITY |
+                        RE_CHECK_NOTIONAL |
+                        RE_CHECK_PRICE_BAND |
+                        RE_CHECK_POSITION |
+                        RE_CHECK_GLOBAL_POSITION |
+                        RE_CHECK_RATE |
+                        RE_CHECK_GLOBAL_RATE;
+
+    // top of book reference for symbol 0
+    memset(&response, 0, sizeof(response));
+    response.symbolIndex = 0;
+    response.bidPrice.range(31,0) = 5853300;
+    response.askPrice.range(31,0) = 5859100;
+    intf.orderBookResponsePack(&response, &responsePack);
+    responseInStreamPackFIFO.write(responsePack);
+
+    // single tick to fill token buckets
+    riskEngineTick();
+
+    for(int i=0; i<NUM_TEST_SAMPLE_RE; i++)
+    {
+        // last operation is issued with kill switch engaged
+        if(i == (NUM_TEST_SAMPLE_RE-1))
+        {
+            regControl.control = RE_KILL_SWITCH;
+        }
+
+        // ingress timestamp as stamped by LineHandler, never zero
+        operations[i].ingressTimestamp = (++numRxOperation);
+        intf.orderEntryOperationPack(&operations[i], &operationPack);
+        operationInStreamPackFIFO.write(operationPack);
+        riskEngineCall();
+
+        if(operationsExpected[i])
+        {
+            ++numTxExpected;
+        }
+    }
+
+    // order 1 was deleted so only the ask of order 5 is still open
+    if(regStatus.globalPosition != 100)
+    {
+        std::cout << "ERROR: delete did not release exposure, global position " << regStatus.globalPosition << std::endl;
+        testPassed = false;
+    }
+
+    // refill both buckets, global bucket limited to the four operations
+    // expected to pass
+    regControl.control = 0;
+    regControl.globalRate = (4<<16) | 4;
+    riskEngineLimitWrite(0, RE_LIMIT_RATE, (8<<16) | 8);
+    riskEngineTick();
+
+    for(int i=0; i<NUM_TEST_SAMPLE_RE_EXPOSURE; i++)
+    {
+        // fill the first bid and cancel the second before modifying it, the
+        // modify then reopens the cancelled order with its new quantity
+        if(i == 3)
+        {
+            for(int j=0; j<NUM_TEST_SAMPLE_RE_EXEC; j++)
+            {
+                intf.orderEntryExecReportPack(&execReports[j], &execReportPack);
+                execReportInStreamPackFIFO.write(execReportPack);
+                riskEngineCall();
+            }
+
+            // filled bid of 800 against the ask of 100 still open
+            if(regStatus.globalPosition != 800)
+            {
+                std::cout << "ERROR: fill did not move position, global position " << regStatus.globalPosition << std::endl;
+                testPassed = false;
+            }
+        }
+
+        operationsExposure[i].ingressTimestamp = (++numRxOperation);
+        intf.orderEntryOperationPack(&operationsExposure[i], &operationPack);
+        operationInStreamPackFIFO.write(operationPack);
+        riskEngineCall();
+
+        if(operationsExposureExpected[i])
+        {
+            ++numTxExpected;
+        }
+    }
+
+    // filled 800 plus the modified bid of 600 still open
+    if(regStatus.globalPosition != 1400)
+    {
+        std::cout << "ERROR: expected global position 1400, got " << regStatus.globalPosition << std::endl;
+        testPassed = false;
+    }
+
+    if((regStatus.rejectRate != 1) || (regStatus.rejectGlobalRate != 1) || (regStatus.rejectPosition != 2))
+    {
+        std::cout << "ERROR: reject counters do not match operations" << std::endl;
+        testPassed = false;
+    }
+
+    // response should be forwarded untouched
+    if(responseOutStreamPackFIFO.empty())
+    {
+        std::cout << "ERROR: response not forwarded" << std::endl;
+        testPassed = false;
+    }
+    else
+    {
+        responseOutStreamPackFIFO.read();
+    }
+
+    // execution reports should be forwarded untouched
+    while(!execReportOutStreamPackFIFO.empty())
+    {
+        execReportOutStreamPackFIFO.read();
+        ++numExecReport;
+    }
+
+    if(numExecReport != NUM_TEST_SAMPLE_RE_EXEC)
+    {
+        std::cout << "ERROR: expected " << NUM_TEST_SAMPLE_RE_EXEC << " execution reports, received " << numExecReport << std::endl;
+        testPassed = false;
+    }
+
+    // drain operation stream
+    while(!operationOutStreamPackFIFO.empty())
+    {
+        operationPack = operationOutStreamPackFIFO.read();
+        intf.orderEntryOperationUnpack(&operationPack, &operation);
+        ++numTxOperation;
+
+        std::cout << "ORDER_ENTRY_OPERATION: {"
+                  << operation.opCode << ","
+                  << operation.symbolIndex << ","
+                  << operation.orderId << ","
+                  << operation.quantity << ","
+                  << operation.price << ","
+                  << operation.direction << "}"
+                  << std::endl;
+    }
+
+    if(numTxOperation != numTxExpected)
+    {
+        std::cout << "ERROR: expected " << numTxExpected << " operations, received " << numTxOperation << std::endl;
+        testPassed = false;
+    }
+
+    // each rejected operation should have returned its credit upstream
+    while(!creditOutStreamFIFO.empty())
+    {
+        credit = creditOutStreamFIFO.read();
+        numCreditReturn += credit.data;
+    }
+
+    if(numCreditReturn != (numRxOperation - numTxExpected))
+    {
+        std::cout << "ERROR: expected " << (numRxOperation - numTxExpected) << " credits, received " << numCreditReturn << std::endl;
+        testPassed = false;
+    }
+
+    // every operation is sampled on the way in, only those passing on the way out
+    if((regIngressLatencyStatus.count != numRxOperation) || (regLatencyStatus.count != numTxExpected))
+    {
+        std::cout << "ERROR: latency samples do not match operations" << std::endl;
+        testPassed = false;
+    }
+
+    // log final status
+    std::cout << "--" << std::hex << std::endl;
+    std::cout << "STATUS: ";
+    std::cout << "RE_RX_RESP=" << regStatus.rxResponse << " ";
+    std::cout << "RE_RX_OP=" << regStatus.rxOperation << " ";
+    std::cout << "RE_TX_OP=" << regStatus.txOperation << " ";
+    std::cout << "RE_REJ_KILL=" << regStatus.rejectKill << " ";
+    std::cout << "RE_REJ_QTY=" << regStatus.rejectQuantity << " ";
+    std::cout << "RE_REJ_NOTIONAL=" << regStatus.rejectNotional << " ";
+    std::cout << "RE_REJ_BAND=" << regStatus.rejectPriceBand << " ";
+    std::cout << "RE_REJ_POS=" << regStatus.rejectPosition << " ";
+    std::cout << "RE_REJ_GPOS=" << regStatus.rejectGlobalPosition << " ";
+    std::cout << "RE_REJ_RATE=" << regStatus.rejectRate << " ";
+    std::cout << "RE_REJ_GRATE=" << regStatus.rejectGlobalRate << " ";
+    std::cout << "RE_RX_EVENT=" << regStatus.rxEvent << " ";
+    std::cout << "RE_GPOS=" << regStatus.globalPosition << " ";
+    std::cout << "RE_LAST_REJ=" << regStatus.lastReject << " ";
+    std::cout << "RE_LATENCY_COUNT=" << regLatencyStatus.count << " ";
+    std::cout << "RE_LATENCY_MAX=" << regLatencyStatus.max << " ";
+    std::cout << "RE_INGRESS_LATENCY_COUNT=" << regIngressLatencyStatus.count << " ";
+    std::cout << "RE_INGRESS_LATENCY_MAX=" << regIngressLatencyStatus.max << " ";
+    std::cout << std::endl << std::dec;
+
+    // known delays: with the statistics cleared, two operations stamped a
+    // fixed number of cycles before the time base value of the call that
+    // reads them are recorded as exactly that on the way in, and the same
+    // transit through the kernel is added to both on the way out
+    regControl.latency = LATENCY_RESET;
+    while(numCall <= TEST_DELAY_LONG)
+    {
+        riskEngineCall();
+    }
+    regControl.latency = 0;
+    riskEngineTick();
+
+    orderEntryOperation_t operationsDelay[2] =
+    {
+        // timestamp, opCode, symbolIndex, orderId, quantity, price, direction
+        {0, ORDERENTRY_DELETE, 0, 11, 100, 5859100, ORDER_ASK}, // pass
+        {0, ORDERENTRY_DELETE, 0,  9, 600, 5853400, ORDER_BID}, // pass
+    };
+    const uint64_t delays[2] = {TEST_DELAY_SHORT, TEST_DELAY_LONG};
+
+    for(int i=0; i<2; i++)
+    {
+        operationsDelay[i].ingressTimestamp = (numCall + 1) - delays[i];
+        intf.orderEntryOperationPack(&operationsDelay[i], &operationPack);
+        operationInStreamPackFIFO.write(operationPack);
+        riskEngineCall();
+    }
+
+    for(int i=0; i<4; i++)
+    {
+        riskEngineCall();
+    }
+
+    while(!operationOutStreamPackFIFO.empty())
+    {
+        operationOutStreamPackFIFO.read();
+    }
+
+    uint64_t ingressSum = ((uint64_t)regIngressLatencyStatus.sumUpper << 32) | regIngressLatencyStatus.sumLower;
+    uint64_t egressSum = ((uint64_t)regLatencyStatus.sumUpper << 32) | regLatencyStatus.sumLower;
+    uint64_t transit = (uint64_t)regLatencyStatus.min - (uint64_t)regIngressLatencyStatus.min;
+
+    if((regIngressLatencyStatus.count != 2) ||
+       (regIngressLatencyStatus.min != TEST_DELAY_SHORT) ||
+       (regIngressLatencyStatus.max != TEST_DELAY_LONG) ||
+       (ingressSum != (TEST_DELAY_SHORT + TEST_DELAY_LONG)))
+    {
+        std::cout << "ERROR: ingress latency of known delays, count " << regIngressLatencyStatus.count
+                  << " min " << regIngressLatencyStatus.min << " max " << regIngressLatencyStatus.max
+                  << " sum " << ingressSum << std::endl;
+        testPassed = false;
+    }
+
+    if((regLatencyStatus.count != 2) ||
+       (regLatencyStatus.min < TEST_DELAY_SHORT) ||
+       (regLatencyStatus.max != (TEST_DELAY_LONG + transit)) ||
+       (egressSum != (TEST_DELAY_SHORT + TEST_DELAY_LONG + (2 * transit))))
+    {
+        std::cout << "ERROR: egress latency of known delays, count " << regLatencyStatus.count
+                  << " min " << regLatencyStatus.min << " max " << regLatencyStatus.max
+                  << " sum " << egressSum << std::endl;
+        testPassed = false;
+    }
+
+    std::cout << "KNOWN_DELAY: INGRESS=" << TEST_DELAY_SHORT << "," << TEST_DELAY_LONG
+              << " EGRESS=" << regLatencyStatus.min << "," << regLatencyStatus.max
+              << " TRANSIT=" << transit << std::endl;
+
+    std::cout << std::endl;
+    std::cout << (testPassed ? "Done!" : "FAILED!") << std::endl;
+
+    return (testPassed ? 0 : 1);
+}
@@ -39,7 +39,11 @@
 #include <iomanip>
 #include "ap_axi_sdata.h"
 
+// Network datapath width, the UDP receive chain (ip_handler, ipv4, udp) may be
+// built wider for 25/100GbE feeds
+#ifndef AXI_WIDTH
 #define AXI_WIDTH 64
+#endif
 
 // Adaptation of ap_axiu<>
 template <int D>
@@ -382,6 +386,20 @@ void rshiftWordByOctet(uint16_t offset, hls::stream<Tin>& input, hls::stream<Tou
 
     sendWord.last = 0;
     switch (fsmState) {
+        case REMAINDER:
+            sendWord.data((W - 1) - (8 * offset), 0) = prevWord.data((W - 1), 8 * offset);
+            sendWord.data((W - 1), W - (8 * offset)) = 0;
+            sendWord.keep((W / 8 - 1) - offset, 0) = prevWord.keep((W / 8 - 1), offset);
+            sendWord.keep((W / 8 - 1), (W / 8) - offset) = 0;
+            sendWord.last = 1;
+            // TID fields not used
+            //assignDest(sendWord, currWord);
+
+            output.write(sendWord);
+            fsmState = PKG;
+            sendWord.last = 0;
+            // Fall through, the first word of the next packet produces no output
+            // and is taken in the same cycle
         case PKG:
             if (!input.empty()) {
                 input.read(currWord);
@@ -417,18 +435,6 @@ void rshiftWordByOctet(uint16_t offset, hls::stream<Tin>& input, hls::stream<Tou
                 //}//else offset
             }
             break;
-        case REMAINDER:
-            sendWord.data((W - 1) - (8 * offset), 0) = prevWord.data((W - 1), 8 * offset);
-            sendWord.data((W - 1), W - (8 * offset)) = 0;
-            sendWord.keep((W / 8 - 1) - offset, 0) = prevWord.keep((W / 8 - 1), offset);
-            sendWord.keep((W / 8 - 1), (W / 8) - offset) = 0;
-            sendWord.last = 1;
-            // TID fields not used
-            //assignDest(sendWord, currWord);
-
-            output.write(sendWord);
-            fsmState = PKG;
-            break;
     }
 }
 
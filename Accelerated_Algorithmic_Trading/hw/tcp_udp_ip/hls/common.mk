@@ -35,6 +35,10 @@
 # Default below only currently effective for verification flow
 XPART?=xcu50-fsvh2104-2L-e
 KERNEL_PERIOD?=3.33
+TCP_STACK_MAX_SESSIONS?=32
+TCP_STACK_WINDOW_SCALE_BITS?=2
+# datapath width of the UDP receive chain (ip_handler, ipv4, udp), 64 or 512
+UDP_RX_WIDTH?=64
 
 # Relative directories are defined from the point of view of the subdirectory below.
 IPREPO=../../iprepo
@@ -43,7 +47,9 @@ VENDOR_LIBRARY=com_xilinx_dcg_fintech_hls
 # Fully qualified IP name definition
 FQIPNAME=$(VENDOR_LIBRARY)_$(IPNAME)_$(IPVERSION)
 
-ifdef UDP_ONLY
+ifdef UDP_RX
+HLSBUILD=UDP_RX
+else ifdef UDP_ONLY
 HLSBUILD=UDP_ONLY
 else ifdef TCP_ONLY
 HLSBUILD=TCP_ONLY
@@ -53,7 +59,7 @@ endif
 
 .PHONY: hls
 hls:
-	XPART=$(XPART) KERNEL_PERIOD=$(KERNEL_PERIOD) HLSBUILD=$(HLSBUILD) vitis_hls -f run_hls.tcl
+	XPART=$(XPART) KERNEL_PERIOD=$(KERNEL_PERIOD) HLSBUILD=$(HLSBUILD) TCP_STACK_MAX_SESSIONS=$(TCP_STACK_MAX_SESSIONS) TCP_STACK_WINDOW_SCALE_BITS=$(TCP_STACK_WINDOW_SCALE_BITS) UDP_RX_WIDTH=$(UDP_RX_WIDTH) vitis_hls -f run_hls.tcl
 
 .PHONY: export_ip
 export_ip: hls
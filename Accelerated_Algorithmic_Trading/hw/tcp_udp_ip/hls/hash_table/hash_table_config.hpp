@@ -1,3 +1,7 @@
 #pragma once
 
-const uint32_t MAX_NUMBER_OF_ENTRIES = 32;
+// Sized to the TOE session count, set at build time through TCP_STACK_MAX_SESSIONS
+#ifndef TCP_STACK_MAX_SESSIONS
+#define TCP_STACK_MAX_SESSIONS 32
+#endif
+const uint32_t MAX_NUMBER_OF_ENTRIES = TCP_STACK_MAX_SESSIONS;
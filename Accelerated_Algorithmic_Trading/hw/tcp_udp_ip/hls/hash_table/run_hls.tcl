@@ -32,7 +32,7 @@ open_project hash_table_prj
 
 set_top hash_table
 
-add_files hash_table.cpp -cflags "-std=c++11"
+add_files hash_table.cpp -cflags "-std=c++11 -DTCP_STACK_MAX_SESSIONS=$::env(TCP_STACK_MAX_SESSIONS)"
 
 open_solution "solution1"
 set_part $::env(XPART)
@@ -51,7 +51,7 @@
 void igmp(hls::stream<ap_axiu<64,0,0,0> >& s_axis_data,
           hls::stream<ap_axiu<64,0,0,0> >& m_axis_data,
           bool host_op_toggle,
-          ap_uint<2> host_opcode,
+          ap_uint<3> host_opcode,
           uint32_t host_ipAddr,
           uint32_t srcIpAddr,
           uint8_t host_tableAddr,
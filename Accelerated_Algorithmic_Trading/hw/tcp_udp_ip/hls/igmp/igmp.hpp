@@ -37,8 +37,16 @@
 #include "../axi_utils.hpp"
 #include "ap_axi_sdata.h"
 
-#define MAX_IP_ENTRIES 4
+// Multicast group table depth. The host read port addresses the table in
+// bytes through an 8-bit register, which bounds the table at 64 entries.
+#ifndef MAX_IP_ENTRIES
+#define MAX_IP_ENTRIES 64
+#endif
 #define LAST_IP_ENTRY (MAX_IP_ENTRIES - 1)
+// one timer per joined group plus the general query
+#define MAX_IGMP_TIMERS (MAX_IP_ENTRIES + 1)
+// v3 report header word plus one group record word per table entry
+#define IGMP_MAX_REPORT_WORDS (MAX_IP_ENTRIES + 1)
 
 const uint32_t IP_ALL_ROUTERS_MULTICAST = 0xE0000016; // 224.0.0.22
 const uint32_t IP_ALL_SYSTEMS_MULTICAST = 0xE0000001; // 224.0.0.1
@@ -67,6 +75,18 @@ enum opCodes {
     IP_READ = 3,
 };
 
+// host_opcode bit 2, queue the v3 change record of an add or delete and send
+// it in one report with those of the following operations. The queue is sent
+// on the next operation without the flag (a NOOP sends it alone) or when full.
+#define IP_DEFER_REPORT (1 << 2)
+
+struct igmpChangeRecord {
+    ap_uint<32> groupAddr;
+    ap_uint<2> mode;
+    igmpChangeRecord() {}
+    igmpChangeRecord(ap_uint<32> groupAddr, ap_uint<2> mode) : groupAddr(groupAddr), mode(mode) {}
+};
+
 typedef ap_uint<32> ap_uint32_t;
 typedef ap_uint<16> ap_uint16_t;
 typedef ap_uint<1> ap_uint1_t;
@@ -96,7 +116,7 @@ struct igmpReportMeta {
     ap_uint32_t ip_address;
     ap_uint32_t group_address;
     uint8_t mode;
-    uint8_t nEntries;
+    uint8_t nEntries; // number of group records in the report
     igmpReportMeta() {}
     igmpReportMeta(uint8_t version, bool is_state_record, ap_uint32_t ip_address, ap_uint32_t group_address, 
         uint8_t mode, uint8_t nEntries) : 
@@ -114,7 +134,7 @@ void igmp_report_gen(hls::stream<ap_axiu<64,0,0,0> >& m_axis_data,
                      hls::stream<igmpQuery>& gen_report,
                      hls::stream<bool>& is_v3,
                      bool host_op_toggle,
-                     ap_uint<2> host_opcode,
+                     ap_uint<3> host_opcode,
                      uint32_t host_ipAddr,
                      uint32_t srcIpAddr,
                      uint8_t host_tableAddr,
@@ -138,7 +158,7 @@ void igmp_process_timer(hls::stream<bool>& tick100ms,
 void igmp(hls::stream<ap_axiu<64,0,0,0> >& s_axis_data,
           hls::stream<ap_axiu<64,0,0,0> >& m_axis_data,
           bool host_op_toggle,
-          ap_uint<2> host_opcode,
+          ap_uint<3> host_opcode,
           uint32_t host_ipAddr,
           uint32_t srcIpAddr,
           uint8_t host_tableAddr,
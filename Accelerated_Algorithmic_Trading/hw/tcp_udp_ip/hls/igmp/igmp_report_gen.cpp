@@ -35,7 +35,8 @@
 
 /** @ingroup igmp_report_gen
  *  Multicast table FSM.  Can be triggered on either host operations to modify the record table
- * or a gen_report command from an igmp_timer expiring.
+ * or a gen_report command from an igmp_timer expiring. With igmp_ver 3 the change records of host
+ * operations are queued and sent in one report, see IP_DEFER_REPORT.
  *  @param[out]     ipTupleFifoOut
  *  @param[out]     igmp_v2_report_meta
  *  @param[out]     igmp_v3_report_meta
@@ -54,7 +55,7 @@ void igmp_record_table(hls::stream<igmpQuery>& gen_report,
                  hls::stream<igmpReportMeta>& igmp_v3_report_meta,
                  hls::stream<bool>& is_v3,
                  bool host_op_toggle,
-                 ap_uint<2> host_opcode,
+                 ap_uint<3> host_opcode,
                  uint32_t host_ipAddr,
                  uint8_t host_tableAddr,
                  uint8_t igmp_ver,
@@ -70,19 +71,28 @@ void igmp_record_table(hls::stream<igmpQuery>& gen_report,
         READ_ENTRY,
         CURRENT_STATE_RECORDS,
         GROUP_MATCH,
-        WRITE_META
+        WRITE_META,
+        CHANGE_RECORDS
     };
     static igmpReportFsmStateType igmpReportFsmState = IDLE;
     igmpReportMeta ReportMeta;
+    igmpChangeRecord change;
     static igmpQuery query;
     static bool toggle;
     static bool is_state_record;
     static uint32_t ipTable[MAX_IP_ENTRIES];
+#pragma HLS RESOURCE variable = ipTable core = RAM_2P_BRAM
+    static igmpChangeRecord changeTable[MAX_IP_ENTRIES];
+#pragma HLS RESOURCE variable = changeTable core = RAM_2P_BRAM
+#pragma HLS DATA_PACK variable = changeTable
     static uint8_t nEntries = 0;
     static uint8_t nCurrEntry = 0;
     static uint8_t nRecords = 0;
+    static uint8_t nChanges = 0;
+    static uint8_t nCurrChange = 0;
     static bool fMatch = false;
     static bool fInsert = false;
+    static bool fDefer = false;
     static ap_uint<2> _opcode = IP_READ;
     static uint32_t _hostIp = 0;
     static uint8_t _tableAddr = 0;
@@ -100,7 +110,8 @@ void igmp_record_table(hls::stream<igmpQuery>& gen_report,
                 // Take local copies of the register in case it changes
                 // during the operation
                 _hostIp = host_ipAddr;
-                _opcode = host_opcode;
+                _opcode = host_opcode(1, 0);
+                fDefer = ((host_opcode & IP_DEFER_REPORT) != 0);
                 _tableAddr = host_tableAddr;
                 _igmp_ver = igmp_ver;
 
@@ -108,6 +119,12 @@ void igmp_record_table(hls::stream<igmpQuery>& gen_report,
                 fMatch = false;
                 fInsert = false;
                 switch (_opcode) {
+                    case IP_NOOP:
+                        // Send any change records still queued
+                        if (nChanges != 0) {
+                            igmpReportFsmState = CHANGE_RECORDS;
+                        }
+                        break;
                     case IP_ADD:
                         if (enable) {
                             igmpReportFsmState = ADD_ENTRY;
@@ -151,15 +168,23 @@ void igmp_record_table(hls::stream<igmpQuery>& gen_report,
             }
 
             if (nCurrEntry == LAST_IP_ENTRY) {
+                // Failed to insert an entry - just return to IDLE
+                igmpReportFsmState = IDLE;
                 if (fInsert && !fMatch) {
                     ipTable[candidateEntry] = _hostIp;
                     ipAddr = _hostIp;
                     mode = _opcode;
                     nEntries++;
-                    igmpReportFsmState = WRITE_META;
-                } else {
-                    // Failed to insert an entry - just return to IDLE
-                    igmpReportFsmState = IDLE;
+                    if (_igmp_ver == 3) {
+                        changeTable[nChanges] = igmpChangeRecord(_hostIp, _opcode);
+                        nChanges++;
+                    } else {
+                        igmpReportFsmState = WRITE_META;
+                    }
+                }
+                // A failed insert still sends the queued records when not deferred
+                if ((nChanges != 0) && (!fDefer || (nChanges == MAX_IP_ENTRIES))) {
+                    igmpReportFsmState = CHANGE_RECORDS;
                 }
             }
             nCurrEntry++;
@@ -171,12 +196,19 @@ void igmp_record_table(hls::stream<igmpQuery>& gen_report,
                 fMatch = true;
             }
             if (nCurrEntry == LAST_IP_ENTRY) {
+                igmpReportFsmState = IDLE;
                 if (fMatch) {
                     ipAddr = _hostIp;
                     mode = _opcode;
-                    igmpReportFsmState = WRITE_META;
-                } else {
-                    igmpReportFsmState = IDLE;
+                    if (_igmp_ver == 3) {
+                        changeTable[nChanges] = igmpChangeRecord(_hostIp, _opcode);
+                        nChanges++;
+                    } else {
+                        igmpReportFsmState = WRITE_META;
+                    }
+                }
+                if ((nChanges != 0) && (!fDefer || (nChanges == MAX_IP_ENTRIES))) {
+                    igmpReportFsmState = CHANGE_RECORDS;
                 }
             }
             nCurrEntry++;
@@ -209,13 +241,31 @@ void igmp_record_table(hls::stream<igmpQuery>& gen_report,
             }
             nCurrEntry++;
             break;
+        case CHANGE_RECORDS:
+            // One v3 report carrying every queued change record, one per cycle
+            change = changeTable[nCurrChange];
+            ReportMeta.version = 3;
+            ReportMeta.is_state_record = false;
+            ReportMeta.ip_address = change.groupAddr;
+            ReportMeta.group_address = 0;
+            ReportMeta.mode = change.mode;
+            ReportMeta.nEntries = nChanges;
+            igmp_v3_report_meta.write(ReportMeta);
+            if (nCurrChange == (nChanges - 1)) {
+                nChanges = 0;
+                nCurrChange = 0;
+                igmpReportFsmState = IDLE;
+            } else {
+                nCurrChange++;
+            }
+            break;
         case WRITE_META:
             ReportMeta.version = _igmp_ver;
             ReportMeta.is_state_record = is_state_record;
             ReportMeta.ip_address = ipAddr;
             ReportMeta.group_address = group_address;
             ReportMeta.mode = mode; 
-            ReportMeta.nEntries = nEntries;
+            ReportMeta.nEntries = is_state_record ? nEntries : 1;
             if(_igmp_ver == 2){
                 igmp_v2_report_meta.write(ReportMeta);
             } else if (_igmp_ver == 3){
@@ -317,7 +367,8 @@ void igmp_v2_report(hls::stream<igmpReportMeta>& igmp_v2_report_meta,
 
 /** @ingroup igmp_report_gen
  *  v3 report generation function. 
- *  generates a v3 report based on trigger from igmp_report
+ *  generates a v3 report based on trigger from igmp_report. Each meta carries one group record,
+ *  the first meta of a report emits the header with the number of records it carries.
  *  @param[in]      igmp_v3_report_meta
  *  @param[out]     mcastReportData
  *  @param[out]     ipTupleFifoOut
@@ -329,141 +380,56 @@ void igmp_v3_report(hls::stream<igmpReportMeta>& igmp_v3_report_meta,
 
     enum igmpV3ReportFsmStateType {
         IDLE,
-        FILTER_CHANGE_QUERY,
-        GENERAL_QUERY,
-        FILTER_CHANGE_RECORD,
-        CURRENT_STATE_RECORDS,
-        WRITE_META,
-        GROUP_MATCH,
-        GROUP_QUERY,
-        GROUP_RECORD
+        REPORT_HEADER,
+        GROUP_RECORD,
+        WRITE_META
     };
 
     static igmpV3ReportFsmStateType igmpV3ReportFsmState = IDLE;
     axiWord currWord;
     static ap_uint16_t nLength = 0;
     uint8_t mode = 0;
-    static uint8_t nEntries = 0;
     static uint8_t nRecords = 0;
     static igmpReportMeta report_meta; 
-    static bool is_first_record = true;
-    static uint32_t ipTable[MAX_IP_ENTRIES];
-    ap_uint<32> ipAddr; // TODO: make it static?
+    ap_uint<32> ipAddr;
 
     switch (igmpV3ReportFsmState) {
         case IDLE:
             if (!igmp_v3_report_meta.empty()) {
                 igmp_v3_report_meta.read(report_meta);
                 if(report_meta.version==3){
-                    switch (report_meta.mode) {
-                        case IP_NOOP:
-                            if(report_meta.is_state_record==true){
-                                ipTable[nRecords] = report_meta.ip_address;
-                                if(is_first_record==true){
-                                    igmpV3ReportFsmState = GENERAL_QUERY;
-                                } else{
-                                    igmpV3ReportFsmState = CURRENT_STATE_RECORDS;
-                                }
-                            } else {
-                                igmpV3ReportFsmState = GROUP_QUERY;
-                            }
-                            break;
-                        case IP_ADD:
-                            igmpV3ReportFsmState = FILTER_CHANGE_QUERY;
-                            break;
-                        case IP_DELETE:
-                            igmpV3ReportFsmState = FILTER_CHANGE_QUERY;
-                            break;
+                    if (nRecords == 0) {
+                        igmpV3ReportFsmState = REPORT_HEADER;
+                    } else {
+                        igmpV3ReportFsmState = GROUP_RECORD;
                     }
                 }
             }
             break;
-        case FILTER_CHANGE_QUERY:
+        case REPORT_HEADER:
             currWord.data(7, 0)   = 0x22;
             currWord.data(15, 8)  = 0x00;    // Reserved
             currWord.data(31, 16) = 0x0000; // Checksum, to be filled in later
             currWord.data(47, 32) = 0x0000; // Reserved
             currWord.data(55, 48) = 0x0;
-            currWord.data(63, 56) = 0x1; // 1 Record (filter change)
+            currWord.data(63, 56) = report_meta.nEntries; // Number of Group Records
             currWord.keep = 0xFF;
             currWord.last = 0;
             mcastReportData.write(currWord);
             nLength = 8;
-            igmpV3ReportFsmState = FILTER_CHANGE_RECORD;
+            igmpV3ReportFsmState = GROUP_RECORD;
             break;
-        case FILTER_CHANGE_RECORD:
+        case GROUP_RECORD:
             ipAddr = report_meta.ip_address;
-            mode = 0;
             if (report_meta.mode == IP_ADD) {  // Exclude Nothing
                 mode = 0x04;                   // CHANGE_TO_EXCLUDE
             } else if (report_meta.mode == IP_DELETE) { // Include Nothing
                 mode = 0x03;                            // CHANGE_TO_INCLUDE
-            }
-            currWord.data(7, 0)   = mode;
-            currWord.data(15, 8)  = 0x00;  // Reserved
-            currWord.data(31, 16) = 0x00; // Number of Sources
-            currWord.data(63, 56) = ipAddr(7, 0);
-            currWord.data(55, 48) = ipAddr(15, 8);
-            currWord.data(47, 40) = ipAddr(23, 16);
-            currWord.data(39, 32) = ipAddr(31, 24); // Multicast Address
-            currWord.keep = 0xFF;
-            currWord.last = 1;
-            nLength += 8;
-            mcastReportData.write(currWord);
-            igmpV3ReportFsmState = WRITE_META;
-            break;
-        case GROUP_QUERY:
-            currWord.data(7, 0)   = 0x22;
-            currWord.data(15, 8)  = 0x00;    // Reserved
-            currWord.data(31, 16) = 0x0000; // Checksum, to be filled in later
-            currWord.data(47, 32) = 0x0000; // Reserved
-            currWord.data(55, 48) = 0x0;
-            currWord.data(63, 56) = 1; // Number of Group Records
-            currWord.keep = 0xFF;
-            currWord.last = 0;
-            nLength = 8;
-            igmpV3ReportFsmState = GROUP_RECORD;
-            mcastReportData.write(currWord);
-            nRecords = 0;
-            break;
-        case GROUP_RECORD:
-            currWord.data(7, 0)   = 0x02;   // MODE_IS_EXCLUDE
-            currWord.data(15, 8)  = 0x00;  // Reserved
-            currWord.data(31, 16) = 0x00; // Number of Sources
-            currWord.data(63, 56) = report_meta.group_address(7, 0);
-            currWord.data(55, 48) = report_meta.group_address(15, 8);
-            currWord.data(47, 40) = report_meta.group_address(23, 16);
-            currWord.data(39, 32) = report_meta.group_address(31, 24);
-            currWord.keep = 0xFF;
-            currWord.last = 1;
-            mcastReportData.write(currWord);
-            nLength += 8;
-            igmpV3ReportFsmState = WRITE_META;
-            break;
-        case GENERAL_QUERY:
-            is_first_record=false;
-            nEntries = report_meta.nEntries;
-            currWord.data(7, 0) = 0x22;
-            currWord.data(15, 8) = 0x00;    // Reserved
-            currWord.data(31, 16) = 0x0000; // Checksum, to be filled in later
-            currWord.data(47, 32) = 0x0000; // Reserved
-            currWord.data(55, 48) = 0x0;
-            currWord.data(63, 56) = nEntries; // Number of Group Records
-            currWord.keep = 0xFF;
-            currWord.last = (nEntries == 0);
-            nLength = 8;
-            if (nEntries == 0) { // Should never go into this one tbh
-                igmpV3ReportFsmState = WRITE_META;
             } else {
-                igmpV3ReportFsmState = CURRENT_STATE_RECORDS;
+                mode = 0x02;                            // MODE_IS_EXCLUDE
             }
-            mcastReportData.write(currWord);
-            nRecords = 0;
-            break;
-        case CURRENT_STATE_RECORDS:
-            ipAddr = ipTable[nRecords];
             nRecords++;
-            currWord.data(7, 0)   = 0x02;   // MODE_IS_EXCLUDE
+            currWord.data(7, 0)   = mode;
             currWord.data(15, 8)  = 0x00;  // Reserved
             currWord.data(31, 16) = 0x00; // Number of Sources
             currWord.data(63, 56) = ipAddr(7, 0);
@@ -471,11 +437,11 @@ void igmp_v3_report(hls::stream<igmpReportMeta>& igmp_v3_report_meta,
             currWord.data(47, 40) = ipAddr(23, 16);
             currWord.data(39, 32) = ipAddr(31, 24); // Multicast Address
             currWord.keep = 0xFF;
-            currWord.last = (nRecords == nEntries);
+            currWord.last = (nRecords == report_meta.nEntries);
             mcastReportData.write(currWord);
             nLength += 8;
-            if (nRecords == nEntries) {
-                is_first_record = true;
+            if (nRecords == report_meta.nEntries) {
+                nRecords = 0;
                 igmpV3ReportFsmState = WRITE_META;
             } else {
                 igmpV3ReportFsmState = IDLE;
@@ -691,7 +657,7 @@ void igmp_report_gen(hls::stream<ap_axiu<64,0,0,0> >& m_axis_data,
                      hls::stream<igmpQuery>& gen_report,
                      hls::stream<bool>& is_v3,
                      bool host_op_toggle,
-                     ap_uint<2> host_opcode,
+                     ap_uint<3> host_opcode,
                      uint32_t host_ipAddr,
                      uint32_t srcIpAddr,
                      uint8_t host_tableAddr,
@@ -706,14 +672,15 @@ void igmp_report_gen(hls::stream<ap_axiu<64,0,0,0> >& m_axis_data,
     #pragma HLS STREAM variable = report2subchecksum_v3 depth = 4
     static hls::stream<axiWord> report2subchecksum("igmp_report2subchecksum");
     #pragma HLS STREAM variable = report2subchecksum depth = 4
+    // the checksum is inserted in the first word, hold a full report
     static hls::stream<axiWord> subchecksum2stitcher("igmp_subchecksum2stitcher");
-    #pragma HLS STREAM variable = subchecksum2stitcher depth = 64
+    #pragma HLS STREAM variable = subchecksum2stitcher depth = IGMP_MAX_REPORT_WORDS
     static hls::stream<subSums<4> > igmp_report_gen_subChecksumsFifo("igmp_report_gen_subChecksumsFifo");
     #pragma HLS stream variable = igmp_report_gen_subChecksumsFifo depth = 4
     static hls::stream<ap_uint16_t> igmp_report_gen_ChecksumFifo("igmp_report_genChecksumFifo");
     #pragma HLS stream variable = igmp_report_gen_ChecksumFifo depth = 4
     static hls::stream<axiWord> checksum2ipv4Fifo("igmp_report_gen_checksum2ipv4Fifo");
-    #pragma HLS stream variable = checksum2ipv4Fifo depth = 64
+    #pragma HLS stream variable = checksum2ipv4Fifo depth = IGMP_MAX_REPORT_WORDS
     static hls::stream<twoTuple> twoTupleFIFO_v2("igmpTwoTupleFIFO_v2");
     #pragma HLS stream variable = twoTupleFIFO_v2 depth = 4
     static hls::stream<twoTuple> twoTupleFIFO_v3("igmpTwoTupleFIFO_v3");
@@ -723,9 +690,9 @@ void igmp_report_gen(hls::stream<ap_axiu<64,0,0,0> >& m_axis_data,
     static hls::stream<axiWord> ipHeaderBuffer("igmpIpHeaderFIFO");
     #pragma HLS stream variable = ipHeaderBuffer depth = 8
     static hls::stream<igmpReportMeta> igmp_v2_report_meta("igmpv2report_meta");
-    #pragma HLS stream variable = ipHeaderBuffer depth = 4
+    #pragma HLS stream variable = igmp_v2_report_meta depth = 4
     static hls::stream<igmpReportMeta> igmp_v3_report_meta("igmpv3report_meta");
-    #pragma HLS stream variable = ipHeaderBuffer depth = 4
+    #pragma HLS stream variable = igmp_v3_report_meta depth = 4
 
     igmp_record_table(gen_report,igmp_v2_report_meta, igmp_v3_report_meta, is_v3, host_op_toggle, host_opcode, host_ipAddr, host_tableAddr,
                 igmp_ver, host_readVal, enable);
@@ -43,7 +43,6 @@ void igmp_process_timer(hls::stream<bool>& tick100ms,
                         hls::stream<bool>& is_v3,
                         hls::stream<igmpQuery>& inIgmpQuery,
                         hls::stream<igmpQuery>& outIgmpReport) {
-#define MAX_IGMP_TIMERS 16
 #pragma HLS PIPELINE II = 1
 
     static igmpTimerEntry igmpTimerTable[MAX_IGMP_TIMERS];
@@ -0,0 +1,267 @@
+/************************************************
+ * Copyright (c) 2016, 2020 Xilinx, Inc.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY
+ * WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ ************************************************/
+
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+#include "../igmp.hpp"
+
+/*
+ * IGMPv3 change record batching test. More groups are joined with
+ * IP_DEFER_REPORT than one report can carry, so the queue must be sent when
+ * full and the rest carried into the next report. That report mixes deferred
+ * leaves and joins and is sent by an operation without the flag. A NOOP sends
+ * a queue on its own and does nothing when the queue is empty. Every report is
+ * checked for its record count, the mode and group of each record in order,
+ * the IP length and destination and the IGMP checksum.
+ */
+
+#define TB_NUM_GROUPS (MAX_IP_ENTRIES + 6)
+#define TB_GROUP_BASE (0xEF010001) // 239.1.0.1
+#define TB_SRC_IP (0x0A000001)
+#define TB_CYCLES_PER_OP (4 * MAX_IP_ENTRIES + 64)
+#define TB_IP_HEADER_WORDS (3)
+
+#define TB_CHANGE_TO_INCLUDE (0x03)
+#define TB_CHANGE_TO_EXCLUDE (0x04)
+
+typedef ap_axiu<64, 0, 0, 0> tbWord;
+typedef std::vector<tbWord> tbPacket;
+
+struct tbRecord {
+    uint8_t mode;
+    uint32_t group;
+    tbRecord(uint8_t mode, uint32_t group) : mode(mode), group(group) {}
+};
+
+static hls::stream<tbWord> s_axis_data("s_axis_data");
+static hls::stream<tbWord> m_axis_data("m_axis_data");
+static bool hostToggle = false;
+static std::vector<tbPacket> reports;
+static tbPacket currentPacket;
+
+static uint32_t groupAddress(int group) {
+    return TB_GROUP_BASE + group;
+}
+
+static void run(int numCycles, ap_uint<3> opcode, uint32_t ipAddr) {
+    uint32_t readVal;
+    uint32_t invalidCsum;
+    uint32_t igmpQuery;
+    uint32_t invalidQuery;
+
+    for (int i = 0; i < numCycles; i++) {
+        igmp(s_axis_data, m_axis_data, hostToggle, opcode, ipAddr, TB_SRC_IP, 0, readVal, true, invalidCsum, igmpQuery,
+             invalidQuery, 3);
+
+        while (!m_axis_data.empty()) {
+            tbWord word = m_axis_data.read();
+            currentPacket.push_back(word);
+            if (word.last) {
+                reports.push_back(currentPacket);
+                currentPacket.clear();
+            }
+        }
+    }
+}
+
+static void hostOp(ap_uint<3> opcode, uint32_t ipAddr) {
+    hostToggle = !hostToggle;
+    run(TB_CYCLES_PER_OP, opcode, ipAddr);
+}
+
+static uint8_t wordByte(const tbWord& word, int i) {
+    return word.data(8 * i + 7, 8 * i);
+}
+
+// compares one report against the records it should carry, in order
+static int checkReport(const char* name, const tbPacket& packet, const std::vector<tbRecord>& expected) {
+    int numErrors = 0;
+    uint32_t ipLength;
+    uint32_t dstIp;
+    uint32_t checksum = 0;
+    size_t numRecords;
+    size_t i;
+
+    numRecords = packet.size() - TB_IP_HEADER_WORDS - 1;
+
+    if ((packet.size() < (TB_IP_HEADER_WORDS + 1)) || (numRecords != expected.size())) {
+        std::cout << "ERROR: " << name << " has " << std::dec << (packet.size() - TB_IP_HEADER_WORDS - 1)
+                  << " record words, expected " << expected.size() << std::endl;
+        return 1;
+    }
+
+    ipLength = (wordByte(packet[0], 2) << 8) | wordByte(packet[0], 3);
+    dstIp = (wordByte(packet[2], 0) << 24) | (wordByte(packet[2], 1) << 16) | (wordByte(packet[2], 2) << 8) |
+            wordByte(packet[2], 3);
+
+    if ((ipLength != (8 * packet.size())) || (dstIp != IP_ALL_ROUTERS_MULTICAST)) {
+        std::cout << "ERROR: " << name << " IP length " << std::dec << ipLength << " destination " << std::hex << dstIp
+                  << std::endl;
+        numErrors++;
+    }
+
+    // v3 report header, the record count is in the last byte
+    if ((wordByte(packet[3], 0) != 0x22) || (wordByte(packet[3], 7) != expected.size())) {
+        std::cout << "ERROR: " << name << " header type " << std::hex << (int)wordByte(packet[3], 0) << " count "
+                  << std::dec << (int)wordByte(packet[3], 7) << std::endl;
+        numErrors++;
+    }
+
+    for (i = 0; i < numRecords; i++) {
+        const tbWord& word = packet[TB_IP_HEADER_WORDS + 1 + i];
+        uint32_t group = (wordByte(word, 4) << 24) | (wordByte(word, 5) << 16) | (wordByte(word, 6) << 8) |
+                         wordByte(word, 7);
+
+        if ((wordByte(word, 0) != expected[i].mode) || (group != expected[i].group)) {
+            std::cout << "ERROR: " << name << " record " << std::dec << i << " mode " << (int)wordByte(word, 0)
+                      << " group " << std::hex << group << ", expected mode " << std::dec << (int)expected[i].mode
+                      << " group " << std::hex << expected[i].group << std::endl;
+            numErrors++;
+        }
+    }
+
+    // IGMP checksum covers the header and records, last flag only on the final word
+    for (i = TB_IP_HEADER_WORDS; i < packet.size(); i++) {
+        for (int j = 0; j < 8; j += 2) {
+            checksum += (wordByte(packet[i], j) << 8) | wordByte(packet[i], j + 1);
+        }
+        if (packet[i].last != (i == (packet.size() - 1))) {
+            std::cout << "ERROR: " << name << " last flag on word " << std::dec << i << std::endl;
+            numErrors++;
+        }
+    }
+    while (checksum >> 16) {
+        checksum = (checksum & 0xFFFF) + (checksum >> 16);
+    }
+    if (checksum != 0xFFFF) {
+        std::cout << "ERROR: " << name << " checksum" << std::endl;
+        numErrors++;
+    }
+
+    std::cout << name << ": " << std::dec << numRecords << " records" << std::endl;
+
+    return numErrors;
+}
+
+int main() {
+    std::vector<tbRecord> expected;
+    size_t numReports;
+    int numErrors = 0;
+    int i;
+
+    std::cout << "IGMP Report Batching Test" << std::endl;
+    std::cout << "-------------------------" << std::endl;
+
+    // settle, nothing is sent without a host operation or query
+    run(TB_CYCLES_PER_OP, IP_NOOP, 0);
+
+    // a full table of deferred joins, held until the last one fills the queue
+    for (i = 0; i < MAX_IP_ENTRIES; i++) {
+        hostOp(IP_ADD | IP_DEFER_REPORT, groupAddress(i));
+        if ((i < LAST_IP_ENTRY) && !reports.empty()) {
+            std::cout << "ERROR: report sent after " << std::dec << (i + 1) << " deferred joins" << std::endl;
+            numErrors++;
+            reports.clear();
+        }
+    }
+
+    for (i = 0; i < MAX_IP_ENTRIES; i++) {
+        expected.push_back(tbRecord(TB_CHANGE_TO_EXCLUDE, groupAddress(i)));
+    }
+
+    if (reports.size() != 1) {
+        std::cout << "ERROR: " << std::dec << reports.size() << " reports for a full queue" << std::endl;
+        numErrors++;
+    } else {
+        numErrors += checkReport("REPORT 1", reports[0], expected);
+    }
+    reports.clear();
+    expected.clear();
+
+    // make room for the remaining groups and join them, the leave of one more
+    // group without the flag sends everything queued
+    for (i = 0; i < (TB_NUM_GROUPS - MAX_IP_ENTRIES); i++) {
+        hostOp(IP_DELETE | IP_DEFER_REPORT, groupAddress(i));
+        expected.push_back(tbRecord(TB_CHANGE_TO_INCLUDE, groupAddress(i)));
+    }
+    for (i = MAX_IP_ENTRIES; i < TB_NUM_GROUPS; i++) {
+        hostOp(IP_ADD | IP_DEFER_REPORT, groupAddress(i));
+        expected.push_back(tbRecord(TB_CHANGE_TO_EXCLUDE, groupAddress(i)));
+    }
+    numReports = reports.size();
+
+    hostOp(IP_DELETE, groupAddress(TB_NUM_GROUPS - MAX_IP_ENTRIES));
+    expected.push_back(tbRecord(TB_CHANGE_TO_INCLUDE, groupAddress(TB_NUM_GROUPS - MAX_IP_ENTRIES)));
+
+    if ((numReports != 0) || (reports.size() != 1)) {
+        std::cout << "ERROR: " << std::dec << numReports << " reports before and " << reports.size()
+                  << " after the flush" << std::endl;
+        numErrors++;
+    } else {
+        numErrors += checkReport("REPORT 2", reports[0], expected);
+    }
+    reports.clear();
+    expected.clear();
+
+    // a NOOP with nothing queued sends nothing, with a queued record it sends it alone
+    hostOp(IP_NOOP, 0);
+    numReports = reports.size();
+
+    hostOp(IP_ADD | IP_DEFER_REPORT, groupAddress(0));
+    hostOp(IP_NOOP, 0);
+    expected.push_back(tbRecord(TB_CHANGE_TO_EXCLUDE, groupAddress(0)));
+
+    if ((numReports != 0) || (reports.size() != 1)) {
+        std::cout << "ERROR: " << std::dec << numReports << " reports for an empty NOOP and " << reports.size()
+                  << " for a queued one" << std::endl;
+        numErrors++;
+    } else {
+        numErrors += checkReport("REPORT 3", reports[0], expected);
+    }
+
+    if (!currentPacket.empty()) {
+        std::cout << "ERROR: partial report left over" << std::endl;
+        numErrors++;
+    }
+
+    if (numErrors != 0) {
+        std::cout << "FAILED!" << std::endl;
+        return 1;
+    }
+
+    std::cout << "Done!" << std::endl;
+
+    return 0;
+}
@@ -136,26 +136,54 @@ bool isHandledProtocol(uint8_t protocol) {
  *
  *  Detects the MAC protocol in the header of the packet, ARP and IP packets
  *  are forwarded accordingly, packets of other protocols are discarded.
+ *  When the Ethernet header fits in a single word the Ethertype is extracted
+ *  from the first word and every word is forwarded as it arrives, otherwise
+ *  the first word is held back until the Ethertype is known.
  *
  *  @param[in]		dataIn
  *  @param[out]		ARPdataOut
  *  @param[out]		IPdataOut
  */
-void detect_eth_protocol(hls::stream<ap_axiu<64,0,0,0> >& dataIn,
+template <int W>
+void detect_eth_protocol(hls::stream<ap_axiu<W,0,0,0> >& dataIn,
                          hls::stream<ap_uint<16> >& etherTypeFifo,
-                         hls::stream<axiWord>& dataOut) {
+                         hls::stream<net_axis<W> >& dataOut) {
 #pragma HLS PIPELINE II = 1
 #pragma HLS INLINE off
     enum stateType { FIRST, MIDDLE, LAST };
     static stateType state = FIRST;
-    static ethHeader<AXI_WIDTH> header;
-    static axiWord prevWord;
+    static ethHeader<W> header;
+    static net_axis<W> prevWord;
     static bool metaWritten = false;
 
+    if (W >= ETH_HEADER_SIZE) {
+        if (!dataIn.empty()) {
+            ap_axiu<W,0,0,0> word = dataIn.read();
+            if (!metaWritten) {
+                etherTypeFifo.write(reverse((ap_uint<16>)word.data(111, 96)));
+                metaWritten = true;
+            }
+            dataOut.write(net_axis<W>(word.data, word.keep, word.last));
+            if (word.last) {
+                metaWritten = false;
+            }
+        }
+        return;
+    }
+
     switch (state) {
+        case LAST:
+            if (!metaWritten) {
+                etherTypeFifo.write(header.getEthertype());
+            }
+            dataOut.write(prevWord);
+            header.clear();
+            metaWritten = false;
+            state = FIRST;
+            // Fall through, the first word of the next frame is only stored
         case FIRST:
             if (!dataIn.empty()) {
-                ap_axiu<64,0,0,0> word = dataIn.read();
+                ap_axiu<W,0,0,0> word = dataIn.read();
                 header.parseWord(word.data);
                 prevWord.data = word.data;
                 prevWord.keep = word.keep;
@@ -169,16 +197,14 @@ void detect_eth_protocol(hls::stream<ap_axiu<64,0,0,0> >& dataIn,
             break;
         case MIDDLE:
             if (!dataIn.empty()) {
-                ap_axiu<64,0,0,0> word = dataIn.read();
+                ap_axiu<W,0,0,0> word = dataIn.read();
                 header.parseWord(word.data);
 
                 if (!metaWritten) {
                     etherTypeFifo.write(header.getEthertype());
                     metaWritten = true;
-#if AXI_WIDTH < 128
-                    if (header.getEthertype() == ARP)
-#endif
-                    {
+                    // the first word only holds MAC addresses, it is dropped for IP
+                    if (header.getEthertype() == ARP) {
                         dataOut.write(prevWord);
                     }
                 } else {
@@ -192,34 +218,26 @@ void detect_eth_protocol(hls::stream<ap_axiu<64,0,0,0> >& dataIn,
                 }
             }
             break;
-        case LAST:
-            if (!metaWritten) {
-                etherTypeFifo.write(header.getEthertype());
-            }
-            dataOut.write(prevWord);
-            header.clear();
-            metaWritten = false;
-            state = FIRST;
-            break;
     } // switch
 }
 
+template <int W>
 void route_by_eth_protocol(hls::stream<ap_uint<16> >& etherTypeFifoIn,
-                           hls::stream<axiWord>& dataIn,
-                           hls::stream<ap_axiu<64,0,0,0> >& ARPdataOut,
-                           hls::stream<axiWord>& IPdataOut) {
+                           hls::stream<net_axis<W> >& dataIn,
+                           hls::stream<ap_axiu<W,0,0,0> >& ARPdataOut,
+                           hls::stream<net_axis<W> >& IPdataOut) {
 #pragma HLS PIPELINE II = 1
 #pragma HLS INLINE off
 
     static ap_uint<1> rep_fsmState = 0;
     static ap_uint<16> rep_etherType;
-    ap_axiu<64,0,0,0> outArp;
+    ap_axiu<W,0,0,0> outArp;
 
     switch (rep_fsmState) {
         case 0:
             if (!etherTypeFifoIn.empty() && !dataIn.empty()) {
                 rep_etherType = etherTypeFifoIn.read();
-                axiWord word = dataIn.read();
+                net_axis<W> word = dataIn.read();
                 if (rep_etherType == ARP) {
                     outArp.data = word.data;
                     outArp.keep = word.keep;
@@ -235,7 +253,7 @@ void route_by_eth_protocol(hls::stream<ap_uint<16> >& etherTypeFifoIn,
             break;
         case 1:
             if (!dataIn.empty()) {
-                axiWord word = dataIn.read();
+                net_axis<W> word = dataIn.read();
                 if (rep_etherType == ARP) {
                     outArp.data = word.data;
                     outArp.keep = word.keep;
@@ -256,108 +274,91 @@ void route_by_eth_protocol(hls::stream<ap_uint<16> >& etherTypeFifoIn,
 /** @ingroup ip_handler
  *
  *  Checks IP checksum and removes Ethernet layer 2 frame encapsulation.
+ *  Every 16-bit lane of a word that falls inside the IP header is summed,
+ *  lane i into partial sum i % 4, so a word wide enough to hold the whole
+ *  header is checked in a single beat.
  *
  *  @param[in]      dataIn              incoming data stream
  *  @param[in]      myIpAddress         our IP address which is set externally
  *  @param[out]     dataOut             outgoing data stream
  *  @param[out]     iph_subSumsFifoIn
  */
-void check_ip_checksum(hls::stream<axiWord>& dataIn,
+template <int W>
+void check_ip_checksum(hls::stream<net_axis<W> >& dataIn,
                        ap_uint<32> myIpAddress,
-                       hls::stream<axiWord>& dataOut,
-                       hls::stream<subSums>& iph_subSumsFifoIn) {
+                       hls::stream<net_axis<W> >& dataOut,
+                       hls::stream<ipHandlerSubSums>& iph_subSumsFifoIn) {
 #pragma HLS PIPELINE II = 1
 #pragma HLS INLINE off
 
+    const int BYTES = W / 8;
+    // header bytes 16 to 19 hold the destination address
+    const int DST_WORD = 16 / BYTES;
+    const int DST_OFFSET = (16 % BYTES) * 8;
+
     static ap_uint<17> cics_ip_sums[4] = {0, 0, 0, 0};
-    static ap_uint<8> cics_ipHeaderLen = 0;
-    static ap_uint<3> cics_wordCount = 0;
+    static ap_uint<6> cics_ipHeaderLen = 0;
+    static ap_uint<4> cics_wordCount = 0;
     static ap_uint<32> cics_dstIpAddress = 0;
     static ap_uint<4> cics_ipVersion = 0;
     static bool cics_csumSent = false;
-    static bool cics_csumSend = false;
-    static subSums subSums_i;
 
     ap_uint<16> temp;
 
     if (!dataIn.empty()) {
-        axiWord currWord = dataIn.read();
+        net_axis<W> currWord = dataIn.read();
         dataOut.write(currWord);
-        switch (cics_wordCount) {
-            case 0:
-                cics_ipHeaderLen = currWord.data(3, 0);
-                cics_ipVersion = currWord.data(7, 4);
-                // Fall through
-            case 1:
-                for (int i = 0; i < 4; i++) {
-#pragma HLS unroll
-                    temp(7, 0) = currWord.data.range(i * 16 + 15, i * 16 + 8);
-                    temp(15, 8) = currWord.data.range(i * 16 + 7, i * 16);
-                    cics_ip_sums[i] += temp;
-                    cics_ip_sums[i] = (cics_ip_sums[i] + (cics_ip_sums[i] >> 16)) & 0xFFFF;
-                }
-                cics_ipHeaderLen -= 2;
-                cics_wordCount++;
-                break;
-            default:
-                if (cics_wordCount == 2) {
-                    cics_wordCount++;
-                    cics_dstIpAddress = currWord.data(31, 0);
-                }
-                switch (cics_ipHeaderLen) {
-                    case 0:
-                        // length 0 means we are just handling payload
-                        break;
-                    case 1:
-                        // Sum up part 0-1
-                        for (int i = 0; i < 2; i++) {
+
+        ap_uint<6> ipHeaderLen = cics_ipHeaderLen;
+        ap_uint<4> ipVersion = cics_ipVersion;
+        ap_uint<32> dstIpAddress = cics_dstIpAddress;
+        if (cics_wordCount == 0) {
+            // IHL counts 32-bit words
+            ipHeaderLen = ((ap_uint<6>)currWord.data(3, 0)) << 2;
+            ipVersion = currWord.data(7, 4);
+        }
+        if (cics_wordCount == DST_WORD) {
+            dstIpAddress = currWord.data(DST_OFFSET + 31, DST_OFFSET);
+        }
+
+        for (int i = 0; i < 4; i++) {
 #pragma HLS unroll
-                            temp(7, 0) = currWord.data.range(i * 16 + 15, i * 16 + 8);
-                            temp(15, 8) = currWord.data.range(i * 16 + 7, i * 16);
-                            cics_ip_sums[i] += temp;
-                            cics_ip_sums[i] = (cics_ip_sums[i] + (cics_ip_sums[i] >> 16)) & 0xFFFF;
-                        }
-                        cics_ipHeaderLen = 0;
-                        subSums_i =
-                            subSums(cics_ip_sums, isMatch(myIpAddress, cics_dstIpAddress), hdr_valid(cics_ipVersion));
-                        cics_csumSend = true;
-                        break;
-                    default:
-                        // Sum up everything
-                        for (int i = 0; i < 4; i++) {
+            ap_uint<20> sum = cics_ip_sums[i];
+            for (int j = i; j < (W / 16); j += 4) {
 #pragma HLS unroll
-                            if (currWord.keep(i * 2 + 1, i * 2) == 3) {
-                                temp(7, 0) = currWord.data.range(i * 16 + 15, i * 16 + 8);
-                                temp(15, 8) = currWord.data.range(i * 16 + 7, i * 16);
-                                cics_ip_sums[i] += temp;
-                                cics_ip_sums[i] = (cics_ip_sums[i] + (cics_ip_sums[i] >> 16)) & 0xFFFF;
-                            }
-                        }
-                        if (cics_ipHeaderLen == 2) {
-                            subSums_i = subSums(cics_ip_sums, isMatch(myIpAddress, cics_dstIpAddress),
-                                                hdr_valid(cics_ipVersion));
-                            cics_csumSend = true;
-                        }
-                        cics_ipHeaderLen -= 2;
-                        break;
+                ap_uint<16> offset = cics_wordCount * BYTES + j * 2;
+                if ((offset < ipHeaderLen) && (currWord.keep(j * 2 + 1, j * 2) == 3)) {
+                    temp(7, 0) = currWord.data.range(j * 16 + 15, j * 16 + 8);
+                    temp(15, 8) = currWord.data.range(j * 16 + 7, j * 16);
+                    sum += temp;
                 }
-                break;
-        } // switch WORD_N
+            }
+            sum = sum(15, 0) + sum(19, 16);
+            sum = sum(15, 0) + sum(19, 16);
+            cics_ip_sums[i] = sum;
+        }
 
         if (!cics_csumSent) {
-            if (cics_csumSend) {
-                iph_subSumsFifoIn.write(subSums_i);
+            if ((cics_wordCount * BYTES + BYTES) >= ipHeaderLen) {
+                iph_subSumsFifoIn.write(
+                    ipHandlerSubSums(cics_ip_sums, isMatch(myIpAddress, dstIpAddress), hdr_valid(ipVersion)));
                 cics_csumSent = true;
             } else if (currWord.last) {
                 // If this condition is true, then we've had a malformed packet due to incorrect IHL.
                 // Sent the csums anyway and mark isMatch as false, hdrError true to ensure the packet has a 'checksum'
                 // to be processed.
-                iph_subSumsFifoIn.write(subSums(cics_ip_sums, false, true));
+                iph_subSumsFifoIn.write(ipHandlerSubSums(cics_ip_sums, false, true));
             }
         }
 
+        cics_ipHeaderLen = ipHeaderLen;
+        cics_ipVersion = ipVersion;
+        cics_dstIpAddress = dstIpAddress;
+        if (cics_wordCount != 15) {
+            cics_wordCount++;
+        }
+
         if (currWord.last) {
-            cics_csumSend = false;
             cics_csumSent = false;
             cics_wordCount = 0;
             for (int i = 0; i < 4; i++) {
@@ -377,12 +378,12 @@ void check_ip_checksum(hls::stream<axiWord>& dataIn,
  * @param[out] iph_validFifoOut   Signal valid checksums & metadata match out
  *
  */
-void iph_check_ip_checksum(hls::stream<subSums>& iph_subSumsFifoOut, hls::stream<packet_valid>& iph_validFifoOut) {
+void iph_check_ip_checksum(hls::stream<ipHandlerSubSums>& iph_subSumsFifoOut, hls::stream<packet_valid>& iph_validFifoOut) {
 #pragma HLS PIPELINE II = 1
 #pragma HlS INLINE off
 
     if (!iph_subSumsFifoOut.empty()) {
-        subSums icic_ip_sums = iph_subSumsFifoOut.read();
+        ipHandlerSubSums icic_ip_sums = iph_subSumsFifoOut.read();
         icic_ip_sums.sum0 += icic_ip_sums.sum2;
         icic_ip_sums.sum1 += icic_ip_sums.sum3;
         icic_ip_sums.sum0 = (icic_ip_sums.sum0 + (icic_ip_sums.sum0 >> 16)) & 0xFFFF;
@@ -411,9 +412,10 @@ void iph_check_ip_checksum(hls::stream<subSums>& iph_subSumsFifoOut, hls::stream
  *  @param[out]		stats_ipInAddrErrors number of packets discarded cause of IP address not valid
  *  @param[out]		stats_ipInReceives total number of input datagrams including those received in error.
  */
-void ip_invalid_dropper(hls::stream<axiWord>& dataIn,
+template <int W>
+void ip_invalid_dropper(hls::stream<net_axis<W> >& dataIn,
                         hls::stream<packet_valid>& ipValidFifoIn,
-                        hls::stream<axiWord>& dataOut,
+                        hls::stream<net_axis<W> >& dataOut,
                         uint32_t& stats_ipInHdrErrors,
                         uint32_t& stats_ipInAddrErrors,
                         uint32_t& stats_ipInReceives) {
@@ -426,12 +428,13 @@ void ip_invalid_dropper(hls::stream<axiWord>& dataIn,
     static uint32_t cnt_ipInAddrErrors = 0;
     static uint32_t cnt_ipInReceives = 0;
 
-    axiWord currWord;
+    net_axis<W> currWord;
     packet_valid valid;
 
     switch (iid_state) {
         case GET_VALID: // Drop1
-            if (!ipValidFifoIn.empty()) {
+            // the first word is taken with its valid flag, no idle cycle between packets
+            if (!ipValidFifoIn.empty() && !dataIn.empty()) {
                 ipValidFifoIn.read(valid);
                 cnt_ipInReceives++;
                 if (!valid.hdrValid) {
@@ -441,11 +444,16 @@ void ip_invalid_dropper(hls::stream<axiWord>& dataIn,
                         cnt_ipInAddrErrors++;
                     }
                 }
+                dataIn.read(currWord);
                 if (valid.hdrValid && valid.ipMatch) {
+                    dataOut.write(currWord);
                     iid_state = FWD;
                 } else {
                     iid_state = DROP;
                 }
+                if (currWord.last) {
+                    iid_state = GET_VALID;
+                }
             }
             break;
         case FWD:
@@ -474,44 +482,49 @@ void ip_invalid_dropper(hls::stream<axiWord>& dataIn,
 /**
  * @ingroup ip_handler
  *
- * Trim an IP packet to its declared length
+ * Trim an IP packet to its declared length, this also strips the Ethernet
+ * padding of short frames which may share the first word with the header.
  *
  * @param [in]  dataIn   input packet stream
  * @param [out] dataOut  output packet stream
  */
-void cut_length(hls::stream<axiWord>& dataIn, hls::stream<axiWord>& dataOut) {
+template <int W>
+void cut_length(hls::stream<net_axis<W> >& dataIn, hls::stream<net_axis<W> >& dataOut) {
 #pragma HLS PIPELINE II = 1
 #pragma HLS INLINE off
 
+    const int BYTES = W / 8;
+
     enum cl_stateType { PKG, DROP };
     static cl_stateType cl_state = PKG;
     static ap_uint<16> cl_wordCount = 0;
     static ap_uint<16> cl_totalLength = 0;
-    // static bool cl_drop = false;
 
-    axiWord currWord;
-    ap_uint<4> leftLength = 0;
+    net_axis<W> currWord;
+    ap_uint<16> totalLength;
+    ap_uint<8> leftLength = 0;
 
     switch (cl_state) {
         case PKG:
             if (!dataIn.empty()) {
                 dataIn.read(currWord);
-                switch (cl_wordCount) {
-                    case 0:
-                        cl_totalLength(7, 0) = currWord.data(31, 24);
-                        cl_totalLength(15, 8) = currWord.data(23, 16);
-                        break;
-                    default:
-                        if (((cl_wordCount + 1) * 8) >= cl_totalLength) // last real world
-                        {
-                            if (currWord.last == 0) {
-                                cl_state = DROP;
-                            }
-                            currWord.last = 1;
-                            leftLength = cl_totalLength - (cl_wordCount * 8);
-                            currWord.keep = lenToKeep(leftLength);
-                        }
-                        break;
+                totalLength = cl_totalLength;
+                if (cl_wordCount == 0) {
+                    totalLength(7, 0) = currWord.data(31, 24);
+                    totalLength(15, 8) = currWord.data(23, 16);
+                    cl_totalLength = totalLength;
+                }
+                if (((cl_wordCount + 1) * BYTES) >= totalLength) // last real word
+                {
+                    if (currWord.last == 0) {
+                        cl_state = DROP;
+                    }
+                    currWord.last = 1;
+                    leftLength = totalLength - (cl_wordCount * BYTES);
+                    for (int i = 0; i < BYTES; i++) {
+#pragma HLS unroll
+                        currWord.keep[i] = (i < leftLength);
+                    }
                 }
                 dataOut.write(currWord);
                 cl_wordCount++;
@@ -535,7 +548,9 @@ void cut_length(hls::stream<axiWord>& dataIn, hls::stream<axiWord>& dataOut) {
  *
  *  Detects the IP protocol in the packet. ICMP, IGMP, UDP and TCP packets are forwarded,
  *  packets of other IP protocols are discarded. ip_handler_cfg determines if UDP / TCP
- *  packets are handled and forwarded.
+ *  packets are handled and forwarded. When the protocol field is in the first word
+ *  every word is routed as it arrives, otherwise the first word is held back until
+ *  the protocol is known.
  *
  *  @param[in]		dataIn       incoming data stream
  *  @param[out]		ICMPdataOut  outgoing ICMP (Ping) data stream
@@ -544,13 +559,16 @@ void cut_length(hls::stream<axiWord>& dataIn, hls::stream<axiWord>& dataOut) {
  *  @param[out]     stats_ipInDelivers stats - ipInDelivers
  *  @param[out]     stats_ipInUnknownProtos stats - Unknown IP Protocol
  */
-template <ip_handler_cfg cfg>
-void detect_ipv4_protocol(hls::stream<axiWord>& dataIn,
-                          hls::stream<ap_axiu<64,0,0,0> >& ICMPdataOut,
-                          hls::stream<ap_axiu<64,0,0,0> >& IGMPdataOut,
+template <ip_handler_cfg cfg, int W>
+void detect_ipv4_protocol(hls::stream<net_axis<W> >& dataIn,
+                          hls::stream<ap_axiu<W,0,0,0> >& ICMPdataOut,
+                          hls::stream<ap_axiu<W,0,0,0> >& IGMPdataOut,
 #ifndef UDP_ONLY                          
-                          hls::stream<ap_axiu<64,0,0,0> >& TCPdataOut,
+                          hls::stream<ap_axiu<W,0,0,0> >& TCPdataOut,
 #endif                          
+#ifdef UDP_RX
+                          hls::stream<ap_axiu<W,0,0,0> >& UDPdataOut,
+#endif
                           uint32_t& stats_ipInDelivers,
                           uint32_t& stats_ipInUnknownProtos)
 {
@@ -561,76 +579,97 @@ void detect_ipv4_protocol(hls::stream<axiWord>& dataIn,
     static dip_stateType dip_state = PKG;
     static ap_uint<8> dip_ipProtocol;
     static ap_uint<2> dip_wordCount = 0;
-    static ap_axiu<64,0,0,0> dip_prevWord;
+    static ap_axiu<W,0,0,0> dip_prevWord;
     static uint32_t cnt_ipInDelivers = 0;
     static uint32_t cnt_ipInUnknownProtos = 0;
 
-    axiWord currWord;
-
-    switch (dip_state) {
-        case PKG:
-            if (!dataIn.empty()) {
-                dataIn.read(currWord);
-                switch (dip_wordCount) {
-                    case 0:
-                        dip_wordCount++;
-                        break;
-                    default:
-                        if (dip_wordCount == 1) {
-                            dip_ipProtocol = currWord.data(15, 8);
-                            if (isHandledProtocol<cfg>(dip_ipProtocol)) {
-                                cnt_ipInDelivers++;
-                            } else {
-                                cnt_ipInUnknownProtos++;
-                            }
+    net_axis<W> currWord;
+    ap_axiu<W,0,0,0> sendWord;
+    bool send = false;
+
+    if ((W / 8) > 9) {
+        if (!dataIn.empty()) {
+            dataIn.read(currWord);
+            if (dip_wordCount == 0) {
+                dip_ipProtocol = currWord.data(79, 72);
+                if (isHandledProtocol<cfg>(dip_ipProtocol)) {
+                    cnt_ipInDelivers++;
+                } else {
+                    cnt_ipInUnknownProtos++;
+                }
+                dip_wordCount = 1;
+            }
+            sendWord.data = currWord.data;
+            sendWord.keep = currWord.keep;
+            sendWord.last = currWord.last;
+            send = true;
+            if (currWord.last) {
+                dip_wordCount = 0;
+            }
+        }
+    } else {
+        switch (dip_state) {
+            case LEFTOVER:
+                sendWord = dip_prevWord;
+                send = true;
+                dip_state = PKG;
+                // Fall through, the first word of the next packet is only stored
+            case PKG:
+                if (!dataIn.empty()) {
+                    dataIn.read(currWord);
+                    switch (dip_wordCount) {
+                        case 0:
                             dip_wordCount++;
-                        }
-                        // There is no default, if package does not match any case it is automatically dropped
-                        switch (dip_ipProtocol) {
-                            case ICMP:
-                                ICMPdataOut.write(dip_prevWord);
-                                break;
-                            case IGMP:
-                                IGMPdataOut.write(dip_prevWord);
-                                break;
-                            case TCP:                            
+                            break;
+                        default:
+                            if (dip_wordCount == 1) {
+                                dip_ipProtocol = currWord.data(15, 8);
                                 if (isHandledProtocol<cfg>(dip_ipProtocol)) {
-#ifndef UDP_ONLY                                    
-                                    TCPdataOut.write(dip_prevWord);
-#endif                                    
+                                    cnt_ipInDelivers++;
+                                } else {
+                                    cnt_ipInUnknownProtos++;
                                 }
-                                break;
-                        }
-                        break;
+                                dip_wordCount++;
+                            }
+                            sendWord = dip_prevWord;
+                            send = true;
+                            break;
+                    }
+                    dip_prevWord.data = currWord.data;
+                    dip_prevWord.keep = currWord.keep;
+                    dip_prevWord.last = currWord.last;
+                    if (currWord.last) {
+                        dip_wordCount = 0;
+                        dip_state = LEFTOVER;
+                    }
                 }
-                dip_prevWord.data = currWord.data;
-                dip_prevWord.keep = currWord.keep;
-                dip_prevWord.last = currWord.last;
-                if (currWord.last) {
-                    dip_wordCount = 0;
-                    dip_state = LEFTOVER;
+                break;
+        } // switch
+    }
+
+    // There is no default, if package does not match any case it is automatically dropped
+    if (send) {
+        switch (dip_ipProtocol) {
+            case ICMP:
+                ICMPdataOut.write(sendWord);
+                break;
+            case IGMP:
+                IGMPdataOut.write(sendWord);
+                break;
+            case TCP:
+                if (isHandledProtocol<cfg>(dip_ipProtocol)) {
+#ifndef UDP_ONLY
+                    TCPdataOut.write(sendWord);
+#endif
                 }
-            }
-            break;
-        case LEFTOVER:
-            switch (dip_ipProtocol) {
-                case ICMP:
-                    ICMPdataOut.write(dip_prevWord);
-                    break;
-                case IGMP:
-                    IGMPdataOut.write(dip_prevWord);
-                    break;
-                case TCP:
-                    if (isHandledProtocol<cfg>(dip_ipProtocol)) {
-#ifndef UDP_ONLY                                                        
-                        TCPdataOut.write(dip_prevWord);
-#endif                        
-                    }
-                    break;
-            }
-            dip_state = PKG;
-            break;
-    } // switch
+                break;
+            case UDP:
+#ifdef UDP_RX
+                UDPdataOut.write(sendWord);
+#endif
+                break;
+        }
+    }
     stats_ipInDelivers = cnt_ipInDelivers;
     stats_ipInUnknownProtos = cnt_ipInUnknownProtos;
 }
@@ -651,14 +690,17 @@ void detect_ipv4_protocol(hls::stream<axiWord>& dataIn,
  *  @param[out]		m_axis_TCP     outgoing TCP data stream
  *  @param[out]		stats          Statistics
  */
-template <ip_handler_cfg cfg>
-void ip_handler_body(hls::stream<ap_axiu<64,0,0,0> >& s_axis_raw,
-                     hls::stream<ap_axiu<64,0,0,0> >& m_axis_ARP,
-                     hls::stream<ap_axiu<64,0,0,0> >& m_axis_ICMP,
-                     hls::stream<ap_axiu<64,0,0,0> >& m_axis_IGMP,                
+template <ip_handler_cfg cfg, int W>
+void ip_handler_body(hls::stream<ap_axiu<W,0,0,0> >& s_axis_raw,
+                     hls::stream<ap_axiu<W,0,0,0> >& m_axis_ARP,
+                     hls::stream<ap_axiu<W,0,0,0> >& m_axis_ICMP,
+                     hls::stream<ap_axiu<W,0,0,0> >& m_axis_IGMP,                
 #ifndef UDP_ONLY 
-                     hls::stream<ap_axiu<64,0,0,0> >& m_axis_TCP,
+                     hls::stream<ap_axiu<W,0,0,0> >& m_axis_TCP,
 #endif                     
+#ifdef UDP_RX
+                     hls::stream<ap_axiu<W,0,0,0> >& m_axis_UDP,
+#endif
                      ap_uint<32> myIpAddress,
                      uint32_t& ipInHdrErrors,
                      uint32_t& ipInDelivers,
@@ -666,14 +708,14 @@ void ip_handler_body(hls::stream<ap_axiu<64,0,0,0> >& s_axis_raw,
                      uint32_t& ipInAddrErrors,
                      uint32_t& ipInReceives) {
     static hls::stream<ap_uint<16> > etherTypeFifo("etherTypeFifo");
-    static hls::stream<axiWord> ethDataFifo("ethDataFifo");
-    static hls::stream<axiWord> ipv4ShiftFifo("ipv4ShiftFifo");
-
-    static hls::stream<axiWord> ipDataFifo("ipDataFifo");
-    static hls::stream<axiWord> ipDataCheckFifo("ipDataCheckFifo");
-    static hls::stream<axiWord> ipDataDropFifo("ipDataDropFifo");
-    static hls::stream<axiWord> ipDataCutFifo("ipDataCutFifo");
-    static hls::stream<subSums> iph_subSumsFifoOut("iph_subSumsFifoOut");
+    static hls::stream<net_axis<W> > ethDataFifo("ethDataFifo");
+    static hls::stream<net_axis<W> > ipv4ShiftFifo("ipv4ShiftFifo");
+
+    static hls::stream<net_axis<W> > ipDataFifo("ipDataFifo");
+    static hls::stream<net_axis<W> > ipDataCheckFifo("ipDataCheckFifo");
+    static hls::stream<net_axis<W> > ipDataDropFifo("ipDataDropFifo");
+    static hls::stream<net_axis<W> > ipDataCutFifo("ipDataCutFifo");
+    static hls::stream<ipHandlerSubSums> iph_subSumsFifoOut("iph_subSumsFifoOut");
     static hls::stream<packet_valid> ipValidFifo("ipValidFifo");
     #pragma HLS INLINE
 
@@ -693,7 +735,7 @@ void ip_handler_body(hls::stream<ap_axiu<64,0,0,0> >& s_axis_raw,
 
     route_by_eth_protocol(etherTypeFifo, ethDataFifo, m_axis_ARP, ipv4ShiftFifo);
 
-    rshiftWordByOctet<AXI_WIDTH,axiWord, axiWord, 1>(((ETH_HEADER_SIZE % AXI_WIDTH) / 8), ipv4ShiftFifo, ipDataFifo);
+    rshiftWordByOctet<W, net_axis<W>, net_axis<W>, 1>(((ETH_HEADER_SIZE % W) / 8), ipv4ShiftFifo, ipDataFifo);
 
     check_ip_checksum(ipDataFifo, myIpAddress, ipDataCheckFifo, iph_subSumsFifoOut);
 
@@ -704,9 +746,12 @@ void ip_handler_body(hls::stream<ap_axiu<64,0,0,0> >& s_axis_raw,
 
     cut_length(ipDataDropFifo, ipDataCutFifo);
 
-    detect_ipv4_protocol<cfg>(ipDataCutFifo, m_axis_ICMP, m_axis_IGMP, 
+    detect_ipv4_protocol<cfg, W>(ipDataCutFifo, m_axis_ICMP, m_axis_IGMP, 
     #ifndef UDP_ONLY 
     m_axis_TCP, 
+    #endif
+    #ifdef UDP_RX
+    m_axis_UDP,
     #endif
 	ipInDelivers,
 	ipInUnknownProtos);
@@ -728,11 +773,11 @@ void ip_handler_body(hls::stream<ap_axiu<64,0,0,0> >& s_axis_raw,
  *  @param[out]		stats          Statistics
  */
 #ifdef TCP_UDP
-void ip_handler_tcp_udp(hls::stream<ap_axiu<64,0,0,0> >& s_axis_raw,
-                        hls::stream<ap_axiu<64,0,0,0> >& m_axis_ARP,
-                        hls::stream<ap_axiu<64,0,0,0> >& m_axis_ICMP,
-                        hls::stream<ap_axiu<64,0,0,0> >& m_axis_IGMP,
-                        hls::stream<ap_axiu<64,0,0,0> >& m_axis_TCP,
+void ip_handler_tcp_udp(hls::stream<ap_axiu<AXI_WIDTH,0,0,0> >& s_axis_raw,
+                        hls::stream<ap_axiu<AXI_WIDTH,0,0,0> >& m_axis_ARP,
+                        hls::stream<ap_axiu<AXI_WIDTH,0,0,0> >& m_axis_ICMP,
+                        hls::stream<ap_axiu<AXI_WIDTH,0,0,0> >& m_axis_IGMP,
+                        hls::stream<ap_axiu<AXI_WIDTH,0,0,0> >& m_axis_TCP,
                         ap_uint<32> myIpAddress,
                         uint32_t& ipInHdrErrors,
                         uint32_t& ipInDelivers,
@@ -753,7 +798,7 @@ void ip_handler_tcp_udp(hls::stream<ap_axiu<64,0,0,0> >& s_axis_raw,
     #pragma HLS INTERFACE s_axilite port = ipInAddrErrors bundle = control
     #pragma HLS INTERFACE s_axilite port = ipInReceives bundle = control
 
-    ip_handler_body<CONFIG_TCP_UDP>(s_axis_raw, m_axis_ARP, m_axis_ICMP, m_axis_IGMP, m_axis_TCP,
+    ip_handler_body<CONFIG_TCP_UDP, AXI_WIDTH>(s_axis_raw, m_axis_ARP, m_axis_ICMP, m_axis_IGMP, m_axis_TCP,
                                     myIpAddress, ipInHdrErrors, ipInDelivers, ipInUnknownProtos, ipInAddrErrors, ipInReceives);
 }
 #endif
@@ -769,14 +814,17 @@ void ip_handler_tcp_udp(hls::stream<ap_axiu<64,0,0,0> >& s_axis_raw,
  *  @param[out]		m_axis_ARP     outgoing ARP data stream
  *  @param[out]		m_axis_ICMP    outgoing ICMP (Ping) data stream
  *  @param[out]		m_axis_IGMP    outgoing IGMP data stream
- *  @param[out]		m_axis_UDP     outgoing UDP data stream
+ *  @param[out]		m_axis_UDP     outgoing UDP data stream, UDP_RX build only
  *  @param[out]		stats          Statistics
  */
 #ifdef UDP_ONLY
-void ip_handler_udp(hls::stream<ap_axiu<64,0,0,0> >& s_axis_raw,
-                    hls::stream<ap_axiu<64,0,0,0> >& m_axis_ARP,
-                    hls::stream<ap_axiu<64,0,0,0> >& m_axis_ICMP,
-                    hls::stream<ap_axiu<64,0,0,0> >& m_axis_IGMP,
+void ip_handler_udp(hls::stream<ap_axiu<AXI_WIDTH,0,0,0> >& s_axis_raw,
+                    hls::stream<ap_axiu<AXI_WIDTH,0,0,0> >& m_axis_ARP,
+                    hls::stream<ap_axiu<AXI_WIDTH,0,0,0> >& m_axis_ICMP,
+                    hls::stream<ap_axiu<AXI_WIDTH,0,0,0> >& m_axis_IGMP,
+#ifdef UDP_RX
+                    hls::stream<ap_axiu<AXI_WIDTH,0,0,0> >& m_axis_UDP,
+#endif
                     ap_uint<32> myIpAddress,
                     uint32_t& ipInHdrErrors,
                     uint32_t& ipInDelivers,
@@ -789,6 +837,9 @@ void ip_handler_udp(hls::stream<ap_axiu<64,0,0,0> >& s_axis_raw,
     #pragma HLS INTERFACE axis register port = m_axis_ARP
     #pragma HLS INTERFACE axis register port = m_axis_ICMP
     #pragma HLS INTERFACE axis register port = m_axis_IGMP
+#ifdef UDP_RX
+    #pragma HLS INTERFACE axis register port = m_axis_UDP
+#endif
     #pragma HLS INTERFACE ap_stable port = myIpAddress
     #pragma HLS INTERFACE s_axilite port = ipInHdrErrors bundle = control
     #pragma HLS INTERFACE s_axilite port = ipInDelivers bundle = control
@@ -796,8 +847,12 @@ void ip_handler_udp(hls::stream<ap_axiu<64,0,0,0> >& s_axis_raw,
     #pragma HLS INTERFACE s_axilite port = ipInAddrErrors bundle = control
     #pragma HLS INTERFACE s_axilite port = ipInReceives bundle = control
 
-    ip_handler_body<CONFIG_UDP>(s_axis_raw, m_axis_ARP, m_axis_ICMP, m_axis_IGMP, myIpAddress,
-                                 ipInHdrErrors, ipInDelivers, ipInUnknownProtos, ipInAddrErrors, ipInReceives);
+    ip_handler_body<CONFIG_UDP, AXI_WIDTH>(s_axis_raw, m_axis_ARP, m_axis_ICMP, m_axis_IGMP,
+#ifdef UDP_RX
+                                           m_axis_UDP,
+#endif
+                                           myIpAddress, ipInHdrErrors, ipInDelivers, ipInUnknownProtos, ipInAddrErrors,
+                                           ipInReceives);
 }
 #endif
 
@@ -816,11 +871,11 @@ void ip_handler_udp(hls::stream<ap_axiu<64,0,0,0> >& s_axis_raw,
  *  @param[out]		stats          Statistics
  */
 #ifdef TCP_ONLY
-void ip_handler_tcp(hls::stream<ap_axiu<64,0,0,0> >& s_axis_raw,
-                    hls::stream<ap_axiu<64,0,0,0> >& m_axis_ARP,
-                    hls::stream<ap_axiu<64,0,0,0> >& m_axis_ICMP,
-                    hls::stream<ap_axiu<64,0,0,0> >& m_axis_IGMP,
-                    hls::stream<ap_axiu<64,0,0,0> >& m_axis_TCP,
+void ip_handler_tcp(hls::stream<ap_axiu<AXI_WIDTH,0,0,0> >& s_axis_raw,
+                    hls::stream<ap_axiu<AXI_WIDTH,0,0,0> >& m_axis_ARP,
+                    hls::stream<ap_axiu<AXI_WIDTH,0,0,0> >& m_axis_ICMP,
+                    hls::stream<ap_axiu<AXI_WIDTH,0,0,0> >& m_axis_IGMP,
+                    hls::stream<ap_axiu<AXI_WIDTH,0,0,0> >& m_axis_TCP,
                     ap_uint<32> myIpAddress,
                     uint32_t& ipInHdrErrors,
                     uint32_t& ipInDelivers,
@@ -841,7 +896,7 @@ void ip_handler_tcp(hls::stream<ap_axiu<64,0,0,0> >& s_axis_raw,
     #pragma HLS INTERFACE s_axilite port = ipInAddrErrors bundle = control
     #pragma HLS INTERFACE s_axilite port = ipInReceives bundle = control
 
-    ip_handler_body<CONFIG_TCP>(s_axis_raw, m_axis_ARP, m_axis_ICMP, m_axis_IGMP, m_axis_TCP, myIpAddress,
+    ip_handler_body<CONFIG_TCP, AXI_WIDTH>(s_axis_raw, m_axis_ARP, m_axis_ICMP, m_axis_IGMP, m_axis_TCP, myIpAddress,
                                  ipInHdrErrors, ipInDelivers, ipInUnknownProtos, ipInAddrErrors, ipInReceives);
 }
 #endif
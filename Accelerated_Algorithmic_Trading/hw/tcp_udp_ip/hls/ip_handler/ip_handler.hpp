@@ -29,6 +29,14 @@ EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.// Copyright (c) 2015 Xilinx,
 #include "../axi_utils.hpp"
 #include "../packet.hpp"
 
+// UDP receive build, UDP only handler with the UDP stream routed out towards
+// the ipv4 and udp receive chain
+#ifdef UDP_RX
+#ifndef UDP_ONLY
+#define UDP_ONLY
+#endif
+#endif
+
 const int ETH_HEADER_SIZE = 112;
 
 const uint16_t ARP = 0x0806;
@@ -42,17 +50,17 @@ const uint8_t TCP = 0x06;
 
 enum ip_handler_cfg { CONFIG_UDP = 1, CONFIG_TCP = 2, CONFIG_TCP_UDP = 3};
 
-struct subSums {
+struct ipHandlerSubSums {
     ap_uint<17> sum0;
     ap_uint<17> sum1;
     ap_uint<17> sum2;
     ap_uint<17> sum3;
     bool ipMatch;
     bool hdrValid;
-    subSums() {}
-    subSums(ap_uint<17> sums[4], bool match, bool valid)
+    ipHandlerSubSums() {}
+    ipHandlerSubSums(ap_uint<17> sums[4], bool match, bool valid)
         : sum0(sums[0]), sum1(sums[1]), sum2(sums[2]), sum3(sums[3]), ipMatch(match), hdrValid(valid) {}
-    subSums(ap_uint<17> s0, ap_uint<17> s1, ap_uint<17> s2, ap_uint<17> s3, bool match, bool valid)
+    ipHandlerSubSums(ap_uint<17> s0, ap_uint<17> s1, ap_uint<17> s2, ap_uint<17> s3, bool match, bool valid)
         : sum0(s0), sum1(s1), sum2(s2), sum3(s3), ipMatch(match), hdrValid(valid) {}
 };
 
@@ -76,12 +84,12 @@ class ethHeader : public packetHeader<W, ETH_HEADER_SIZE> {
  * (ARP, ICMP, UDP or TCP). It also performs an IP address match and
  * verifies the IP header checksum.
  */
-void ip_handler_tcp_udp(hls::stream<ap_axiu<64,0,0,0> >& s_axis_raw,
-                        hls::stream<ap_axiu<64,0,0,0> >& m_axis_ARP,
-                        hls::stream<ap_axiu<64,0,0,0> >& m_axis_ICMP,
-                        hls::stream<ap_axiu<64,0,0,0> >& m_axis_IGMP,
-                        // hls::stream<ap_axiu<64,0,0,0> >& m_axis_UDP,
-                        hls::stream<ap_axiu<64,0,0,0> >& m_axis_TCP,
+void ip_handler_tcp_udp(hls::stream<ap_axiu<AXI_WIDTH,0,0,0> >& s_axis_raw,
+                        hls::stream<ap_axiu<AXI_WIDTH,0,0,0> >& m_axis_ARP,
+                        hls::stream<ap_axiu<AXI_WIDTH,0,0,0> >& m_axis_ICMP,
+                        hls::stream<ap_axiu<AXI_WIDTH,0,0,0> >& m_axis_IGMP,
+                        // hls::stream<ap_axiu<AXI_WIDTH,0,0,0> >& m_axis_UDP,
+                        hls::stream<ap_axiu<AXI_WIDTH,0,0,0> >& m_axis_TCP,
                         ap_uint<32> myIpAddress,
                         uint32_t& ipInHdrErrors,
                         uint32_t& ipInDelivers,
@@ -96,11 +104,13 @@ void ip_handler_tcp_udp(hls::stream<ap_axiu<64,0,0,0> >& s_axis_raw,
  * (ARP, ICMP, UDP ). It also performs an IP address match and
  * verifies the IP header checksum.
  */
-void ip_handler_udp(hls::stream<ap_axiu<64,0,0,0> >& s_axis_raw,
-                    hls::stream<ap_axiu<64,0,0,0> >& m_axis_ARP,
-                    hls::stream<ap_axiu<64,0,0,0> >& m_axis_ICMP,
-                    hls::stream<ap_axiu<64,0,0,0> >& m_axis_IGMP,
-                    // hls::stream<ap_axiu<64,0,0,0> >& m_axis_UDP,
+void ip_handler_udp(hls::stream<ap_axiu<AXI_WIDTH,0,0,0> >& s_axis_raw,
+                    hls::stream<ap_axiu<AXI_WIDTH,0,0,0> >& m_axis_ARP,
+                    hls::stream<ap_axiu<AXI_WIDTH,0,0,0> >& m_axis_ICMP,
+                    hls::stream<ap_axiu<AXI_WIDTH,0,0,0> >& m_axis_IGMP,
+#ifdef UDP_RX
+                    hls::stream<ap_axiu<AXI_WIDTH,0,0,0> >& m_axis_UDP,
+#endif
                     ap_uint<32> myIpAddress,
                         uint32_t& ipInHdrErrors,
                         uint32_t& ipInDelivers,
@@ -115,11 +125,11 @@ void ip_handler_udp(hls::stream<ap_axiu<64,0,0,0> >& s_axis_raw,
  * (ARP, ICMP, TCP ). It also performs an IP address match and
  * verifies the IP header checksum.
  */
-void ip_handler_tcp(hls::stream<ap_axiu<64,0,0,0> >& s_axis_raw,
-                    hls::stream<ap_axiu<64,0,0,0> >& m_axis_ARP,
-                    hls::stream<ap_axiu<64,0,0,0> >& m_axis_ICMP,
-                    hls::stream<ap_axiu<64,0,0,0> >& m_axis_IGMP,
-                    hls::stream<ap_axiu<64,0,0,0> >& m_axis_TCP,
+void ip_handler_tcp(hls::stream<ap_axiu<AXI_WIDTH,0,0,0> >& s_axis_raw,
+                    hls::stream<ap_axiu<AXI_WIDTH,0,0,0> >& m_axis_ARP,
+                    hls::stream<ap_axiu<AXI_WIDTH,0,0,0> >& m_axis_ICMP,
+                    hls::stream<ap_axiu<AXI_WIDTH,0,0,0> >& m_axis_IGMP,
+                    hls::stream<ap_axiu<AXI_WIDTH,0,0,0> >& m_axis_TCP,
                     ap_uint<32> myIpAddress,
                     uint32_t& ipInHdrErrors,
                     uint32_t& ipInDelivers,
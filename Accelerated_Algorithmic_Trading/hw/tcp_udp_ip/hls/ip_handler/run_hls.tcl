@@ -27,8 +27,13 @@
 # ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
 # THE POSSIBILITY OF SUCH DAMAGE.
 
+# datapath width of the UDP receive chain, common.mk passes it when built through make
+if {![info exists ::env(UDP_RX_WIDTH)]} {
+    set ::env(UDP_RX_WIDTH) 64
+}
+
 set build $::env(HLSBUILD)
-if {$build eq "UDP_ONLY"} {
+if {$build eq "UDP_ONLY" || $build eq "UDP_RX"} {
     set top ip_handler_udp    
 } elseif {$build eq "TCP_ONLY"} {
     set top ip_handler_tcp
@@ -36,7 +41,7 @@ if {$build eq "UDP_ONLY"} {
     set top ip_handler_tcp_udp
 }
 
-set cflags "-D $::env(HLSBUILD)"
+set cflags "-D $::env(HLSBUILD) -DAXI_WIDTH=$::env(UDP_RX_WIDTH)"
 
 open_project ${top}_prj
 set_top $top
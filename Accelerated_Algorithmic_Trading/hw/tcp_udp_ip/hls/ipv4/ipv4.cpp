@@ -36,7 +36,7 @@
  * @param [out] dataOut
  */
 template <int WIDTH>
-void process_ipv4(hls::stream<ap_axiu<64,0,0,0> >& dataIn,
+void process_ipv4(hls::stream<ap_axiu<WIDTH,0,0,0> >& dataIn,
                   hls::stream<ap_uint<4> >& process2dropLengthFifo,
                   hls::stream<ipv4Meta>& MetaOut,
                   hls::stream<net_axis<WIDTH> >& dataOut) {
@@ -48,7 +48,7 @@ void process_ipv4(hls::stream<ap_axiu<64,0,0,0> >& dataIn,
     static bool metaWritten = false;
 
     net_axis<WIDTH> currWord;
-    ap_axiu<64,0,0,0> inWord;
+    ap_axiu<WIDTH,0,0,0> inWord;
 
     if (!dataIn.empty()) {
         dataIn.read(inWord);
@@ -63,7 +63,7 @@ void process_ipv4(hls::stream<ap_axiu<64,0,0,0> >& dataIn,
                 std::cout << "IP HEADER: src address: " << header.getSrcAddr() << ", length: " << header.getLength()
                           << std::endl;
                 process2dropLengthFifo.write(header.getHeaderLength() - headerWordsDropped);
-                MetaOut.write(ipv4Meta(header.getSrcAddr(), header.getLength()));
+                MetaOut.write(ipv4Meta(header.getSrcAddr(), header.getLength(), header.getDstAddr()));
                 metaWritten = true;
             }
         }
@@ -185,12 +185,12 @@ void generate_ipv4(hls::stream<ipv4Meta>& txEng_ipMetaDataFifoIn,
  * @param[out] protocol
  */
 template <int WIDTH>
-void ipv4_body(hls::stream<ap_axiu<64,0,0,0> >& s_axis_rx_data,
+void ipv4_body(hls::stream<ap_axiu<WIDTH,0,0,0> >& s_axis_rx_data,
                hls::stream<ipv4Meta>& m_axis_rx_meta,
-               hls::stream<ap_axiu<64,0,0,0> >& m_axis_rx_data,
+               hls::stream<ap_axiu<WIDTH,0,0,0> >& m_axis_rx_data,
                hls::stream<ipv4Meta>& s_axis_tx_meta,
-               hls::stream<ap_axiu<64,0,0,0> >& s_axis_tx_data,
-               hls::stream<ap_axiu<64,0,0,0> >& m_axis_tx_data,
+               hls::stream<ap_axiu<WIDTH,0,0,0> >& s_axis_tx_data,
+               hls::stream<ap_axiu<WIDTH,0,0,0> >& m_axis_tx_data,
                ap_uint<32> local_ipv4_address,
                ap_uint<8> protocol) {
 #pragma HLS INLINE
@@ -208,7 +208,7 @@ void ipv4_body(hls::stream<ap_axiu<64,0,0,0> >& s_axis_rx_data,
      * RX PATH
      */
     process_ipv4(s_axis_rx_data, rx_process2dropLengthFifo, m_axis_rx_meta, rx_process2dropFifo);    
-    drop_optional_ip_header<64,ap_axiu<64,0,0,0> >(rx_process2dropLengthFifo, rx_process2dropFifo, m_axis_rx_data);
+    drop_optional_ip_header<WIDTH, ap_axiu<WIDTH,0,0,0> >(rx_process2dropLengthFifo, rx_process2dropFifo, m_axis_rx_data);
 
     /*
      * TX PATH
@@ -233,12 +233,12 @@ void ipv4_body(hls::stream<ap_axiu<64,0,0,0> >& s_axis_rx_data,
  * @param[out] protocol
  */
 
-void ipv4(hls::stream<ap_axiu<64,0,0,0> >& s_axis_rx_data,
+void ipv4(hls::stream<ap_axiu<AXI_WIDTH,0,0,0> >& s_axis_rx_data,
           hls::stream<ipv4Meta>& m_axis_rx_meta,
-          hls::stream<ap_axiu<64,0,0,0> >& m_axis_rx_data,
+          hls::stream<ap_axiu<AXI_WIDTH,0,0,0> >& m_axis_rx_data,
           hls::stream<ipv4Meta>& s_axis_tx_meta,
-          hls::stream<ap_axiu<64,0,0,0> >& s_axis_tx_data,
-          hls::stream<ap_axiu<64,0,0,0> >& m_axis_tx_data,
+          hls::stream<ap_axiu<AXI_WIDTH,0,0,0> >& s_axis_tx_data,
+          hls::stream<ap_axiu<AXI_WIDTH,0,0,0> >& m_axis_tx_data,
           ap_uint<32> local_ipv4_address,
           ap_uint<8> protocol) {
     #pragma HLS DATAFLOW disable_start_propagation
@@ -32,12 +32,17 @@
 
 const uint32_t IPV4_HEADER_SIZE = 160;
 
+// my_address - destination address of a received packet, lets the upper
+// layers tell multicast groups apart, unused on transmit
 struct __attribute__((packed)) ipv4Meta {
     ap_uint<32> their_address;
     ap_uint<16> length;
+    ap_uint<32> my_address;
     ipv4Meta() {}
-    ipv4Meta(ap_uint<32> addr, ap_uint<16> len) : their_address(addr), length(len) {}
-    ipv4Meta(ap_uint<128> addr, ap_uint<16> len) : their_address(addr(31, 0)), length(len) {}
+    ipv4Meta(ap_uint<32> addr, ap_uint<16> len) : their_address(addr), length(len), my_address(0) {}
+    ipv4Meta(ap_uint<128> addr, ap_uint<16> len) : their_address(addr(31, 0)), length(len), my_address(0) {}
+    ipv4Meta(ap_uint<32> addr, ap_uint<16> len, ap_uint<32> myAddr)
+        : their_address(addr), length(len), my_address(myAddr) {}
 };
 
 template <int N>
@@ -52,7 +57,7 @@ void drop_optional_ip_header(hls::stream<ap_uint<4> >& process2dropLengthFifo,
 #pragma HLS INLINE off
 #pragma HLS pipeline II = 1
 
-    enum fsmStateType { META, DROP, BODY, SHIFT, LAST, SHIFT_FIVE, LAST_FIVE };
+    enum fsmStateType { META, DROP, FIRST, BODY, SHIFT, LAST };
     static fsmStateType doh_state = META;
     static ap_uint<4> length;
 
@@ -60,29 +65,31 @@ void drop_optional_ip_header(hls::stream<ap_uint<4> >& process2dropLengthFifo,
     net_axis<WIDTH> currWord;
     T sendWord;
 
+    // length is the number of header dwords left from the first word passed on
+    // by process_ipv4. Words holding nothing but header (IP options on narrow
+    // widths) are dropped, then SHIFT and LAST drop the remaining length x 32
+    // bits of header from the front of prevWord
     switch (doh_state) {
+        case LAST:
+            sendWord.data = prevWord.data >> (length * 32);
+            sendWord.keep = prevWord.keep >> (length * 4);
+            sendWord.last = 0x1;
+            dataOut.write(sendWord);
+            doh_state = META;
+            // Fall through, the first word of the next packet produces no output
+            // and is taken in the same cycle
         case META:
             if (!process2dropLengthFifo.empty() && !process2dropFifo.empty()) {
                 process2dropLengthFifo.read(length);
                 std::cout << "(Optional) Header length: " << length << std::endl;
 
-                // TODO for WIDTH == 128 this only works if no IP options
-                if (WIDTH == 64 || WIDTH == 128) {
-                    if (length > 1) {
-                        doh_state = DROP;
-                    } else {
-                        process2dropFifo.read(prevWord);
-                        doh_state = SHIFT;
-                    }
-                }
-                if (WIDTH == 256 || WIDTH == 512) {
-                    // TODO this is a hack and only works if there are no IP options
-                    if (length == 5) {
-                        process2dropFifo.read(prevWord);
-                        doh_state = SHIFT_FIVE;
-                        if (prevWord.last) {
-                            doh_state = LAST_FIVE;
-                        }
+                if (length >= (WIDTH / 32)) {
+                    doh_state = DROP;
+                } else {
+                    process2dropFifo.read(prevWord);
+                    doh_state = SHIFT;
+                    if (prevWord.last) {
+                        doh_state = LAST;
                     }
                 }
             }
@@ -90,11 +97,22 @@ void drop_optional_ip_header(hls::stream<ap_uint<4> >& process2dropLengthFifo,
         case DROP:
             if (!process2dropFifo.empty()) {
                 process2dropFifo.read(prevWord);
-                length -= 2;
-                if (length == 1) {
-                    doh_state = SHIFT;
+                length -= (WIDTH / 32);
+                if (prevWord.last) {
+                    doh_state = META;
                 } else if (length == 0) {
                     doh_state = BODY;
+                } else if (length < (WIDTH / 32)) {
+                    doh_state = FIRST;
+                }
+            }
+            break;
+        case FIRST:
+            if (!process2dropFifo.empty()) {
+                process2dropFifo.read(prevWord);
+                doh_state = SHIFT;
+                if (prevWord.last) {
+                    doh_state = LAST;
                 }
             }
             break;
@@ -113,11 +131,9 @@ void drop_optional_ip_header(hls::stream<ap_uint<4> >& process2dropLengthFifo,
         case SHIFT:
             if (!process2dropFifo.empty()) {
                 process2dropFifo.read(currWord);
-                sendWord.data(WIDTH - 32 - 1, 0) = prevWord.data(WIDTH - 1, 32);
-                sendWord.keep((WIDTH / 8) - 4 - 1, 0) = prevWord.keep((WIDTH / 8) - 1, 4);
-                sendWord.data(WIDTH - 1, WIDTH - 32) = currWord.data(31, 0);
-                sendWord.keep((WIDTH / 8) - 1, (WIDTH / 8) - 4) = currWord.keep(3, 0);
-                sendWord.last = (currWord.keep[4] == 0);
+                sendWord.data = (prevWord.data >> (length * 32)) | (currWord.data << (WIDTH - (length * 32)));
+                sendWord.keep = (prevWord.keep >> (length * 4)) | (currWord.keep << ((WIDTH / 8) - (length * 4)));
+                sendWord.last = ((currWord.keep >> (length * 4)) == 0);
                 dataOut.write(sendWord);
                 prevWord = currWord;
                 if (sendWord.last) {
@@ -127,41 +143,6 @@ void drop_optional_ip_header(hls::stream<ap_uint<4> >& process2dropLengthFifo,
                 }
             }
             break;
-        case SHIFT_FIVE:
-            if (!process2dropFifo.empty()) {
-                process2dropFifo.read(currWord);
-                sendWord.data(WIDTH - 160 - 1, 0) = prevWord.data(WIDTH - 1, 160);
-                sendWord.keep((WIDTH / 8) - 20 - 1, 0) = prevWord.keep((WIDTH / 8) - 1, 20);
-                sendWord.data(WIDTH - 1, WIDTH - 160) = currWord.data(160 - 1, 0);
-                sendWord.keep((WIDTH / 8) - 1, (WIDTH / 8) - 20) = currWord.keep(20 - 1, 0);
-                sendWord.last = (currWord.keep[20] == 0);
-                dataOut.write(sendWord);
-                prevWord = currWord;
-                if (sendWord.last) {
-                    doh_state = META;
-                } else if (currWord.last) {
-                    doh_state = LAST_FIVE;
-                }
-            }
-            break;
-        case LAST:
-            sendWord.data(WIDTH - 32 - 1, 0) = prevWord.data(WIDTH - 1, 32);
-            sendWord.keep((WIDTH / 8) - 4 - 1, 0) = prevWord.keep((WIDTH / 8) - 1, 4);
-            sendWord.data(WIDTH - 1, WIDTH - 32) = 0;
-            sendWord.keep((WIDTH / 8) - 1, (WIDTH / 8) - 4) = 0x0;
-            sendWord.last = 0x1;
-            dataOut.write(sendWord);
-            doh_state = META;
-            break;
-        case LAST_FIVE:
-            sendWord.data(WIDTH - 160 - 1, 0) = prevWord.data(WIDTH - 1, 160);
-            sendWord.keep((WIDTH / 8) - 20 - 1, 0) = prevWord.keep((WIDTH / 8) - 1, 20);
-            sendWord.data(WIDTH - 1, WIDTH - 160) = 0;
-            sendWord.keep((WIDTH / 8) - 1, (WIDTH / 8) - 20) = 0;
-            sendWord.last = 0x1;
-            dataOut.write(sendWord);
-            doh_state = META;
-            break;
     } // switch
 }
 
@@ -302,12 +283,12 @@ class ipv4Header : public packetHeader<W, IPV4_HEADER_SIZE> {
  * @defgroup ipv4 IPv4 Module
  */
 
-void ipv4(hls::stream<ap_axiu<64,0,0,0> >& s_axis_rx_data,
+void ipv4(hls::stream<ap_axiu<AXI_WIDTH,0,0,0> >& s_axis_rx_data,
           hls::stream<ipv4Meta>& m_axis_rx_meta,
-          hls::stream<ap_axiu<64,0,0,0> >& m_axis_rx_data,
+          hls::stream<ap_axiu<AXI_WIDTH,0,0,0> >& m_axis_rx_data,
           hls::stream<ipv4Meta>& s_axis_tx_meta,
-          hls::stream<ap_axiu<64,0,0,0> >& s_axis_tx_data,
-          hls::stream<ap_axiu<64,0,0,0> >& m_axis_tx_data,
+          hls::stream<ap_axiu<AXI_WIDTH,0,0,0> >& s_axis_tx_data,
+          hls::stream<ap_axiu<AXI_WIDTH,0,0,0> >& m_axis_tx_data,
           ap_uint<32> local_ipv4_address,
           ap_uint<8> protocol);
 
@@ -27,13 +27,18 @@
 # ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
 # THE POSSIBILITY OF SUCH DAMAGE.
 
+# datapath width of the UDP receive chain, common.mk passes it when built through make
+if {![info exists ::env(UDP_RX_WIDTH)]} {
+    set ::env(UDP_RX_WIDTH) 64
+}
+
 open_project ipv4_prj
 
 set_top ipv4
 
 add_files ../packet.hpp
 add_files ipv4.hpp
-add_files ipv4.cpp
+add_files ipv4.cpp -cflags "-DAXI_WIDTH=$::env(UDP_RX_WIDTH)"
 
 
 #add_files -tb test_ipv4.cpp
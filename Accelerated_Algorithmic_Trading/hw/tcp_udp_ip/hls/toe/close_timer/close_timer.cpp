@@ -31,15 +31,7 @@
  ************************************************/
 
 #include "close_timer.hpp"
-
-/** @ingroup close_timer
- *
- * A single entry in the close_timer() table.
- */
-struct close_timer_entry {
-    ap_uint<32> time;
-    bool active;
-};
+#include "../timer_wheel/timer_wheel.hpp"
 
 /** 
  * @ingroup close_timer
@@ -53,8 +45,6 @@ struct close_timer_entry {
  *                                            the TIME-WAIT state.
  * @param[out] timer2stateTable_releaseState  Write Sessions which are 
  *                                            closed into this FIFO
- *
- * @todo Does the closeTimerTable need to be BRAM now MAX_SESSIONS is reduced?
  */
 void close_timer(hls::stream<ap_uint<16> >& rxEng2timer_setCloseTimer,
                  hls::stream<ap_uint<16> >& closeTimer2stateTable_releaseState) {
@@ -63,44 +53,18 @@ void close_timer(hls::stream<ap_uint<16> >& rxEng2timer_setCloseTimer,
 #pragma HLS DATA_PACK variable = rxEng2timer_setCloseTimer
 #pragma HLS DATA_PACK variable = closeTimer2stateTable_releaseState
 
-    static close_timer_entry closeTimerTable[MAX_SESSIONS];
-    // clang-format off
-    #pragma HLS RESOURCE   variable = closeTimerTable core = RAM_T2P_BRAM
-    #pragma HLS DATA_PACK  variable = closeTimerTable
-    #pragma HLS DEPENDENCE variable = closeTimerTable inter false
-    //clang-format on
+    static timer_wheel<MAX_SESSIONS, TIMER_WHEEL_SLOTS, TIMER_WHEEL_HORIZON, TIMER_TICK_CYCLES> ct_wheel;
 
-    static ap_uint<16> ct_currSessionID = 0;
-    static ap_uint<16> ct_setSessionID = 0;
-    static ap_uint<16> ct_prevSessionID = 0;
-    static bool ct_waitForWrite = false;
+    timerWheelOp op = TW_SWEEP;
+    ap_uint<16> currID = 0;
+    ap_uint<16> expiredID;
 
-    if (ct_waitForWrite) {
-        if (ct_setSessionID != ct_prevSessionID) {
-            closeTimerTable[ct_setSessionID].time = TIME_60s;
-            closeTimerTable[ct_setSessionID].active = true;
-            ct_waitForWrite = false;
-        }
-        ct_prevSessionID--;
-    } else if (!rxEng2timer_setCloseTimer.empty()) {
-        rxEng2timer_setCloseTimer.read(ct_setSessionID);
-        ct_waitForWrite = true;
-    } else {
-        ct_prevSessionID = ct_currSessionID;
-        // Check if 0, otherwise decrement
-        if (closeTimerTable[ct_currSessionID].active) {
-            if (closeTimerTable[ct_currSessionID].time > 0) {
-                closeTimerTable[ct_currSessionID].time -= 1;
-            } else {
-                closeTimerTable[ct_currSessionID].time = 0;
-                closeTimerTable[ct_currSessionID].active = false;
-                closeTimer2stateTable_releaseState.write(ct_currSessionID);
-            }
-        }
+    if (!rxEng2timer_setCloseTimer.empty()) {
+        rxEng2timer_setCloseTimer.read(currID);
+        op = TW_ARM;
+    }
 
-        ct_currSessionID++;
-        if (ct_currSessionID == MAX_SESSIONS) {
-            ct_currSessionID = 0;
-        }
+    if (ct_wheel.step(op, currID, TICKS_60s, !closeTimer2stateTable_releaseState.full(), expiredID)) {
+        closeTimer2stateTable_releaseState.write(expiredID);
     }
 }
@@ -31,21 +31,11 @@
  ************************************************/
 
 #include "probe_timer.hpp"
+#include "../timer_wheel/timer_wheel.hpp"
 
 /** @ingroup probe_timer
  *
- * Single entry in the probe timer table.
- *
- */
-struct probe_timer_entry {
-    ap_uint<32> time;
-    bool active;
-};
-
-
-/** @ingroup probe_timer
- *
- *  Reads in the Session-ID and activates a timer with an interval of 5 seconds. When the timer times out
+ *  Reads in the Session-ID and activates a timer with an interval of 50 milliseconds. When the timer times out
  *  a RT Event is fired to the @ref tx_engine. In case of a zero-window (or too small window) an RT Event
  *  will generate a packet without payload which is the same as a probing packet.
  *  @param[in]  rxEng2timer_clearProbeTimer
@@ -57,64 +47,45 @@ void probe_timer(hls::stream<ap_uint<16> >& rxEng2timer_clearProbeTimer,
                  hls::stream<event>& probeTimer2eventEng_setEvent) {                     
 #pragma HLS PIPELINE II = 1
 
-    static probe_timer_entry probeTimerTable[MAX_SESSIONS];
+    static bool probeTimerActive[MAX_SESSIONS];
     // clang-format off
-    #pragma HLS RESOURCE variable = probeTimerTable core = RAM_T2P_BRAM
-    #pragma HLS DATA_PACK variable = probeTimerTable
-    #pragma HLS DEPENDENCE variable = probeTimerTable inter false
+    #pragma HLS RESOURCE variable = probeTimerActive core = RAM_T2P_BRAM
+    #pragma HLS DEPENDENCE variable = probeTimerActive inter false
     // clang-format on
 
-    static ap_uint<16> pt_currSessionID = 0;
-    static ap_uint<16> pt_updSessionID = 0;
-    static ap_uint<16> pt_prevSessionID = 0;
-    static bool pt_WaitForWrite = false;
+    static timer_wheel<MAX_SESSIONS, TIMER_WHEEL_SLOTS, TIMER_WHEEL_HORIZON, TIMER_TICK_CYCLES> pt_wheel;
 
-    ap_uint<16> checkID;
-    bool fastResume = false;
+    timerWheelOp op = TW_SWEEP;
+    ap_uint<16> currID = 0;
+    ap_uint<16> expiredID;
+    bool fire = false;
 
-    if (pt_WaitForWrite) {
-        if (pt_updSessionID != pt_prevSessionID) {
-            probeTimerTable[pt_updSessionID].time = TIME_50ms;
-            probeTimerTable[pt_updSessionID].active = true;
-            pt_WaitForWrite = false;
+    if (!txEng2timer_setProbeTimer.empty()) {
+        txEng2timer_setProbeTimer.read(currID);
+        probeTimerActive[currID] = true;
+        op = TW_ARM;
+    } else if (!rxEng2timer_clearProbeTimer.empty() && !probeTimer2eventEng_setEvent.full()) {
+        // window opened, resume without waiting for the time-out
+        rxEng2timer_clearProbeTimer.read(currID);
+        if (probeTimerActive[currID]) {
+            probeTimerActive[currID] = false;
+            op = TW_CANCEL;
+            fire = true;
         }
-        pt_prevSessionID--;
-    } else if (!txEng2timer_setProbeTimer.empty()) {
-        txEng2timer_setProbeTimer.read(pt_updSessionID);
-        pt_WaitForWrite = true;
     }
-    // too restrictive FIXME
-    else // if (!probeTimer2eventEng_setEvent.full()) this leads to II=2
-    {
-        // pt_prevSessionID = pt_currSessionID;
-        checkID = pt_currSessionID;
 
-        if (!rxEng2timer_clearProbeTimer.empty()) {
-            rxEng2timer_clearProbeTimer.read(checkID);
-            fastResume = true;
-        } else {
-            pt_currSessionID++;
-            if (pt_currSessionID == MAX_SESSIONS) {
-                pt_currSessionID = 0;
-            }
-        }
+    if (pt_wheel.step(op, currID, TICKS_50ms, !probeTimer2eventEng_setEvent.full(), expiredID)) {
+        probeTimerActive[expiredID] = false;
+        currID = expiredID;
+        fire = true;
+    }
 
-        // Check if 0, otherwise decrement
-        if (probeTimerTable[checkID].active && !probeTimer2eventEng_setEvent.full()) {
-            if (probeTimerTable[checkID].time == 0 || fastResume) {
-                probeTimerTable[checkID].time = 0;
-                probeTimerTable[checkID].active = false;
+    if (fire) {
 // It's not an RT, we want to resume TX
 #if !(TCP_NODELAY)
-                probeTimer2eventEng_setEvent.write(event(TX, checkID));
+        probeTimer2eventEng_setEvent.write(event(TX, currID));
 #else
-                probeTimer2eventEng_setEvent.write(event(RT, checkID));
+        probeTimer2eventEng_setEvent.write(event(RT, currID));
 #endif
-                fastResume = false;
-            } else {
-                probeTimerTable[checkID].time -= 1;
-            }
-        }
-        pt_prevSessionID = checkID;
     }
 }
@@ -32,13 +32,14 @@
  ************************************************/
 
 #include "retransmit_timer.hpp"
+#include "../timer_wheel/timer_wheel.hpp"
 
 /** @ingroup retransmit_timer
  *
- * Single entry in the retransmit Timer Table.
+ * Single entry in the retransmit Timer Table, the time-out itself is held
+ * by the @ref timer_wheel.
  */
 struct retransmitTimerEntry {
-    ap_uint<32> time;
     ap_uint<3> retries;
     bool active;
     eventType type;
@@ -82,106 +83,81 @@ void retransmit_timer(hls::stream<rxRetransmitTimerUpdate>& rxEng2timer_clearRet
     #pragma HLS DEPENDENCE variable = retransmitTimerTable inter false
     //clang-format on
 
-    static ap_uint<16> rt_position = 0;
-    static bool rt_waitForWrite = false;
-    static ap_uint<16> rt_prevPosition = 0;
-    static rxRetransmitTimerUpdate rt_update;
+    static timer_wheel<MAX_SESSIONS, TIMER_WHEEL_SLOTS, TIMER_WHEEL_HORIZON, TIMER_TICK_CYCLES> rt_wheel;
 
     retransmitTimerEntry currEntry;
-    ap_uint<1> operationSwitch = 0;
+    rxRetransmitTimerUpdate update;
     txRetransmitTimerSet set;
-    ap_uint<16> currID;
+    timerWheelOp op = TW_SWEEP;
+    ap_uint<16> currID = 0;
+    ap_uint<32> interval = 0;
+    ap_uint<16> expiredID;
     appNotification notification;
 
-    if (rt_waitForWrite && rt_update.sessionID != rt_prevPosition)
-    {
-        if (!rt_update.stop) {
-            retransmitTimerTable[rt_update.sessionID].time = TIME_1s;
+    if (!rxEng2timer_clearRetransmitTimer.empty()) {
+        rxEng2timer_clearRetransmitTimer.read(update);
+        currID = update.sessionID;
+        currEntry = retransmitTimerTable[currID];
+        if (!update.stop) {
+            // restart a running timer
+            if (currEntry.active) {
+                op = TW_ARM;
+                interval = TICKS_1s;
+            }
         } else {
-            retransmitTimerTable[rt_update.sessionID].time = 0;
-            retransmitTimerTable[rt_update.sessionID].active = false;
+            currEntry.active = false;
+            op = TW_CANCEL;
         }
-        retransmitTimerTable[rt_update.sessionID].retries = 0;
-        rt_waitForWrite = false;
-    } else if (!rxEng2timer_clearRetransmitTimer.empty() && !rt_waitForWrite)
-    {
-        rxEng2timer_clearRetransmitTimer.read(rt_update);
-        rt_waitForWrite = true;
-    } else {
-        currID = rt_position;
-
-        if (!txEng2timer_setRetransmitTimer.empty()) {
-            txEng2timer_setRetransmitTimer.read(set);
-            currID = set.sessionID;
-            operationSwitch = 1;
-            if (set.sessionID - 3 < rt_position && rt_position <= set.sessionID) {
-                rt_position += 5;
+        currEntry.retries = 0;
+        retransmitTimerTable[currID] = currEntry;
+    } else if (!txEng2timer_setRetransmitTimer.empty()) {
+        txEng2timer_setRetransmitTimer.read(set);
+        currID = set.sessionID;
+        currEntry = retransmitTimerTable[currID];
+        currEntry.type = set.type;
+        if (!currEntry.active) {
+            switch (currEntry.retries) {
+                case 0:
+                    interval = TICKS_1s;
+                    break;
+                case 1:
+                    interval = TICKS_5s;
+                    break;
+                case 2:
+                    interval = TICKS_10s;
+                    break;
+                case 3:
+                    interval = TICKS_15s;
+                    break;
+                default:
+                    interval = TICKS_30s;
+                    break;
             }
+            op = TW_ARM;
+        }
+        currEntry.active = true;
+        retransmitTimerTable[currID] = currEntry;
+    }
+
+    // We need to check if we can generate another event, otherwise we might end up in a Deadlock,
+    // since the TX Engine will not be able to set new retransmit timers
+    if (rt_wheel.step(op, currID, interval, !rtTimer2eventEng_setEvent.full(), expiredID)) {
+        currEntry = retransmitTimerTable[expiredID];
+        currEntry.active = false;
+        if (currEntry.retries < 4) {
+            currEntry.retries++;
+            rtTimer2eventEng_setEvent.write(event(currEntry.type, expiredID, currEntry.retries));
         } else {
-            // increment position
-            rt_position++;
-            if (rt_position >= MAX_SESSIONS) {
-                rt_position = 0;
+            currEntry.retries = 0;
+            rtTimer2stateTable_releaseState.write(expiredID);
+            if (currEntry.type == SYN) {
+                rtTimer2txApp_notification.write(openStatus(expiredID, false));
+            } else {
+                notification = appNotification(expiredID);
+                notification.closed = true;
+                rtTimer2rxApp_notification.write(notification); // TIME_OUT
             }
-            operationSwitch = 0;
         }
-
-        // Get entry from table
-        currEntry = retransmitTimerTable[currID];
-        switch (operationSwitch) {
-            case 1:
-                currEntry.type = set.type;
-                if (!currEntry.active) {
-                    switch (currEntry.retries) {
-                        case 0:
-                            currEntry.time = TIME_1s;
-                            break;
-                        case 1:
-                            currEntry.time = TIME_5s;
-                            break;
-                        case 2:
-                            currEntry.time = TIME_10s;
-                            break;
-                        case 3:
-                            currEntry.time = TIME_15s;
-                            break;
-                        default:
-                            currEntry.time = TIME_30s;
-                            break;
-                    }
-                }
-                currEntry.active = true;
-                break;
-            case 0:
-                if (currEntry.active) {
-                    if (currEntry.time > 0) {
-                        currEntry.time--;
-                    }
-                    // We need to check if we can generate another event, otherwise we might end up in a Deadlock,
-                    // since the TX Engine will not be able to set new retransmit timers
-                    else if (!rtTimer2eventEng_setEvent.full()) {
-                        currEntry.time = 0;
-                        currEntry.active = false;
-                        if (currEntry.retries < 4) {
-                            currEntry.retries++;
-                            rtTimer2eventEng_setEvent.write(event(currEntry.type, currID, currEntry.retries));
-                        } else {
-                            currEntry.retries = 0;
-                            rtTimer2stateTable_releaseState.write(currID);
-                            if (currEntry.type == SYN) {
-                                rtTimer2txApp_notification.write(openStatus(currID, false));
-                            } else {
-                                notification = appNotification(currID);
-                                notification.closed = true;
-                                rtTimer2rxApp_notification.write(notification); // TIME_OUT
-                            }
-                        }
-                    }
-                } // if active
-                break;
-        } // switch
-        // write entry back
-        retransmitTimerTable[currID] = currEntry;
-        rt_prevPosition = currID;
+        retransmitTimerTable[expiredID] = currEntry;
     }
 }
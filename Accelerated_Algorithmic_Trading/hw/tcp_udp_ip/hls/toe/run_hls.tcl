@@ -30,27 +30,29 @@ open_project toe_prj
 
 set_top toe
 
-add_files ack_delay/ack_delay.cpp
-add_files close_timer/close_timer.cpp
-add_files event_engine/event_engine.cpp
-add_files port_table/port_table.cpp
-add_files probe_timer/probe_timer.cpp
-add_files retransmit_timer/retransmit_timer.cpp
-add_files rx_app_if/rx_app_if.cpp
-add_files rx_app_stream_if/rx_app_stream_if.cpp
-add_files rx_engine/rx_engine.cpp -cflags -std=c++11
-add_files rx_sar_table/rx_sar_table.cpp
-add_files session_lookup_controller/session_lookup_controller.cpp
+set CFLAGS "-DTCP_STACK_MAX_SESSIONS=$::env(TCP_STACK_MAX_SESSIONS) -DTCP_STACK_WINDOW_SCALE_BITS=$::env(TCP_STACK_WINDOW_SCALE_BITS)"
+
+add_files ack_delay/ack_delay.cpp -cflags ${CFLAGS}
+add_files close_timer/close_timer.cpp -cflags ${CFLAGS}
+add_files event_engine/event_engine.cpp -cflags ${CFLAGS}
+add_files port_table/port_table.cpp -cflags ${CFLAGS}
+add_files probe_timer/probe_timer.cpp -cflags ${CFLAGS}
+add_files retransmit_timer/retransmit_timer.cpp -cflags ${CFLAGS}
+add_files rx_app_if/rx_app_if.cpp -cflags ${CFLAGS}
+add_files rx_app_stream_if/rx_app_stream_if.cpp -cflags ${CFLAGS}
+add_files rx_engine/rx_engine.cpp -cflags "-std=c++11 ${CFLAGS}"
+add_files rx_sar_table/rx_sar_table.cpp -cflags ${CFLAGS}
+add_files session_lookup_controller/session_lookup_controller.cpp -cflags ${CFLAGS}
 #add_files session_lookup_controller/session_lookup_controller/stub_session_lookup.cpp
-add_files state_table/state_table.cpp
-add_files tx_app_if/tx_app_if.cpp
-add_files tx_app_stream_if/tx_app_stream_if.cpp
-add_files tx_engine/tx_engine.cpp
-add_files tx_sar_table/tx_sar_table.cpp
-add_files tx_app_interface/tx_app_interface.cpp
-add_files ../axi_utils.cpp
-add_files toe.cpp
-add_files -tb toe_tb.cpp
+add_files state_table/state_table.cpp -cflags ${CFLAGS}
+add_files tx_app_if/tx_app_if.cpp -cflags ${CFLAGS}
+add_files tx_app_stream_if/tx_app_stream_if.cpp -cflags ${CFLAGS}
+add_files tx_engine/tx_engine.cpp -cflags ${CFLAGS}
+add_files tx_sar_table/tx_sar_table.cpp -cflags ${CFLAGS}
+add_files tx_app_interface/tx_app_interface.cpp -cflags ${CFLAGS}
+add_files ../axi_utils.cpp -cflags ${CFLAGS}
+add_files toe.cpp -cflags ${CFLAGS}
+add_files -tb toe_tb.cpp -cflags ${CFLAGS}
 
 open_solution "solution1"
 set_part $::env(XPART)
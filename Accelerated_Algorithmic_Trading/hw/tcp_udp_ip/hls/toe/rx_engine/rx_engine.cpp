@@ -558,6 +558,10 @@ void drop_optional_header_fields(hls::stream<optionalFieldsMeta>& metaIn,
  *   2  |     4B | MSS (Maximum segment size)
  *   3  |     3B | Window scale
  *   4  |     2B | SACK permitted (Selective Acknowledgment)
+ * The options are walked in bytes and parsing stops at the end of list, at the
+ * end of the options area or on a malformed length so a bad SYN cannot stall
+ * the FSM. The window scale is output as shift + 1 so that an advertised shift
+ * of 0 can be told apart from no option (0), the shift is clamped to 14 (RFC 7323)
  *
  *  @param[in]      metdataOffsetInaIn
  *  @param[in]      optionalHeaderFieldsIn
@@ -571,41 +575,43 @@ void parse_optional_header_fields(hls::stream<ap_uint<4> >& dataOffsetIn,
 
     enum fsmStateType { IDLE, PARSE };
     static fsmStateType state = IDLE;
-    static ap_uint<4> dataOffset;
+    static ap_uint<6> remainingBytes;
     static ap_uint<320> fields;
 
     switch (state) {
         case IDLE:
             if (!dataOffsetIn.empty() && !optionalHeaderFieldsIn.empty()) {
-                dataOffsetIn.read(dataOffset);
+                ap_uint<4> dataOffset = dataOffsetIn.read();
                 optionalHeaderFieldsIn.read(fields);
+                remainingBytes = dataOffset * 4;
                 state = PARSE;
             }
             break;
         case PARSE:
             ap_uint<8> optionKind = fields(7, 0);
             ap_uint<8> optionLength = fields(15, 8);
+            ap_uint<8> windowShift = fields(23, 16);
 
-            switch (optionKind) {
-                case 0: // End of option list
-                    windowScaleOut.write(0);
-                    state = IDLE;
-                    break;
-                case 1:
-                    optionLength = 1;
-                    break;
-                case 3:
-                    windowScaleOut.write(fields(19, 16));
-                    state = IDLE;
-                    break;
-                default:
-                    if (dataOffset == optionLength) {
-                        windowScaleOut.write(0);
-                        state = IDLE;
-                    }
-                    break;
-            } // switch
-            dataOffset -= optionLength;
+            if (optionKind == 1) {
+                optionLength = 1;
+            }
+
+            if (remainingBytes == 0 || optionKind == 0) {
+                // End of option list
+                windowScaleOut.write(0);
+                state = IDLE;
+            } else if (optionKind == 3 && optionLength == 3 && remainingBytes >= 3) {
+                if (windowShift > 14) {
+                    windowShift = 14;
+                }
+                windowScaleOut.write(windowShift(3, 0) + 1);
+                state = IDLE;
+            } else if (optionLength == 0 || optionLength >= remainingBytes) {
+                // Malformed or last option, no window scale present
+                windowScaleOut.write(0);
+                state = IDLE;
+            }
+            remainingBytes -= optionLength(5, 0);
             fields = (fields >> (optionLength * 8));
             break;
     } // switch
@@ -1007,7 +1013,7 @@ void rxTcpFSM(hls::stream<rxFsmMetaData>& fsmMetaDataFifo,
                                 SYN_SENT) { // Actually this is LISTEN || SYN_SENT but LISTEN has been merged in CLOSED
 #if (WINDOW_SCALE)
                             ap_uint<4> rx_win_shift = (fsm_meta.meta.winScale == 0) ? 0 : WINDOW_SCALE_BITS;
-                            ap_uint<4> tx_win_shift = fsm_meta.meta.winScale;
+                            ap_uint<4> tx_win_shift = (fsm_meta.meta.winScale == 0) ? 0 : fsm_meta.meta.winScale.to_uint() - 1;
                             // Initialize rxSar, SEQ + phantom byte
                             rxEng2rxSar_upd_req.write(
                                 rxSarRecvd(fsm_meta.sessionID, fsm_meta.meta.seqNumb + 1, rx_win_shift));
@@ -1062,7 +1068,7 @@ void rxTcpFSM(hls::stream<rxFsmMetaData>& fsmMetaDataFifo,
                         if ((tcpState == SYN_SENT) && (fsm_meta.meta.ackNumb == txSar.nextByte)) {
 #if (WINDOW_SCALE)
                             ap_uint<4> rx_win_shift = (fsm_meta.meta.winScale == 0) ? 0 : WINDOW_SCALE_BITS;
-                            ap_uint<4> tx_win_shift = fsm_meta.meta.winScale;
+                            ap_uint<4> tx_win_shift = (fsm_meta.meta.winScale == 0) ? 0 : fsm_meta.meta.winScale.to_uint() - 1;
                             rxEng2rxSar_upd_req.write(
                                 rxSarRecvd(fsm_meta.sessionID, fsm_meta.meta.seqNumb + 1, rx_win_shift));
                             rxEng2txSar_upd_req.write((rxTxSarQuery(fsm_meta.sessionID, fsm_meta.meta.ackNumb,
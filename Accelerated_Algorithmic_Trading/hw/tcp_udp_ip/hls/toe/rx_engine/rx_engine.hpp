@@ -59,7 +59,7 @@ struct rxEngineMetaData {
     ap_uint<32> seqNumb;
     ap_uint<32> ackNumb;
     ap_uint<16> winSize;
-    ap_uint<4> winScale;
+    ap_uint<4> winScale; // peer window shift + 1, 0 when no window scale option
     ap_uint<16> length;
     ap_uint<1> ack;
     ap_uint<1> rst;
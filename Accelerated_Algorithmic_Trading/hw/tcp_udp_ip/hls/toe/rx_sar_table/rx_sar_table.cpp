@@ -30,6 +30,7 @@
  * THE POSSIBILITY OF SUCH DAMAGE.
  */
 #include "rx_sar_table.hpp"
+#include "../session_table.hpp"
 
 
 /** @ingroup rx_sar_table
@@ -49,17 +50,14 @@ void rx_sar_table(hls::stream<rxSarRecvd>& rxEng2rxSar_upd_req,
                   hls::stream<rxSarEntry>& rxSar2rxEng_upd_rsp,
                   hls::stream<rxSarAppd>& rxSar2rxApp_upd_rsp,
                   hls::stream<rxSarReply>& rxSar2txEng_rsp) {
-    static rxSarEntry rx_table[MAX_SESSIONS];
+    static session_table<rxSarEntry, MAX_SESSIONS, SESSION_TABLE_CACHE> rx_table;
 
 	#pragma HLS PIPELINE II = 1
 
-	#pragma HLS RESOURCE variable = rx_table core = RAM_1P_BRAM
-	#pragma HLS DEPENDENCE variable = rx_table inter false
-
     // Read only access from the Tx Engine
     if (!txEng2rxSar_req.empty()) {
         ap_uint<16> addr = txEng2rxSar_req.read();
-        rxSarEntry entry = rx_table[addr];
+        rxSarEntry entry = rx_table.read(addr);
         rxSarReply reply(entry);
 
 // Pre-calculated usedLength, windowSize to improve timing in metaLoader
@@ -77,25 +75,29 @@ void rx_sar_table(hls::stream<rxSarRecvd>& rxEng2rxSar_upd_req,
     // Read or Write access from the Rx App I/F to update the application pointer
     else if (!rxApp2rxSar_upd_req.empty()) {
         rxSarAppd in_appd = rxApp2rxSar_upd_req.read();
+        rxSarEntry entry = rx_table.read(in_appd.sessionID);
         if (in_appd.write) {
-            rx_table[in_appd.sessionID].appd = in_appd.appd;
+            entry.appd = in_appd.appd;
+            rx_table.write(in_appd.sessionID, entry);
         } else {
-            rxSar2rxApp_upd_rsp.write(rxSarAppd(in_appd.sessionID, rx_table[in_appd.sessionID].appd));
+            rxSar2rxApp_upd_rsp.write(rxSarAppd(in_appd.sessionID, entry.appd));
         }
     }
     // Read or Write access from the Rx Engine
     else if (!rxEng2rxSar_upd_req.empty()) {
         rxSarRecvd in_recvd = rxEng2rxSar_upd_req.read();
+        rxSarEntry entry = rx_table.read(in_recvd.sessionID);
         if (in_recvd.write) {
-            rx_table[in_recvd.sessionID].recvd = in_recvd.recvd;
+            entry.recvd = in_recvd.recvd;
             if (in_recvd.init) {
-                rx_table[in_recvd.sessionID].appd = in_recvd.recvd;
+                entry.appd = in_recvd.recvd;
 #if (WINDOW_SCALE)
-                rx_table[in_recvd.sessionID].win_shift = in_recvd.win_shift;
+                entry.win_shift = in_recvd.win_shift;
 #endif
             }
+            rx_table.write(in_recvd.sessionID, entry);
         } else {
-            rxSar2rxEng_upd_rsp.write(rx_table[in_recvd.sessionID]);
+            rxSar2rxEng_upd_rsp.write(entry);
         }
     }
 }
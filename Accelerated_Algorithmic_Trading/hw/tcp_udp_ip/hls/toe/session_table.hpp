@@ -0,0 +1,102 @@
+/************************************************
+ * Copyright (c) 2016, 2020 Xilinx, Inc.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY
+ * WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ ************************************************/
+#pragma once
+
+#include "toe_config.hpp"
+#include "../axi_utils.hpp"
+
+/**
+ * Per session table used by the state and SAR tables.
+ *
+ * With TCP_STACK_URAM_TABLES the table is mapped to URAM, which has a longer
+ * read latency than BRAM. As in UramArray (uram_datamover/uram_array.hpp) the
+ * last NUM_CACHE writes are held in registers and forwarded to reads of the
+ * same session, so read-modify-write accesses from consecutive requests do
+ * not stall the II=1 pipeline.
+ */
+template <typename T, int NUM_ENTRIES, int NUM_CACHE>
+class session_table {
+  public:
+    session_table() {
+#pragma HLS INLINE
+// clang-format off
+#if (TCP_STACK_URAM_TABLES)
+        #pragma HLS RESOURCE variable = table core = RAM_2P_URAM
+#else
+        #pragma HLS RESOURCE variable = table core = RAM_2P_BRAM
+#endif
+        #pragma HLS DATA_PACK variable = table
+        #pragma HLS DEPENDENCE variable = table inter false
+        #pragma HLS ARRAY_PARTITION variable = cacheIndex complete dim = 1
+        #pragma HLS ARRAY_PARTITION variable = cacheValid complete dim = 1
+        #pragma HLS ARRAY_PARTITION variable = cacheEntry complete dim = 1
+        // clang-format on
+        for (int i = 0; i < NUM_CACHE; i++) {
+#pragma HLS UNROLL
+            cacheValid[i] = false;
+        }
+    }
+
+    T read(ap_uint<16> index) {
+#pragma HLS INLINE
+        T entry = table[index];
+        // most recent write wins
+        for (int i = NUM_CACHE - 1; i >= 0; i--) {
+#pragma HLS UNROLL
+            if (cacheValid[i] && (cacheIndex[i] == index)) {
+                entry = cacheEntry[i];
+            }
+        }
+        return entry;
+    }
+
+    void write(ap_uint<16> index, const T& entry) {
+#pragma HLS INLINE
+        table[index] = entry;
+        for (int i = NUM_CACHE - 1; i >= 1; i--) {
+#pragma HLS UNROLL
+            cacheIndex[i] = cacheIndex[i - 1];
+            cacheEntry[i] = cacheEntry[i - 1];
+            cacheValid[i] = cacheValid[i - 1];
+        }
+        cacheIndex[0] = index;
+        cacheEntry[0] = entry;
+        cacheValid[0] = true;
+    }
+
+  private:
+    T table[NUM_ENTRIES];
+    ap_uint<16> cacheIndex[NUM_CACHE];
+    T cacheEntry[NUM_CACHE];
+    bool cacheValid[NUM_CACHE];
+};
@@ -32,6 +32,7 @@
  ************************************************/
 
 #include "state_table.hpp"
+#include "../session_table.hpp"
 
 /** @ingroup state_table
  *
@@ -72,11 +73,7 @@ void state_table(hls::stream<stateQuery>& rxEng2stateTable_upd_req,
                  uint32_t& stats_tcpPassiveOpens) {
 #pragma HLS PIPELINE II = 1
 
-    static sessionState state_table[MAX_SESSIONS];
-// clang-format off
-    #pragma HLS RESOURCE variable = state_table core = RAM_2P_BRAM
-    #pragma HLS DEPENDENCE variable = state_table inter false
-    // clang-format on
+    static session_table<sessionState, MAX_SESSIONS, SESSION_TABLE_CACHE> state_table;
 
     static ap_uint<16> stt_txSessionID;
     static ap_uint<16> stt_rxSessionID;
@@ -103,13 +100,13 @@ void state_table(hls::stream<stateQuery>& rxEng2stateTable_upd_req,
             stt_txWait = true;
         } else {
             if (stt_txAccess.write) {
-                state_table[stt_txAccess.sessionID] = stt_txAccess.state;
+                state_table.write(stt_txAccess.sessionID, stt_txAccess.state);
                 stt_txSessionLocked = false;
                 if (stt_txAccess.state == SYN_SENT) {
                     cnt_tcpActiveOpens++;
                 }
             } else {
-                stateTable2TxApp_upd_rsp.write(state_table[stt_txAccess.sessionID]);
+                stateTable2TxApp_upd_rsp.write(state_table.read(stt_txAccess.sessionID));
                 // lock on every read
                 stt_txSessionID = stt_txAccess.sessionID;
                 stt_txSessionLocked = true;
@@ -120,7 +117,7 @@ void state_table(hls::stream<stateQuery>& rxEng2stateTable_upd_req,
     else if (!txApp2stateTable_req.empty()) {
         txApp2stateTable_req.read(sessionID);
         if (sessionID < MAX_SESSIONS) {
-            stateTable2txApp_rsp.write(state_table[sessionID]);
+            stateTable2txApp_rsp.write(state_table.read(sessionID));
         } else {
             stateTable2txApp_rsp.write(CLOSED);
         }
@@ -140,10 +137,10 @@ void state_table(hls::stream<stateQuery>& rxEng2stateTable_upd_req,
                 } else if (stt_rxAccess.state == SYN_RECEIVED) {
                     cnt_tcpPassiveOpens++;
                 }
-                state_table[stt_rxAccess.sessionID] = stt_rxAccess.state;
+                state_table.write(stt_rxAccess.sessionID, stt_rxAccess.state);
                 stt_rxSessionLocked = false;
             } else {
-                stateTable2rxEng_upd_rsp.write(state_table[stt_rxAccess.sessionID]);
+                stateTable2rxEng_upd_rsp.write(state_table.read(stt_rxAccess.sessionID));
                 stt_rxSessionID = stt_rxAccess.sessionID;
                 stt_rxSessionLocked = true;
             }
@@ -158,19 +155,19 @@ void state_table(hls::stream<stateQuery>& rxEng2stateTable_upd_req,
             ((stt_closeSessionID == stt_txSessionID) && stt_txSessionLocked)) {
             stt_closeWait = true;
         } else {
-            state_table[stt_closeSessionID] = CLOSED;
+            state_table.write(stt_closeSessionID, CLOSED);
             stateTable2sLookup_releaseSession.write(stt_closeSessionID);
         }
     } else if (stt_txWait) {
         if ((stt_txAccess.sessionID != stt_rxSessionID) || !stt_rxSessionLocked) {
             if (stt_txAccess.write) {
-                state_table[stt_txAccess.sessionID] = stt_txAccess.state;
+                state_table.write(stt_txAccess.sessionID, stt_txAccess.state);
                 stt_txSessionLocked = false;
                 if (stt_txAccess.state == SYN_SENT) {
                     cnt_tcpActiveOpens++;
                 }
             } else {
-                stateTable2TxApp_upd_rsp.write(state_table[stt_txAccess.sessionID]);
+                stateTable2TxApp_upd_rsp.write(state_table.read(stt_txAccess.sessionID));
                 stt_txSessionID = stt_txAccess.sessionID;
                 stt_txSessionLocked = true;
             }
@@ -184,11 +181,11 @@ void state_table(hls::stream<stateQuery>& rxEng2stateTable_upd_req,
                 } else if (stt_rxAccess.state == SYN_RECEIVED) {
                     cnt_tcpPassiveOpens++;
                 }
-                state_table[stt_rxAccess.sessionID] = stt_rxAccess.state;
+                state_table.write(stt_rxAccess.sessionID, stt_rxAccess.state);
                 stt_rxSessionLocked = false;
 
             } else {
-                stateTable2rxEng_upd_rsp.write(state_table[stt_rxAccess.sessionID]);
+                stateTable2rxEng_upd_rsp.write(state_table.read(stt_rxAccess.sessionID));
                 stt_rxSessionID = stt_rxAccess.sessionID;
                 stt_rxSessionLocked = true;
             }
@@ -197,7 +194,7 @@ void state_table(hls::stream<stateQuery>& rxEng2stateTable_upd_req,
     } else if (stt_closeWait) {
         if (((stt_closeSessionID != stt_rxSessionID) || !stt_rxSessionLocked) &&
             ((stt_closeSessionID != stt_txSessionID) || !stt_txSessionLocked)) {
-            state_table[stt_closeSessionID] = CLOSED;
+            state_table.write(stt_closeSessionID, CLOSED);
             stateTable2sLookup_releaseSession.write(stt_closeSessionID);
             stt_closeWait = false;
         }
@@ -0,0 +1,85 @@
+# Copyright (c) 2019 Xilinx, Inc.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are 
+# met:
+#
+# 1. Redistributions of source code must retain the above copyright notice,
+#    this list of conditions and the following disclaimer.
+#
+# 2. Redistributions in binary form must reproduce the above copyright
+#    notice, this list of conditions and the following disclaimer in the
+#    documentation and/or other materials provided with the distribution.
+#
+# 3. Neither the name of the copyright holder nor the names of its
+#    contributors may be used to endorse or promote products derived from this
+#    software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+# AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE#
+# IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+# ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+# LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+# CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+# SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+# INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+# CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+# ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+# THE POSSIBILITY OF SUCH DAMAGE.
+
+source settings.tcl
+
+set PROJ "prj"
+set SOLN "sol"
+set CLKP 300MHz
+set CASE_ROOT [pwd]
+set KERNEL_ROOT "${CASE_ROOT}/../"
+set TCP_ROOT "${KERNEL_ROOT}/.."
+# longer C-sim timer tick so the retransmit time-out covers the loopback round trip
+set CFLAGS "-I${KERNEL_ROOT} -std=c++14 -DTOE_CSIM_TIMER_TICK_CYCLES=512"
+
+open_project -reset $PROJ
+
+add_files "${KERNEL_ROOT}/ack_delay/ack_delay.cpp" -cflags ${CFLAGS}
+add_files "${KERNEL_ROOT}/close_timer/close_timer.cpp" -cflags ${CFLAGS}
+add_files "${KERNEL_ROOT}/event_engine/event_engine.cpp" -cflags ${CFLAGS}
+add_files "${KERNEL_ROOT}/port_table/port_table.cpp" -cflags ${CFLAGS}
+add_files "${KERNEL_ROOT}/probe_timer/probe_timer.cpp" -cflags ${CFLAGS}
+add_files "${KERNEL_ROOT}/retransmit_timer/retransmit_timer.cpp" -cflags ${CFLAGS}
+add_files "${KERNEL_ROOT}/rx_app_if/rx_app_if.cpp" -cflags ${CFLAGS}
+add_files "${KERNEL_ROOT}/rx_app_stream_if/rx_app_stream_if.cpp" -cflags ${CFLAGS}
+add_files "${KERNEL_ROOT}/rx_engine/rx_engine.cpp" -cflags ${CFLAGS}
+add_files "${KERNEL_ROOT}/rx_sar_table/rx_sar_table.cpp" -cflags ${CFLAGS}
+add_files "${KERNEL_ROOT}/session_lookup_controller/session_lookup_controller.cpp" -cflags ${CFLAGS}
+add_files "${KERNEL_ROOT}/state_table/state_table.cpp" -cflags ${CFLAGS}
+add_files "${KERNEL_ROOT}/tx_app_if/tx_app_if.cpp" -cflags ${CFLAGS}
+add_files "${KERNEL_ROOT}/tx_app_stream_if/tx_app_stream_if.cpp" -cflags ${CFLAGS}
+add_files "${KERNEL_ROOT}/tx_engine/tx_engine.cpp" -cflags ${CFLAGS}
+add_files "${KERNEL_ROOT}/tx_sar_table/tx_sar_table.cpp" -cflags ${CFLAGS}
+add_files "${KERNEL_ROOT}/tx_app_interface/tx_app_interface.cpp" -cflags ${CFLAGS}
+add_files "${TCP_ROOT}/axi_utils.cpp" -cflags ${CFLAGS}
+add_files "${KERNEL_ROOT}/toe.cpp" -cflags ${CFLAGS}
+add_files -tb "${TCP_ROOT}/hash_table/hash_table.cpp" -cflags ${CFLAGS}
+add_files -tb "${TCP_ROOT}/uram_datamover/uram_datamover.cpp" -cflags ${CFLAGS}
+add_files -tb "tb_toe_loopback.cpp" -cflags ${CFLAGS}
+
+set_top toe
+
+open_solution -reset $SOLN -flow_target vitis
+
+set_part $XPART
+create_clock -period $CLKP -name default
+
+if {$CSIM == 1} {
+  csim_design
+}
+
+if {$CSYNTH == 1} {
+  csynth_design
+}
+
+if {$COSIM == 1} {
+  cosim_design
+}
+
+exit
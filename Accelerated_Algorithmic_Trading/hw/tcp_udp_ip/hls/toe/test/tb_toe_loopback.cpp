@@ -0,0 +1,331 @@
+/************************************************
+ * Copyright (c) 2016, 2020 Xilinx, Inc.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY
+ * WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ ************************************************/
+
+#include <cstdlib>
+#include <deque>
+#include <iomanip>
+#include <iostream>
+
+#include "toe_config.hpp"
+#include "toe.hpp"
+
+/*
+ * Self loopback throughput test. The TOE opens a connection to its own
+ * listening port, every segment on ipTxData is returned on ipRxData after
+ * LB_WIRE_DELAY cycles so the round trip holds more than 64KB at line rate.
+ * The session lookup and TX buffer are the hash_table and uram_datamover
+ * kernels, the RX path uses the DDR bypass FIFO.
+ */
+
+#define LB_WIRE_DELAY (12000)
+#define LB_TRANSFER_BYTES (2 * 1024 * 1024)
+#define LB_MAX_CYCLES (4000000)
+#define LB_RX_FIFO_DEPTH (4096)
+#define LB_LISTEN_PORT (5001)
+#define LB_HOST_IP (0x0A01D4D1)
+
+void hash_table(hls::stream<ap_axiu<128, 0, 0, 0> >& s_axis_lup_req,
+                hls::stream<ap_axiu<128, 0, 0, 0> >& s_axis_upd_req,
+                hls::stream<ap_axiu<128, 0, 0, 0> >& m_axis_lup_rsp,
+                hls::stream<ap_axiu<128, 0, 0, 0> >& m_axis_upd_rsp,
+                ap_uint<16>& regInsertFailureCount);
+
+void uram_datamover(hls::stream<ap_axiu<128, 0, 0, 0> >& cmdRead,
+                    hls::stream<ap_axiu<128, 0, 0, 0> >& cmdWrite,
+                    hls::stream<ap_axiu<64, 0, 0, 0> >& dataIn,
+                    hls::stream<ap_axiu<8, 0, 0, 0> >& writeStatus,
+                    hls::stream<ap_axiu<64, 0, 0, 0> >& dataOut);
+
+typedef ap_axiu<DATA_WIDTH, 0, 0, 0> lbWord;
+
+struct lbWireWord {
+    long cycle;
+    lbWord word;
+};
+
+static hls::stream<lbWord> ipRxData("ipRxData");
+static hls::stream<lbWord> ipTxData("ipTxData");
+static hls::stream<ap_axiu<8, 0, 0, 0> > txBufferWriteStatus("txBufferWriteStatus");
+static hls::stream<lbWord> rxBufferData("rxBufferData");
+static hls::stream<lbWord> txBufferReadData("txBufferReadData");
+static hls::stream<ap_axiu<128, 0, 0, 0> > txBufferWriteCmd("txBufferWriteCmd");
+static hls::stream<ap_axiu<128, 0, 0, 0> > txBufferReadCmd("txBufferReadCmd");
+static hls::stream<lbWord> txBufferWriteData("txBufferWriteData");
+static hls::stream<ap_axiu<128, 0, 0, 0> > memWriteCmd("memWriteCmd");
+static hls::stream<lbWord> memWriteData("memWriteData");
+static hls::stream<ap_axiu<128, 0, 0, 0> > sessionLookup_rsp("sessionLookup_rsp");
+static hls::stream<ap_axiu<128, 0, 0, 0> > sessionUpdate_rsp("sessionUpdate_rsp");
+static hls::stream<ap_axiu<128, 0, 0, 0> > sessionLookup_req("sessionLookup_req");
+static hls::stream<ap_axiu<128, 0, 0, 0> > sessionUpdate_req("sessionUpdate_req");
+static hls::stream<ap_axiu<16, 0, 0, 0> > listenPortReq("listenPortReq");
+static hls::stream<ap_axiu<32, 0, 0, 0> > rxDataReq("rxDataReq");
+static hls::stream<ap_axiu<64, 0, 0, 0> > openConnReq("openConnReq");
+static hls::stream<ap_axiu<16, 0, 0, 0> > closeConnReq("closeConnReq");
+static hls::stream<ap_axiu<64, 0, 0, 0> > txDataReqMeta("txDataReqMeta");
+static hls::stream<lbWord> txDataReq("txDataReq");
+static hls::stream<ap_axiu<8, 0, 0, 0> > listenPortRsp("listenPortRsp");
+static hls::stream<ap_axiu<128, 0, 0, 0> > notification("notification");
+static hls::stream<ap_axiu<16, 0, 0, 0> > rxDataRspMeta("rxDataRspMeta");
+static hls::stream<lbWord> rxDataRsp("rxDataRsp");
+static hls::stream<ap_axiu<32, 0, 0, 0> > openConnRsp("openConnRsp");
+static hls::stream<ap_axiu<64, 0, 0, 0> > txDataRsp("txDataRsp");
+
+static uint32_t tcpInSegs, tcpInErrs, tcpOutSegs, tcpRetransSegs, tcpActiveOpens;
+static uint32_t tcpPassiveOpens, tcpAttemptFails, tcpEstabResets, tcpCurrEstab;
+static ap_uint<16> regInsertFailureCount;
+
+static std::deque<lbWireWord> wire;
+static std::deque<lbWord> txBufferBurst;
+static int txBufferBurstCount = 0;
+
+static ap_uint<8> patternByte(uint64_t offset) {
+    return (offset * 7 + (offset >> 11)) & 0xFF;
+}
+
+/*
+ * Advance the TOE, its lookup and memory kernels and the wire by one cycle
+ */
+static void loopbackCall(long cycle) {
+    toe(ipRxData, txBufferWriteStatus, rxBufferData, txBufferReadData, ipTxData, txBufferWriteCmd, txBufferReadCmd,
+        rxBufferData, txBufferWriteData, sessionLookup_rsp, sessionUpdate_rsp, sessionLookup_req, sessionUpdate_req,
+        listenPortReq, rxDataReq, openConnReq, closeConnReq, txDataReqMeta, txDataReq, listenPortRsp, notification,
+        rxDataRspMeta, rxDataRsp, openConnRsp, txDataRsp, rxBufferData.size(), LB_RX_FIFO_DEPTH,
+        reverse(ap_uint<32>(LB_HOST_IP)), tcpInSegs, tcpInErrs, tcpOutSegs, tcpRetransSegs, tcpActiveOpens,
+        tcpPassiveOpens, tcpAttemptFails, tcpEstabResets, tcpCurrEstab);
+
+    hash_table(sessionLookup_req, sessionUpdate_req, sessionLookup_rsp, sessionUpdate_rsp, regInsertFailureCount);
+
+    // the datamover reads a whole write burst per call, hand over a command
+    // only once all of its data has been pushed by the TOE
+    while (!txBufferWriteData.empty()) {
+        lbWord w = txBufferWriteData.read();
+        txBufferBurst.push_back(w);
+        txBufferBurstCount += w.last;
+    }
+    if (memWriteCmd.empty() && !txBufferWriteCmd.empty() && (txBufferBurstCount > 0)) {
+        memWriteCmd.write(txBufferWriteCmd.read());
+        bool last = false;
+        while (!last) {
+            last = txBufferBurst.front().last;
+            memWriteData.write(txBufferBurst.front());
+            txBufferBurst.pop_front();
+        }
+        txBufferBurstCount--;
+    }
+
+    uram_datamover(txBufferReadCmd, memWriteCmd, memWriteData, txBufferWriteStatus, txBufferReadData);
+
+    while (!ipTxData.empty()) {
+        lbWireWord w;
+        w.cycle = cycle + LB_WIRE_DELAY;
+        w.word = ipTxData.read();
+        wire.push_back(w);
+    }
+    if (!wire.empty() && wire.front().cycle <= cycle) {
+        ipRxData.write(wire.front().word);
+        wire.pop_front();
+    }
+}
+
+int main() {
+    ap_axiu<16, 0, 0, 0> listenReq;
+    ap_axiu<64, 0, 0, 0> openReq;
+    ap_axiu<64, 0, 0, 0> txMeta;
+    ap_axiu<32, 0, 0, 0> rxReq;
+    lbWord txWord;
+    lbWord rxWord;
+
+    long cycle = 0;
+    bool listening = false;
+    bool opened = false;
+    bool txPending = false;
+    uint16_t txSession = 0;
+    uint16_t txLength = 0;
+    uint64_t txBytes = 0;
+    uint64_t rxBytes = 0;
+    uint64_t maxInFlight = 0;
+    uint64_t errors = 0;
+    long startCycle = 0;
+    long endCycle = 0;
+    bool testPassed = true;
+
+    std::cout << "TOE Loopback Test" << std::endl;
+    std::cout << "-----------------" << std::endl;
+    std::cout << "WINDOW_SCALE_BITS=" << WINDOW_SCALE_BITS << " BUFFER_SIZE=" << BUFFER_SIZE
+              << " WIRE_DELAY=" << LB_WIRE_DELAY << std::endl;
+
+    listenReq.data = LB_LISTEN_PORT;
+    listenReq.keep = 0x3;
+    listenReq.last = 1;
+    listenPortReq.write(listenReq);
+
+    for (cycle = 0; (cycle < LB_MAX_CYCLES) && (rxBytes < LB_TRANSFER_BYTES); cycle++) {
+        loopbackCall(cycle);
+
+        if (!listenPortRsp.empty()) {
+            listening = (listenPortRsp.read().data != 0);
+            if (!listening) {
+                std::cout << "ERROR: listen port request failed" << std::endl;
+                return 1;
+            }
+            openReq.data(31, 0) = LB_HOST_IP;
+            openReq.data(47, 32) = LB_LISTEN_PORT;
+            openReq.data(63, 48) = 0;
+            openReq.keep = 0xFF;
+            openReq.last = 1;
+            openConnReq.write(openReq);
+        }
+
+        if (!openConnRsp.empty()) {
+            ap_axiu<32, 0, 0, 0> rsp = openConnRsp.read();
+            txSession = rsp.data(15, 0);
+            opened = (rsp.data(23, 16) != 0);
+            if (!opened) {
+                std::cout << "ERROR: open connection request failed" << std::endl;
+                return 1;
+            }
+            startCycle = cycle;
+        }
+
+        // sender, one MSS sized write at a time, retried while the window is full
+        if (opened && !txPending && (txBytes < LB_TRANSFER_BYTES)) {
+            txLength = ((LB_TRANSFER_BYTES - txBytes) < MSS) ? (uint16_t)(LB_TRANSFER_BYTES - txBytes) : MSS;
+            txMeta.data = 0;
+            txMeta.data(15, 0) = txSession;
+            txMeta.data(31, 16) = txLength;
+            txMeta.keep = 0xFF;
+            txMeta.last = 1;
+            txDataReqMeta.write(txMeta);
+            txPending = true;
+        }
+
+        if (!txDataRsp.empty()) {
+            ap_axiu<64, 0, 0, 0> rsp = txDataRsp.read();
+            txPending = false;
+            if (rsp.data(63, 62) == 0) {
+                for (int i = 0; i < txLength; i += (DATA_WIDTH / 8)) {
+                    txWord.data = 0;
+                    txWord.keep = 0;
+                    for (int j = 0; (j < (DATA_WIDTH / 8)) && ((i + j) < txLength); j++) {
+                        txWord.data(j * 8 + 7, j * 8) = patternByte(txBytes + i + j);
+                        txWord.keep[j] = 1;
+                    }
+                    txWord.last = ((i + (DATA_WIDTH / 8)) >= txLength);
+                    txDataReq.write(txWord);
+                }
+                txBytes += txLength;
+            }
+        }
+
+        // receiver, reads every notified segment and checks the byte pattern
+        if (!notification.empty()) {
+            ap_axiu<128, 0, 0, 0> notif = notification.read();
+            if (notif.data(31, 16) != 0) {
+                rxReq.data(15, 0) = notif.data(15, 0);
+                rxReq.data(31, 16) = notif.data(31, 16);
+                rxReq.keep = 0xF;
+                rxReq.last = 1;
+                rxDataReq.write(rxReq);
+            }
+        }
+
+        if (!rxDataRspMeta.empty()) {
+            rxDataRspMeta.read();
+        }
+
+        while (!rxDataRsp.empty()) {
+            rxWord = rxDataRsp.read();
+            for (int j = 0; j < (DATA_WIDTH / 8); j++) {
+                if (rxWord.keep[j]) {
+                    if (rxWord.data(j * 8 + 7, j * 8) != patternByte(rxBytes)) {
+                        errors++;
+                    }
+                    rxBytes++;
+                }
+            }
+        }
+
+        if ((txBytes - rxBytes) > maxInFlight) {
+            maxInFlight = txBytes - rxBytes;
+        }
+    }
+    endCycle = cycle;
+
+    // a 64KB window can move at most one window per round trip
+    double roundTrip = 2.0 * LB_WIRE_DELAY;
+    double bytesPerCycle = (double)rxBytes / (double)(endCycle - startCycle);
+    double unscaledBytesPerCycle = 65535.0 / roundTrip;
+
+    std::cout << "--" << std::endl;
+    std::cout << "STATUS: ";
+    std::cout << "TX_BYTES=" << txBytes << " ";
+    std::cout << "RX_BYTES=" << rxBytes << " ";
+    std::cout << "CYCLES=" << (endCycle - startCycle) << " ";
+    std::cout << "MAX_IN_FLIGHT=" << maxInFlight << " ";
+    std::cout << "TCP_OUT_SEGS=" << tcpOutSegs << " ";
+    std::cout << "TCP_RETRANS_SEGS=" << tcpRetransSegs << " ";
+    std::cout << std::endl;
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << "THROUGHPUT: " << bytesPerCycle << " B/cycle, 64KB window bound " << unscaledBytesPerCycle
+              << " B/cycle, line rate " << (DATA_WIDTH / 8) << " B/cycle" << std::endl;
+    std::cout << std::endl;
+
+    if (rxBytes != LB_TRANSFER_BYTES) {
+        std::cout << "ERROR: transfer incomplete" << std::endl;
+        testPassed = false;
+    }
+
+    if (errors != 0) {
+        std::cout << "ERROR: " << errors << " corrupted bytes" << std::endl;
+        testPassed = false;
+    }
+
+    if (maxInFlight <= 65535) {
+        std::cout << "ERROR: bytes in flight never exceeded a 64KB window" << std::endl;
+        testPassed = false;
+    }
+
+    if (bytesPerCycle < (1.5 * unscaledBytesPerCycle)) {
+        std::cout << "ERROR: throughput not above the 64KB window bound" << std::endl;
+        testPassed = false;
+    }
+
+    if (!testPassed) {
+        std::cout << "FAIL!" << std::endl;
+        return 1;
+    }
+
+    std::cout << "Done!" << std::endl;
+
+    return 0;
+}
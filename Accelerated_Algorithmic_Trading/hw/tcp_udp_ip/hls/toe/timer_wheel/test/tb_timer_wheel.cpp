@@ -0,0 +1,223 @@
+/************************************************
+ * Copyright (c) 2016, 2020 Xilinx, Inc.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY
+ * WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ ************************************************/
+
+#include <iomanip>
+#include <iostream>
+#include <random>
+
+#include "timer_wheel.hpp"
+
+/*
+ * Retransmit-fire accuracy benchmark, compares the timer wheel against the
+ * per-session sweep it replaced. Both models see the same operation stream:
+ * a few probe sessions re-armed with a fixed time-out as soon as they fire,
+ * plus background restarts of the remaining sessions which take the
+ * operation slot as ACK traffic does in the TOE.
+ */
+
+#define BENCH_CYCLES (4000000)
+#define BENCH_PROBES (4)
+#define BENCH_LOAD (0.25)
+#define BENCH_TIMEOUT_US (200.0)
+#define BENCH_CYCLE_US (0.0033)
+
+#define BENCH_TICK_CYCLES (64)
+
+/*
+ * Model of the previous timers, one session visited per idle cycle with the
+ * time-out expressed in visits
+ */
+template <int NUM_TIMERS>
+class legacy_sweep {
+  public:
+    legacy_sweep() : position(0) {
+        for (int i = 0; i < NUM_TIMERS; i++) {
+            active[i] = false;
+        }
+    }
+
+    bool step(timerWheelOp op, int id, unsigned interval, int& expiredID) {
+        bool expired = false;
+
+        if (op == TW_ARM) {
+            time[id] = interval;
+            active[id] = true;
+        } else if (op == TW_CANCEL) {
+            active[id] = false;
+        } else {
+            if (active[position]) {
+                if (time[position] > 0) {
+                    time[position]--;
+                } else {
+                    active[position] = false;
+                    expiredID = position;
+                    expired = true;
+                }
+            }
+            position = (position + 1) % NUM_TIMERS;
+        }
+        return expired;
+    }
+
+  private:
+    unsigned time[NUM_TIMERS];
+    bool active[NUM_TIMERS];
+    int position;
+};
+
+struct benchResult {
+    unsigned samples;
+    double meanErrorUs;
+    double maxErrorUs;
+};
+
+template <int NUM_TIMERS, class MODEL, class ID>
+static benchResult benchRun(MODEL& model, unsigned interval) {
+    std::mt19937 rng(NUM_TIMERS);
+    std::uniform_real_distribution<double> load(0.0, 1.0);
+    std::uniform_int_distribution<int> background(BENCH_PROBES, NUM_TIMERS - 1);
+    std::uniform_int_distribution<int> delay(0, 4 * BENCH_TICK_CYCLES);
+
+    const double timeoutCycles = BENCH_TIMEOUT_US / BENCH_CYCLE_US;
+    long armCycle[BENCH_PROBES];
+    long rearmCycle[BENCH_PROBES];
+    benchResult result = {0, 0.0, 0.0};
+    double sumError = 0.0;
+
+    for (int i = 0; i < BENCH_PROBES; i++) {
+        rearmCycle[i] = i;
+    }
+
+    for (long cycle = 0; cycle < BENCH_CYCLES; cycle++) {
+        timerWheelOp op = TW_SWEEP;
+        int id = 0;
+        unsigned opInterval = interval;
+        ID expiredID;
+
+        for (int i = 0; i < BENCH_PROBES; i++) {
+            if ((rearmCycle[i] >= 0) && (rearmCycle[i] <= cycle)) {
+                op = TW_ARM;
+                id = i;
+                rearmCycle[i] = -1;
+                armCycle[i] = cycle;
+                break;
+            }
+        }
+
+        if ((op == TW_SWEEP) && (load(rng) < BENCH_LOAD)) {
+            // restart of a live session, never due within the run
+            op = TW_ARM;
+            id = background(rng);
+            opInterval = interval * 1000;
+        }
+
+        if (model.step(op, id, opInterval, expiredID) && (expiredID < BENCH_PROBES)) {
+            double errorUs = ((cycle - armCycle[expiredID]) - timeoutCycles) * BENCH_CYCLE_US;
+            if (errorUs < 0) {
+                errorUs = -errorUs;
+            }
+            sumError += errorUs;
+            if (errorUs > result.maxErrorUs) {
+                result.maxErrorUs = errorUs;
+            }
+            result.samples++;
+            // re-arm off the tick boundary the expiry was aligned to
+            rearmCycle[(int)expiredID] = cycle + 1 + delay(rng);
+        }
+    }
+
+    if (result.samples) {
+        result.meanErrorUs = sumError / result.samples;
+    }
+    return result;
+}
+
+template <int NUM_TIMERS>
+class wheel_adapter {
+  public:
+    bool step(timerWheelOp op, int id, unsigned interval, ap_uint<16>& expiredID) {
+        return wheel.step(op, id, interval, true, expiredID);
+    }
+
+  private:
+    timer_wheel<NUM_TIMERS, TIMER_WHEEL_SLOTS, TIMER_WHEEL_HORIZON, BENCH_TICK_CYCLES> wheel;
+};
+
+static void benchReport(int numTimers, const char* name, benchResult& result) {
+    std::cout << std::setw(8) << numTimers << " " << std::setw(8) << name << " " << std::setw(8) << result.samples
+              << " " << std::setw(12) << std::fixed << std::setprecision(3) << result.meanErrorUs << " "
+              << std::setw(12) << result.maxErrorUs << std::endl;
+}
+
+template <int NUM_TIMERS>
+static bool benchSessions() {
+    static legacy_sweep<NUM_TIMERS> legacy;
+    static wheel_adapter<NUM_TIMERS> wheel;
+
+    unsigned legacyInterval = (BENCH_TIMEOUT_US / BENCH_CYCLE_US / NUM_TIMERS) + 1;
+    unsigned wheelInterval = (BENCH_TIMEOUT_US / BENCH_CYCLE_US / BENCH_TICK_CYCLES) + 1;
+
+    benchResult legacyResult = benchRun<NUM_TIMERS, legacy_sweep<NUM_TIMERS>, int>(legacy, legacyInterval);
+    benchResult wheelResult = benchRun<NUM_TIMERS, wheel_adapter<NUM_TIMERS>, ap_uint<16> >(wheel, wheelInterval);
+
+    benchReport(NUM_TIMERS, "sweep", legacyResult);
+    benchReport(NUM_TIMERS, "wheel", wheelResult);
+
+    // one tick of quantisation plus the interval rounding
+    return (wheelResult.samples > 0) && (wheelResult.maxErrorUs < (2 * BENCH_TICK_CYCLES * BENCH_CYCLE_US));
+}
+
+int main() {
+    bool testPassed = true;
+
+    std::cout << "TimerWheel Benchmark" << std::endl;
+    std::cout << "--------------------" << std::endl;
+    std::cout << "time-out " << BENCH_TIMEOUT_US << "us, load " << BENCH_LOAD << ", " << BENCH_CYCLES << " cycles"
+              << std::endl;
+    std::cout << "sessions    model  samples  mean err us   max err us" << std::endl;
+
+    testPassed &= benchSessions<32>();
+    testPassed &= benchSessions<256>();
+    testPassed &= benchSessions<1024>();
+
+    std::cout << std::endl;
+
+    if (!testPassed) {
+        std::cout << "FAIL!" << std::endl;
+        return 1;
+    }
+
+    std::cout << "Done!" << std::endl;
+
+    return 0;
+}
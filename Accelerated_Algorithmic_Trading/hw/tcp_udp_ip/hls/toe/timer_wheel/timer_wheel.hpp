@@ -0,0 +1,189 @@
+/************************************************
+ * Copyright (c) 2016, 2020 Xilinx, Inc.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY
+ * WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ ************************************************/
+#pragma once
+
+#include "../toe_internals.hpp"
+
+/** @defgroup timer_wheel Timer Wheel
+ *  @ingroup timer
+ *
+ */
+
+enum timerWheelOp { TW_SWEEP, TW_ARM, TW_CANCEL };
+
+/** @ingroup timer_wheel
+ *
+ * Single entry in the timer wheel table, entries due in the same slot are
+ * chained through next.
+ */
+struct timerWheelEntry {
+    ap_uint<32> deadline;
+    ap_uint<16> next;
+    bool nextValid;
+    bool active;
+    bool linked;
+};
+
+/** @ingroup timer_wheel
+ *
+ * Head of the chain of entries due in a slot.
+ */
+struct timerWheelSlot {
+    ap_uint<16> head;
+    bool valid;
+};
+
+/** @ingroup timer_wheel
+ *
+ * Hashed timer wheel shared by the @ref retransmit_timer, @ref probe_timer
+ * and @ref close_timer.
+ *
+ * Deadlines are absolute, taken from a free running tick counter advanced
+ * every TICK_CYCLES calls, so the expiry precision is one tick regardless
+ * of NUM_TIMERS. An armed entry is chained into the slot of its deadline,
+ * deadlines further than HORIZON ticks away are chained HORIZON ticks ahead
+ * and re-chained when that slot is swept. Cancel and re-arm are lazy: the
+ * chained entry is checked against its current deadline when its slot is
+ * swept, re-arming to an earlier deadline while chained fires at most
+ * HORIZON ticks late.
+ *
+ * Each call performs a single operation: arm or cancel the given timer, or
+ * sweep, which removes one entry from the slot under the cursor or advances
+ * the cursor to the next slot once the current one is empty. Expiries are
+ * only taken when ready is set, so a full event FIFO holds the sweep rather
+ * than dropping timers.
+ */
+template <int NUM_TIMERS, int NUM_SLOTS, int HORIZON, int TICK_CYCLES>
+class timer_wheel {
+  public:
+    timer_wheel() : tickCycles(0), now(0), cursor(0), curHead(0), curValid(false) {
+        for (int i = 0; i < NUM_SLOTS; i++) {
+            slotTable[i].valid = false;
+        }
+        for (int i = 0; i < NUM_TIMERS; i++) {
+            timerTable[i].active = false;
+            timerTable[i].linked = false;
+        }
+    }
+
+    bool step(timerWheelOp op, ap_uint<16> id, ap_uint<32> interval, bool ready, ap_uint<16>& expiredID) {
+#pragma HLS INLINE
+// clang-format off
+        #pragma HLS RESOURCE variable = timerTable core = RAM_T2P_BRAM
+        #pragma HLS DATA_PACK variable = timerTable
+        #pragma HLS DEPENDENCE variable = timerTable inter false
+        #pragma HLS RESOURCE variable = slotTable core = RAM_T2P_BRAM
+        #pragma HLS DATA_PACK variable = slotTable
+        #pragma HLS DEPENDENCE variable = slotTable inter false
+        // clang-format on
+
+        timerWheelEntry currEntry;
+        bool expired = false;
+
+        if (tickCycles == TICK_CYCLES - 1) {
+            tickCycles = 0;
+            now++;
+        } else {
+            tickCycles++;
+        }
+
+        switch (op) {
+            case TW_ARM:
+                currEntry = timerTable[id];
+                currEntry.deadline = now + interval;
+                currEntry.active = true;
+                if (!currEntry.linked) {
+                    chain(id, currEntry);
+                }
+                timerTable[id] = currEntry;
+                break;
+            case TW_CANCEL:
+                timerTable[id].active = false;
+                break;
+            default:
+                if (curValid) {
+                    if (ready) {
+                        expiredID = curHead;
+                        currEntry = timerTable[curHead];
+                        curHead = currEntry.next;
+                        curValid = currEntry.nextValid;
+                        currEntry.linked = false;
+                        if (currEntry.active) {
+                            if ((ap_int<32>)(currEntry.deadline - cursor) <= 0) {
+                                currEntry.active = false;
+                                expired = true;
+                            } else {
+                                chain(expiredID, currEntry);
+                            }
+                        }
+                        timerTable[expiredID] = currEntry;
+                    }
+                } else if (cursor != now) {
+                    // take ownership of the next slot chain
+                    cursor++;
+                    curHead = slotTable[cursor % NUM_SLOTS].head;
+                    curValid = slotTable[cursor % NUM_SLOTS].valid;
+                    slotTable[cursor % NUM_SLOTS].valid = false;
+                }
+                break;
+        }
+        return expired;
+    }
+
+  private:
+    timerWheelEntry timerTable[NUM_TIMERS];
+    timerWheelSlot slotTable[NUM_SLOTS];
+
+    ap_uint<16> tickCycles;
+    ap_uint<32> now;
+    ap_uint<32> cursor;
+    ap_uint<16> curHead;
+    bool curValid;
+
+    // Pushes the entry onto the chain of the slot it is due in, clamped to
+    // the window between the cursor and the horizon
+    void chain(ap_uint<16> id, timerWheelEntry& entry) {
+#pragma HLS INLINE
+        ap_uint<32> target = entry.deadline;
+        if ((ap_int<32>)(target - cursor) <= 0) {
+            target = cursor + 1;
+        } else if ((ap_int<32>)(target - cursor) > HORIZON) {
+            target = cursor + HORIZON;
+        }
+        entry.next = slotTable[target % NUM_SLOTS].head;
+        entry.nextValid = slotTable[target % NUM_SLOTS].valid;
+        entry.linked = true;
+        slotTable[target % NUM_SLOTS].head = id;
+        slotTable[target % NUM_SLOTS].valid = true;
+    }
+};
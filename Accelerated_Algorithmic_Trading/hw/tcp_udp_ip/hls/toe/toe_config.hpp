@@ -38,8 +38,20 @@
 
 //const uint16_t MSS = ${TCP_STACK_MSS};
 const uint16_t MSS = 1460;
-//const uint16_t MAX_SESSIONS = ${TCP_STACK_MAX_SESSIONS};
-const uint16_t MAX_SESSIONS = 32;
+// Number of TCP sessions, set at build time through TCP_STACK_MAX_SESSIONS.
+// Note the uram_datamover TX buffer holds BUFFER_SIZE bytes per session
+#ifndef TCP_STACK_MAX_SESSIONS
+#define TCP_STACK_MAX_SESSIONS 32
+#endif
+const uint16_t MAX_SESSIONS = TCP_STACK_MAX_SESSIONS;
+
+// Map the per session state and SAR tables to URAM rather than BRAM,
+// defaults on from 256 sessions
+#ifndef TCP_STACK_URAM_TABLES
+#define TCP_STACK_URAM_TABLES (TCP_STACK_MAX_SESSIONS >= 256)
+#endif
+// Number of recent table writes forwarded to reads, covers the URAM latency
+const int SESSION_TABLE_CACHE = 4;
 //const unsigned DATA_WIDTH = ${DATA_WIDTH} * 8;
 const unsigned DATA_WIDTH = 8 * 8;
 //const unsigned DATA_WIDTH_BITS = ConstLog2(DATA_WIDTH);
@@ -47,7 +59,9 @@ const unsigned DATA_WIDTH = 8 * 8;
 const unsigned DATA_WIDTH_BITS = 6;
 const unsigned DATA_KEEP_BITS = 3;
 
-// TCP_NODELAY flag, to disable Nagle's Algorithm
+// TCP_NODELAY flag, to disable Nagle's Algorithm, also enables the TX cut-through
+// path where segments that fit the send window are built directly from the
+// application stream while a copy is written to TX buffer for retransmission
 //#define TCP_NODELAY ${TCP_STACK_NODELAY_EN}
 #define TCP_NODELAY 1
 
@@ -61,16 +75,16 @@ const unsigned DATA_KEEP_BITS = 3;
 //#define FAST_RETRANSMIT ${TCP_STACK_FAST_RETRANSMIT_EN}
 #define FAST_RETRANSMIT 1
 
-//TCP window scaling option
+//TCP window scaling option, set at build time through TCP_STACK_WINDOW_SCALE_BITS.
+//The per session RX/TX buffer is 64KB << TCP_STACK_WINDOW_SCALE_BITS and the
+//shift is advertised in the SYN/SYN-ACK, 0 disables scaling (RFC 7323 max 14)
 //#define WINDOW_SCALE ${TCP_STACK_WINDOW_SCALING_EN}
-#define WINDOW_SCALE 0
-const unsigned WINDOW_SCALE_BITS = 2;
-#if (WINDOW_SCALE)
-const unsigned WINDOW_BITS = 16 + WINDOW_SCALE_BITS;
-#else
-const unsigned WINDOW_BITS = 16;
+#ifndef TCP_STACK_WINDOW_SCALE_BITS
+#define TCP_STACK_WINDOW_SCALE_BITS 2
 #endif
-
+#define WINDOW_SCALE (TCP_STACK_WINDOW_SCALE_BITS != 0)
+const unsigned WINDOW_SCALE_BITS = TCP_STACK_WINDOW_SCALE_BITS;
+const unsigned WINDOW_BITS = 16 + WINDOW_SCALE_BITS;
 
 const unsigned BUFFER_SIZE = (1 << WINDOW_BITS);
 const unsigned CONGESTION_WINDOW_MAX = (BUFFER_SIZE - 2048);
@@ -75,6 +75,38 @@ static const ap_uint<32> TIME_60s = (60000000.0 / 0.0033 / MAX_SESSIONS) + 1;
 static const ap_uint<32> TIME_120s = (120000000.0 / 0.0033 / MAX_SESSIONS) + 1;
 #endif
 
+/*
+ * Timer wheel used by the retransmit, probe and close timers. Intervals are
+ * in ticks of TIMER_TICK_CYCLES clock cycles and do not depend on MAX_SESSIONS,
+ * TIMER_WHEEL_HORIZON must be smaller than TIMER_WHEEL_SLOTS.
+ */
+static const int TIMER_WHEEL_SLOTS = 1024;
+static const int TIMER_WHEEL_HORIZON = 1000;
+
+#ifndef __SYNTHESIS__
+// Testbenches with long round trip times may lengthen the C-sim tick
+#ifndef TOE_CSIM_TIMER_TICK_CYCLES
+#define TOE_CSIM_TIMER_TICK_CYCLES 32
+#endif
+static const int TIMER_TICK_CYCLES = TOE_CSIM_TIMER_TICK_CYCLES;
+static const ap_uint<32> TICKS_50ms = 100;
+static const ap_uint<32> TICKS_1s = 100;
+static const ap_uint<32> TICKS_5s = 100;
+static const ap_uint<32> TICKS_10s = 300;
+static const ap_uint<32> TICKS_15s = 400;
+static const ap_uint<32> TICKS_30s = 600;
+static const ap_uint<32> TICKS_60s = 6000;
+#else
+static const int TIMER_TICK_CYCLES = 64;
+static const ap_uint<32> TICKS_50ms = (50000.0 / 0.0033 / TIMER_TICK_CYCLES) + 1;
+static const ap_uint<32> TICKS_1s = (1000000.0 / 0.0033 / TIMER_TICK_CYCLES) + 1;
+static const ap_uint<32> TICKS_5s = (5000000.0 / 0.0033 / TIMER_TICK_CYCLES) + 1;
+static const ap_uint<32> TICKS_10s = (10000000.0 / 0.0033 / TIMER_TICK_CYCLES) + 1;
+static const ap_uint<32> TICKS_15s = (15000000.0 / 0.0033 / TIMER_TICK_CYCLES) + 1;
+static const ap_uint<32> TICKS_30s = (30000000.0 / 0.0033 / TIMER_TICK_CYCLES) + 1;
+static const ap_uint<32> TICKS_60s = (60000000.0 / 0.0033 / TIMER_TICK_CYCLES) + 1;
+#endif
+
 /*
  * The SET_FIFO_DEPTH macro allows the FIFO depth to be set from a define
  */
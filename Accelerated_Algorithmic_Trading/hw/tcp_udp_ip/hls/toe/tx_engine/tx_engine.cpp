@@ -1072,7 +1072,9 @@ void read_data_stitching(hls::stream<bool>& memAccessBreakdown2readPkgStitcher,
 // TODO call function only when NODELAY
 /** @ingroup read_data_arbiter
  *
- * in TCP_NODELAY forwards on packets depending on txEng_isDDRbypass
+ * in TCP_NODELAY forwards on packets depending on txEng_isDDRbypass, the
+ * first word of a segment is forwarded in the same cycle as the source
+ * decision so that cut-through segments do not pay a bubble per segment
  *
  *  @param[in]		txBufferReadData
  *  @param[in]      txEng_isDDRbypass
@@ -1098,8 +1100,22 @@ void read_data_arbiter(hls::stream<net_axis<WIDTH> >& txBufferReadData,
                 bool isBypass = txEng_isDDRbypass.read();
                 if (isBypass) {
                     tps_state = 2;
+                    if (!txApp2txEng_data_stream.empty()) {
+                        net_axis<WIDTH> currWord = txApp2txEng_data_stream.read();
+                        txEng_tcpSegOut.write(currWord);
+                        if (currWord.last) {
+                            tps_state = 0;
+                        }
+                    }
                 } else {
                     tps_state = 1;
+                    if (!txBufferReadData.empty()) {
+                        net_axis<WIDTH> currWord = txBufferReadData.read();
+                        txEng_tcpSegOut.write(currWord);
+                        if (currWord.last) {
+                            tps_state = 0;
+                        }
+                    }
                 }
             }
 #else
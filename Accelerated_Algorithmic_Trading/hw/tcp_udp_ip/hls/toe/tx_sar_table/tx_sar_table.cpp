@@ -30,6 +30,7 @@
  * THE POSSIBILITY OF SUCH DAMAGE.
  */
 #include "tx_sar_table.hpp"
+#include "../session_table.hpp"
 
 /** @ingroup tx_sar_table
  *  This data structure stores the TX(transmitting) sliding window
@@ -50,25 +51,24 @@ void tx_sar_table(hls::stream<rxTxSarQuery>& rxEng2txSar_upd_req,
                   hls::stream<txSarAckPush>& txSar2txApp_ack_push) {
 #pragma HLS PIPELINE II = 1
 
-    static txSarEntry tx_table[MAX_SESSIONS];
-#pragma HLS DEPENDENCE variable = tx_table inter false
-#pragma HLS RESOURCE variable = tx_table core = RAM_T2P_BRAM
+    static session_table<txSarEntry, MAX_SESSIONS, SESSION_TABLE_CACHE> tx_table;
     const uint16_t INITIAL_WINDOW = 10 * MSS;
 
     // TX Engine
     if (!txEng2txSar_upd_req.empty()) {
         txTxSarQuery tst_txEngUpdate = txEng2txSar_upd_req.read();
+        txSarEntry entry = tx_table.read(tst_txEngUpdate.sessionID);
         if (tst_txEngUpdate.write) {
             if (!tst_txEngUpdate.isRtQuery) {
-                tx_table[tst_txEngUpdate.sessionID].not_ackd = tst_txEngUpdate.not_ackd;
+                entry.not_ackd = tst_txEngUpdate.not_ackd;
                 if (tst_txEngUpdate.init) {
-                    tx_table[tst_txEngUpdate.sessionID].app = tst_txEngUpdate.not_ackd;
-                    tx_table[tst_txEngUpdate.sessionID].ackd = tst_txEngUpdate.not_ackd - 1;
-                    tx_table[tst_txEngUpdate.sessionID].cong_window = INITIAL_WINDOW;
-                    tx_table[tst_txEngUpdate.sessionID].slowstart_threshold = 0xFFFF;
-                    tx_table[tst_txEngUpdate.sessionID].synSent = tst_txEngUpdate.synSent;
-                    tx_table[tst_txEngUpdate.sessionID].finReady = tst_txEngUpdate.finReady;
-                    tx_table[tst_txEngUpdate.sessionID].finSent = tst_txEngUpdate.finSent;
+                    entry.app = tst_txEngUpdate.not_ackd;
+                    entry.ackd = tst_txEngUpdate.not_ackd - 1;
+                    entry.cong_window = INITIAL_WINDOW;
+                    entry.slowstart_threshold = BUFFER_SIZE - 1; // slow start up to the full window
+                    entry.synSent = tst_txEngUpdate.synSent;
+                    entry.finReady = tst_txEngUpdate.finReady;
+                    entry.finSent = tst_txEngUpdate.finSent;
 // Init ACK to txAppInterface
 #if !(TCP_NODELAY)
                     txSar2txApp_ack_push.write(txSarAckPush(tst_txEngUpdate.sessionID, tst_txEngUpdate.not_ackd, 1));
@@ -78,22 +78,22 @@ void tx_sar_table(hls::stream<rxTxSarQuery>& rxEng2txSar_upd_req,
 #endif
                 }
                 if (tst_txEngUpdate.synSent) {
-                    tx_table[tst_txEngUpdate.sessionID].synSent = tst_txEngUpdate.synSent;
+                    entry.synSent = tst_txEngUpdate.synSent;
                 }
                 if (tst_txEngUpdate.finReady) {
-                    tx_table[tst_txEngUpdate.sessionID].finReady = tst_txEngUpdate.finReady;
+                    entry.finReady = tst_txEngUpdate.finReady;
                 }
                 if (tst_txEngUpdate.finSent) {
-                    tx_table[tst_txEngUpdate.sessionID].finSent = tst_txEngUpdate.finSent;
+                    entry.finSent = tst_txEngUpdate.finSent;
                 }
             } else {
                 txTxSarRtQuery txEngRtUpdate = tst_txEngUpdate;
-                tx_table[tst_txEngUpdate.sessionID].slowstart_threshold = txEngRtUpdate.getThreshold();
-                tx_table[tst_txEngUpdate.sessionID].cong_window = INITIAL_WINDOW;
+                entry.slowstart_threshold = txEngRtUpdate.getThreshold();
+                entry.cong_window = INITIAL_WINDOW;
             }
+            tx_table.write(tst_txEngUpdate.sessionID, entry);
         } else // Read
         {
-            txSarEntry entry = tx_table[tst_txEngUpdate.sessionID];
             // Pre-calculated usedLength, minWindow to improve timing in metaLoader
             // When calculating the usedLength we also consider if the FIN was already sent
             ap_uint<WINDOW_BITS> usedLength = ((ap_uint<WINDOW_BITS>)entry.not_ackd - entry.ackd);
@@ -132,26 +132,30 @@ void tx_sar_table(hls::stream<rxTxSarQuery>& rxEng2txSar_upd_req,
     else if (!txApp2txSar_app_push.empty()) // write only
     {
         txAppTxSarPush push = txApp2txSar_app_push.read();
-        tx_table[push.sessionID].app = push.app;
+        txSarEntry entry = tx_table.read(push.sessionID);
+        entry.app = push.app;
+        tx_table.write(push.sessionID, entry);
     }
     // RX Engine
     else if (!rxEng2txSar_upd_req.empty()) {
         rxTxSarQuery tst_rxEngUpdate = rxEng2txSar_upd_req.read();
+        txSarEntry entry = tx_table.read(tst_rxEngUpdate.sessionID);
         if (tst_rxEngUpdate.write) {
-            tx_table[tst_rxEngUpdate.sessionID].ackd = tst_rxEngUpdate.ackd;
-            tx_table[tst_rxEngUpdate.sessionID].recv_window = tst_rxEngUpdate.recv_window;
-            tx_table[tst_rxEngUpdate.sessionID].cong_window = tst_rxEngUpdate.cong_window;
-            tx_table[tst_rxEngUpdate.sessionID].count = tst_rxEngUpdate.count;
-            tx_table[tst_rxEngUpdate.sessionID].fastRetransmitted = tst_rxEngUpdate.fastRetransmitted;
+            entry.ackd = tst_rxEngUpdate.ackd;
+            entry.recv_window = tst_rxEngUpdate.recv_window;
+            entry.cong_window = tst_rxEngUpdate.cong_window;
+            entry.count = tst_rxEngUpdate.count;
+            entry.fastRetransmitted = tst_rxEngUpdate.fastRetransmitted;
 #if (WINDOW_SCALE)
             ap_uint<4> win_shift;
             if (tst_rxEngUpdate.init) {
                 win_shift = tst_rxEngUpdate.win_shift;
-                tx_table[tst_rxEngUpdate.sessionID].win_shift = tst_rxEngUpdate.win_shift;
+                entry.win_shift = tst_rxEngUpdate.win_shift;
             } else {
-                win_shift = tx_table[tst_rxEngUpdate.sessionID].win_shift;
+                win_shift = entry.win_shift;
             }
 #endif
+            tx_table.write(tst_rxEngUpdate.sessionID, entry);
 // Push ACK to txAppInterface
 #if !(TCP_NODELAY)
             txSar2txApp_ack_push.write(txSarAckPush(tst_rxEngUpdate.sessionID, tst_rxEngUpdate.ackd));
@@ -173,11 +177,9 @@ void tx_sar_table(hls::stream<rxTxSarQuery>& rxEng2txSar_upd_req,
             txSar2txApp_ack_push.write(txSarAckPush(tst_rxEngUpdate.sessionID, tst_rxEngUpdate.ackd, minWindow));
 #endif
         } else {
-            txSar2rxEng_upd_rsp.write(rxTxSarReply(
-                tx_table[tst_rxEngUpdate.sessionID].ackd, tx_table[tst_rxEngUpdate.sessionID].not_ackd,
-                tx_table[tst_rxEngUpdate.sessionID].cong_window,
-                tx_table[tst_rxEngUpdate.sessionID].slowstart_threshold, tx_table[tst_rxEngUpdate.sessionID].count,
-                tx_table[tst_rxEngUpdate.sessionID].fastRetransmitted));
+            txSar2rxEng_upd_rsp.write(rxTxSarReply(entry.ackd, entry.not_ackd, entry.cong_window,
+                                                   entry.slowstart_threshold, entry.count,
+                                                   entry.fastRetransmitted));
         }
     }
 }
@@ -27,13 +27,18 @@
 # ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
 # THE POSSIBILITY OF SUCH DAMAGE.
 
+# datapath width of the UDP receive chain, common.mk passes it when built through make
+if {![info exists ::env(UDP_RX_WIDTH)]} {
+    set ::env(UDP_RX_WIDTH) 64
+}
+
 open_project udp_prj
 
 set_top udp
 
 add_files ../packet.hpp
 add_files udp.hpp
-add_files udp.cpp
+add_files udp.cpp -cflags "-DAXI_WIDTH=$::env(UDP_RX_WIDTH)"
 
 open_solution "solution1"
 set_part $::env(XPART)
@@ -0,0 +1,73 @@
+# Copyright (c) 2019 Xilinx, Inc.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are 
+# met:
+#
+# 1. Redistributions of source code must retain the above copyright notice,
+#    this list of conditions and the following disclaimer.
+#
+# 2. Redistributions in binary form must reproduce the above copyright
+#    notice, this list of conditions and the following disclaimer in the
+#    documentation and/or other materials provided with the distribution.
+#
+# 3. Neither the name of the copyright holder nor the names of its
+#    contributors may be used to endorse or promote products derived from this
+#    software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+# AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE#
+# IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+# ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+# LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+# CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+# SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+# INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+# CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+# ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+# THE POSSIBILITY OF SUCH DAMAGE.
+
+source settings.tcl
+
+set PROJ "prj"
+set SOLN "sol"
+set CLKP 300MHz
+set CASE_ROOT [pwd]
+set KERNEL_ROOT "${CASE_ROOT}/../"
+set TCP_ROOT "${KERNEL_ROOT}/.."
+set AAT_ROOT "${TCP_ROOT}/../.."
+set CFLAGS "-I${KERNEL_ROOT} -I${AAT_ROOT}/lineHandler -I${AAT_ROOT}/common/include -std=c++14 -DUDP_RX -DAXI_WIDTH=${UDP_RX_WIDTH}"
+# sample captures are read relative to the csim working directory
+set PCAP_DIR "${AAT_ROOT}/../build/sample/"
+
+open_project -reset $PROJ
+
+add_files "${TCP_ROOT}/ip_handler/ip_handler.cpp" -cflags ${CFLAGS}
+add_files "${TCP_ROOT}/ipv4/ipv4.cpp" -cflags ${CFLAGS}
+add_files "${KERNEL_ROOT}/udp.cpp" -cflags ${CFLAGS}
+add_files "${TCP_ROOT}/axi_utils.cpp" -cflags ${CFLAGS}
+add_files -tb "${AAT_ROOT}/lineHandler/linehandler.cpp" -cflags ${CFLAGS}
+add_files -tb "${AAT_ROOT}/common/include/aat_interfaces.cpp" -cflags ${CFLAGS}
+add_files -tb "${AAT_ROOT}/common/include/aat_latency.cpp" -cflags ${CFLAGS}
+add_files -tb "tb_udp_rx_chain.cpp" -cflags ${CFLAGS}
+
+set_top udp
+
+open_solution -reset $SOLN -flow_target vitis
+
+set_part $XPART
+create_clock -period $CLKP -name default
+
+if {$CSIM == 1} {
+  csim_design -argv ${PCAP_DIR}
+}
+
+if {$CSYNTH == 1} {
+  csynth_design
+}
+
+if {$COSIM == 1} {
+  cosim_design -argv ${PCAP_DIR}
+}
+
+exit
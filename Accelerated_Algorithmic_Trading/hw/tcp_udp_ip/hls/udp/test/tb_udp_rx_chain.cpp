@@ -0,0 +1,422 @@
+/************************************************
+ * Copyright (c) 2016, 2020 Xilinx, Inc.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY
+ * WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ ************************************************/
+
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <vector>
+
+#include "../../ip_handler/ip_handler.hpp"
+#include "../udp.hpp"
+#include "linehandler.hpp"
+
+/*
+ * UDP receive chain throughput test. Ethernet frames from the sample pcaps are
+ * presented back to back, one word per cycle, to ip_handler -> ipv4 -> udp ->
+ * LineFilter::portFilter built at AXI_WIDTH bits. The TCP frames of the order
+ * entry capture are interleaved with the market data datagrams and must be
+ * dropped by the ip_handler. The udp group filter is enabled with the
+ * (group, port) pairs of the capture, copies of the datagrams readdressed to an
+ * unlisted group are interleaved as well and must be dropped by the udp lookup.
+ * Copies carrying 1 to 10 dwords of IP options exercise the optional header
+ * drop in ipv4 at every bus width.
+ * Line rate holds when the chain drains within RX_LATENCY_SLACK cycles of the
+ * last input word.
+ */
+
+#define RX_LATENCY_SLACK (64)
+#define RX_MAX_CYCLES (1000000)
+#define RX_TCP_INTERLEAVE (6)
+#define RX_CLOCK_MHZ (322)
+#define RX_STRAY_INTERLEAVE (16)
+#define RX_STRAY_GROUP (0xEF000001) // 239.0.0.1
+#define RX_OPTIONS_INTERLEAVE (7)
+#define RX_MAX_OPTIONS_DWORDS (10)
+
+#ifndef RX_PCAP_DIR
+#define RX_PCAP_DIR "../../../../../build/sample/"
+#endif
+
+typedef ap_axiu<AXI_WIDTH, 0, 0, 0> rxWord;
+
+struct rxSource {
+    uint32_t address;
+    uint16_t port;
+    bool operator<(const rxSource& other) const {
+        return (address < other.address) || ((address == other.address) && (port < other.port));
+    }
+};
+
+static hls::stream<rxWord> rawIn("rawIn");
+static hls::stream<rxWord> arpOut("arpOut");
+static hls::stream<rxWord> icmpOut("icmpOut");
+static hls::stream<rxWord> igmpOut("igmpOut");
+static hls::stream<rxWord> ipUdpData("ipUdpData");
+static hls::stream<ipv4Meta> ipRxMeta("ipRxMeta");
+static hls::stream<rxWord> ipRxData("ipRxData");
+static hls::stream<ipv4Meta> ipTxMeta("ipTxMeta");
+static hls::stream<rxWord> ipTxDataIn("ipTxDataIn");
+static hls::stream<rxWord> ipTxDataOut("ipTxDataOut");
+static hls::stream<ap_axiu<80, 0, 0, 0> > udpRxMetaIn("udpRxMetaIn");
+static hls::stream<ap_axiu<176, 0, 0, 0> > udpRxMeta("udpRxMeta");
+static hls::stream<rxWord> udpRxData("udpRxData");
+static hls::stream<ap_axiu<176, 0, 0, 0> > udpTxMeta("udpTxMeta");
+static hls::stream<rxWord> udpTxDataIn("udpTxDataIn");
+static hls::stream<ap_axiu<64, 0, 0, 0> > udpTxMetaOut("udpTxMetaOut");
+static hls::stream<rxWord> udpTxDataOut("udpTxDataOut");
+static hls::stream<ap_axis<AXI_WIDTH, 0, 0, 0> > filterIn("filterIn");
+static hls::stream<ipUdpMetaPackExt_t> filterMetaIn("filterMetaIn");
+static hls::stream<ap_axis<AXI_WIDTH, 0, 0, 0> > echoOut("echoOut");
+static hls::stream<ipUdpMetaPackExt_t> echoMetaOut("echoMetaOut");
+static hls::stream<axis<AXI_WIDTH> > filterOut("filterOut");
+static hls::stream<lhSplitId_t> splitIdOut("splitIdOut");
+static hls::stream<ap_uint<64> > timestampOut("timestampOut");
+static hls::stream<ap_uint<64> > timeIn("timeIn");
+
+static uint32_t ipInHdrErrors, ipInDelivers, ipInUnknownProtos, ipInAddrErrors, ipInReceives;
+static uint32_t datagramsTransmitted, datagramsRecv, datagramsRecvInvalidPort, datagramsRecvInvalidGroup;
+static uint32_t udpCapabilities;
+static uint8_t arrPorts[8192];
+static uint32_t arrGroups[2 * UDP_GROUP_TABLE_SIZE];
+
+static LineFilter lineFilter;
+static ap_uint<32> regFilterAddress[NUM_FILTERS];
+static ap_uint<32> regFilterPort[NUM_FILTERS];
+static ap_uint<32> regFilterSplitIdx[NUM_FILTERS];
+static ap_uint<32> regRxWord, regRxMeta, regDropWord, regDebugAddress, regDebugPort;
+
+static bool readPcap(const std::string& fileName, std::vector<std::vector<uint8_t> >& frames) {
+    std::ifstream file(fileName.c_str(), std::ios::binary);
+    uint8_t globalHeader[24];
+    uint8_t recordHeader[16];
+
+    if (!file.read((char*)globalHeader, sizeof(globalHeader))) {
+        std::cout << "ERROR: could not read " << fileName << std::endl;
+        return false;
+    }
+    while (file.read((char*)recordHeader, sizeof(recordHeader))) {
+        uint32_t length = recordHeader[8] | (recordHeader[9] << 8) | (recordHeader[10] << 16) | (recordHeader[11] << 24);
+        std::vector<uint8_t> frame(length);
+        file.read((char*)frame.data(), length);
+        frames.push_back(frame);
+    }
+    return true;
+}
+
+static bool isUdpFrame(const std::vector<uint8_t>& frame) {
+    return (frame.size() >= 42) && (frame[12] == 0x08) && (frame[13] == 0x00) && (frame[23] == UDP);
+}
+
+/*
+ * Copy of a datagram sent to another group, the IPv4 header checksum is
+ * recomputed and the UDP checksum cleared
+ */
+static std::vector<uint8_t> readdressFrame(const std::vector<uint8_t>& frame, uint32_t group) {
+    std::vector<uint8_t> stray(frame);
+    uint32_t sum = 0;
+    stray[30] = group >> 24;
+    stray[31] = group >> 16;
+    stray[32] = group >> 8;
+    stray[33] = group;
+    stray[24] = 0;
+    stray[25] = 0;
+    for (unsigned i = 14; i < 34; i += 2) {
+        sum += (stray[i] << 8) | stray[i + 1];
+    }
+    while (sum >> 16) {
+        sum = (sum & 0xFFFF) + (sum >> 16);
+    }
+    stray[24] = ~sum >> 8;
+    stray[25] = ~sum;
+    stray[40] = 0;
+    stray[41] = 0;
+    return stray;
+}
+
+/*
+ * Copy of a datagram with dwords x 32 bits of NOP IP options inserted, the
+ * IPv4 header length, total length and checksum are updated
+ */
+static std::vector<uint8_t> optionsFrame(const std::vector<uint8_t>& frame, unsigned dwords) {
+    std::vector<uint8_t> copy(frame.begin(), frame.begin() + 34);
+    uint16_t totalLength = ((frame[16] << 8) | frame[17]) + (dwords * 4);
+    uint32_t sum = 0;
+    copy.insert(copy.end(), dwords * 4, 0x01);
+    copy.insert(copy.end(), frame.begin() + 34, frame.end());
+    copy[14] = 0x40 | (5 + dwords);
+    copy[16] = totalLength >> 8;
+    copy[17] = totalLength;
+    copy[24] = 0;
+    copy[25] = 0;
+    for (unsigned i = 14; i < (34 + (dwords * 4)); i += 2) {
+        sum += (copy[i] << 8) | copy[i + 1];
+    }
+    while (sum >> 16) {
+        sum = (sum & 0xFFFF) + (sum >> 16);
+    }
+    copy[24] = ~sum >> 8;
+    copy[25] = ~sum;
+    return copy;
+}
+
+/*
+ * Advance every kernel of the chain by one cycle, streams between kernels of
+ * different interface types are wired through without delay
+ */
+static void rxChainCall(void) {
+    ip_handler_udp(rawIn, arpOut, icmpOut, igmpOut, ipUdpData, 0, ipInHdrErrors, ipInDelivers, ipInUnknownProtos,
+                   ipInAddrErrors, ipInReceives);
+    ipv4(ipUdpData, ipRxMeta, ipRxData, ipTxMeta, ipTxDataIn, ipTxDataOut, 0, UDP);
+    while (!ipRxMeta.empty()) {
+        ipv4Meta meta = ipRxMeta.read();
+        ap_axiu<80, 0, 0, 0> metaWord;
+        metaWord.data(31, 0) = meta.their_address;
+        metaWord.data(47, 32) = meta.length;
+        metaWord.data(79, 48) = meta.my_address;
+        metaWord.last = 1;
+        udpRxMetaIn.write(metaWord);
+    }
+    udp(udpRxMetaIn, ipRxData, udpRxMeta, udpRxData, udpTxMeta, udpTxDataIn, udpTxMetaOut, udpTxDataOut,
+        datagramsTransmitted, datagramsRecv, datagramsRecvInvalidPort, datagramsRecvInvalidGroup, arrPorts, arrGroups,
+        true, udpCapabilities);
+    while (!udpRxMeta.empty()) {
+        ap_axiu<176, 0, 0, 0> meta = udpRxMeta.read();
+        ipUdpMetaPackExt_t metaPack;
+        metaPack.data = 0;
+        metaPack.data(31, 0) = meta.data(31, 0);
+        metaPack.data(47, 32) = meta.data(143, 128);
+        metaPack.data(95, 80) = meta.data(159, 144);
+        metaPack.data(111, 96) = meta.data(175, 160);
+        metaPack.keep = -1;
+        metaPack.last = 1;
+        filterMetaIn.write(metaPack);
+    }
+    while (!udpRxData.empty()) {
+        rxWord word = udpRxData.read();
+        ap_axis<AXI_WIDTH, 0, 0, 0> filterWord;
+        filterWord.data = word.data;
+        filterWord.keep = word.keep;
+        filterWord.last = word.last;
+        filterIn.write(filterWord);
+    }
+    lineFilter.portFilter<AXI_WIDTH>(0, 0, 0, regFilterAddress, regFilterPort, regFilterSplitIdx, regRxWord,
+                                     regRxMeta, regDropWord, regDebugAddress, regDebugPort, timeIn, filterIn,
+                                     filterMetaIn, echoOut, echoMetaOut, filterOut, splitIdOut,
+                                     timestampOut);
+}
+
+int main(int argc, char* argv[]) {
+    const unsigned BYTES = AXI_WIDTH / 8;
+    std::string pcapDir = (argc > 1) ? argv[1] : RX_PCAP_DIR;
+    std::vector<std::vector<uint8_t> > udpFrames;
+    std::vector<std::vector<uint8_t> > tcpFrames;
+    std::vector<std::vector<uint8_t> > frames;
+    std::vector<std::vector<uint8_t> > expected;
+    std::vector<rxWord> words;
+    std::map<rxSource, unsigned> sources;
+    std::map<rxSource, unsigned> groups;
+    unsigned strays = 0;
+    bool testPassed = true;
+
+    std::cout << "UDP Receive Chain Throughput Test" << std::endl;
+    std::cout << "---------------------------------" << std::endl;
+    std::cout << "AXI_WIDTH=" << AXI_WIDTH << std::endl;
+
+    if (!readPcap(pcapDir + "cme_input_arb.pcap", udpFrames) || !readPcap(pcapDir + "cme_output.pcap", tcpFrames)) {
+        std::cout << "FAIL!" << std::endl;
+        return 1;
+    }
+
+    // interleave order entry TCP frames and stray group datagrams with the
+    // market data, program a port filter for every datagram source and the UDP
+    // port and group tables for every destination
+    for (unsigned i = 0, t = 0; i < udpFrames.size(); i++) {
+        const std::vector<uint8_t>& frame = udpFrames[i];
+        if (isUdpFrame(frame)) {
+            rxSource source;
+            source.address = (frame[26] << 24) | (frame[27] << 16) | (frame[28] << 8) | frame[29];
+            source.port = (frame[34] << 8) | frame[35];
+            uint16_t dstPort = (frame[36] << 8) | frame[37];
+            if ((sources.find(source) == sources.end()) && (sources.size() < NUM_FILTERS)) {
+                unsigned idx = sources.size();
+                sources[source] = idx;
+                regFilterAddress[idx] = source.address;
+                regFilterPort[idx] = source.port;
+                regFilterSplitIdx[idx] = idx % NUM_SPLITS;
+            }
+            rxSource group;
+            group.address = (frame[30] << 24) | (frame[31] << 16) | (frame[32] << 8) | frame[33];
+            group.port = dstPort;
+            if ((groups.find(group) == groups.end()) && (groups.size() < UDP_GROUP_TABLE_SIZE)) {
+                unsigned idx = groups.size();
+                groups[group] = idx;
+                arrGroups[2 * idx] = group.address;
+                arrGroups[2 * idx + 1] = group.port;
+            }
+            arrPorts[dstPort / 8] |= (1 << (dstPort % 8));
+            expected.push_back(std::vector<uint8_t>(frame.begin() + 42, frame.end()));
+            if ((expected.size() % RX_STRAY_INTERLEAVE) == 0) {
+                frames.push_back(readdressFrame(frame, RX_STRAY_GROUP));
+                strays++;
+            }
+            if ((expected.size() % RX_OPTIONS_INTERLEAVE) == 0) {
+                unsigned dwords = ((expected.size() / RX_OPTIONS_INTERLEAVE - 1) % RX_MAX_OPTIONS_DWORDS) + 1;
+                frames.push_back(optionsFrame(frame, dwords));
+                expected.push_back(expected.back());
+            }
+        }
+        frames.push_back(frame);
+        if (((i % RX_TCP_INTERLEAVE) == (RX_TCP_INTERLEAVE - 1)) && (t < tcpFrames.size())) {
+            frames.push_back(tcpFrames[t++]);
+        }
+    }
+
+    uint64_t inputBytes = 0;
+    for (unsigned i = 0; i < frames.size(); i++) {
+        const std::vector<uint8_t>& frame = frames[i];
+        for (unsigned offset = 0; offset < frame.size(); offset += BYTES) {
+            rxWord word;
+            word.data = 0;
+            word.keep = 0;
+            for (unsigned b = 0; (b < BYTES) && ((offset + b) < frame.size()); b++) {
+                word.data(b * 8 + 7, b * 8) = frame[offset + b];
+                word.keep[b] = 1;
+            }
+            word.last = ((offset + BYTES) >= frame.size());
+            words.push_back(word);
+        }
+        inputBytes += frame.size();
+    }
+
+    // one input word per cycle, the chain must keep up without backlog
+    unsigned wordIdx = 0;
+    unsigned datagram = 0;
+    unsigned byteIdx = 0;
+    unsigned errors = 0;
+    long lastInputCycle = 0;
+    long lastOutputCycle = 0;
+    long cycle;
+    for (cycle = 0; (cycle < RX_MAX_CYCLES) && (datagram < expected.size()); cycle++) {
+        if (wordIdx < words.size()) {
+            if (!rawIn.empty()) {
+                std::cout << "ERROR: input word not taken at cycle " << cycle << std::endl;
+                testPassed = false;
+                break;
+            }
+            rawIn.write(words[wordIdx++]);
+            lastInputCycle = cycle;
+        }
+
+        rxChainCall();
+
+        while (!filterOut.empty()) {
+            axis<AXI_WIDTH> word = filterOut.read();
+            for (unsigned b = 0; b < BYTES; b++) {
+                if (word.keep[b]) {
+                    if ((byteIdx >= expected[datagram].size()) ||
+                        (uint8_t(word.data(b * 8 + 7, b * 8)) != expected[datagram][byteIdx])) {
+                        errors++;
+                    }
+                    byteIdx++;
+                }
+            }
+            if (word.last) {
+                if (byteIdx != expected[datagram].size()) {
+                    errors++;
+                }
+                datagram++;
+                byteIdx = 0;
+            }
+            lastOutputCycle = cycle;
+        }
+        while (!splitIdOut.empty()) {
+            splitIdOut.read();
+        }
+        while (!timestampOut.empty()) {
+            timestampOut.read();
+        }
+    }
+
+    double bytesPerCycle = (double)inputBytes / (lastInputCycle + 1);
+    std::cout << std::dec << std::endl;
+    std::cout << "FRAMES=" << frames.size() << " DATAGRAMS=" << datagram << "/" << expected.size()
+              << " WORDS=" << words.size() << std::endl;
+    std::cout << "INPUT_CYCLES=" << (lastInputCycle + 1) << " DRAIN_CYCLES=" << (lastOutputCycle + 1) << std::endl;
+    std::cout << "BYTES_PER_CYCLE=" << std::fixed << std::setprecision(2) << bytesPerCycle
+              << " GBPS_AT_" << RX_CLOCK_MHZ << "MHZ=" << (bytesPerCycle * 8 * RX_CLOCK_MHZ / 1000) << std::endl;
+    std::cout << "IP_RECEIVES=" << ipInReceives << " IP_ADDR_ERRORS=" << ipInAddrErrors
+              << " IP_HDR_ERRORS=" << ipInHdrErrors << " UDP_RECV=" << datagramsRecv
+              << " UDP_INVALID_PORT=" << datagramsRecvInvalidPort << " UDP_INVALID_GROUP=" << datagramsRecvInvalidGroup
+              << " FILTER_RX_META=" << regRxMeta
+              << " FILTER_DROP_WORD=" << regDropWord << std::endl;
+
+    if (datagram != expected.size()) {
+        std::cout << "ERROR: " << (expected.size() - datagram) << " datagrams missing" << std::endl;
+        testPassed = false;
+    }
+
+    if (datagramsRecvInvalidGroup != strays) {
+        std::cout << "ERROR: " << datagramsRecvInvalidGroup << " of " << strays << " stray group datagrams dropped"
+                  << std::endl;
+        testPassed = false;
+    }
+
+    if ((udpCapabilities & UDP_CAPABILITY_GROUP_FILTER) == 0) {
+        std::cout << "ERROR: group filter capability not reported" << std::endl;
+        testPassed = false;
+    }
+
+    if (errors != 0) {
+        std::cout << "ERROR: " << errors << " payload mismatches" << std::endl;
+        testPassed = false;
+    }
+
+    if ((lastOutputCycle - lastInputCycle) > RX_LATENCY_SLACK) {
+        std::cout << "ERROR: chain drained " << (lastOutputCycle - lastInputCycle)
+                  << " cycles after the last input word, below line rate" << std::endl;
+        testPassed = false;
+    }
+
+    std::cout << std::endl;
+
+    if (!testPassed) {
+        std::cout << "FAIL!" << std::endl;
+        return 1;
+    }
+
+    std::cout << "Done!" << std::endl;
+
+    return 0;
+}
@@ -62,13 +62,14 @@ net_axis<64> axiu2word(ap_axiu<64, 0, 0, 0> inWord) {
 }
 
 /** @ingroup udp
- * Converts from ap_axi<64,0,0,0> to native ipMeta structure
+ * Converts from ap_axi<80,0,0,0> to native ipMeta structure
  */
-ipMeta axiu2ipMeta(ap_axiu<64, 0, 0, 0> inword) {
+ipMeta axiu2ipMeta(ap_axiu<80, 0, 0, 0> inword) {
 #pragma HLS inline
     ipMeta tmp_ipMeta;
     tmp_ipMeta.their_address = inword.data(31, 0);
     tmp_ipMeta.length = inword.data(47, 32);
+    tmp_ipMeta.my_address = inword.data(79, 48);
     return tmp_ipMeta;
 }
 
@@ -113,6 +114,11 @@ void process_udp(hls::stream<ap_axiu<WIDTH,0,0,0> >& input,
                 std::cout << "UDP dst Port: " << (uint16_t)dstPort << std::endl;
                 metaOut.write(udpMeta(pu_header.getSrcPort(), dstPort, pu_header.getLength() - 8, false));
                 metaWritten = true;
+                // a word wider than the header also carries payload, the header
+                // is shifted out after the port lookup
+                if (WIDTH > UDP_HEADER_SIZE) {
+                    output.write(currWord);
+                }
             } else {
                 output.write(currWord);
             }
@@ -129,29 +135,74 @@ void process_udp(hls::stream<ap_axiu<WIDTH,0,0,0> >& input,
 }
 
 /** @ingroup udp
- * The destination port lookup will take 2 clock cycles
+ * The destination lookup will take 2 clock cycles. Multicast datagrams are
+ * matched on (group address, port) against arrGroups when the group filter is
+ * enabled so unwanted groups sharing a port are dropped, all other datagrams
+ * on the port alone against arrPorts. The group table is shadowed in registers
+ * to compare every entry in the same cycle, one word of the shadow is
+ * refreshed from arrGroups per call.
  */
-void lookup(hls::stream<uint16_t> &dstPort,
+void lookup(hls::stream<ap_axiu<80,0,0,0> > &ipMetaIn,
+            hls::stream<uint16_t> &dstPort,
+            hls::stream<ipMeta> &ipMetaOut,
             hls::stream<bool> &validMeta,
             hls::stream<bool> &validData,
             uint8_t arrPorts[8192],
-            uint32_t& datagrams_recv_invalid_port            
+            uint32_t arrGroups[2 * UDP_GROUP_TABLE_SIZE],
+            bool group_filter_enable,
+            uint32_t& datagrams_recv_invalid_port,
+            uint32_t& datagrams_recv_invalid_group,
+            uint32_t& capabilities
             ) {
-    static uint32_t invalidPktsRecv = 0;                
-    if (!dstPort.empty()) {
+#pragma HLS PIPELINE II = 1
+    static ap_uint<32> groupAddress[UDP_GROUP_TABLE_SIZE];
+    static ap_uint<16> groupPort[UDP_GROUP_TABLE_SIZE];
+#pragma HLS ARRAY_PARTITION variable = groupAddress complete
+#pragma HLS ARRAY_PARTITION variable = groupPort complete
+    static uint16_t refreshIdx = 0;
+    static uint32_t invalidPktsRecv = 0;
+    static uint32_t invalidGroupPktsRecv = 0;
+
+    uint32_t groupWord = arrGroups[refreshIdx];
+    if (refreshIdx % 2 == 0) {
+        groupAddress[refreshIdx / 2] = groupWord;
+    } else {
+        groupPort[refreshIdx / 2] = groupWord;
+    }
+    refreshIdx = (refreshIdx == (2 * UDP_GROUP_TABLE_SIZE - 1)) ? 0 : refreshIdx + 1;
+
+    if (!ipMetaIn.empty() && !dstPort.empty()) {
+        ipMeta l_ipMeta = axiu2ipMeta(ipMetaIn.read());
         uint16_t l_dstPort = dstPort.read();
         // Convert the port to a byte location in memory
         uint8_t bitField = arrPorts[l_dstPort / 8];        
         // Convert the port to our expected bit fieldWID
         uint8_t expectedBit = 1 << (l_dstPort % 8);
         bool fPortMatch = bitField & expectedBit;
-        validMeta.write(fPortMatch);
-        validData.write(fPortMatch);
-        if (!fPortMatch) {
-         invalidPktsRecv++;   
+        bool fGroupMatch = false;
+        for (int i = 0; i < UDP_GROUP_TABLE_SIZE; i++) {
+#pragma HLS UNROLL
+            if ((groupPort[i] != 0) && (groupPort[i] == l_dstPort) && (groupAddress[i] == l_ipMeta.my_address)) {
+                fGroupMatch = true;
+            }
         }
+        bool fMulticast = (l_ipMeta.my_address(31, 28) == 0xE);
+        bool fValid = fPortMatch;
+        if (group_filter_enable && fMulticast) {
+            fValid = fGroupMatch;
+            if (!fValid) {
+                invalidGroupPktsRecv++;
+            }
+        } else if (!fValid) {
+            invalidPktsRecv++;
+        }
+        ipMetaOut.write(l_ipMeta);
+        validMeta.write(fValid);
+        validData.write(fValid);
     }
     datagrams_recv_invalid_port = invalidPktsRecv;            
+    datagrams_recv_invalid_group = invalidGroupPktsRecv;
+    capabilities = UDP_CAPABILITY_GROUP_FILTER;
 }
 
 /** @ingroup udp
@@ -182,13 +233,19 @@ void dropData(hls::stream<net_axis<WIDTH> >& input,
     bool fValid = false;
     switch (state) {
         case IDLE:
-            if (!validIn.empty()) {
+            // the first word is taken with its valid flag, no idle cycle between packets
+            if (!validIn.empty() && !input.empty()) {
                 validIn.read(fValid);
+                currWord = input.read();
                 if (fValid) {
+                    output.write(currWord);
                     state = FWD;
                 } else {
                     state = DROP;
                 }
+                if (currWord.last) {
+                    state = IDLE;
+                }
             }
             break;
         case FWD:
@@ -217,7 +274,7 @@ void dropData(hls::stream<net_axis<WIDTH> >& input,
 template <int WIDTH>
 void generate_udp(hls::stream<udpMeta>& metaIn,
                   hls::stream<net_axis<WIDTH> >& input,
-                  hls::stream<ap_axiu<64,0,0,0> >& output,
+                  hls::stream<ap_axiu<WIDTH,0,0,0> >& output,
                   uint32_t& datagrams_transmitted) {
 #pragma HLS inline off
 #pragma HLS pipeline II = 1
@@ -230,7 +287,7 @@ void generate_udp(hls::stream<udpMeta>& metaIn,
     net_axis<WIDTH> currWord;
     uint8_t nBytesRem = 0;
     static uint32_t pktsSent = 0;
-    ap_axiu<64,0,0,0> outWord;
+    ap_axiu<WIDTH,0,0,0> outWord;
 
     switch (state) {
         case META:
@@ -315,7 +372,7 @@ void split_tx_meta(hls::stream<ap_axiu<176, 0, 0, 0> >& metaIn,
 /** @ingroup udp
  * Combines the IP Metadata and UDP Metadata into the user interface structure.
  */
-void merge_rx_meta(hls::stream<ap_axiu<64,0,0,0> >& ipMetaIn,
+void merge_rx_meta(hls::stream<ipMeta>& ipMetaIn,
                    hls::stream<udpMeta>& udpMetaIn,
                    hls::stream<ap_axiu<176, 0, 0, 0> >& metaOut) {
 #pragma HLS PIPELINE II = 1
@@ -324,7 +381,7 @@ void merge_rx_meta(hls::stream<ap_axiu<64,0,0,0> >& ipMetaIn,
     ipMeta l_ipMeta;
     udpMeta l_udpMeta;
     if (!ipMetaIn.empty() && !udpMetaIn.empty()) {
-        l_ipMeta = axiu2ipMeta(ipMetaIn.read());
+        ipMetaIn.read(l_ipMeta);
         udpMetaIn.read(l_udpMeta);
         if (l_udpMeta.valid) {
             metaOut.write(udpMeta2axiu(
@@ -347,21 +404,28 @@ void merge_rx_meta(hls::stream<ap_axiu<64,0,0,0> >& ipMetaIn,
  * @param [out] m_axis_tx_meta
  * @param [in]  m_axis_tx_data
  * @param [in]  arrPorts
+ * @param [in]  arrGroups
+ * @param [in]  group_filter_enable
  * @param [out] stats
+ * @param [out] capabilities
  */
 template <int WIDTH>
-void udp_body(hls::stream<ap_axiu<64,0,0,0> >& s_axis_rx_meta,
-              hls::stream<ap_axiu<64,0,0,0> >& s_axis_rx_data,
+void udp_body(hls::stream<ap_axiu<80,0,0,0> >& s_axis_rx_meta,
+              hls::stream<ap_axiu<WIDTH,0,0,0> >& s_axis_rx_data,
               hls::stream<ap_axiu<176, 0, 0, 0> >& m_axis_rx_meta,
-              hls::stream<ap_axiu<64,0,0,0> >& m_axis_rx_data,
+              hls::stream<ap_axiu<WIDTH,0,0,0> >& m_axis_rx_data,
               hls::stream<ap_axiu<176, 0, 0, 0> >& s_axis_tx_meta,
-              hls::stream<ap_axiu<64,0,0,0> >& s_axis_tx_data,
+              hls::stream<ap_axiu<WIDTH,0,0,0> >& s_axis_tx_data,
               hls::stream<ap_axiu<64,0,0,0> >& m_axis_tx_meta,
-              hls::stream<ap_axiu<64,0,0,0> >& m_axis_tx_data,
+              hls::stream<ap_axiu<WIDTH,0,0,0> >& m_axis_tx_data,
               uint32_t &datagrams_transmitted,
               uint32_t &datagrams_recv,
               uint32_t &datagrams_recv_invalid_port,
-              uint8_t arrPorts[8192]) {
+              uint32_t &datagrams_recv_invalid_group,
+              uint8_t arrPorts[8192],
+              uint32_t arrGroups[2 * UDP_GROUP_TABLE_SIZE],
+              bool group_filter_enable,
+              uint32_t &capabilities) {
 #pragma HLS INLINE
 
     /*
@@ -387,12 +451,13 @@ void udp_body(hls::stream<ap_axiu<64,0,0,0> >& s_axis_rx_meta,
 #pragma HLS STREAM depth = 2 variable = valid2drop
 
     process_udp(s_axis_rx_data, rx_udpMetaFifo, dstPort2lookup, rx_udp2dropFifo, datagrams_recv);
-    lookup(dstPort2lookup,valid2update,valid2drop,arrPorts,datagrams_recv_invalid_port);
+    lookup(s_axis_rx_meta,dstPort2lookup,rxIpMetaUdp,valid2update,valid2drop,arrPorts,arrGroups,group_filter_enable,
+           datagrams_recv_invalid_port,datagrams_recv_invalid_group,capabilities);
     updateUdpMeta(rx_udpMetaFifo, valid2update, rx_udpMeta2Merge);
     dropData(rx_udp2dropFifo,valid2drop,rx_udp2shiftFifo);
-    rshiftWordByOctet<AXI_WIDTH, net_axis<WIDTH>, ap_axiu<WIDTH,0,0,0>, 2>(((UDP_HEADER_SIZE % AXI_WIDTH) / 8), rx_udp2shiftFifo,
+    rshiftWordByOctet<WIDTH, net_axis<WIDTH>, ap_axiu<WIDTH,0,0,0>, 2>(((UDP_HEADER_SIZE % WIDTH) / 8), rx_udp2shiftFifo,
                                                           m_axis_rx_data);
-    merge_rx_meta(s_axis_rx_meta, rx_udpMeta2Merge, m_axis_rx_meta);
+    merge_rx_meta(rxIpMetaUdp, rx_udpMeta2Merge, m_axis_rx_meta);
 
     /*
      * TX PATH
@@ -409,7 +474,7 @@ void udp_body(hls::stream<ap_axiu<64,0,0,0> >& s_axis_rx_meta,
 #pragma HLS STREAM depth = 2 variable = txUdpData_out
 
     split_tx_meta(s_axis_tx_meta, m_axis_tx_meta, tx_udpMetaFifo);
-    lshiftWordByOctet<WIDTH,ap_axiu<WIDTH,0,0,0>, net_axis<WIDTH>, 1>(((UDP_HEADER_SIZE % AXI_WIDTH) / 8), s_axis_tx_data, tx_shift2udpFifo);
+    lshiftWordByOctet<WIDTH,ap_axiu<WIDTH,0,0,0>, net_axis<WIDTH>, 1>(((UDP_HEADER_SIZE % WIDTH) / 8), s_axis_tx_data, tx_shift2udpFifo);
     generate_udp<WIDTH>(tx_udpMetaFifo, tx_shift2udpFifo, m_axis_tx_data, datagrams_transmitted);
 };
 
@@ -427,20 +492,27 @@ void udp_body(hls::stream<ap_axiu<64,0,0,0> >& s_axis_rx_meta,
  * @param [out] m_axis_tx_meta
  * @param [in]  m_axis_tx_data
  * @param [in]  arrPorts
+ * @param [in]  arrGroups
+ * @param [in]  group_filter_enable
  * @param [out] stats
+ * @param [out] capabilities
  */
-void udp(hls::stream<ap_axiu<64,0,0,0> >& s_axis_rx_meta,
-         hls::stream<ap_axiu<64,0,0,0> >& s_axis_rx_data,
+void udp(hls::stream<ap_axiu<80,0,0,0> >& s_axis_rx_meta,
+         hls::stream<ap_axiu<AXI_WIDTH,0,0,0> >& s_axis_rx_data,
          hls::stream<ap_axiu<176, 0, 0, 0> >& m_axis_rx_meta,
-         hls::stream<ap_axiu<64,0,0,0> >& m_axis_rx_data,
+         hls::stream<ap_axiu<AXI_WIDTH,0,0,0> >& m_axis_rx_data,
          hls::stream<ap_axiu<176, 0, 0, 0> >& s_axis_tx_meta,
-         hls::stream<ap_axiu<64,0,0,0> >& s_axis_tx_data,
+         hls::stream<ap_axiu<AXI_WIDTH,0,0,0> >& s_axis_tx_data,
          hls::stream<ap_axiu<64,0,0,0> >& m_axis_tx_meta,
-         hls::stream<ap_axiu<64,0,0,0> >& m_axis_tx_data,
+         hls::stream<ap_axiu<AXI_WIDTH,0,0,0> >& m_axis_tx_data,
          uint32_t &datagrams_transmitted,
          uint32_t &datagrams_recv,
          uint32_t &datagrams_recv_invalid_port,
-         uint8_t arrPorts[8192]) {
+         uint32_t &datagrams_recv_invalid_group,
+         uint8_t arrPorts[8192],
+         uint32_t arrGroups[2 * UDP_GROUP_TABLE_SIZE],
+         bool group_filter_enable,
+         uint32_t &capabilities) {
 #pragma HLS DATAFLOW disable_start_propagation
 #pragma HLS INTERFACE ap_ctrl_none port = return
 
@@ -452,11 +524,18 @@ void udp(hls::stream<ap_axiu<64,0,0,0> >& s_axis_rx_meta,
 #pragma HLS INTERFACE axis register port = s_axis_tx_data
 #pragma HLS INTERFACE axis register port = m_axis_tx_meta
 #pragma HLS INTERFACE axis register port = m_axis_tx_data
-#pragma HLS INTERFACE s_axilite port = arrPorts bundle = control
+// The control window is 16KB (C_S_AXI_CONTROL_UDP_ADDR_WIDTH) and the TCP
+// block follows it, keep these offsets in step with the host address map
+#pragma HLS INTERFACE s_axilite port = arrPorts bundle = control offset = 0x2000
 #pragma HLS INTERFACE s_axilite port = datagrams_transmitted bundle = control
 #pragma HLS INTERFACE s_axilite port = datagrams_recv bundle = control
 #pragma HLS INTERFACE s_axilite port = datagrams_recv_invalid_port bundle = control
+#pragma HLS INTERFACE s_axilite port = datagrams_recv_invalid_group bundle = control
+#pragma HLS INTERFACE s_axilite port = arrGroups bundle = control offset = 0x1000
+#pragma HLS INTERFACE s_axilite port = group_filter_enable bundle = control offset = 0x50
+#pragma HLS INTERFACE s_axilite port = capabilities bundle = control offset = 0x60
 
-    udp_body<64>(s_axis_rx_meta, s_axis_rx_data, m_axis_rx_meta, m_axis_rx_data, s_axis_tx_meta, s_axis_tx_data,
-                 m_axis_tx_meta, m_axis_tx_data, datagrams_transmitted, datagrams_recv, datagrams_recv_invalid_port, arrPorts);
+    udp_body<AXI_WIDTH>(s_axis_rx_meta, s_axis_rx_data, m_axis_rx_meta, m_axis_rx_data, s_axis_tx_meta, s_axis_tx_data,
+                 m_axis_tx_meta, m_axis_tx_data, datagrams_transmitted, datagrams_recv, datagrams_recv_invalid_port,
+                 datagrams_recv_invalid_group, arrPorts, arrGroups, group_filter_enable, capabilities);
 }
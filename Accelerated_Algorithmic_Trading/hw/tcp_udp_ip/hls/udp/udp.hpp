@@ -45,6 +45,17 @@ typedef ipv4Meta ipMeta;
 
 const uint32_t UDP_HEADER_SIZE = 64;
 
+// Number of (multicast group, port) pairs matched in parallel on receive, the
+// host table holds the group address at word 2n and the port at word 2n+1, a
+// port of 0 marks the entry as unused
+#ifndef UDP_GROUP_TABLE_SIZE
+#define UDP_GROUP_TABLE_SIZE 64
+#endif
+
+// Reported through the capabilities register so the host can tell this block
+// from the RTL udp_ll stack, which reads back 0 there and has no group table
+const uint32_t UDP_CAPABILITY_GROUP_FILTER = (1 << 0);
+
 struct ipUdpMeta {
     ap_uint<128> their_address;
     ap_uint<16> their_port;
@@ -96,17 +107,21 @@ class udpHeader : public packetHeader<W, UDP_HEADER_SIZE> {
 /**
  * @defgroup udp UDP Module
  */
-void udp(hls::stream<ap_axiu<64,0,0,0> >& s_axis_rx_meta,
-         hls::stream<ap_axiu<64, 0, 0, 0> >& s_axis_rx_data,
+void udp(hls::stream<ap_axiu<80,0,0,0> >& s_axis_rx_meta,
+         hls::stream<ap_axiu<AXI_WIDTH, 0, 0, 0> >& s_axis_rx_data,
          hls::stream<ap_axiu<176, 0, 0, 0> >& m_axis_rx_meta,
-         hls::stream<ap_axiu<64, 0, 0, 0> >& m_axis_rx_data,
+         hls::stream<ap_axiu<AXI_WIDTH, 0, 0, 0> >& m_axis_rx_data,
          hls::stream<ap_axiu<176, 0, 0, 0> >& s_axis_tx_meta,
-         hls::stream<ap_axiu<64, 0, 0, 0> >& s_axis_tx_data,
+         hls::stream<ap_axiu<AXI_WIDTH, 0, 0, 0> >& s_axis_tx_data,
          hls::stream<ap_axiu<64,0,0,0> >& m_axis_tx_meta,
-         hls::stream<ap_axiu<64, 0, 0, 0> >& m_axis_tx_data,
+         hls::stream<ap_axiu<AXI_WIDTH, 0, 0, 0> >& m_axis_tx_data,
          uint32_t &datagrams_transmitted,
          uint32_t &datagrams_recv,
          uint32_t &datagrams_recv_invalid_port,
-         uint8_t arrPorts[8192]);
+         uint32_t &datagrams_recv_invalid_group,
+         uint8_t arrPorts[8192],
+         uint32_t arrGroups[2 * UDP_GROUP_TABLE_SIZE],
+         bool group_filter_enable,
+         uint32_t &capabilities);
 
 #endif
@@ -31,7 +31,7 @@ open_project uram_datamover_prj
 
 set_top uram_datamover
 
-add_files uram_datamover.cpp
+add_files uram_datamover.cpp -cflags "-DTCP_STACK_MAX_SESSIONS=$::env(TCP_STACK_MAX_SESSIONS) -DTCP_STACK_WINDOW_SCALE_BITS=$::env(TCP_STACK_WINDOW_SCALE_BITS)"
 add_files uram_datamover.hpp
 
 open_solution "solution1"
@@ -124,7 +124,7 @@ T reg(T x) {
 
 struct commonVars {
     uint64_t rshiftWord;
-    uint8_t nBuffer;
+    uint16_t nBuffer;
     uint32_t nBufferAddr;
     uint8_t nStartWordByte;
     uint32_t nCurrWordAddr;
@@ -143,11 +143,12 @@ struct commonVars {
  */
 void set_common(commonVars& cvars, ap_uint<32> saddr, ap_uint<23> btt) {
 #pragma HLS inline
-    cvars.nBuffer = saddr(WINDOW_BITS + 8, WINDOW_BITS);
+    cvars.nBuffer = saddr(29, WINDOW_BITS);
     cvars.nStartWordByte = saddr(2, 0);
     cvars.rshiftWord = 0;
     cvars.nCurrWordAddr = saddr(WINDOW_BITS - 1, 3) << 3;
-    cvars.nBufferAddr = cvars.nBuffer << WINDOW_BITS;
+    // Word address of the session buffer, BUFFER_SIZE bytes per session
+    cvars.nBufferAddr = cvars.nBuffer << (WINDOW_BITS - 3);
     // Total bytes to transfer is the number of bytes transferred in the operation + the byte offset of starting word
     cvars.btt = btt + saddr(2, 0);
     cvars.nTransferWords = cvars.btt / 8;
@@ -260,10 +261,10 @@ void uram_datamover_body(hls::stream<ap_axiu<128,0,0,0> >& cmdRead,
             // 1. Start at a non-word aligned offset.
             // 2. We have a partial word at the end
             if (currCmd.saddr(WINDOW_BITS - 1, 0) > cVars.nCurrWordAddr) {
-                firstWord = mem_buf.read(cVars.nCurrWordAddr + cVars.nBufferAddr);
+                firstWord = mem_buf.read((cVars.nCurrWordAddr >> 3) + cVars.nBufferAddr);
             }
             if (cVars.taddr(2, 0) != 7) {
-                lastWord = mem_buf.read(cVars.nCurrWordAddr + cVars.nTransferWords + cVars.nBufferAddr);
+                lastWord = mem_buf.read((cVars.nCurrWordAddr >> 3) + cVars.nTransferWords - 1 + cVars.nBufferAddr);
             }
 
             // Work out the number of transfers on the slave interface.
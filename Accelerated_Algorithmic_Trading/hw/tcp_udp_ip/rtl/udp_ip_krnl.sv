@@ -351,6 +351,7 @@ logic          axis_broadcast_to_udp_tlast;
 
     assign m_axis_udp_data_TSTRB = m_axis_udp_data_TKEEP;
 
+`ifndef UDP_RX
     assign axis_broadcast_to_udp_tvalid = m_axis_broadcast_tvalid[0:0];
     assign m_axis_broadcast_tready[0:0] = axis_broadcast_to_udp_tready;
     assign axis_broadcast_to_udp_tdata = m_axis_broadcast_tdata[0+:64];
@@ -447,6 +448,183 @@ logic          axis_broadcast_to_udp_tlast;
          .m_axis_tx_data_tkeep  (axi_udp_to_merge_tkeep),
          .m_axis_tx_data_tlast  (axi_udp_to_merge_tlast)
 );
+`else
+    // UDP_RX build - the HLS ipv4 and udp cores behind the UDP output of the
+    // ip_handler replace the udp_ll stack, the kernel streams stay 64 bits wide
+    wire            axi_iph_to_ipv4_tvalid;
+    wire            axi_iph_to_ipv4_tready;
+    wire[63:0]      axi_iph_to_ipv4_tdata;
+    wire[7:0]       axi_iph_to_ipv4_tkeep;
+    wire            axi_iph_to_ipv4_tlast;
+
+    wire            axis_ipv4_to_udp_meta_tvalid;
+    wire            axis_ipv4_to_udp_meta_tready;
+    wire[79:0]      axis_ipv4_to_udp_meta_tdata;
+
+    wire            axis_ipv4_to_udp_data_tvalid;
+    wire            axis_ipv4_to_udp_data_tready;
+    wire[63:0]      axis_ipv4_to_udp_data_tdata;
+    wire[7:0]       axis_ipv4_to_udp_data_tkeep;
+    wire            axis_ipv4_to_udp_data_tlast;
+
+    wire            axis_udp_rx_meta_tvalid;
+    wire            axis_udp_rx_meta_tready;
+    wire[175:0]     axis_udp_rx_meta_tdata;
+
+    wire            axis_udp_to_ipv4_meta_tvalid;
+    wire            axis_udp_to_ipv4_meta_tready;
+    wire[63:0]      axis_udp_to_ipv4_meta_tdata;
+
+    wire            axis_udp_to_ipv4_data_tvalid;
+    wire            axis_udp_to_ipv4_data_tready;
+    wire[63:0]      axis_udp_to_ipv4_data_tdata;
+    wire[7:0]       axis_udp_to_ipv4_data_tkeep;
+    wire            axis_udp_to_ipv4_data_tlast;
+
+    assign axis_broadcast_to_iph_tvalid = s_axis_line_TVALID;
+    assign s_axis_line_TREADY = axis_broadcast_to_iph_tready;
+    assign axis_broadcast_to_iph_tdata = s_axis_line_TDATA;
+    assign axis_broadcast_to_iph_tkeep = s_axis_line_TKEEP;
+    assign axis_broadcast_to_iph_tlast = s_axis_line_TLAST;
+
+    // HLS meta {length, my_port, their_port, their_address} to the udp_ll
+    // layout {length, dst port, dst address, src port, src address}
+    assign m_axis_udp_metadata_TVALID = axis_udp_rx_meta_tvalid;
+    assign axis_udp_rx_meta_tready = m_axis_udp_metadata_TREADY;
+    assign m_axis_udp_metadata_TDATA = {144'd0, axis_udp_rx_meta_tdata[160+:16], axis_udp_rx_meta_tdata[144+:16],
+                                        32'd0, axis_udp_rx_meta_tdata[128+:16], axis_udp_rx_meta_tdata[0+:32]};
+    assign m_axis_udp_metadata_TKEEP = 32'h00003FFF;
+    assign m_axis_udp_metadata_TSTRB = 32'h00003FFF;
+    assign m_axis_udp_metadata_TLAST = 1'b1;
+
+    ipv4_ip ipv4_inst (
+        .s_axis_rx_data_TVALID(axi_iph_to_ipv4_tvalid),
+        .s_axis_rx_data_TREADY(axi_iph_to_ipv4_tready),
+        .s_axis_rx_data_TDATA(axi_iph_to_ipv4_tdata),
+        .s_axis_rx_data_TKEEP(axi_iph_to_ipv4_tkeep),
+        .s_axis_rx_data_TSTRB(axi_iph_to_ipv4_tkeep),
+        .s_axis_rx_data_TLAST(axi_iph_to_ipv4_tlast),
+
+        .m_axis_rx_meta_TVALID(axis_ipv4_to_udp_meta_tvalid),
+        .m_axis_rx_meta_TREADY(axis_ipv4_to_udp_meta_tready),
+        .m_axis_rx_meta_TDATA(axis_ipv4_to_udp_meta_tdata),
+
+        .m_axis_rx_data_TVALID(axis_ipv4_to_udp_data_tvalid),
+        .m_axis_rx_data_TREADY(axis_ipv4_to_udp_data_tready),
+        .m_axis_rx_data_TDATA(axis_ipv4_to_udp_data_tdata),
+        .m_axis_rx_data_TKEEP(axis_ipv4_to_udp_data_tkeep),
+        .m_axis_rx_data_TSTRB(),
+        .m_axis_rx_data_TLAST(axis_ipv4_to_udp_data_tlast),
+
+        // udp ipMeta {length, their_address} to ipv4Meta, my_address is unused on transmit
+        .s_axis_tx_meta_TVALID(axis_udp_to_ipv4_meta_tvalid),
+        .s_axis_tx_meta_TREADY(axis_udp_to_ipv4_meta_tready),
+        .s_axis_tx_meta_TDATA({32'd0, axis_udp_to_ipv4_meta_tdata[47:0]}),
+
+        .s_axis_tx_data_TVALID(axis_udp_to_ipv4_data_tvalid),
+        .s_axis_tx_data_TREADY(axis_udp_to_ipv4_data_tready),
+        .s_axis_tx_data_TDATA(axis_udp_to_ipv4_data_tdata),
+        .s_axis_tx_data_TKEEP(axis_udp_to_ipv4_data_tkeep),
+        .s_axis_tx_data_TSTRB(axis_udp_to_ipv4_data_tkeep),
+        .s_axis_tx_data_TLAST(axis_udp_to_ipv4_data_tlast),
+
+        .m_axis_tx_data_TVALID(axi_udp_to_merge_tvalid),
+        .m_axis_tx_data_TREADY(axi_udp_to_merge_tready),
+        .m_axis_tx_data_TDATA(axi_udp_to_merge_tdata),
+        .m_axis_tx_data_TKEEP(axi_udp_to_merge_tkeep),
+        .m_axis_tx_data_TSTRB(),
+        .m_axis_tx_data_TLAST(axi_udp_to_merge_tlast),
+
+        .local_ipv4_address(ip_address),
+        .protocol(8'h11), //UDP_PROTOCOL
+
+        .ap_clk(ap_clk),
+        .ap_rst_n(ap_rst_n)
+    );
+
+    udp_ip udp_inst (
+        .s_axi_control_AWVALID(s_axi_udp_i_awvalid),
+        .s_axi_control_AWREADY(s_axi_udp_i_awready),
+        .s_axi_control_AWADDR(s_axi_udp_i_awaddr[C_S_AXI_CONTROL_UDP_ADDR_WIDTH-1:0]),
+        .s_axi_control_WVALID(s_axi_udp_i_wvalid),
+        .s_axi_control_WREADY(s_axi_udp_i_wready),
+        .s_axi_control_WDATA(s_axi_udp_i_wdata),
+        .s_axi_control_WSTRB(s_axi_udp_i_wstrb),
+        .s_axi_control_ARVALID(s_axi_udp_i_arvalid),
+        .s_axi_control_ARREADY(s_axi_udp_i_arready),
+        .s_axi_control_ARADDR(s_axi_udp_i_araddr[C_S_AXI_CONTROL_UDP_ADDR_WIDTH-1:0]),
+        .s_axi_control_RVALID(s_axi_udp_i_rvalid),
+        .s_axi_control_RREADY(s_axi_udp_i_rready),
+        .s_axi_control_RDATA(s_axi_udp_i_rdata),
+        .s_axi_control_RRESP(s_axi_udp_i_rresp),
+        .s_axi_control_BVALID(s_axi_udp_i_bvalid),
+        .s_axi_control_BREADY(s_axi_udp_i_bready),
+        .s_axi_control_BRESP(s_axi_udp_i_bresp),
+
+        // ipv4Meta {my_address, length, their_address} is the 80 bit udp receive meta
+        .s_axis_rx_meta_TVALID(axis_ipv4_to_udp_meta_tvalid),
+        .s_axis_rx_meta_TREADY(axis_ipv4_to_udp_meta_tready),
+        .s_axis_rx_meta_TDATA(axis_ipv4_to_udp_meta_tdata),
+        .s_axis_rx_meta_TKEEP(10'h3FF),
+        .s_axis_rx_meta_TSTRB(10'h3FF),
+        .s_axis_rx_meta_TLAST(1'b1),
+
+        .s_axis_rx_data_TVALID(axis_ipv4_to_udp_data_tvalid),
+        .s_axis_rx_data_TREADY(axis_ipv4_to_udp_data_tready),
+        .s_axis_rx_data_TDATA(axis_ipv4_to_udp_data_tdata),
+        .s_axis_rx_data_TKEEP(axis_ipv4_to_udp_data_tkeep),
+        .s_axis_rx_data_TSTRB(axis_ipv4_to_udp_data_tkeep),
+        .s_axis_rx_data_TLAST(axis_ipv4_to_udp_data_tlast),
+
+        .m_axis_rx_meta_TVALID(axis_udp_rx_meta_tvalid),
+        .m_axis_rx_meta_TREADY(axis_udp_rx_meta_tready),
+        .m_axis_rx_meta_TDATA(axis_udp_rx_meta_tdata),
+        .m_axis_rx_meta_TKEEP(),
+        .m_axis_rx_meta_TSTRB(),
+        .m_axis_rx_meta_TLAST(),
+
+        .m_axis_rx_data_TVALID(m_axis_udp_data_TVALID),
+        .m_axis_rx_data_TREADY(m_axis_udp_data_TREADY),
+        .m_axis_rx_data_TDATA(m_axis_udp_data_TDATA),
+        .m_axis_rx_data_TKEEP(m_axis_udp_data_TKEEP),
+        .m_axis_rx_data_TSTRB(),
+        .m_axis_rx_data_TLAST(m_axis_udp_data_TLAST),
+
+        // udp_ll transmit meta {length, src port, src address, dst port, dst address}
+        // to the HLS layout {length, my_port, their_port, their_address}
+        .s_axis_tx_meta_TVALID(s_axis_udp_metadata_TVALID),
+        .s_axis_tx_meta_TREADY(s_axis_udp_metadata_TREADY),
+        .s_axis_tx_meta_TDATA({s_axis_udp_metadata_TDATA[96+:16], s_axis_udp_metadata_TDATA[80+:16],
+                               s_axis_udp_metadata_TDATA[32+:16], 96'd0, s_axis_udp_metadata_TDATA[0+:32]}),
+        .s_axis_tx_meta_TKEEP(22'h3FFFFF),
+        .s_axis_tx_meta_TSTRB(22'h3FFFFF),
+        .s_axis_tx_meta_TLAST(1'b1),
+
+        .s_axis_tx_data_TVALID(s_axis_udp_data_TVALID),
+        .s_axis_tx_data_TREADY(s_axis_udp_data_TREADY),
+        .s_axis_tx_data_TDATA(s_axis_udp_data_TDATA),
+        .s_axis_tx_data_TKEEP(s_axis_udp_data_TKEEP),
+        .s_axis_tx_data_TSTRB(s_axis_udp_data_TKEEP),
+        .s_axis_tx_data_TLAST(s_axis_udp_data_TLAST),
+
+        .m_axis_tx_meta_TVALID(axis_udp_to_ipv4_meta_tvalid),
+        .m_axis_tx_meta_TREADY(axis_udp_to_ipv4_meta_tready),
+        .m_axis_tx_meta_TDATA(axis_udp_to_ipv4_meta_tdata),
+        .m_axis_tx_meta_TKEEP(),
+        .m_axis_tx_meta_TSTRB(),
+        .m_axis_tx_meta_TLAST(),
+
+        .m_axis_tx_data_TVALID(axis_udp_to_ipv4_data_tvalid),
+        .m_axis_tx_data_TREADY(axis_udp_to_ipv4_data_tready),
+        .m_axis_tx_data_TDATA(axis_udp_to_ipv4_data_tdata),
+        .m_axis_tx_data_TKEEP(axis_udp_to_ipv4_data_tkeep),
+        .m_axis_tx_data_TSTRB(),
+        .m_axis_tx_data_TLAST(axis_udp_to_ipv4_data_tlast),
+
+        .ap_clk(ap_clk),
+        .ap_rst_n(ap_rst_n)
+    );
+`endif
 
     wire [C_S_AXI_CONTROL_ADDR_WIDTH-1:0] s_axi_igmp_i_awaddr;
     wire        s_axi_igmp_i_awvalid;
@@ -564,6 +742,15 @@ logic          axis_broadcast_to_udp_tlast;
         .m_axis_IGMP_TKEEP(axi_iph_to_igmp_slice_tkeep), // output [7 : 0] AXI4Stream_M_TSTRB
         .m_axis_IGMP_TLAST(axi_iph_to_igmp_slice_tlast), // output [0 : 0] AXI4Stream_M_TLAST
 
+`ifdef UDP_RX
+        .m_axis_UDP_TVALID(axi_iph_to_ipv4_tvalid),
+        .m_axis_UDP_TREADY(axi_iph_to_ipv4_tready),
+        .m_axis_UDP_TDATA(axi_iph_to_ipv4_tdata),
+        .m_axis_UDP_TSTRB(),
+        .m_axis_UDP_TKEEP(axi_iph_to_ipv4_tkeep),
+        .m_axis_UDP_TLAST(axi_iph_to_ipv4_tlast),
+`endif
+
         .s_axis_raw_TVALID(axis_broadcast_to_iph_tvalid), // input AXI4Stream_S_TVALID
         .s_axis_raw_TREADY(axis_broadcast_to_iph_tready), // output AXI4Stream_S_TREADY
         .s_axis_raw_TDATA(axis_broadcast_to_iph_tdata), // input [63 : 0] AXI4Stream_S_TDATA
@@ -61,6 +61,12 @@ switch -- $kernel_name {
     }
 }
 
+# UDP_RX - HLS ipv4 and udp cores in place of the udp_ll stack, see udp_ip_krnl.sv
+set has_udp_rx 0
+if {$has_udp && !$has_tcp && [info exists ::env(UDP_RX)] && $::env(UDP_RX) ne ""} {
+    set has_udp_rx 1
+}
+
 create_project -force $proj_name $path_to_tmp_project -part $part
 set_property IP_REPO_PATHS $ip_repo [current_fileset]
 update_ip_catalog
@@ -72,11 +78,17 @@ if {$has_tcp && $has_udp} {
 } elseif {$has_tcp} {
     add_files rtl/axi_lite_crossbar_tcp.sv
     add_files -norecurse [glob rtl/udp_ll/mac_ip*.v rtl/udp_ll/mac_ip*.sv]
+} elseif {$has_udp_rx} {
+    add_files rtl/axi_lite_crossbar_udp.sv
+    add_files -norecurse [glob rtl/udp_ll/mac_ip*.v rtl/udp_ll/mac_ip*.sv]
 } else {
     add_files rtl/axi_lite_crossbar_udp.sv
     add_files -norecurse [glob rtl/udp_ll/*.v rtl/udp_ll/*.sv]
 }
 add_files rtl/${kernel_name}.sv
+if {$has_udp_rx} {
+    set_property verilog_define UDP_RX [current_fileset]
+}
 
 set_property top $top [current_fileset]
 
@@ -93,10 +105,10 @@ if {$has_tcp && $has_udp} {
 create_ip -name icmp_server -vendor com.xilinx.dcg.fintech -library hls -version 1.0 -module_name icmp_server_ip
 create_ip -name igmp -vendor com.xilinx.dcg.fintech -library hls -version 1.0 -module_name igmp_ip
 create_ip -name arp_server_subnet -vendor com.xilinx.dcg.fintech -library hls -version 1.0 -module_name arp_server_subnet_ip
-# if {$has_udp} {
-    # create_ip -name ipv4 -vendor com.xilinx.dcg.fintech -library hls -version 1.0 -module_name ipv4_ip
-    # create_ip -name udp -vendor com.xilinx.dcg.fintech -library hls -version 1.0 -module_name udp_ip
-# }
+if {$has_udp_rx} {
+    create_ip -name ipv4 -vendor com.xilinx.dcg.fintech -library hls -version 1.0 -module_name ipv4_ip
+    create_ip -name udp -vendor com.xilinx.dcg.fintech -library hls -version 1.0 -module_name udp_ip
+}
 if {$has_tcp} {
     create_ip -name toe -vendor com.xilinx.dcg.fintech -library hls -version 1.0 -module_name toe_ip
     create_ip -name uram_datamover -vendor com.xilinx.dcg.fintech -library hls -version 1.0 -module_name uram_datamover_ip
@@ -0,0 +1,312 @@
+/*
+ * Copyright 2021 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cstdio>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <chrono>
+
+#include "xlnx_capture_store.h"
+#include "xlnx_capture_store_error_codes.h"
+
+using namespace XLNX;
+
+
+
+
+static void PrintUsage(const char* exeName)
+{
+    printf("Usage: %s <capture.pcap> [-l] [-o <output.pcap>] [-s <ns>] [-e <ns>] [-t <ns> -w <ns>] [flow options]\n", exeName);
+    printf("    -l  list the segments of the capture\n");
+    printf("    -o  write the extracted packets to this file\n");
+    printf("    -s  start of the time window in nanoseconds (default start of capture)\n");
+    printf("    -e  end of the time window in nanoseconds (default end of capture)\n");
+    printf("    -t  centre of the time window in nanoseconds, used with -w\n");
+    printf("    -w  half width of the time window in nanoseconds, used with -t\n");
+    printf("flow options:\n");
+    printf("    --vlan <id> --proto <tcp|udp|num>\n");
+    printf("    --src <ip>[/len] --dst <ip>[/len] --addr <ip>[/len]  (addr matches either direction)\n");
+    printf("    --sport <port> --dport <port> --port <port>          (port matches either direction)\n");
+}
+
+
+
+
+static bool ParseUInt64(const char* pToken, uint64_t* pValue)
+{
+    char* pEnd;
+
+    *pValue = strtoull(pToken, &pEnd, 0);
+
+    return ((*pToken != '\0') && (*pEnd == '\0'));
+}
+
+
+
+
+static bool ParseUInt16(const char* pToken, uint16_t* pValue)
+{
+    uint64_t value;
+    bool bOK;
+
+    bOK = ParseUInt64(pToken, &value) && (value <= 0xFFFF);
+
+    *pValue = (uint16_t)value;
+
+    return bOK;
+}
+
+
+
+
+//<a.b.c.d>[/<prefix length>]
+static bool ParseAddress(const char* pToken, uint32_t* pAddress, uint32_t* pMask)
+{
+    unsigned int a, b, c, d;
+    unsigned int prefixLength = 32;
+    char trailing;
+    int numTokens;
+
+    numTokens = sscanf(pToken, "%u.%u.%u.%u/%u%c", &a, &b, &c, &d, &prefixLength, &trailing);
+
+    if (((numTokens != 4) && (numTokens != 5)) || (a > 255) || (b > 255) || (c > 255) || (d > 255) || (prefixLength > 32))
+    {
+        return false;
+    }
+
+    *pMask = (prefixLength == 0) ? 0 : (0xFFFFFFFF << (32 - prefixLength));
+    *pAddress = ((a << 24) | (b << 16) | (c << 8) | d) & *pMask;
+
+    return true;
+}
+
+
+
+
+static bool ParseProtocol(const char* pToken, uint8_t* pProtocol)
+{
+    uint16_t value;
+    bool bOK = true;
+
+    if (strcmp(pToken, "tcp") == 0)
+    {
+        *pProtocol = 6;
+    }
+    else if (strcmp(pToken, "udp") == 0)
+    {
+        *pProtocol = 17;
+    }
+    else
+    {
+        bOK = ParseUInt16(pToken, &value) && (value <= 0xFF);
+        *pProtocol = (uint8_t)value;
+    }
+
+    return bOK;
+}
+
+
+
+
+static void ListSegments(CaptureStore* pStore)
+{
+    CaptureStore::SegmentInfo info;
+    uint32_t numSegments = 0;
+
+    pStore->GetNumSegments(&numSegments);
+
+    printf("%-48s %14s %22s %10s\n", "Segment", "Bytes", "First Timestamp (ns)", "Index");
+
+    for (uint32_t i = 0; i < numSegments; i++)
+    {
+        if (pStore->GetSegmentInfo(i, &info) == XLNX_OK)
+        {
+            if (info.bHasPackets)
+            {
+                printf("%-48s %14llu %22llu %10u\n", info.path.c_str(), (unsigned long long)info.fileSize, (unsigned long long)info.firstTimestamp, info.numIndexEntries);
+            }
+            else
+            {
+                printf("%-48s %14llu %22s %10u\n", info.path.c_str(), (unsigned long long)info.fileSize, "-", info.numIndexEntries);
+            }
+        }
+    }
+}
+
+
+
+
+int main(int argc, char* argv[])
+{
+    uint32_t retval = XLNX_OK;
+    CaptureStore store;
+    CaptureStore::FlowFilter filter;
+    CaptureStore::ExtractStats stats;
+    const char* capturePath = nullptr;
+    const char* outputPath = nullptr;
+    bool bList = false;
+    bool bOK = true;
+    uint64_t startTimestamp = 0;
+    uint64_t endTimestamp = UINT64_MAX;
+    uint64_t centreTimestamp = 0;
+    uint64_t halfWidth = 0;
+    bool bCentre = false;
+    bool bWidth = false;
+    double elapsedNanoseconds;
+    int arg;
+
+    memset(&filter, 0, sizeof(filter));
+
+    for (arg = 1; (arg < argc) && bOK; arg++)
+    {
+        bool bHasValue = ((arg + 1) < argc);
+
+        if (strcmp(argv[arg], "-l") == 0)
+        {
+            bList = true;
+        }
+        else if ((strcmp(argv[arg], "-o") == 0) && bHasValue)
+        {
+            outputPath = argv[++arg];
+        }
+        else if ((strcmp(argv[arg], "-s") == 0) && bHasValue)
+        {
+            bOK = ParseUInt64(argv[++arg], &startTimestamp);
+        }
+        else if ((strcmp(argv[arg], "-e") == 0) && bHasValue)
+        {
+            bOK = ParseUInt64(argv[++arg], &endTimestamp);
+        }
+        else if ((strcmp(argv[arg], "-t") == 0) && bHasValue)
+        {
+            bOK = ParseUInt64(argv[++arg], &centreTimestamp);
+            bCentre = true;
+        }
+        else if ((strcmp(argv[arg], "-w") == 0) && bHasValue)
+        {
+            bOK = ParseUInt64(argv[++arg], &halfWidth);
+            bWidth = true;
+        }
+        else if ((strcmp(argv[arg], "--vlan") == 0) && bHasValue)
+        {
+            bOK = ParseUInt16(argv[++arg], &filter.vlanID);
+            filter.matchFlags |= CaptureStore::FLOW_MATCH_VLAN;
+        }
+        else if ((strcmp(argv[arg], "--proto") == 0) && bHasValue)
+        {
+            bOK = ParseProtocol(argv[++arg], &filter.ipProtocol);
+            filter.matchFlags |= CaptureStore::FLOW_MATCH_IP_PROTOCOL;
+        }
+        else if ((strcmp(argv[arg], "--src") == 0) && bHasValue)
+        {
+            bOK = ParseAddress(argv[++arg], &filter.srcAddress, &filter.srcMask);
+            filter.matchFlags |= CaptureStore::FLOW_MATCH_SRC_ADDRESS;
+        }
+        else if ((strcmp(argv[arg], "--dst") == 0) && bHasValue)
+        {
+            bOK = ParseAddress(argv[++arg], &filter.dstAddress, &filter.dstMask);
+            filter.matchFlags |= CaptureStore::FLOW_MATCH_DST_ADDRESS;
+        }
+        else if ((strcmp(argv[arg], "--addr") == 0) && bHasValue)
+        {
+            bOK = ParseAddress(argv[++arg], &filter.address, &filter.addressMask);
+            filter.matchFlags |= CaptureStore::FLOW_MATCH_ADDRESS;
+        }
+        else if ((strcmp(argv[arg], "--sport") == 0) && bHasValue)
+        {
+            bOK = ParseUInt16(argv[++arg], &filter.srcPort);
+            filter.matchFlags |= CaptureStore::FLOW_MATCH_SRC_PORT;
+        }
+        else if ((strcmp(argv[arg], "--dport") == 0) && bHasValue)
+        {
+            bOK = ParseUInt16(argv[++arg], &filter.dstPort);
+            filter.matchFlags |= CaptureStore::FLOW_MATCH_DST_PORT;
+        }
+        else if ((strcmp(argv[arg], "--port") == 0) && bHasValue)
+        {
+            bOK = ParseUInt16(argv[++arg], &filter.port);
+            filter.matchFlags |= CaptureStore::FLOW_MATCH_PORT;
+        }
+        else if ((argv[arg][0] != '-') && (capturePath == nullptr))
+        {
+            capturePath = argv[arg];
+        }
+        else
+        {
+            bOK = false;
+        }
+    }
+
+    if (bCentre != bWidth)
+    {
+        bOK = false;
+    }
+
+    if ((bOK == false) || (capturePath == nullptr) || ((outputPath == nullptr) && (bList == false)))
+    {
+        PrintUsage(argv[0]);
+        return 1;
+    }
+
+    if (bCentre)
+    {
+        startTimestamp = (centreTimestamp > halfWidth) ? (centreTimestamp - halfWidth) : 0;
+        endTimestamp = ((UINT64_MAX - centreTimestamp) > halfWidth) ? (centreTimestamp + halfWidth) : UINT64_MAX;
+    }
+
+    retval = store.Open(capturePath);
+
+    if (retval != XLNX_OK)
+    {
+        printf("[ERROR] Failed to open capture %s (0x%08X)\n", capturePath, retval);
+        return 1;
+    }
+
+    if (bList)
+    {
+        ListSegments(&store);
+    }
+
+    if (outputPath != nullptr)
+    {
+        std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+
+        retval = store.Extract(startTimestamp, endTimestamp, (filter.matchFlags != 0) ? &filter : nullptr, outputPath, &stats);
+
+        std::chrono::steady_clock::time_point endTime = std::chrono::steady_clock::now();
+
+        elapsedNanoseconds = (double)std::chrono::duration_cast<std::chrono::nanoseconds>(endTime - startTime).count();
+
+        if (retval != XLNX_OK)
+        {
+            printf("[ERROR] Extraction failed (0x%08X)\n", retval);
+            return 1;
+        }
+
+        printf("\n");
+        printf("Output:               %s\n", outputPath);
+        printf("Segments Searched:    %llu\n", (unsigned long long)stats.numSegmentsSearched);
+        printf("Records Scanned:      %llu\n", (unsigned long long)stats.numRecordsScanned);
+        printf("Records Extracted:    %llu\n", (unsigned long long)stats.numRecordsExtracted);
+        printf("Bytes Extracted:      %llu\n", (unsigned long long)stats.numBytesExtracted);
+        printf("Elapsed:              %.3f ms\n", elapsedNanoseconds / 1000000.0);
+    }
+
+    store.Close();
+
+    return 0;
+}
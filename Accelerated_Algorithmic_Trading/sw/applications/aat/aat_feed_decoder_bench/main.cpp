@@ -0,0 +1,216 @@
+/*
+ * Copyright 2021 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <cstdio>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <chrono>
+
+#include "xlnx_feed_decoder.h"
+#include "xlnx_feed_decoder_pcap_reader.h"
+#include "xlnx_feed_decoder_error_codes.h"
+
+using namespace XLNX;
+
+
+
+//security ID carried by the sample capture, mapped at the same index as the FeedHandler HLS testbench
+#define DEFAULT_SECURITY_ID         (0x12345678)
+#define DEFAULT_SECURITY_INDEX      (9)
+
+#define DEFAULT_NUM_ITERATIONS      (10000)
+
+
+
+
+static orderBookOperation_t operations[FeedDecoder::MAX_OPERATIONS_PER_PACKET];
+
+
+
+
+static void PrintUsage(const char* exeName)
+{
+    printf("Usage: %s <pcapfile> [-i <iterations>] [-s <securityID>:<index>]... [-v]\n", exeName);
+    printf("    -i  number of times the capture is replayed (default %u)\n", DEFAULT_NUM_ITERATIONS);
+    printf("    -s  map a security ID to a symbol index, may be repeated (default 0x%08X:%u)\n", DEFAULT_SECURITY_ID, DEFAULT_SECURITY_INDEX);
+    printf("    -v  print each decoded operation on the first replay\n");
+}
+
+
+
+
+static void PrintOperation(orderBookOperation_t* pOperation)
+{
+    //same format as the FeedHandler HLS testbench to allow the two to be compared directly
+    printf("OPERATION: %llu,%u,%u,%u,%u,%u,%u,%u,%d,%llu\n",
+           (unsigned long long)pOperation->timestamp,
+           pOperation->opCode,
+           pOperation->symbolIndex,
+           pOperation->orderId,
+           pOperation->orderCount,
+           pOperation->quantity,
+           pOperation->price,
+           pOperation->direction,
+           pOperation->level,
+           (unsigned long long)pOperation->ingressTimestamp);
+}
+
+
+
+
+int main(int argc, char* argv[])
+{
+    uint32_t retval = XLNX_OK;
+    FeedDecoder decoder;
+    FeedDecoder::Stats stats;
+    PCAPReader reader;
+    const char* filePath = nullptr;
+    uint32_t numIterations = DEFAULT_NUM_ITERATIONS;
+    bool bVerbose = false;
+    bool bSecurityMapped = false;
+    unsigned long securityID;
+    unsigned long securityIndex;
+    char* pEnd;
+    const uint8_t* pPayload;
+    uint32_t payloadLength;
+    uint64_t timestamp;
+    uint32_t numOperations;
+    uint64_t checksum = 0;
+    double elapsedNanoseconds;
+    uint32_t iteration;
+    uint32_t i;
+    int arg;
+
+    for (arg = 1; (arg < argc) && (retval == XLNX_OK); arg++)
+    {
+        if ((strcmp(argv[arg], "-i") == 0) && ((arg + 1) < argc))
+        {
+            numIterations = (uint32_t)strtoul(argv[++arg], nullptr, 0);
+        }
+        else if ((strcmp(argv[arg], "-s") == 0) && ((arg + 1) < argc))
+        {
+            securityID = strtoul(argv[++arg], &pEnd, 0);
+
+            securityIndex = 0;
+
+            if (*pEnd == ':')
+            {
+                securityIndex = strtoul(pEnd + 1, &pEnd, 0);
+            }
+            else
+            {
+                pEnd = argv[arg];
+            }
+
+            if ((*pEnd != '\0') || (securityID == 0))
+            {
+                retval = XLNX_FEED_DECODER_ERROR_INVALID_PARAMETER;
+            }
+            else
+            {
+                retval = decoder.SetSecurity((uint32_t)securityIndex, (uint32_t)securityID);
+                bSecurityMapped = true;
+            }
+        }
+        else if (strcmp(argv[arg], "-v") == 0)
+        {
+            bVerbose = true;
+        }
+        else if ((argv[arg][0] != '-') && (filePath == nullptr))
+        {
+            filePath = argv[arg];
+        }
+        else
+        {
+            retval = XLNX_FEED_DECODER_ERROR_INVALID_PARAMETER;
+        }
+    }
+
+    if ((retval != XLNX_OK) || (filePath == nullptr) || (numIterations == 0))
+    {
+        PrintUsage(argv[0]);
+        return 1;
+    }
+
+    if (bSecurityMapped == false)
+    {
+        decoder.SetSecurity(DEFAULT_SECURITY_INDEX, DEFAULT_SECURITY_ID);
+    }
+
+    retval = reader.Open(filePath);
+
+    if (retval != XLNX_OK)
+    {
+        printf("[ERROR] Failed to open %s (0x%08X)\n", filePath, retval);
+        return 1;
+    }
+
+    std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+
+    for (iteration = 0; iteration < numIterations; iteration++)
+    {
+        reader.Rewind();
+
+        while (reader.GetNextUDPPayload(&pPayload, &payloadLength, &timestamp) == XLNX_OK)
+        {
+            numOperations = 0;
+
+            retval = decoder.DecodePacket(pPayload, payloadLength, timestamp, operations, FeedDecoder::MAX_OPERATIONS_PER_PACKET, &numOperations);
+
+            for (i = 0; i < numOperations; i++)
+            {
+                checksum += operations[i].price;
+
+                if (bVerbose && (iteration == 0))
+                {
+                    PrintOperation(&operations[i]);
+                }
+            }
+        }
+    }
+
+    std::chrono::steady_clock::time_point endTime = std::chrono::steady_clock::now();
+
+    elapsedNanoseconds = (double)std::chrono::duration_cast<std::chrono::nanoseconds>(endTime - startTime).count();
+
+    decoder.GetStats(&stats);
+
+    printf("\n");
+    printf("Capture:              %s\n", filePath);
+    printf("Iterations:           %u\n", numIterations);
+    printf("Packets:              %llu\n", (unsigned long long)stats.numPackets);
+    printf("Messages:             %llu\n", (unsigned long long)stats.numMessages);
+    printf("Unsupported Messages: %llu\n", (unsigned long long)stats.numUnsupportedMessages);
+    printf("Entries:              %llu\n", (unsigned long long)stats.numEntries);
+    printf("Operations:           %llu\n", (unsigned long long)stats.numOperations);
+    printf("Unknown Securities:   %llu\n", (unsigned long long)stats.numUnknownSecurities);
+    printf("Malformed Packets:    %llu\n", (unsigned long long)stats.numMalformedPackets);
+    printf("Price Checksum:       %llu\n", (unsigned long long)checksum);
+    printf("\n");
+    printf("Elapsed:              %.3f ms\n", elapsedNanoseconds / 1000000.0);
+
+    if (stats.numMessages > 0)
+    {
+        printf("Messages/sec:         %.0f\n", (double)stats.numMessages * 1000000000.0 / elapsedNanoseconds);
+        printf("ns/message:           %.2f\n", elapsedNanoseconds / (double)stats.numMessages);
+    }
+
+    reader.Close();
+
+    return 0;
+}
@@ -14,10 +14,20 @@
  * limitations under the License.
  */
 
+#include <cstdio>
 #include <cstring> //for memcpy..
 
 #include "xlnx_aat.h"
 #include "xlnx_aat_error_codes.h"
+
+#include "xlnx_feed_handler_address_map.h"
+#include "xlnx_order_book_address_map.h"
+#include "xlnx_order_book_data_mover_address_map.h"
+#include "xlnx_pricing_engine_address_map.h"
+#include "xlnx_risk_engine_address_map.h"
+#include "xlnx_order_entry_address_map.h"
+#include "xlnx_ethernet_address_map.h"
+#include "xlnx_tcp_udp_ip_address_map.h"
 using namespace XLNX;
 
 
@@ -42,6 +52,8 @@ static const char* ORDER_BOOK_DATA_MOVER_CU_NAME	= "orderBookDataMoverTop:orderB
 
 static const char* PRICING_ENGINE_CU_NAME			= "pricingEngineTop:pricingEngineTop";
 
+static const char* RISK_ENGINE_CU_NAME				= "riskEngineTop:riskEngineTop";
+
 static const char* ORDER_ENTRY_CU_NAME				= "orderEntryTop:orderEntryTop";		//original name
 static const char* ORDER_ENTRY_UDP_CU_NAME			= "orderEntryUdpTop:orderEntryUdpTop";	//new name when attached to UDPIP block
 static const char* ORDER_ENTRY_TCP_CU_NAME			= "orderEntryTcpTop:orderEntryTcpTop";	//new name when attached to TCPIP block
@@ -141,6 +153,10 @@ uint32_t AAT::Initialise(DeviceInterface* pDeviceInterface)
 
 
 
+    retval = riskEngine.Initialise(pDeviceInterface, RISK_ENGINE_CU_NAME);
+
+
+
 
 
 
@@ -191,6 +207,31 @@ uint32_t AAT::Initialise(DeviceInterface* pDeviceInterface)
     retval = networkTap.Initialise(pDeviceInterface, NETWORK_TAP_CU_NAME);
 
 
+
+    //Register sampling is set up last so that only the kernels present in this load are added to it
+    retval = telemetry.Initialise(pDeviceInterface);
+
+    if (retval == XLNX_OK)
+    {
+        AddTelemetryBlocks();
+
+        //while sampling is running the kernel GetStats calls are served from the telemetry snapshots
+        lineHandler.SetTelemetry(&telemetry);
+        feedHandler.SetTelemetry(&telemetry);
+        orderBook.SetTelemetry(&telemetry);
+        pricingEngine.SetTelemetry(&telemetry);
+        riskEngine.SetTelemetry(&telemetry);
+        orderEntry.SetTelemetry(&telemetry);
+
+        retval = metrics.Initialise(&telemetry);
+    }
+
+    if (retval == XLNX_OK)
+    {
+        AddMetrics();
+    }
+
+
     //Now we will set the MAC address registers in the IP blocks using the MAC addresses from the 
     //cards NVRAM (which is set in the factory)
     SetMACAddressesFromNVRAM(pDeviceInterface);
@@ -209,6 +250,10 @@ uint32_t AAT::Uninitialise(void)
 {
     uint32_t retval = XLNX_OK;
 
+    //stop sampling before anything else is torn down underneath it (exporter first, it reads the telemetry snapshots)
+    metrics.Uninitialise();
+    telemetry.Uninitialise();
+
     //Currently the data mover kernel and the network capture kernel are the only ones that uses any DDR/HBM memory...
     retval = dataMover.Uninitialise();
 
@@ -222,6 +267,321 @@ uint32_t AAT::Uninitialise(void)
 
 
 
+//Number of 32-bit registers from FIRST to LAST inclusive
+#define TELEMETRY_NUM_WORDS(FIRST, LAST)    ((uint32_t)((((LAST) - (FIRST)) / sizeof(uint32_t)) + 1))
+
+//Index of the register at OFFSET within a telemetry block starting at FIRST
+#define TELEMETRY_WORD_INDEX(FIRST, OFFSET) ((uint32_t)(((OFFSET) - (FIRST)) / sizeof(uint32_t)))
+
+
+void AAT::AddTelemetryBlocks(void)
+{
+    uint64_t cuAddress;
+    uint32_t numChannels;
+    uint32_t channel;
+    char blockName[XLNX_TELEMETRY_MAX_BLOCK_NAME_LENGTH];
+
+    //NOTE - the status/stats outputs of the HLS kernels are plain (ap_none) registers, so reading them,
+    //       or any of the unused words between them, has no side effects.  Each latency block runs from the
+    //       egress count to the ingress sum so that it holds both probe summaries read by GetStats.  The bin
+    //       registers inside it are captured too, but only hold whichever bin the latency control register
+    //       last selected, so they are not meaningful in a snapshot.
+
+
+    if (lineHandler.GetCUAddress(&cuAddress) == XLNX_OK)
+    {
+        telemetry.AddBlock("linehandler.stats",     cuAddress + XLNX_LINE_HANDLER_STATS_RX_WORDS_COUNT_0_OFFSET,
+                           TELEMETRY_NUM_WORDS(XLNX_LINE_HANDLER_STATS_RX_WORDS_COUNT_0_OFFSET, XLNX_LINE_HANDLER_STATS_CLOCK_TICK_EVENTS_COUNT_OFFSET));
+
+        telemetry.AddBlock("linehandler.latency",   cuAddress + XLNX_LINE_HANDLER_STATS_LATENCY_COUNT_OFFSET,
+                           TELEMETRY_NUM_WORDS(XLNX_LINE_HANDLER_STATS_LATENCY_COUNT_OFFSET, XLNX_LINE_HANDLER_STATS_INGRESS_LATENCY_SUM_UPPER_OFFSET));
+    }
+
+
+
+    if (feedHandler.GetCUAddress(&cuAddress) == XLNX_OK)
+    {
+        telemetry.AddBlock("feedhandler.stats",     cuAddress + XLNX_FEED_HANDLER_STATS_PROCESSED_WORDS_COUNT_OFFSET,
+                           TELEMETRY_NUM_WORDS(XLNX_FEED_HANDLER_STATS_PROCESSED_WORDS_COUNT_OFFSET, XLNX_FEED_HANDLER_STATS_CLOCK_TICK_COUNT_OFFSET));
+
+        telemetry.AddBlock("feedhandler.latency",   cuAddress + XLNX_FEED_HANDLER_STATS_LATENCY_COUNT_OFFSET,
+                           TELEMETRY_NUM_WORDS(XLNX_FEED_HANDLER_STATS_LATENCY_COUNT_OFFSET, XLNX_FEED_HANDLER_STATS_INGRESS_LATENCY_SUM_UPPER_OFFSET));
+    }
+
+
+
+    if (orderBook.GetCUAddress(&cuAddress) == XLNX_OK)
+    {
+        telemetry.AddBlock("orderbook.stats",       cuAddress + XLNX_ORDER_BOOK_STATUS_FLAGS_OFFSET,
+                           TELEMETRY_NUM_WORDS(XLNX_ORDER_BOOK_STATUS_FLAGS_OFFSET, XLNX_ORDER_BOOK_CLOCK_TICK_GEN_EVENTS_COUNT_OFFSET));
+
+        telemetry.AddBlock("orderbook.latency",     cuAddress + XLNX_ORDER_BOOK_STATS_LATENCY_COUNT_OFFSET,
+                           TELEMETRY_NUM_WORDS(XLNX_ORDER_BOOK_STATS_LATENCY_COUNT_OFFSET, XLNX_ORDER_BOOK_STATS_INGRESS_LATENCY_SUM_UPPER_OFFSET));
+    }
+
+
+
+    if (dataMover.GetCUAddress(&cuAddress) == XLNX_OK)
+    {
+        telemetry.AddBlock("datamover.stats",       cuAddress + XLNX_ORDER_BOOK_DATA_MOVER_STATUS_OFFSET,
+                           TELEMETRY_NUM_WORDS(XLNX_ORDER_BOOK_DATA_MOVER_STATUS_OFFSET, XLNX_ORDER_BOOK_DATA_MOVER_CREDIT_STALL_OFFSET));
+    }
+
+
+
+    if (pricingEngine.GetCUAddress(&cuAddress) == XLNX_OK)
+    {
+        telemetry.AddBlock("pricingengine.stats",   cuAddress + XLNX_PRICING_ENGINE_STATUS_FLAGS_OFFSET,
+                           TELEMETRY_NUM_WORDS(XLNX_PRICING_ENGINE_STATUS_FLAGS_OFFSET, XLNX_PRICING_ENGINE_STATS_STRATEGY_CUSTOM_COUNT_OFFSET));
+
+        telemetry.AddBlock("pricingengine.exec",    cuAddress + XLNX_PRICING_ENGINE_STATS_EXEC_REPORT_COUNT_OFFSET,
+                           TELEMETRY_NUM_WORDS(XLNX_PRICING_ENGINE_STATS_EXEC_REPORT_COUNT_OFFSET, XLNX_PRICING_ENGINE_STATS_EXEC_UNMATCHED_COUNT_OFFSET));
+
+        //also takes in the per-strategy latency summaries that follow the ingress probe
+        telemetry.AddBlock("pricingengine.latency", cuAddress + XLNX_PRICING_ENGINE_STATS_LATENCY_COUNT_OFFSET,
+                           TELEMETRY_NUM_WORDS(XLNX_PRICING_ENGINE_STATS_LATENCY_COUNT_OFFSET,
+                                               XLNX_PRICING_ENGINE_STATS_STRATEGY_LATENCY_BASE_OFFSET + (2 * XLNX_PRICING_ENGINE_STATS_STRATEGY_LATENCY_STRIDE) + XLNX_PRICING_ENGINE_STATS_STRATEGY_LATENCY_SUM_UPPER_OFFSET));
+    }
+
+
+
+    if (riskEngine.GetCUAddress(&cuAddress) == XLNX_OK)
+    {
+        telemetry.AddBlock("riskengine.stats",      cuAddress + XLNX_RISK_ENGINE_STATUS_FLAGS_OFFSET,
+                           TELEMETRY_NUM_WORDS(XLNX_RISK_ENGINE_STATUS_FLAGS_OFFSET, XLNX_RISK_ENGINE_STATS_REJECT_GLOBAL_RATE_COUNT_OFFSET));
+
+        telemetry.AddBlock("riskengine.latency",    cuAddress + XLNX_RISK_ENGINE_STATS_LATENCY_COUNT_OFFSET,
+                           TELEMETRY_NUM_WORDS(XLNX_RISK_ENGINE_STATS_LATENCY_COUNT_OFFSET, XLNX_RISK_ENGINE_STATS_INGRESS_LATENCY_SUM_UPPER_OFFSET));
+    }
+
+
+
+    if (orderEntry.GetCUAddress(&cuAddress) == XLNX_OK)
+    {
+        telemetry.AddBlock("orderentry.stats",      cuAddress + XLNX_ORDER_ENTRY_STATUS_FLAGS_OFFSET,
+                           TELEMETRY_NUM_WORDS(XLNX_ORDER_ENTRY_STATUS_FLAGS_OFFSET, XLNX_ORDER_ENTRY_STATS_RX_EXEC_REJECTS_COUNT_OFFSET));
+
+        telemetry.AddBlock("orderentry.latency",    cuAddress + XLNX_ORDER_ENTRY_STATS_LATENCY_COUNT_OFFSET,
+                           TELEMETRY_NUM_WORDS(XLNX_ORDER_ENTRY_STATS_LATENCY_COUNT_OFFSET, XLNX_ORDER_ENTRY_STATS_INGRESS_LATENCY_SUM_UPPER_OFFSET));
+    }
+
+
+
+    if ((ethernet.GetCUAddress(&cuAddress) == XLNX_OK) && (ethernet.GetNumSupportedChannels(&numChannels) == XLNX_OK))
+    {
+        for (channel = 0; channel < numChannels; channel++)
+        {
+            snprintf(blockName, sizeof(blockName), "ethernet.ch%u", channel);
+
+            telemetry.AddBlock(blockName,           cuAddress + XLNX_ETHERNET_CHANNEL_STATUS_BLOCK_LOCK_OFFSET(channel),
+                               TELEMETRY_NUM_WORDS(XLNX_ETHERNET_CHANNEL_STATUS_BLOCK_LOCK_OFFSET(channel), XLNX_ETHERNET_CHANNEL_STATUS_TX_FIFO_UNDERFLOW_COUNT_OFFSET(channel)));
+        }
+    }
+
+
+
+    AddTCPUDPIPTelemetryBlocks(&ingressTCPUDPIP0,   "udpip0");
+    AddTCPUDPIPTelemetryBlocks(&ingressTCPUDPIP1,   "udpip1");
+    AddTCPUDPIPTelemetryBlocks(&egressTCPUDPIP,     "egress");
+}
+
+
+
+
+
+void AAT::AddTCPUDPIPTelemetryBlocks(TCPUDPIP* pTCPUDPIP, const char* prefix)
+{
+    uint64_t cuAddress;
+    bool bIsSynthesized;
+    char blockName[XLNX_TELEMETRY_MAX_BLOCK_NAME_LENGTH];
+
+    if (pTCPUDPIP->GetCUAddress(&cuAddress) == XLNX_OK)
+    {
+        snprintf(blockName, sizeof(blockName), "%s.ip", prefix);
+        telemetry.AddBlock(blockName,               cuAddress + XLNX_TCP_UDP_IP_IP_HANDLER_STATS_IPINHDRERRORS,
+                           TELEMETRY_NUM_WORDS(XLNX_TCP_UDP_IP_IP_HANDLER_STATS_IPINHDRERRORS, XLNX_TCP_UDP_IP_IP_HANDLER_STATS_IPINRECEIVES));
+
+        snprintf(blockName, sizeof(blockName), "%s.mac", prefix);
+        telemetry.AddBlock(blockName,               cuAddress + XLNX_TCP_UDP_IP_MAC_IP_ENCODER_STATS_IPV4_PACKETS_SENT,
+                           TELEMETRY_NUM_WORDS(XLNX_TCP_UDP_IP_MAC_IP_ENCODER_STATS_IPV4_PACKETS_SENT, XLNX_TCP_UDP_IP_MAC_IP_ENCODER_STATS_PACKETS_DROPPED));
+
+        pTCPUDPIP->IsUDPSynthesized(&bIsSynthesized);
+        if (bIsSynthesized)
+        {
+            snprintf(blockName, sizeof(blockName), "%s.udp", prefix);
+            telemetry.AddBlock(blockName,           cuAddress + XLNX_TCP_UDP_IP_UDP_STATS_DATAGRAMS_TRANSMITTED,
+                               TELEMETRY_NUM_WORDS(XLNX_TCP_UDP_IP_UDP_STATS_DATAGRAMS_TRANSMITTED, XLNX_TCP_UDP_IP_UDP_STATS_DATAGRAMS_RECEIVED_INVALID_GROUP));
+        }
+
+        pTCPUDPIP->IsTCPSynthesized(&bIsSynthesized);
+        if (bIsSynthesized)
+        {
+            snprintf(blockName, sizeof(blockName), "%s.tcp", prefix);
+            telemetry.AddBlock(blockName,           cuAddress + XLNX_TCP_UDP_IP_TCP_STATS_TCPINSEGS,
+                               TELEMETRY_NUM_WORDS(XLNX_TCP_UDP_IP_TCP_STATS_TCPINSEGS, XLNX_TCP_UDP_IP_TCP_STATS_TCPCURRESTAB));
+        }
+    }
+}
+
+
+
+
+
+typedef struct
+{
+    const char* name;
+    const char* blockName;
+    uint32_t wordIndex;
+    bool bIsGauge;
+
+}MetricDefinition;
+
+
+#define METRIC_COUNTER(NAME, BLOCK, FIRST, OFFSET)  { NAME, BLOCK, TELEMETRY_WORD_INDEX(FIRST, OFFSET), false }
+#define METRIC_GAUGE(NAME, BLOCK, FIRST, OFFSET)    { NAME, BLOCK, TELEMETRY_WORD_INDEX(FIRST, OFFSET), true }
+
+
+static const MetricDefinition KERNEL_METRICS[] =
+{
+    METRIC_COUNTER("feedhandler.rx_packets",            "feedhandler.stats",    XLNX_FEED_HANDLER_STATS_PROCESSED_WORDS_COUNT_OFFSET,   XLNX_FEED_HANDLER_STATS_PROCESSED_PACKETS_COUNT_OFFSET),
+    METRIC_COUNTER("feedhandler.rx_binary_messages",    "feedhandler.stats",    XLNX_FEED_HANDLER_STATS_PROCESSED_WORDS_COUNT_OFFSET,   XLNX_FEED_HANDLER_STATS_PROCESSED_BINARY_MSG_COUNT_OFFSET),
+    METRIC_COUNTER("feedhandler.tx_operations",         "feedhandler.stats",    XLNX_FEED_HANDLER_STATS_PROCESSED_WORDS_COUNT_OFFSET,   XLNX_FEED_HANDLER_STATS_TX_OPERATION_COUNT_OFFSET),
+
+    METRIC_COUNTER("orderbook.rx_operations",           "orderbook.stats",      XLNX_ORDER_BOOK_STATUS_FLAGS_OFFSET,                    XLNX_ORDER_BOOK_STATS_RX_OPERATIONS_COUNT_OFFSET),
+    METRIC_COUNTER("orderbook.process_operations",      "orderbook.stats",      XLNX_ORDER_BOOK_STATUS_FLAGS_OFFSET,                    XLNX_ORDER_BOOK_STATS_PROCESS_OPERATIONS_COUNT_OFFSET),
+    METRIC_COUNTER("orderbook.invalid_operations",      "orderbook.stats",      XLNX_ORDER_BOOK_STATUS_FLAGS_OFFSET,                    XLNX_ORDER_BOOK_STATS_INVALID_OPERATIONS_COUNT_OFFSET),
+    METRIC_COUNTER("orderbook.responses_sent",          "orderbook.stats",      XLNX_ORDER_BOOK_STATUS_FLAGS_OFFSET,                    XLNX_ORDER_BOOK_RESPONSE_SENT_COUNT_OFFSET),
+
+    METRIC_COUNTER("datamover.credit_stalls",           "datamover.stats",      XLNX_ORDER_BOOK_DATA_MOVER_STATUS_OFFSET,               XLNX_ORDER_BOOK_DATA_MOVER_CREDIT_STALL_OFFSET),
+
+    METRIC_COUNTER("pricingengine.rx_responses",        "pricingengine.stats",  XLNX_PRICING_ENGINE_STATUS_FLAGS_OFFSET,                XLNX_PRICING_ENGINE_STATS_RX_RESPONSE_COUNT_OFFSET),
+    METRIC_COUNTER("pricingengine.tx_operations",       "pricingengine.stats",  XLNX_PRICING_ENGINE_STATUS_FLAGS_OFFSET,                XLNX_PRICING_ENGINE_STATS_TX_OPERATIONS_COUNT_OFFSET),
+    METRIC_COUNTER("pricingengine.credit_stalls",       "pricingengine.stats",  XLNX_PRICING_ENGINE_STATUS_FLAGS_OFFSET,                XLNX_PRICING_ENGINE_STATS_CREDIT_STALL_COUNT_OFFSET),
+    METRIC_GAUGE  ("pricingengine.credit_available",    "pricingengine.stats",  XLNX_PRICING_ENGINE_STATUS_FLAGS_OFFSET,                XLNX_PRICING_ENGINE_STATS_CREDIT_AVAILABLE_OFFSET),
+    METRIC_COUNTER("pricingengine.exec_reports",        "pricingengine.exec",   XLNX_PRICING_ENGINE_STATS_EXEC_REPORT_COUNT_OFFSET,     XLNX_PRICING_ENGINE_STATS_EXEC_REPORT_COUNT_OFFSET),
+
+    METRIC_COUNTER("riskengine.rx_operations",          "riskengine.stats",     XLNX_RISK_ENGINE_STATUS_FLAGS_OFFSET,                   XLNX_RISK_ENGINE_STATS_RX_OPERATIONS_COUNT_OFFSET),
+    METRIC_COUNTER("riskengine.tx_operations",          "riskengine.stats",     XLNX_RISK_ENGINE_STATUS_FLAGS_OFFSET,                   XLNX_RISK_ENGINE_STATS_TX_OPERATIONS_COUNT_OFFSET),
+    METRIC_COUNTER("riskengine.rejects_quantity",       "riskengine.stats",     XLNX_RISK_ENGINE_STATUS_FLAGS_OFFSET,                   XLNX_RISK_ENGINE_STATS_REJECT_QUANTITY_COUNT_OFFSET),
+    METRIC_COUNTER("riskengine.rejects_notional",       "riskengine.stats",     XLNX_RISK_ENGINE_STATUS_FLAGS_OFFSET,                   XLNX_RISK_ENGINE_STATS_REJECT_NOTIONAL_COUNT_OFFSET),
+    METRIC_COUNTER("riskengine.rejects_price_band",     "riskengine.stats",     XLNX_RISK_ENGINE_STATUS_FLAGS_OFFSET,                   XLNX_RISK_ENGINE_STATS_REJECT_PRICE_BAND_COUNT_OFFSET),
+    METRIC_COUNTER("riskengine.rejects_position",       "riskengine.stats",     XLNX_RISK_ENGINE_STATUS_FLAGS_OFFSET,                   XLNX_RISK_ENGINE_STATS_REJECT_POSITION_COUNT_OFFSET),
+    METRIC_COUNTER("riskengine.rejects_rate",           "riskengine.stats",     XLNX_RISK_ENGINE_STATUS_FLAGS_OFFSET,                   XLNX_RISK_ENGINE_STATS_REJECT_RATE_COUNT_OFFSET),
+    METRIC_COUNTER("riskengine.rejects_global_rate",    "riskengine.stats",     XLNX_RISK_ENGINE_STATUS_FLAGS_OFFSET,                   XLNX_RISK_ENGINE_STATS_REJECT_GLOBAL_RATE_COUNT_OFFSET),
+
+    METRIC_COUNTER("orderentry.rx_operations",          "orderentry.stats",     XLNX_ORDER_ENTRY_STATUS_FLAGS_OFFSET,                   XLNX_ORDER_ENTRY_STATS_RX_OPERATIONS_COUNT_OFFSET),
+    METRIC_COUNTER("orderentry.tx_orders",              "orderentry.stats",     XLNX_ORDER_ENTRY_STATUS_FLAGS_OFFSET,                   XLNX_ORDER_ENTRY_STATS_TX_MESSAGES_COUNT_OFFSET),
+    METRIC_COUNTER("orderentry.tx_dropped",             "orderentry.stats",     XLNX_ORDER_ENTRY_STATUS_FLAGS_OFFSET,                   XLNX_ORDER_ENTRY_STATS_TX_DROPPED_MSG_COUNT_OFFSET),
+    METRIC_COUNTER("orderentry.rx_exec_reports",        "orderentry.stats",     XLNX_ORDER_ENTRY_STATUS_FLAGS_OFFSET,                   XLNX_ORDER_ENTRY_STATS_RX_EXEC_REPORTS_COUNT_OFFSET),
+    METRIC_COUNTER("orderentry.rx_exec_rejects",        "orderentry.stats",     XLNX_ORDER_ENTRY_STATUS_FLAGS_OFFSET,                   XLNX_ORDER_ENTRY_STATS_RX_EXEC_REJECTS_COUNT_OFFSET),
+};
+
+
+static const uint32_t NUM_KERNEL_METRICS = (uint32_t)(sizeof(KERNEL_METRICS) / sizeof(KERNEL_METRICS[0]));
+
+
+//Network metrics are per channel/per block, so are named after the telemetry block they come from
+static const MetricDefinition ETHERNET_CHANNEL_METRICS[] =
+{
+    METRIC_COUNTER("rx_overflow_drops",     nullptr,    XLNX_ETHERNET_CHANNEL_STATUS_BLOCK_LOCK_OFFSET(0),      XLNX_ETHERNET_CHANNEL_STATUS_RX_OVERFLOW_COUNT_OFFSET(0)),
+    METRIC_COUNTER("rx_unicast_drops",      nullptr,    XLNX_ETHERNET_CHANNEL_STATUS_BLOCK_LOCK_OFFSET(0),      XLNX_ETHERNET_CHANNEL_STATUS_RX_UNICAST_DROP_COUNT_OFFSET(0)),
+    METRIC_COUNTER("rx_multicast_drops",    nullptr,    XLNX_ETHERNET_CHANNEL_STATUS_BLOCK_LOCK_OFFSET(0),      XLNX_ETHERNET_CHANNEL_STATUS_RX_MULTICAST_DROP_COUNT_OFFSET(0)),
+    METRIC_COUNTER("rx_oversized_drops",    nullptr,    XLNX_ETHERNET_CHANNEL_STATUS_BLOCK_LOCK_OFFSET(0),      XLNX_ETHERNET_CHANNEL_STATUS_RX_OVERSIZED_DROP_COUNT_OFFSET(0)),
+    METRIC_COUNTER("tx_fifo_underflows",    nullptr,    XLNX_ETHERNET_CHANNEL_STATUS_BLOCK_LOCK_OFFSET(0),      XLNX_ETHERNET_CHANNEL_STATUS_TX_FIFO_UNDERFLOW_COUNT_OFFSET(0)),
+};
+
+
+static const MetricDefinition TCP_UDP_IP_METRICS[] =
+{
+    METRIC_COUNTER("rx_packets",            "ip",       XLNX_TCP_UDP_IP_IP_HANDLER_STATS_IPINHDRERRORS,         XLNX_TCP_UDP_IP_IP_HANDLER_STATS_IPINRECEIVES),
+    METRIC_COUNTER("rx_header_errors",      "ip",       XLNX_TCP_UDP_IP_IP_HANDLER_STATS_IPINHDRERRORS,         XLNX_TCP_UDP_IP_IP_HANDLER_STATS_IPINHDRERRORS),
+    METRIC_COUNTER("tx_packets",            "mac",      XLNX_TCP_UDP_IP_MAC_IP_ENCODER_STATS_IPV4_PACKETS_SENT, XLNX_TCP_UDP_IP_MAC_IP_ENCODER_STATS_IPV4_PACKETS_SENT),
+    METRIC_COUNTER("tx_dropped",            "mac",      XLNX_TCP_UDP_IP_MAC_IP_ENCODER_STATS_IPV4_PACKETS_SENT, XLNX_TCP_UDP_IP_MAC_IP_ENCODER_STATS_PACKETS_DROPPED),
+    METRIC_COUNTER("udp_rx_datagrams",      "udp",      XLNX_TCP_UDP_IP_UDP_STATS_DATAGRAMS_TRANSMITTED,        XLNX_TCP_UDP_IP_UDP_STATS_DATAGRAMS_RECEIVED),
+    METRIC_COUNTER("udp_tx_datagrams",      "udp",      XLNX_TCP_UDP_IP_UDP_STATS_DATAGRAMS_TRANSMITTED,        XLNX_TCP_UDP_IP_UDP_STATS_DATAGRAMS_TRANSMITTED),
+    METRIC_COUNTER("tcp_rx_segments",       "tcp",      XLNX_TCP_UDP_IP_TCP_STATS_TCPINSEGS,                    XLNX_TCP_UDP_IP_TCP_STATS_TCPINSEGS),
+    METRIC_COUNTER("tcp_tx_segments",       "tcp",      XLNX_TCP_UDP_IP_TCP_STATS_TCPINSEGS,                    XLNX_TCP_UDP_IP_TCP_STATS_TCPOUTSEGS),
+    METRIC_COUNTER("tcp_retransmits",       "tcp",      XLNX_TCP_UDP_IP_TCP_STATS_TCPINSEGS,                    XLNX_TCP_UDP_IP_TCP_STATS_TCPRETRANSSEGS),
+    METRIC_GAUGE  ("tcp_established",       "tcp",      XLNX_TCP_UDP_IP_TCP_STATS_TCPINSEGS,                    XLNX_TCP_UDP_IP_TCP_STATS_TCPCURRESTAB),
+};
+
+
+static const char* TCP_UDP_IP_PREFIXES[] = { "udpip0", "udpip1", "egress" };
+
+
+
+
+void AAT::AddMetrics(void)
+{
+    const MetricDefinition* pDefinition;
+    char name[XLNX_METRICS_MAX_NAME_LENGTH];
+    char blockName[XLNX_TELEMETRY_MAX_BLOCK_NAME_LENGTH];
+    uint32_t channel;
+    uint32_t i;
+    uint32_t j;
+
+    //NOTE - metrics for blocks that were not added to telemetry (kernel not in this load, TCP/UDP not
+    //       synthesized etc.) are rejected by the exporter, so the tables can list everything
+
+
+    for (i = 0; i < NUM_KERNEL_METRICS; i++)
+    {
+        pDefinition = &KERNEL_METRICS[i];
+
+        if (pDefinition->bIsGauge)
+        {
+            metrics.AddGauge(pDefinition->name, pDefinition->blockName, pDefinition->wordIndex);
+        }
+        else
+        {
+            metrics.AddCounter(pDefinition->name, pDefinition->blockName, pDefinition->wordIndex);
+        }
+    }
+
+
+
+    for (channel = 0; channel < Ethernet::MAX_SUPPORTED_CHANNELS; channel++)
+    {
+        snprintf(blockName, sizeof(blockName), "ethernet.ch%u", channel);
+
+        for (i = 0; i < (sizeof(ETHERNET_CHANNEL_METRICS) / sizeof(ETHERNET_CHANNEL_METRICS[0])); i++)
+        {
+            pDefinition = &ETHERNET_CHANNEL_METRICS[i];
+
+            snprintf(name, sizeof(name), "%s.%s", blockName, pDefinition->name);
+
+            metrics.AddCounter(name, blockName, pDefinition->wordIndex);
+        }
+    }
+
+
+
+    for (j = 0; j < (sizeof(TCP_UDP_IP_PREFIXES) / sizeof(TCP_UDP_IP_PREFIXES[0])); j++)
+    {
+        for (i = 0; i < (sizeof(TCP_UDP_IP_METRICS) / sizeof(TCP_UDP_IP_METRICS[0])); i++)
+        {
+            pDefinition = &TCP_UDP_IP_METRICS[i];
+
+            snprintf(blockName, sizeof(blockName), "%s.%s", TCP_UDP_IP_PREFIXES[j], pDefinition->blockName);
+            snprintf(name, sizeof(name), "%s.%s", TCP_UDP_IP_PREFIXES[j], pDefinition->name);
+
+            if (pDefinition->bIsGauge)
+            {
+                metrics.AddGauge(name, blockName, pDefinition->wordIndex);
+            }
+            else
+            {
+                metrics.AddCounter(name, blockName, pDefinition->wordIndex);
+            }
+        }
+    }
+}
+
+
+
+
+
+
 uint32_t AAT::SetMACAddressesFromNVRAM(DeviceInterface* pDeviceInterface)
 {
     uint32_t retval = XLNX_OK;
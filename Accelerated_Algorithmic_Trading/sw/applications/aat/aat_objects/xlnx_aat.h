@@ -27,6 +27,7 @@
 #include "xlnx_order_book.h"
 #include "xlnx_order_book_data_mover.h"
 #include "xlnx_pricing_engine.h"
+#include "xlnx_risk_engine.h"
 #include "xlnx_order_entry.h"
 #include "xlnx_clock_tick_generator.h"
 #include "xlnx_line_handler.h"
@@ -34,6 +35,9 @@
 #include "xlnx_network_capture.h"
 #include "xlnx_network_tap.h"
 
+#include "xlnx_telemetry.h"
+#include "xlnx_metrics_exporter.h"
+
 
 namespace XLNX
 {
@@ -83,6 +87,14 @@ protected:
 	//TCPUDPIP block and the relevant Ethernet channel.
 	void CheckForSufficientMACAddresses(MACAddresses* pMACAddresses);
 
+	//Registers the status/stats register blocks of each datapath kernel that was found in the
+	//loaded design with the telemetry sampler.
+	void AddTelemetryBlocks(void);
+	void AddTCPUDPIPTelemetryBlocks(TCPUDPIP* pTCPUDPIP, const char* prefix);
+
+	//Exports the counters of interest from the blocks registered above as 64-bit values and rates
+	void AddMetrics(void);
+
 
 
 
@@ -97,6 +109,7 @@ public:
 	OrderBook		    orderBook;
     OrderBookDataMover  dataMover;
     PricingEngine	    pricingEngine;
+    RiskEngine          riskEngine;
     OrderEntry		    orderEntry;
     ClockTickGenerator  clockTickGenerator;
 	LineHandler			lineHandler;
@@ -105,6 +118,10 @@ public:
 	NetworkCapture      networkCapture;
 	NetworkTap			networkTap;
 
+	//Snapshots the kernel stats registers into shared memory for the shell and external readers
+	Telemetry			telemetry;
+	MetricsExporter		metrics;
+
 
 
 
@@ -36,6 +36,14 @@
 #include "xlnx_shell_network_capture.h"
 #include "xlnx_shell_network_tap.h"
 
+#include "xlnx_shell_telemetry.h"
+#include "xlnx_shell_metrics.h"
+
+#ifdef XLNX_AAT_EMULATION
+#include "xlnx_aat_emulation.h"
+#include "xlnx_shell_aat_emulation.h"
+#endif
+
 using namespace XLNX;
 
 
@@ -50,6 +58,10 @@ Shell g_shell;
 DeviceManager g_deviceManager;
 AAT g_aat;
 
+#ifdef XLNX_AAT_EMULATION
+AATEmulation g_emulation;
+#endif
+
 
 
 
@@ -81,6 +93,9 @@ typedef struct
 
 	bool bInteractiveMode;
 
+	bool bEmulationSourceSupplied;
+	char* emulationSource;
+
 }CommandLineOptions;
 
 
@@ -102,6 +117,9 @@ void PrintUsage(char* progName)
 	printf("Usage: %s [-d deviceindex] [-i] [cmd]\n", progName);
 	printf("[-d] device selection (when multiple cards are present)\n");
 	printf("[-i] forces the shell in interactive mode instead of exiting (i.e. one-shot mode) after executing the supplied command\n");
+#ifdef XLNX_AAT_EMULATION
+	printf("[-e source] starts the emulated pipeline from a PCAP file or udp:[group:]port\n");
+#endif
 }
 
 
@@ -191,6 +209,12 @@ DeviceInterface* ChooseDeviceInterface(CommandLineOptions* pCommandLineOptions)
 
 
 
+#ifdef XLNX_AAT_EMULATION
+	//the emulated kernels only exist behind the virtual device
+	pCommandLineOptions->bDeviceIndexSupplied = true;
+	pCommandLineOptions->deviceIndex = 0;
+#endif
+
 	if (pCommandLineOptions->bDeviceIndexSupplied)
 	{
 		if (pCommandLineOptions->deviceIndex == 0) //special case - 0 means virtual device
@@ -265,6 +289,7 @@ bool ParseCommandLineOptions(int argc, char* argv[], CommandLineOptions* pComman
 	pCommandLineOptions->bDeviceIndexSupplied = false;
 	pCommandLineOptions->bInlineCommandSupplied = false;
 	pCommandLineOptions->bInteractiveMode = false;
+	pCommandLineOptions->bEmulationSourceSupplied = false;
 
 	//start at 1 to skip the program name....
 	for (uint32_t currentArgIndex = 1; currentArgIndex < (uint32_t)argc; /*no increment*/) 
@@ -310,6 +335,24 @@ bool ParseCommandLineOptions(int argc, char* argv[], CommandLineOptions* pComman
 			pCommandLineOptions->bInteractiveMode = true;
 			currentArgIndex++;
 		}
+#ifdef XLNX_AAT_EMULATION
+		else if (strcmp(argv[currentArgIndex], "-e") == 0)
+		{
+			currentArgIndex++;
+
+			if (currentArgIndex < (uint32_t)argc)
+			{
+				pCommandLineOptions->emulationSource = argv[currentArgIndex];
+				pCommandLineOptions->bEmulationSourceSupplied = true;
+				currentArgIndex++;
+			}
+			else
+			{
+				printf("Missing -e argument");
+				bValid = false;
+			}
+		}
+#endif
 		else
 		{
 			pCommandLineOptions->bInlineCommandSupplied = true;
@@ -436,10 +479,38 @@ int main(int argc, char* argv[])
 
 
 
+#ifdef XLNX_AAT_EMULATION
+	//The emulated kernels must be attached before the business object probes for its CUs...
+	uint32_t emulationRetval = g_emulation.Initialise((VirtualDeviceInterface*)pDeviceInterface);
+	if (emulationRetval != XLNX_OK)
+	{
+		printf("[ERROR] Failed to initialise emulated pipeline - %s (0x%08X)\n", AATEmulation_ErrorCodeToString(emulationRetval), emulationRetval);
+	}
+#endif
+
+
     //Initialise our main business object...
 	g_aat.Initialise(pDeviceInterface);
 
 
+#ifdef XLNX_AAT_EMULATION
+	if ((emulationRetval == XLNX_OK) && commandLineOptions.bEmulationSourceSupplied)
+	{
+		emulationRetval = g_emulation.SetSource(commandLineOptions.emulationSource);
+
+		if (emulationRetval == XLNX_OK)
+		{
+			emulationRetval = g_emulation.Start();
+		}
+
+		if (emulationRetval != XLNX_OK)
+		{
+			printf("[ERROR] Failed to start emulation source %s - %s (0x%08X)\n", commandLineOptions.emulationSource, AATEmulation_ErrorCodeToString(emulationRetval), emulationRetval);
+		}
+	}
+#endif
+
+
 	// The following is to handle the fact the egress comms block can be either TCP or UDP (depending on how the HW is built)
 	// We will name the shell object the accordingly
 	// NOTE - we are ALWAYS calling the SOFTWARE OBJECT "g_aat.egressTCPUDPIP" in code
@@ -472,6 +543,7 @@ int main(int argc, char* argv[])
 	g_shell.AddObjectCommandTable("orderbook",			&g_aat.orderBook,					XLNX_ORDER_BOOK_COMMAND_TABLE,				XLNX_ORDER_BOOK_COMMAND_TABLE_LENGTH);
 	g_shell.AddObjectCommandTable("datamover",			&g_aat.dataMover,					XLNX_ORDER_BOOK_DATA_MOVER_COMMAND_TABLE,	XLNX_ORDER_BOOK_DATA_MOVER_COMMAND_TABLE_LENGTH);
 	g_shell.AddObjectCommandTable("pricingengine",		&g_aat.pricingEngine,				XLNX_PRICING_ENGINE_COMMAND_TABLE,			XLNX_PRICING_ENGINE_COMMAND_TABLE_LENGTH);
+	g_shell.AddObjectCommandTable("riskengine",			&g_aat.riskEngine,					XLNX_RISK_ENGINE_COMMAND_TABLE,				XLNX_RISK_ENGINE_COMMAND_TABLE_LENGTH);
     g_shell.AddObjectCommandTable("orderentry",			&g_aat.orderEntry,					XLNX_ORDER_ENTRY_COMMAND_TABLE,				XLNX_ORDER_ENTRY_COMMAND_TABLE_LENGTH);
 	g_shell.AddObjectCommandTable(egressCommsShellName, &g_aat.egressTCPUDPIP,				XLNX_TCP_UDP_IP_COMMAND_TABLE,				XLNX_TCP_UDP_IP_COMMAND_TABLE_LENGTH);
 	g_shell.AddObjectCommandTable("clocktickgen",		&g_aat.clockTickGenerator,			XLNX_CLOCK_TICK_GENERATOR_COMMAND_TABLE,	XLNX_CLOCK_TICK_GENERATOR_COMMAND_TABLE_LENGTH);
@@ -480,6 +552,13 @@ int main(int argc, char* argv[])
 	g_shell.AddObjectCommandTable("networkcapture",		&g_aat.networkCapture,				XLNX_NETWORK_CAPTURE_COMMAND_TABLE,			XLNX_NETWORK_CAPTURE_COMMAND_TABLE_LENGTH);	
 	g_shell.AddObjectCommandTable("networktap",			&g_aat.networkTap,					XLNX_NETWORK_TAP_COMMAND_TABLE,				XLNX_NETWORK_TAP_COMMAND_TABLE_LENGTH);
 
+	g_shell.AddObjectCommandTable("telemetry",			&g_aat.telemetry,					XLNX_TELEMETRY_COMMAND_TABLE,				XLNX_TELEMETRY_COMMAND_TABLE_LENGTH);
+	g_shell.AddObjectCommandTable("metrics",			&g_aat.metrics,						XLNX_METRICS_COMMAND_TABLE,					XLNX_METRICS_COMMAND_TABLE_LENGTH);
+
+#ifdef XLNX_AAT_EMULATION
+	g_shell.AddObjectCommandTable("emulation",			&g_emulation,						XLNX_AAT_EMULATION_COMMAND_TABLE,			XLNX_AAT_EMULATION_COMMAND_TABLE_LENGTH);
+#endif
+
 
 	//Bind in the pre and post download handler functions - these will be invoked if the user issues the "download" command to download a bitstream (XCLBIN file).
 	//This allows the software objects to be automtically cleaned up/reinitialised to use the new HW load.
@@ -519,6 +598,10 @@ int main(int argc, char* argv[])
 	//Clean-up our business object..
 	g_aat.Uninitialise();
 
+#ifdef XLNX_AAT_EMULATION
+	g_emulation.Uninitialise();
+#endif
+
 
 	return 0;
 }
\ No newline at end of file
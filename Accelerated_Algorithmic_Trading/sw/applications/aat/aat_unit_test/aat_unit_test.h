@@ -0,0 +1,160 @@
+/*
+ * Copyright 2021 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef AAT_UNIT_TEST_H
+#define AAT_UNIT_TEST_H
+
+#include <cstdio>
+#include <cstdint>
+
+#include <cstring>
+
+#include <chrono>
+#include <string>
+#include <thread>
+
+#include <unistd.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+
+
+
+//Each test function returns the number of checks that failed, so a test keeps going after a failure and
+//reports everything it finds in one run.
+
+#define UNIT_CHECK(numFailures, condition)                                              \
+    do                                                                                  \
+    {                                                                                   \
+        if (!(condition))                                                               \
+        {                                                                               \
+            printf("    [FAIL] %s:%d: %s\n", __FILE__, __LINE__, #condition);          \
+            (numFailures)++;                                                            \
+        }                                                                               \
+    } while (0)
+
+
+
+typedef uint32_t (*UnitTestFunctionType)(void);
+
+
+
+//Polls for something another thread is expected to do, returns false if it has not happened in time.
+template <typename ConditionType>
+bool UnitWaitFor(ConditionType condition, uint32_t timeoutMilliseconds = 2000)
+{
+    std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeoutMilliseconds);
+
+    while (!condition())
+    {
+        if (std::chrono::steady_clock::now() >= deadline)
+        {
+            return false;
+        }
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    return true;
+}
+
+
+
+//Port nothing is currently bound to, for the servers that have to be told which one to use.  type is
+//SOCK_STREAM or SOCK_DGRAM.  Returns 0 if one could not be found.
+inline uint16_t UnitGetFreePort(int type)
+{
+    struct sockaddr_in address;
+    socklen_t addressLength = sizeof(address);
+    uint16_t port = 0;
+    int sock;
+
+    sock = socket(AF_INET, type, 0);
+
+    if (sock >= 0)
+    {
+        memset(&address, 0, sizeof(address));
+        address.sin_family = AF_INET;
+        address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        address.sin_port = 0;
+
+        if ((bind(sock, (struct sockaddr*)&address, sizeof(address)) == 0) &&
+            (getsockname(sock, (struct sockaddr*)&address, &addressLength) == 0))
+        {
+            port = ntohs(address.sin_port);
+        }
+
+        close(sock);
+    }
+
+    return port;
+}
+
+
+
+//TCP connection to a server on this machine, -1 on failure
+inline int UnitConnect(uint16_t port)
+{
+    struct sockaddr_in address;
+    int sock;
+
+    sock = socket(AF_INET, SOCK_STREAM, 0);
+
+    memset(&address, 0, sizeof(address));
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    address.sin_port = htons(port);
+
+    if ((sock >= 0) && (connect(sock, (struct sockaddr*)&address, sizeof(address)) != 0))
+    {
+        close(sock);
+        sock = -1;
+    }
+
+    return sock;
+}
+
+
+
+//everything the server sends until it closes the connection
+inline std::string UnitReadAll(int sock)
+{
+    std::string text;
+    char buffer[65536];
+    ssize_t numBytesRead;
+
+    while ((numBytesRead = recv(sock, buffer, sizeof(buffer), 0)) > 0)
+    {
+        text.append(buffer, (size_t)numBytesRead);
+    }
+
+    return text;
+}
+
+
+
+uint32_t TestMetricsExporter(void);
+uint32_t TestBufferPool(void);
+uint32_t TestSocketReactor(void);
+uint32_t TestTCPServer(void);
+uint32_t TestUDPServer(void);
+uint32_t TestTelemetryRegisterSnapshot(void);
+uint32_t TestCaptureSegments(void);
+uint32_t TestCaptureFlushTimeout(void);
+uint32_t TestFeedDecoder(void);
+
+
+
+#endif
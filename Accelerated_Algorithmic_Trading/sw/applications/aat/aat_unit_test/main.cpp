@@ -0,0 +1,93 @@
+/*
+ * Copyright 2021 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cstdio>
+#include <cstdint>
+#include <cstring>
+
+#include "aat_unit_test.h"
+
+
+
+
+typedef struct
+{
+    const char* name;
+    UnitTestFunctionType function;
+
+}UnitTest;
+
+
+
+static const UnitTest s_tests[] =
+{
+    { "buffer_pool",            TestBufferPool },
+    { "socket_reactor",         TestSocketReactor },
+    { "tcp_server",             TestTCPServer },
+    { "udp_server",             TestUDPServer },
+    { "metrics_exporter",       TestMetricsExporter },
+    { "register_snapshot",      TestTelemetryRegisterSnapshot },
+    { "capture_segments",       TestCaptureSegments },
+    { "capture_flush",          TestCaptureFlushTimeout },
+    { "feed_decoder",           TestFeedDecoder },
+};
+
+static const uint32_t NUM_TESTS = sizeof(s_tests) / sizeof(s_tests[0]);
+
+
+
+
+int main(int argc, char* argv[])
+{
+    uint32_t numFailures;
+    uint32_t numFailedTests = 0;
+    uint32_t numRun = 0;
+    uint32_t i;
+
+    for (i = 0; i < NUM_TESTS; i++)
+    {
+        //optional argument runs a single test by name
+        if ((argc > 1) && (strcmp(argv[1], s_tests[i].name) != 0))
+        {
+            continue;
+        }
+
+        printf("[RUN ] %s\n", s_tests[i].name);
+
+        numFailures = s_tests[i].function();
+        numRun++;
+
+        if (numFailures == 0)
+        {
+            printf("[PASS] %s\n", s_tests[i].name);
+        }
+        else
+        {
+            printf("[FAIL] %s (%u checks failed)\n", s_tests[i].name, numFailures);
+            numFailedTests++;
+        }
+    }
+
+
+    printf("%u of %u tests passed\n", numRun - numFailedTests, numRun);
+
+    if ((numRun == 0) || (numFailedTests != 0))
+    {
+        return 1;
+    }
+
+    return 0;
+}
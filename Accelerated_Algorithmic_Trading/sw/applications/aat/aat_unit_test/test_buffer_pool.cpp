@@ -0,0 +1,123 @@
+/*
+ * Copyright 2021 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cstring>
+
+#include "xlnx_buffer_pool.h"
+
+#include "aat_unit_test.h"
+
+using namespace XLNX;
+
+
+
+#define TEST_NUM_BUFFERS    (3)
+#define TEST_BUFFER_SIZE    (64)
+
+
+
+
+uint32_t TestBufferPool(void)
+{
+    BufferPool pool;
+    uint8_t* pBuffers[TEST_NUM_BUFFERS];
+    uint8_t* pBuffer = nullptr;
+    uint32_t bufferSize = 0;
+    uint32_t numFree = 0;
+    uint32_t numFailures = 0;
+    uint32_t i;
+    uint32_t j;
+
+
+    //nothing to hand out until it is initialised
+    UNIT_CHECK(numFailures, pool.Acquire(&pBuffer) == XLNX_SOCKET_ERROR_BUFFER_POOL_NOT_INITIALISED);
+    UNIT_CHECK(numFailures, pool.Initialise(0, TEST_BUFFER_SIZE) == XLNX_SOCKET_ERROR_INVALID_PARAMETER);
+    UNIT_CHECK(numFailures, pool.Initialise(TEST_NUM_BUFFERS, 0) == XLNX_SOCKET_ERROR_INVALID_PARAMETER);
+
+
+    UNIT_CHECK(numFailures, pool.Initialise(TEST_NUM_BUFFERS, TEST_BUFFER_SIZE) == XLNX_OK);
+
+    pool.GetBufferSize(&bufferSize);
+    pool.GetNumFreeBuffers(&numFree);
+
+    UNIT_CHECK(numFailures, bufferSize == TEST_BUFFER_SIZE);
+    UNIT_CHECK(numFailures, numFree == TEST_NUM_BUFFERS);
+
+
+    //every buffer can be taken, and no two of them overlap
+    for (i = 0; i < TEST_NUM_BUFFERS; i++)
+    {
+        pBuffers[i] = nullptr;
+        UNIT_CHECK(numFailures, pool.Acquire(&pBuffers[i]) == XLNX_OK);
+        UNIT_CHECK(numFailures, pBuffers[i] != nullptr);
+    }
+
+    for (i = 0; i < TEST_NUM_BUFFERS; i++)
+    {
+        for (j = i + 1; j < TEST_NUM_BUFFERS; j++)
+        {
+            UNIT_CHECK(numFailures, (pBuffers[i] + TEST_BUFFER_SIZE <= pBuffers[j]) || (pBuffers[j] + TEST_BUFFER_SIZE <= pBuffers[i]));
+        }
+
+        memset(pBuffers[i], (int)i, TEST_BUFFER_SIZE);
+    }
+
+    for (i = 0; i < TEST_NUM_BUFFERS; i++)
+    {
+        UNIT_CHECK(numFailures, (pBuffers[i][0] == i) && (pBuffers[i][TEST_BUFFER_SIZE - 1] == i));
+    }
+
+
+    //empty pool says so rather than allocating
+    UNIT_CHECK(numFailures, pool.Acquire(&pBuffer) == XLNX_SOCKET_ERROR_BUFFER_POOL_EMPTY);
+
+    pool.GetNumFreeBuffers(&numFree);
+    UNIT_CHECK(numFailures, numFree == 0);
+
+
+    //a released buffer is the next one handed out
+    UNIT_CHECK(numFailures, pool.Release(pBuffers[1]) == XLNX_OK);
+
+    pool.GetNumFreeBuffers(&numFree);
+    UNIT_CHECK(numFailures, numFree == 1);
+
+    UNIT_CHECK(numFailures, pool.Acquire(&pBuffer) == XLNX_OK);
+    UNIT_CHECK(numFailures, pBuffer == pBuffers[1]);
+
+
+    //pointers that did not come from the pool are refused
+    UNIT_CHECK(numFailures, pool.Release((uint8_t*)&numFree) == XLNX_SOCKET_ERROR_INVALID_PARAMETER);
+    UNIT_CHECK(numFailures, pool.Release(pBuffers[0] + 1) == XLNX_SOCKET_ERROR_INVALID_PARAMETER);
+
+    pool.GetNumFreeBuffers(&numFree);
+    UNIT_CHECK(numFailures, numFree == 0);
+
+
+    for (i = 0; i < TEST_NUM_BUFFERS; i++)
+    {
+        UNIT_CHECK(numFailures, pool.Release(pBuffers[i]) == XLNX_OK);
+    }
+
+    pool.GetNumFreeBuffers(&numFree);
+    UNIT_CHECK(numFailures, numFree == TEST_NUM_BUFFERS);
+
+
+    UNIT_CHECK(numFailures, pool.Uninitialise() == XLNX_OK);
+    UNIT_CHECK(numFailures, pool.Acquire(&pBuffer) == XLNX_SOCKET_ERROR_BUFFER_POOL_NOT_INITIALISED);
+    UNIT_CHECK(numFailures, pool.Release(pBuffers[0]) == XLNX_SOCKET_ERROR_INVALID_PARAMETER);
+
+    return numFailures;
+}
@@ -0,0 +1,386 @@
+/*
+ * Copyright 2021 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include <string>
+#include <vector>
+
+#include <unistd.h>
+#include <sys/stat.h>
+
+#include "xlnx_network_capture_pcap_headers.h"
+#include "xlnx_network_capture_pcap_writer.h"
+#include "xlnx_network_capture_error_codes.h"
+#include "xlnx_capture_store.h"
+#include "xlnx_capture_store_error_codes.h"
+
+#include "aat_unit_test.h"
+
+using namespace XLNX;
+
+
+
+//Writes a capture big enough to rotate through several segments, checks that every index entry points at
+//the record it names, then extracts time windows that cross segment boundaries.  Records vary in length
+//so that with direct I/O the unaligned tail of each buffer (and the index entries for it) is carried over.
+
+#define TEST_SEGMENT_SIZE_MEGABYTES     (1)
+#define TEST_INDEX_INTERVAL             (16)
+#define TEST_NUM_PACKETS                (4000)
+#define TEST_START_TIMESTAMP            (1600000000ULL * 1000000000ULL)
+#define TEST_TIMESTAMP_STEP             (1000)  //nanoseconds between packets
+
+#define TEST_EXTRACT_FIRST_PACKET       (1000)
+#define TEST_EXTRACT_LAST_PACKET        (2999)
+
+#define TEST_FLUSH_TIMEOUT_MILLISECONDS (10)
+
+
+
+static uint64_t TestPacketTimestamp(uint32_t packetNumber)
+{
+    return TEST_START_TIMESTAMP + ((uint64_t)packetNumber * TEST_TIMESTAMP_STEP);
+}
+
+
+
+static uint32_t TestPacketLength(uint32_t packetNumber)
+{
+    return 60 + ((packetNumber * 37) % 1400);
+}
+
+
+
+static uint64_t TestRecordTimestamp(const uint8_t* pRecord)
+{
+    const pcaprec_hdr_t* pHeader = (const pcaprec_hdr_t*)pRecord;
+
+    return ((uint64_t)pHeader->ts_sec * 1000000000ULL) + pHeader->ts_nsec;
+}
+
+
+
+static uint64_t TestFileSize(const std::string& path)
+{
+    struct stat fileStat;
+    uint64_t fileSize = 0;
+
+    if (stat(path.c_str(), &fileStat) == 0)
+    {
+        fileSize = (uint64_t)fileStat.st_size;
+    }
+
+    return fileSize;
+}
+
+
+
+static bool TestReadFile(const std::string& path, std::vector<uint8_t>* pContents)
+{
+    FILE* pFile;
+    long fileSize;
+    bool bOK = false;
+
+    pContents->clear();
+
+    pFile = fopen(path.c_str(), "rb");
+
+    if (pFile != nullptr)
+    {
+        fseek(pFile, 0, SEEK_END);
+        fileSize = ftell(pFile);
+        fseek(pFile, 0, SEEK_SET);
+
+        if (fileSize >= 0)
+        {
+            pContents->resize((size_t)fileSize);
+            bOK = (fread(pContents->data(), 1, pContents->size(), pFile) == pContents->size());
+        }
+
+        fclose(pFile);
+    }
+
+    return bOK;
+}
+
+
+
+//walks the records of a PCAP file, returning the timestamp of each, false if the file is malformed
+static bool TestReadRecordTimestamps(const std::vector<uint8_t>& contents, std::vector<uint64_t>* pTimestamps)
+{
+    const pcaprec_hdr_t* pHeader;
+    size_t offset = sizeof(pcap_hdr_t);
+
+    pTimestamps->clear();
+
+    if (contents.size() < sizeof(pcap_hdr_t))
+    {
+        return false;
+    }
+
+    while (offset < contents.size())
+    {
+        if ((offset + sizeof(pcaprec_hdr_t)) > contents.size())
+        {
+            return false;
+        }
+
+        pHeader = (const pcaprec_hdr_t*)(contents.data() + offset);
+
+        offset += sizeof(pcaprec_hdr_t) + pHeader->incl_len;
+
+        if (offset > contents.size())
+        {
+            return false;
+        }
+
+        pTimestamps->push_back(TestRecordTimestamp((const uint8_t*)pHeader));
+    }
+
+    return true;
+}
+
+
+
+
+uint32_t TestCaptureSegments(void)
+{
+    uint32_t numFailures = 0;
+    PCAPWriter writer;
+    PCAPWriter::Stats writerStats;
+    CaptureStore store;
+    CaptureStore::SegmentInfo segmentInfo;
+    CaptureStore::ExtractStats extractStats;
+    char directoryTemplate[] = "/tmp/aat_unit_test_capture_XXXXXX";
+    std::string capturePath;
+    std::string outputPath;
+    std::vector<std::string> segmentPaths;
+    std::vector<uint8_t> packet(2048);
+    std::vector<uint8_t> contents;
+    std::vector<uint8_t> indexContents;
+    std::vector<uint64_t> timestamps;
+    const pcap_index_hdr_t* pIndexHeader;
+    const pcap_index_entry_t* pIndexEntry;
+    uint64_t numIndexEntries = 0;
+    uint64_t numPacketsInSegments = 0;
+    uint64_t expectedNumEntries;
+    uint32_t numSegments = 0;
+    uint32_t numEntriesInSegment;
+    uint32_t i;
+    uint32_t j;
+    bool bIndexOK;
+
+    if (mkdtemp(directoryTemplate) == nullptr)
+    {
+        printf("    [FAIL] could not create a temporary directory\n");
+        return 1;
+    }
+
+    capturePath = std::string(directoryTemplate) + "/capture.pcap";
+    outputPath = std::string(directoryTemplate) + "/extract.pcap";
+
+
+
+    UNIT_CHECK(numFailures, writer.SetSegmentSize(TEST_SEGMENT_SIZE_MEGABYTES) == XLNX_OK);
+    UNIT_CHECK(numFailures, writer.SetIndexInterval(TEST_INDEX_INTERVAL) == XLNX_OK);
+    UNIT_CHECK(numFailures, writer.SetBufferSize(PCAPWriter::MIN_BUFFER_SIZE) == XLNX_OK);
+    UNIT_CHECK(numFailures, writer.SetDirectIO(true) == XLNX_OK);
+    UNIT_CHECK(numFailures, writer.Start((char*)capturePath.c_str()) == XLNX_OK);
+
+    for (i = 0; i < TEST_NUM_PACKETS; i++)
+    {
+        memset(packet.data(), (int)(i & 0xFF), TestPacketLength(i));
+
+        UNIT_CHECK(numFailures, writer.WritePacket(packet.data(), TestPacketLength(i), TestPacketTimestamp(i)) == XLNX_OK);
+    }
+
+    UNIT_CHECK(numFailures, writer.Stop() == XLNX_OK);
+    UNIT_CHECK(numFailures, writer.GetStats(&writerStats) == XLNX_OK);
+
+    UNIT_CHECK(numFailures, writerStats.numPackets == TEST_NUM_PACKETS);
+    UNIT_CHECK(numFailures, writerStats.numBytesWritten == writerStats.numBytes);
+    UNIT_CHECK(numFailures, writerStats.numSegments >= 3);   //at least two rotations
+
+
+
+    UNIT_CHECK(numFailures, store.Open(capturePath.c_str()) == XLNX_OK);
+    UNIT_CHECK(numFailures, store.GetNumSegments(&numSegments) == XLNX_OK);
+    UNIT_CHECK(numFailures, numSegments == writerStats.numSegments);
+
+    for (i = 0; i < numSegments; i++)
+    {
+        UNIT_CHECK(numFailures, store.GetSegmentInfo(i, &segmentInfo) == XLNX_OK);
+        segmentPaths.push_back(segmentInfo.path);
+
+        UNIT_CHECK(numFailures, segmentInfo.bHasPackets);
+        UNIT_CHECK(numFailures, segmentInfo.fileSize <= ((uint64_t)TEST_SEGMENT_SIZE_MEGABYTES * 1024 * 1024));
+
+        UNIT_CHECK(numFailures, TestReadFile(segmentInfo.path, &contents));
+        UNIT_CHECK(numFailures, TestReadRecordTimestamps(contents, &timestamps));
+        UNIT_CHECK(numFailures, TestReadFile(segmentInfo.path + PCAP_INDEX_FILE_SUFFIX, &indexContents));
+
+        //every segment starts a new index, so its first packet always has an entry
+        expectedNumEntries = (timestamps.size() + TEST_INDEX_INTERVAL - 1) / TEST_INDEX_INTERVAL;
+        numEntriesInSegment = 0;
+        bIndexOK = (indexContents.size() >= sizeof(pcap_index_hdr_t));
+
+        if (bIndexOK)
+        {
+            pIndexHeader = (const pcap_index_hdr_t*)indexContents.data();
+            numEntriesInSegment = (uint32_t)((indexContents.size() - sizeof(pcap_index_hdr_t)) / sizeof(pcap_index_entry_t));
+
+            UNIT_CHECK(numFailures, pIndexHeader->magic_number == PCAP_INDEX_MAGIC_NUMBER);
+            UNIT_CHECK(numFailures, pIndexHeader->interval == TEST_INDEX_INTERVAL);
+            UNIT_CHECK(numFailures, numEntriesInSegment == expectedNumEntries);
+            UNIT_CHECK(numFailures, numEntriesInSegment == segmentInfo.numIndexEntries);
+
+            for (j = 0; j < numEntriesInSegment; j++)
+            {
+                pIndexEntry = (const pcap_index_entry_t*)(indexContents.data() + sizeof(pcap_index_hdr_t)) + j;
+
+                //each entry must point at the header of the record it was taken from
+                bIndexOK = bIndexOK && ((pIndexEntry->offset + sizeof(pcaprec_hdr_t)) <= contents.size()) &&
+                                       (TestRecordTimestamp(contents.data() + pIndexEntry->offset) == pIndexEntry->timestamp) &&
+                                       (pIndexEntry->timestamp == timestamps[j * TEST_INDEX_INTERVAL]);
+            }
+        }
+
+        UNIT_CHECK(numFailures, bIndexOK);
+
+        numIndexEntries += numEntriesInSegment;
+        numPacketsInSegments += timestamps.size();
+    }
+
+    UNIT_CHECK(numFailures, numPacketsInSegments == TEST_NUM_PACKETS);
+    UNIT_CHECK(numFailures, numIndexEntries == writerStats.numIndexEntries);
+
+
+
+    //a window spanning segment boundaries...
+    UNIT_CHECK(numFailures, store.Extract(TestPacketTimestamp(TEST_EXTRACT_FIRST_PACKET), TestPacketTimestamp(TEST_EXTRACT_LAST_PACKET), nullptr, outputPath.c_str(), &extractStats) == XLNX_OK);
+    UNIT_CHECK(numFailures, extractStats.numRecordsExtracted == (TEST_EXTRACT_LAST_PACKET - TEST_EXTRACT_FIRST_PACKET + 1));
+    UNIT_CHECK(numFailures, extractStats.numSegmentsSearched >= 2);
+
+    //...the index means only the records from the entry before the window start need scanning
+    UNIT_CHECK(numFailures, extractStats.numRecordsScanned <= (extractStats.numRecordsExtracted + (TEST_INDEX_INTERVAL * extractStats.numSegmentsSearched) + 1));
+
+    UNIT_CHECK(numFailures, TestReadFile(outputPath, &contents));
+    UNIT_CHECK(numFailures, TestReadRecordTimestamps(contents, &timestamps));
+    UNIT_CHECK(numFailures, timestamps.size() == (TEST_EXTRACT_LAST_PACKET - TEST_EXTRACT_FIRST_PACKET + 1));
+
+    if (timestamps.empty() == false)
+    {
+        UNIT_CHECK(numFailures, timestamps.front() == TestPacketTimestamp(TEST_EXTRACT_FIRST_PACKET));
+        UNIT_CHECK(numFailures, timestamps.back() == TestPacketTimestamp(TEST_EXTRACT_LAST_PACKET));
+    }
+
+    //a window that starts between two packets and between two index entries
+    UNIT_CHECK(numFailures, store.Extract(TestPacketTimestamp(1500) + 1, TestPacketTimestamp(1502), nullptr, outputPath.c_str(), &extractStats) == XLNX_OK);
+    UNIT_CHECK(numFailures, extractStats.numRecordsExtracted == 2);
+
+    //and one past the end of the capture
+    UNIT_CHECK(numFailures, store.Extract(TestPacketTimestamp(TEST_NUM_PACKETS), TestPacketTimestamp(TEST_NUM_PACKETS + 100), nullptr, outputPath.c_str(), &extractStats) == XLNX_OK);
+    UNIT_CHECK(numFailures, extractStats.numRecordsExtracted == 0);
+
+    UNIT_CHECK(numFailures, store.Close() == XLNX_OK);
+
+
+
+    for (i = 0; i < segmentPaths.size(); i++)
+    {
+        remove(segmentPaths[i].c_str());
+        remove((segmentPaths[i] + PCAP_INDEX_FILE_SUFFIX).c_str());
+    }
+
+    remove(outputPath.c_str());
+    rmdir(directoryTemplate);
+
+    return numFailures;
+}
+
+
+
+
+//With direct I/O a flush on timeout must still get a capture smaller than one aligned block into the file,
+//and must not write the same tail again while no new packets arrive.
+uint32_t TestCaptureFlushTimeout(void)
+{
+    uint32_t numFailures = 0;
+    PCAPWriter writer;
+    PCAPWriter::Stats writerStats;
+    char directoryTemplate[] = "/tmp/aat_unit_test_capture_XXXXXX";
+    std::string capturePath;
+    std::vector<uint8_t> packet(100);
+    std::vector<uint8_t> contents;
+    std::vector<uint64_t> timestamps;
+    uint64_t expectedFileSize;
+    uint64_t numBufferWrites;
+
+    if (mkdtemp(directoryTemplate) == nullptr)
+    {
+        printf("    [FAIL] could not create a temporary directory\n");
+        return 1;
+    }
+
+    capturePath = std::string(directoryTemplate) + "/capture.pcap";
+
+    UNIT_CHECK(numFailures, writer.SetIndexInterval(0) == XLNX_OK);
+    UNIT_CHECK(numFailures, writer.SetDirectIO(true) == XLNX_OK);
+    UNIT_CHECK(numFailures, writer.SetFlushTimeout(TEST_FLUSH_TIMEOUT_MILLISECONDS) == XLNX_OK);
+    UNIT_CHECK(numFailures, writer.Start((char*)capturePath.c_str()) == XLNX_OK);
+
+    memset(packet.data(), 0x5A, packet.size());
+
+    //one packet...
+    UNIT_CHECK(numFailures, writer.WritePacket(packet.data(), (uint32_t)packet.size(), TestPacketTimestamp(0)) == XLNX_OK);
+    expectedFileSize = sizeof(pcap_hdr_t) + sizeof(pcaprec_hdr_t) + packet.size();
+
+    UNIT_CHECK(numFailures, UnitWaitFor([&] { writer.CheckFlushTimeout(); return (TestFileSize(capturePath) == expectedFileSize); }));
+
+    //...then nothing, so there is nothing new to flush
+    UNIT_CHECK(numFailures, writer.GetStats(&writerStats) == XLNX_OK);
+    numBufferWrites = writerStats.numBufferWrites;
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(3 * TEST_FLUSH_TIMEOUT_MILLISECONDS));
+    UNIT_CHECK(numFailures, writer.CheckFlushTimeout() == XLNX_OK);
+    UNIT_CHECK(numFailures, writer.GetStats(&writerStats) == XLNX_OK);
+    UNIT_CHECK(numFailures, writerStats.numBufferWrites == numBufferWrites);
+
+    //a second packet goes out after the first
+    UNIT_CHECK(numFailures, writer.WritePacket(packet.data(), (uint32_t)packet.size(), TestPacketTimestamp(1)) == XLNX_OK);
+    expectedFileSize += sizeof(pcaprec_hdr_t) + packet.size();
+
+    UNIT_CHECK(numFailures, UnitWaitFor([&] { writer.CheckFlushTimeout(); return (TestFileSize(capturePath) == expectedFileSize); }));
+
+    UNIT_CHECK(numFailures, TestReadFile(capturePath, &contents));
+    UNIT_CHECK(numFailures, TestReadRecordTimestamps(contents, &timestamps));
+    UNIT_CHECK(numFailures, timestamps.size() == 2);
+
+    //and the file is the same once closed
+    UNIT_CHECK(numFailures, writer.Stop() == XLNX_OK);
+    UNIT_CHECK(numFailures, writer.GetStats(&writerStats) == XLNX_OK);
+    UNIT_CHECK(numFailures, writerStats.numBytesWritten == expectedFileSize);
+    UNIT_CHECK(numFailures, TestFileSize(capturePath) == expectedFileSize);
+
+    remove(capturePath.c_str());
+    rmdir(directoryTemplate);
+
+    return numFailures;
+}
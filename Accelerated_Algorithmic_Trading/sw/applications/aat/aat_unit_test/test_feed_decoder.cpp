@@ -0,0 +1,128 @@
+/*
+ * Copyright 2021 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cstdint>
+#include <cstdio>
+
+#include "xlnx_feed_decoder.h"
+#include "xlnx_feed_decoder_error_codes.h"
+
+#include "aat_unit_test.h"
+
+using namespace XLNX;
+
+
+
+//The software FeedDecoder must produce exactly the operations the FeedHandler kernel does.  Both are
+//checked against the same golden files, the kernel by its C-sim testbench (hw/feedHandler/test) and
+//the decoder here.
+
+#define TEST_NUM_PACKETS            (54)
+#define TEST_NUM_WORDS_PER_PACKET   (13)
+#define TEST_NUM_OPERATIONS         (54)
+#define TEST_NUM_OPERATION_FIELDS   (10)
+
+#define TEST_SECURITY_INDEX         (9)
+#define TEST_SECURITY_ID            (0x12345678)    //security ID of the golden messages
+
+
+
+
+uint32_t TestFeedDecoder(void)
+{
+    uint32_t numFailures = 0;
+    FeedDecoder decoder;
+    FeedDecoder::Stats stats;
+    orderBookOperation_t operations[FeedDecoder::MAX_OPERATIONS_PER_PACKET];
+    uint8_t payload[TEST_NUM_WORDS_PER_PACKET * sizeof(uint64_t)];
+    uint32_t numOperations;
+    uint32_t numDecoded = 0;
+    uint32_t numMismatches = 0;
+    uint32_t packet;
+    uint32_t word;
+    uint32_t byte;
+    uint32_t i;
+    const int64_t* pExpected;
+
+    //UDP payloads, each word holds the next eight bytes in wire order from its MSB down
+    static const uint64_t inputWords[TEST_NUM_PACKETS][TEST_NUM_WORDS_PER_PACKET] =
+    {
+#include "input_golden.dat"
+    };
+
+    static const int64_t outputOperations[TEST_NUM_OPERATIONS][TEST_NUM_OPERATION_FIELDS] =
+    {
+#include "output_golden.dat"
+    };
+
+    //same symbol map as the kernel testbench
+    for (i = 0; i < TEST_SECURITY_INDEX; i++)
+    {
+        UNIT_CHECK(numFailures, decoder.SetSecurity(i, 0x11111111u * (i + 1)) == XLNX_OK);
+    }
+
+    UNIT_CHECK(numFailures, decoder.SetSecurity(TEST_SECURITY_INDEX, TEST_SECURITY_ID) == XLNX_OK);
+
+    for (packet = 0; packet < TEST_NUM_PACKETS; packet++)
+    {
+        for (word = 0; word < TEST_NUM_WORDS_PER_PACKET; word++)
+        {
+            for (byte = 0; byte < sizeof(uint64_t); byte++)
+            {
+                payload[(word * sizeof(uint64_t)) + byte] = (uint8_t)(inputWords[packet][word] >> (56 - (8 * byte)));
+            }
+        }
+
+        //the kernel testbench stamps each packet with its number from 1
+        numOperations = 0;
+        UNIT_CHECK(numFailures, decoder.DecodePacket(payload, sizeof(payload), packet + 1, operations, FeedDecoder::MAX_OPERATIONS_PER_PACKET, &numOperations) == XLNX_OK);
+
+        for (i = 0; i < numOperations; i++, numDecoded++)
+        {
+            if (numDecoded >= TEST_NUM_OPERATIONS)
+            {
+                continue;
+            }
+
+            pExpected = outputOperations[numDecoded];
+
+            if ((pExpected[0] != (int64_t)operations[i].timestamp) ||
+                (pExpected[1] != (int64_t)operations[i].opCode) ||
+                (pExpected[2] != (int64_t)operations[i].symbolIndex) ||
+                (pExpected[3] != (int64_t)operations[i].orderId) ||
+                (pExpected[4] != (int64_t)operations[i].orderCount) ||
+                (pExpected[5] != (int64_t)operations[i].quantity) ||
+                (pExpected[6] != (int64_t)operations[i].price) ||
+                (pExpected[7] != (int64_t)operations[i].direction) ||
+                (pExpected[8] != (int64_t)operations[i].level) ||
+                (pExpected[9] != (int64_t)operations[i].ingressTimestamp))
+            {
+                printf("    operation %u differs from the FeedHandler golden output\n", numDecoded);
+                numMismatches++;
+            }
+        }
+    }
+
+    UNIT_CHECK(numFailures, numDecoded == TEST_NUM_OPERATIONS);
+    UNIT_CHECK(numFailures, numMismatches == 0);
+
+    UNIT_CHECK(numFailures, decoder.GetStats(&stats) == XLNX_OK);
+    UNIT_CHECK(numFailures, stats.numPackets == TEST_NUM_PACKETS);
+    UNIT_CHECK(numFailures, stats.numOperations == TEST_NUM_OPERATIONS);
+    UNIT_CHECK(numFailures, stats.numMalformedPackets == 0);
+
+    return numFailures;
+}
@@ -0,0 +1,384 @@
+/*
+ * Copyright 2021 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cmath>
+#include <cstring>
+#include <thread>
+#include <chrono>
+
+#include <unistd.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+
+#include "xlnx_virtual_device_interface.h"
+#include "xlnx_telemetry.h"
+#include "xlnx_telemetry_shared_memory.h"
+#include "xlnx_metrics_exporter.h"
+
+#include "aat_unit_test.h"
+
+using namespace XLNX;
+
+
+
+//Counter values are written to a virtual device, snapshotted by Telemetry and run through
+//MetricsExporter::Sample() one snapshot at a time, so each step controls exactly what the exporter sees.
+
+#define TEST_TELEMETRY_SHARED_NAME  "/xlnx_aat_unit_test_telemetry"
+#define TEST_METRICS_SHARED_NAME    "/xlnx_aat_unit_test_metrics"
+
+#define TEST_BLOCK_ADDRESS          (0x00010000)
+
+#define TEST_COUNTER_INDEX          (0)
+#define TEST_GAUGE_INDEX            (1)
+
+
+
+
+class TestMetricsFixture
+{
+public:
+    VirtualDeviceInterface device;
+    Telemetry telemetry;
+    MetricsExporter exporter;
+    const MetricsSharedRegion* pRegion = nullptr;
+
+    uint32_t numFailures = 0;
+
+
+    uint32_t Setup(void)
+    {
+        uint32_t retval;
+        const void* pMapping = nullptr;
+
+        retval = telemetry.Initialise(&device, TEST_TELEMETRY_SHARED_NAME);
+
+        if (retval == XLNX_OK)
+        {
+            retval = telemetry.AddBlock("test", TEST_BLOCK_ADDRESS, 2);
+        }
+
+        if (retval == XLNX_OK)
+        {
+            retval = exporter.Initialise(&telemetry, TEST_METRICS_SHARED_NAME);
+        }
+
+        if (retval == XLNX_OK)
+        {
+            retval = exporter.AddCounter("test_counter", "test", 0);
+        }
+
+        if (retval == XLNX_OK)
+        {
+            retval = exporter.AddGauge("test_gauge", "test", 1);
+        }
+
+        if (retval == XLNX_OK)
+        {
+            retval = TelemetryOpenSharedMemory(TEST_METRICS_SHARED_NAME, sizeof(MetricsSharedRegion), &pMapping);
+        }
+
+        if (retval == XLNX_OK)
+        {
+            pRegion = (const MetricsSharedRegion*)pMapping;
+        }
+
+        return retval;
+    }
+
+
+    void Teardown(void)
+    {
+        if (pRegion != nullptr)
+        {
+            TelemetryCloseSharedMemory(pRegion, sizeof(MetricsSharedRegion));
+        }
+
+        exporter.Uninitialise();
+        telemetry.Uninitialise();
+    }
+
+
+    //registers as the HW would present them, then one snapshot and one sample of it
+    void Step(uint32_t counterRaw, uint32_t gaugeRaw)
+    {
+        //keeps the interval between snapshots well clear of the clock resolution
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+
+        device.WriteReg32(TEST_BLOCK_ADDRESS + (TEST_COUNTER_INDEX * 4), counterRaw);
+        device.WriteReg32(TEST_BLOCK_ADDRESS + (TEST_GAUGE_INDEX * 4), gaugeRaw);
+
+        UNIT_CHECK(numFailures, telemetry.Snapshot() == XLNX_OK);
+        UNIT_CHECK(numFailures, exporter.Sample() == XLNX_OK);
+    }
+
+
+    MetricsSharedValue Value(uint32_t index)
+    {
+        MetricsSharedDescriptor descriptor;
+        MetricsSharedValue value = { 0, 0.0 };
+
+        UNIT_CHECK(numFailures, exporter.GetMetric(index, &descriptor, &value) == XLNX_OK);
+
+        return value;
+    }
+
+
+    uint64_t PublishedInterval(void)
+    {
+        uint64_t sequence = pRegion->sequence.load(std::memory_order_acquire);
+
+        return pRegion->buffers[sequence % XLNX_METRICS_NUM_BUFFERS].intervalNanoseconds;
+    }
+
+
+    //rate is the raw counter change over the snapshot interval that was published with it
+    bool RateMatches(double rate, uint64_t delta)
+    {
+        uint64_t intervalNanoseconds = PublishedInterval();
+        double expected;
+
+        if (intervalNanoseconds == 0)
+        {
+            return false;
+        }
+
+        expected = ((double)delta * 1000000000.0) / (double)intervalNanoseconds;
+
+        return (std::fabs(rate - expected) <= (expected * 1e-9));
+    }
+};
+
+
+
+
+static bool TestServerPortInUse(MetricsExporter* pExporter)
+{
+    struct sockaddr_in address;
+    socklen_t addressLength = sizeof(address);
+    bool bRunning = true;
+    uint16_t port;
+    uint32_t retval;
+    int sock;
+
+    sock = socket(AF_INET, SOCK_STREAM, 0);
+
+    memset(&address, 0, sizeof(address));
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_ANY);
+    address.sin_port = 0;
+
+    if ((sock < 0) ||
+        (bind(sock, (struct sockaddr*)&address, sizeof(address)) != 0) ||
+        (listen(sock, 1) != 0) ||
+        (getsockname(sock, (struct sockaddr*)&address, &addressLength) != 0))
+    {
+        printf("    failed to open a listening socket to collide with\n");
+        return false;
+    }
+
+    retval = pExporter->StartServer(ntohs(address.sin_port));
+
+    pExporter->IsServerRunning(&bRunning, &port);
+
+    pExporter->StopServer();
+    close(sock);
+
+    return ((retval == XLNX_TELEMETRY_ERROR_FAILED_TO_START_SERVER) && (bRunning == false));
+}
+
+
+
+
+//the text endpoint answers from the server's reactor with exactly what FormatText() produces
+static uint32_t TestServerText(MetricsExporter* pExporter)
+{
+    MetricsExporter::Stats stats;
+    std::string expected;
+    std::string text;
+    uint32_t numFailures = 0;
+    uint64_t numRequests;
+    uint16_t port;
+    int sock;
+
+    port = UnitGetFreePort(SOCK_STREAM);
+
+    pExporter->GetStats(&stats);
+    numRequests = stats.numServerRequests;
+
+    UNIT_CHECK(numFailures, pExporter->FormatText(&expected) == XLNX_OK);
+    UNIT_CHECK(numFailures, pExporter->StartServer(port) == XLNX_OK);
+
+    sock = UnitConnect(port);
+    UNIT_CHECK(numFailures, sock >= 0);
+
+    if (sock >= 0)
+    {
+        text = UnitReadAll(sock);
+        close(sock);
+    }
+
+    pExporter->StopServer();
+    pExporter->GetStats(&stats);
+
+    UNIT_CHECK(numFailures, text == expected);
+    UNIT_CHECK(numFailures, text.find("test_counter ") != std::string::npos);
+    UNIT_CHECK(numFailures, stats.numServerRequests == numRequests + 1);
+
+    return numFailures;
+}
+
+
+
+
+uint32_t TestMetricsExporter(void)
+{
+    TestMetricsFixture fixture;
+    MetricsExporter::Stats stats;
+    MetricsSharedValue counter;
+    MetricsSharedValue gauge;
+    uint64_t expected;
+    uint64_t sequence;
+    uint32_t& numFailures = fixture.numFailures;
+
+    if (fixture.Setup() != XLNX_OK)
+    {
+        printf("    failed to set up telemetry on the virtual device\n");
+        fixture.Teardown();
+        return 1;
+    }
+
+
+    //first snapshot seeds the counter with no rate
+    fixture.Step(1000, 7);
+
+    counter = fixture.Value(TEST_COUNTER_INDEX);
+    gauge = fixture.Value(TEST_GAUGE_INDEX);
+    expected = 1000;
+
+    UNIT_CHECK(numFailures, counter.value == expected);
+    UNIT_CHECK(numFailures, counter.ratePerSecond == 0.0);
+    UNIT_CHECK(numFailures, gauge.value == 7);
+
+
+    //ordinary advance
+    fixture.Step(1500, 3);
+
+    counter = fixture.Value(TEST_COUNTER_INDEX);
+    gauge = fixture.Value(TEST_GAUGE_INDEX);
+    expected += 500;
+
+    UNIT_CHECK(numFailures, counter.value == expected);
+    UNIT_CHECK(numFailures, fixture.RateMatches(counter.ratePerSecond, 500));
+    UNIT_CHECK(numFailures, gauge.value == 3);
+    UNIT_CHECK(numFailures, gauge.ratePerSecond == 0.0);
+
+
+    //climb to just below the top of the 32-bit range, in steps small enough not to look like a reset...
+    fixture.Step(0x7FFFFFF0, 3);
+    fixture.Step(0xFFFFFF00, 3);
+
+    expected += (0xFFFFFF00 - 1500);
+    counter = fixture.Value(TEST_COUNTER_INDEX);
+
+    UNIT_CHECK(numFailures, counter.value == expected);
+
+
+    //...and wrap, the 64-bit value keeps counting up through it
+    fixture.Step(0x00000050, 3);
+
+    expected += 0x150;
+    counter = fixture.Value(TEST_COUNTER_INDEX);
+
+    UNIT_CHECK(numFailures, counter.value == expected);
+    UNIT_CHECK(numFailures, counter.value > 0xFFFFFFFFull);
+    UNIT_CHECK(numFailures, fixture.RateMatches(counter.ratePerSecond, 0x150));
+
+    fixture.exporter.GetStats(&stats);
+    UNIT_CHECK(numFailures, stats.numCounterWraps == 1);
+    UNIT_CHECK(numFailures, stats.numCounterResets == 0);
+
+
+    //going backwards by less than COUNTER_WRAP_THRESHOLD is the counter being cleared, everything it now
+    //holds is new
+    fixture.Step(0x00000010, 3);
+
+    expected += 0x10;
+    counter = fixture.Value(TEST_COUNTER_INDEX);
+
+    UNIT_CHECK(numFailures, counter.value == expected);
+    UNIT_CHECK(numFailures, fixture.RateMatches(counter.ratePerSecond, 0x10));
+
+    fixture.exporter.GetStats(&stats);
+    UNIT_CHECK(numFailures, stats.numCounterWraps == 1);
+    UNIT_CHECK(numFailures, stats.numCounterResets == 1);
+
+
+    //one below COUNTER_WRAP_THRESHOLD is the largest step still taken as the counter moving forward...
+    fixture.Step(0x8000000F, 3);
+
+    expected += 0x7FFFFFFF;
+    counter = fixture.Value(TEST_COUNTER_INDEX);
+
+    UNIT_CHECK(numFailures, counter.value == expected);
+
+    fixture.exporter.GetStats(&stats);
+    UNIT_CHECK(numFailures, stats.numCounterResets == 1);
+
+
+    //...and a step of the threshold itself is a reset, so only the new raw value is added
+    fixture.Step(0x0000000F, 3);
+
+    expected += 0x0F;
+    counter = fixture.Value(TEST_COUNTER_INDEX);
+
+    UNIT_CHECK(numFailures, counter.value == expected);
+
+    fixture.exporter.GetStats(&stats);
+    UNIT_CHECK(numFailures, stats.numCounterResets == 2);
+    UNIT_CHECK(numFailures, stats.numCounterWraps == 1);
+
+
+    //no new snapshot - the sample is counted as stale and nothing is republished
+    sequence = fixture.pRegion->sequence.load(std::memory_order_acquire);
+
+    UNIT_CHECK(numFailures, fixture.exporter.Sample() == XLNX_OK);
+
+    fixture.exporter.GetStats(&stats);
+    UNIT_CHECK(numFailures, stats.numStaleSamples == 1);
+    UNIT_CHECK(numFailures, stats.numSamples == 8);
+    UNIT_CHECK(numFailures, fixture.pRegion->sequence.load(std::memory_order_acquire) == sequence);
+    UNIT_CHECK(numFailures, fixture.Value(TEST_COUNTER_INDEX).value == expected);
+
+
+    //published region matches what GetMetric() reports
+    sequence = fixture.pRegion->sequence.load(std::memory_order_acquire);
+
+    UNIT_CHECK(numFailures, fixture.pRegion->magic == XLNX_METRICS_SHARED_MAGIC);
+    UNIT_CHECK(numFailures, fixture.pRegion->numMetrics == 2);
+    UNIT_CHECK(numFailures, fixture.pRegion->buffers[sequence % XLNX_METRICS_NUM_BUFFERS].values[TEST_COUNTER_INDEX].value == expected);
+
+
+    //text endpoint on a port something else is already listening on fails to start, and says so
+    UNIT_CHECK(numFailures, TestServerPortInUse(&fixture.exporter));
+
+    numFailures += TestServerText(&fixture.exporter);
+
+
+    fixture.Teardown();
+
+    return numFailures;
+}
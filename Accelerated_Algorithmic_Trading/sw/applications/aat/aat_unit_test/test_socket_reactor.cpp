@@ -0,0 +1,232 @@
+/*
+ * Copyright 2021 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <atomic>
+#include <mutex>
+#include <thread>
+
+#include <unistd.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+
+#include "xlnx_socket_reactor.h"
+
+#include "aat_unit_test.h"
+
+using namespace XLNX;
+
+
+
+//Sockets are one end of AF_UNIX socket pairs - the test writes to the other end to make them readable.
+
+#define TEST_NUM_THREADS    (2)
+#define TEST_NUM_SOCKETS    (4)
+
+
+
+
+class TestReactorConnection
+{
+public:
+    int fds[2] = { -1, -1 };            //[0] is added to the reactor, [1] is written to by the test
+
+    SocketReactor* pReactor = nullptr;
+    bool bRemoveOnCallback = false;
+
+    std::atomic<uint32_t> numCallbacks{0};
+    std::atomic<uint32_t> numBytes{0};
+    std::atomic<bool> bWrongThread{false};
+
+    std::mutex threadMutex;
+    std::thread::id threadId;
+    bool bThreadKnown = false;
+
+
+    bool Open(void)
+    {
+        return (socketpair(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0, fds) == 0);
+    }
+
+
+    void Close(void)
+    {
+        for (int i = 0; i < 2; i++)
+        {
+            if (fds[i] >= 0)
+            {
+                close(fds[i]);
+                fds[i] = -1;
+            }
+        }
+    }
+
+
+    bool Write(uint32_t numBytesToWrite)
+    {
+        uint8_t buffer[64] = { 0 };
+
+        return (write(fds[1], buffer, numBytesToWrite) == (ssize_t)numBytesToWrite);
+    }
+
+
+    static void Callback(void* pDataObject, SOCKET sock, uint32_t events)
+    {
+        TestReactorConnection* pConnection = (TestReactorConnection*)pDataObject;
+        uint8_t buffer[64];
+        ssize_t numBytesRead;
+
+        (void)events;
+
+        //a socket stays on the worker it was first given to
+        {
+            std::lock_guard<std::mutex> lock(pConnection->threadMutex);
+
+            if (pConnection->bThreadKnown == false)
+            {
+                pConnection->threadId = std::this_thread::get_id();
+                pConnection->bThreadKnown = true;
+            }
+            else if (pConnection->threadId != std::this_thread::get_id())
+            {
+                pConnection->bWrongThread = true;
+            }
+        }
+
+        numBytesRead = read(sock, buffer, sizeof(buffer));
+
+        if (numBytesRead > 0)
+        {
+            pConnection->numBytes += (uint32_t)numBytesRead;
+        }
+
+        pConnection->numCallbacks++;
+
+        if (pConnection->bRemoveOnCallback)
+        {
+            pConnection->pReactor->RemoveSocket(sock);
+        }
+    }
+};
+
+
+
+
+uint32_t TestSocketReactor(void)
+{
+    SocketReactor reactor;
+    TestReactorConnection connections[TEST_NUM_SOCKETS];
+    TestReactorConnection selfRemoving;
+    bool bRunning = false;
+    uint32_t numThreads = 0;
+    uint32_t numFailures = 0;
+    uint32_t i;
+
+
+    UNIT_CHECK(numFailures, reactor.Start(0) == XLNX_SOCKET_ERROR_INVALID_PARAMETER);
+    UNIT_CHECK(numFailures, reactor.Start(SocketReactor::MAX_NUM_THREADS + 1) == XLNX_SOCKET_ERROR_INVALID_PARAMETER);
+
+    UNIT_CHECK(numFailures, reactor.Start(TEST_NUM_THREADS) == XLNX_OK);
+    UNIT_CHECK(numFailures, reactor.Start(TEST_NUM_THREADS) == XLNX_SOCKET_ERROR_ALREADY_RUNNING);
+
+    reactor.IsRunning(&bRunning);
+    reactor.GetNumThreads(&numThreads);
+
+    UNIT_CHECK(numFailures, bRunning);
+    UNIT_CHECK(numFailures, numThreads == TEST_NUM_THREADS);
+
+
+    for (i = 0; i < TEST_NUM_SOCKETS; i++)
+    {
+        connections[i].pReactor = &reactor;
+
+        UNIT_CHECK(numFailures, connections[i].Open());
+        UNIT_CHECK(numFailures, reactor.AddSocket(connections[i].fds[0], EPOLLIN, TestReactorConnection::Callback, &connections[i]) == XLNX_OK);
+    }
+
+    //each socket can only be registered once
+    UNIT_CHECK(numFailures, reactor.AddSocket(connections[0].fds[0], EPOLLIN, TestReactorConnection::Callback, &connections[0]) == XLNX_SOCKET_ERROR_INVALID_PARAMETER);
+    UNIT_CHECK(numFailures, reactor.AddSocket(INVALID_SOCKET, EPOLLIN, TestReactorConnection::Callback, &connections[0]) == XLNX_SOCKET_ERROR_INVALID_PARAMETER);
+
+
+    //data on every socket reaches its own callback, and only that one.  Several writes each so the
+    //callbacks are called repeatedly across both workers.
+    for (uint32_t round = 0; round < 8; round++)
+    {
+        for (i = 0; i < TEST_NUM_SOCKETS; i++)
+        {
+            UNIT_CHECK(numFailures, connections[i].Write(i + 1));
+        }
+
+        for (i = 0; i < TEST_NUM_SOCKETS; i++)
+        {
+            TestReactorConnection* pConnection = &connections[i];
+            uint32_t expected = (round + 1) * (i + 1);
+
+            UNIT_CHECK(numFailures, UnitWaitFor([pConnection, expected] { return (pConnection->numBytes == expected); }));
+        }
+    }
+
+    for (i = 0; i < TEST_NUM_SOCKETS; i++)
+    {
+        UNIT_CHECK(numFailures, connections[i].bWrongThread == false);
+    }
+
+
+    //a removed socket gets no more callbacks, even with data waiting
+    UNIT_CHECK(numFailures, reactor.RemoveSocket(connections[0].fds[0]) == XLNX_OK);
+    UNIT_CHECK(numFailures, reactor.RemoveSocket(connections[0].fds[0]) == XLNX_SOCKET_ERROR_SOCKET_NOT_FOUND);
+
+    UNIT_CHECK(numFailures, connections[0].Write(5));
+    UNIT_CHECK(numFailures, connections[1].Write(5));
+
+    UNIT_CHECK(numFailures, UnitWaitFor([&connections] { return (connections[1].numBytes == (8 * 2) + 5); }));
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    UNIT_CHECK(numFailures, connections[0].numBytes == 8);
+
+
+    //a callback can remove its own socket
+    selfRemoving.pReactor = &reactor;
+    selfRemoving.bRemoveOnCallback = true;
+
+    UNIT_CHECK(numFailures, selfRemoving.Open());
+    UNIT_CHECK(numFailures, reactor.AddSocket(selfRemoving.fds[0], EPOLLIN, TestReactorConnection::Callback, &selfRemoving) == XLNX_OK);
+
+    //more than one read's worth, so a level triggered socket would fire again if it were still registered
+    UNIT_CHECK(numFailures, selfRemoving.Write(64));
+    UNIT_CHECK(numFailures, selfRemoving.Write(64));
+
+    UNIT_CHECK(numFailures, UnitWaitFor([&selfRemoving] { return (selfRemoving.numCallbacks == 1); }));
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    UNIT_CHECK(numFailures, selfRemoving.numCallbacks == 1);
+    UNIT_CHECK(numFailures, reactor.RemoveSocket(selfRemoving.fds[0]) == XLNX_SOCKET_ERROR_SOCKET_NOT_FOUND);
+
+
+    UNIT_CHECK(numFailures, reactor.Stop() == XLNX_OK);
+
+    reactor.IsRunning(&bRunning);
+    UNIT_CHECK(numFailures, bRunning == false);
+    UNIT_CHECK(numFailures, reactor.AddSocket(connections[1].fds[0], EPOLLIN, TestReactorConnection::Callback, &connections[1]) == XLNX_SOCKET_ERROR_NOT_RUNNING);
+
+
+    for (i = 0; i < TEST_NUM_SOCKETS; i++)
+    {
+        connections[i].Close();
+    }
+
+    selfRemoving.Close();
+
+    return numFailures;
+}
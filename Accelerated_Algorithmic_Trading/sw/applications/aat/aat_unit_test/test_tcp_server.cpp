@@ -0,0 +1,257 @@
+/*
+ * Copyright 2021 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <atomic>
+#include <cstring>
+#include <string>
+
+#include <dirent.h>
+#include <unistd.h>
+#include <sys/socket.h>
+
+#include "xlnx_tcp_server.h"
+
+#include "aat_unit_test.h"
+
+using namespace XLNX;
+
+
+
+#define TEST_NUM_CLIENTS        (4)
+#define TEST_RESPONSE_LENGTH    (32 * 1024 * 1024)  //far more than a socket send buffer holds
+
+
+
+
+static uint32_t s_numResponses = 0;
+
+static void TestResponseCallback(void* pDataObject, std::string* pResponse)
+{
+    std::string* pSource = (std::string*)pDataObject;
+
+    s_numResponses++;
+    *pResponse = *pSource;
+}
+
+
+
+static void TestEchoCallback(void* pDataObject, SOCKET sock, uint8_t* pBuffer, uint32_t dataLength)
+{
+    (void)pDataObject;
+
+    send(sock, pBuffer, dataLength, MSG_NOSIGNAL);
+}
+
+
+
+static void TestConnectionCallback(void* pDataObject, SOCKET sock)
+{
+    const char* pText = (const char*)pDataObject;
+
+    send(sock, pText, strlen(pText), MSG_NOSIGNAL);
+}
+
+
+
+
+static uint32_t TestNumThreads(void)
+{
+    uint32_t numThreads = 0;
+    struct dirent* pEntry;
+    DIR* pDir;
+
+    pDir = opendir("/proc/self/task");
+
+    if (pDir != nullptr)
+    {
+        while ((pEntry = readdir(pDir)) != nullptr)
+        {
+            if (pEntry->d_name[0] != '.')
+            {
+                numThreads++;
+            }
+        }
+
+        closedir(pDir);
+    }
+
+    return numThreads;
+}
+
+
+
+
+static uint32_t TestResponseServer(void)
+{
+    TCPServer server;
+    std::string response;
+    int clients[TEST_NUM_CLIENTS];
+    uint32_t numThreads;
+    uint32_t numFailures = 0;
+    uint16_t port;
+    uint32_t i;
+    int sock;
+
+    for (i = 0; i < TEST_RESPONSE_LENGTH; i++)
+    {
+        response.push_back((char)('a' + (i % 26)));
+    }
+
+    port = UnitGetFreePort(SOCK_STREAM);
+    s_numResponses = 0;
+
+    server.SetResponseCallback(TestResponseCallback, &response);
+    UNIT_CHECK(numFailures, server.StartAsThread(port, nullptr));
+
+    numThreads = TestNumThreads();
+
+
+    //clients that connect and then don't read - the server has to leave the rest of each response
+    //waiting on the reactor rather than block, and uses no more threads for them
+    for (i = 0; i < TEST_NUM_CLIENTS; i++)
+    {
+        clients[i] = UnitConnect(port);
+        UNIT_CHECK(numFailures, clients[i] >= 0);
+    }
+
+    UNIT_CHECK(numFailures, UnitWaitFor([] { return (s_numResponses == TEST_NUM_CLIENTS); }));
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+    UNIT_CHECK(numFailures, TestNumThreads() == numThreads);
+
+
+    //then each gets the whole response, and the connection closed at the end of it
+    for (i = 0; i < TEST_NUM_CLIENTS; i++)
+    {
+        if (clients[i] >= 0)
+        {
+            UNIT_CHECK(numFailures, UnitReadAll(clients[i]) == response);
+            close(clients[i]);
+        }
+    }
+
+
+    //a client that goes away part way through doesn't upset the others
+    sock = UnitConnect(port);
+    UNIT_CHECK(numFailures, sock >= 0);
+    UNIT_CHECK(numFailures, UnitWaitFor([] { return (s_numResponses == TEST_NUM_CLIENTS + 1); }));
+    close(sock);
+
+    sock = UnitConnect(port);
+    UNIT_CHECK(numFailures, sock >= 0);
+
+    if (sock >= 0)
+    {
+        UNIT_CHECK(numFailures, UnitReadAll(sock) == response);
+        close(sock);
+    }
+
+
+    //stopping with a response still outstanding doesn't wait for the client
+    sock = UnitConnect(port);
+    UNIT_CHECK(numFailures, UnitWaitFor([] { return (s_numResponses == TEST_NUM_CLIENTS + 3); }));
+
+    server.Stop();
+    UNIT_CHECK(numFailures, server.IsRunning() == false);
+
+    if (sock >= 0)
+    {
+        UNIT_CHECK(numFailures, UnitReadAll(sock).size() < response.size());
+        close(sock);
+    }
+
+    return numFailures;
+}
+
+
+
+
+static uint32_t TestReceiveServer(void)
+{
+    TCPServer server;
+    const char* pRequest = "hello reactor";
+    char buffer[64];
+    uint32_t numFailures = 0;
+    uint16_t port;
+    int sock;
+
+    port = UnitGetFreePort(SOCK_STREAM);
+
+    server.SetReceiveCallback(TestEchoCallback, nullptr);
+    UNIT_CHECK(numFailures, server.StartAsThread(port, nullptr));
+
+    sock = UnitConnect(port);
+    UNIT_CHECK(numFailures, sock >= 0);
+
+    if (sock >= 0)
+    {
+        memset(buffer, 0, sizeof(buffer));
+
+        UNIT_CHECK(numFailures, send(sock, pRequest, strlen(pRequest), 0) == (ssize_t)strlen(pRequest));
+        UNIT_CHECK(numFailures, recv(sock, buffer, strlen(pRequest), MSG_WAITALL) == (ssize_t)strlen(pRequest));
+        UNIT_CHECK(numFailures, strcmp(buffer, pRequest) == 0);
+
+        close(sock);
+    }
+
+    server.Stop();
+
+    return numFailures;
+}
+
+
+
+
+static uint32_t TestConnectionServer(void)
+{
+    TCPServer server;
+    const char* pText = "legacy connection callback\n";
+    uint32_t numFailures = 0;
+    uint16_t port;
+    int sock;
+
+    port = UnitGetFreePort(SOCK_STREAM);
+
+    server.SetConnectionCallback(TestConnectionCallback, (void*)pText);
+    UNIT_CHECK(numFailures, server.StartAsThread(port, nullptr));
+
+    sock = UnitConnect(port);
+    UNIT_CHECK(numFailures, sock >= 0);
+
+    if (sock >= 0)
+    {
+        UNIT_CHECK(numFailures, UnitReadAll(sock) == pText);
+        close(sock);
+    }
+
+    server.Stop();
+
+    return numFailures;
+}
+
+
+
+
+uint32_t TestTCPServer(void)
+{
+    uint32_t numFailures = 0;
+
+    numFailures += TestResponseServer();
+    numFailures += TestReceiveServer();
+    numFailures += TestConnectionServer();
+
+    return numFailures;
+}
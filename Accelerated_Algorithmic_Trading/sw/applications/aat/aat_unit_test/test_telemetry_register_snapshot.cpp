@@ -0,0 +1,110 @@
+/*
+ * Copyright 2021 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <cstdint>
+
+#include "xlnx_virtual_device_interface.h"
+#include "xlnx_telemetry.h"
+#include "xlnx_telemetry_register_snapshot.h"
+
+#include "aat_unit_test.h"
+
+using namespace XLNX;
+
+
+
+//A snapshot is only served while the sampler is running, and then only for registers inside a block, so that
+//the driver GetStats calls never see stale values or registers the sampler does not read.
+
+#define TEST_SNAPSHOT_SHARED_NAME   "/xlnx_aat_unit_test_register_snapshot"
+
+#define TEST_BLOCK_ADDRESS          (0x00020000)
+#define TEST_BLOCK_NUM_WORDS        (4)
+
+//long enough that no second snapshot is taken while the test looks at the first
+#define TEST_INTERVAL_MILLISECONDS  (60000)
+
+
+
+
+uint32_t TestTelemetryRegisterSnapshot(void)
+{
+    uint32_t numFailures = 0;
+    VirtualDeviceInterface device;
+    Telemetry telemetry;
+    TelemetryReader* pReader = nullptr;
+    TelemetryRegisterSnapshot snapshot;
+    uint64_t sequence = 0;
+    bool bIsLoaded = true;
+    uint32_t value;
+    uint32_t i;
+
+    UNIT_CHECK(numFailures, telemetry.Initialise(&device, TEST_SNAPSHOT_SHARED_NAME) == XLNX_OK);
+    UNIT_CHECK(numFailures, telemetry.AddBlock("test", TEST_BLOCK_ADDRESS, TEST_BLOCK_NUM_WORDS) == XLNX_OK);
+    UNIT_CHECK(numFailures, telemetry.GetReader(&pReader) == XLNX_OK);
+
+    for (i = 0; i < TEST_BLOCK_NUM_WORDS; i++)
+    {
+        device.WriteReg32(TEST_BLOCK_ADDRESS + (i * sizeof(uint32_t)), 100 + i);
+    }
+
+
+    //no telemetry, or telemetry that is not sampling, leaves nothing loaded
+    UNIT_CHECK(numFailures, snapshot.Load(nullptr) == XLNX_TELEMETRY_ERROR_INVALID_PARAMETER);
+    UNIT_CHECK(numFailures, telemetry.Snapshot() == XLNX_OK);
+    UNIT_CHECK(numFailures, snapshot.Load(&telemetry) == XLNX_TELEMETRY_ERROR_NOT_RUNNING);
+    snapshot.IsLoaded(&bIsLoaded);
+    UNIT_CHECK(numFailures, bIsLoaded == false);
+    UNIT_CHECK(numFailures, snapshot.ReadReg32(TEST_BLOCK_ADDRESS, &value) != XLNX_OK);
+
+
+    //the sampler takes its first snapshot as soon as it starts
+    UNIT_CHECK(numFailures, pReader->GetSequence(&sequence) == XLNX_OK);
+    UNIT_CHECK(numFailures, telemetry.Start(TEST_INTERVAL_MILLISECONDS) == XLNX_OK);
+    UNIT_CHECK(numFailures, UnitWaitFor([&]() { uint64_t latest = 0; pReader->GetSequence(&latest); return (latest > sequence); }));
+
+    UNIT_CHECK(numFailures, snapshot.Load(&telemetry) == XLNX_OK);
+    snapshot.IsLoaded(&bIsLoaded);
+    UNIT_CHECK(numFailures, bIsLoaded);
+
+    for (i = 0; i < TEST_BLOCK_NUM_WORDS; i++)
+    {
+        value = 0;
+        UNIT_CHECK(numFailures, snapshot.ReadReg32(TEST_BLOCK_ADDRESS + (i * sizeof(uint32_t)), &value) == XLNX_OK);
+        UNIT_CHECK(numFailures, value == (100 + i));
+    }
+
+    //either side of the block and unaligned addresses are left to the device
+    UNIT_CHECK(numFailures, snapshot.ReadReg32(TEST_BLOCK_ADDRESS - sizeof(uint32_t), &value) == XLNX_TELEMETRY_ERROR_BLOCK_NOT_FOUND);
+    UNIT_CHECK(numFailures, snapshot.ReadReg32(TEST_BLOCK_ADDRESS + (TEST_BLOCK_NUM_WORDS * sizeof(uint32_t)), &value) == XLNX_TELEMETRY_ERROR_BLOCK_NOT_FOUND);
+    UNIT_CHECK(numFailures, snapshot.ReadReg32(TEST_BLOCK_ADDRESS + 2, &value) == XLNX_TELEMETRY_ERROR_BLOCK_NOT_FOUND);
+
+    //values come from the copy taken by Load, not the device
+    device.WriteReg32(TEST_BLOCK_ADDRESS, 999);
+    UNIT_CHECK(numFailures, snapshot.ReadReg32(TEST_BLOCK_ADDRESS, &value) == XLNX_OK);
+    UNIT_CHECK(numFailures, value == 100);
+
+
+    //once stopped the last snapshot is not used however recent it is
+    UNIT_CHECK(numFailures, telemetry.Stop() == XLNX_OK);
+    UNIT_CHECK(numFailures, snapshot.Load(&telemetry) == XLNX_TELEMETRY_ERROR_NOT_RUNNING);
+    UNIT_CHECK(numFailures, snapshot.ReadReg32(TEST_BLOCK_ADDRESS, &value) != XLNX_OK);
+
+    telemetry.Uninitialise();
+
+    return numFailures;
+}
@@ -0,0 +1,248 @@
+/*
+ * Copyright 2021 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <atomic>
+#include <condition_variable>
+#include <cstring>
+#include <mutex>
+#include <vector>
+
+#include <unistd.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+
+#include "xlnx_socket_reactor.h"
+#include "xlnx_udp_server.h"
+
+#include "aat_unit_test.h"
+
+using namespace XLNX;
+
+
+
+//The server shares a single threaded reactor with a socket whose callback the test can hold up.  With the
+//reactor thread held, datagrams queue up on the server's socket, and are then all there for the
+//recvmmsg batching when the thread is let go.
+
+#define TEST_NUM_DATAGRAMS      (80)        //two full batches and a partial one
+#define TEST_RECEIVE_BATCH_SIZE (32)        //UDPServer::RECEIVE_BATCH_SIZE
+#define TEST_TRUNCATED_LENGTH   (3000)      //longer than UDPServer::MAX_RECEIVE_LENGTH
+#define TEST_MAX_RECEIVE_LENGTH (2048)
+
+
+
+
+class TestReactorBlocker
+{
+public:
+    int fds[2] = { -1, -1 };
+
+    std::mutex mutex;
+    std::condition_variable condition;
+    bool bRelease = false;
+    std::atomic<bool> bBlocked{false};
+
+
+    static void Callback(void* pDataObject, SOCKET sock, uint32_t events)
+    {
+        TestReactorBlocker* pBlocker = (TestReactorBlocker*)pDataObject;
+        uint8_t byte;
+        ssize_t numBytesRead;
+
+        (void)events;
+
+        numBytesRead = read(sock, &byte, 1);
+        (void)numBytesRead;
+
+        std::unique_lock<std::mutex> lock(pBlocker->mutex);
+
+        pBlocker->bBlocked = true;
+        pBlocker->condition.wait(lock, [pBlocker] { return pBlocker->bRelease; });
+        pBlocker->bBlocked = false;
+        pBlocker->bRelease = false;
+    }
+
+
+    bool Block(void)
+    {
+        uint8_t byte = 0;
+
+        if (write(fds[1], &byte, 1) != 1)
+        {
+            return false;
+        }
+
+        return UnitWaitFor([this] { return (bBlocked == true); });
+    }
+
+
+    void Release(void)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            bRelease = true;
+        }
+
+        condition.notify_all();
+    }
+};
+
+
+
+
+class TestUDPReceiver
+{
+public:
+    std::mutex mutex;
+    std::vector<std::vector<uint8_t> > datagrams;
+
+
+    static void Callback(void* pDataObject, uint8_t* pBuffer, uint32_t dataLength)
+    {
+        TestUDPReceiver* pReceiver = (TestUDPReceiver*)pDataObject;
+
+        std::lock_guard<std::mutex> lock(pReceiver->mutex);
+        pReceiver->datagrams.push_back(std::vector<uint8_t>(pBuffer, pBuffer + dataLength));
+    }
+
+
+    size_t NumReceived(void)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        return datagrams.size();
+    }
+};
+
+
+
+
+uint32_t TestUDPServer(void)
+{
+    SocketReactor reactor;
+    UDPServer server;
+    UDPServer::Stats stats;
+    TestReactorBlocker blocker;
+    TestUDPReceiver receiver;
+    struct sockaddr_in address;
+    std::vector<uint8_t> datagram;
+    bool bRunning = false;
+    uint16_t port;
+    uint32_t numFailures = 0;
+    uint32_t i;
+    int sock;
+
+
+    port = UnitGetFreePort(SOCK_DGRAM);
+    sock = socket(AF_INET, SOCK_DGRAM, 0);
+
+    UNIT_CHECK(numFailures, port != 0);
+    UNIT_CHECK(numFailures, sock >= 0);
+    UNIT_CHECK(numFailures, socketpair(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0, blocker.fds) == 0);
+
+    if (numFailures != 0)
+    {
+        return numFailures;
+    }
+
+
+    UNIT_CHECK(numFailures, reactor.Start(1) == XLNX_OK);
+    UNIT_CHECK(numFailures, reactor.AddSocket(blocker.fds[0], EPOLLIN, TestReactorBlocker::Callback, &blocker) == XLNX_OK);
+
+    server.SetReactor(&reactor);
+    server.SetReceiveCallback(TestUDPReceiver::Callback, &receiver);
+    server.StartAsThread(port);
+
+    UNIT_CHECK(numFailures, server.IsRunning());
+
+
+    memset(&address, 0, sizeof(address));
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    address.sin_port = htons(port);
+
+
+    //queue the datagrams up while the reactor is busy elsewhere...
+    UNIT_CHECK(numFailures, blocker.Block());
+
+    for (i = 0; i < TEST_NUM_DATAGRAMS; i++)
+    {
+        datagram.assign(1 + (i % 100), (uint8_t)i);
+        UNIT_CHECK(numFailures, sendto(sock, datagram.data(), datagram.size(), 0, (struct sockaddr*)&address, sizeof(address)) == (ssize_t)datagram.size());
+    }
+
+    blocker.Release();
+
+
+    //...so that they are read in as few recvmmsg calls as the batch size allows, in order and intact
+    UNIT_CHECK(numFailures, UnitWaitFor([&receiver] { return (receiver.NumReceived() == TEST_NUM_DATAGRAMS); }));
+
+    server.GetStats(&stats);
+
+    UNIT_CHECK(numFailures, stats.numPackets == TEST_NUM_DATAGRAMS);
+    UNIT_CHECK(numFailures, stats.numBatches == ((TEST_NUM_DATAGRAMS + TEST_RECEIVE_BATCH_SIZE - 1) / TEST_RECEIVE_BATCH_SIZE));
+    UNIT_CHECK(numFailures, stats.numTruncatedPackets == 0);
+
+    {
+        std::lock_guard<std::mutex> lock(receiver.mutex);
+
+        for (i = 0; (i < TEST_NUM_DATAGRAMS) && (i < receiver.datagrams.size()); i++)
+        {
+            datagram.assign(1 + (i % 100), (uint8_t)i);
+            UNIT_CHECK(numFailures, receiver.datagrams[i] == datagram);
+        }
+    }
+
+
+    //a datagram too big for the receive buffer is passed on cut short, and counted
+    datagram.assign(TEST_TRUNCATED_LENGTH, 0xA5);
+    UNIT_CHECK(numFailures, sendto(sock, datagram.data(), datagram.size(), 0, (struct sockaddr*)&address, sizeof(address)) == (ssize_t)datagram.size());
+
+    UNIT_CHECK(numFailures, UnitWaitFor([&receiver] { return (receiver.NumReceived() == TEST_NUM_DATAGRAMS + 1); }));
+
+    server.GetStats(&stats);
+
+    UNIT_CHECK(numFailures, stats.numPackets == TEST_NUM_DATAGRAMS + 1);
+    UNIT_CHECK(numFailures, stats.numTruncatedPackets == 1);
+
+    {
+        std::lock_guard<std::mutex> lock(receiver.mutex);
+
+        if (receiver.datagrams.size() > TEST_NUM_DATAGRAMS)
+        {
+            UNIT_CHECK(numFailures, receiver.datagrams[TEST_NUM_DATAGRAMS].size() == TEST_MAX_RECEIVE_LENGTH);
+        }
+    }
+
+
+    //the shared reactor is left running for its other sockets
+    server.Stop();
+
+    reactor.IsRunning(&bRunning);
+
+    UNIT_CHECK(numFailures, server.IsRunning() == false);
+    UNIT_CHECK(numFailures, bRunning);
+
+
+    reactor.Stop();
+
+    close(sock);
+    close(blocker.fds[0]);
+    close(blocker.fds[1]);
+
+    return numFailures;
+}
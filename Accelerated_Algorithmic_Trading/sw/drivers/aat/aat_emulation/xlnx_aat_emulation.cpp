@@ -0,0 +1,708 @@
+/*
+ * Copyright 2021 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+
+#include <cstring>
+#include <cstdlib>
+
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+
+#include "xlnx_aat_emulation.h"
+#include "xlnx_aat_emulation_kernels.h"
+#include "xlnx_feed_decoder_error_codes.h"
+
+using namespace XLNX;
+
+
+
+
+#define UDP_SOURCE_PREFIX           "udp:"
+#define UDP_SOURCE_PREFIX_LENGTH    (4)
+
+#define UDP_RECEIVE_TIMEOUT_MICROSECONDS    (100000)    //bounds how long Stop() waits for an idle socket
+#define UDP_RECEIVE_BUFFER_SIZE             (4 * 1024 * 1024)
+
+
+
+//The emulated kernels are attached under the CU names the AAT business object looks up...
+static const char* FEED_HANDLER_CU_NAME             = "feedHandlerTop:feedHandlerTop";
+static const char* ORDER_BOOK_CU_NAME               = "orderBookTop:orderBookTop";
+static const char* ORDER_BOOK_DATA_MOVER_CU_NAME    = "orderBookDataMoverTop:orderBookDataMoverTop";
+static const char* RISK_ENGINE_CU_NAME              = "riskEngineTop:riskEngineTop";
+static const char* PRICING_ENGINE_CU_NAME           = "pricingEngineTop:pricingEngineTop";
+static const char* ORDER_ENTRY_CU_NAME              = "orderEntryTcpTop:orderEntryTcpTop";
+
+
+//...while the rest of the design is present as plain register storage so that its drivers still initialise
+static const char* REGISTER_ONLY_CU_NAMES[] =
+{
+    "ethernet_krnl_axis_x4:eth0",
+    "udp_ip_krnl:udp_ip0",
+    "udp_ip_krnl:udp_ip1",
+    "tcp_ip_krnl:tcp_ip0",
+    "lineHandlerTop:lineHandlerTop",
+    "clockTickGeneratorTop:clockTickGeneratorTop"
+};
+
+static const uint32_t NUM_REGISTER_ONLY_CU_NAMES = (uint32_t)(sizeof(REGISTER_ONLY_CU_NAMES) / sizeof(REGISTER_ONLY_CU_NAMES[0]));
+
+
+
+
+AATEmulation::AATEmulation()
+{
+    uint32_t i;
+
+    m_bInitialised = false;
+    m_pDeviceInterface = nullptr;
+
+    m_pChannels = nullptr;
+    m_pFeedHandler = nullptr;
+    m_pOrderEntry = nullptr;
+
+    for (i = 0; i < NUM_EMULATED_KERNELS; i++)
+    {
+        m_kernels[i] = nullptr;
+        m_kernelCUNames[i] = nullptr;
+    }
+
+    m_bKernelsKeepRunning = false;
+
+    m_numSourceLoops = 1;
+    m_socket = -1;
+    m_bSourceKeepRunning = false;
+
+    m_numPacketsInjected = 0;
+    m_numBytesInjected = 0;
+    m_numSourceLoopsCompleted = 0;
+    m_numSourceDrops = 0;
+
+    m_sourceStartTime = std::chrono::steady_clock::now();
+    m_sourceStopTime = m_sourceStartTime;
+}
+
+
+
+
+AATEmulation::~AATEmulation()
+{
+    Uninitialise();
+}
+
+
+
+
+
+uint32_t AATEmulation::Initialise(VirtualDeviceInterface* pDeviceInterface)
+{
+    uint32_t retval = XLNX_OK;
+    uint32_t i;
+
+    if (pDeviceInterface == nullptr)
+    {
+        retval = XLNX_AAT_EMULATION_ERROR_INVALID_PARAMETER;
+    }
+
+
+    if (retval == XLNX_OK)
+    {
+        Uninitialise();
+
+        m_pDeviceInterface = pDeviceInterface;
+
+        m_pChannels = new EmulationChannels();
+
+        m_pFeedHandler = new FeedHandlerKernel(m_pChannels);
+        m_pOrderEntry = new OrderEntryKernel(m_pChannels);
+
+        m_kernels[0] = m_pFeedHandler;                              m_kernelCUNames[0] = FEED_HANDLER_CU_NAME;
+        m_kernels[1] = new OrderBookKernel(m_pChannels);            m_kernelCUNames[1] = ORDER_BOOK_CU_NAME;
+        m_kernels[2] = new OrderBookDataMoverKernel(m_pChannels);   m_kernelCUNames[2] = ORDER_BOOK_DATA_MOVER_CU_NAME;
+        m_kernels[3] = new RiskEngineKernel(m_pChannels);           m_kernelCUNames[3] = RISK_ENGINE_CU_NAME;
+        m_kernels[4] = new PricingEngineKernel(m_pChannels);        m_kernelCUNames[4] = PRICING_ENGINE_CU_NAME;
+        m_kernels[5] = m_pOrderEntry;                               m_kernelCUNames[5] = ORDER_ENTRY_CU_NAME;
+
+
+        //Only the CUs that actually exist in the design should resolve, otherwise drivers that probe for
+        //alternative kernel names (e.g. OrderEntry) would bind to an auto-created CU instead of ours
+        m_pDeviceInterface->SetStrictCUNames(true);
+    }
+
+
+    for (i = 0; (i < NUM_EMULATED_KERNELS) && (retval == XLNX_OK); i++)
+    {
+        if (m_pDeviceInterface->AddCU(m_kernelCUNames[i], m_kernels[i]) != XLNX_OK)
+        {
+            retval = XLNX_AAT_EMULATION_ERROR_FAILED_TO_ADD_CU;
+        }
+    }
+
+
+    for (i = 0; (i < NUM_REGISTER_ONLY_CU_NAMES) && (retval == XLNX_OK); i++)
+    {
+        if (m_pDeviceInterface->AddCU(REGISTER_ONLY_CU_NAMES[i], nullptr) != XLNX_OK)
+        {
+            retval = XLNX_AAT_EMULATION_ERROR_FAILED_TO_ADD_CU;
+        }
+    }
+
+
+    if (retval == XLNX_OK)
+    {
+        m_bInitialised = true;
+
+        m_bKernelsKeepRunning = true;
+
+        for (i = 0; i < NUM_EMULATED_KERNELS; i++)
+        {
+            m_kernelThreads[i] = std::thread(&AATEmulation::KernelThreadFunc, this, m_kernels[i]);
+        }
+    }
+    else if (m_pDeviceInterface != nullptr)
+    {
+        m_bInitialised = true; //so that Uninitialise() tidies up the partial state
+        Uninitialise();
+    }
+
+    return retval;
+}
+
+
+
+
+
+uint32_t AATEmulation::Uninitialise(void)
+{
+    uint32_t retval = XLNX_OK;
+    uint32_t i;
+
+    if (m_bInitialised)
+    {
+        Stop();
+
+        m_bKernelsKeepRunning = false;
+
+        for (i = 0; i < NUM_EMULATED_KERNELS; i++)
+        {
+            if (m_kernelThreads[i].joinable())
+            {
+                m_kernelThreads[i].join();
+            }
+        }
+
+
+        //detach from the virtual device before the kernels go away, the CUs fall back to plain registers
+        for (i = 0; i < NUM_EMULATED_KERNELS; i++)
+        {
+            if (m_kernelCUNames[i] != nullptr)
+            {
+                m_pDeviceInterface->AddCU(m_kernelCUNames[i], nullptr);
+            }
+
+            delete m_kernels[i];
+
+            m_kernels[i] = nullptr;
+            m_kernelCUNames[i] = nullptr;
+        }
+
+        delete m_pChannels;
+
+        m_pChannels = nullptr;
+        m_pFeedHandler = nullptr;
+        m_pOrderEntry = nullptr;
+        m_pDeviceInterface = nullptr;
+
+        m_bInitialised = false;
+    }
+
+    return retval;
+}
+
+
+
+
+
+uint32_t AATEmulation::IsInitialised(bool* pbIsInitialised)
+{
+    *pbIsInitialised = m_bInitialised;
+
+    return XLNX_OK;
+}
+
+
+
+
+
+uint32_t AATEmulation::CheckInitialised(void)
+{
+    uint32_t retval = XLNX_OK;
+
+    if (m_bInitialised == false)
+    {
+        retval = XLNX_AAT_EMULATION_ERROR_NOT_INITIALISED;
+    }
+
+    return retval;
+}
+
+
+
+
+
+uint32_t AATEmulation::SetSource(const char* source)
+{
+    uint32_t retval = XLNX_OK;
+    bool bIsRunning = false;
+
+    if (source == nullptr)
+    {
+        retval = XLNX_AAT_EMULATION_ERROR_INVALID_PARAMETER;
+    }
+
+    if (retval == XLNX_OK)
+    {
+        IsRunning(&bIsRunning);
+
+        if (bIsRunning)
+        {
+            retval = XLNX_AAT_EMULATION_ERROR_ALREADY_RUNNING;
+        }
+    }
+
+    if (retval == XLNX_OK)
+    {
+        m_source = source;
+    }
+
+    return retval;
+}
+
+
+
+
+
+uint32_t AATEmulation::GetSource(const char** ppSource)
+{
+    *ppSource = m_source.c_str();
+
+    return XLNX_OK;
+}
+
+
+
+
+
+uint32_t AATEmulation::SetSourceLoops(uint32_t numLoops)
+{
+    m_numSourceLoops = numLoops;
+
+    return XLNX_OK;
+}
+
+
+
+
+
+uint32_t AATEmulation::GetSourceLoops(uint32_t* pNumLoops)
+{
+    *pNumLoops = m_numSourceLoops;
+
+    return XLNX_OK;
+}
+
+
+
+
+
+uint32_t AATEmulation::Start(void)
+{
+    uint32_t retval = XLNX_OK;
+    bool bIsRunning = false;
+    const char* pPortString;
+    const char* pSeparator;
+    char addressString[INET_ADDRSTRLEN];
+    struct in_addr groupAddress;
+    struct sockaddr_in bindAddress;
+    struct ip_mreq membership;
+    struct timeval timeout;
+    unsigned long port;
+    char* pEnd;
+    int reuse = 1;
+    int receiveBufferSize = UDP_RECEIVE_BUFFER_SIZE;
+
+    retval = CheckInitialised();
+
+
+    if (retval == XLNX_OK)
+    {
+        IsRunning(&bIsRunning);
+
+        if (bIsRunning)
+        {
+            retval = XLNX_AAT_EMULATION_ERROR_ALREADY_RUNNING;
+        }
+    }
+
+
+    if (retval == XLNX_OK)
+    {
+        //a previous replay may have finished by itself, in which case the thread still needs to be joined
+        if (m_sourceThread.joinable())
+        {
+            m_sourceThread.join();
+        }
+
+        if (m_source.empty())
+        {
+            retval = XLNX_AAT_EMULATION_ERROR_NO_SOURCE;
+        }
+    }
+
+
+    if (retval == XLNX_OK)
+    {
+        if (strncmp(m_source.c_str(), UDP_SOURCE_PREFIX, UDP_SOURCE_PREFIX_LENGTH) == 0)
+        {
+            pPortString = m_source.c_str() + UDP_SOURCE_PREFIX_LENGTH;
+            groupAddress.s_addr = htonl(INADDR_ANY);
+
+            pSeparator = strrchr(pPortString, ':');
+            if (pSeparator != nullptr)
+            {
+                if ((size_t)(pSeparator - pPortString) >= sizeof(addressString))
+                {
+                    retval = XLNX_AAT_EMULATION_ERROR_INVALID_PARAMETER;
+                }
+                else
+                {
+                    memcpy(addressString, pPortString, pSeparator - pPortString);
+                    addressString[pSeparator - pPortString] = '\0';
+
+                    if (inet_pton(AF_INET, addressString, &groupAddress) != 1)
+                    {
+                        retval = XLNX_AAT_EMULATION_ERROR_INVALID_PARAMETER;
+                    }
+                }
+
+                pPortString = pSeparator + 1;
+            }
+
+            port = strtoul(pPortString, &pEnd, 10);
+
+            if ((*pEnd != '\0') || (port == 0) || (port > 0xFFFF))
+            {
+                retval = XLNX_AAT_EMULATION_ERROR_INVALID_PARAMETER;
+            }
+
+
+            if (retval == XLNX_OK)
+            {
+                m_socket = socket(AF_INET, SOCK_DGRAM, 0);
+
+                if (m_socket < 0)
+                {
+                    retval = XLNX_AAT_EMULATION_ERROR_FAILED_TO_OPEN_SOURCE;
+                }
+            }
+
+            if (retval == XLNX_OK)
+            {
+                setsockopt(m_socket, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+                setsockopt(m_socket, SOL_SOCKET, SO_RCVBUF, &receiveBufferSize, sizeof(receiveBufferSize));
+
+                timeout.tv_sec = 0;
+                timeout.tv_usec = UDP_RECEIVE_TIMEOUT_MICROSECONDS;
+                setsockopt(m_socket, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+
+                memset(&bindAddress, 0, sizeof(bindAddress));
+                bindAddress.sin_family = AF_INET;
+                bindAddress.sin_addr.s_addr = htonl(INADDR_ANY);
+                bindAddress.sin_port = htons((uint16_t)port);
+
+                if (bind(m_socket, (struct sockaddr*)&bindAddress, sizeof(bindAddress)) != 0)
+                {
+                    retval = XLNX_AAT_EMULATION_ERROR_FAILED_TO_OPEN_SOURCE;
+                }
+            }
+
+            if ((retval == XLNX_OK) && IN_MULTICAST(ntohl(groupAddress.s_addr)))
+            {
+                membership.imr_multiaddr = groupAddress;
+                membership.imr_interface.s_addr = htonl(INADDR_ANY);
+
+                if (setsockopt(m_socket, IPPROTO_IP, IP_ADD_MEMBERSHIP, &membership, sizeof(membership)) != 0)
+                {
+                    retval = XLNX_AAT_EMULATION_ERROR_FAILED_TO_OPEN_SOURCE;
+                }
+            }
+
+            if ((retval != XLNX_OK) && (m_socket >= 0))
+            {
+                close(m_socket);
+                m_socket = -1;
+            }
+        }
+        else
+        {
+            if (m_pcapReader.Open(m_source.c_str()) != XLNX_OK)
+            {
+                retval = XLNX_AAT_EMULATION_ERROR_FAILED_TO_OPEN_SOURCE;
+            }
+        }
+    }
+
+
+    if (retval == XLNX_OK)
+    {
+        m_numPacketsInjected = 0;
+        m_numBytesInjected = 0;
+        m_numSourceLoopsCompleted = 0;
+        m_numSourceDrops = 0;
+
+        m_sourceStartTime = std::chrono::steady_clock::now();
+        m_sourceStopTime = m_sourceStartTime;
+
+        m_bSourceKeepRunning = true;
+
+        m_sourceThread = std::thread(&AATEmulation::SourceThreadFunc, this);
+    }
+
+    return retval;
+}
+
+
+
+
+
+uint32_t AATEmulation::Stop(void)
+{
+    uint32_t retval = XLNX_OK;
+
+    m_bSourceKeepRunning = false;
+
+    if (m_sourceThread.joinable())
+    {
+        m_sourceThread.join();
+    }
+
+    return retval;
+}
+
+
+
+
+
+uint32_t AATEmulation::IsRunning(bool* pbIsRunning)
+{
+    *pbIsRunning = m_bSourceKeepRunning;
+
+    return XLNX_OK;
+}
+
+
+
+
+
+uint32_t AATEmulation::GetStats(Stats* pStats)
+{
+    uint32_t retval = XLNX_OK;
+    std::chrono::steady_clock::time_point endTime;
+
+    retval = CheckInitialised();
+
+    if (retval == XLNX_OK)
+    {
+        pStats->numPacketsInjected      = m_numPacketsInjected;
+        pStats->numBytesInjected        = m_numBytesInjected;
+        pStats->numSourceLoops          = m_numSourceLoopsCompleted;
+        pStats->numSourceDrops          = m_numSourceDrops;
+
+        pStats->numFeedOperations       = m_pChannels->bookOperation.GetNumTransferred();
+        pStats->numBookResponses        = m_pChannels->bookResponse.GetNumTransferred();
+        pStats->numDataMoverResponses   = m_pChannels->bookDataMove.GetNumTransferred();
+        pStats->numPricingOperations    = m_pChannels->pricingOperation.GetNumTransferred();
+        pStats->numRiskOperations       = m_pChannels->riskOperation.GetNumTransferred();
+        pStats->numHostOperations       = m_pChannels->hostOperation.GetNumTransferred();
+
+        m_pOrderEntry->GetTxStats(&pStats->numTxMessages, &pStats->numTxBytes, &pStats->numConnections);
+
+        if (m_bSourceKeepRunning)
+        {
+            endTime = std::chrono::steady_clock::now();
+        }
+        else
+        {
+            endTime = m_sourceStopTime;
+        }
+
+        pStats->elapsedNanoseconds = (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(endTime - m_sourceStartTime).count();
+    }
+
+    return retval;
+}
+
+
+
+
+
+void AATEmulation::KernelThreadFunc(EmulatedKernel* pKernel)
+{
+    uint32_t numIdlePasses = 0;
+
+    while (m_bKernelsKeepRunning)
+    {
+        if (pKernel->Step())
+        {
+            numIdlePasses = 0;
+        }
+        else
+        {
+            //spin for a while so a burst does not pay a sleep on every hop, then back off
+            if (numIdlePasses < IDLE_SPIN_PASSES)
+            {
+                numIdlePasses++;
+                std::this_thread::yield();
+            }
+            else
+            {
+                std::this_thread::sleep_for(std::chrono::microseconds(IDLE_SLEEP_MICROSECONDS));
+            }
+        }
+    }
+}
+
+
+
+
+
+void AATEmulation::SourceThreadFunc(void)
+{
+    if (m_socket >= 0)
+    {
+        RunUDPSource();
+
+        close(m_socket);
+        m_socket = -1;
+    }
+    else
+    {
+        RunPCAPSource();
+
+        m_pcapReader.Close();
+    }
+
+    m_sourceStopTime = std::chrono::steady_clock::now();
+
+    m_bSourceKeepRunning = false;
+}
+
+
+
+
+
+uint32_t AATEmulation::RunPCAPSource(void)
+{
+    uint32_t retval = XLNX_OK;
+    const uint8_t* pPayload;
+    uint32_t payloadLength;
+    uint64_t captureTimestamp;
+
+    while (m_bSourceKeepRunning)
+    {
+        retval = m_pcapReader.GetNextUDPPayload(&pPayload, &payloadLength, &captureTimestamp);
+
+        if (retval == XLNX_FEED_DECODER_ERROR_END_OF_FILE)
+        {
+            m_numSourceLoopsCompleted++;
+
+            if ((m_numSourceLoops != 0) && (m_numSourceLoopsCompleted >= m_numSourceLoops))
+            {
+                retval = XLNX_OK;
+                break; //out of loop
+            }
+
+            retval = m_pcapReader.Rewind();
+        }
+        else if (retval == XLNX_OK)
+        {
+            //replay runs as fast as the pipeline accepts data, the capture timestamps are not honoured
+            while ((InjectPayload(pPayload, payloadLength) == false) && m_bSourceKeepRunning)
+            {
+                std::this_thread::sleep_for(std::chrono::microseconds(IDLE_SLEEP_MICROSECONDS));
+            }
+        }
+
+        if (retval != XLNX_OK)
+        {
+            break; //out of loop
+        }
+    }
+
+    return retval;
+}
+
+
+
+
+
+uint32_t AATEmulation::RunUDPSource(void)
+{
+    uint32_t retval = XLNX_OK;
+    uint8_t datagram[MAX_DATAGRAM_SIZE];
+    ssize_t numBytes;
+
+    while (m_bSourceKeepRunning)
+    {
+        numBytes = recv(m_socket, datagram, sizeof(datagram), 0);
+
+        if (numBytes > 0)
+        {
+            //a live feed cannot be paused, so anything arriving while the FeedHandler is backed up is lost
+            if (InjectPayload(datagram, (uint32_t)numBytes) == false)
+            {
+                m_numSourceDrops++;
+            }
+        }
+    }
+
+    return retval;
+}
+
+
+
+
+
+bool AATEmulation::InjectPayload(const uint8_t* pPayload, uint32_t payloadLength)
+{
+    bool bAccepted;
+
+    //the LineHandler stamps every packet with a non-zero ingress timestamp, a running packet
+    //count stands in for its clock here
+    bAccepted = m_pFeedHandler->InjectPayload(pPayload, payloadLength, m_numPacketsInjected + 1);
+
+    if (bAccepted)
+    {
+        m_numPacketsInjected++;
+        m_numBytesInjected += payloadLength;
+    }
+
+    return bAccepted;
+}
@@ -0,0 +1,170 @@
+/*
+ * Copyright 2021 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+
+#ifndef XLNX_AAT_EMULATION_H
+#define XLNX_AAT_EMULATION_H
+
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <atomic>
+#include <chrono>
+
+#include "xlnx_virtual_device_interface.h"
+#include "xlnx_feed_decoder_pcap_reader.h"
+
+#include "xlnx_aat_emulation_error_codes.h"
+
+
+namespace XLNX
+{
+
+
+class EmulationChannels;
+class EmulatedKernel;
+class FeedHandlerKernel;
+class OrderEntryKernel;
+
+
+
+
+//Runs the AAT datapath kernels (FeedHandler -> OrderBook -> RiskEngine -> PricingEngine -> OrderEntry,
+//plus the OrderBook DataMover) as HLS C-simulation models behind a VirtualDeviceInterface, so that the
+//shell, drivers and host pricing path can be exercised end-to-end without an accelerator card.
+//
+//Each emulated kernel is attached to the virtual device under the same CU name the real design uses,
+//and runs on its own thread from Initialise() until Uninitialise().  Market data is fed in by a separate
+//source thread, either replaying a PCAP file or receiving from a UDP socket, in place of the
+//Ethernet/UDP/LineHandler front end.
+class AATEmulation
+{
+public:
+    AATEmulation();
+    virtual ~AATEmulation();
+
+
+public:
+    uint32_t Initialise(VirtualDeviceInterface* pDeviceInterface);
+    uint32_t Uninitialise(void);
+    uint32_t IsInitialised(bool* pbIsInitialised);
+
+
+
+public: //Packet Source
+    //"<file>.pcap" replays a capture file, "udp:[<address>:]<port>" receives from a socket, joining the
+    //multicast group if the address given is a multicast one
+    uint32_t SetSource(const char* source);
+    uint32_t GetSource(const char** ppSource);
+
+    //Number of times a PCAP source is replayed, 0 = repeat until stopped
+    uint32_t SetSourceLoops(uint32_t numLoops);
+    uint32_t GetSourceLoops(uint32_t* pNumLoops);
+
+
+
+public: //Source Control
+    uint32_t Start(void);
+    uint32_t Stop(void);
+    uint32_t IsRunning(bool* pbIsRunning);
+
+
+
+public: //Stats
+    typedef struct
+    {
+        uint64_t numPacketsInjected;
+        uint64_t numBytesInjected;
+        uint64_t numSourceLoops;
+        uint64_t numSourceDrops;            //UDP datagrams that arrived while the FeedHandler was backed up
+
+        uint64_t numFeedOperations;         //FeedHandler   -> OrderBook
+        uint64_t numBookResponses;          //OrderBook     -> RiskEngine
+        uint64_t numDataMoverResponses;     //OrderBook     -> DataMover
+        uint64_t numPricingOperations;      //PricingEngine -> RiskEngine
+        uint64_t numRiskOperations;         //RiskEngine    -> OrderEntry
+        uint64_t numHostOperations;         //DataMover     -> OrderEntry
+
+        uint64_t numTxMessages;
+        uint64_t numTxBytes;
+        uint32_t numConnections;
+
+        uint64_t elapsedNanoseconds;        //time the source has been running for
+
+    }Stats;
+
+    uint32_t GetStats(Stats* pStats);
+
+
+
+protected:
+    void KernelThreadFunc(EmulatedKernel* pKernel);
+    void SourceThreadFunc(void);
+
+    uint32_t RunPCAPSource(void);
+    uint32_t RunUDPSource(void);
+
+    uint32_t CheckInitialised(void);
+
+    //Hands a payload to the FeedHandler, returns false if it is backed up and the payload was not taken
+    bool InjectPayload(const uint8_t* pPayload, uint32_t payloadLength);
+
+
+
+protected:
+    static const uint32_t NUM_EMULATED_KERNELS = 6;
+
+    //number of consecutive idle passes a thread spins (yielding) for before it starts sleeping
+    static const uint32_t IDLE_SPIN_PASSES = 1000;
+    static const uint32_t IDLE_SLEEP_MICROSECONDS = 100;
+
+    static const uint32_t MAX_DATAGRAM_SIZE = 9000;
+
+
+    bool m_bInitialised;
+    VirtualDeviceInterface* m_pDeviceInterface;
+
+    EmulationChannels* m_pChannels;
+    FeedHandlerKernel* m_pFeedHandler;
+    OrderEntryKernel* m_pOrderEntry;
+    EmulatedKernel* m_kernels[NUM_EMULATED_KERNELS];
+    const char* m_kernelCUNames[NUM_EMULATED_KERNELS];
+    std::thread m_kernelThreads[NUM_EMULATED_KERNELS];
+    std::atomic<bool> m_bKernelsKeepRunning;
+
+    std::string m_source;
+    uint32_t m_numSourceLoops;
+    PCAPReader m_pcapReader;
+    int m_socket;
+    std::thread m_sourceThread;
+    std::atomic<bool> m_bSourceKeepRunning;
+
+    std::atomic<uint64_t> m_numPacketsInjected;
+    std::atomic<uint64_t> m_numBytesInjected;
+    std::atomic<uint64_t> m_numSourceLoopsCompleted;
+    std::atomic<uint64_t> m_numSourceDrops;
+    std::chrono::steady_clock::time_point m_sourceStartTime;
+    std::chrono::steady_clock::time_point m_sourceStopTime;
+};
+
+
+
+} //namespace XLNX
+
+
+
+#endif
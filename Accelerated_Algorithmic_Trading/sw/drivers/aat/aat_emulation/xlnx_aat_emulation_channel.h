@@ -0,0 +1,154 @@
+/*
+ * Copyright 2021 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+
+#ifndef XLNX_AAT_EMULATION_CHANNEL_H
+#define XLNX_AAT_EMULATION_CHANNEL_H
+
+#include <cstdint>
+#include <deque>
+#include <mutex>
+
+#include "hls_stream.h"
+
+
+namespace XLNX
+{
+
+
+//Thread-safe FIFO that stands in for an AXI-Stream connection between two emulated kernels.
+//Each kernel runs on its own thread and only ever touches its own local hls::stream objects, items
+//are moved across in bulk at the start (inputs) and end (outputs) of each kernel step.
+template <typename T>
+class EmulationChannel
+{
+public:
+    //Once this many items are queued the producer stops pulling new input, mirroring the backpressure
+    //a full FIFO would apply in HW
+    static const uint32_t HIGH_WATERMARK = 4096;
+
+
+
+public:
+    EmulationChannel()
+    {
+        m_numTransferred = 0;
+    }
+
+
+
+    //Moves everything from the producer's local stream into the channel, returns the number of items moved
+    uint32_t Put(hls::stream<T>& source)
+    {
+        uint32_t numItems = 0;
+
+        if (source.empty() == false)
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+
+            while (source.empty() == false)
+            {
+                m_queue.push_back(source.read());
+                numItems++;
+            }
+
+            m_numTransferred += numItems;
+        }
+
+        return numItems;
+    }
+
+
+
+    void Put(const T& item)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        m_queue.push_back(item);
+        m_numTransferred++;
+    }
+
+
+
+    //Moves up to maxItems from the channel into the consumer's local stream, returns the number of items moved
+    uint32_t Get(hls::stream<T>& destination, uint32_t maxItems)
+    {
+        uint32_t numItems = 0;
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        while ((numItems < maxItems) && (m_queue.empty() == false))
+        {
+            destination.write(m_queue.front());
+            m_queue.pop_front();
+            numItems++;
+        }
+
+        return numItems;
+    }
+
+
+
+    bool IsAboveWatermark(void)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        return (m_queue.size() >= HIGH_WATERMARK);
+    }
+
+
+
+    uint32_t GetLevel(void)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        return (uint32_t)m_queue.size();
+    }
+
+
+
+    uint64_t GetNumTransferred(void)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        return m_numTransferred;
+    }
+
+
+
+    void Clear(void)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        m_queue.clear();
+        m_numTransferred = 0;
+    }
+
+
+
+protected:
+    std::mutex m_mutex;
+    std::deque<T> m_queue;
+    uint64_t m_numTransferred;
+};
+
+
+
+} //namespace XLNX
+
+
+
+#endif
@@ -0,0 +1,1107 @@
+/*
+ * Copyright 2021 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+
+#include <cstring>
+
+#include "xlnx_aat_emulation_kernels.h"
+#include "xlnx_aat_emulation_error_codes.h"
+
+#include "xlnx_feed_handler_address_map.h"
+#include "xlnx_order_book_address_map.h"
+#include "xlnx_order_book_data_mover_address_map.h"
+#include "xlnx_pricing_engine_address_map.h"
+#include "xlnx_risk_engine_address_map.h"
+#include "xlnx_order_entry_address_map.h"
+
+using namespace XLNX;
+
+
+
+//The following registers exist in the kernel register structs but the drivers do not currently use them,
+//so there are no entries for them in the driver address maps
+#define EMULATION_PRICING_ENGINE_CONFIG_OFFSET                  (0x00000018)
+#define EMULATION_ORDER_ENTRY_CONFIG_OFFSET                     (0x00000018)
+
+
+#define EMULATION_DATA_MOVER_AP_START                           (1 << 0)
+#define EMULATION_DATA_MOVER_INVALID_BUFFER_ADDRESS             (0xFFFFFFFF)
+
+
+#define EMULATION_FEED_WORD_BYTES                               (8)
+
+#define EMULATION_TCP_SESSION_ID                                (0x0001)
+#define EMULATION_TCP_CONNECTION_STATUS_SUCCESS                 (0x10000 | EMULATION_TCP_SESSION_ID)
+#define EMULATION_TCP_TX_SPACE                                  (0xFFFF)
+
+
+static_assert(sizeof(ap_uint<1024>) == 128, "ring buffer TX element must match OrderBookDataMover READ_ELEMENT_SIZE");
+static_assert(sizeof(ap_uint<256>) == 32, "ring buffer RX element must match OrderBookDataMover WRITE_ELEMENT_SIZE");
+
+
+
+
+void EmulationChannels::Clear(void)
+{
+    feedIn.Clear();
+    bookOperation.Clear();
+    bookResponse.Clear();
+    riskResponse.Clear();
+    bookDataMove.Clear();
+    hostOperation.Clear();
+    pricingOperation.Clear();
+    riskOperation.Clear();
+    entryCredit.Clear();
+    riskCredit.Clear();
+    hostCredit.Clear();
+    execReport.Clear();
+    riskExecReport.Clear();
+}
+
+
+
+
+
+
+EmulatedKernel::EmulatedKernel(EmulationChannels* pChannels)
+{
+    m_pChannels = pChannels;
+    m_numIdleInvocations = IDLE_INVOCATIONS_LIMIT;
+    m_numInvocations = 0;
+}
+
+
+
+
+EmulatedKernel::~EmulatedKernel()
+{
+
+}
+
+
+
+
+
+uint32_t EmulatedKernel::ReadReg32(uint64_t offset, uint32_t* value)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    return m_registerMap.Read(offset, value);
+}
+
+
+
+
+
+uint32_t EmulatedKernel::WriteReg32(uint64_t offset, uint32_t value)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    //a control change may need the kernel to act without any new input (e.g. opening a connection)
+    m_numIdleInvocations = 0;
+
+    return m_registerMap.Write(offset, value);
+}
+
+
+
+
+
+bool EmulatedKernel::Step(void)
+{
+    uint32_t numInvocations = 0;
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    if (IsStarted() == false)
+    {
+        return false;
+    }
+
+
+    if (PullInputs())
+    {
+        m_numIdleInvocations = 0;
+    }
+
+
+    while ((m_numIdleInvocations < IDLE_INVOCATIONS_LIMIT) && (numInvocations < MAX_INVOCATIONS_PER_STEP))
+    {
+        Invoke();
+        numInvocations++;
+
+        if (PushOutputs() || InputsPending())
+        {
+            m_numIdleInvocations = 0;
+        }
+        else
+        {
+            m_numIdleInvocations++;
+        }
+    }
+
+    m_numInvocations += numInvocations;
+
+    return (numInvocations > 0);
+}
+
+
+
+
+
+uint64_t EmulatedKernel::GetNumInvocations(void)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    return m_numInvocations;
+}
+
+
+
+
+
+bool EmulatedKernel::IsStarted(void)
+{
+    //free-running (ap_ctrl_none) kernels start as soon as the bitstream is loaded
+    return true;
+}
+
+
+
+
+
+
+
+
+
+
+FeedHandlerKernel::FeedHandlerKernel(EmulationChannels* pChannels) : EmulatedKernel(pChannels)
+{
+    memset((void*)&m_regControl, 0, sizeof(m_regControl));
+    memset((void*)&m_regStatus, 0, sizeof(m_regStatus));
+    memset((void*)&m_regSymbolMap, 0, sizeof(m_regSymbolMap));
+    memset((void*)&m_regLatencyStatus, 0, sizeof(m_regLatencyStatus));
+    memset((void*)&m_regIngressLatencyStatus, 0, sizeof(m_regIngressLatencyStatus));
+    m_regCapture = 0;
+
+    m_registerMap.Bind(XLNX_FEED_HANDLER_RESET_CONTROL_OFFSET,                      &m_regControl.control,              true);
+    m_registerMap.Bind(XLNX_FEED_HANDLER_CAPTURE_FREEZE_OFFSET,                     &m_regControl.capture,              true);
+    m_registerMap.Bind(XLNX_FEED_HANDLER_LATENCY_CONTROL_OFFSET,                    &m_regControl.latency,              true);
+
+    m_registerMap.Bind(XLNX_FEED_HANDLER_STATS_PROCESSED_WORDS_COUNT_OFFSET,        &m_regStatus.processWord,           false);
+    m_registerMap.Bind(XLNX_FEED_HANDLER_STATS_PROCESSED_PACKETS_COUNT_OFFSET,      &m_regStatus.processPacket,         false);
+    m_registerMap.Bind(XLNX_FEED_HANDLER_STATS_PROCESSED_BINARY_MSG_COUNT_OFFSET,   &m_regStatus.processBinary,         false);
+    m_registerMap.Bind(XLNX_FEED_HANDLER_STATS_PROCESSED_FIX_MSG_COUNT_OFFSET,      &m_regStatus.processFix,            false);
+    m_registerMap.Bind(XLNX_FEED_HANDLER_STATS_TX_OPERATION_COUNT_OFFSET,           &m_regStatus.txOperation,           false);
+    m_registerMap.Bind(XLNX_FEED_HANDLER_STATS_CLOCK_TICK_COUNT_OFFSET,             &m_regStatus.rxEvent,               false);
+
+    m_registerMap.BindArray(XLNX_FEED_HANDLER_SYMBOL_MAP_START_OFFSET, m_regSymbolMap.symbols, NUM_SYMBOL, XLNX_FEED_HANDLER_SYMBOL_INDEX_MULTIPLIER, true);
+
+    m_registerMap.BindWide(XLNX_FEED_HANDLER_CAPTURE_DATA_REGISTER, &m_regCapture);
+
+    m_registerMap.Bind(XLNX_FEED_HANDLER_STATS_LATENCY_COUNT_OFFSET,                &m_regLatencyStatus.count,          false);
+    m_registerMap.Bind(XLNX_FEED_HANDLER_STATS_LATENCY_MIN_OFFSET,                  &m_regLatencyStatus.min,            false);
+    m_registerMap.Bind(XLNX_FEED_HANDLER_STATS_LATENCY_MAX_OFFSET,                  &m_regLatencyStatus.max,            false);
+    m_registerMap.Bind(XLNX_FEED_HANDLER_STATS_LATENCY_BIN_OFFSET,                  &m_regLatencyStatus.bin,            false);
+    m_registerMap.Bind(XLNX_FEED_HANDLER_STATS_LATENCY_SUM_LOWER_OFFSET,            &m_regLatencyStatus.sumLower,       false);
+    m_registerMap.Bind(XLNX_FEED_HANDLER_STATS_LATENCY_SUM_UPPER_OFFSET,            &m_regLatencyStatus.sumUpper,       false);
+    m_registerMap.Bind(XLNX_FEED_HANDLER_STATS_INGRESS_LATENCY_COUNT_OFFSET,        &m_regIngressLatencyStatus.count,   false);
+    m_registerMap.Bind(XLNX_FEED_HANDLER_STATS_INGRESS_LATENCY_MIN_OFFSET,          &m_regIngressLatencyStatus.min,     false);
+    m_registerMap.Bind(XLNX_FEED_HANDLER_STATS_INGRESS_LATENCY_MAX_OFFSET,          &m_regIngressLatencyStatus.max,     false);
+    m_registerMap.Bind(XLNX_FEED_HANDLER_STATS_INGRESS_LATENCY_BIN_OFFSET,          &m_regIngressLatencyStatus.bin,     false);
+    m_registerMap.Bind(XLNX_FEED_HANDLER_STATS_INGRESS_LATENCY_SUM_LOWER_OFFSET,    &m_regIngressLatencyStatus.sumLower, false);
+    m_registerMap.Bind(XLNX_FEED_HANDLER_STATS_INGRESS_LATENCY_SUM_UPPER_OFFSET,    &m_regIngressLatencyStatus.sumUpper, false);
+}
+
+
+
+
+
+bool FeedHandlerKernel::InjectPayload(const uint8_t* pPayload, uint32_t payloadLength, uint64_t ingressTimestamp)
+{
+    hls::stream<axiWordTimestampExt_t> packetStream;
+    axiWordTimestampExt_t word;
+    uint32_t offset;
+    uint32_t i;
+
+    if (m_pChannels->feedIn.IsAboveWatermark())
+    {
+        return false;
+    }
+
+
+    //byte 0 of the payload sits in the least significant byte of each word, the same as the
+    //LineHandler output (and the byte reversed words in the FeedHandler testbench)
+    for (offset = 0; offset < payloadLength; offset += EMULATION_FEED_WORD_BYTES)
+    {
+        word.data = 0;
+        word.keep = 0;
+
+        for (i = 0; (i < EMULATION_FEED_WORD_BYTES) && ((offset + i) < payloadLength); i++)
+        {
+            word.data.range((8 * i) + 7, 8 * i) = pPayload[offset + i];
+            word.keep[i] = 1;
+        }
+
+        word.strb = word.keep;
+        word.user = ingressTimestamp;
+        word.last = ((offset + EMULATION_FEED_WORD_BYTES) >= payloadLength);
+
+        packetStream.write(word);
+    }
+
+    m_pChannels->feedIn.Put(packetStream);
+
+    return true;
+}
+
+
+
+
+
+bool FeedHandlerKernel::PullInputs(void)
+{
+    uint32_t numItems = 0;
+
+    if (m_pChannels->bookOperation.IsAboveWatermark() == false)
+    {
+        numItems += m_pChannels->feedIn.Get(m_inputDataStream, MAX_ITEMS_PER_PULL);
+    }
+
+    return (numItems > 0);
+}
+
+
+
+
+
+bool FeedHandlerKernel::InputsPending(void)
+{
+    return (m_inputDataStream.empty() == false);
+}
+
+
+
+
+
+void FeedHandlerKernel::Invoke(void)
+{
+    feedHandlerTop(m_regControl,
+                   m_regStatus,
+                   m_regSymbolMap,
+                   m_regCapture,
+                   m_inputDataStream,
+                   m_operationStream,
+                   m_eventStream,
+                   m_regLatencyStatus,
+                   m_regIngressLatencyStatus);
+}
+
+
+
+
+
+bool FeedHandlerKernel::PushOutputs(void)
+{
+    uint32_t numItems = 0;
+
+    numItems += m_pChannels->bookOperation.Put(m_operationStream);
+
+    return (numItems > 0);
+}
+
+
+
+
+
+
+
+
+
+
+OrderBookKernel::OrderBookKernel(EmulationChannels* pChannels) : EmulatedKernel(pChannels)
+{
+    memset((void*)&m_regControl, 0, sizeof(m_regControl));
+    memset((void*)&m_regStatus, 0, sizeof(m_regStatus));
+    memset((void*)&m_regLatencyStatus, 0, sizeof(m_regLatencyStatus));
+    memset((void*)&m_regIngressLatencyStatus, 0, sizeof(m_regIngressLatencyStatus));
+    m_regCapture = 0;
+
+    m_registerMap.Bind(XLNX_ORDER_BOOK_RESET_CONTROL_OFFSET,                    &m_regControl.control,              true);
+    m_registerMap.Bind(XLNX_ORDER_BOOK_SIZE_CONTROL_OFFSET,                     &m_regControl.config,               true);
+    m_registerMap.Bind(XLNX_ORDER_BOOK_CAPTURE_CONTROL_OFFSET,                  &m_regControl.capture,              true);
+    m_registerMap.Bind(XLNX_ORDER_BOOK_LATENCY_CONTROL_OFFSET,                  &m_regControl.latency,              true);
+
+    m_registerMap.Bind(XLNX_ORDER_BOOK_STATUS_FLAGS_OFFSET,                     &m_regStatus.status,                false);
+    m_registerMap.Bind(XLNX_ORDER_BOOK_STATS_RX_OPERATIONS_COUNT_OFFSET,        &m_regStatus.rxOperation,           false);
+    m_registerMap.Bind(XLNX_ORDER_BOOK_STATS_PROCESS_OPERATIONS_COUNT_OFFSET,   &m_regStatus.processOperation,      false);
+    m_registerMap.Bind(XLNX_ORDER_BOOK_STATS_INVALID_OPERATIONS_COUNT_OFFSET,   &m_regStatus.invalidOperation,      false);
+    m_registerMap.Bind(XLNX_ORDER_BOOK_RESPONSES_GENERATED_COUNT_OFFSET,        &m_regStatus.generateResponse,      false);
+    m_registerMap.Bind(XLNX_ORDER_BOOK_RESPONSE_SENT_COUNT_OFFSET,              &m_regStatus.txResponse,            false);
+    m_registerMap.Bind(XLNX_ORDER_BOOK_ADD_OPERATIONS_COUNT_OFFSET,             &m_regStatus.addOperation,          false);
+    m_registerMap.Bind(XLNX_ORDER_BOOK_MODIFY_OPERATIONS_COUNT_OFFSET,          &m_regStatus.modifyOperation,       false);
+    m_registerMap.Bind(XLNX_ORDER_BOOK_DELETE_OPERATIONS_COUNT_OFFSET,          &m_regStatus.deleteOperation,       false);
+    m_registerMap.Bind(XLNX_ORDER_BOOK_TRANSACT_OPERATIONS_COUNT_OFFSET,        &m_regStatus.transactOperation,     false);
+    m_registerMap.Bind(XLNX_ORDER_BOOK_HALT_OPERATIONS_COUNT_OFFSET,            &m_regStatus.haltOperation,         false);
+    m_registerMap.Bind(XLNX_ORDER_BOOK_TIMESTAMP_ERRORS_COUNT_OFFSET,           &m_regStatus.timestampError,        false);
+    m_registerMap.Bind(XLNX_ORDER_BOOK_UNHANDLED_OP_CODES_COUNT_OFFSET,         &m_regStatus.operationError,        false);
+    m_registerMap.Bind(XLNX_ORDER_BOOK_SYMBOL_ERRORS_COUNT_OFFSET,              &m_regStatus.symbolError,           false);
+    m_registerMap.Bind(XLNX_ORDER_BOOK_DIRECTION_ERRORS_COUNT_OFFSET,           &m_regStatus.directionError,        false);
+    m_registerMap.Bind(XLNX_ORDER_BOOK_LEVEL_ERRORS_COUNT_OFFSET,               &m_regStatus.levelError,            false);
+    m_registerMap.Bind(XLNX_ORDER_BOOK_CLOCK_TICK_GEN_EVENTS_COUNT_OFFSET,      &m_regStatus.rxEvent,               false);
+
+    m_registerMap.BindWide(XLNX_ORDER_BOOK_DATA_OFFSET, &m_regCapture);
+
+    m_registerMap.Bind(XLNX_ORDER_BOOK_STATS_LATENCY_COUNT_OFFSET,              &m_regLatencyStatus.count,          false);
+    m_registerMap.Bind(XLNX_ORDER_BOOK_STATS_LATENCY_MIN_OFFSET,                &m_regLatencyStatus.min,            false);
+    m_registerMap.Bind(XLNX_ORDER_BOOK_STATS_LATENCY_MAX_OFFSET,                &m_regLatencyStatus.max,            false);
+    m_registerMap.Bind(XLNX_ORDER_BOOK_STATS_LATENCY_BIN_OFFSET,                &m_regLatencyStatus.bin,            false);
+    m_registerMap.Bind(XLNX_ORDER_BOOK_STATS_LATENCY_SUM_LOWER_OFFSET,          &m_regLatencyStatus.sumLower,       false);
+    m_registerMap.Bind(XLNX_ORDER_BOOK_STATS_LATENCY_SUM_UPPER_OFFSET,          &m_regLatencyStatus.sumUpper,       false);
+    m_registerMap.Bind(XLNX_ORDER_BOOK_STATS_INGRESS_LATENCY_COUNT_OFFSET,      &m_regIngressLatencyStatus.count,   false);
+    m_registerMap.Bind(XLNX_ORDER_BOOK_STATS_INGRESS_LATENCY_MIN_OFFSET,        &m_regIngressLatencyStatus.min,     false);
+    m_registerMap.Bind(XLNX_ORDER_BOOK_STATS_INGRESS_LATENCY_MAX_OFFSET,        &m_regIngressLatencyStatus.max,     false);
+    m_registerMap.Bind(XLNX_ORDER_BOOK_STATS_INGRESS_LATENCY_BIN_OFFSET,        &m_regIngressLatencyStatus.bin,     false);
+    m_registerMap.Bind(XLNX_ORDER_BOOK_STATS_INGRESS_LATENCY_SUM_LOWER_OFFSET,  &m_regIngressLatencyStatus.sumLower, false);
+    m_registerMap.Bind(XLNX_ORDER_BOOK_STATS_INGRESS_LATENCY_SUM_UPPER_OFFSET,  &m_regIngressLatencyStatus.sumUpper, false);
+}
+
+
+
+
+
+bool OrderBookKernel::PullInputs(void)
+{
+    uint32_t numItems = 0;
+
+    if ((m_pChannels->bookResponse.IsAboveWatermark() == false) &&
+        (m_pChannels->bookDataMove.IsAboveWatermark() == false))
+    {
+        numItems += m_pChannels->bookOperation.Get(m_operationStream, MAX_ITEMS_PER_PULL);
+    }
+
+    return (numItems > 0);
+}
+
+
+
+
+
+bool OrderBookKernel::InputsPending(void)
+{
+    return (m_operationStream.empty() == false);
+}
+
+
+
+
+
+void OrderBookKernel::Invoke(void)
+{
+    orderBookTop(m_regControl,
+                 m_regStatus,
+                 m_regCapture,
+                 m_operationStream,
+                 m_responseStream,
+                 m_dataMoveStream,
+                 m_eventStream,
+                 m_regLatencyStatus,
+                 m_regIngressLatencyStatus);
+}
+
+
+
+
+
+bool OrderBookKernel::PushOutputs(void)
+{
+    uint32_t numItems = 0;
+
+    numItems += m_pChannels->bookResponse.Put(m_responseStream);
+    numItems += m_pChannels->bookDataMove.Put(m_dataMoveStream);
+
+    return (numItems > 0);
+}
+
+
+
+
+
+
+
+
+
+
+OrderBookDataMoverKernel::OrderBookDataMoverKernel(EmulationChannels* pChannels) : EmulatedKernel(pChannels)
+{
+    memset((void*)&m_regControl, 0, sizeof(m_regControl));
+    memset((void*)&m_regStatus, 0, sizeof(m_regStatus));
+
+    m_registerMap.Bind(XLNX_ORDER_BOOK_DATA_MOVER_CTRL_OFFSET,                          &m_regControl.control,          true);
+    m_registerMap.Bind(XLNX_ORDER_BOOK_DATA_MOVER_RING_READ_BUFFER_HEAD_INDEX_OFFSET,   &m_regControl.indexTxHead,      true);
+    m_registerMap.Bind(XLNX_ORDER_BOOK_DATA_MOVER_RING_WRITE_BUFFER_TAIL_INDEX_OFFSET,  &m_regControl.indexRxTail,      true);
+    m_registerMap.Bind(XLNX_ORDER_BOOK_DATA_MOVER_CREDIT_LIMIT_OFFSET,                  &m_regControl.rxCreditLimit,    true);
+
+    m_registerMap.Bind(XLNX_ORDER_BOOK_DATA_MOVER_STATUS_OFFSET,                        &m_regStatus.status,            false);
+    m_registerMap.Bind(XLNX_ORDER_BOOK_DATA_MOVER_RING_READ_BUFFER_TAIL_INDEX_OFFSET,   &m_regStatus.indexTxTail,       false);
+    m_registerMap.Bind(XLNX_ORDER_BOOK_DATA_MOVER_TX_RESPONSE_INDEX_OFFSET,             &m_regStatus.txResponse,        false);
+    m_registerMap.Bind(XLNX_ORDER_BOOK_DATA_MOVER_RING_WRITE_BUFFER_HEAD_INDEX_OFFSET,  &m_regStatus.indexRxHead,       false);
+    m_registerMap.Bind(XLNX_ORDER_BOOK_DATA_MOVER_NUM_RX_OP_OFFSET,                     &m_regStatus.rxOperation,       false);
+    m_registerMap.Bind(XLNX_ORDER_BOOK_DATA_MOVER_LATENCY_MIN_OFFSET,                   &m_regStatus.latencyMin,        false);
+    m_registerMap.Bind(XLNX_ORDER_BOOK_DATA_MOVER_LATENCY_MAX_OFFSET,                   &m_regStatus.latencyMax,        false);
+    m_registerMap.Bind(XLNX_ORDER_BOOK_DATA_MOVER_LATENCY_SUM_OFFSET,                   &m_regStatus.latencySum,        false);
+    m_registerMap.Bind(XLNX_ORDER_BOOK_DATA_MOVER_LATENCY_CNT_OFFSET,                   &m_regStatus.latencyCount,      false);
+    m_registerMap.Bind(XLNX_ORDER_BOOK_DATA_MOVER_CYCLES_PRE_OFFSET,                    &m_regStatus.cyclesPre,         false);
+    m_registerMap.Bind(XLNX_ORDER_BOOK_DATA_MOVER_CYCLES_POST_OFFSET,                   &m_regStatus.cyclesPost,        false);
+    m_registerMap.Bind(XLNX_ORDER_BOOK_DATA_MOVER_CREDIT_AVAILABLE_OFFSET,              &m_regStatus.rxCreditAvailable, false);
+    m_registerMap.Bind(XLNX_ORDER_BOOK_DATA_MOVER_CREDIT_STALL_OFFSET,                  &m_regStatus.rxCreditStall,     false);
+
+    //NOTE - the kernel control register and the m_axi buffer address registers are left unbound,
+    //       they are plain storage that is read back here when deciding whether the kernel can run
+}
+
+
+
+
+
+uint64_t OrderBookDataMoverKernel::GetBufferAddress(uint64_t lowerWordOffset, uint64_t upperWordOffset)
+{
+    uint32_t lowerWord = 0;
+    uint32_t upperWord = 0;
+
+    m_registerMap.Read(lowerWordOffset, &lowerWord);
+    m_registerMap.Read(upperWordOffset, &upperWord);
+
+    return (((uint64_t)upperWord) << 32) | lowerWord;
+}
+
+
+
+
+
+bool OrderBookDataMoverKernel::IsStarted(void)
+{
+    uint32_t kernelControl = 0;
+    uint64_t readBufferAddress;
+    uint64_t writeBufferAddress;
+
+    m_registerMap.Read(XLNX_ORDER_BOOK_DATA_MOVER_KERNEL_CONTROL_OFFSET, &kernelControl);
+
+    readBufferAddress = GetBufferAddress(XLNX_ORDER_BOOK_DATA_MOVER_READ_BUFFER_ADDRESS_LOWER_WORD_OFFSET,
+                                         XLNX_ORDER_BOOK_DATA_MOVER_READ_BUFFER_ADDRESS_UPPER_WORD_OFFSET);
+
+    writeBufferAddress = GetBufferAddress(XLNX_ORDER_BOOK_DATA_MOVER_WRITE_BUFFER_ADDRESS_LOWER_WORD_OFFSET,
+                                          XLNX_ORDER_BOOK_DATA_MOVER_WRITE_BUFFER_ADDRESS_UPPER_WORD_OFFSET);
+
+    return ((kernelControl & EMULATION_DATA_MOVER_AP_START) &&
+            (readBufferAddress != 0) && (readBufferAddress != EMULATION_DATA_MOVER_INVALID_BUFFER_ADDRESS) &&
+            (writeBufferAddress != 0) && (writeBufferAddress != EMULATION_DATA_MOVER_INVALID_BUFFER_ADDRESS));
+}
+
+
+
+
+
+bool OrderBookDataMoverKernel::PullInputs(void)
+{
+    uint32_t numItems = 0;
+
+    if (m_pChannels->hostOperation.IsAboveWatermark() == false)
+    {
+        numItems += m_pChannels->bookDataMove.Get(m_responseStream, MAX_ITEMS_PER_PULL);
+    }
+
+    numItems += m_pChannels->hostCredit.Get(m_creditStream, MAX_ITEMS_PER_PULL);
+
+    return (numItems > 0);
+}
+
+
+
+
+
+bool OrderBookDataMoverKernel::InputsPending(void)
+{
+    return ((m_responseStream.empty() == false) || (m_creditStream.empty() == false));
+}
+
+
+
+
+
+void OrderBookDataMoverKernel::Invoke(void)
+{
+    ap_uint<1024>* pRingBufferTx;
+    ap_uint<256>* pRingBufferRx;
+
+    //TX ring is the driver's READ buffer (responses to the host), RX ring is its WRITE buffer (operations from the host)
+    pRingBufferTx = (ap_uint<1024>*)GetBufferAddress(XLNX_ORDER_BOOK_DATA_MOVER_READ_BUFFER_ADDRESS_LOWER_WORD_OFFSET,
+                                                     XLNX_ORDER_BOOK_DATA_MOVER_READ_BUFFER_ADDRESS_UPPER_WORD_OFFSET);
+
+    pRingBufferRx = (ap_uint<256>*)GetBufferAddress(XLNX_ORDER_BOOK_DATA_MOVER_WRITE_BUFFER_ADDRESS_LOWER_WORD_OFFSET,
+                                                    XLNX_ORDER_BOOK_DATA_MOVER_WRITE_BUFFER_ADDRESS_UPPER_WORD_OFFSET);
+
+    orderBookDataMoverTop(m_regControl,
+                          m_regStatus,
+                          pRingBufferTx,
+                          pRingBufferRx,
+                          m_responseStream,
+                          m_operationStream,
+                          m_creditStream);
+}
+
+
+
+
+
+bool OrderBookDataMoverKernel::PushOutputs(void)
+{
+    uint32_t numItems = 0;
+
+    numItems += m_pChannels->hostOperation.Put(m_operationStream);
+
+    return (numItems > 0);
+}
+
+
+
+
+
+
+
+
+
+
+RiskEngineKernel::RiskEngineKernel(EmulationChannels* pChannels) : EmulatedKernel(pChannels)
+{
+    memset((void*)&m_regControl, 0, sizeof(m_regControl));
+    memset((void*)&m_regStatus, 0, sizeof(m_regStatus));
+    memset((void*)&m_regLatencyStatus, 0, sizeof(m_regLatencyStatus));
+    memset((void*)&m_regIngressLatencyStatus, 0, sizeof(m_regIngressLatencyStatus));
+    m_regCapture = 0;
+
+    m_registerMap.Bind(XLNX_RISK_ENGINE_RESET_CONTROL_OFFSET,                       &m_regControl.control,              true);
+    m_registerMap.Bind(XLNX_RISK_ENGINE_CHECK_CONFIG_OFFSET,                        &m_regControl.config,               true);
+    m_registerMap.Bind(XLNX_RISK_ENGINE_CAPTURE_CONTROL_OFFSET,                     &m_regControl.capture,              true);
+    m_registerMap.Bind(XLNX_RISK_ENGINE_GLOBAL_POSITION_LIMIT_OFFSET,               &m_regControl.globalPositionLimit,  true);
+    m_registerMap.Bind(XLNX_RISK_ENGINE_GLOBAL_RATE_LIMIT_OFFSET,                   &m_regControl.globalRate,           true);
+    m_registerMap.Bind(XLNX_RISK_ENGINE_LIMIT_SELECT_OFFSET,                        &m_regControl.limitSelect,          true);
+    m_registerMap.Bind(XLNX_RISK_ENGINE_LIMIT_VALUE_OFFSET,                         &m_regControl.limitValue,           true);
+    m_registerMap.Bind(XLNX_RISK_ENGINE_LATENCY_CONTROL_OFFSET,                     &m_regControl.latency,              true);
+
+    m_registerMap.Bind(XLNX_RISK_ENGINE_STATUS_FLAGS_OFFSET,                        &m_regStatus.status,                false);
+    m_registerMap.Bind(XLNX_RISK_ENGINE_STATS_RX_RESPONSE_COUNT_OFFSET,             &m_regStatus.rxResponse,            false);
+    m_registerMap.Bind(XLNX_RISK_ENGINE_STATS_RX_OPERATIONS_COUNT_OFFSET,           &m_regStatus.rxOperation,           false);
+    m_registerMap.Bind(XLNX_RISK_ENGINE_STATS_TX_OPERATIONS_COUNT_OFFSET,           &m_regStatus.txOperation,           false);
+    m_registerMap.Bind(XLNX_RISK_ENGINE_STATS_REJECT_KILL_SWITCH_COUNT_OFFSET,      &m_regStatus.rejectKill,            false);
+    m_registerMap.Bind(XLNX_RISK_ENGINE_STATS_REJECT_QUANTITY_COUNT_OFFSET,         &m_regStatus.rejectQuantity,        false);
+    m_registerMap.Bind(XLNX_RISK_ENGINE_STATS_REJECT_NOTIONAL_COUNT_OFFSET,         &m_regStatus.rejectNotional,        false);
+    m_registerMap.Bind(XLNX_RISK_ENGINE_STATS_REJECT_PRICE_BAND_COUNT_OFFSET,       &m_regStatus.rejectPriceBand,       false);
+    m_registerMap.Bind(XLNX_RISK_ENGINE_STATS_REJECT_POSITION_COUNT_OFFSET,         &m_regStatus.rejectPosition,        false);
+    m_registerMap.Bind(XLNX_RISK_ENGINE_STATS_REJECT_GLOBAL_POSITION_COUNT_OFFSET,  &m_regStatus.rejectGlobalPosition,  false);
+    m_registerMap.Bind(XLNX_RISK_ENGINE_STATS_REJECT_RATE_COUNT_OFFSET,             &m_regStatus.rejectRate,            false);
+    m_registerMap.Bind(XLNX_RISK_ENGINE_STATS_REJECT_GLOBAL_RATE_COUNT_OFFSET,      &m_regStatus.rejectGlobalRate,      false);
+    m_registerMap.Bind(XLNX_RISK_ENGINE_STATS_CLOCK_TICK_EVENTS_COUNT_OFFSET,       &m_regStatus.rxEvent,               false);
+    m_registerMap.Bind(XLNX_RISK_ENGINE_GLOBAL_POSITION_OFFSET,                     &m_regStatus.globalPosition,        false);
+    m_registerMap.Bind(XLNX_RISK_ENGINE_LAST_REJECT_OFFSET,                         &m_regStatus.lastReject,            false);
+    m_registerMap.Bind(XLNX_RISK_ENGINE_STATS_LATENCY_COUNT_OFFSET,                 &m_regLatencyStatus.count,          false);
+    m_registerMap.Bind(XLNX_RISK_ENGINE_STATS_LATENCY_MIN_OFFSET,                   &m_regLatencyStatus.min,            false);
+    m_registerMap.Bind(XLNX_RISK_ENGINE_STATS_LATENCY_MAX_OFFSET,                   &m_regLatencyStatus.max,            false);
+    m_registerMap.Bind(XLNX_RISK_ENGINE_STATS_LATENCY_BIN_OFFSET,                   &m_regLatencyStatus.bin,            false);
+    m_registerMap.Bind(XLNX_RISK_ENGINE_STATS_LATENCY_SUM_LOWER_OFFSET,             &m_regLatencyStatus.sumLower,       false);
+    m_registerMap.Bind(XLNX_RISK_ENGINE_STATS_LATENCY_SUM_UPPER_OFFSET,             &m_regLatencyStatus.sumUpper,       false);
+    m_registerMap.Bind(XLNX_RISK_ENGINE_STATS_INGRESS_LATENCY_COUNT_OFFSET,         &m_regIngressLatencyStatus.count,   false);
+    m_registerMap.Bind(XLNX_RISK_ENGINE_STATS_INGRESS_LATENCY_MIN_OFFSET,           &m_regIngressLatencyStatus.min,     false);
+    m_registerMap.Bind(XLNX_RISK_ENGINE_STATS_INGRESS_LATENCY_MAX_OFFSET,           &m_regIngressLatencyStatus.max,     false);
+    m_registerMap.Bind(XLNX_RISK_ENGINE_STATS_INGRESS_LATENCY_BIN_OFFSET,           &m_regIngressLatencyStatus.bin,     false);
+    m_registerMap.Bind(XLNX_RISK_ENGINE_STATS_INGRESS_LATENCY_SUM_LOWER_OFFSET,     &m_regIngressLatencyStatus.sumLower, false);
+    m_registerMap.Bind(XLNX_RISK_ENGINE_STATS_INGRESS_LATENCY_SUM_UPPER_OFFSET,     &m_regIngressLatencyStatus.sumUpper, false);
+
+    m_registerMap.BindWide(XLNX_RISK_ENGINE_CAPTURE_OFFSET, &m_regCapture);
+}
+
+
+
+
+
+bool RiskEngineKernel::PullInputs(void)
+{
+    uint32_t numItems = 0;
+
+    if (m_pChannels->riskResponse.IsAboveWatermark() == false)
+    {
+        numItems += m_pChannels->bookResponse.Get(m_responseInStream, MAX_ITEMS_PER_PULL);
+    }
+
+    if (m_pChannels->riskOperation.IsAboveWatermark() == false)
+    {
+        numItems += m_pChannels->pricingOperation.Get(m_operationInStream, MAX_ITEMS_PER_PULL);
+    }
+
+    if (m_pChannels->riskExecReport.IsAboveWatermark() == false)
+    {
+        numItems += m_pChannels->execReport.Get(m_execReportInStream, MAX_ITEMS_PER_PULL);
+    }
+
+    numItems += m_pChannels->entryCredit.Get(m_creditInStream, MAX_ITEMS_PER_PULL);
+
+    return (numItems > 0);
+}
+
+
+
+
+
+bool RiskEngineKernel::InputsPending(void)
+{
+    return ((m_responseInStream.empty() == false) ||
+            (m_operationInStream.empty() == false) ||
+            (m_execReportInStream.empty() == false) ||
+            (m_creditInStream.empty() == false));
+}
+
+
+
+
+
+void RiskEngineKernel::Invoke(void)
+{
+    riskEngineTop(m_regControl,
+                  m_regStatus,
+                  m_regCapture,
+                  m_responseInStream,
+                  m_responseOutStream,
+                  m_operationInStream,
+                  m_operationOutStream,
+                  m_eventStream,
+                  m_execReportInStream,
+                  m_execReportOutStream,
+                  m_creditInStream,
+                  m_creditOutStream,
+                  m_regLatencyStatus,
+                  m_regIngressLatencyStatus);
+}
+
+
+
+
+
+bool RiskEngineKernel::PushOutputs(void)
+{
+    uint32_t numItems = 0;
+
+    numItems += m_pChannels->riskResponse.Put(m_responseOutStream);
+    numItems += m_pChannels->riskOperation.Put(m_operationOutStream);
+    numItems += m_pChannels->riskExecReport.Put(m_execReportOutStream);
+    numItems += m_pChannels->riskCredit.Put(m_creditOutStream);
+
+    return (numItems > 0);
+}
+
+
+
+
+
+
+
+
+
+
+PricingEngineKernel::PricingEngineKernel(EmulationChannels* pChannels) : EmulatedKernel(pChannels)
+{
+    uint64_t strategyOffset;
+    uint64_t latencyOffset;
+    latencyRegStatus_t* strategyLatencyStatus[3] = { &m_regPegLatencyStatus, &m_regLimitLatencyStatus, &m_regCustomLatencyStatus };
+    uint32_t i;
+
+    memset((void*)&m_regControl, 0, sizeof(m_regControl));
+    memset((void*)&m_regStatus, 0, sizeof(m_regStatus));
+    memset((void*)&m_regStrategies, 0, sizeof(m_regStrategies));
+    memset((void*)&m_regExecStatus, 0, sizeof(m_regExecStatus));
+    memset((void*)&m_regLatencyStatus, 0, sizeof(m_regLatencyStatus));
+    memset((void*)&m_regIngressLatencyStatus, 0, sizeof(m_regIngressLatencyStatus));
+    memset((void*)&m_regPegLatencyStatus, 0, sizeof(m_regPegLatencyStatus));
+    memset((void*)&m_regLimitLatencyStatus, 0, sizeof(m_regLimitLatencyStatus));
+    memset((void*)&m_regCustomLatencyStatus, 0, sizeof(m_regCustomLatencyStatus));
+    m_regCapture = 0;
+
+    m_registerMap.Bind(XLNX_PRICING_ENGINE_RESET_CONTROL_OFFSET,                    &m_regControl.control,              true);
+    m_registerMap.Bind(EMULATION_PRICING_ENGINE_CONFIG_OFFSET,                      &m_regControl.config,               true);
+    m_registerMap.Bind(XLNX_PRICING_ENGINE_CAPTURE_CONTROL_OFFSET,                  &m_regControl.capture,              true);
+    m_registerMap.Bind(XLNX_PRICING_ENGINE_GLOBAL_STRATEGY_CONTOL_OFFSET,           &m_regControl.strategy,             true);
+    m_registerMap.Bind(XLNX_PRICING_ENGINE_CREDIT_LIMIT_OFFSET,                     &m_regControl.creditLimit,          true);
+    m_registerMap.Bind(XLNX_PRICING_ENGINE_ORDER_LIFETIME_OFFSET,                   &m_regControl.orderLifetime,        true);
+    m_registerMap.Bind(XLNX_PRICING_ENGINE_LATENCY_CONTROL_OFFSET,                  &m_regControl.latency,              true);
+
+    m_registerMap.Bind(XLNX_PRICING_ENGINE_STATUS_FLAGS_OFFSET,                     &m_regStatus.status,                false);
+    m_registerMap.Bind(XLNX_PRICING_ENGINE_STATS_RX_RESPONSE_COUNT_OFFSET,          &m_regStatus.rxResponse,            false);
+    m_registerMap.Bind(XLNX_PRICING_ENGINE_STATS_PROCESSED_RESPONSES_COUNT_OFFSET,  &m_regStatus.processResponse,       false);
+    m_registerMap.Bind(XLNX_PRICING_ENGINE_STATS_TX_OPERATIONS_COUNT_OFFSET,        &m_regStatus.txOperation,           false);
+    m_registerMap.Bind(XLNX_PRICING_ENGINE_STATS_STRATEGY_NONE_COUNT_OFFSET,        &m_regStatus.strategyNone,          false);
+    m_registerMap.Bind(XLNX_PRICING_ENGINE_STATS_STRATEGY_PEG_COUNT_OFFSET,         &m_regStatus.strategyPeg,           false);
+    m_registerMap.Bind(XLNX_PRICING_ENGINE_STATS_STRATEGY_LIMIT_COUNT_OFFSET,       &m_regStatus.strategyLimit,         false);
+    m_registerMap.Bind(XLNX_PRICING_ENGINE_STATS_STRATEGY_UNKNOWN_COUNT_OFFSET,     &m_regStatus.strategyUnknown,       false);
+    m_registerMap.Bind(XLNX_PRICING_ENGINE_STATS_CLOCK_TICK_EVENTS_COUNT_OFFSET,    &m_regStatus.rxEvent,               false);
+    m_registerMap.Bind(XLNX_PRICING_ENGINE_STATS_CREDIT_AVAILABLE_OFFSET,           &m_regStatus.creditAvailable,       false);
+    m_registerMap.Bind(XLNX_PRICING_ENGINE_STATS_CREDIT_STALL_COUNT_OFFSET,         &m_regStatus.creditStall,           false);
+    m_registerMap.Bind(XLNX_PRICING_ENGINE_STATS_STRATEGY_CUSTOM_COUNT_OFFSET,      &m_regStatus.strategyCustom,        false);
+
+    m_registerMap.BindWide(XLNX_PRICING_ENGINE_CAPTURE_OFFSET, &m_regCapture);
+
+    for (i = 0; i < NUM_SYMBOL; i++)
+    {
+        strategyOffset = XLNX_PRICING_ENGINE_SYMBOL_STRATEGY_BASE_OFFSET + ((uint64_t)i * XLNX_PRICING_ENGINE_SYMBOL_STRATEGY_STRIDE);
+
+        m_registerMap.Bind(strategyOffset + XLNX_PRICING_ENGINE_SYMBOL_STRATEGY_SELECT_OFFSET,          &m_regStrategies[i].select,     true);
+        m_registerMap.Bind(strategyOffset + XLNX_PRICING_ENGINE_SYMBOL_STRATEGY_ENABLE_OFFSET,          &m_regStrategies[i].enable,     true);
+        m_registerMap.Bind(strategyOffset + XLNX_PRICING_ENGINE_SYMBOL_STRATEGY_THRESHOLD_OFFSET,       &m_regStrategies[i].totalBid,   true);
+        m_registerMap.Bind(strategyOffset + XLNX_PRICING_ENGINE_SYMBOL_STRATEGY_THRESHOLD_OFFSET + 4,   &m_regStrategies[i].totalAsk,   true);
+    }
+
+    m_registerMap.Bind(XLNX_PRICING_ENGINE_STATS_EXEC_REPORT_COUNT_OFFSET,          &m_regExecStatus.execReport,        false);
+    m_registerMap.Bind(XLNX_PRICING_ENGINE_STATS_EXEC_FILL_COUNT_OFFSET,            &m_regExecStatus.execFill,          false);
+    m_registerMap.Bind(XLNX_PRICING_ENGINE_STATS_EXEC_REJECT_COUNT_OFFSET,          &m_regExecStatus.execReject,        false);
+    m_registerMap.Bind(XLNX_PRICING_ENGINE_STATS_EXEC_UNMATCHED_COUNT_OFFSET,       &m_regExecStatus.execUnmatched,     false);
+
+    m_registerMap.Bind(XLNX_PRICING_ENGINE_STATS_LATENCY_COUNT_OFFSET,              &m_regLatencyStatus.count,          false);
+    m_registerMap.Bind(XLNX_PRICING_ENGINE_STATS_LATENCY_MIN_OFFSET,                &m_regLatencyStatus.min,            false);
+    m_registerMap.Bind(XLNX_PRICING_ENGINE_STATS_LATENCY_MAX_OFFSET,                &m_regLatencyStatus.max,            false);
+    m_registerMap.Bind(XLNX_PRICING_ENGINE_STATS_LATENCY_BIN_OFFSET,                &m_regLatencyStatus.bin,            false);
+    m_registerMap.Bind(XLNX_PRICING_ENGINE_STATS_LATENCY_SUM_LOWER_OFFSET,          &m_regLatencyStatus.sumLower,       false);
+    m_registerMap.Bind(XLNX_PRICING_ENGINE_STATS_LATENCY_SUM_UPPER_OFFSET,          &m_regLatencyStatus.sumUpper,       false);
+    m_registerMap.Bind(XLNX_PRICING_ENGINE_STATS_INGRESS_LATENCY_COUNT_OFFSET,      &m_regIngressLatencyStatus.count,   false);
+    m_registerMap.Bind(XLNX_PRICING_ENGINE_STATS_INGRESS_LATENCY_MIN_OFFSET,        &m_regIngressLatencyStatus.min,     false);
+    m_registerMap.Bind(XLNX_PRICING_ENGINE_STATS_INGRESS_LATENCY_MAX_OFFSET,        &m_regIngressLatencyStatus.max,     false);
+    m_registerMap.Bind(XLNX_PRICING_ENGINE_STATS_INGRESS_LATENCY_BIN_OFFSET,        &m_regIngressLatencyStatus.bin,     false);
+    m_registerMap.Bind(XLNX_PRICING_ENGINE_STATS_INGRESS_LATENCY_SUM_LOWER_OFFSET,  &m_regIngressLatencyStatus.sumLower, false);
+    m_registerMap.Bind(XLNX_PRICING_ENGINE_STATS_INGRESS_LATENCY_SUM_UPPER_OFFSET,  &m_regIngressLatencyStatus.sumUpper, false);
+
+    //per strategy split of the egress probe, one block each for PEG, LIMIT and CUSTOM
+    for (i = 0; i < 3; i++)
+    {
+        latencyOffset = XLNX_PRICING_ENGINE_STATS_STRATEGY_LATENCY_BASE_OFFSET + ((uint64_t)i * XLNX_PRICING_ENGINE_STATS_STRATEGY_LATENCY_STRIDE);
+
+        m_registerMap.Bind(latencyOffset + XLNX_PRICING_ENGINE_STATS_STRATEGY_LATENCY_COUNT_OFFSET,     &strategyLatencyStatus[i]->count,       false);
+        m_registerMap.Bind(latencyOffset + XLNX_PRICING_ENGINE_STATS_STRATEGY_LATENCY_MIN_OFFSET,       &strategyLatencyStatus[i]->min,         false);
+        m_registerMap.Bind(latencyOffset + XLNX_PRICING_ENGINE_STATS_STRATEGY_LATENCY_MAX_OFFSET,       &strategyLatencyStatus[i]->max,         false);
+        m_registerMap.Bind(latencyOffset + XLNX_PRICING_ENGINE_STATS_STRATEGY_LATENCY_BIN_OFFSET,       &strategyLatencyStatus[i]->bin,         false);
+        m_registerMap.Bind(latencyOffset + XLNX_PRICING_ENGINE_STATS_STRATEGY_LATENCY_SUM_LOWER_OFFSET, &strategyLatencyStatus[i]->sumLower,    false);
+        m_registerMap.Bind(latencyOffset + XLNX_PRICING_ENGINE_STATS_STRATEGY_LATENCY_SUM_UPPER_OFFSET, &strategyLatencyStatus[i]->sumUpper,    false);
+    }
+}
+
+
+
+
+
+bool PricingEngineKernel::PullInputs(void)
+{
+    uint32_t numItems = 0;
+
+    if (m_pChannels->pricingOperation.IsAboveWatermark() == false)
+    {
+        numItems += m_pChannels->riskResponse.Get(m_responseStream, MAX_ITEMS_PER_PULL);
+    }
+
+    numItems += m_pChannels->riskCredit.Get(m_creditStream, MAX_ITEMS_PER_PULL);
+    numItems += m_pChannels->riskExecReport.Get(m_execReportStream, MAX_ITEMS_PER_PULL);
+
+    return (numItems > 0);
+}
+
+
+
+
+
+bool PricingEngineKernel::InputsPending(void)
+{
+    return ((m_responseStream.empty() == false) ||
+            (m_creditStream.empty() == false) ||
+            (m_execReportStream.empty() == false));
+}
+
+
+
+
+
+void PricingEngineKernel::Invoke(void)
+{
+    pricingEngineTop(m_regControl,
+                     m_regStatus,
+                     m_regCapture,
+                     m_regStrategies,
+                     m_responseStream,
+                     m_operationStream,
+                     m_eventStream,
+                     m_creditStream,
+                     m_timerArmStream,
+                     m_regExecStatus,
+                     m_execReportStream,
+                     m_regLatencyStatus,
+                     m_regIngressLatencyStatus,
+                     m_regPegLatencyStatus,
+                     m_regLimitLatencyStatus,
+                     m_regCustomLatencyStatus);
+}
+
+
+
+
+
+bool PricingEngineKernel::PushOutputs(void)
+{
+    uint32_t numItems = 0;
+
+    numItems += m_pChannels->pricingOperation.Put(m_operationStream);
+
+    //the clock tick generator is not emulated, so order lifetime timers are never armed
+    while (m_timerArmStream.empty() == false)
+    {
+        m_timerArmStream.read();
+    }
+
+    return (numItems > 0);
+}
+
+
+
+
+
+
+
+
+
+
+OrderEntryKernel::OrderEntryKernel(EmulationChannels* pChannels) : EmulatedKernel(pChannels)
+{
+    memset((void*)&m_regControl, 0, sizeof(m_regControl));
+    memset((void*)&m_regStatus, 0, sizeof(m_regStatus));
+    memset((void*)&m_regLatencyStatus, 0, sizeof(m_regLatencyStatus));
+    memset((void*)&m_regIngressLatencyStatus, 0, sizeof(m_regIngressLatencyStatus));
+    m_regCapture = 0;
+
+    m_numTxMessages = 0;
+    m_numTxBytes = 0;
+    m_numConnections = 0;
+
+    m_registerMap.Bind(XLNX_ORDER_ENTRY_CONTROL_OFFSET,                             &m_regControl.control,              true);
+    m_registerMap.Bind(EMULATION_ORDER_ENTRY_CONFIG_OFFSET,                         &m_regControl.config,               true);
+    m_registerMap.Bind(XLNX_ORDER_ENTRY_CAPTURE_CONTROL_OFFSET,                     &m_regControl.capture,              true);
+    m_registerMap.Bind(XLNX_ORDER_ENTRY_DESTINATION_IP_ADDRESS_OFFSET,              &m_regControl.destAddress,          true);
+    m_registerMap.Bind(XLNX_ORDER_ENTRY_DESTINATION_PORT_OFFSET,                    &m_regControl.destPort,             true);
+    m_registerMap.Bind(XLNX_ORDER_ENTRY_LATENCY_CONTROL_OFFSET,                     &m_regControl.latency,              true);
+
+    m_registerMap.Bind(XLNX_ORDER_ENTRY_STATUS_FLAGS_OFFSET,                        &m_regStatus.status,                false);
+    m_registerMap.Bind(XLNX_ORDER_ENTRY_STATS_RX_OPERATIONS_COUNT_OFFSET,           &m_regStatus.rxOperation,           false);
+    m_registerMap.Bind(XLNX_ORDER_ENTRY_STATS_PROCESSED_OPERATIONS_COUNT_OFFSET,    &m_regStatus.processOperation,      false);
+    m_registerMap.Bind(XLNX_ORDER_ENTRY_STATS_TX_DATA_FRAMES_COUNT_OFFSET,          &m_regStatus.txData,                false);
+    m_registerMap.Bind(XLNX_ORDER_ENTRY_STATS_TX_META_FRAMES_COUNT_OFFSET,          &m_regStatus.txMeta,                false);
+    m_registerMap.Bind(XLNX_ORDER_ENTRY_STATS_TX_MESSAGES_COUNT_OFFSET,             &m_regStatus.txOrder,               false);
+    m_registerMap.Bind(XLNX_ORDER_ENTRY_STATS_RX_DATA_FRAMES_COUNT_OFFSET,          &m_regStatus.rxData,                false);
+    m_registerMap.Bind(XLNX_ORDER_ENTRY_STATS_RX_META_FRAMES_COUNT_OFFSET,          &m_regStatus.rxMeta,                false);
+    m_registerMap.Bind(XLNX_ORDER_ENTRY_STATS_CLOCK_TICK_EVENTS_COUNT_OFFSET,       &m_regStatus.rxEvent,               false);
+    m_registerMap.Bind(XLNX_ORDER_ENTRY_STATS_TX_DROPPED_MSG_COUNT_OFFSET,          &m_regStatus.txDrop,                false);
+    m_registerMap.Bind(XLNX_ORDER_ENTRY_TX_STATUS_OFFSET,                           &m_regStatus.txStatus,              false);
+    m_registerMap.Bind(XLNX_ORDER_ENTRY_STATS_NOTIFICATIONS_RECEIVED_COUNT_OFFSET,  &m_regStatus.notification,          false);
+    m_registerMap.Bind(XLNX_ORDER_ENTRY_STATS_READ_REQUESTS_SENT_COUNT_OFFSET,      &m_regStatus.readRequest,           false);
+    m_registerMap.Bind(XLNX_ORDER_ENTRY_STATS_RX_EXEC_REPORTS_COUNT_OFFSET,         &m_regStatus.rxExecReport,          false);
+    m_registerMap.Bind(XLNX_ORDER_ENTRY_STATS_RX_EXEC_REJECTS_COUNT_OFFSET,         &m_regStatus.rxExecReject,          false);
+
+    m_registerMap.BindWide(XLNX_ORDER_ENTRY_CAPTURE_OFFSET, &m_regCapture);
+
+    m_registerMap.Bind(XLNX_ORDER_ENTRY_STATS_LATENCY_COUNT_OFFSET,                 &m_regLatencyStatus.count,          false);
+    m_registerMap.Bind(XLNX_ORDER_ENTRY_STATS_LATENCY_MIN_OFFSET,                   &m_regLatencyStatus.min,            false);
+    m_registerMap.Bind(XLNX_ORDER_ENTRY_STATS_LATENCY_MAX_OFFSET,                   &m_regLatencyStatus.max,            false);
+    m_registerMap.Bind(XLNX_ORDER_ENTRY_STATS_LATENCY_BIN_OFFSET,                   &m_regLatencyStatus.bin,            false);
+    m_registerMap.Bind(XLNX_ORDER_ENTRY_STATS_LATENCY_SUM_LOWER_OFFSET,             &m_regLatencyStatus.sumLower,       false);
+    m_registerMap.Bind(XLNX_ORDER_ENTRY_STATS_LATENCY_SUM_UPPER_OFFSET,             &m_regLatencyStatus.sumUpper,       false);
+    m_registerMap.Bind(XLNX_ORDER_ENTRY_STATS_INGRESS_LATENCY_COUNT_OFFSET,         &m_regIngressLatencyStatus.count,   false);
+    m_registerMap.Bind(XLNX_ORDER_ENTRY_STATS_INGRESS_LATENCY_MIN_OFFSET,           &m_regIngressLatencyStatus.min,     false);
+    m_registerMap.Bind(XLNX_ORDER_ENTRY_STATS_INGRESS_LATENCY_MAX_OFFSET,           &m_regIngressLatencyStatus.max,     false);
+    m_registerMap.Bind(XLNX_ORDER_ENTRY_STATS_INGRESS_LATENCY_BIN_OFFSET,           &m_regIngressLatencyStatus.bin,     false);
+    m_registerMap.Bind(XLNX_ORDER_ENTRY_STATS_INGRESS_LATENCY_SUM_LOWER_OFFSET,     &m_regIngressLatencyStatus.sumLower, false);
+    m_registerMap.Bind(XLNX_ORDER_ENTRY_STATS_INGRESS_LATENCY_SUM_UPPER_OFFSET,     &m_regIngressLatencyStatus.sumUpper, false);
+}
+
+
+
+
+
+void OrderEntryKernel::GetTxStats(uint64_t* pNumMessages, uint64_t* pNumBytes, uint32_t* pNumConnections)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    *pNumMessages = m_numTxMessages;
+    *pNumBytes = m_numTxBytes;
+    *pNumConnections = m_numConnections;
+}
+
+
+
+
+
+bool OrderEntryKernel::PullInputs(void)
+{
+    uint32_t numItems = 0;
+
+    numItems += m_pChannels->riskOperation.Get(m_operationStream, MAX_ITEMS_PER_PULL);
+    numItems += m_pChannels->hostOperation.Get(m_operationHostStream, MAX_ITEMS_PER_PULL);
+
+    return (numItems > 0);
+}
+
+
+
+
+
+bool OrderEntryKernel::InputsPending(void)
+{
+    return ((m_operationStream.empty() == false) || (m_operationHostStream.empty() == false));
+}
+
+
+
+
+
+void OrderEntryKernel::Invoke(void)
+{
+    orderEntryTcpTop(m_regControl,
+                     m_regStatus,
+                     m_regCapture,
+                     m_operationStream,
+                     m_operationHostStream,
+                     m_listenPortStream,
+                     m_listenStatusStream,
+                     m_notificationStream,
+                     m_readRequestStream,
+                     m_rxMetaStream,
+                     m_rxDataStream,
+                     m_openConnectionStream,
+                     m_connectionStatusStream,
+                     m_closeConnectionStream,
+                     m_txMetaStream,
+                     m_txDataStream,
+                     m_txStatusStream,
+                     m_eventStream,
+                     m_creditStream,
+                     m_creditHostStream,
+                     m_execReportStream,
+                     m_regLatencyStatus,
+                     m_regIngressLatencyStatus);
+}
+
+
+
+
+
+bool OrderEntryKernel::PushOutputs(void)
+{
+    uint32_t numItems = 0;
+    bool bStubActive;
+
+    numItems += m_pChannels->entryCredit.Put(m_creditStream);
+    numItems += m_pChannels->hostCredit.Put(m_creditHostStream);
+    numItems += m_pChannels->execReport.Put(m_execReportStream);
+
+    bStubActive = ServiceTCPStub();
+
+    return ((numItems > 0) || bStubActive);
+}
+
+
+
+
+
+bool OrderEntryKernel::ServiceTCPStub(void)
+{
+    bool bActive = false;
+    ipTcpListenStatusPack_t listenStatusPack;
+    ipTcpConnectionStatusPack_t connectionStatusPack;
+    ipTcpTxMetaPack_t txMetaPack;
+    ipTcpTxStatusPack_t txStatusPack;
+    uint32_t messageLength;
+
+    while (m_listenPortStream.empty() == false)
+    {
+        m_listenPortStream.read();
+
+        listenStatusPack.data = 1;
+        listenStatusPack.keep = 0x1;
+        listenStatusPack.last = 1;
+        m_listenStatusStream.write(listenStatusPack);
+
+        bActive = true;
+    }
+
+
+    while (m_openConnectionStream.empty() == false)
+    {
+        m_openConnectionStream.read();
+
+        connectionStatusPack.data = EMULATION_TCP_CONNECTION_STATUS_SUCCESS;
+        connectionStatusPack.keep = 0xF;
+        connectionStatusPack.last = 1;
+        m_connectionStatusStream.write(connectionStatusPack);
+
+        m_numConnections++;
+        bActive = true;
+    }
+
+
+    while (m_closeConnectionStream.empty() == false)
+    {
+        m_closeConnectionStream.read();
+        bActive = true;
+    }
+
+
+    while (m_readRequestStream.empty() == false)
+    {
+        m_readRequestStream.read();
+        bActive = true;
+    }
+
+
+    //every send is acknowledged straight away with the window left fully open
+    while (m_txMetaStream.empty() == false)
+    {
+        txMetaPack = m_txMetaStream.read();
+
+        messageLength = (uint32_t)txMetaPack.data.range(31, 16).to_uint();
+
+        txStatusPack.data = 0;
+        txStatusPack.data.range(15, 0) = txMetaPack.data.range(15, 0);
+        txStatusPack.data.range(31, 16) = messageLength;
+        txStatusPack.data.range(61, 32) = EMULATION_TCP_TX_SPACE;
+        txStatusPack.data.range(63, 62) = TXSTATUS_SUCCESS;
+        txStatusPack.keep = 0xFF;
+        txStatusPack.last = 1;
+        m_txStatusStream.write(txStatusPack);
+
+        m_numTxMessages++;
+        m_numTxBytes += messageLength;
+        bActive = true;
+    }
+
+
+    while (m_txDataStream.empty() == false)
+    {
+        m_txDataStream.read();
+        bActive = true;
+    }
+
+    return bActive;
+}
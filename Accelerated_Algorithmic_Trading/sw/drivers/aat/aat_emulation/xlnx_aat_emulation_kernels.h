@@ -0,0 +1,351 @@
+/*
+ * Copyright 2021 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+
+#ifndef XLNX_AAT_EMULATION_KERNELS_H
+#define XLNX_AAT_EMULATION_KERNELS_H
+
+#include <cstdint>
+#include <mutex>
+
+#include "xlnx_virtual_device_interface.h"
+
+#include "xlnx_aat_emulation_register_map.h"
+#include "xlnx_aat_emulation_channel.h"
+
+#include "feedhandler_kernels.hpp"
+#include "orderbook_kernels.hpp"
+#include "pricingengine_kernels.hpp"
+#include "riskengine_kernels.hpp"
+#include "orderentry_kernels.hpp"
+
+
+namespace XLNX
+{
+
+
+//The AXI-Stream connections between the emulated kernels, named after the producer/consumer pair
+//and wired the same way as the stream_connect (sc=) entries in the AAT linker config
+class EmulationChannels
+{
+public:
+    EmulationChannel<axiWordTimestampExt_t>         feedIn;             //packet source         -> feedHandlerTop
+    EmulationChannel<orderBookOperationPack_t>      bookOperation;      //feedHandlerTop        -> orderBookTop
+    EmulationChannel<orderBookResponsePack_t>       bookResponse;       //orderBookTop          -> riskEngineTop
+    EmulationChannel<orderBookResponsePack_t>       riskResponse;       //riskEngineTop         -> pricingEngineTop
+    EmulationChannel<orderBookResponsePack_t>       bookDataMove;       //orderBookTop          -> orderBookDataMoverTop
+    EmulationChannel<orderEntryOperationPack_t>     hostOperation;      //orderBookDataMoverTop -> orderEntryTcpTop
+    EmulationChannel<orderEntryOperationPack_t>     pricingOperation;   //pricingEngineTop      -> riskEngineTop
+    EmulationChannel<orderEntryOperationPack_t>     riskOperation;      //riskEngineTop         -> orderEntryTcpTop
+    EmulationChannel<orderEntryCredit_t>            entryCredit;        //orderEntryTcpTop      -> riskEngineTop
+    EmulationChannel<orderEntryCredit_t>            riskCredit;         //riskEngineTop         -> pricingEngineTop
+    EmulationChannel<orderEntryCredit_t>            hostCredit;         //orderEntryTcpTop      -> orderBookDataMoverTop
+    EmulationChannel<orderEntryExecReportPack_t>    execReport;         //orderEntryTcpTop      -> riskEngineTop
+    EmulationChannel<orderEntryExecReportPack_t>    riskExecReport;     //riskEngineTop         -> pricingEngineTop
+
+
+    void Clear(void);
+};
+
+
+
+
+
+
+//Base class for a kernel whose HLS top function is run in C-simulation on a host thread.  The kernel owns
+//the register structs that are handed to the top function by reference, and exposes them to the drivers
+//through the virtual device as that CU's register space.
+class EmulatedKernel : public VirtualDeviceCU
+{
+public:
+    EmulatedKernel(EmulationChannels* pChannels);
+    virtual ~EmulatedKernel();
+
+
+public: //VirtualDeviceCU
+    uint32_t ReadReg32(uint64_t offset, uint32_t* value);
+    uint32_t WriteReg32(uint64_t offset, uint32_t value);
+
+
+public:
+    //Runs one scheduling pass (pull inputs, invoke the top function, push outputs).
+    //Returns true if the kernel did any work, false if it is idle.
+    bool Step(void);
+
+    uint64_t GetNumInvocations(void);
+
+
+
+protected:
+    //Moves input items from the channels into the local streams, returns true if anything arrived
+    virtual bool PullInputs(void) = 0;
+
+    //Returns true if the local input streams still hold items the top function has not consumed
+    virtual bool InputsPending(void) = 0;
+
+    virtual void Invoke(void) = 0;
+
+    //Moves output items from the local streams into the channels, returns true if anything was produced
+    virtual bool PushOutputs(void) = 0;
+
+    //Kernels that are started by the host (ap_ctrl_hs) override this to report their run state
+    virtual bool IsStarted(void);
+
+
+protected:
+    //Upper bound on the items pulled from a channel per pass, keeps each pass short so register
+    //accesses from the host are not held off for long
+    static const uint32_t MAX_ITEMS_PER_PULL = 256;
+
+    static const uint32_t MAX_INVOCATIONS_PER_STEP = 64;
+
+    //HLS dataflow stages hold items internally between calls, so the top function keeps being called
+    //for a while after the last input/output to flush them through before the kernel is considered idle
+    static const uint32_t IDLE_INVOCATIONS_LIMIT = 16;
+
+
+    std::mutex m_mutex;
+    EmulatedRegisterMap m_registerMap;
+    EmulationChannels* m_pChannels;
+    uint32_t m_numIdleInvocations;
+    uint64_t m_numInvocations;
+};
+
+
+
+
+
+
+class FeedHandlerKernel : public EmulatedKernel
+{
+public:
+    FeedHandlerKernel(EmulationChannels* pChannels);
+
+    //Splits a UDP payload into the 64-bit AXI-Stream words the kernel expects from the LineHandler.
+    //Returns false without queuing anything if the kernel is not keeping up.
+    bool InjectPayload(const uint8_t* pPayload, uint32_t payloadLength, uint64_t ingressTimestamp);
+
+protected:
+    bool PullInputs(void);
+    bool InputsPending(void);
+    void Invoke(void);
+    bool PushOutputs(void);
+
+protected:
+    feedHandlerRegControl_t m_regControl;
+    feedHandlerRegStatus_t m_regStatus;
+    regSymbolMapContainer_t m_regSymbolMap;
+    ap_uint<256> m_regCapture;
+    latencyRegStatus_t m_regLatencyStatus;
+    latencyRegStatus_t m_regIngressLatencyStatus;
+
+    hls::stream<axiWordTimestampExt_t> m_inputDataStream;
+    hls::stream<orderBookOperationPack_t> m_operationStream;
+    hls::stream<clockTickGeneratorEvent_t> m_eventStream;
+};
+
+
+
+
+
+
+class OrderBookKernel : public EmulatedKernel
+{
+public:
+    OrderBookKernel(EmulationChannels* pChannels);
+
+protected:
+    bool PullInputs(void);
+    bool InputsPending(void);
+    void Invoke(void);
+    bool PushOutputs(void);
+
+protected:
+    orderBookRegControl_t m_regControl;
+    orderBookRegStatus_t m_regStatus;
+    ap_uint<1024> m_regCapture;
+    latencyRegStatus_t m_regLatencyStatus;
+    latencyRegStatus_t m_regIngressLatencyStatus;
+
+    hls::stream<orderBookOperationPack_t> m_operationStream;
+    hls::stream<orderBookResponsePack_t> m_responseStream;
+    hls::stream<orderBookResponsePack_t> m_dataMoveStream;
+    hls::stream<clockTickGeneratorEvent_t> m_eventStream;
+};
+
+
+
+
+
+
+//The data mover reads/writes its host rings directly through the addresses programmed into its
+//m_axi offset registers.  On the virtual device a buffer's device address is its host address, so
+//the rings the driver polls are filled exactly as they would be over PCIe.
+class OrderBookDataMoverKernel : public EmulatedKernel
+{
+public:
+    OrderBookDataMoverKernel(EmulationChannels* pChannels);
+
+protected:
+    bool PullInputs(void);
+    bool InputsPending(void);
+    void Invoke(void);
+    bool PushOutputs(void);
+    bool IsStarted(void);
+
+    uint64_t GetBufferAddress(uint64_t lowerWordOffset, uint64_t upperWordOffset);
+
+protected:
+    orderBookDataMoverRegControl_t m_regControl;
+    orderBookDataMoverRegStatus_t m_regStatus;
+
+    hls::stream<orderBookResponsePack_t> m_responseStream;
+    hls::stream<orderEntryOperationPack_t> m_operationStream;
+    hls::stream<orderEntryCredit_t> m_creditStream;
+};
+
+
+
+
+
+
+class RiskEngineKernel : public EmulatedKernel
+{
+public:
+    RiskEngineKernel(EmulationChannels* pChannels);
+
+protected:
+    bool PullInputs(void);
+    bool InputsPending(void);
+    void Invoke(void);
+    bool PushOutputs(void);
+
+protected:
+    riskEngineRegControl_t m_regControl;
+    riskEngineRegStatus_t m_regStatus;
+    ap_uint<1024> m_regCapture;
+    latencyRegStatus_t m_regLatencyStatus;
+    latencyRegStatus_t m_regIngressLatencyStatus;
+
+    hls::stream<orderBookResponsePack_t> m_responseInStream;
+    hls::stream<orderBookResponsePack_t> m_responseOutStream;
+    hls::stream<orderEntryOperationPack_t> m_operationInStream;
+    hls::stream<orderEntryOperationPack_t> m_operationOutStream;
+    hls::stream<clockTickGeneratorEvent_t> m_eventStream;
+    hls::stream<orderEntryExecReportPack_t> m_execReportInStream;
+    hls::stream<orderEntryExecReportPack_t> m_execReportOutStream;
+    hls::stream<orderEntryCredit_t> m_creditInStream;
+    hls::stream<orderEntryCredit_t> m_creditOutStream;
+};
+
+
+
+
+
+
+class PricingEngineKernel : public EmulatedKernel
+{
+public:
+    PricingEngineKernel(EmulationChannels* pChannels);
+
+protected:
+    bool PullInputs(void);
+    bool InputsPending(void);
+    void Invoke(void);
+    bool PushOutputs(void);
+
+protected:
+    pricingEngineRegControl_t m_regControl;
+    pricingEngineRegStatus_t m_regStatus;
+    ap_uint<1024> m_regCapture;
+    pricingEngineRegStrategy_t m_regStrategies[NUM_SYMBOL];
+    pricingEngineRegExecStatus_t m_regExecStatus;
+    latencyRegStatus_t m_regLatencyStatus;
+    latencyRegStatus_t m_regIngressLatencyStatus;
+    latencyRegStatus_t m_regPegLatencyStatus;
+    latencyRegStatus_t m_regLimitLatencyStatus;
+    latencyRegStatus_t m_regCustomLatencyStatus;
+
+    hls::stream<orderBookResponsePack_t> m_responseStream;
+    hls::stream<orderEntryOperationPack_t> m_operationStream;
+    hls::stream<clockTickGeneratorEvent_t> m_eventStream;
+    hls::stream<orderEntryCredit_t> m_creditStream;
+    hls::stream<clockTickGeneratorTimerPack_t> m_timerArmStream;
+    hls::stream<orderEntryExecReportPack_t> m_execReportStream;
+};
+
+
+
+
+
+
+//The TCP offload engine is not modelled.  A minimal stub answers the listen/open requests and
+//acknowledges every transmit so that the kernel sees an established session with plenty of window,
+//the order messages themselves are counted and then discarded.
+class OrderEntryKernel : public EmulatedKernel
+{
+public:
+    OrderEntryKernel(EmulationChannels* pChannels);
+
+    void GetTxStats(uint64_t* pNumMessages, uint64_t* pNumBytes, uint32_t* pNumConnections);
+
+protected:
+    bool PullInputs(void);
+    bool InputsPending(void);
+    void Invoke(void);
+    bool PushOutputs(void);
+
+    bool ServiceTCPStub(void);
+
+protected:
+    orderEntryRegControl_t m_regControl;
+    orderEntryRegStatus_t m_regStatus;
+    ap_uint<1024> m_regCapture;
+    latencyRegStatus_t m_regLatencyStatus;
+    latencyRegStatus_t m_regIngressLatencyStatus;
+
+    hls::stream<orderEntryOperationPack_t> m_operationStream;
+    hls::stream<orderEntryOperationPack_t> m_operationHostStream;
+    hls::stream<ipTcpListenPortPack_t> m_listenPortStream;
+    hls::stream<ipTcpListenStatusPack_t> m_listenStatusStream;
+    hls::stream<ipTcpNotificationPack_t> m_notificationStream;
+    hls::stream<ipTcpReadRequestPack_t> m_readRequestStream;
+    hls::stream<ipTcpRxMetaPack_t> m_rxMetaStream;
+    hls::stream<ipTcpRxDataPack_t> m_rxDataStream;
+    hls::stream<ipTuplePack_t> m_openConnectionStream;
+    hls::stream<ipTcpConnectionStatusPack_t> m_connectionStatusStream;
+    hls::stream<ipTcpCloseConnectionPack_t> m_closeConnectionStream;
+    hls::stream<ipTcpTxMetaPack_t> m_txMetaStream;
+    hls::stream<ipTcpTxDataPack_t> m_txDataStream;
+    hls::stream<ipTcpTxStatusPack_t> m_txStatusStream;
+    hls::stream<clockTickGeneratorEvent_t> m_eventStream;
+    hls::stream<orderEntryCredit_t> m_creditStream;
+    hls::stream<orderEntryCredit_t> m_creditHostStream;
+    hls::stream<orderEntryExecReportPack_t> m_execReportStream;
+
+    uint64_t m_numTxMessages;
+    uint64_t m_numTxBytes;
+    uint32_t m_numConnections;
+};
+
+
+
+} //namespace XLNX
+
+
+
+#endif
@@ -0,0 +1,163 @@
+/*
+ * Copyright 2021 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+
+#include "xlnx_aat_emulation_register_map.h"
+#include "xlnx_aat_emulation_error_codes.h"
+
+using namespace XLNX;
+
+
+
+#ifndef XLNX_UNUSED_ARG
+#define XLNX_UNUSED_ARG(x)	((void)x)
+#endif
+
+
+
+
+EmulatedRegisterMap::EmulatedRegisterMap()
+{
+
+}
+
+
+
+
+EmulatedRegisterMap::~EmulatedRegisterMap()
+{
+
+}
+
+
+
+
+
+void EmulatedRegisterMap::Bind(uint64_t offset, ap_uint<32>* pRegister, bool bWritable)
+{
+    Binding binding;
+
+    binding.pRegister = pRegister;
+    binding.wordIndex = 0;
+    binding.readFunc = ReadWord;
+    binding.writeFunc = bWritable ? WriteWord : nullptr;
+
+    m_bindings[offset] = binding;
+}
+
+
+
+
+
+void EmulatedRegisterMap::BindArray(uint64_t offset, ap_uint<32>* pRegisters, uint32_t numRegisters, uint32_t stride, bool bWritable)
+{
+    uint32_t i;
+
+    for (i = 0; i < numRegisters; i++)
+    {
+        Bind(offset + ((uint64_t)i * stride), &pRegisters[i], bWritable);
+    }
+}
+
+
+
+
+
+uint32_t EmulatedRegisterMap::Read(uint64_t offset, uint32_t* value)
+{
+    uint32_t retval = XLNX_OK;
+    std::map<uint64_t, Binding>::iterator it;
+    std::map<uint64_t, uint32_t>::iterator unboundIt;
+
+    if (value == nullptr)
+    {
+        retval = XLNX_AAT_EMULATION_ERROR_INVALID_PARAMETER;
+    }
+
+    if (retval == XLNX_OK)
+    {
+        it = m_bindings.find(offset);
+
+        if (it != m_bindings.end())
+        {
+            *value = it->second.readFunc(it->second.pRegister, it->second.wordIndex);
+        }
+        else
+        {
+            unboundIt = m_unboundRegisters.find(offset);
+
+            if (unboundIt != m_unboundRegisters.end())
+            {
+                *value = unboundIt->second;
+            }
+            else
+            {
+                *value = 0;
+            }
+        }
+    }
+
+    return retval;
+}
+
+
+
+
+
+uint32_t EmulatedRegisterMap::Write(uint64_t offset, uint32_t value)
+{
+    uint32_t retval = XLNX_OK;
+    std::map<uint64_t, Binding>::iterator it;
+
+    it = m_bindings.find(offset);
+
+    if (it != m_bindings.end())
+    {
+        if (it->second.writeFunc != nullptr)
+        {
+            it->second.writeFunc(it->second.pRegister, it->second.wordIndex, value);
+        }
+    }
+    else
+    {
+        m_unboundRegisters[offset] = value;
+    }
+
+    return retval;
+}
+
+
+
+
+
+uint32_t EmulatedRegisterMap::ReadWord(void* pRegister, uint32_t wordIndex)
+{
+    XLNX_UNUSED_ARG(wordIndex);
+
+    return (uint32_t)((ap_uint<32>*)pRegister)->to_uint();
+}
+
+
+
+
+
+void EmulatedRegisterMap::WriteWord(void* pRegister, uint32_t wordIndex, uint32_t value)
+{
+    XLNX_UNUSED_ARG(wordIndex);
+
+    *((ap_uint<32>*)pRegister) = value;
+}
@@ -0,0 +1,113 @@
+/*
+ * Copyright 2021 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+
+#ifndef XLNX_AAT_EMULATION_REGISTER_MAP_H
+#define XLNX_AAT_EMULATION_REGISTER_MAP_H
+
+#include <cstdint>
+#include <map>
+
+#include "ap_int.h"
+
+
+namespace XLNX
+{
+
+
+//Maps AXI-Lite register offsets onto the fields of the register structs that are passed by reference
+//into an HLS kernel top function.  This lets the existing drivers talk to a C-simulation model through
+//exactly the same offsets they use against the real HW.  Offsets with nothing bound behave like plain
+//memory so that block-level control registers (e.g. ap_ctrl) still read back what was written.
+class EmulatedRegisterMap
+{
+public:
+    EmulatedRegisterMap();
+    virtual ~EmulatedRegisterMap();
+
+
+
+public:
+    //A single 32-bit register.  Read-only registers silently discard writes, as the HW does.
+    void Bind(uint64_t offset, ap_uint<32>* pRegister, bool bWritable);
+
+    //A contiguous array of 32-bit registers, "stride" bytes apart
+    void BindArray(uint64_t offset, ap_uint<32>* pRegisters, uint32_t numRegisters, uint32_t stride, bool bWritable);
+
+    //A wide read-only register (e.g. a data capture) exposed as consecutive 32-bit words, LSW first
+    template <int W>
+    void BindWide(uint64_t offset, ap_uint<W>* pRegister)
+    {
+        Binding binding;
+
+        for (uint32_t i = 0; i < (W / 32); i++)
+        {
+            binding.pRegister = pRegister;
+            binding.wordIndex = i;
+            binding.readFunc = ReadWideWord<W>;
+            binding.writeFunc = nullptr;
+
+            m_bindings[offset + (i * 4)] = binding;
+        }
+    }
+
+
+
+public:
+    uint32_t Read(uint64_t offset, uint32_t* value);
+    uint32_t Write(uint64_t offset, uint32_t value);
+
+
+
+protected:
+    typedef uint32_t (*ReadFunc)(void* pRegister, uint32_t wordIndex);
+    typedef void (*WriteFunc)(void* pRegister, uint32_t wordIndex, uint32_t value);
+
+    typedef struct
+    {
+        void* pRegister;
+        uint32_t wordIndex;
+        ReadFunc readFunc;
+        WriteFunc writeFunc;    //nullptr for read-only registers
+
+    }Binding;
+
+
+    static uint32_t ReadWord(void* pRegister, uint32_t wordIndex);
+    static void WriteWord(void* pRegister, uint32_t wordIndex, uint32_t value);
+
+    template <int W>
+    static uint32_t ReadWideWord(void* pRegister, uint32_t wordIndex)
+    {
+        ap_uint<W>* pWide = (ap_uint<W>*)pRegister;
+
+        return (uint32_t)pWide->range((wordIndex * 32) + 31, wordIndex * 32).to_uint();
+    }
+
+
+protected:
+    std::map<uint64_t, Binding> m_bindings;
+    std::map<uint64_t, uint32_t> m_unboundRegisters;
+};
+
+
+
+} //namespace XLNX
+
+
+
+#endif
@@ -301,7 +301,7 @@ uint32_t ClockTickGenerator::CheckStreamIndex(uint32_t streamIndex)
 {
 	uint32_t retval = XLNX_OK;
 
-	if (streamIndex > NUM_SUPPORTED_TICK_STREAMS)
+	if (streamIndex >= NUM_SUPPORTED_TICK_STREAMS)
 	{
 		retval = XLNX_CLOCK_TICK_GENERATOR_ERROR_STREAM_INDEX_OUT_OF_RANGE;
 	}
@@ -312,6 +312,21 @@ uint32_t ClockTickGenerator::CheckStreamIndex(uint32_t streamIndex)
 
 
 
+uint32_t ClockTickGenerator::CheckTimerIndex(uint32_t timerIndex)
+{
+	uint32_t retval = XLNX_OK;
+
+	if (timerIndex >= NUM_TIMERS)
+	{
+		retval = XLNX_CLOCK_TICK_GENERATOR_ERROR_TIMER_INDEX_OUT_OF_RANGE;
+	}
+
+	return retval;
+}
+
+
+
+
 uint32_t ClockTickGenerator::SetTickEnabled(uint32_t streamIndex, bool bEnabled)
 {
 	uint32_t retval = XLNX_OK;
@@ -512,6 +527,151 @@ uint32_t ClockTickGenerator::GetStats(Stats* pStats)
 
 
 
+uint32_t ClockTickGenerator::ArmTimer(uint32_t timerIndex, uint32_t microseconds, uint32_t target, uint32_t symbolIndex, uint32_t eventCode, bool bPeriodic)
+{
+	uint32_t retval = XLNX_OK;
+	uint32_t clockCycles;
+	uint32_t revolutions = 0;
+	uint32_t config;
+
+	retval = CheckIsInitialised();
+
+	if (retval == XLNX_OK)
+	{
+		retval = CheckTimerIndex(timerIndex);
+	}
+
+	if (retval == XLNX_OK)
+	{
+		if (target >= NUM_SUPPORTED_TICK_STREAMS)
+		{
+			retval = XLNX_CLOCK_TICK_GENERATOR_ERROR_TIMER_TARGET_OUT_OF_RANGE;
+		}
+	}
+
+	if (retval == XLNX_OK)
+	{
+		if ((symbolIndex > 0xFF) || (eventCode > 0xFF))
+		{
+			retval = XLNX_CLOCK_TICK_GENERATOR_ERROR_INVALID_PARAMETER;
+		}
+	}
+
+	if (retval == XLNX_OK)
+	{
+		retval = ConvertMicrosecondsToClockCycles(microseconds, &clockCycles);
+	}
+
+	if (retval == XLNX_OK)
+	{
+		//HW fires on the first visit to the timer slot at least N revolutions after the arm and
+		//periodic timers repeat every N+1 revolutions, so the first expiry lands within one
+		//revolution of the requested interval and the period is rounded up to whole revolutions
+		if (clockCycles > NUM_TIMERS)
+		{
+			revolutions = ((clockCycles + NUM_TIMERS - 1) / NUM_TIMERS) - 1;
+		}
+
+		config = (timerIndex << 22) |
+				 (1 << 21) |
+				 ((bPeriodic ? 1 : 0) << 20) |
+				 (target << 16) |
+				 (symbolIndex << 8) |
+				 eventCode;
+
+		retval = WriteTimerRequest(revolutions, config);
+	}
+
+	return retval;
+}
+
+
+
+
+uint32_t ClockTickGenerator::CancelTimer(uint32_t timerIndex)
+{
+	uint32_t retval = XLNX_OK;
+
+	retval = CheckIsInitialised();
+
+	if (retval == XLNX_OK)
+	{
+		retval = CheckTimerIndex(timerIndex);
+	}
+
+	if (retval == XLNX_OK)
+	{
+		retval = WriteTimerRequest(0, (timerIndex << 22));
+	}
+
+	return retval;
+}
+
+
+
+
+uint32_t ClockTickGenerator::WriteTimerRequest(uint32_t interval, uint32_t config)
+{
+	uint32_t retval = XLNX_OK;
+	uint32_t strobeMask = (1u << 31);
+	uint32_t value;
+
+	//HW applies the request when it detects a toggle of the strobe bit,
+	//so the interval must be in place before the config register is written
+
+	retval = ReadReg32(XLNX_CLOCK_TICK_GENERATOR_TIMER_CONFIG_OFFSET, &value);
+
+	if (retval == XLNX_OK)
+	{
+		retval = WriteReg32(XLNX_CLOCK_TICK_GENERATOR_TIMER_INTERVAL_OFFSET, interval);
+	}
+
+	if (retval == XLNX_OK)
+	{
+		config = (config & ~strobeMask) | ((value & strobeMask) ^ strobeMask);
+
+		retval = WriteReg32(XLNX_CLOCK_TICK_GENERATOR_TIMER_CONFIG_OFFSET, config);
+	}
+
+	return retval;
+}
+
+
+
+
+uint32_t ClockTickGenerator::GetTimerStats(TimerStats* pStats)
+{
+	uint32_t retval = XLNX_OK;
+
+	memset(pStats, 0, sizeof(TimerStats));
+
+	retval = CheckIsInitialised();
+
+	if (retval == XLNX_OK)
+	{
+		retval = ReadReg32(XLNX_CLOCK_TICK_GENERATOR_TIMER_ARM_COUNT_OFFSET, &(pStats->numArmed));
+	}
+
+	if (retval == XLNX_OK)
+	{
+		retval = ReadReg32(XLNX_CLOCK_TICK_GENERATOR_TIMER_CANCEL_COUNT_OFFSET, &(pStats->numCancelled));
+	}
+
+	if (retval == XLNX_OK)
+	{
+		retval = ReadReg32(XLNX_CLOCK_TICK_GENERATOR_TIMER_FIRE_COUNT_OFFSET, &(pStats->numFired));
+	}
+
+	if (retval == XLNX_OK)
+	{
+		retval = ReadReg32(XLNX_CLOCK_TICK_GENERATOR_TIMER_DROP_COUNT_OFFSET, &(pStats->numDropped));
+	}
+
+	return retval;
+}
+
+
+
 uint32_t ClockTickGenerator::ConvertMicrosecondsToClockCycles(uint32_t microseconds, uint32_t* pClockCycles)
 {
 	uint32_t retval = XLNX_OK;
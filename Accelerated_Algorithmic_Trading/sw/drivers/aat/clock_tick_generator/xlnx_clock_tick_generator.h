@@ -41,7 +41,7 @@ public:
 
 
 public:
-    static const uint32_t NUM_SUPPORTED_TICK_STREAMS = 4;
+    static const uint32_t NUM_SUPPORTED_TICK_STREAMS = 6;
 
 
 public:
@@ -69,6 +69,34 @@ public:
 
 
 
+public: //Timer Wheel
+
+    //The HW sweeps one timer slot per clock cycle, so timer resolution is NUM_TIMERS clock cycles.
+    //Arming never stalls the sweep, so a timer fires at most NUM_TIMERS clock cycles late whatever
+    //the arm request rate.
+    //Expired timers deliver an event carrying the supplied event code and symbol index on the
+    //tick stream of the target kernel (target index == tick stream index).
+    //Timer slots from PRICING_ENGINE_TIMER_BASE upwards are armed by the pricing engine itself.
+    static const uint32_t NUM_TIMERS = 512;
+    static const uint32_t PRICING_ENGINE_TIMER_BASE = 256;
+
+    uint32_t ArmTimer(uint32_t timerIndex, uint32_t microseconds, uint32_t target, uint32_t symbolIndex, uint32_t eventCode, bool bPeriodic);
+    uint32_t CancelTimer(uint32_t timerIndex);
+
+
+    typedef struct
+    {
+        uint32_t numArmed;
+        uint32_t numCancelled;
+        uint32_t numFired;
+        uint32_t numDropped;    //events addressed to an unknown target
+    }TimerStats;
+
+    uint32_t GetTimerStats(TimerStats* pStats);
+
+
+
+
 public:
     void IsInitialised(bool* pbIsInitialised);
     uint32_t GetCUIndex(uint32_t* pCUIndex);
@@ -79,6 +107,7 @@ public:
 public:
     uint32_t CheckIsInitialised(void);
     uint32_t CheckStreamIndex(uint32_t streamIndex);
+    uint32_t CheckTimerIndex(uint32_t timerIndex);
 
 
 
@@ -96,6 +125,8 @@ protected:
     uint32_t ConvertMicrosecondsToClockCycles(uint32_t microseconds, uint32_t* pClockCycles);
     uint32_t ConvertClockCyclesToMicroseconds(uint32_t clockCycles, uint32_t* pMicroseconds);
 
+    uint32_t WriteTimerRequest(uint32_t interval, uint32_t config);
+
 
 protected:
     uint32_t m_initialisedMagicNumber;
@@ -41,7 +41,15 @@
 #define XLNX_CLOCK_TICK_GENERATOR_STATUS_OFFSET                             (0x00000058)
 
 #define XLNX_CLOCK_TICK_GENERATOR_STATS_START                               (0x0000005C)
-#define XLNX_CLOCK_TICK_GENERATOR_NUM_STATS_REGISTERS                       (5) 
+#define XLNX_CLOCK_TICK_GENERATOR_NUM_STATS_REGISTERS                       (7) 
+
+/* timer wheel */
+#define XLNX_CLOCK_TICK_GENERATOR_TIMER_INTERVAL_OFFSET                     (0x00000080)
+#define XLNX_CLOCK_TICK_GENERATOR_TIMER_CONFIG_OFFSET                       (0x00000088)
+#define XLNX_CLOCK_TICK_GENERATOR_TIMER_ARM_COUNT_OFFSET                    (0x00000090)
+#define XLNX_CLOCK_TICK_GENERATOR_TIMER_CANCEL_COUNT_OFFSET                 (0x000000A0)
+#define XLNX_CLOCK_TICK_GENERATOR_TIMER_FIRE_COUNT_OFFSET                   (0x000000B0)
+#define XLNX_CLOCK_TICK_GENERATOR_TIMER_DROP_COUNT_OFFSET                   (0x000000C0)
 
 
 
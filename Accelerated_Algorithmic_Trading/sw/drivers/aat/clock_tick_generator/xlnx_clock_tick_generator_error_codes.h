@@ -34,6 +34,8 @@
 #define XLNX_CLOCK_TICK_GENERATOR_ERROR_CU_INDEX_NOT_FOUND			            (0x00000005)
 #define XLNX_CLOCK_TICK_GENERATOR_ERROR_STREAM_INDEX_OUT_OF_RANGE               (0x00000006)
 #define XLNX_CLOCK_TICK_GENERATOR_ERROR_INTERVAL_TOO_LARGE                      (0x00000007)
+#define XLNX_CLOCK_TICK_GENERATOR_ERROR_TIMER_INDEX_OUT_OF_RANGE                (0x00000008)
+#define XLNX_CLOCK_TICK_GENERATOR_ERROR_TIMER_TARGET_OUT_OF_RANGE               (0x00000009)
 
 
 
@@ -0,0 +1,409 @@
+/*
+ * Copyright 2021 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <cstring>
+
+//the 64b lane extract (_mm_cvtsi128_si64) is only available on x86-64, 32b SSE2 builds take the scalar path
+#if defined(__SSE2__) && defined(__x86_64__)
+#include <emmintrin.h>
+#endif
+
+#include "xlnx_feed_decoder.h"
+#include "xlnx_feed_decoder_error_codes.h"
+
+using namespace XLNX;
+
+
+
+
+//matches PRICE_EXPONENT in hw/common/include/aat_defines.hpp
+static const double PRICE_EXPONENT = 0.00001;
+
+
+
+
+//multiplicative hash, the top bits of the product select the slot
+static inline uint32_t SecuritySlot(uint32_t securityID, uint32_t tableSizeLog2)
+{
+    return (securityID * 2654435761u) >> (32 - tableSizeLog2);
+}
+
+static inline uint16_t ReadLE16(const uint8_t* p)
+{
+    uint16_t value;
+    memcpy(&value, p, sizeof(value));
+    return value;
+}
+
+static inline uint32_t ReadLE32(const uint8_t* p)
+{
+    uint32_t value;
+    memcpy(&value, p, sizeof(value));
+    return value;
+}
+
+static inline uint64_t ReadLE64(const uint8_t* p)
+{
+    uint64_t value;
+    memcpy(&value, p, sizeof(value));
+    return value;
+}
+
+
+
+
+
+FeedDecoder::FeedDecoder()
+{
+    ClearSecurities();
+    ResetStats();
+}
+
+
+
+
+FeedDecoder::~FeedDecoder()
+{
+
+}
+
+
+
+
+
+uint32_t FeedDecoder::SetSecurity(uint32_t index, uint32_t securityID)
+{
+    uint32_t retval = XLNX_OK;
+
+    if (index >= MAX_NUM_SECURITIES)
+    {
+        retval = XLNX_FEED_DECODER_ERROR_SECURITY_INDEX_OUT_OF_RANGE;
+    }
+
+    if (retval == XLNX_OK)
+    {
+        m_securities[index] = securityID;
+        RebuildSecurityTable();
+    }
+
+    return retval;
+}
+
+
+
+
+
+uint32_t FeedDecoder::GetSecurity(uint32_t index, uint32_t* pSecurityID)
+{
+    uint32_t retval = XLNX_OK;
+
+    if (index >= MAX_NUM_SECURITIES)
+    {
+        retval = XLNX_FEED_DECODER_ERROR_SECURITY_INDEX_OUT_OF_RANGE;
+    }
+
+    if (retval == XLNX_OK)
+    {
+        *pSecurityID = m_securities[index];
+    }
+
+    return retval;
+}
+
+
+
+
+
+uint32_t FeedDecoder::ClearSecurities(void)
+{
+    memset(m_securities, 0, sizeof(m_securities));
+    RebuildSecurityTable();
+
+    return XLNX_OK;
+}
+
+
+
+
+
+uint32_t FeedDecoder::DecodePacket(const uint8_t* pPayload, uint32_t payloadLength, uint64_t ingressTimestamp,
+                                   orderBookOperation_t* pOperations, uint32_t maxOperations, uint32_t* pNumOperations)
+{
+    uint32_t retval = XLNX_OK;
+    uint32_t offset;
+    uint32_t messageLength;
+    uint32_t templateID;
+    uint32_t numOperations = 0;
+    uint32_t numMessageOperations;
+
+    if ((pPayload == nullptr) || (pOperations == nullptr) || (pNumOperations == nullptr))
+    {
+        retval = XLNX_FEED_DECODER_ERROR_INVALID_PARAMETER;
+    }
+
+    if (retval == XLNX_OK)
+    {
+        m_stats.numPackets++;
+
+        if (payloadLength < PACKET_HEADER_LENGTH)
+        {
+            retval = XLNX_FEED_DECODER_ERROR_MALFORMED_PACKET;
+        }
+    }
+
+    offset = PACKET_HEADER_LENGTH;
+
+    while ((retval == XLNX_OK) && ((offset + MESSAGE_HEADER_LENGTH) <= payloadLength))
+    {
+        //messages are parsed in place, MsgSize includes its own 2 bytes
+        messageLength = ReadLE16(&pPayload[offset]);
+        templateID = ReadLE16(&pPayload[offset + 4]);
+
+        if ((messageLength < MESSAGE_HEADER_LENGTH) || ((offset + messageLength) > payloadLength))
+        {
+            retval = XLNX_FEED_DECODER_ERROR_MALFORMED_PACKET;
+            break;
+        }
+
+        m_stats.numMessages++;
+
+        if (templateID == TEMPLATE_ID_BOOK32)
+        {
+            numMessageOperations = 0;
+
+            retval = DecodeBook32(&pPayload[offset], messageLength, ingressTimestamp,
+                                  &pOperations[numOperations], maxOperations - numOperations, &numMessageOperations);
+
+            numOperations += numMessageOperations;
+        }
+        else
+        {
+            m_stats.numUnsupportedMessages++;
+        }
+
+        offset += messageLength;
+    }
+
+    if (retval == XLNX_FEED_DECODER_ERROR_MALFORMED_PACKET)
+    {
+        m_stats.numMalformedPackets++;
+    }
+
+    if (pNumOperations != nullptr)
+    {
+        *pNumOperations = numOperations;
+    }
+
+    m_stats.numOperations += numOperations;
+
+    return retval;
+}
+
+
+
+
+
+uint32_t FeedDecoder::DecodeBook32(const uint8_t* pMessage, uint32_t messageLength, uint64_t ingressTimestamp,
+                                   orderBookOperation_t* pOperations, uint32_t maxOperations, uint32_t* pNumOperations)
+{
+    uint32_t retval = XLNX_OK;
+    uint64_t transactTime;
+    uint32_t entryLength;
+    uint32_t numEntries;
+    uint32_t numOperations = 0;
+    const uint8_t* pEntry;
+    const uint8_t* pMessageEnd = pMessage + messageLength;
+    int64_t mantissa;
+    uint32_t entrySize;
+    uint32_t securityID;
+    uint32_t numOrders;
+    uint32_t entryTail;
+    uint8_t symbolIndex;
+    orderBookOperation_t* pOperation;
+    uint32_t i;
+
+    if (messageLength < (BOOK32_GROUP_OFFSET + 3))
+    {
+        retval = XLNX_FEED_DECODER_ERROR_MALFORMED_PACKET;
+    }
+
+    if (retval == XLNX_OK)
+    {
+        transactTime = ReadLE64(&pMessage[14]);
+        entryLength = ReadLE16(&pMessage[BOOK32_GROUP_OFFSET]);
+        numEntries = pMessage[BOOK32_GROUP_OFFSET + 2];
+
+        if ((entryLength < BOOK32_ENTRY_MIN_LENGTH) ||
+            ((BOOK32_GROUP_OFFSET + 3 + (numEntries * entryLength)) > messageLength))
+        {
+            retval = XLNX_FEED_DECODER_ERROR_MALFORMED_PACKET;
+        }
+    }
+
+    pEntry = &pMessage[BOOK32_GROUP_OFFSET + 3];
+
+    for (i = 0; (retval == XLNX_OK) && (i < numEntries); i++, pEntry += entryLength)
+    {
+#if defined(__SSE2__) && defined(__x86_64__)
+        if ((pEntry + 32) <= pMessageEnd)
+        {
+            //the whole entry is pulled in with two unaligned 128b loads and the fields are
+            //extracted from register lanes, rather than eight separate narrow loads
+            __m128i lo = _mm_loadu_si128((const __m128i*)pEntry);          //MDEntryPx, MDEntrySize, SecurityID
+            __m128i hi = _mm_loadu_si128((const __m128i*)(pEntry + 16));   //RptSeq, NumberOfOrders, level, action, type
+
+            mantissa    = (int64_t)_mm_cvtsi128_si64(lo);
+            entrySize   = (uint32_t)_mm_cvtsi128_si32(_mm_srli_si128(lo, 8));
+            securityID  = (uint32_t)_mm_cvtsi128_si32(_mm_srli_si128(lo, 12));
+            numOrders   = (uint32_t)_mm_cvtsi128_si32(_mm_srli_si128(hi, 4));
+            entryTail   = (uint32_t)_mm_cvtsi128_si32(_mm_srli_si128(hi, 8));
+        }
+        else
+#endif
+        {
+            mantissa    = (int64_t)ReadLE64(&pEntry[0]);
+            entrySize   = ReadLE32(&pEntry[8]);
+            securityID  = ReadLE32(&pEntry[12]);
+            numOrders   = ReadLE32(&pEntry[20]);
+            entryTail   = pEntry[24] | (pEntry[25] << 8) | (pEntry[26] << 16);
+        }
+
+        m_stats.numEntries++;
+
+        if (LookupSecurity(securityID, &symbolIndex) == false)
+        {
+            m_stats.numUnknownSecurities++;
+            continue;
+        }
+
+        if (numOperations >= maxOperations)
+        {
+            retval = XLNX_FEED_DECODER_ERROR_OPERATION_BUFFER_FULL;
+            break;
+        }
+
+        pOperation = &pOperations[numOperations];
+
+        pOperation->timestamp           = transactTime;
+        pOperation->opCode              = (uint8_t)(entryTail >> 8);            //MDUpdateAction
+        pOperation->symbolIndex         = symbolIndex;
+        pOperation->orderId             = 0;
+        pOperation->orderCount          = numOrders;
+        pOperation->quantity            = entrySize;
+        pOperation->price               = (uint32_t)(int64_t)(mantissa * PRICE_EXPONENT);
+        pOperation->direction           = (uint8_t)((entryTail >> 16) - 0x30);  //MDEntryType, ascii to OB encoding
+        pOperation->level               = (int8_t)(entryTail & 0xFF);           //MDPriceLevel
+        pOperation->ingressTimestamp    = ingressTimestamp;
+
+        numOperations++;
+    }
+
+    *pNumOperations = numOperations;
+
+    return retval;
+}
+
+
+
+
+
+uint32_t FeedDecoder::GetStats(Stats* pStats)
+{
+    uint32_t retval = XLNX_OK;
+
+    if (pStats == nullptr)
+    {
+        retval = XLNX_FEED_DECODER_ERROR_INVALID_PARAMETER;
+    }
+
+    if (retval == XLNX_OK)
+    {
+        *pStats = m_stats;
+    }
+
+    return retval;
+}
+
+
+
+
+
+uint32_t FeedDecoder::ResetStats(void)
+{
+    memset(&m_stats, 0, sizeof(m_stats));
+
+    return XLNX_OK;
+}
+
+
+
+
+
+bool FeedDecoder::LookupSecurity(uint32_t securityID, uint8_t* pIndex)
+{
+    bool bFound = false;
+    uint32_t slot;
+
+    if (securityID != 0)
+    {
+        slot = SecuritySlot(securityID, SECURITY_TABLE_SIZE_LOG2);
+
+        while (m_securityTableKeys[slot] != 0)
+        {
+            if (m_securityTableKeys[slot] == securityID)
+            {
+                *pIndex = m_securityTableValues[slot];
+                bFound = true;
+                break;
+            }
+
+            slot = (slot + 1) & (SECURITY_TABLE_SIZE - 1);
+        }
+    }
+
+    return bFound;
+}
+
+
+
+
+
+void FeedDecoder::RebuildSecurityTable(void)
+{
+    uint32_t slot;
+    uint32_t i;
+
+    memset(m_securityTableKeys, 0, sizeof(m_securityTableKeys));
+    memset(m_securityTableValues, 0, sizeof(m_securityTableValues));
+
+    //ascending order so that, as in HW, the highest index wins if a security ID is mapped more than once
+    for (i = 0; i < MAX_NUM_SECURITIES; i++)
+    {
+        if (m_securities[i] != 0)
+        {
+            slot = SecuritySlot(m_securities[i], SECURITY_TABLE_SIZE_LOG2);
+
+            while ((m_securityTableKeys[slot] != 0) && (m_securityTableKeys[slot] != m_securities[i]))
+            {
+                slot = (slot + 1) & (SECURITY_TABLE_SIZE - 1);
+            }
+
+            m_securityTableKeys[slot] = m_securities[i];
+            m_securityTableValues[slot] = (uint8_t)i;
+        }
+    }
+}
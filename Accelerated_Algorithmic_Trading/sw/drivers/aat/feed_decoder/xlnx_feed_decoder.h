@@ -0,0 +1,137 @@
+/*
+ * Copyright 2021 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef XLNX_FEED_DECODER_H
+#define XLNX_FEED_DECODER_H
+
+
+#include <cstdint>
+
+#include "xlnx_feed_decoder_error_codes.h"
+
+
+
+
+namespace XLNX
+{
+
+
+//Host equivalent of the orderBookOperation_t emitted by the FeedHandler kernel
+typedef struct orderBookOperation_t
+{
+    uint64_t timestamp;
+    uint8_t  opCode;
+    uint8_t  symbolIndex;
+    uint32_t orderId;
+    uint32_t orderCount;
+    uint32_t quantity;
+    uint32_t price;
+    uint8_t  direction;
+    int8_t   level;
+    uint64_t ingressTimestamp;
+} orderBookOperation_t;
+
+
+
+
+
+//The FeedDecoder is a software model of the FeedHandler kernel. It decodes CME MDP3 (SBE) UDP payloads
+//into the same order book operation stream as the HW, and is intended for use as a golden reference,
+//as a fallback when the card is unavailable and for offline book reconstruction.
+//The message layout and field handling follow hw/feedHandler/feedhandler.cpp, including its limitation
+//to MDIncrementalRefreshBook32 (template 32) messages.
+class FeedDecoder
+{
+
+
+public:
+    FeedDecoder();
+    virtual ~FeedDecoder();
+
+
+
+public: //Security ID Control
+    static const uint32_t MAX_NUM_SECURITIES = 256;
+
+    //Equivalent of the FeedHandler symbol map, operations for a security ID that is not mapped are dropped.
+    //A security ID of 0 marks an unused index
+    uint32_t SetSecurity(uint32_t index, uint32_t securityID);
+    uint32_t GetSecurity(uint32_t index, uint32_t* pSecurityID);
+    uint32_t ClearSecurities(void);
+
+
+
+public: //Decode
+    static const uint32_t PACKET_HEADER_LENGTH = 12;      //MsgSeqNum + SendingTime
+    static const uint32_t MESSAGE_HEADER_LENGTH = 10;     //MsgSize + SBE header
+    static const uint32_t MAX_OPERATIONS_PER_PACKET = 2048;
+
+    //Decodes a single MDP3 packet (i.e. UDP payload) in place, no copy is taken of the payload.
+    //Decoded operations are written to pOperations, the number written is returned in pNumOperations.
+    //The ingress timestamp is applied to every operation decoded from the packet
+    uint32_t DecodePacket(const uint8_t* pPayload, uint32_t payloadLength, uint64_t ingressTimestamp,
+                          orderBookOperation_t* pOperations, uint32_t maxOperations, uint32_t* pNumOperations);
+
+
+
+public: //Stats
+    typedef struct
+    {
+        uint64_t numPackets;
+        uint64_t numMessages;
+        uint64_t numUnsupportedMessages;    //template other than 32, skipped
+        uint64_t numEntries;                //MDEntries decoded
+        uint64_t numOperations;             //operations emitted
+        uint64_t numUnknownSecurities;      //entries dropped as security ID is not mapped
+        uint64_t numMalformedPackets;
+    }Stats;
+
+    uint32_t GetStats(Stats* pStats);
+    uint32_t ResetStats(void);
+
+
+
+protected:
+    static const uint32_t TEMPLATE_ID_BOOK32 = 32;
+    static const uint32_t BOOK32_GROUP_OFFSET = 25;        //from start of message, see MDIncrementalRefreshBook32()
+    static const uint32_t BOOK32_ENTRY_MIN_LENGTH = 27;
+    static const uint32_t SECURITY_TABLE_SIZE_LOG2 = 9;
+    static const uint32_t SECURITY_TABLE_SIZE = (1 << SECURITY_TABLE_SIZE_LOG2);  //2 x MAX_NUM_SECURITIES
+
+    uint32_t DecodeBook32(const uint8_t* pMessage, uint32_t messageLength, uint64_t ingressTimestamp,
+                          orderBookOperation_t* pOperations, uint32_t maxOperations, uint32_t* pNumOperations);
+
+    bool LookupSecurity(uint32_t securityID, uint8_t* pIndex);
+    void RebuildSecurityTable(void);
+
+protected:
+    uint32_t m_securities[MAX_NUM_SECURITIES];
+
+    //open addressed hash of security ID to index, rebuilt whenever the map changes
+    uint32_t m_securityTableKeys[SECURITY_TABLE_SIZE];
+    uint8_t m_securityTableValues[SECURITY_TABLE_SIZE];
+
+    Stats m_stats;
+};
+
+
+
+} //namespace XLNX
+
+
+
+#endif
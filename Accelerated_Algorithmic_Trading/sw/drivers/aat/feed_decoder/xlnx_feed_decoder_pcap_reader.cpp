@@ -0,0 +1,323 @@
+/*
+ * Copyright 2021 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <cstring>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "xlnx_network_capture_pcap_headers.h"
+
+#include "xlnx_feed_decoder_pcap_reader.h"
+#include "xlnx_feed_decoder_error_codes.h"
+
+using namespace XLNX;
+
+
+
+#define PCAP_MAGIC_MICROSECONDS     (0xA1B2C3D4)
+#define PCAP_MAGIC_NANOSECONDS      (0xA1B23C4D)
+
+#define ETHERNET_HEADER_LENGTH      (14)
+#define ETHERTYPE_VLAN              (0x8100)
+#define ETHERTYPE_IPV4              (0x0800)
+#define IP_PROTOCOL_UDP             (17)
+#define UDP_HEADER_LENGTH           (8)
+
+
+
+
+PCAPReader::PCAPReader()
+{
+    m_pFileData = nullptr;
+    m_fileSize = 0;
+    m_readOffset = 0;
+    m_linkType = 0;
+    m_bNanosecondTimestamps = false;
+}
+
+
+
+
+PCAPReader::~PCAPReader()
+{
+    Close();
+}
+
+
+
+
+
+uint32_t PCAPReader::Open(const char* filePath)
+{
+    uint32_t retval = XLNX_OK;
+    int fd = -1;
+    struct stat fileStat;
+    void* pMapping = MAP_FAILED;
+    pcap_hdr_t fileHeader;
+
+    Close();
+
+    fd = open(filePath, O_RDONLY);
+
+    if (fd < 0)
+    {
+        retval = XLNX_FEED_DECODER_ERROR_FAILED_TO_OPEN_PCAP_FILE;
+    }
+
+    if (retval == XLNX_OK)
+    {
+        if ((fstat(fd, &fileStat) != 0) || ((size_t)fileStat.st_size < sizeof(pcap_hdr_t)))
+        {
+            retval = XLNX_FEED_DECODER_ERROR_INVALID_PCAP_FILE;
+        }
+    }
+
+    if (retval == XLNX_OK)
+    {
+        pMapping = mmap(nullptr, (size_t)fileStat.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+
+        if (pMapping == MAP_FAILED)
+        {
+            retval = XLNX_FEED_DECODER_ERROR_FAILED_TO_MAP_PCAP_FILE;
+        }
+    }
+
+    if (fd >= 0)
+    {
+        close(fd);
+    }
+
+    if (retval == XLNX_OK)
+    {
+        madvise(pMapping, (size_t)fileStat.st_size, MADV_SEQUENTIAL);
+
+        m_pFileData = (const uint8_t*)pMapping;
+        m_fileSize = (size_t)fileStat.st_size;
+
+        memcpy(&fileHeader, m_pFileData, sizeof(fileHeader));
+
+        //only native byte order files are supported
+        if (fileHeader.magic_number == PCAP_MAGIC_MICROSECONDS)
+        {
+            m_bNanosecondTimestamps = false;
+        }
+        else if (fileHeader.magic_number == PCAP_MAGIC_NANOSECONDS)
+        {
+            m_bNanosecondTimestamps = true;
+        }
+        else
+        {
+            retval = XLNX_FEED_DECODER_ERROR_INVALID_PCAP_FILE;
+        }
+
+        m_linkType = fileHeader.network;
+
+        if ((m_linkType != LINKTYPE_ETHERNET) && (m_linkType != LINKTYPE_RAW) && (m_linkType != LINKTYPE_IPV4))
+        {
+            retval = XLNX_FEED_DECODER_ERROR_INVALID_PCAP_FILE;
+        }
+    }
+
+    if (retval == XLNX_OK)
+    {
+        m_readOffset = sizeof(pcap_hdr_t);
+    }
+    else
+    {
+        Close();
+    }
+
+    return retval;
+}
+
+
+
+
+
+uint32_t PCAPReader::Close(void)
+{
+    if (m_pFileData != nullptr)
+    {
+        munmap((void*)m_pFileData, m_fileSize);
+    }
+
+    m_pFileData = nullptr;
+    m_fileSize = 0;
+    m_readOffset = 0;
+
+    return XLNX_OK;
+}
+
+
+
+
+
+uint32_t PCAPReader::Rewind(void)
+{
+    uint32_t retval = XLNX_OK;
+
+    retval = CheckFileIsOpen();
+
+    if (retval == XLNX_OK)
+    {
+        m_readOffset = sizeof(pcap_hdr_t);
+    }
+
+    return retval;
+}
+
+
+
+
+
+uint32_t PCAPReader::GetNextUDPPayload(const uint8_t** ppPayload, uint32_t* pPayloadLength, uint64_t* pTimestampNanoseconds)
+{
+    uint32_t retval = XLNX_OK;
+    pcaprec_hdr_t recordHeader;
+    const uint8_t* pFrame;
+    bool bFound = false;
+
+    retval = CheckFileIsOpen();
+
+    while ((retval == XLNX_OK) && (bFound == false))
+    {
+        if ((m_readOffset + sizeof(pcaprec_hdr_t)) > m_fileSize)
+        {
+            retval = XLNX_FEED_DECODER_ERROR_END_OF_FILE;
+            break;
+        }
+
+        memcpy(&recordHeader, &m_pFileData[m_readOffset], sizeof(recordHeader));
+        m_readOffset += sizeof(pcaprec_hdr_t);
+
+        if ((m_readOffset + recordHeader.incl_len) > m_fileSize)
+        {
+            //truncated final record
+            m_readOffset = m_fileSize;
+            retval = XLNX_FEED_DECODER_ERROR_END_OF_FILE;
+            break;
+        }
+
+        pFrame = &m_pFileData[m_readOffset];
+        m_readOffset += recordHeader.incl_len;
+
+        bFound = GetUDPPayload(pFrame, recordHeader.incl_len, ppPayload, pPayloadLength);
+
+        if (bFound)
+        {
+            *pTimestampNanoseconds = ((uint64_t)recordHeader.ts_sec * 1000000000ull) +
+                                     (m_bNanosecondTimestamps ? recordHeader.ts_nsec : ((uint64_t)recordHeader.ts_nsec * 1000ull));
+        }
+    }
+
+    return retval;
+}
+
+
+
+
+
+uint32_t PCAPReader::CheckFileIsOpen(void)
+{
+    uint32_t retval = XLNX_OK;
+
+    if (m_pFileData == nullptr)
+    {
+        retval = XLNX_FEED_DECODER_ERROR_PCAP_FILE_NOT_OPEN;
+    }
+
+    return retval;
+}
+
+
+
+
+
+bool PCAPReader::GetUDPPayload(const uint8_t* pFrame, uint32_t frameLength, const uint8_t** ppPayload, uint32_t* pPayloadLength)
+{
+    bool bFound = true;
+    uint32_t offset = 0;
+    uint32_t etherType;
+    uint32_t ipHeaderLength;
+    uint32_t ipTotalLength;
+    uint32_t udpLength;
+
+    if (m_linkType == LINKTYPE_ETHERNET)
+    {
+        offset = ETHERNET_HEADER_LENGTH;
+
+        if (frameLength < offset)
+        {
+            bFound = false;
+        }
+        else
+        {
+            etherType = (pFrame[12] << 8) | pFrame[13];
+
+            if ((etherType == ETHERTYPE_VLAN) && (frameLength >= (offset + 4)))
+            {
+                etherType = (pFrame[16] << 8) | pFrame[17];
+                offset += 4;
+            }
+
+            if (etherType != ETHERTYPE_IPV4)
+            {
+                bFound = false;
+            }
+        }
+    }
+
+    if (bFound)
+    {
+        if (((offset + 20) > frameLength) || ((pFrame[offset] >> 4) != 4) || (pFrame[offset + 9] != IP_PROTOCOL_UDP))
+        {
+            bFound = false;
+        }
+    }
+
+    if (bFound)
+    {
+        ipHeaderLength = (pFrame[offset] & 0x0F) * 4;
+        ipTotalLength = (pFrame[offset + 2] << 8) | pFrame[offset + 3];
+
+        if ((ipHeaderLength < 20) || ((offset + ipTotalLength) > frameLength) || (ipTotalLength < (ipHeaderLength + UDP_HEADER_LENGTH)))
+        {
+            bFound = false;
+        }
+    }
+
+    if (bFound)
+    {
+        offset += ipHeaderLength;
+        udpLength = (pFrame[offset + 4] << 8) | pFrame[offset + 5];
+
+        if ((udpLength < UDP_HEADER_LENGTH) || (udpLength > (ipTotalLength - ipHeaderLength)))
+        {
+            bFound = false;
+        }
+        else
+        {
+            *ppPayload = &pFrame[offset + UDP_HEADER_LENGTH];
+            *pPayloadLength = udpLength - UDP_HEADER_LENGTH;
+        }
+    }
+
+    return bFound;
+}
@@ -0,0 +1,77 @@
+/*
+ * Copyright 2021 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef XLNX_FEED_DECODER_PCAP_READER_H
+#define XLNX_FEED_DECODER_PCAP_READER_H
+
+
+#include <cstdint>
+#include <cstddef>
+
+#include "xlnx_feed_decoder_error_codes.h"
+
+
+
+
+namespace XLNX
+{
+
+
+//Memory maps a PCAP file and walks its records in place, handing out pointers to the UDP payload
+//of each IPv4 packet so that the file contents are never copied on the decode path
+class PCAPReader
+{
+
+
+public:
+    PCAPReader();
+    virtual ~PCAPReader();
+
+
+
+public:
+    uint32_t Open(const char* filePath);
+    uint32_t Close(void);
+
+    //Moves back to the first record in the file
+    uint32_t Rewind(void);
+
+    //Returns the next UDP payload in the file, records that do not hold an IPv4 UDP packet are skipped.
+    //Returns XLNX_FEED_DECODER_ERROR_END_OF_FILE once all records have been consumed
+    uint32_t GetNextUDPPayload(const uint8_t** ppPayload, uint32_t* pPayloadLength, uint64_t* pTimestampNanoseconds);
+
+
+
+protected:
+    uint32_t CheckFileIsOpen(void);
+    bool GetUDPPayload(const uint8_t* pFrame, uint32_t frameLength, const uint8_t** ppPayload, uint32_t* pPayloadLength);
+
+protected:
+    const uint8_t* m_pFileData;
+    size_t m_fileSize;
+    size_t m_readOffset;
+    uint32_t m_linkType;
+    bool m_bNanosecondTimestamps;
+};
+
+
+
+} //namespace XLNX
+
+
+
+#endif
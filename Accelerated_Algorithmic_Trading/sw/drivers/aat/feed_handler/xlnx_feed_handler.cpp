@@ -32,6 +32,7 @@ static const uint32_t NUM_BYTES_PER_HW_WORD = 8;
 FeedHandler::FeedHandler()
 {
 	m_pDeviceInterface = nullptr;
+	m_pTelemetry = nullptr;
 	m_cuAddress = 0;
 	m_cuIndex = 0;
 	m_initialisedMagicNumber = 0;
@@ -134,6 +135,23 @@ uint32_t FeedHandler::ReadReg32(uint64_t offset, uint32_t* value)
 
 
 
+uint32_t FeedHandler::ReadStatsReg32(TelemetryRegisterSnapshot* pSnapshot, uint64_t offset, uint32_t* value)
+{
+    uint32_t retval = XLNX_OK;
+
+    if ((pSnapshot == nullptr) || (pSnapshot->ReadReg32(m_cuAddress + offset, value) != XLNX_OK))
+    {
+        retval = ReadReg32(offset, value);
+    }
+
+    return retval;
+}
+
+
+
+
+
+
 uint32_t FeedHandler::WriteReg32(uint64_t offset, uint32_t value)
 {
 	uint32_t retval = XLNX_OK;
@@ -407,10 +425,17 @@ uint32_t FeedHandler::RemoveAllSecurities(void)
 uint32_t  FeedHandler::GetStats(FeedHandler::Stats* pStats)
 {
 	uint32_t retval = XLNX_OK;
+	TelemetryRegisterSnapshot snapshot;
     uint32_t numProcessedWords;
 
 	retval = CheckIsInitialised();
 
+    if (retval == XLNX_OK)
+    {
+        //no snapshot (sampling stopped or no telemetry set) just means every register is read from the device
+        snapshot.Load(m_pTelemetry);
+    }
+
 
 	
 
@@ -419,7 +444,7 @@ uint32_t  FeedHandler::GetStats(FeedHandler::Stats* pStats)
         //NOTE - for the following, the HW reports number of processed WORDS.
         //       Each word is 8 bytes in HW.  We do a conversion here so we 
         //       report the number of processed BYTES to the end-user
-        retval = m_pDeviceInterface->ReadReg32(m_cuAddress + XLNX_FEED_HANDLER_STATS_PROCESSED_WORDS_COUNT_OFFSET, &numProcessedWords);
+        retval = ReadStatsReg32(&snapshot, XLNX_FEED_HANDLER_STATS_PROCESSED_WORDS_COUNT_OFFSET, &numProcessedWords);
 
         if (retval == XLNX_OK)
         {
@@ -430,29 +455,39 @@ uint32_t  FeedHandler::GetStats(FeedHandler::Stats* pStats)
 
     if (retval == XLNX_OK)
     {
-        retval = m_pDeviceInterface->ReadReg32(m_cuAddress + XLNX_FEED_HANDLER_STATS_PROCESSED_PACKETS_COUNT_OFFSET, &pStats->numProcessedPackets);
+        retval = ReadStatsReg32(&snapshot, XLNX_FEED_HANDLER_STATS_PROCESSED_PACKETS_COUNT_OFFSET, &pStats->numProcessedPackets);
     }
 
     if (retval == XLNX_OK)
     {
-        retval = m_pDeviceInterface->ReadReg32(m_cuAddress + XLNX_FEED_HANDLER_STATS_PROCESSED_BINARY_MSG_COUNT_OFFSET, &pStats->numProcessedBinaryMessages);
+        retval = ReadStatsReg32(&snapshot, XLNX_FEED_HANDLER_STATS_PROCESSED_BINARY_MSG_COUNT_OFFSET, &pStats->numProcessedBinaryMessages);
     }
 
     if (retval == XLNX_OK)
     {
-        retval = m_pDeviceInterface->ReadReg32(m_cuAddress + XLNX_FEED_HANDLER_STATS_PROCESSED_FIX_MSG_COUNT_OFFSET, &pStats->numProcessedFIXMessages);
+        retval = ReadStatsReg32(&snapshot, XLNX_FEED_HANDLER_STATS_PROCESSED_FIX_MSG_COUNT_OFFSET, &pStats->numProcessedFIXMessages);
     }
 
     if (retval == XLNX_OK)
     {
-        retval = m_pDeviceInterface->ReadReg32(m_cuAddress + XLNX_FEED_HANDLER_STATS_TX_OPERATION_COUNT_OFFSET, &pStats->numTxOrderBookOperations);
+        retval = ReadStatsReg32(&snapshot, XLNX_FEED_HANDLER_STATS_TX_OPERATION_COUNT_OFFSET, &pStats->numTxOrderBookOperations);
     }
 
     if (retval == XLNX_OK)
     {
-        retval = m_pDeviceInterface->ReadReg32(m_cuAddress + XLNX_FEED_HANDLER_STATS_CLOCK_TICK_COUNT_OFFSET, &pStats->numClockTickEvents);
+        retval = ReadStatsReg32(&snapshot, XLNX_FEED_HANDLER_STATS_CLOCK_TICK_COUNT_OFFSET, &pStats->numClockTickEvents);
+    }
+
+
+    if (retval == XLNX_OK)
+    {
+        retval = ReadLatencySummary(false, &pStats->egressLatency, &snapshot);
     }
 
+    if (retval == XLNX_OK)
+    {
+        retval = ReadLatencySummary(true, &pStats->ingressLatency, &snapshot);
+    }
 
 	return retval;
 }
@@ -596,6 +631,18 @@ uint32_t FeedHandler::CheckIsInitialised(void)
 
 
 
+uint32_t FeedHandler::SetTelemetry(Telemetry* pTelemetry)
+{
+    m_pTelemetry = pTelemetry;
+
+    return XLNX_OK;
+}
+
+
+
+
+
+
 void FeedHandler::IsInitialised(bool* pbIsInitialised)
 {
     if (CheckIsInitialised() == XLNX_OK)
@@ -1073,4 +1120,204 @@ uint32_t FeedHandler::ReadData(FeedData* pData)
     }
 
     return retval;
-}
\ No newline at end of file
+}
+
+
+
+
+
+
+uint32_t FeedHandler::SetLatencyBinShift(uint32_t binShift)
+{
+    uint32_t retval = XLNX_OK;
+    uint32_t mask = XLNX_FEED_HANDLER_LATENCY_BIN_SHIFT_MASK;
+
+    retval = CheckIsInitialised();
+
+    if (retval == XLNX_OK)
+    {
+        if (binShift > XLNX_FEED_HANDLER_LATENCY_BIN_SHIFT_MASK)
+        {
+            retval = XLNX_FEED_HANDLER_ERROR_INVALID_PARAMETER;
+        }
+    }
+
+    if (retval == XLNX_OK)
+    {
+        retval = WriteRegWithMask32(XLNX_FEED_HANDLER_LATENCY_CONTROL_OFFSET, binShift, mask);
+    }
+
+    return retval;
+}
+
+
+
+
+
+
+uint32_t FeedHandler::GetLatencyHistogram(LatencyHistogram* pHistogram)
+{
+    return ReadLatencyHistogram(false, pHistogram);
+}
+
+
+
+
+
+
+uint32_t FeedHandler::GetIngressLatencyHistogram(LatencyHistogram* pHistogram)
+{
+    return ReadLatencyHistogram(true, pHistogram);
+}
+
+
+
+
+
+uint32_t FeedHandler::ResetLatencyHistogram(void)
+{
+    uint32_t retval = XLNX_OK;
+    uint32_t shift = XLNX_FEED_HANDLER_LATENCY_RESET_SHIFT;
+    uint32_t mask = 0x01;
+    uint32_t value;
+
+    retval = CheckIsInitialised();
+
+    if (retval == XLNX_OK)
+    {
+        mask = mask << shift;
+
+        value = 1;
+        value = value << shift;
+
+        retval = WriteRegWithMask32(XLNX_FEED_HANDLER_LATENCY_CONTROL_OFFSET, value, mask);
+    }
+
+    if (retval == XLNX_OK)
+    {
+        value = 0;
+        value = value << shift;
+        retval = WriteRegWithMask32(XLNX_FEED_HANDLER_LATENCY_CONTROL_OFFSET, value, mask);
+    }
+
+    return retval;
+}
+
+
+
+
+
+
+
+uint32_t FeedHandler::ReadLatencySummary(bool bIngress, LatencySummary* pSummary, TelemetryRegisterSnapshot* pSnapshot)
+{
+    uint32_t retval = XLNX_OK;
+    uint64_t countOffset = XLNX_FEED_HANDLER_STATS_LATENCY_COUNT_OFFSET;
+    uint64_t minOffset = XLNX_FEED_HANDLER_STATS_LATENCY_MIN_OFFSET;
+    uint64_t maxOffset = XLNX_FEED_HANDLER_STATS_LATENCY_MAX_OFFSET;
+    uint64_t sumLowerOffset = XLNX_FEED_HANDLER_STATS_LATENCY_SUM_LOWER_OFFSET;
+    uint64_t sumUpperOffset = XLNX_FEED_HANDLER_STATS_LATENCY_SUM_UPPER_OFFSET;
+    uint32_t sumLower = 0;
+    uint32_t sumUpper = 0;
+
+    if (bIngress)
+    {
+        countOffset = XLNX_FEED_HANDLER_STATS_INGRESS_LATENCY_COUNT_OFFSET;
+        minOffset = XLNX_FEED_HANDLER_STATS_INGRESS_LATENCY_MIN_OFFSET;
+        maxOffset = XLNX_FEED_HANDLER_STATS_INGRESS_LATENCY_MAX_OFFSET;
+        sumLowerOffset = XLNX_FEED_HANDLER_STATS_INGRESS_LATENCY_SUM_LOWER_OFFSET;
+        sumUpperOffset = XLNX_FEED_HANDLER_STATS_INGRESS_LATENCY_SUM_UPPER_OFFSET;
+    }
+
+    retval = CheckIsInitialised();
+
+    if (retval == XLNX_OK)
+    {
+        retval = ReadStatsReg32(pSnapshot, countOffset, &pSummary->numSamples);
+    }
+
+    if (retval == XLNX_OK)
+    {
+        retval = ReadStatsReg32(pSnapshot, minOffset, &pSummary->minLatency);
+    }
+
+    if (retval == XLNX_OK)
+    {
+        retval = ReadStatsReg32(pSnapshot, maxOffset, &pSummary->maxLatency);
+    }
+
+    if (retval == XLNX_OK)
+    {
+        retval = ReadStatsReg32(pSnapshot, sumLowerOffset, &sumLower);
+    }
+
+    if (retval == XLNX_OK)
+    {
+        retval = ReadStatsReg32(pSnapshot, sumUpperOffset, &sumUpper);
+    }
+
+    if (retval == XLNX_OK)
+    {
+        pSummary->totalLatency = ((uint64_t)sumUpper << 32) | sumLower;
+    }
+
+    return retval;
+}
+
+
+
+
+
+
+uint32_t FeedHandler::ReadLatencyHistogram(bool bIngress, LatencyHistogram* pHistogram)
+{
+    uint32_t retval = XLNX_OK;
+    uint32_t control = 0;
+    uint32_t mask = XLNX_FEED_HANDLER_LATENCY_BIN_SELECT_MASK << XLNX_FEED_HANDLER_LATENCY_BIN_SELECT_SHIFT;
+    uint64_t binOffset = XLNX_FEED_HANDLER_STATS_LATENCY_BIN_OFFSET;
+    LatencySummary summary;
+    uint32_t value;
+    uint32_t i;
+
+    if (bIngress)
+    {
+        binOffset = XLNX_FEED_HANDLER_STATS_INGRESS_LATENCY_BIN_OFFSET;
+    }
+
+    retval = CheckIsInitialised();
+
+    if (retval == XLNX_OK)
+    {
+        retval = ReadReg32(XLNX_FEED_HANDLER_LATENCY_CONTROL_OFFSET, &control);
+    }
+
+    if (retval == XLNX_OK)
+    {
+        pHistogram->binShift = control & XLNX_FEED_HANDLER_LATENCY_BIN_SHIFT_MASK;
+
+        retval = ReadLatencySummary(bIngress, &summary);
+    }
+
+    if (retval == XLNX_OK)
+    {
+        pHistogram->numSamples = summary.numSamples;
+        pHistogram->minLatency = summary.minLatency;
+        pHistogram->maxLatency = summary.maxLatency;
+        pHistogram->totalLatency = summary.totalLatency;
+    }
+
+    //the bins share a single status register per probe, each is selected in turn via the control register
+    for (i = 0; (i < XLNX_FEED_HANDLER_NUM_LATENCY_BINS) && (retval == XLNX_OK); i++)
+    {
+        value = i << XLNX_FEED_HANDLER_LATENCY_BIN_SELECT_SHIFT;
+
+        retval = WriteRegWithMask32(XLNX_FEED_HANDLER_LATENCY_CONTROL_OFFSET, value, mask);
+
+        if (retval == XLNX_OK)
+        {
+            retval = ReadReg32(binOffset, &pHistogram->bins[i]);
+        }
+    }
+
+    return retval;
+}
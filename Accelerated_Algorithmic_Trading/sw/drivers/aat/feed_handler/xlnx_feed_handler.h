@@ -22,9 +22,11 @@
 #include <cstdint>
 
 #include "xlnx_device_interface.h"
+#include "xlnx_telemetry_register_snapshot.h"
 
 
 #include "xlnx_feed_handler_error_codes.h"
+#include "xlnx_feed_handler_address_map.h"
 
 
 
@@ -124,6 +126,15 @@ public: //Capture Data
 
 public: //Stats
 
+    //Summary of one latency probe, see the Latency section below
+    typedef struct
+    {
+        uint32_t numSamples;
+        uint32_t minLatency;
+        uint32_t maxLatency;
+        uint64_t totalLatency;              //sum of all samples, mean is totalLatency / numSamples
+    }LatencySummary;
+
 	typedef struct
 	{
 		uint64_t numProcessedBytes;				// Number of UDP payload bytes forwarded.
@@ -133,6 +144,8 @@ public: //Stats
 		uint32_t numTxOrderBookOperations;		// Number of Order Book operations sent.
 		uint32_t numClockTickEvents;			// Number of events received from clock tick generator block
 
+        LatencySummary egressLatency;       //wire to leaving this kernel
+        LatencySummary ingressLatency;      //wire to entering this kernel
 	} Stats;
 
 	uint32_t GetStats(Stats* pStats);
@@ -150,6 +163,47 @@ public:
 
 
 
+public: //Latency
+
+    //Cycles from packet arrival at the LineHandler port filter to the order book operation forwarded to the OrderBook,
+    //collected in a histogram of XLNX_FEED_HANDLER_NUM_LATENCY_BINS bins each (1 << binShift) cycles wide,
+    //the last bin also holds any sample beyond the histogram range.
+    //Samples are taken against this kernel's own time base, which is not synchronised with the LineHandler time base
+    //that stamped the packet, so both histograms carry the same unknown offset and only their difference is meaningful.
+    //The ingress histogram covers the same cycles up to the point the packet is taken in by the UDP packet handler,
+    //so the difference of the two means approximates the time spent inside this kernel, to within the few cycles
+    //either probe may read the kernel time base late and any difference in the messages the two probes sample
+    typedef struct
+    {
+        uint32_t numSamples;
+        uint32_t minLatency;
+        uint32_t maxLatency;
+        uint64_t totalLatency;              //sum of all samples, mean is totalLatency / numSamples
+        uint32_t binShift;
+        uint32_t bins[XLNX_FEED_HANDLER_NUM_LATENCY_BINS];
+    }LatencyHistogram;
+
+    uint32_t SetLatencyBinShift(uint32_t binShift);
+    uint32_t GetLatencyHistogram(LatencyHistogram* pHistogram);
+    uint32_t GetIngressLatencyHistogram(LatencyHistogram* pHistogram);
+    uint32_t ResetLatencyHistogram(void);
+
+
+
+
+
+public: //Telemetry
+    //While pTelemetry is sampling, GetStats takes the registers covered by its blocks from the latest
+    //snapshot instead of the device.  NULL (the default) always reads the device.
+    uint32_t SetTelemetry(Telemetry* pTelemetry);
+
+
+
+
+
+
+
+
 public:
     void IsInitialised(bool* pbIsInitialised);
 	uint32_t GetCUAddress(uint64_t* pCUAddress);
@@ -166,6 +220,9 @@ public:
 
 protected:
 	uint32_t CheckIsInitialised(void);
+
+    uint32_t ReadLatencySummary(bool bIngress, LatencySummary* pSummary, TelemetryRegisterSnapshot* pSnapshot = nullptr);
+    uint32_t ReadLatencyHistogram(bool bIngress, LatencyHistogram* pHistogram);
 	uint32_t CheckSecurityIndex(uint32_t index);
 	uint32_t CheckSecurityID(uint32_t securityID);
 
@@ -188,6 +245,8 @@ protected:
 
 protected:
 	uint32_t ReadReg32(uint64_t offset, uint32_t* value);
+	//from pSnapshot if it covers the register, otherwise from the device
+	uint32_t ReadStatsReg32(TelemetryRegisterSnapshot* pSnapshot, uint64_t offset, uint32_t* value);
 	uint32_t WriteReg32(uint64_t offset, uint32_t value);
 	uint32_t WriteRegWithMask32(uint64_t offset, uint32_t value, uint32_t mask);
 	uint32_t BlockReadReg32(uint64_t offset, uint32_t* buffer, uint32_t numWords);
@@ -200,6 +259,7 @@ protected:
 	uint64_t m_cuAddress;
 	uint32_t m_cuIndex;
 	DeviceInterface* m_pDeviceInterface;
+	Telemetry* m_pTelemetry;
 
 
 protected: //cache
@@ -63,6 +63,29 @@
 
 
 
+/* Wire-to-stage latency histograms at stage egress and ingress, see hw/common/include/aat_latency.hpp */
+#define XLNX_FEED_HANDLER_LATENCY_CONTROL_OFFSET                    (0x00000020)
+#define XLNX_FEED_HANDLER_STATS_LATENCY_COUNT_OFFSET                (0x00000500)
+#define XLNX_FEED_HANDLER_STATS_LATENCY_MIN_OFFSET                  (0x00000510)
+#define XLNX_FEED_HANDLER_STATS_LATENCY_MAX_OFFSET                  (0x00000520)
+#define XLNX_FEED_HANDLER_STATS_LATENCY_BIN_OFFSET                  (0x00000530)
+#define XLNX_FEED_HANDLER_STATS_LATENCY_SUM_LOWER_OFFSET            (0x00000540)
+#define XLNX_FEED_HANDLER_STATS_LATENCY_SUM_UPPER_OFFSET            (0x00000550)
+#define XLNX_FEED_HANDLER_STATS_INGRESS_LATENCY_COUNT_OFFSET        (0x00000560)
+#define XLNX_FEED_HANDLER_STATS_INGRESS_LATENCY_MIN_OFFSET          (0x00000570)
+#define XLNX_FEED_HANDLER_STATS_INGRESS_LATENCY_MAX_OFFSET          (0x00000580)
+#define XLNX_FEED_HANDLER_STATS_INGRESS_LATENCY_BIN_OFFSET          (0x00000590)
+#define XLNX_FEED_HANDLER_STATS_INGRESS_LATENCY_SUM_LOWER_OFFSET    (0x000005A0)
+#define XLNX_FEED_HANDLER_STATS_INGRESS_LATENCY_SUM_UPPER_OFFSET    (0x000005B0)
+
+#define XLNX_FEED_HANDLER_NUM_LATENCY_BINS                          (16)
+#define XLNX_FEED_HANDLER_LATENCY_BIN_SHIFT_MASK                    (0x1F)
+#define XLNX_FEED_HANDLER_LATENCY_BIN_SELECT_SHIFT                  (8)
+#define XLNX_FEED_HANDLER_LATENCY_BIN_SELECT_MASK                   (0x0F)
+#define XLNX_FEED_HANDLER_LATENCY_RESET_SHIFT                       (31)
+
+
+
 #endif
 
 
@@ -30,6 +30,7 @@
 #define XLNX_FEED_HANDLER_ERROR_SECURITY_INDEX_OUT_OF_RANGE         (0x00000007)
 #define XLNX_FEED_HANDLER_ERROR_NO_SECURITY_AT_SPECIFIED_INDEX      (0x00000008)
 #define XLNX_FEED_HANDLER_ERROR_INVALID_SECURITY_ID                 (0x00000009)
+#define XLNX_FEED_HANDLER_ERROR_INVALID_PARAMETER                   (0x0000000A)
 
 
 
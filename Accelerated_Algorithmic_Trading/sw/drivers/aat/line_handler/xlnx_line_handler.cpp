@@ -29,6 +29,7 @@ static const uint32_t IS_INITIALISED_MAGIC_NUMBER = 0x19CAA610;
 LineHandler::LineHandler()
 {
     m_pDeviceInterface = nullptr;
+    m_pTelemetry = nullptr;
     m_cuAddress = 0;
     m_cuIndex = 0;
     m_initialisedMagicNumber = 0;
@@ -116,6 +117,18 @@ uint32_t LineHandler::CheckIsInitialised(void)
 
 
 
+uint32_t LineHandler::SetTelemetry(Telemetry* pTelemetry)
+{
+    m_pTelemetry = pTelemetry;
+
+    return XLNX_OK;
+}
+
+
+
+
+
+
 void LineHandler::IsInitialised(bool* pbIsInitialised)
 {
     if (CheckIsInitialised() == XLNX_OK)
@@ -193,6 +206,23 @@ uint32_t LineHandler::ReadReg32(uint64_t offset, uint32_t* value)
 
 
 
+uint32_t LineHandler::ReadStatsReg32(TelemetryRegisterSnapshot* pSnapshot, uint64_t offset, uint32_t* value)
+{
+    uint32_t retval = XLNX_OK;
+
+    if ((pSnapshot == nullptr) || (pSnapshot->ReadReg32(m_cuAddress + offset, value) != XLNX_OK))
+    {
+        retval = ReadReg32(offset, value);
+    }
+
+    return retval;
+}
+
+
+
+
+
+
 uint32_t LineHandler::WriteReg32(uint64_t offset, uint32_t value)
 {
     uint32_t retval = XLNX_OK;
@@ -501,27 +531,34 @@ uint32_t LineHandler::GetEchoDestination(uint32_t inputPort, uint8_t* ipAddrA, u
 uint32_t LineHandler::GetStats(Stats* pStats)
 {
     uint32_t retval = XLNX_OK;
+    TelemetryRegisterSnapshot snapshot;
 
     memset(pStats, 0, sizeof(*pStats));
 
     retval = CheckIsInitialised();
 
+    if (retval == XLNX_OK)
+    {
+        //no snapshot (sampling stopped or no telemetry set) just means every register is read from the device
+        snapshot.Load(m_pTelemetry);
+    }
+
 
 
 
     if (retval == XLNX_OK)
     {
-        retval = m_pDeviceInterface->ReadReg32(m_cuAddress + XLNX_LINE_HANDLER_STATS_RX_WORDS_COUNT_0_OFFSET, &pStats->inputPortStats[0].numRxWords);
+        retval = ReadStatsReg32(&snapshot, XLNX_LINE_HANDLER_STATS_RX_WORDS_COUNT_0_OFFSET, &pStats->inputPortStats[0].numRxWords);
     }
 
     if (retval == XLNX_OK)
     {
-        retval = m_pDeviceInterface->ReadReg32(m_cuAddress + XLNX_LINE_HANDLER_STATS_RX_META_COUNT_0_OFFSET, &pStats->inputPortStats[0].numRxMeta);
+        retval = ReadStatsReg32(&snapshot, XLNX_LINE_HANDLER_STATS_RX_META_COUNT_0_OFFSET, &pStats->inputPortStats[0].numRxMeta);
     }
 
     if (retval == XLNX_OK)
     {
-        retval = m_pDeviceInterface->ReadReg32(m_cuAddress + XLNX_LINE_HANDLER_STATS_DROPPED_WORDS_COUNT_0_OFFSET, &pStats->inputPortStats[0].numDroppedWords);
+        retval = ReadStatsReg32(&snapshot, XLNX_LINE_HANDLER_STATS_DROPPED_WORDS_COUNT_0_OFFSET, &pStats->inputPortStats[0].numDroppedWords);
     }
 
 
@@ -531,34 +568,34 @@ uint32_t LineHandler::GetStats(Stats* pStats)
 
     if (retval == XLNX_OK)
     {
-        retval = m_pDeviceInterface->ReadReg32(m_cuAddress + XLNX_LINE_HANDLER_STATS_RX_WORDS_COUNT_1_OFFSET, &pStats->inputPortStats[1].numRxWords);
+        retval = ReadStatsReg32(&snapshot, XLNX_LINE_HANDLER_STATS_RX_WORDS_COUNT_1_OFFSET, &pStats->inputPortStats[1].numRxWords);
     }
 
     if (retval == XLNX_OK)
     {
-        retval = m_pDeviceInterface->ReadReg32(m_cuAddress + XLNX_LINE_HANDLER_STATS_RX_META_COUNT_1_OFFSET, &pStats->inputPortStats[1].numRxMeta);
+        retval = ReadStatsReg32(&snapshot, XLNX_LINE_HANDLER_STATS_RX_META_COUNT_1_OFFSET, &pStats->inputPortStats[1].numRxMeta);
     }
 
     if (retval == XLNX_OK)
     {
-        retval = m_pDeviceInterface->ReadReg32(m_cuAddress + XLNX_LINE_HANDLER_STATS_DROPPED_WORDS_COUNT_1_OFFSET, &pStats->inputPortStats[1].numDroppedWords);
+        retval = ReadStatsReg32(&snapshot, XLNX_LINE_HANDLER_STATS_DROPPED_WORDS_COUNT_1_OFFSET, &pStats->inputPortStats[1].numDroppedWords);
     }
 
 
 
     if (retval == XLNX_OK)
     {
-        retval = m_pDeviceInterface->ReadReg32(m_cuAddress + XLNX_LINE_HANDLER_STATS_TOTAL_PACKETS_SENT_COUNT_OFFSET, &pStats->totalPacketsSent);
+        retval = ReadStatsReg32(&snapshot, XLNX_LINE_HANDLER_STATS_TOTAL_PACKETS_SENT_COUNT_OFFSET, &pStats->totalPacketsSent);
     }
 
     if (retval == XLNX_OK)
     {
-        retval = m_pDeviceInterface->ReadReg32(m_cuAddress + XLNX_LINE_HANDLER_STATS_TOTAL_WORDS_SENT_COUNT_OFFSET, &pStats->totalWordsSent);
+        retval = ReadStatsReg32(&snapshot, XLNX_LINE_HANDLER_STATS_TOTAL_WORDS_SENT_COUNT_OFFSET, &pStats->totalWordsSent);
     }
 
     if (retval == XLNX_OK)
     {
-        retval = m_pDeviceInterface->ReadReg32(m_cuAddress + XLNX_LINE_HANDLER_STATS_TOTAL_PACKETS_MISSED_COUNT_OFFSET, &pStats->totalPacketsMissed);
+        retval = ReadStatsReg32(&snapshot, XLNX_LINE_HANDLER_STATS_TOTAL_PACKETS_MISSED_COUNT_OFFSET, &pStats->totalPacketsMissed);
     }
 
 
@@ -569,12 +606,12 @@ uint32_t LineHandler::GetStats(Stats* pStats)
 
     if (retval == XLNX_OK)
     {
-        retval = m_pDeviceInterface->ReadReg32(m_cuAddress + XLNX_LINE_HANDLER_STATS_RX_PACKETS_COUNT_0_OFFSET, &pStats->inputPortStats[0].numRxPackets);
+        retval = ReadStatsReg32(&snapshot, XLNX_LINE_HANDLER_STATS_RX_PACKETS_COUNT_0_OFFSET, &pStats->inputPortStats[0].numRxPackets);
     }
 
     if (retval == XLNX_OK)
     {
-        retval = m_pDeviceInterface->ReadReg32(m_cuAddress + XLNX_LINE_HANDLER_STATS_RX_PACKETS_COUNT_1_OFFSET, &pStats->inputPortStats[1].numRxPackets);
+        retval = ReadStatsReg32(&snapshot, XLNX_LINE_HANDLER_STATS_RX_PACKETS_COUNT_1_OFFSET, &pStats->inputPortStats[1].numRxPackets);
     }
 
 
@@ -583,12 +620,12 @@ uint32_t LineHandler::GetStats(Stats* pStats)
 
     if (retval == XLNX_OK)
     {
-        retval = m_pDeviceInterface->ReadReg32(m_cuAddress + XLNX_LINE_HANDLER_STATS_ARBITRATED_TX_PACKETS_COUNT_0_OFFSET, &pStats->inputPortStats[0].numArbitratedTxPackets);
+        retval = ReadStatsReg32(&snapshot, XLNX_LINE_HANDLER_STATS_ARBITRATED_TX_PACKETS_COUNT_0_OFFSET, &pStats->inputPortStats[0].numArbitratedTxPackets);
     }
 
     if (retval == XLNX_OK)
     {
-        retval = m_pDeviceInterface->ReadReg32(m_cuAddress + XLNX_LINE_HANDLER_STATS_ARBITRATED_TX_PACKETS_COUNT_1_OFFSET, &pStats->inputPortStats[1].numArbitratedTxPackets);
+        retval = ReadStatsReg32(&snapshot, XLNX_LINE_HANDLER_STATS_ARBITRATED_TX_PACKETS_COUNT_1_OFFSET, &pStats->inputPortStats[1].numArbitratedTxPackets);
     }
 
 
@@ -597,12 +634,12 @@ uint32_t LineHandler::GetStats(Stats* pStats)
 
     if (retval == XLNX_OK)
     {
-        retval = m_pDeviceInterface->ReadReg32(m_cuAddress + XLNX_LINE_HANDLER_STATS_DISCARDED_PACKETS_COUNT_0_OFFSET, &pStats->inputPortStats[0].numDiscardedPackets);
+        retval = ReadStatsReg32(&snapshot, XLNX_LINE_HANDLER_STATS_DISCARDED_PACKETS_COUNT_0_OFFSET, &pStats->inputPortStats[0].numDiscardedPackets);
     }
 
     if (retval == XLNX_OK)
     {
-        retval = m_pDeviceInterface->ReadReg32(m_cuAddress + XLNX_LINE_HANDLER_STATS_DISCARDED_PACKETS_COUNT_1_OFFSET, &pStats->inputPortStats[1].numDiscardedPackets);
+        retval = ReadStatsReg32(&snapshot, XLNX_LINE_HANDLER_STATS_DISCARDED_PACKETS_COUNT_1_OFFSET, &pStats->inputPortStats[1].numDiscardedPackets);
     }
 
 
@@ -611,11 +648,21 @@ uint32_t LineHandler::GetStats(Stats* pStats)
 
     if (retval == XLNX_OK)
     {
-        retval = m_pDeviceInterface->ReadReg32(m_cuAddress + XLNX_LINE_HANDLER_STATS_CLOCK_TICK_EVENTS_COUNT_OFFSET, &pStats->clockTickEvents);
+        retval = ReadStatsReg32(&snapshot, XLNX_LINE_HANDLER_STATS_CLOCK_TICK_EVENTS_COUNT_OFFSET, &pStats->clockTickEvents);
     }
 
 
 
+    if (retval == XLNX_OK)
+    {
+        retval = ReadLatencySummary(false, &pStats->egressLatency, &snapshot);
+    }
+
+    if (retval == XLNX_OK)
+    {
+        retval = ReadLatencySummary(true, &pStats->ingressLatency, &snapshot);
+    }
+
     return retval;
     
 }
@@ -1093,3 +1140,201 @@ uint32_t LineHandler::GetFilterDetails(uint32_t inputPort, uint32_t index, uint8
 }
 
 
+
+
+
+
+uint32_t LineHandler::SetLatencyBinShift(uint32_t binShift)
+{
+    uint32_t retval = XLNX_OK;
+    uint32_t mask = XLNX_LINE_HANDLER_LATENCY_BIN_SHIFT_MASK;
+
+    retval = CheckIsInitialised();
+
+    if (retval == XLNX_OK)
+    {
+        if (binShift > XLNX_LINE_HANDLER_LATENCY_BIN_SHIFT_MASK)
+        {
+            retval = XLNX_LINE_HANDLER_ERROR_INVALID_PARAMETER;
+        }
+    }
+
+    if (retval == XLNX_OK)
+    {
+        retval = WriteRegWithMask32(XLNX_LINE_HANDLER_LATENCY_CONTROL_OFFSET, binShift, mask);
+    }
+
+    return retval;
+}
+
+
+
+
+
+
+uint32_t LineHandler::GetLatencyHistogram(LatencyHistogram* pHistogram)
+{
+    return ReadLatencyHistogram(false, pHistogram);
+}
+
+
+
+
+
+
+uint32_t LineHandler::GetIngressLatencyHistogram(LatencyHistogram* pHistogram)
+{
+    return ReadLatencyHistogram(true, pHistogram);
+}
+
+
+
+
+
+uint32_t LineHandler::ResetLatencyHistogram(void)
+{
+    uint32_t retval = XLNX_OK;
+    uint32_t shift = XLNX_LINE_HANDLER_LATENCY_RESET_SHIFT;
+    uint32_t mask = 0x01;
+    uint32_t value;
+
+    retval = CheckIsInitialised();
+
+    if (retval == XLNX_OK)
+    {
+        mask = mask << shift;
+
+        value = 1;
+        value = value << shift;
+
+        retval = WriteRegWithMask32(XLNX_LINE_HANDLER_LATENCY_CONTROL_OFFSET, value, mask);
+    }
+
+    if (retval == XLNX_OK)
+    {
+        value = 0;
+        value = value << shift;
+        retval = WriteRegWithMask32(XLNX_LINE_HANDLER_LATENCY_CONTROL_OFFSET, value, mask);
+    }
+
+    return retval;
+}
+
+
+
+
+
+
+
+uint32_t LineHandler::ReadLatencySummary(bool bIngress, LatencySummary* pSummary, TelemetryRegisterSnapshot* pSnapshot)
+{
+    uint32_t retval = XLNX_OK;
+    uint64_t countOffset = XLNX_LINE_HANDLER_STATS_LATENCY_COUNT_OFFSET;
+    uint64_t minOffset = XLNX_LINE_HANDLER_STATS_LATENCY_MIN_OFFSET;
+    uint64_t maxOffset = XLNX_LINE_HANDLER_STATS_LATENCY_MAX_OFFSET;
+    uint64_t sumLowerOffset = XLNX_LINE_HANDLER_STATS_LATENCY_SUM_LOWER_OFFSET;
+    uint64_t sumUpperOffset = XLNX_LINE_HANDLER_STATS_LATENCY_SUM_UPPER_OFFSET;
+    uint32_t sumLower = 0;
+    uint32_t sumUpper = 0;
+
+    if (bIngress)
+    {
+        countOffset = XLNX_LINE_HANDLER_STATS_INGRESS_LATENCY_COUNT_OFFSET;
+        minOffset = XLNX_LINE_HANDLER_STATS_INGRESS_LATENCY_MIN_OFFSET;
+        maxOffset = XLNX_LINE_HANDLER_STATS_INGRESS_LATENCY_MAX_OFFSET;
+        sumLowerOffset = XLNX_LINE_HANDLER_STATS_INGRESS_LATENCY_SUM_LOWER_OFFSET;
+        sumUpperOffset = XLNX_LINE_HANDLER_STATS_INGRESS_LATENCY_SUM_UPPER_OFFSET;
+    }
+
+    retval = CheckIsInitialised();
+
+    if (retval == XLNX_OK)
+    {
+        retval = ReadStatsReg32(pSnapshot, countOffset, &pSummary->numSamples);
+    }
+
+    if (retval == XLNX_OK)
+    {
+        retval = ReadStatsReg32(pSnapshot, minOffset, &pSummary->minLatency);
+    }
+
+    if (retval == XLNX_OK)
+    {
+        retval = ReadStatsReg32(pSnapshot, maxOffset, &pSummary->maxLatency);
+    }
+
+    if (retval == XLNX_OK)
+    {
+        retval = ReadStatsReg32(pSnapshot, sumLowerOffset, &sumLower);
+    }
+
+    if (retval == XLNX_OK)
+    {
+        retval = ReadStatsReg32(pSnapshot, sumUpperOffset, &sumUpper);
+    }
+
+    if (retval == XLNX_OK)
+    {
+        pSummary->totalLatency = ((uint64_t)sumUpper << 32) | sumLower;
+    }
+
+    return retval;
+}
+
+
+
+
+
+
+uint32_t LineHandler::ReadLatencyHistogram(bool bIngress, LatencyHistogram* pHistogram)
+{
+    uint32_t retval = XLNX_OK;
+    uint32_t control = 0;
+    uint32_t mask = XLNX_LINE_HANDLER_LATENCY_BIN_SELECT_MASK << XLNX_LINE_HANDLER_LATENCY_BIN_SELECT_SHIFT;
+    uint64_t binOffset = XLNX_LINE_HANDLER_STATS_LATENCY_BIN_OFFSET;
+    LatencySummary summary;
+    uint32_t value;
+    uint32_t i;
+
+    if (bIngress)
+    {
+        binOffset = XLNX_LINE_HANDLER_STATS_INGRESS_LATENCY_BIN_OFFSET;
+    }
+
+    retval = CheckIsInitialised();
+
+    if (retval == XLNX_OK)
+    {
+        retval = ReadReg32(XLNX_LINE_HANDLER_LATENCY_CONTROL_OFFSET, &control);
+    }
+
+    if (retval == XLNX_OK)
+    {
+        pHistogram->binShift = control & XLNX_LINE_HANDLER_LATENCY_BIN_SHIFT_MASK;
+
+        retval = ReadLatencySummary(bIngress, &summary);
+    }
+
+    if (retval == XLNX_OK)
+    {
+        pHistogram->numSamples = summary.numSamples;
+        pHistogram->minLatency = summary.minLatency;
+        pHistogram->maxLatency = summary.maxLatency;
+        pHistogram->totalLatency = summary.totalLatency;
+    }
+
+    //the bins share a single status register per probe, each is selected in turn via the control register
+    for (i = 0; (i < XLNX_LINE_HANDLER_NUM_LATENCY_BINS) && (retval == XLNX_OK); i++)
+    {
+        value = i << XLNX_LINE_HANDLER_LATENCY_BIN_SELECT_SHIFT;
+
+        retval = WriteRegWithMask32(XLNX_LINE_HANDLER_LATENCY_CONTROL_OFFSET, value, mask);
+
+        if (retval == XLNX_OK)
+        {
+            retval = ReadReg32(binOffset, &pHistogram->bins[i]);
+        }
+    }
+
+    return retval;
+}
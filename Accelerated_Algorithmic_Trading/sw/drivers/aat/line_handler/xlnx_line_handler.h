@@ -22,8 +22,10 @@
 #include <cstdint>
 
 #include "xlnx_device_interface.h"
+#include "xlnx_telemetry_register_snapshot.h"
 
 #include "xlnx_line_handler_error_codes.h"
+#include "xlnx_line_handler_address_map.h"
 
 
 namespace XLNX
@@ -85,6 +87,15 @@ public: //Stats
 
 
 
+    //Summary of one latency probe, see the Latency section below
+    typedef struct
+    {
+        uint32_t numSamples;
+        uint32_t minLatency;
+        uint32_t maxLatency;
+        uint64_t totalLatency;              //sum of all samples, mean is totalLatency / numSamples
+    }LatencySummary;
+
     typedef struct
     {
         InputPortStats inputPortStats[NUM_SUPPORTED_INPUT_PORTS];
@@ -94,6 +105,9 @@ public: //Stats
         uint32_t totalPacketsMissed;
 
         uint32_t clockTickEvents;
+
+        LatencySummary egressLatency;       //wire to leaving this kernel
+        LatencySummary ingressLatency;      //wire to entering this kernel
     }Stats;
 
 
@@ -122,6 +136,45 @@ public: //Debug
 
 
 
+public: //Latency
+
+    //Cycles from packet arrival at the LineHandler port filter to the arbitrated packet forwarded to the FeedHandler,
+    //collected in a histogram of XLNX_LINE_HANDLER_NUM_LATENCY_BINS bins each (1 << binShift) cycles wide,
+    //the last bin also holds any sample beyond the histogram range.
+    //The ingress histogram covers the same cycles up to the point the packet is taken from the port filter FIFO by the arbitrator,
+    //so the difference of the two means approximates the time spent inside this kernel, to within the few cycles
+    //either probe may read the kernel time base late and any difference in the messages the two probes sample
+    typedef struct
+    {
+        uint32_t numSamples;
+        uint32_t minLatency;
+        uint32_t maxLatency;
+        uint64_t totalLatency;              //sum of all samples, mean is totalLatency / numSamples
+        uint32_t binShift;
+        uint32_t bins[XLNX_LINE_HANDLER_NUM_LATENCY_BINS];
+    }LatencyHistogram;
+
+    uint32_t SetLatencyBinShift(uint32_t binShift);
+    uint32_t GetLatencyHistogram(LatencyHistogram* pHistogram);
+    uint32_t GetIngressLatencyHistogram(LatencyHistogram* pHistogram);
+    uint32_t ResetLatencyHistogram(void);
+
+
+
+
+
+public: //Telemetry
+    //While pTelemetry is sampling, GetStats takes the registers covered by its blocks from the latest
+    //snapshot instead of the device.  NULL (the default) always reads the device.
+    uint32_t SetTelemetry(Telemetry* pTelemetry);
+
+
+
+
+
+
+
+
 public:
     void IsInitialised(bool* pbIsInitialised);
 
@@ -134,11 +187,16 @@ public:
 protected:
     uint32_t CheckIsInitialised(void);
 
+    uint32_t ReadLatencySummary(bool bIngress, LatencySummary* pSummary, TelemetryRegisterSnapshot* pSnapshot = nullptr);
+    uint32_t ReadLatencyHistogram(bool bIngress, LatencyHistogram* pHistogram);
+
 
 
 
 protected:
     uint32_t ReadReg32(uint64_t offset, uint32_t* value);
+    //from pSnapshot if it covers the register, otherwise from the device
+    uint32_t ReadStatsReg32(TelemetryRegisterSnapshot* pSnapshot, uint64_t offset, uint32_t* value);
     uint32_t WriteReg32(uint64_t offset, uint32_t value);
     uint32_t WriteRegWithMask32(uint64_t offset, uint32_t value, uint32_t mask);
     uint32_t BlockReadReg32(uint64_t offset, uint32_t* buffer, uint32_t numWords);
@@ -175,6 +233,7 @@ protected:
     uint64_t m_cuAddress;
     uint32_t m_cuIndex;
     DeviceInterface* m_pDeviceInterface;
+    Telemetry* m_pTelemetry;
 
     uint32_t m_clockFrequencyMHz;
 };
@@ -90,5 +90,28 @@
 
 
 
+/* Wire-to-stage latency histograms at stage egress and ingress, see hw/common/include/aat_latency.hpp */
+#define XLNX_LINE_HANDLER_LATENCY_CONTROL_OFFSET                    (0x00000310)
+#define XLNX_LINE_HANDLER_STATS_LATENCY_COUNT_OFFSET                (0x00000318)
+#define XLNX_LINE_HANDLER_STATS_LATENCY_MIN_OFFSET                  (0x00000328)
+#define XLNX_LINE_HANDLER_STATS_LATENCY_MAX_OFFSET                  (0x00000338)
+#define XLNX_LINE_HANDLER_STATS_LATENCY_BIN_OFFSET                  (0x00000348)
+#define XLNX_LINE_HANDLER_STATS_LATENCY_SUM_LOWER_OFFSET            (0x00000358)
+#define XLNX_LINE_HANDLER_STATS_LATENCY_SUM_UPPER_OFFSET            (0x00000368)
+#define XLNX_LINE_HANDLER_STATS_INGRESS_LATENCY_COUNT_OFFSET        (0x00000378)
+#define XLNX_LINE_HANDLER_STATS_INGRESS_LATENCY_MIN_OFFSET          (0x00000388)
+#define XLNX_LINE_HANDLER_STATS_INGRESS_LATENCY_MAX_OFFSET          (0x00000398)
+#define XLNX_LINE_HANDLER_STATS_INGRESS_LATENCY_BIN_OFFSET          (0x000003A8)
+#define XLNX_LINE_HANDLER_STATS_INGRESS_LATENCY_SUM_LOWER_OFFSET    (0x000003B8)
+#define XLNX_LINE_HANDLER_STATS_INGRESS_LATENCY_SUM_UPPER_OFFSET    (0x000003C8)
+
+#define XLNX_LINE_HANDLER_NUM_LATENCY_BINS                          (16)
+#define XLNX_LINE_HANDLER_LATENCY_BIN_SHIFT_MASK                    (0x1F)
+#define XLNX_LINE_HANDLER_LATENCY_BIN_SELECT_SHIFT                  (8)
+#define XLNX_LINE_HANDLER_LATENCY_BIN_SELECT_MASK                   (0x0F)
+#define XLNX_LINE_HANDLER_LATENCY_RESET_SHIFT                       (31)
+
+
+
 #endif
 
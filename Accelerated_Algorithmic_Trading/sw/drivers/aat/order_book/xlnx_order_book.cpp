@@ -29,6 +29,7 @@ static const uint32_t IS_INITIALISED_MAGIC_NUMBER = 0x4362AA5B;
 OrderBook::OrderBook()
 {
 	m_pDeviceInterface = nullptr;
+	m_pTelemetry = nullptr;
 
 	m_cuIndex = 0xFFFFFFFF;
 	m_cuAddress = 0;
@@ -121,6 +122,18 @@ uint32_t OrderBook::CheckIsInitialised(void)
 
 
 
+uint32_t OrderBook::SetTelemetry(Telemetry* pTelemetry)
+{
+    m_pTelemetry = pTelemetry;
+
+    return XLNX_OK;
+}
+
+
+
+
+
+
 void OrderBook::IsInitialised(bool* pbIsInitialised)
 {
     if (CheckIsInitialised() == XLNX_OK)
@@ -417,6 +430,23 @@ uint32_t OrderBook::ReadReg32(uint64_t offset, uint32_t* value)
 
 
 
+uint32_t OrderBook::ReadStatsReg32(TelemetryRegisterSnapshot* pSnapshot, uint64_t offset, uint32_t* value)
+{
+    uint32_t retval = XLNX_OK;
+
+    if ((pSnapshot == nullptr) || (pSnapshot->ReadReg32(m_cuAddress + offset, value) != XLNX_OK))
+    {
+        retval = ReadReg32(offset, value);
+    }
+
+    return retval;
+}
+
+
+
+
+
+
 uint32_t OrderBook::WriteReg32(uint64_t offset, uint32_t value)
 {
 	uint32_t retval = XLNX_OK;
@@ -504,96 +534,116 @@ uint32_t OrderBook::BlockReadMem32(uint64_t address, uint32_t* buffer, uint32_t
 uint32_t OrderBook::GetStats(OrderBook::Stats* pStats)
 {
     uint32_t retval = XLNX_OK;
+    TelemetryRegisterSnapshot snapshot;
+    bool bFromSnapshot = false;
  
     retval = CheckIsInitialised();
 
     if (retval == XLNX_OK)
+    {
+        //no snapshot (sampling stopped or no telemetry set) just means every register is read from the device
+        snapshot.Load(m_pTelemetry);
+        snapshot.IsLoaded(&bFromSnapshot);
+    }
+
+    //a snapshot is already a consistent set of counters, the device only needs freezing when read directly
+    if ((retval == XLNX_OK) && (bFromSnapshot == false))
     {
         retval = FreezeStats();
     }
 
     if (retval == XLNX_OK)
     {
-        retval = m_pDeviceInterface->ReadReg32(m_cuAddress + XLNX_ORDER_BOOK_STATS_RX_OPERATIONS_COUNT_OFFSET, &pStats->numRxOperations);
+        retval = ReadStatsReg32(&snapshot, XLNX_ORDER_BOOK_STATS_RX_OPERATIONS_COUNT_OFFSET, &pStats->numRxOperations);
     }
 
     if (retval == XLNX_OK)
     {
-        retval = m_pDeviceInterface->ReadReg32(m_cuAddress + XLNX_ORDER_BOOK_STATS_PROCESS_OPERATIONS_COUNT_OFFSET, &pStats->numProcessedOperations);
+        retval = ReadStatsReg32(&snapshot, XLNX_ORDER_BOOK_STATS_PROCESS_OPERATIONS_COUNT_OFFSET, &pStats->numProcessedOperations);
     }
 
     if (retval == XLNX_OK)
     {
-        retval = m_pDeviceInterface->ReadReg32(m_cuAddress + XLNX_ORDER_BOOK_STATS_INVALID_OPERATIONS_COUNT_OFFSET, &pStats->numInvalidOperations);
+        retval = ReadStatsReg32(&snapshot, XLNX_ORDER_BOOK_STATS_INVALID_OPERATIONS_COUNT_OFFSET, &pStats->numInvalidOperations);
     }
 
     if (retval == XLNX_OK)
     {
-        retval = m_pDeviceInterface->ReadReg32(m_cuAddress + XLNX_ORDER_BOOK_RESPONSES_GENERATED_COUNT_OFFSET, &pStats->numResponsesGenerated);
+        retval = ReadStatsReg32(&snapshot, XLNX_ORDER_BOOK_RESPONSES_GENERATED_COUNT_OFFSET, &pStats->numResponsesGenerated);
     }
 
     if (retval == XLNX_OK)
     {
-        retval = m_pDeviceInterface->ReadReg32(m_cuAddress + XLNX_ORDER_BOOK_RESPONSE_SENT_COUNT_OFFSET, &pStats->numResponsesSent);
+        retval = ReadStatsReg32(&snapshot, XLNX_ORDER_BOOK_RESPONSE_SENT_COUNT_OFFSET, &pStats->numResponsesSent);
     }
 
     if (retval == XLNX_OK)
     {
-        retval = m_pDeviceInterface->ReadReg32(m_cuAddress + XLNX_ORDER_BOOK_ADD_OPERATIONS_COUNT_OFFSET, &pStats->numAddOperations);
+        retval = ReadStatsReg32(&snapshot, XLNX_ORDER_BOOK_ADD_OPERATIONS_COUNT_OFFSET, &pStats->numAddOperations);
     }
 
     if (retval == XLNX_OK)
     {
-        retval = m_pDeviceInterface->ReadReg32(m_cuAddress + XLNX_ORDER_BOOK_MODIFY_OPERATIONS_COUNT_OFFSET, &pStats->numModifyOperations);
+        retval = ReadStatsReg32(&snapshot, XLNX_ORDER_BOOK_MODIFY_OPERATIONS_COUNT_OFFSET, &pStats->numModifyOperations);
     }
 
     if (retval == XLNX_OK)
     {
-        retval = m_pDeviceInterface->ReadReg32(m_cuAddress + XLNX_ORDER_BOOK_DELETE_OPERATIONS_COUNT_OFFSET, &pStats->numDeleteOperations);
+        retval = ReadStatsReg32(&snapshot, XLNX_ORDER_BOOK_DELETE_OPERATIONS_COUNT_OFFSET, &pStats->numDeleteOperations);
     }
 
     if (retval == XLNX_OK)
     {
-        retval = m_pDeviceInterface->ReadReg32(m_cuAddress + XLNX_ORDER_BOOK_TRANSACT_OPERATIONS_COUNT_OFFSET, &pStats->numTransactOperations);
+        retval = ReadStatsReg32(&snapshot, XLNX_ORDER_BOOK_TRANSACT_OPERATIONS_COUNT_OFFSET, &pStats->numTransactOperations);
     }
 
     if (retval == XLNX_OK)
     {
-        retval = m_pDeviceInterface->ReadReg32(m_cuAddress + XLNX_ORDER_BOOK_HALT_OPERATIONS_COUNT_OFFSET, &pStats->numHaltOperations);
+        retval = ReadStatsReg32(&snapshot, XLNX_ORDER_BOOK_HALT_OPERATIONS_COUNT_OFFSET, &pStats->numHaltOperations);
     }
 
     if (retval == XLNX_OK)
     {
-        retval = m_pDeviceInterface->ReadReg32(m_cuAddress + XLNX_ORDER_BOOK_TIMESTAMP_ERRORS_COUNT_OFFSET, &pStats->numTimestampErrors);
+        retval = ReadStatsReg32(&snapshot, XLNX_ORDER_BOOK_TIMESTAMP_ERRORS_COUNT_OFFSET, &pStats->numTimestampErrors);
     }
 
     if (retval == XLNX_OK)
     {
-        retval = m_pDeviceInterface->ReadReg32(m_cuAddress + XLNX_ORDER_BOOK_UNHANDLED_OP_CODES_COUNT_OFFSET, &pStats->numUnhandledOpCodes);
+        retval = ReadStatsReg32(&snapshot, XLNX_ORDER_BOOK_UNHANDLED_OP_CODES_COUNT_OFFSET, &pStats->numUnhandledOpCodes);
     }
 
     if (retval == XLNX_OK)
     {
-        retval = m_pDeviceInterface->ReadReg32(m_cuAddress + XLNX_ORDER_BOOK_SYMBOL_ERRORS_COUNT_OFFSET, &pStats->numSymbolErrors);
+        retval = ReadStatsReg32(&snapshot, XLNX_ORDER_BOOK_SYMBOL_ERRORS_COUNT_OFFSET, &pStats->numSymbolErrors);
     }
 
     if (retval == XLNX_OK)
     {
-        retval = m_pDeviceInterface->ReadReg32(m_cuAddress + XLNX_ORDER_BOOK_DIRECTION_ERRORS_COUNT_OFFSET, &pStats->numDirectionErrors);
+        retval = ReadStatsReg32(&snapshot, XLNX_ORDER_BOOK_DIRECTION_ERRORS_COUNT_OFFSET, &pStats->numDirectionErrors);
     }
 
     if (retval == XLNX_OK)
     {
-        retval = m_pDeviceInterface->ReadReg32(m_cuAddress + XLNX_ORDER_BOOK_LEVEL_ERRORS_COUNT_OFFSET, &pStats->numLevelErrors);
+        retval = ReadStatsReg32(&snapshot, XLNX_ORDER_BOOK_LEVEL_ERRORS_COUNT_OFFSET, &pStats->numLevelErrors);
     }
 
     if (retval == XLNX_OK)
     {
-        retval = m_pDeviceInterface->ReadReg32(m_cuAddress + XLNX_ORDER_BOOK_CLOCK_TICK_GEN_EVENTS_COUNT_OFFSET, &pStats->numClockTickGeneratorEvents);
+        retval = ReadStatsReg32(&snapshot, XLNX_ORDER_BOOK_CLOCK_TICK_GEN_EVENTS_COUNT_OFFSET, &pStats->numClockTickGeneratorEvents);
     }
 
    
     if (retval == XLNX_OK)
+    {
+        retval = ReadLatencySummary(false, &pStats->egressLatency, &snapshot);
+    }
+
+    if (retval == XLNX_OK)
+    {
+        retval = ReadLatencySummary(true, &pStats->ingressLatency, &snapshot);
+    }
+
+    if ((retval == XLNX_OK) && (bFromSnapshot == false))
     {
         retval = UnfreezeStats();
     }
@@ -819,3 +869,202 @@ uint32_t OrderBook::GetDataMoverOutput(bool* pbEnabled)
     return retval;
 }
 
+
+
+
+
+
+uint32_t OrderBook::SetLatencyBinShift(uint32_t binShift)
+{
+    uint32_t retval = XLNX_OK;
+    uint32_t mask = XLNX_ORDER_BOOK_LATENCY_BIN_SHIFT_MASK;
+
+    retval = CheckIsInitialised();
+
+    if (retval == XLNX_OK)
+    {
+        if (binShift > XLNX_ORDER_BOOK_LATENCY_BIN_SHIFT_MASK)
+        {
+            retval = XLNX_ORDER_BOOK_ERROR_INVALID_PARAMETER;
+        }
+    }
+
+    if (retval == XLNX_OK)
+    {
+        retval = WriteRegWithMask32(XLNX_ORDER_BOOK_LATENCY_CONTROL_OFFSET, binShift, mask);
+    }
+
+    return retval;
+}
+
+
+
+
+
+
+uint32_t OrderBook::GetLatencyHistogram(LatencyHistogram* pHistogram)
+{
+    return ReadLatencyHistogram(false, pHistogram);
+}
+
+
+
+
+
+
+uint32_t OrderBook::GetIngressLatencyHistogram(LatencyHistogram* pHistogram)
+{
+    return ReadLatencyHistogram(true, pHistogram);
+}
+
+
+
+
+
+uint32_t OrderBook::ResetLatencyHistogram(void)
+{
+    uint32_t retval = XLNX_OK;
+    uint32_t shift = XLNX_ORDER_BOOK_LATENCY_RESET_SHIFT;
+    uint32_t mask = 0x01;
+    uint32_t value;
+
+    retval = CheckIsInitialised();
+
+    if (retval == XLNX_OK)
+    {
+        mask = mask << shift;
+
+        value = 1;
+        value = value << shift;
+
+        retval = WriteRegWithMask32(XLNX_ORDER_BOOK_LATENCY_CONTROL_OFFSET, value, mask);
+    }
+
+    if (retval == XLNX_OK)
+    {
+        value = 0;
+        value = value << shift;
+        retval = WriteRegWithMask32(XLNX_ORDER_BOOK_LATENCY_CONTROL_OFFSET, value, mask);
+    }
+
+    return retval;
+}
+
+
+
+
+
+
+
+uint32_t OrderBook::ReadLatencySummary(bool bIngress, LatencySummary* pSummary, TelemetryRegisterSnapshot* pSnapshot)
+{
+    uint32_t retval = XLNX_OK;
+    uint64_t countOffset = XLNX_ORDER_BOOK_STATS_LATENCY_COUNT_OFFSET;
+    uint64_t minOffset = XLNX_ORDER_BOOK_STATS_LATENCY_MIN_OFFSET;
+    uint64_t maxOffset = XLNX_ORDER_BOOK_STATS_LATENCY_MAX_OFFSET;
+    uint64_t sumLowerOffset = XLNX_ORDER_BOOK_STATS_LATENCY_SUM_LOWER_OFFSET;
+    uint64_t sumUpperOffset = XLNX_ORDER_BOOK_STATS_LATENCY_SUM_UPPER_OFFSET;
+    uint32_t sumLower = 0;
+    uint32_t sumUpper = 0;
+
+    if (bIngress)
+    {
+        countOffset = XLNX_ORDER_BOOK_STATS_INGRESS_LATENCY_COUNT_OFFSET;
+        minOffset = XLNX_ORDER_BOOK_STATS_INGRESS_LATENCY_MIN_OFFSET;
+        maxOffset = XLNX_ORDER_BOOK_STATS_INGRESS_LATENCY_MAX_OFFSET;
+        sumLowerOffset = XLNX_ORDER_BOOK_STATS_INGRESS_LATENCY_SUM_LOWER_OFFSET;
+        sumUpperOffset = XLNX_ORDER_BOOK_STATS_INGRESS_LATENCY_SUM_UPPER_OFFSET;
+    }
+
+    retval = CheckIsInitialised();
+
+    if (retval == XLNX_OK)
+    {
+        retval = ReadStatsReg32(pSnapshot, countOffset, &pSummary->numSamples);
+    }
+
+    if (retval == XLNX_OK)
+    {
+        retval = ReadStatsReg32(pSnapshot, minOffset, &pSummary->minLatency);
+    }
+
+    if (retval == XLNX_OK)
+    {
+        retval = ReadStatsReg32(pSnapshot, maxOffset, &pSummary->maxLatency);
+    }
+
+    if (retval == XLNX_OK)
+    {
+        retval = ReadStatsReg32(pSnapshot, sumLowerOffset, &sumLower);
+    }
+
+    if (retval == XLNX_OK)
+    {
+        retval = ReadStatsReg32(pSnapshot, sumUpperOffset, &sumUpper);
+    }
+
+    if (retval == XLNX_OK)
+    {
+        pSummary->totalLatency = ((uint64_t)sumUpper << 32) | sumLower;
+    }
+
+    return retval;
+}
+
+
+
+
+
+
+uint32_t OrderBook::ReadLatencyHistogram(bool bIngress, LatencyHistogram* pHistogram)
+{
+    uint32_t retval = XLNX_OK;
+    uint32_t control = 0;
+    uint32_t mask = XLNX_ORDER_BOOK_LATENCY_BIN_SELECT_MASK << XLNX_ORDER_BOOK_LATENCY_BIN_SELECT_SHIFT;
+    uint64_t binOffset = XLNX_ORDER_BOOK_STATS_LATENCY_BIN_OFFSET;
+    LatencySummary summary;
+    uint32_t value;
+    uint32_t i;
+
+    if (bIngress)
+    {
+        binOffset = XLNX_ORDER_BOOK_STATS_INGRESS_LATENCY_BIN_OFFSET;
+    }
+
+    retval = CheckIsInitialised();
+
+    if (retval == XLNX_OK)
+    {
+        retval = ReadReg32(XLNX_ORDER_BOOK_LATENCY_CONTROL_OFFSET, &control);
+    }
+
+    if (retval == XLNX_OK)
+    {
+        pHistogram->binShift = control & XLNX_ORDER_BOOK_LATENCY_BIN_SHIFT_MASK;
+
+        retval = ReadLatencySummary(bIngress, &summary);
+    }
+
+    if (retval == XLNX_OK)
+    {
+        pHistogram->numSamples = summary.numSamples;
+        pHistogram->minLatency = summary.minLatency;
+        pHistogram->maxLatency = summary.maxLatency;
+        pHistogram->totalLatency = summary.totalLatency;
+    }
+
+    //the bins share a single status register per probe, each is selected in turn via the control register
+    for (i = 0; (i < XLNX_ORDER_BOOK_NUM_LATENCY_BINS) && (retval == XLNX_OK); i++)
+    {
+        value = i << XLNX_ORDER_BOOK_LATENCY_BIN_SELECT_SHIFT;
+
+        retval = WriteRegWithMask32(XLNX_ORDER_BOOK_LATENCY_CONTROL_OFFSET, value, mask);
+
+        if (retval == XLNX_OK)
+        {
+            retval = ReadReg32(binOffset, &pHistogram->bins[i]);
+        }
+    }
+
+    return retval;
+}
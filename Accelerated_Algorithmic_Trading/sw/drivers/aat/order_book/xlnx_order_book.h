@@ -22,8 +22,10 @@
 #include <cstdint>
 
 #include "xlnx_device_interface.h"
+#include "xlnx_telemetry_register_snapshot.h"
 
 #include "xlnx_order_book_error_codes.h"
+#include "xlnx_order_book_address_map.h"
 
 
 
@@ -88,6 +90,15 @@ public:
 
 
 public:
+    //Summary of one latency probe, see the Latency section below
+    typedef struct
+    {
+        uint32_t numSamples;
+        uint32_t minLatency;
+        uint32_t maxLatency;
+        uint64_t totalLatency;              //sum of all samples, mean is totalLatency / numSamples
+    }LatencySummary;
+
     typedef struct
     {
         uint32_t numRxOperations;
@@ -107,6 +118,8 @@ public:
         uint32_t numLevelErrors;                //level outside of supported range
         uint32_t numClockTickGeneratorEvents;
 
+        LatencySummary egressLatency;       //wire to leaving this kernel
+        LatencySummary ingressLatency;      //wire to entering this kernel
     } Stats;
 
     uint32_t GetStats(Stats* pStats);
@@ -127,6 +140,47 @@ public: //Orderbook Data Mover Output Stream Control
     uint32_t GetDataMoverOutput(bool* pbEnabled);
 
 
+public: //Latency
+
+    //Cycles from packet arrival at the LineHandler port filter to the book response forwarded to the PricingEngine,
+    //collected in a histogram of XLNX_ORDER_BOOK_NUM_LATENCY_BINS bins each (1 << binShift) cycles wide,
+    //the last bin also holds any sample beyond the histogram range.
+    //Samples are taken against this kernel's own time base, which is not synchronised with the LineHandler time base
+    //that stamped the packet, so both histograms carry the same unknown offset and only their difference is meaningful.
+    //The ingress histogram covers the same cycles up to the point the operation is pulled from the FeedHandler stream,
+    //so the difference of the two means approximates the time spent inside this kernel, to within the few cycles
+    //either probe may read the kernel time base late and any difference in the messages the two probes sample
+    typedef struct
+    {
+        uint32_t numSamples;
+        uint32_t minLatency;
+        uint32_t maxLatency;
+        uint64_t totalLatency;              //sum of all samples, mean is totalLatency / numSamples
+        uint32_t binShift;
+        uint32_t bins[XLNX_ORDER_BOOK_NUM_LATENCY_BINS];
+    }LatencyHistogram;
+
+    uint32_t SetLatencyBinShift(uint32_t binShift);
+    uint32_t GetLatencyHistogram(LatencyHistogram* pHistogram);
+    uint32_t GetIngressLatencyHistogram(LatencyHistogram* pHistogram);
+    uint32_t ResetLatencyHistogram(void);
+
+
+
+
+
+public: //Telemetry
+    //While pTelemetry is sampling, GetStats takes the registers covered by its blocks from the latest
+    //snapshot instead of the device.  NULL (the default) always reads the device.
+    uint32_t SetTelemetry(Telemetry* pTelemetry);
+
+
+
+
+
+
+
+
 public:
     void IsInitialised(bool* pbIsInitialised);
 	uint32_t GetCUIndex(uint32_t* pCUIndex);
@@ -138,6 +192,9 @@ public:
 protected:
 	uint32_t CheckIsInitialised(void);
 
+    uint32_t ReadLatencySummary(bool bIngress, LatencySummary* pSummary, TelemetryRegisterSnapshot* pSnapshot = nullptr);
+    uint32_t ReadLatencyHistogram(bool bIngress, LatencyHistogram* pHistogram);
+
 	// the follow functions provide a form of mutual exclusion to the order book data.
 	// i.e they enable/disable HW updates to the data registers.
 	uint32_t FreezeData(void);
@@ -150,6 +207,8 @@ protected:
 
 protected:
 	uint32_t ReadReg32(uint64_t offset, uint32_t* value);
+	//from pSnapshot if it covers the register, otherwise from the device
+	uint32_t ReadStatsReg32(TelemetryRegisterSnapshot* pSnapshot, uint64_t offset, uint32_t* value);
 	uint32_t WriteReg32(uint64_t offset, uint32_t value);
 	uint32_t WriteRegWithMask32(uint64_t offset, uint32_t value, uint32_t mask);
 	uint32_t BlockReadReg32(uint64_t offset, uint32_t* buffer, uint32_t numWords);
@@ -167,6 +226,8 @@ protected:
 
 	DeviceInterface* m_pDeviceInterface;
 
+	Telemetry* m_pTelemetry;
+
 
 }; //class OrderBook
 
@@ -65,4 +65,27 @@
 
 
 
+/* Wire-to-stage latency histograms at stage egress and ingress, see hw/common/include/aat_latency.hpp */
+#define XLNX_ORDER_BOOK_LATENCY_CONTROL_OFFSET                      (0x00000028)
+#define XLNX_ORDER_BOOK_STATS_LATENCY_COUNT_OFFSET                  (0x00000220)
+#define XLNX_ORDER_BOOK_STATS_LATENCY_MIN_OFFSET                    (0x00000230)
+#define XLNX_ORDER_BOOK_STATS_LATENCY_MAX_OFFSET                    (0x00000240)
+#define XLNX_ORDER_BOOK_STATS_LATENCY_BIN_OFFSET                    (0x00000250)
+#define XLNX_ORDER_BOOK_STATS_LATENCY_SUM_LOWER_OFFSET              (0x00000260)
+#define XLNX_ORDER_BOOK_STATS_LATENCY_SUM_UPPER_OFFSET              (0x00000270)
+#define XLNX_ORDER_BOOK_STATS_INGRESS_LATENCY_COUNT_OFFSET          (0x00000280)
+#define XLNX_ORDER_BOOK_STATS_INGRESS_LATENCY_MIN_OFFSET            (0x00000290)
+#define XLNX_ORDER_BOOK_STATS_INGRESS_LATENCY_MAX_OFFSET            (0x000002A0)
+#define XLNX_ORDER_BOOK_STATS_INGRESS_LATENCY_BIN_OFFSET            (0x000002B0)
+#define XLNX_ORDER_BOOK_STATS_INGRESS_LATENCY_SUM_LOWER_OFFSET      (0x000002C0)
+#define XLNX_ORDER_BOOK_STATS_INGRESS_LATENCY_SUM_UPPER_OFFSET      (0x000002D0)
+
+#define XLNX_ORDER_BOOK_NUM_LATENCY_BINS                            (16)
+#define XLNX_ORDER_BOOK_LATENCY_BIN_SHIFT_MASK                      (0x1F)
+#define XLNX_ORDER_BOOK_LATENCY_BIN_SELECT_SHIFT                    (8)
+#define XLNX_ORDER_BOOK_LATENCY_BIN_SELECT_MASK                     (0x0F)
+#define XLNX_ORDER_BOOK_LATENCY_RESET_SHIFT                         (31)
+
+
+
 #endif
@@ -1668,7 +1668,7 @@ uint32_t OrderBookDataMover::SetHWWriteTailIndex(uint32_t tailIndex)
 
 
 
-uint32_t OrderBookDataMover::SetThrottleRate(uint32_t throttleRateClockCycles)
+uint32_t OrderBookDataMover::SetCreditLimit(uint32_t creditLimit)
 {
 	uint32_t retval = XLNX_OK;
 
@@ -1676,7 +1676,7 @@ uint32_t OrderBookDataMover::SetThrottleRate(uint32_t throttleRateClockCycles)
 
 	if (retval == XLNX_OK)
 	{
-		retval = WriteReg32(XLNX_ORDER_BOOK_DATA_MOVER_THROTTLE_RATE_OFFSET, throttleRateClockCycles);
+		retval = WriteReg32(XLNX_ORDER_BOOK_DATA_MOVER_CREDIT_LIMIT_OFFSET, creditLimit);
 	}
 
 	return retval;
@@ -1688,7 +1688,7 @@ uint32_t OrderBookDataMover::SetThrottleRate(uint32_t throttleRateClockCycles)
 
 
 
-uint32_t OrderBookDataMover::GetThrottleRate(uint32_t* pThrottleRateClockCycles)
+uint32_t OrderBookDataMover::GetCreditLimit(uint32_t* pCreditLimit)
 {
 	uint32_t retval = XLNX_OK;
 
@@ -1696,7 +1696,7 @@ uint32_t OrderBookDataMover::GetThrottleRate(uint32_t* pThrottleRateClockCycles)
 
 	if (retval == XLNX_OK)
 	{
-		retval = ReadReg32(XLNX_ORDER_BOOK_DATA_MOVER_THROTTLE_RATE_OFFSET, pThrottleRateClockCycles);
+		retval = ReadReg32(XLNX_ORDER_BOOK_DATA_MOVER_CREDIT_LIMIT_OFFSET, pCreditLimit);
 	}
 
 	return retval;
@@ -1705,11 +1705,11 @@ uint32_t OrderBookDataMover::GetThrottleRate(uint32_t* pThrottleRateClockCycles)
 
 
 
-uint32_t OrderBookDataMover::GetThrottleStats(ThrottleStats* pStats)
+uint32_t OrderBookDataMover::GetCreditStats(CreditStats* pStats)
 {
 	uint32_t retval = XLNX_OK;
 
-	memset(pStats, 0, sizeof(ThrottleStats));
+	memset(pStats, 0, sizeof(CreditStats));
 
 
 	retval = CheckIsInitialised();
@@ -1718,12 +1718,12 @@ uint32_t OrderBookDataMover::GetThrottleStats(ThrottleStats* pStats)
 
 	if (retval == XLNX_OK)
 	{
-		retval = ReadReg32(XLNX_ORDER_BOOK_DATA_MOVER_THROTTLE_COUNT_OFFSET, &(pStats->throttleCounter));
+		retval = ReadReg32(XLNX_ORDER_BOOK_DATA_MOVER_CREDIT_AVAILABLE_OFFSET, &(pStats->creditsAvailable));
 	}
 
 	if (retval == XLNX_OK)
 	{
-		retval = ReadReg32(XLNX_ORDER_BOOK_DATA_MOVER_TROTTLE_EVENT_OFFSET, &(pStats->throttleEvents));
+		retval = ReadReg32(XLNX_ORDER_BOOK_DATA_MOVER_CREDIT_STALL_OFFSET, &(pStats->creditStalls));
 	}
 
 	return retval;
@@ -137,20 +137,21 @@ public:
 
 
 
-public: //Throttling
+public: //Credits
 
-    //The following functions can be used to control the rate that the HW kernel reads from the H2C ring buffer...
-    uint32_t SetThrottleRate(uint32_t throttleRateClockCycles);
-    uint32_t GetThrottleRate(uint32_t* pThrottleRateClockCycles);
+    //The HW kernel reads from the H2C ring buffer only while it holds a credit from the OrderEntry kernel.
+    //The following functions can be used to control the number of operations allowed in flight (0 = HW default)...
+    uint32_t SetCreditLimit(uint32_t creditLimit);
+    uint32_t GetCreditLimit(uint32_t* pCreditLimit);
 
 
     typedef struct
     {
-        uint32_t throttleCounter;
-        uint32_t throttleEvents;
-    }ThrottleStats;
+        uint32_t creditsAvailable;
+        uint32_t creditStalls;
+    }CreditStats;
 
-    uint32_t GetThrottleStats(ThrottleStats* pStats);
+    uint32_t GetCreditStats(CreditStats* pStats);
 
 
 
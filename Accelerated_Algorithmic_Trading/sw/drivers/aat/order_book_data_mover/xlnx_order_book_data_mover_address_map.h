@@ -29,7 +29,7 @@
 #define XLNX_ORDER_BOOK_DATA_MOVER_RING_READ_BUFFER_HEAD_INDEX_OFFSET           (0x00000018)
 #define XLNX_ORDER_BOOK_DATA_MOVER_RING_WRITE_BUFFER_TAIL_INDEX_OFFSET          (0x00000020)
 
-#define XLNX_ORDER_BOOK_DATA_MOVER_THROTTLE_RATE_OFFSET                         (0x00000028)
+#define XLNX_ORDER_BOOK_DATA_MOVER_CREDIT_LIMIT_OFFSET                          (0x00000028)
 
 
 #define XLNX_ORDER_BOOK_DATA_MOVER_STATUS_OFFSET                                (0x00000050)
@@ -46,8 +46,8 @@
 #define XLNX_ORDER_BOOK_DATA_MOVER_CYCLES_PRE_OFFSET                            (0x000000D8)
 #define XLNX_ORDER_BOOK_DATA_MOVER_CYCLES_POST_OFFSET                           (0x000000E8)
 
-#define XLNX_ORDER_BOOK_DATA_MOVER_THROTTLE_COUNT_OFFSET                        (0x000000F8)
-#define XLNX_ORDER_BOOK_DATA_MOVER_TROTTLE_EVENT_OFFSET                         (0x00000108)
+#define XLNX_ORDER_BOOK_DATA_MOVER_CREDIT_AVAILABLE_OFFSET                      (0x000000F8)
+#define XLNX_ORDER_BOOK_DATA_MOVER_CREDIT_STALL_OFFSET                          (0x00000108)
 
 
 #define XLNX_ORDER_BOOK_DATA_MOVER_READ_BUFFER_ADDRESS_LOWER_WORD_OFFSET        (0x00000130)
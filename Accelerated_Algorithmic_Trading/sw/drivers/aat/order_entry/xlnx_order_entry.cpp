@@ -28,6 +28,7 @@ static const uint32_t IS_INITIALISED_MAGIC_NUMBER = 0xC672CBFE;
 OrderEntry::OrderEntry()
 {
     m_pDeviceInterface = nullptr;
+    m_pTelemetry = nullptr;
     m_cuAddress = 0;
     m_cuIndex = 0;
     m_initialisedMagicNumber = 0;
@@ -104,6 +105,18 @@ uint32_t OrderEntry::CheckIsInitialised(void)
 
 
 
+uint32_t OrderEntry::SetTelemetry(Telemetry* pTelemetry)
+{
+    m_pTelemetry = pTelemetry;
+
+    return XLNX_OK;
+}
+
+
+
+
+
+
 void OrderEntry::IsInitialised(bool* pbIsInitialised)
 {
     if (CheckIsInitialised() == XLNX_OK)
@@ -168,72 +181,102 @@ uint32_t OrderEntry::GetCUAddress(uint64_t* pCUAddress)
 uint32_t OrderEntry::GetStats(OrderEntry::Stats* pStats)
 {
     uint32_t retval = XLNX_OK;
+    TelemetryRegisterSnapshot snapshot;
+    bool bFromSnapshot = false;
 
 
 
     retval = CheckIsInitialised();
 
     if (retval == XLNX_OK)
+    {
+        //no snapshot (sampling stopped or no telemetry set) just means every register is read from the device
+        snapshot.Load(m_pTelemetry);
+        snapshot.IsLoaded(&bFromSnapshot);
+    }
+
+    //a snapshot is already a consistent set of counters, the device only needs freezing when read directly
+    if ((retval == XLNX_OK) && (bFromSnapshot == false))
     {
         retval = FreezeStats();
     }
 
     if (retval == XLNX_OK)
     {
-        retval = m_pDeviceInterface->ReadReg32(m_cuAddress + XLNX_ORDER_ENTRY_STATS_RX_OPERATIONS_COUNT_OFFSET, &pStats->numRxOperations);
+        retval = ReadStatsReg32(&snapshot, XLNX_ORDER_ENTRY_STATS_RX_OPERATIONS_COUNT_OFFSET, &pStats->numRxOperations);
+    }
+
+    if (retval == XLNX_OK)
+    {
+        retval = ReadStatsReg32(&snapshot, XLNX_ORDER_ENTRY_STATS_PROCESSED_OPERATIONS_COUNT_OFFSET, &pStats->numProcessedOperations);
+    }
+
+    if (retval == XLNX_OK)
+    {
+        retval = ReadStatsReg32(&snapshot, XLNX_ORDER_ENTRY_STATS_TX_DATA_FRAMES_COUNT_OFFSET, &pStats->numTxDataFrames);
+    }
+
+    if (retval == XLNX_OK)
+    {
+        retval = ReadStatsReg32(&snapshot, XLNX_ORDER_ENTRY_STATS_TX_META_FRAMES_COUNT_OFFSET, &pStats->numTxMetaFrames);
     }
 
     if (retval == XLNX_OK)
     {
-        retval = m_pDeviceInterface->ReadReg32(m_cuAddress + XLNX_ORDER_ENTRY_STATS_PROCESSED_OPERATIONS_COUNT_OFFSET, &pStats->numProcessedOperations);
+        retval = ReadStatsReg32(&snapshot, XLNX_ORDER_ENTRY_STATS_TX_MESSAGES_COUNT_OFFSET, &pStats->numTxMessages);
     }
 
     if (retval == XLNX_OK)
     {
-        retval = m_pDeviceInterface->ReadReg32(m_cuAddress + XLNX_ORDER_ENTRY_STATS_TX_DATA_FRAMES_COUNT_OFFSET, &pStats->numTxDataFrames);
+        retval = ReadStatsReg32(&snapshot, XLNX_ORDER_ENTRY_STATS_RX_DATA_FRAMES_COUNT_OFFSET, &pStats->numRxDataFrames);
     }
 
     if (retval == XLNX_OK)
     {
-        retval = m_pDeviceInterface->ReadReg32(m_cuAddress + XLNX_ORDER_ENTRY_STATS_TX_META_FRAMES_COUNT_OFFSET, &pStats->numTxMetaFrames);
+        retval = ReadStatsReg32(&snapshot, XLNX_ORDER_ENTRY_STATS_RX_META_FRAMES_COUNT_OFFSET, &pStats->numRxMetaFrames);
     }
 
     if (retval == XLNX_OK)
     {
-        retval = m_pDeviceInterface->ReadReg32(m_cuAddress + XLNX_ORDER_ENTRY_STATS_TX_MESSAGES_COUNT_OFFSET, &pStats->numTxMessages);
+        retval = ReadStatsReg32(&snapshot, XLNX_ORDER_ENTRY_STATS_CLOCK_TICK_EVENTS_COUNT_OFFSET, &pStats->numClockTickEvents);
     }
 
     if (retval == XLNX_OK)
     {
-        retval = m_pDeviceInterface->ReadReg32(m_cuAddress + XLNX_ORDER_ENTRY_STATS_RX_DATA_FRAMES_COUNT_OFFSET, &pStats->numRxDataFrames);
+        retval = ReadStatsReg32(&snapshot, XLNX_ORDER_ENTRY_STATS_TX_DROPPED_MSG_COUNT_OFFSET, &pStats->numTxDroppedMessages);
     }
 
     if (retval == XLNX_OK)
     {
-        retval = m_pDeviceInterface->ReadReg32(m_cuAddress + XLNX_ORDER_ENTRY_STATS_RX_META_FRAMES_COUNT_OFFSET, &pStats->numRxMetaFrames);
+        retval = ReadStatsReg32(&snapshot, XLNX_ORDER_ENTRY_STATS_NOTIFICATIONS_RECEIVED_COUNT_OFFSET, &pStats->numNotificationsReceived);
     }
 
     if (retval == XLNX_OK)
     {
-        retval = m_pDeviceInterface->ReadReg32(m_cuAddress + XLNX_ORDER_ENTRY_STATS_CLOCK_TICK_EVENTS_COUNT_OFFSET, &pStats->numClockTickEvents);
+        retval = ReadStatsReg32(&snapshot, XLNX_ORDER_ENTRY_STATS_READ_REQUESTS_SENT_COUNT_OFFSET, &pStats->numReadRequestsSent);
     }
 
     if (retval == XLNX_OK)
     {
-        retval = m_pDeviceInterface->ReadReg32(m_cuAddress + XLNX_ORDER_ENTRY_STATS_TX_DROPPED_MSG_COUNT_OFFSET, &pStats->numTxDroppedMessages);
+        retval = ReadStatsReg32(&snapshot, XLNX_ORDER_ENTRY_STATS_RX_EXEC_REPORTS_COUNT_OFFSET, &pStats->numRxExecReports);
     }
 
     if (retval == XLNX_OK)
     {
-        retval = m_pDeviceInterface->ReadReg32(m_cuAddress + XLNX_ORDER_ENTRY_STATS_NOTIFICATIONS_RECEIVED_COUNT_OFFSET, &pStats->numNotificationsReceived);
+        retval = ReadStatsReg32(&snapshot, XLNX_ORDER_ENTRY_STATS_RX_EXEC_REJECTS_COUNT_OFFSET, &pStats->numRxExecRejects);
     }
 
     if (retval == XLNX_OK)
     {
-        retval = m_pDeviceInterface->ReadReg32(m_cuAddress + XLNX_ORDER_ENTRY_STATS_READ_REQUESTS_SENT_COUNT_OFFSET, &pStats->numReadRequestsSent);
+        retval = ReadLatencySummary(false, &pStats->egressLatency, &snapshot);
     }
 
     if (retval == XLNX_OK)
+    {
+        retval = ReadLatencySummary(true, &pStats->ingressLatency, &snapshot);
+    }
+
+    if ((retval == XLNX_OK) && (bFromSnapshot == false))
     {
         retval = UnfreezeStats();
     }
@@ -518,6 +561,23 @@ uint32_t OrderEntry::ReadReg32(uint64_t offset, uint32_t* value)
 
 
 
+uint32_t OrderEntry::ReadStatsReg32(TelemetryRegisterSnapshot* pSnapshot, uint64_t offset, uint32_t* value)
+{
+    uint32_t retval = XLNX_OK;
+
+    if ((pSnapshot == nullptr) || (pSnapshot->ReadReg32(m_cuAddress + offset, value) != XLNX_OK))
+    {
+        retval = ReadReg32(offset, value);
+    }
+
+    return retval;
+}
+
+
+
+
+
+
 uint32_t OrderEntry::WriteReg32(uint64_t offset, uint32_t value)
 {
     uint32_t retval = XLNX_OK;
@@ -1066,4 +1126,204 @@ uint32_t OrderEntry::GetChecksumGeneration(bool* pbEnabled)
 
 
     return retval;
-}
\ No newline at end of file
+}
+
+
+
+
+
+
+uint32_t OrderEntry::SetLatencyBinShift(uint32_t binShift)
+{
+    uint32_t retval = XLNX_OK;
+    uint32_t mask = XLNX_ORDER_ENTRY_LATENCY_BIN_SHIFT_MASK;
+
+    retval = CheckIsInitialised();
+
+    if (retval == XLNX_OK)
+    {
+        if (binShift > XLNX_ORDER_ENTRY_LATENCY_BIN_SHIFT_MASK)
+        {
+            retval = XLNX_ORDER_ENTRY_ERROR_INVALID_PARAMETER;
+        }
+    }
+
+    if (retval == XLNX_OK)
+    {
+        retval = WriteRegWithMask32(XLNX_ORDER_ENTRY_LATENCY_CONTROL_OFFSET, binShift, mask);
+    }
+
+    return retval;
+}
+
+
+
+
+
+
+uint32_t OrderEntry::GetLatencyHistogram(LatencyHistogram* pHistogram)
+{
+    return ReadLatencyHistogram(false, pHistogram);
+}
+
+
+
+
+
+
+uint32_t OrderEntry::GetIngressLatencyHistogram(LatencyHistogram* pHistogram)
+{
+    return ReadLatencyHistogram(true, pHistogram);
+}
+
+
+
+
+
+uint32_t OrderEntry::ResetLatencyHistogram(void)
+{
+    uint32_t retval = XLNX_OK;
+    uint32_t shift = XLNX_ORDER_ENTRY_LATENCY_RESET_SHIFT;
+    uint32_t mask = 0x01;
+    uint32_t value;
+
+    retval = CheckIsInitialised();
+
+    if (retval == XLNX_OK)
+    {
+        mask = mask << shift;
+
+        value = 1;
+        value = value << shift;
+
+        retval = WriteRegWithMask32(XLNX_ORDER_ENTRY_LATENCY_CONTROL_OFFSET, value, mask);
+    }
+
+    if (retval == XLNX_OK)
+    {
+        value = 0;
+        value = value << shift;
+        retval = WriteRegWithMask32(XLNX_ORDER_ENTRY_LATENCY_CONTROL_OFFSET, value, mask);
+    }
+
+    return retval;
+}
+
+
+
+
+
+
+
+uint32_t OrderEntry::ReadLatencySummary(bool bIngress, LatencySummary* pSummary, TelemetryRegisterSnapshot* pSnapshot)
+{
+    uint32_t retval = XLNX_OK;
+    uint64_t countOffset = XLNX_ORDER_ENTRY_STATS_LATENCY_COUNT_OFFSET;
+    uint64_t minOffset = XLNX_ORDER_ENTRY_STATS_LATENCY_MIN_OFFSET;
+    uint64_t maxOffset = XLNX_ORDER_ENTRY_STATS_LATENCY_MAX_OFFSET;
+    uint64_t sumLowerOffset = XLNX_ORDER_ENTRY_STATS_LATENCY_SUM_LOWER_OFFSET;
+    uint64_t sumUpperOffset = XLNX_ORDER_ENTRY_STATS_LATENCY_SUM_UPPER_OFFSET;
+    uint32_t sumLower = 0;
+    uint32_t sumUpper = 0;
+
+    if (bIngress)
+    {
+        countOffset = XLNX_ORDER_ENTRY_STATS_INGRESS_LATENCY_COUNT_OFFSET;
+        minOffset = XLNX_ORDER_ENTRY_STATS_INGRESS_LATENCY_MIN_OFFSET;
+        maxOffset = XLNX_ORDER_ENTRY_STATS_INGRESS_LATENCY_MAX_OFFSET;
+        sumLowerOffset = XLNX_ORDER_ENTRY_STATS_INGRESS_LATENCY_SUM_LOWER_OFFSET;
+        sumUpperOffset = XLNX_ORDER_ENTRY_STATS_INGRESS_LATENCY_SUM_UPPER_OFFSET;
+    }
+
+    retval = CheckIsInitialised();
+
+    if (retval == XLNX_OK)
+    {
+        retval = ReadStatsReg32(pSnapshot, countOffset, &pSummary->numSamples);
+    }
+
+    if (retval == XLNX_OK)
+    {
+        retval = ReadStatsReg32(pSnapshot, minOffset, &pSummary->minLatency);
+    }
+
+    if (retval == XLNX_OK)
+    {
+        retval = ReadStatsReg32(pSnapshot, maxOffset, &pSummary->maxLatency);
+    }
+
+    if (retval == XLNX_OK)
+    {
+        retval = ReadStatsReg32(pSnapshot, sumLowerOffset, &sumLower);
+    }
+
+    if (retval == XLNX_OK)
+    {
+        retval = ReadStatsReg32(pSnapshot, sumUpperOffset, &sumUpper);
+    }
+
+    if (retval == XLNX_OK)
+    {
+        pSummary->totalLatency = ((uint64_t)sumUpper << 32) | sumLower;
+    }
+
+    return retval;
+}
+
+
+
+
+
+
+uint32_t OrderEntry::ReadLatencyHistogram(bool bIngress, LatencyHistogram* pHistogram)
+{
+    uint32_t retval = XLNX_OK;
+    uint32_t control = 0;
+    uint32_t mask = XLNX_ORDER_ENTRY_LATENCY_BIN_SELECT_MASK << XLNX_ORDER_ENTRY_LATENCY_BIN_SELECT_SHIFT;
+    uint64_t binOffset = XLNX_ORDER_ENTRY_STATS_LATENCY_BIN_OFFSET;
+    LatencySummary summary;
+    uint32_t value;
+    uint32_t i;
+
+    if (bIngress)
+    {
+        binOffset = XLNX_ORDER_ENTRY_STATS_INGRESS_LATENCY_BIN_OFFSET;
+    }
+
+    retval = CheckIsInitialised();
+
+    if (retval == XLNX_OK)
+    {
+        retval = ReadReg32(XLNX_ORDER_ENTRY_LATENCY_CONTROL_OFFSET, &control);
+    }
+
+    if (retval == XLNX_OK)
+    {
+        pHistogram->binShift = control & XLNX_ORDER_ENTRY_LATENCY_BIN_SHIFT_MASK;
+
+        retval = ReadLatencySummary(bIngress, &summary);
+    }
+
+    if (retval == XLNX_OK)
+    {
+        pHistogram->numSamples = summary.numSamples;
+        pHistogram->minLatency = summary.minLatency;
+        pHistogram->maxLatency = summary.maxLatency;
+        pHistogram->totalLatency = summary.totalLatency;
+    }
+
+    //the bins share a single status register per probe, each is selected in turn via the control register
+    for (i = 0; (i < XLNX_ORDER_ENTRY_NUM_LATENCY_BINS) && (retval == XLNX_OK); i++)
+    {
+        value = i << XLNX_ORDER_ENTRY_LATENCY_BIN_SELECT_SHIFT;
+
+        retval = WriteRegWithMask32(XLNX_ORDER_ENTRY_LATENCY_CONTROL_OFFSET, value, mask);
+
+        if (retval == XLNX_OK)
+        {
+            retval = ReadReg32(binOffset, &pHistogram->bins[i]);
+        }
+    }
+
+    return retval;
+}
@@ -22,8 +22,10 @@
 #include <cstdint>
 
 #include "xlnx_device_interface.h"
+#include "xlnx_telemetry_register_snapshot.h"
 
 #include "xlnx_order_entry_error_codes.h"
+#include "xlnx_order_entry_address_map.h"
 
 
 namespace XLNX
@@ -44,6 +46,15 @@ public:
 
 
 public:
+    //Summary of one latency probe, see the Latency section below
+    typedef struct
+    {
+        uint32_t numSamples;
+        uint32_t minLatency;
+        uint32_t maxLatency;
+        uint64_t totalLatency;              //sum of all samples, mean is totalLatency / numSamples
+    }LatencySummary;
+
     typedef struct
     {
         uint32_t numRxOperations;
@@ -60,7 +71,13 @@ public:
 
         uint32_t numNotificationsReceived;  //from TCP kernel
         uint32_t numReadRequestsSent;       //to TCP kernel
+
+        uint32_t numRxExecReports;          //execution reports parsed and forwarded to PricingEngine
+        uint32_t numRxExecRejects;          //execution reports dropped on a malformed numeric field
       
+
+        LatencySummary egressLatency;       //wire to leaving this kernel
+        LatencySummary ingressLatency;      //wire to entering this kernel
     } Stats;
 
     uint32_t GetStats(Stats* pStats);
@@ -140,6 +157,47 @@ public: //Partial Checksum Calculation And Forwarding
 
 
 
+public: //Latency
+
+    //Cycles from packet arrival at the LineHandler port filter to the order message transmitted on the TCP session,
+    //collected in a histogram of XLNX_ORDER_ENTRY_NUM_LATENCY_BINS bins each (1 << binShift) cycles wide,
+    //the last bin also holds any sample beyond the histogram range.
+    //Samples are taken against this kernel's own time base, which is not synchronised with the LineHandler time base
+    //that stamped the packet, so both histograms carry the same unknown offset and only their difference is meaningful.
+    //The ingress histogram covers the same cycles up to the point the order operation is pulled from the direct (non host) stream,
+    //so the difference of the two means approximates the time spent inside this kernel, to within the few cycles
+    //either probe may read the kernel time base late and any difference in the messages the two probes sample
+    typedef struct
+    {
+        uint32_t numSamples;
+        uint32_t minLatency;
+        uint32_t maxLatency;
+        uint64_t totalLatency;              //sum of all samples, mean is totalLatency / numSamples
+        uint32_t binShift;
+        uint32_t bins[XLNX_ORDER_ENTRY_NUM_LATENCY_BINS];
+    }LatencyHistogram;
+
+    uint32_t SetLatencyBinShift(uint32_t binShift);
+    uint32_t GetLatencyHistogram(LatencyHistogram* pHistogram);
+    uint32_t GetIngressLatencyHistogram(LatencyHistogram* pHistogram);
+    uint32_t ResetLatencyHistogram(void);
+
+
+
+
+
+public: //Telemetry
+    //While pTelemetry is sampling, GetStats takes the registers covered by its blocks from the latest
+    //snapshot instead of the device.  NULL (the default) always reads the device.
+    uint32_t SetTelemetry(Telemetry* pTelemetry);
+
+
+
+
+
+
+
+
 public:
     void IsInitialised(bool* pbIsInitialised);
 
@@ -155,6 +213,9 @@ public:
 protected:
     uint32_t CheckIsInitialised(void);
 
+    uint32_t ReadLatencySummary(bool bIngress, LatencySummary* pSummary, TelemetryRegisterSnapshot* pSnapshot = nullptr);
+    uint32_t ReadLatencyHistogram(bool bIngress, LatencyHistogram* pHistogram);
+
     // the follow functions provide a form of mutual exclusion to the order book data.
     // i.e they enable/disable HW updates to the data registers.
     uint32_t FreezeData(void);
@@ -167,6 +228,8 @@ protected:
 
 protected:
     uint32_t ReadReg32(uint64_t offset, uint32_t* value);
+    //from pSnapshot if it covers the register, otherwise from the device
+    uint32_t ReadStatsReg32(TelemetryRegisterSnapshot* pSnapshot, uint64_t offset, uint32_t* value);
     uint32_t WriteReg32(uint64_t offset, uint32_t value);
     uint32_t WriteRegWithMask32(uint64_t offset, uint32_t value, uint32_t mask);
     uint32_t BlockReadReg32(uint64_t offset, uint32_t* buffer, uint32_t numWords);
@@ -181,6 +244,7 @@ protected:
     uint64_t m_cuAddress;
     uint32_t m_cuIndex;
     DeviceInterface* m_pDeviceInterface;
+    Telemetry* m_pTelemetry;
 
 };
 
@@ -52,8 +52,10 @@
 
 #define XLNX_ORDER_ENTRY_STATS_NOTIFICATIONS_RECEIVED_COUNT_OFFSET  (0x000000F8)
 #define XLNX_ORDER_ENTRY_STATS_READ_REQUESTS_SENT_COUNT_OFFSET      (0x00000108)
+#define XLNX_ORDER_ENTRY_STATS_RX_EXEC_REPORTS_COUNT_OFFSET         (0x00000128)
+#define XLNX_ORDER_ENTRY_STATS_RX_EXEC_REJECTS_COUNT_OFFSET         (0x00000138)
 
-#define XLNX_ORDER_ENTRY_CAPTURE_OFFSET					            (0x00000138)
+#define XLNX_ORDER_ENTRY_CAPTURE_OFFSET					            (0x00000140)
 
 
 
@@ -74,5 +76,28 @@
 
 
 
+/* Wire-to-stage latency histograms at stage egress and ingress, see hw/common/include/aat_latency.hpp */
+#define XLNX_ORDER_ENTRY_LATENCY_CONTROL_OFFSET                     (0x00000038)
+#define XLNX_ORDER_ENTRY_STATS_LATENCY_COUNT_OFFSET                 (0x000001D0)
+#define XLNX_ORDER_ENTRY_STATS_LATENCY_MIN_OFFSET                   (0x000001E0)
+#define XLNX_ORDER_ENTRY_STATS_LATENCY_MAX_OFFSET                   (0x000001F0)
+#define XLNX_ORDER_ENTRY_STATS_LATENCY_BIN_OFFSET                   (0x00000200)
+#define XLNX_ORDER_ENTRY_STATS_LATENCY_SUM_LOWER_OFFSET             (0x00000210)
+#define XLNX_ORDER_ENTRY_STATS_LATENCY_SUM_UPPER_OFFSET             (0x00000220)
+#define XLNX_ORDER_ENTRY_STATS_INGRESS_LATENCY_COUNT_OFFSET         (0x00000230)
+#define XLNX_ORDER_ENTRY_STATS_INGRESS_LATENCY_MIN_OFFSET           (0x00000240)
+#define XLNX_ORDER_ENTRY_STATS_INGRESS_LATENCY_MAX_OFFSET           (0x00000250)
+#define XLNX_ORDER_ENTRY_STATS_INGRESS_LATENCY_BIN_OFFSET           (0x00000260)
+#define XLNX_ORDER_ENTRY_STATS_INGRESS_LATENCY_SUM_LOWER_OFFSET     (0x00000270)
+#define XLNX_ORDER_ENTRY_STATS_INGRESS_LATENCY_SUM_UPPER_OFFSET     (0x00000280)
+
+#define XLNX_ORDER_ENTRY_NUM_LATENCY_BINS                           (16)
+#define XLNX_ORDER_ENTRY_LATENCY_BIN_SHIFT_MASK                     (0x1F)
+#define XLNX_ORDER_ENTRY_LATENCY_BIN_SELECT_SHIFT                   (8)
+#define XLNX_ORDER_ENTRY_LATENCY_BIN_SELECT_MASK                    (0x0F)
+#define XLNX_ORDER_ENTRY_LATENCY_RESET_SHIFT                        (31)
+
+
+
 #endif
 
@@ -30,6 +30,7 @@ static const uint32_t IS_INITIALISED_MAGIC_NUMBER = 0x674217FB;
 PricingEngine::PricingEngine()
 {
     m_pDeviceInterface = nullptr;
+    m_pTelemetry = nullptr;
     m_cuAddress = 0;
     m_cuIndex = 0;
     m_initialisedMagicNumber = 0;
@@ -148,11 +149,21 @@ uint32_t PricingEngine::GetCUAddress(uint64_t* pCUAddress)
 uint32_t PricingEngine::GetStats(PricingEngine::Stats* pStats)
 {
     uint32_t retval = XLNX_OK;
+    TelemetryRegisterSnapshot snapshot;
+    bool bFromSnapshot = false;
   
 
     retval = CheckIsInitialised();
 
     if (retval == XLNX_OK)
+    {
+        //no snapshot (sampling stopped or no telemetry set) just means every register is read from the device
+        snapshot.Load(m_pTelemetry);
+        snapshot.IsLoaded(&bFromSnapshot);
+    }
+
+    //a snapshot is already a consistent set of counters, the device only needs freezing when read directly
+    if ((retval == XLNX_OK) && (bFromSnapshot == false))
     {
         retval = FreezeStats();
     }
@@ -160,45 +171,105 @@ uint32_t PricingEngine::GetStats(PricingEngine::Stats* pStats)
   
     if (retval == XLNX_OK)
     {
-        retval = m_pDeviceInterface->ReadReg32(m_cuAddress + XLNX_PRICING_ENGINE_STATS_RX_RESPONSE_COUNT_OFFSET, &pStats->numRxResponses);
+        retval = ReadStatsReg32(&snapshot, XLNX_PRICING_ENGINE_STATS_RX_RESPONSE_COUNT_OFFSET, &pStats->numRxResponses);
+    }
+
+    if (retval == XLNX_OK)
+    {
+        retval = ReadStatsReg32(&snapshot, XLNX_PRICING_ENGINE_STATS_PROCESSED_RESPONSES_COUNT_OFFSET, &pStats->numProcessedResponses);
+    }
+
+    if (retval == XLNX_OK)
+    {
+        retval = ReadStatsReg32(&snapshot, XLNX_PRICING_ENGINE_STATS_TX_OPERATIONS_COUNT_OFFSET, &pStats->numTxOperations);
+    }
+
+    if (retval == XLNX_OK)
+    {
+        retval = ReadStatsReg32(&snapshot, XLNX_PRICING_ENGINE_STATS_STRATEGY_NONE_COUNT_OFFSET, &pStats->numStrategyNone);
+    }
+
+    if (retval == XLNX_OK)
+    {
+        retval = ReadStatsReg32(&snapshot, XLNX_PRICING_ENGINE_STATS_STRATEGY_PEG_COUNT_OFFSET, &pStats->numStrategyPeg);
+    }
+
+    if (retval == XLNX_OK)
+    {
+        retval = ReadStatsReg32(&snapshot, XLNX_PRICING_ENGINE_STATS_STRATEGY_LIMIT_COUNT_OFFSET, &pStats->numStrategyLimit);
+    }
+
+    if (retval == XLNX_OK)
+    {
+        retval = ReadStatsReg32(&snapshot, XLNX_PRICING_ENGINE_STATS_STRATEGY_CUSTOM_COUNT_OFFSET, &pStats->numStrategyCustom);
+    }
+
+    if (retval == XLNX_OK)
+    {
+        retval = ReadStatsReg32(&snapshot, XLNX_PRICING_ENGINE_STATS_STRATEGY_UNKNOWN_COUNT_OFFSET, &pStats->numStrategyUnknown);
+    }
+
+    if (retval == XLNX_OK)
+    {
+        retval = ReadStatsReg32(&snapshot, XLNX_PRICING_ENGINE_STATS_CLOCK_TICK_EVENTS_COUNT_OFFSET, &pStats->numClockTickEvents);
     }
 
     if (retval == XLNX_OK)
     {
-        retval = m_pDeviceInterface->ReadReg32(m_cuAddress + XLNX_PRICING_ENGINE_STATS_PROCESSED_RESPONSES_COUNT_OFFSET, &pStats->numProcessedResponses);
+        retval = ReadStatsReg32(&snapshot, XLNX_PRICING_ENGINE_STATS_CREDIT_AVAILABLE_OFFSET, &pStats->numCreditsAvailable);
     }
 
     if (retval == XLNX_OK)
     {
-        retval = m_pDeviceInterface->ReadReg32(m_cuAddress + XLNX_PRICING_ENGINE_STATS_TX_OPERATIONS_COUNT_OFFSET, &pStats->numTxOperations);
+        retval = ReadStatsReg32(&snapshot, XLNX_PRICING_ENGINE_STATS_CREDIT_STALL_COUNT_OFFSET, &pStats->numCreditStalls);
     }
 
     if (retval == XLNX_OK)
     {
-        retval = m_pDeviceInterface->ReadReg32(m_cuAddress + XLNX_PRICING_ENGINE_STATS_STRATEGY_NONE_COUNT_OFFSET, &pStats->numStrategyNone);
+        retval = ReadStatsReg32(&snapshot, XLNX_PRICING_ENGINE_STATS_EXEC_REPORT_COUNT_OFFSET, &pStats->numExecReports);
     }
 
     if (retval == XLNX_OK)
     {
-        retval = m_pDeviceInterface->ReadReg32(m_cuAddress + XLNX_PRICING_ENGINE_STATS_STRATEGY_PEG_COUNT_OFFSET, &pStats->numStrategyPeg);
+        retval = ReadStatsReg32(&snapshot, XLNX_PRICING_ENGINE_STATS_EXEC_FILL_COUNT_OFFSET, &pStats->numExecFills);
     }
 
     if (retval == XLNX_OK)
     {
-        retval = m_pDeviceInterface->ReadReg32(m_cuAddress + XLNX_PRICING_ENGINE_STATS_STRATEGY_LIMIT_COUNT_OFFSET, &pStats->numStrategyLimit);
+        retval = ReadStatsReg32(&snapshot, XLNX_PRICING_ENGINE_STATS_EXEC_REJECT_COUNT_OFFSET, &pStats->numExecRejects);
     }
 
     if (retval == XLNX_OK)
     {
-        retval = m_pDeviceInterface->ReadReg32(m_cuAddress + XLNX_PRICING_ENGINE_STATS_STRATEGY_UNKNOWN_COUNT_OFFSET, &pStats->numStrategyUnknown);
+        retval = ReadStatsReg32(&snapshot, XLNX_PRICING_ENGINE_STATS_EXEC_UNMATCHED_COUNT_OFFSET, &pStats->numExecUnmatched);
     }
 
     if (retval == XLNX_OK)
     {
-        retval = m_pDeviceInterface->ReadReg32(m_cuAddress + XLNX_PRICING_ENGINE_STATS_CLOCK_TICK_EVENTS_COUNT_OFFSET, &pStats->numClockTickEvents);
+        retval = ReadLatencySummary(false, &pStats->egressLatency, &snapshot);
     }
 
     if (retval == XLNX_OK)
+    {
+        retval = ReadLatencySummary(true, &pStats->ingressLatency, &snapshot);
+    }
+
+    if (retval == XLNX_OK)
+    {
+        retval = ReadStrategyLatencySummary(0, &pStats->pegLatency, &snapshot);
+    }
+
+    if (retval == XLNX_OK)
+    {
+        retval = ReadStrategyLatencySummary(1, &pStats->limitLatency, &snapshot);
+    }
+
+    if (retval == XLNX_OK)
+    {
+        retval = ReadStrategyLatencySummary(2, &pStats->customLatency, &snapshot);
+    }
+
+    if ((retval == XLNX_OK) && (bFromSnapshot == false))
     {
         retval = UnfreezeStats();
     }
@@ -530,6 +601,18 @@ uint32_t PricingEngine::CheckIsInitialised(void)
 
 
 
+uint32_t PricingEngine::SetTelemetry(Telemetry* pTelemetry)
+{
+    m_pTelemetry = pTelemetry;
+
+    return XLNX_OK;
+}
+
+
+
+
+
+
 void PricingEngine::IsInitialised(bool* pbIsInitialised)
 {
     if (CheckIsInitialised() == XLNX_OK)
@@ -684,6 +767,23 @@ uint32_t PricingEngine::ReadReg32(uint64_t offset, uint32_t* value)
 
 
 
+uint32_t PricingEngine::ReadStatsReg32(TelemetryRegisterSnapshot* pSnapshot, uint64_t offset, uint32_t* value)
+{
+    uint32_t retval = XLNX_OK;
+
+    if ((pSnapshot == nullptr) || (pSnapshot->ReadReg32(m_cuAddress + offset, value) != XLNX_OK))
+    {
+        retval = ReadReg32(offset, value);
+    }
+
+    return retval;
+}
+
+
+
+
+
+
 uint32_t PricingEngine::WriteReg32(uint64_t offset, uint32_t value)
 {
     uint32_t retval = XLNX_OK;
@@ -890,3 +990,490 @@ uint32_t PricingEngine::GetGlobalStrategy(PricingStrategy* pStrategy)
 
 
 
+
+
+
+
+uint32_t PricingEngine::SetSymbolStrategy(uint32_t symbolIndex, PricingStrategy strategy)
+{
+    uint32_t retval = XLNX_OK;
+    uint64_t offset;
+
+    retval = CheckIsInitialised();
+
+    if (retval == XLNX_OK)
+    {
+        if (symbolIndex >= MAX_NUM_SYMBOLS)
+        {
+            retval = XLNX_PRICING_ENGINE_ERROR_SYMBOL_INDEX_OUT_OF_RANGE;
+        }
+    }
+
+    if (retval == XLNX_OK)
+    {
+        offset = XLNX_PRICING_ENGINE_SYMBOL_STRATEGY_BASE_OFFSET +
+                 (symbolIndex * XLNX_PRICING_ENGINE_SYMBOL_STRATEGY_STRIDE) +
+                 XLNX_PRICING_ENGINE_SYMBOL_STRATEGY_SELECT_OFFSET;
+
+        retval = WriteReg32(offset, (uint32_t)strategy);
+    }
+
+    return retval;
+}
+
+
+
+
+
+
+uint32_t PricingEngine::GetSymbolStrategy(uint32_t symbolIndex, PricingStrategy* pStrategy)
+{
+    uint32_t retval = XLNX_OK;
+    uint64_t offset;
+    uint32_t value;
+
+    retval = CheckIsInitialised();
+
+    if (retval == XLNX_OK)
+    {
+        if (symbolIndex >= MAX_NUM_SYMBOLS)
+        {
+            retval = XLNX_PRICING_ENGINE_ERROR_SYMBOL_INDEX_OUT_OF_RANGE;
+        }
+    }
+
+    if (retval == XLNX_OK)
+    {
+        offset = XLNX_PRICING_ENGINE_SYMBOL_STRATEGY_BASE_OFFSET +
+                 (symbolIndex * XLNX_PRICING_ENGINE_SYMBOL_STRATEGY_STRIDE) +
+                 XLNX_PRICING_ENGINE_SYMBOL_STRATEGY_SELECT_OFFSET;
+
+        retval = ReadReg32(offset, &value);
+    }
+
+    if (retval == XLNX_OK)
+    {
+        *pStrategy = (PricingStrategy)(value & 0xFF);
+    }
+
+    return retval;
+}
+
+
+
+
+
+
+uint32_t PricingEngine::SetSymbolPositionThreshold(uint32_t symbolIndex, bool bEnabled, uint32_t threshold)
+{
+    uint32_t retval = XLNX_OK;
+    uint64_t offset;
+    uint32_t value = 0;
+    uint32_t mask = 0x01;
+
+    retval = CheckIsInitialised();
+
+    if (retval == XLNX_OK)
+    {
+        if (symbolIndex >= MAX_NUM_SYMBOLS)
+        {
+            retval = XLNX_PRICING_ENGINE_ERROR_SYMBOL_INDEX_OUT_OF_RANGE;
+        }
+    }
+
+    if (retval == XLNX_OK)
+    {
+        offset = XLNX_PRICING_ENGINE_SYMBOL_STRATEGY_BASE_OFFSET +
+                 (symbolIndex * XLNX_PRICING_ENGINE_SYMBOL_STRATEGY_STRIDE) +
+                 XLNX_PRICING_ENGINE_SYMBOL_STRATEGY_THRESHOLD_OFFSET;
+
+        retval = WriteReg32(offset, threshold);
+    }
+
+    if (retval == XLNX_OK)
+    {
+        offset = XLNX_PRICING_ENGINE_SYMBOL_STRATEGY_BASE_OFFSET +
+                 (symbolIndex * XLNX_PRICING_ENGINE_SYMBOL_STRATEGY_STRIDE) +
+                 XLNX_PRICING_ENGINE_SYMBOL_STRATEGY_ENABLE_OFFSET;
+
+        if (bEnabled)
+        {
+            value = mask;
+        }
+
+        retval = WriteRegWithMask32(offset, value, mask);
+    }
+
+    return retval;
+}
+
+
+
+
+
+
+uint32_t PricingEngine::GetSymbolPositionThreshold(uint32_t symbolIndex, bool* pbEnabled, uint32_t* pThreshold)
+{
+    uint32_t retval = XLNX_OK;
+    uint64_t offset;
+    uint32_t value;
+
+    retval = CheckIsInitialised();
+
+    if (retval == XLNX_OK)
+    {
+        if (symbolIndex >= MAX_NUM_SYMBOLS)
+        {
+            retval = XLNX_PRICING_ENGINE_ERROR_SYMBOL_INDEX_OUT_OF_RANGE;
+        }
+    }
+
+    if (retval == XLNX_OK)
+    {
+        offset = XLNX_PRICING_ENGINE_SYMBOL_STRATEGY_BASE_OFFSET +
+                 (symbolIndex * XLNX_PRICING_ENGINE_SYMBOL_STRATEGY_STRIDE) +
+                 XLNX_PRICING_ENGINE_SYMBOL_STRATEGY_ENABLE_OFFSET;
+
+        retval = ReadReg32(offset, &value);
+    }
+
+    if (retval == XLNX_OK)
+    {
+        *pbEnabled = ((value & 0x01) != 0);
+
+        offset = XLNX_PRICING_ENGINE_SYMBOL_STRATEGY_BASE_OFFSET +
+                 (symbolIndex * XLNX_PRICING_ENGINE_SYMBOL_STRATEGY_STRIDE) +
+                 XLNX_PRICING_ENGINE_SYMBOL_STRATEGY_THRESHOLD_OFFSET;
+
+        retval = ReadReg32(offset, pThreshold);
+    }
+
+    return retval;
+}
+
+
+
+
+
+
+uint32_t PricingEngine::SetCreditLimit(uint32_t creditLimit)
+{
+    uint32_t retval = XLNX_OK;
+
+    retval = CheckIsInitialised();
+
+    if (retval == XLNX_OK)
+    {
+        retval = WriteReg32(XLNX_PRICING_ENGINE_CREDIT_LIMIT_OFFSET, creditLimit);
+    }
+
+    return retval;
+}
+
+
+
+
+
+
+uint32_t PricingEngine::GetCreditLimit(uint32_t* pCreditLimit)
+{
+    uint32_t retval = XLNX_OK;
+
+    retval = CheckIsInitialised();
+
+    if (retval == XLNX_OK)
+    {
+        retval = ReadReg32(XLNX_PRICING_ENGINE_CREDIT_LIMIT_OFFSET, pCreditLimit);
+    }
+
+    return retval;
+}
+
+
+
+
+
+
+uint32_t PricingEngine::SetOrderLifetime(uint32_t revolutions)
+{
+    uint32_t retval = XLNX_OK;
+
+    retval = CheckIsInitialised();
+
+    if (retval == XLNX_OK)
+    {
+        retval = WriteReg32(XLNX_PRICING_ENGINE_ORDER_LIFETIME_OFFSET, revolutions);
+    }
+
+    return retval;
+}
+
+
+
+
+
+
+uint32_t PricingEngine::GetOrderLifetime(uint32_t* pRevolutions)
+{
+    uint32_t retval = XLNX_OK;
+
+    retval = CheckIsInitialised();
+
+    if (retval == XLNX_OK)
+    {
+        retval = ReadReg32(XLNX_PRICING_ENGINE_ORDER_LIFETIME_OFFSET, pRevolutions);
+    }
+
+    return retval;
+}
+
+
+
+
+
+
+uint32_t PricingEngine::SetLatencyBinShift(uint32_t binShift)
+{
+    uint32_t retval = XLNX_OK;
+    uint32_t mask = XLNX_PRICING_ENGINE_LATENCY_BIN_SHIFT_MASK;
+
+    retval = CheckIsInitialised();
+
+    if (retval == XLNX_OK)
+    {
+        if (binShift > XLNX_PRICING_ENGINE_LATENCY_BIN_SHIFT_MASK)
+        {
+            retval = XLNX_PRICING_ENGINE_ERROR_INVALID_PARAMETER;
+        }
+    }
+
+    if (retval == XLNX_OK)
+    {
+        retval = WriteRegWithMask32(XLNX_PRICING_ENGINE_LATENCY_CONTROL_OFFSET, binShift, mask);
+    }
+
+    return retval;
+}
+
+
+
+
+
+
+uint32_t PricingEngine::GetLatencyHistogram(LatencyHistogram* pHistogram)
+{
+    return ReadLatencyHistogram(false, pHistogram);
+}
+
+
+
+
+
+
+uint32_t PricingEngine::GetIngressLatencyHistogram(LatencyHistogram* pHistogram)
+{
+    return ReadLatencyHistogram(true, pHistogram);
+}
+
+
+
+
+
+uint32_t PricingEngine::ResetLatencyHistogram(void)
+{
+    uint32_t retval = XLNX_OK;
+    uint32_t shift = XLNX_PRICING_ENGINE_LATENCY_RESET_SHIFT;
+    uint32_t mask = 0x01;
+    uint32_t value;
+
+    retval = CheckIsInitialised();
+
+    if (retval == XLNX_OK)
+    {
+        mask = mask << shift;
+
+        value = 1;
+        value = value << shift;
+
+        retval = WriteRegWithMask32(XLNX_PRICING_ENGINE_LATENCY_CONTROL_OFFSET, value, mask);
+    }
+
+    if (retval == XLNX_OK)
+    {
+        value = 0;
+        value = value << shift;
+        retval = WriteRegWithMask32(XLNX_PRICING_ENGINE_LATENCY_CONTROL_OFFSET, value, mask);
+    }
+
+    return retval;
+}
+
+
+
+
+
+
+
+uint32_t PricingEngine::ReadLatencySummary(bool bIngress, LatencySummary* pSummary, TelemetryRegisterSnapshot* pSnapshot)
+{
+    uint32_t retval = XLNX_OK;
+    uint64_t countOffset = XLNX_PRICING_ENGINE_STATS_LATENCY_COUNT_OFFSET;
+    uint64_t minOffset = XLNX_PRICING_ENGINE_STATS_LATENCY_MIN_OFFSET;
+    uint64_t maxOffset = XLNX_PRICING_ENGINE_STATS_LATENCY_MAX_OFFSET;
+    uint64_t sumLowerOffset = XLNX_PRICING_ENGINE_STATS_LATENCY_SUM_LOWER_OFFSET;
+    uint64_t sumUpperOffset = XLNX_PRICING_ENGINE_STATS_LATENCY_SUM_UPPER_OFFSET;
+    uint32_t sumLower = 0;
+    uint32_t sumUpper = 0;
+
+    if (bIngress)
+    {
+        countOffset = XLNX_PRICING_ENGINE_STATS_INGRESS_LATENCY_COUNT_OFFSET;
+        minOffset = XLNX_PRICING_ENGINE_STATS_INGRESS_LATENCY_MIN_OFFSET;
+        maxOffset = XLNX_PRICING_ENGINE_STATS_INGRESS_LATENCY_MAX_OFFSET;
+        sumLowerOffset = XLNX_PRICING_ENGINE_STATS_INGRESS_LATENCY_SUM_LOWER_OFFSET;
+        sumUpperOffset = XLNX_PRICING_ENGINE_STATS_INGRESS_LATENCY_SUM_UPPER_OFFSET;
+    }
+
+    retval = CheckIsInitialised();
+
+    if (retval == XLNX_OK)
+    {
+        retval = ReadStatsReg32(pSnapshot, countOffset, &pSummary->numSamples);
+    }
+
+    if (retval == XLNX_OK)
+    {
+        retval = ReadStatsReg32(pSnapshot, minOffset, &pSummary->minLatency);
+    }
+
+    if (retval == XLNX_OK)
+    {
+        retval = ReadStatsReg32(pSnapshot, maxOffset, &pSummary->maxLatency);
+    }
+
+    if (retval == XLNX_OK)
+    {
+        retval = ReadStatsReg32(pSnapshot, sumLowerOffset, &sumLower);
+    }
+
+    if (retval == XLNX_OK)
+    {
+        retval = ReadStatsReg32(pSnapshot, sumUpperOffset, &sumUpper);
+    }
+
+    if (retval == XLNX_OK)
+    {
+        pSummary->totalLatency = ((uint64_t)sumUpper << 32) | sumLower;
+    }
+
+    return retval;
+}
+
+
+
+
+
+
+
+
+
+
+uint32_t PricingEngine::ReadStrategyLatencySummary(uint32_t strategyIndex, LatencySummary* pSummary, TelemetryRegisterSnapshot* pSnapshot)
+{
+    uint32_t retval = XLNX_OK;
+    uint64_t baseOffset = XLNX_PRICING_ENGINE_STATS_STRATEGY_LATENCY_BASE_OFFSET + ((uint64_t)strategyIndex * XLNX_PRICING_ENGINE_STATS_STRATEGY_LATENCY_STRIDE);
+    uint32_t sumLower = 0;
+    uint32_t sumUpper = 0;
+
+    retval = CheckIsInitialised();
+
+    if (retval == XLNX_OK)
+    {
+        retval = ReadStatsReg32(pSnapshot, baseOffset + XLNX_PRICING_ENGINE_STATS_STRATEGY_LATENCY_COUNT_OFFSET, &pSummary->numSamples);
+    }
+
+    if (retval == XLNX_OK)
+    {
+        retval = ReadStatsReg32(pSnapshot, baseOffset + XLNX_PRICING_ENGINE_STATS_STRATEGY_LATENCY_MIN_OFFSET, &pSummary->minLatency);
+    }
+
+    if (retval == XLNX_OK)
+    {
+        retval = ReadStatsReg32(pSnapshot, baseOffset + XLNX_PRICING_ENGINE_STATS_STRATEGY_LATENCY_MAX_OFFSET, &pSummary->maxLatency);
+    }
+
+    if (retval == XLNX_OK)
+    {
+        retval = ReadStatsReg32(pSnapshot, baseOffset + XLNX_PRICING_ENGINE_STATS_STRATEGY_LATENCY_SUM_LOWER_OFFSET, &sumLower);
+    }
+
+    if (retval == XLNX_OK)
+    {
+        retval = ReadStatsReg32(pSnapshot, baseOffset + XLNX_PRICING_ENGINE_STATS_STRATEGY_LATENCY_SUM_UPPER_OFFSET, &sumUpper);
+    }
+
+    if (retval == XLNX_OK)
+    {
+        pSummary->totalLatency = ((uint64_t)sumUpper << 32) | sumLower;
+    }
+
+    return retval;
+}
+
+
+
+
+
+
+uint32_t PricingEngine::ReadLatencyHistogram(bool bIngress, LatencyHistogram* pHistogram)
+{
+    uint32_t retval = XLNX_OK;
+    uint32_t control = 0;
+    uint32_t mask = XLNX_PRICING_ENGINE_LATENCY_BIN_SELECT_MASK << XLNX_PRICING_ENGINE_LATENCY_BIN_SELECT_SHIFT;
+    uint64_t binOffset = XLNX_PRICING_ENGINE_STATS_LATENCY_BIN_OFFSET;
+    LatencySummary summary;
+    uint32_t value;
+    uint32_t i;
+
+    if (bIngress)
+    {
+        binOffset = XLNX_PRICING_ENGINE_STATS_INGRESS_LATENCY_BIN_OFFSET;
+    }
+
+    retval = CheckIsInitialised();
+
+    if (retval == XLNX_OK)
+    {
+        retval = ReadReg32(XLNX_PRICING_ENGINE_LATENCY_CONTROL_OFFSET, &control);
+    }
+
+    if (retval == XLNX_OK)
+    {
+        pHistogram->binShift = control & XLNX_PRICING_ENGINE_LATENCY_BIN_SHIFT_MASK;
+
+        retval = ReadLatencySummary(bIngress, &summary);
+    }
+
+    if (retval == XLNX_OK)
+    {
+        pHistogram->numSamples = summary.numSamples;
+        pHistogram->minLatency = summary.minLatency;
+        pHistogram->maxLatency = summary.maxLatency;
+        pHistogram->totalLatency = summary.totalLatency;
+    }
+
+    //the bins share a single status register per probe, each is selected in turn via the control register
+    for (i = 0; (i < XLNX_PRICING_ENGINE_NUM_LATENCY_BINS) && (retval == XLNX_OK); i++)
+    {
+        value = i << XLNX_PRICING_ENGINE_LATENCY_BIN_SELECT_SHIFT;
+
+        retval = WriteRegWithMask32(XLNX_PRICING_ENGINE_LATENCY_CONTROL_OFFSET, value, mask);
+
+        if (retval == XLNX_OK)
+        {
+            retval = ReadReg32(binOffset, &pHistogram->bins[i]);
+        }
+    }
+
+    return retval;
+}
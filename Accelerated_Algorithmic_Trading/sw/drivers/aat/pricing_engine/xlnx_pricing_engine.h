@@ -22,8 +22,10 @@
 #include <cstdint>
 
 #include "xlnx_device_interface.h"
+#include "xlnx_telemetry_register_snapshot.h"
 
 #include "xlnx_pricing_engine_error_codes.h"
+#include "xlnx_pricing_engine_address_map.h"
 
 
 namespace XLNX
@@ -47,6 +49,15 @@ public:
 
 
 public:
+    //Summary of one latency probe, see the Latency section below
+    typedef struct
+    {
+        uint32_t numSamples;
+        uint32_t minLatency;
+        uint32_t maxLatency;
+        uint64_t totalLatency;              //sum of all samples, mean is totalLatency / numSamples
+    }LatencySummary;
+
     typedef struct
     {
         uint32_t numRxResponses;
@@ -56,9 +67,25 @@ public:
         uint32_t numStrategyNone;       //number of executions for strategy = NONE
         uint32_t numStrategyPeg;        //number of executions for strategy = PEG
         uint32_t numStrategyLimit;      //number of executions for strategy = LIMIT
+        uint32_t numStrategyCustom;     //number of executions for strategy = CUSTOM
         uint32_t numStrategyUnknown;    //number of executions for strategy = UNKNOWN
 
         uint32_t numClockTickEvents;
+
+        uint32_t numCreditsAvailable;   //number of operations that can currently be sent to OrderEntry
+        uint32_t numCreditStalls;       //number of cycles an operation was held waiting on a credit
+
+        uint32_t numExecReports;        //execution reports received from OrderEntry
+        uint32_t numExecFills;          //partial and full fills applied to position
+        uint32_t numExecRejects;
+        uint32_t numExecUnmatched;      //reports with no matching order in the order table
+
+        LatencySummary egressLatency;       //wire to leaving this kernel
+        LatencySummary ingressLatency;      //wire to entering this kernel
+
+        LatencySummary pegLatency;          //egress latency split by the strategy that placed the order
+        LatencySummary limitLatency;
+        LatencySummary customLatency;
     } Stats;
 
     uint32_t GetStats(Stats* pStats);
@@ -121,7 +148,8 @@ public: //Pricing Strategy
     {
         STRATEGY_NONE   = 0,
         STRATEGY_PEG    = 1,
-        STRATEGY_LIMIT  = 2
+        STRATEGY_LIMIT  = 2,
+        STRATEGY_CUSTOM = 3
 
     }PricingStrategy;
 
@@ -136,6 +164,38 @@ public: //Pricing Strategy
     uint32_t SetGlobalStrategy(PricingStrategy strategy);
     uint32_t GetGlobalStrategy(PricingStrategy* pStrategy);
 
+    //Symbol Strategy - applies when global strategy mode is disabled
+    uint32_t SetSymbolStrategy(uint32_t symbolIndex, PricingStrategy strategy);
+    uint32_t GetSymbolStrategy(uint32_t symbolIndex, PricingStrategy* pStrategy);
+
+    //Position Threshold - when enabled, the PEG and LIMIT strategies will only
+    //                     place an order if the resulting position does not
+    //                     exceed the threshold
+    uint32_t SetSymbolPositionThreshold(uint32_t symbolIndex, bool bEnabled, uint32_t threshold);
+    uint32_t GetSymbolPositionThreshold(uint32_t symbolIndex, bool* pbEnabled, uint32_t* pThreshold);
+
+
+
+
+public: //Credits
+
+    //Operations are only sent to OrderEntry while a credit is held, credits are
+    //returned as OrderEntry consumes operations. The limit controls the number
+    //of operations allowed in flight (0 = HW default)
+    uint32_t SetCreditLimit(uint32_t creditLimit);
+    uint32_t GetCreditLimit(uint32_t* pCreditLimit);
+
+
+
+
+public: //Order Lifetime
+
+    //When non-zero, each order placed arms a one-shot timer in the clock tick generator
+    //timer wheel, the resting order is cancelled by HW when it expires. The lifetime is
+    //programmed in timer wheel revolutions (0 = disabled)
+    uint32_t SetOrderLifetime(uint32_t revolutions);
+    uint32_t GetOrderLifetime(uint32_t* pRevolutions);
+
 
 
 
@@ -151,6 +211,47 @@ public:
 
 
 
+public: //Latency
+
+    //Cycles from packet arrival at the LineHandler port filter to the order operation forwarded to OrderEntry,
+    //collected in a histogram of XLNX_PRICING_ENGINE_NUM_LATENCY_BINS bins each (1 << binShift) cycles wide,
+    //the last bin also holds any sample beyond the histogram range.
+    //Samples are taken against this kernel's own time base, which is not synchronised with the LineHandler time base
+    //that stamped the packet, so both histograms carry the same unknown offset and only their difference is meaningful.
+    //The ingress histogram covers the same cycles up to the point the book response is pulled from the OrderBook stream,
+    //so the difference of the two means approximates the time spent inside this kernel, to within the few cycles
+    //either probe may read the kernel time base late and any difference in the messages the two probes sample
+    typedef struct
+    {
+        uint32_t numSamples;
+        uint32_t minLatency;
+        uint32_t maxLatency;
+        uint64_t totalLatency;              //sum of all samples, mean is totalLatency / numSamples
+        uint32_t binShift;
+        uint32_t bins[XLNX_PRICING_ENGINE_NUM_LATENCY_BINS];
+    }LatencyHistogram;
+
+    uint32_t SetLatencyBinShift(uint32_t binShift);
+    uint32_t GetLatencyHistogram(LatencyHistogram* pHistogram);
+    uint32_t GetIngressLatencyHistogram(LatencyHistogram* pHistogram);
+    uint32_t ResetLatencyHistogram(void);
+
+
+
+
+
+public: //Telemetry
+    //While pTelemetry is sampling, GetStats takes the registers covered by its blocks from the latest
+    //snapshot instead of the device.  NULL (the default) always reads the device.
+    uint32_t SetTelemetry(Telemetry* pTelemetry);
+
+
+
+
+
+
+
+
 public:
     void IsInitialised(bool* pbIsInitialised);
     uint32_t GetCUIndex(uint32_t* pCUIndex);
@@ -166,6 +267,10 @@ public:
 protected:
     uint32_t CheckIsInitialised(void);
 
+    uint32_t ReadLatencySummary(bool bIngress, LatencySummary* pSummary, TelemetryRegisterSnapshot* pSnapshot = nullptr);
+    uint32_t ReadStrategyLatencySummary(uint32_t strategyIndex, LatencySummary* pSummary, TelemetryRegisterSnapshot* pSnapshot = nullptr);
+    uint32_t ReadLatencyHistogram(bool bIngress, LatencyHistogram* pHistogram);
+
     // the follow functions provide a form of mutual exclusion to the order book data.
     // i.e they enable/disable HW updates to the data registers.
     uint32_t FreezeData(void);
@@ -180,6 +285,8 @@ protected:
 
 protected:
     uint32_t ReadReg32(uint64_t offset, uint32_t* value);
+    //from pSnapshot if it covers the register, otherwise from the device
+    uint32_t ReadStatsReg32(TelemetryRegisterSnapshot* pSnapshot, uint64_t offset, uint32_t* value);
     uint32_t WriteReg32(uint64_t offset, uint32_t value);
     uint32_t WriteRegWithMask32(uint64_t offset, uint32_t value, uint32_t mask);
     uint32_t BlockReadReg32(uint64_t offset, uint32_t* buffer, uint32_t numWords);
@@ -193,6 +300,7 @@ protected:
     uint64_t m_cuAddress;
     uint32_t m_cuIndex;
     DeviceInterface* m_pDeviceInterface;
+    Telemetry* m_pTelemetry;
 
     char m_cuName[DeviceInterface::MAX_CU_NAME_LENGTH + 1];
 
@@ -34,6 +34,10 @@
 
 #define XLNX_PRICING_ENGINE_GLOBAL_STRATEGY_CONTOL_OFFSET				(0x00000028)
 
+#define XLNX_PRICING_ENGINE_CREDIT_LIMIT_OFFSET                         (0x00000030)
+
+#define XLNX_PRICING_ENGINE_ORDER_LIFETIME_OFFSET                       (0x00000038)
+
 #define XLNX_PRICING_ENGINE_STATUS_FLAGS_OFFSET                         (0x00000050)
 
 #define XLNX_PRICING_ENGINE_STATS_RX_RESPONSE_COUNT_OFFSET              (0x00000058)
@@ -44,12 +48,35 @@
 #define XLNX_PRICING_ENGINE_STATS_STRATEGY_LIMIT_COUNT_OFFSET           (0x000000A8)
 #define XLNX_PRICING_ENGINE_STATS_STRATEGY_UNKNOWN_COUNT_OFFSET         (0x000000B8)
 #define XLNX_PRICING_ENGINE_STATS_CLOCK_TICK_EVENTS_COUNT_OFFSET        (0x000000C8)
+#define XLNX_PRICING_ENGINE_STATS_CREDIT_AVAILABLE_OFFSET               (0x000000E0)
+#define XLNX_PRICING_ENGINE_STATS_CREDIT_STALL_COUNT_OFFSET             (0x000000F0)
+#define XLNX_PRICING_ENGINE_STATS_STRATEGY_CUSTOM_COUNT_OFFSET          (0x00000100)
 
 
-#define XLNX_PRICING_ENGINE_CAPTURE_OFFSET					            (0x00000110)
+#define XLNX_PRICING_ENGINE_CAPTURE_OFFSET					            (0x00000140)
 #define XLNX_PRICING_ENGINE_NUM_CAPTURE_REGISTERS                       (6)
 
 
+/* Execution report status, follows the per symbol strategy table */
+#define XLNX_PRICING_ENGINE_STATS_EXEC_REPORT_COUNT_OFFSET              (0x00002000)
+#define XLNX_PRICING_ENGINE_STATS_EXEC_FILL_COUNT_OFFSET                (0x00002010)
+#define XLNX_PRICING_ENGINE_STATS_EXEC_REJECT_COUNT_OFFSET              (0x00002020)
+#define XLNX_PRICING_ENGINE_STATS_EXEC_UNMATCHED_COUNT_OFFSET           (0x00002030)
+
+
+/* Per symbol strategy table, 4 x 32-bit words per symbol */
+#define XLNX_PRICING_ENGINE_SYMBOL_STRATEGY_BASE_OFFSET                 (0x00001000)
+#define XLNX_PRICING_ENGINE_SYMBOL_STRATEGY_STRIDE                      (0x00000010)
+#define XLNX_PRICING_ENGINE_SYMBOL_STRATEGY_SELECT_OFFSET               (0x00000000)
+#define XLNX_PRICING_ENGINE_SYMBOL_STRATEGY_ENABLE_OFFSET               (0x00000004)
+#define XLNX_PRICING_ENGINE_SYMBOL_STRATEGY_THRESHOLD_OFFSET            (0x00000008)
+
+
+
+
+
+
+
 
 
 
@@ -64,8 +91,36 @@
 
 
 
+/* Wire-to-stage latency histograms at stage egress and ingress, see hw/common/include/aat_latency.hpp */
+#define XLNX_PRICING_ENGINE_LATENCY_CONTROL_OFFSET                  (0x00000040)
+#define XLNX_PRICING_ENGINE_STATS_LATENCY_COUNT_OFFSET              (0x00002040)
+#define XLNX_PRICING_ENGINE_STATS_LATENCY_MIN_OFFSET                (0x00002050)
+#define XLNX_PRICING_ENGINE_STATS_LATENCY_MAX_OFFSET                (0x00002060)
+#define XLNX_PRICING_ENGINE_STATS_LATENCY_BIN_OFFSET                (0x00002070)
+#define XLNX_PRICING_ENGINE_STATS_LATENCY_SUM_LOWER_OFFSET          (0x00002080)
+#define XLNX_PRICING_ENGINE_STATS_LATENCY_SUM_UPPER_OFFSET          (0x00002090)
+#define XLNX_PRICING_ENGINE_STATS_INGRESS_LATENCY_COUNT_OFFSET      (0x000020A0)
+#define XLNX_PRICING_ENGINE_STATS_INGRESS_LATENCY_MIN_OFFSET        (0x000020B0)
+#define XLNX_PRICING_ENGINE_STATS_INGRESS_LATENCY_MAX_OFFSET        (0x000020C0)
+#define XLNX_PRICING_ENGINE_STATS_INGRESS_LATENCY_BIN_OFFSET        (0x000020D0)
+#define XLNX_PRICING_ENGINE_STATS_INGRESS_LATENCY_SUM_LOWER_OFFSET  (0x000020E0)
+#define XLNX_PRICING_ENGINE_STATS_INGRESS_LATENCY_SUM_UPPER_OFFSET  (0x000020F0)
 
+/* Egress latency split by strategy (PEG, LIMIT, CUSTOM), one block of the fields above per strategy */
+#define XLNX_PRICING_ENGINE_STATS_STRATEGY_LATENCY_BASE_OFFSET      (0x00002100)
+#define XLNX_PRICING_ENGINE_STATS_STRATEGY_LATENCY_STRIDE           (0x00000060)
+#define XLNX_PRICING_ENGINE_STATS_STRATEGY_LATENCY_COUNT_OFFSET     (0x00000000)
+#define XLNX_PRICING_ENGINE_STATS_STRATEGY_LATENCY_MIN_OFFSET       (0x00000010)
+#define XLNX_PRICING_ENGINE_STATS_STRATEGY_LATENCY_MAX_OFFSET       (0x00000020)
+#define XLNX_PRICING_ENGINE_STATS_STRATEGY_LATENCY_BIN_OFFSET       (0x00000030)
+#define XLNX_PRICING_ENGINE_STATS_STRATEGY_LATENCY_SUM_LOWER_OFFSET (0x00000040)
+#define XLNX_PRICING_ENGINE_STATS_STRATEGY_LATENCY_SUM_UPPER_OFFSET (0x00000050)
 
+#define XLNX_PRICING_ENGINE_NUM_LATENCY_BINS                        (16)
+#define XLNX_PRICING_ENGINE_LATENCY_BIN_SHIFT_MASK                  (0x1F)
+#define XLNX_PRICING_ENGINE_LATENCY_BIN_SELECT_SHIFT                (8)
+#define XLNX_PRICING_ENGINE_LATENCY_BIN_SELECT_MASK                 (0x0F)
+#define XLNX_PRICING_ENGINE_LATENCY_RESET_SHIFT                     (31)
 
 
 
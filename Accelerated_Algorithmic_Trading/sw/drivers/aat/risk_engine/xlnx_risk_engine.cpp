@@ -0,0 +1,1279 @@
+/*
+ * Copyright 2021 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+
+#include <string.h>
+
+#include "xlnx_risk_engine.h"
+#include "xlnx_risk_engine_address_map.h"
+using namespace XLNX;
+
+
+
+
+static const uint32_t IS_INITIALISED_MAGIC_NUMBER = 0x2B9C41E7;
+
+
+RiskEngine::RiskEngine()
+{
+    m_pDeviceInterface = nullptr;
+    m_pTelemetry = nullptr;
+    m_cuAddress = 0;
+    m_cuIndex = 0;
+    m_initialisedMagicNumber = 0;
+
+    memset(m_symbolLimits, 0, sizeof(m_symbolLimits));
+}
+
+
+
+RiskEngine::~RiskEngine()
+{
+
+
+}
+
+
+
+
+
+uint32_t RiskEngine::Initialise(DeviceInterface* pDeviceInterface, const char* cuName)
+{
+    uint32_t retval = XLNX_OK;
+
+    m_initialisedMagicNumber = 0;	//will be set to magic number if we successfully initialise...
+
+    m_pDeviceInterface = pDeviceInterface;
+
+    strncpy(m_cuName, cuName, DeviceInterface::MAX_CU_NAME_LENGTH);
+    m_cuName[DeviceInterface::MAX_CU_NAME_LENGTH] = '\0'; //always terminate the string...
+
+
+    retval = m_pDeviceInterface->GetCUAddress(cuName, &m_cuAddress);
+
+    if (retval != XLNX_OK)
+    {
+        retval = XLNX_RISK_ENGINE_ERROR_CU_NAME_NOT_FOUND;
+    }
+
+
+
+    if (retval == XLNX_OK)
+    {
+        retval = m_pDeviceInterface->GetCUIndex(cuName, &m_cuIndex);
+
+        if (retval != XLNX_OK)
+        {
+            retval = XLNX_RISK_ENGINE_ERROR_CU_NAME_NOT_FOUND;
+        }
+    }
+
+
+
+
+
+    if (retval == XLNX_OK)
+    {
+        m_initialisedMagicNumber = IS_INITIALISED_MAGIC_NUMBER;
+    }
+
+    return retval;
+}
+
+
+
+
+
+
+
+
+
+
+uint32_t RiskEngine::GetCUIndex(uint32_t* pCUIndex)
+{
+    uint32_t retval = XLNX_OK;
+
+    retval = CheckIsInitialised();
+
+    if (retval == XLNX_OK)
+    {
+        *pCUIndex = m_cuIndex;
+    }
+
+    return retval;
+}
+
+
+
+
+uint32_t RiskEngine::GetCUAddress(uint64_t* pCUAddress)
+{
+    uint32_t retval = XLNX_OK;
+
+    retval = CheckIsInitialised();
+
+    if (retval == XLNX_OK)
+    {
+        *pCUAddress = m_cuAddress;
+    }
+
+    return retval;
+}
+
+
+
+
+
+
+
+
+
+
+
+
+
+uint32_t RiskEngine::GetStats(RiskEngine::Stats* pStats)
+{
+    uint32_t retval = XLNX_OK;
+    TelemetryRegisterSnapshot snapshot;
+
+    retval = CheckIsInitialised();
+
+    if (retval == XLNX_OK)
+    {
+        //no snapshot (sampling stopped or no telemetry set) just means every register is read from the device
+        snapshot.Load(m_pTelemetry);
+    }
+
+    if (retval == XLNX_OK)
+    {
+        retval = ReadStatsReg32(&snapshot, XLNX_RISK_ENGINE_STATS_RX_RESPONSE_COUNT_OFFSET, &pStats->numRxResponses);
+    }
+
+    if (retval == XLNX_OK)
+    {
+        retval = ReadStatsReg32(&snapshot, XLNX_RISK_ENGINE_STATS_RX_OPERATIONS_COUNT_OFFSET, &pStats->numRxOperations);
+    }
+
+    if (retval == XLNX_OK)
+    {
+        retval = ReadStatsReg32(&snapshot, XLNX_RISK_ENGINE_STATS_TX_OPERATIONS_COUNT_OFFSET, &pStats->numTxOperations);
+    }
+
+    if (retval == XLNX_OK)
+    {
+        retval = ReadStatsReg32(&snapshot, XLNX_RISK_ENGINE_STATS_REJECT_KILL_SWITCH_COUNT_OFFSET, &pStats->numRejectKillSwitch);
+    }
+
+    if (retval == XLNX_OK)
+    {
+        retval = ReadStatsReg32(&snapshot, XLNX_RISK_ENGINE_STATS_REJECT_QUANTITY_COUNT_OFFSET, &pStats->numRejectQuantity);
+    }
+
+    if (retval == XLNX_OK)
+    {
+        retval = ReadStatsReg32(&snapshot, XLNX_RISK_ENGINE_STATS_REJECT_NOTIONAL_COUNT_OFFSET, &pStats->numRejectNotional);
+    }
+
+    if (retval == XLNX_OK)
+    {
+        retval = ReadStatsReg32(&snapshot, XLNX_RISK_ENGINE_STATS_REJECT_PRICE_BAND_COUNT_OFFSET, &pStats->numRejectPriceBand);
+    }
+
+    if (retval == XLNX_OK)
+    {
+        retval = ReadStatsReg32(&snapshot, XLNX_RISK_ENGINE_STATS_REJECT_POSITION_COUNT_OFFSET, &pStats->numRejectPosition);
+    }
+
+    if (retval == XLNX_OK)
+    {
+        retval = ReadStatsReg32(&snapshot, XLNX_RISK_ENGINE_STATS_REJECT_GLOBAL_POSITION_COUNT_OFFSET, &pStats->numRejectGlobalPosition);
+    }
+
+    if (retval == XLNX_OK)
+    {
+        retval = ReadStatsReg32(&snapshot, XLNX_RISK_ENGINE_STATS_REJECT_RATE_COUNT_OFFSET, &pStats->numRejectRate);
+    }
+
+    if (retval == XLNX_OK)
+    {
+        retval = ReadStatsReg32(&snapshot, XLNX_RISK_ENGINE_STATS_REJECT_GLOBAL_RATE_COUNT_OFFSET, &pStats->numRejectGlobalRate);
+    }
+
+    if (retval == XLNX_OK)
+    {
+        retval = ReadStatsReg32(&snapshot, XLNX_RISK_ENGINE_STATS_CLOCK_TICK_EVENTS_COUNT_OFFSET, &pStats->numClockTickEvents);
+    }
+
+    if (retval == XLNX_OK)
+    {
+        retval = ReadLatencySummary(false, &pStats->egressLatency, &snapshot);
+    }
+
+    if (retval == XLNX_OK)
+    {
+        retval = ReadLatencySummary(true, &pStats->ingressLatency, &snapshot);
+    }
+
+    return retval;
+}
+
+
+
+
+
+
+
+
+
+
+
+
+uint32_t RiskEngine::ResetStats(void)
+{
+    uint32_t retval = XLNX_OK;
+
+    retval = CheckIsInitialised();
+
+    if (retval == XLNX_OK)
+    {
+        retval = SetResetControlBit(XLNX_RISK_ENGINE_RESET_CONTROL_RESET_COUNT_BIT, true);
+    }
+
+    if (retval == XLNX_OK)
+    {
+        retval = SetResetControlBit(XLNX_RISK_ENGINE_RESET_CONTROL_RESET_COUNT_BIT, false);
+    }
+
+    return retval;
+}
+
+
+
+
+
+
+
+
+uint32_t RiskEngine::ResetPositions(void)
+{
+    uint32_t retval = XLNX_OK;
+    uint32_t value;
+
+    retval = CheckIsInitialised();
+
+    if (retval == XLNX_OK)
+    {
+        retval = SetResetControlBit(XLNX_RISK_ENGINE_RESET_CONTROL_RESET_DATA_BIT, true);
+    }
+
+    if (retval == XLNX_OK)
+    {
+        //HW sweeps one symbol and one open order slot per clock cycle while the reset bit is held. A register read
+        //round trip is far longer than MAX_NUM_SYMBOLS clock cycles so this guarantees
+        //the full table has been cleared before we release the reset.
+        for (uint32_t i = 0; i < 4; i++)
+        {
+            if (retval == XLNX_OK)
+            {
+                retval = ReadReg32(XLNX_RISK_ENGINE_STATUS_FLAGS_OFFSET, &value);
+            }
+        }
+    }
+
+    if (retval == XLNX_OK)
+    {
+        retval = SetResetControlBit(XLNX_RISK_ENGINE_RESET_CONTROL_RESET_DATA_BIT, false);
+    }
+
+    return retval;
+}
+
+
+
+
+
+
+
+
+
+uint32_t RiskEngine::SetChecksEnabled(uint32_t checkMask)
+{
+    uint32_t retval = XLNX_OK;
+
+    retval = CheckIsInitialised();
+
+    if (retval == XLNX_OK)
+    {
+        if ((checkMask & ~((uint32_t)CHECK_ALL)) != 0)
+        {
+            retval = XLNX_RISK_ENGINE_ERROR_INVALID_PARAMETER;
+        }
+    }
+
+    if (retval == XLNX_OK)
+    {
+        retval = WriteReg32(XLNX_RISK_ENGINE_CHECK_CONFIG_OFFSET, checkMask);
+    }
+
+    return retval;
+}
+
+
+
+
+
+
+uint32_t RiskEngine::GetChecksEnabled(uint32_t* pCheckMask)
+{
+    uint32_t retval = XLNX_OK;
+    uint32_t value;
+
+    retval = CheckIsInitialised();
+
+    if (retval == XLNX_OK)
+    {
+        retval = ReadReg32(XLNX_RISK_ENGINE_CHECK_CONFIG_OFFSET, &value);
+    }
+
+    if (retval == XLNX_OK)
+    {
+        *pCheckMask = value & (uint32_t)CHECK_ALL;
+    }
+
+    return retval;
+}
+
+
+
+
+
+
+uint32_t RiskEngine::SetKillSwitch(bool bEngaged)
+{
+    uint32_t retval = XLNX_OK;
+
+    retval = CheckIsInitialised();
+
+    if (retval == XLNX_OK)
+    {
+        retval = SetResetControlBit(XLNX_RISK_ENGINE_RESET_CONTROL_KILL_SWITCH_BIT, bEngaged);
+    }
+
+    return retval;
+}
+
+
+
+
+
+
+uint32_t RiskEngine::GetKillSwitch(bool* pbEngaged)
+{
+    uint32_t retval = XLNX_OK;
+
+    retval = CheckIsInitialised();
+
+    if (retval == XLNX_OK)
+    {
+        retval = GetResetControlBit(XLNX_RISK_ENGINE_RESET_CONTROL_KILL_SWITCH_BIT, pbEngaged);
+    }
+
+    return retval;
+}
+
+
+
+
+
+
+
+
+uint32_t RiskEngine::SetSymbolLimits(uint32_t symbolIndex, SymbolLimits* pLimits)
+{
+    uint32_t retval = XLNX_OK;
+    uint32_t rateConfig;
+
+    retval = CheckIsInitialised();
+
+    if (retval == XLNX_OK)
+    {
+        retval = CheckSymbolIndex(symbolIndex);
+    }
+
+    if (retval == XLNX_OK)
+    {
+        if ((pLimits->rateTokensPerTick > MAX_RATE_TOKENS) || (pLimits->rateBucketDepth > MAX_RATE_TOKENS))
+        {
+            retval = XLNX_RISK_ENGINE_ERROR_RATE_LIMIT_OUT_OF_RANGE;
+        }
+    }
+
+    if (retval == XLNX_OK)
+    {
+        retval = WriteLimit(symbolIndex, XLNX_RISK_ENGINE_LIMIT_FIELD_MAX_QUANTITY, pLimits->maxQuantity);
+    }
+
+    if (retval == XLNX_OK)
+    {
+        retval = WriteLimit(symbolIndex, XLNX_RISK_ENGINE_LIMIT_FIELD_MAX_NOTIONAL_LO, (uint32_t)(pLimits->maxNotional & 0xFFFFFFFF));
+    }
+
+    if (retval == XLNX_OK)
+    {
+        retval = WriteLimit(symbolIndex, XLNX_RISK_ENGINE_LIMIT_FIELD_MAX_NOTIONAL_HI, (uint32_t)(pLimits->maxNotional >> 32));
+    }
+
+    if (retval == XLNX_OK)
+    {
+        retval = WriteLimit(symbolIndex, XLNX_RISK_ENGINE_LIMIT_FIELD_MAX_POSITION, pLimits->maxPosition);
+    }
+
+    if (retval == XLNX_OK)
+    {
+        retval = WriteLimit(symbolIndex, XLNX_RISK_ENGINE_LIMIT_FIELD_PRICE_BAND, pLimits->priceBand);
+    }
+
+    if (retval == XLNX_OK)
+    {
+        rateConfig = (pLimits->rateBucketDepth << 16) | pLimits->rateTokensPerTick;
+
+        retval = WriteLimit(symbolIndex, XLNX_RISK_ENGINE_LIMIT_FIELD_RATE, rateConfig);
+    }
+
+    if (retval == XLNX_OK)
+    {
+        m_symbolLimits[symbolIndex] = *pLimits;
+    }
+
+    return retval;
+}
+
+
+
+
+
+
+uint32_t RiskEngine::GetSymbolLimits(uint32_t symbolIndex, SymbolLimits* pLimits)
+{
+    uint32_t retval = XLNX_OK;
+
+    retval = CheckIsInitialised();
+
+    if (retval == XLNX_OK)
+    {
+        retval = CheckSymbolIndex(symbolIndex);
+    }
+
+    if (retval == XLNX_OK)
+    {
+        *pLimits = m_symbolLimits[symbolIndex];
+    }
+
+    return retval;
+}
+
+
+
+
+
+
+
+
+uint32_t RiskEngine::SetGlobalPositionLimit(uint32_t limit)
+{
+    uint32_t retval = XLNX_OK;
+
+    retval = CheckIsInitialised();
+
+    if (retval == XLNX_OK)
+    {
+        retval = WriteReg32(XLNX_RISK_ENGINE_GLOBAL_POSITION_LIMIT_OFFSET, limit);
+    }
+
+    return retval;
+}
+
+
+
+
+
+
+uint32_t RiskEngine::GetGlobalPositionLimit(uint32_t* pLimit)
+{
+    uint32_t retval = XLNX_OK;
+
+    retval = CheckIsInitialised();
+
+    if (retval == XLNX_OK)
+    {
+        retval = ReadReg32(XLNX_RISK_ENGINE_GLOBAL_POSITION_LIMIT_OFFSET, pLimit);
+    }
+
+    return retval;
+}
+
+
+
+
+
+
+uint32_t RiskEngine::SetGlobalRateLimit(uint32_t tokensPerTick, uint32_t bucketDepth)
+{
+    uint32_t retval = XLNX_OK;
+    uint32_t value;
+
+    retval = CheckIsInitialised();
+
+    if (retval == XLNX_OK)
+    {
+        if ((tokensPerTick > MAX_RATE_TOKENS) || (bucketDepth > MAX_RATE_TOKENS))
+        {
+            retval = XLNX_RISK_ENGINE_ERROR_RATE_LIMIT_OUT_OF_RANGE;
+        }
+    }
+
+    if (retval == XLNX_OK)
+    {
+        value = (bucketDepth << 16) | tokensPerTick;
+
+        retval = WriteReg32(XLNX_RISK_ENGINE_GLOBAL_RATE_LIMIT_OFFSET, value);
+    }
+
+    return retval;
+}
+
+
+
+
+
+
+uint32_t RiskEngine::GetGlobalRateLimit(uint32_t* pTokensPerTick, uint32_t* pBucketDepth)
+{
+    uint32_t retval = XLNX_OK;
+    uint32_t value;
+
+    retval = CheckIsInitialised();
+
+    if (retval == XLNX_OK)
+    {
+        retval = ReadReg32(XLNX_RISK_ENGINE_GLOBAL_RATE_LIMIT_OFFSET, &value);
+    }
+
+    if (retval == XLNX_OK)
+    {
+        *pTokensPerTick = value & 0x0000FFFF;
+        *pBucketDepth = (value >> 16) & 0x0000FFFF;
+    }
+
+    return retval;
+}
+
+
+
+
+
+
+uint32_t RiskEngine::GetGlobalPosition(uint32_t* pPosition)
+{
+    uint32_t retval = XLNX_OK;
+
+    retval = CheckIsInitialised();
+
+    if (retval == XLNX_OK)
+    {
+        retval = ReadReg32(XLNX_RISK_ENGINE_GLOBAL_POSITION_OFFSET, pPosition);
+    }
+
+    return retval;
+}
+
+
+
+
+
+
+uint32_t RiskEngine::GetLastReject(uint32_t* pSymbolIndex, RejectReason* pReason)
+{
+    uint32_t retval = XLNX_OK;
+    uint32_t value;
+
+    retval = CheckIsInitialised();
+
+    if (retval == XLNX_OK)
+    {
+        retval = ReadReg32(XLNX_RISK_ENGINE_LAST_REJECT_OFFSET, &value);
+    }
+
+    if (retval == XLNX_OK)
+    {
+        *pReason = (RejectReason)(value & 0x000000FF);
+        *pSymbolIndex = (value >> 8) & 0x000000FF;
+    }
+
+    return retval;
+}
+
+
+
+
+
+
+
+
+
+
+
+
+uint32_t RiskEngine::ReadData(RiskEngineData* pData)
+{
+    uint32_t retval = XLNX_OK;
+    uint32_t buffer[XLNX_RISK_ENGINE_NUM_CAPTURE_REGISTERS];
+
+    retval = CheckIsInitialised();
+
+
+    if (retval == XLNX_OK)
+    {
+        //Stop HW updates...
+        retval = FreezeData();
+    }
+
+    if (retval == XLNX_OK)
+    {
+        //Take a snapshot of the data....
+        retval = BlockReadReg32(XLNX_RISK_ENGINE_CAPTURE_OFFSET, buffer, XLNX_RISK_ENGINE_NUM_CAPTURE_REGISTERS);
+    }
+
+
+
+    if (retval == XLNX_OK)
+    {
+        //Capture holds the last operation passed to order entry, same packed layout as
+        //the pricing engine capture (see XLNX::PricingEngine::ReadData)
+        pData->orderSide        = (OrderSide) (buffer[0] & 0x000000FF);
+        pData->orderPrice       = ((buffer[0] >> 8) & 0x00FFFFFF) | ((buffer[1] << 24) & 0xFF000000);
+        pData->orderQuantity    = ((buffer[1] >> 8) & 0x00FFFFFF) | ((buffer[2] << 24) & 0xFF000000);
+        pData->orderID          = ((buffer[2] >> 8) & 0x00FFFFFF) | ((buffer[3] << 24) & 0xFF000000);
+        pData->symbolIndex      = ((buffer[3] >> 8) & 0x000000FF);
+        pData->orderOperation   = (OrderOperation) ((buffer[3] >> 16) & 0x000000FF);
+    }
+
+
+    if (retval == XLNX_OK)
+    {
+        //Restart HW updates...
+        retval = UnfreezeData();
+    }
+
+    return retval;
+}
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+uint32_t RiskEngine::Start(void)
+{
+    uint32_t retval = XLNX_OK;
+
+    retval = CheckIsInitialised();
+
+    if (retval == XLNX_OK)
+    {
+        retval = SetResetControlBit(XLNX_RISK_ENGINE_RESET_CONTROL_HALT_BIT, false);
+    }
+
+    return retval;
+}
+
+
+
+
+
+
+uint32_t RiskEngine::Stop(void)
+{
+    uint32_t retval = XLNX_OK;
+
+    retval = CheckIsInitialised();
+
+    if (retval == XLNX_OK)
+    {
+        retval = SetResetControlBit(XLNX_RISK_ENGINE_RESET_CONTROL_HALT_BIT, true);
+    }
+
+    return retval;
+}
+
+
+
+
+
+
+uint32_t RiskEngine::IsRunning(bool* pbIsRunning)
+{
+    uint32_t retval = XLNX_OK;
+    bool bHalted = false;
+
+    retval = CheckIsInitialised();
+
+    if (retval == XLNX_OK)
+    {
+        retval = GetResetControlBit(XLNX_RISK_ENGINE_RESET_CONTROL_HALT_BIT, &bHalted);
+    }
+
+    if (retval == XLNX_OK)
+    {
+        *pbIsRunning = !bHalted;
+    }
+
+    return retval;
+}
+
+
+
+
+
+
+uint32_t RiskEngine::SetLatencyBinShift(uint32_t binShift)
+{
+    uint32_t retval = XLNX_OK;
+    uint32_t mask = XLNX_RISK_ENGINE_LATENCY_BIN_SHIFT_MASK;
+
+    retval = CheckIsInitialised();
+
+    if (retval == XLNX_OK)
+    {
+        if (binShift > XLNX_RISK_ENGINE_LATENCY_BIN_SHIFT_MASK)
+        {
+            retval = XLNX_RISK_ENGINE_ERROR_INVALID_PARAMETER;
+        }
+    }
+
+    if (retval == XLNX_OK)
+    {
+        retval = WriteRegWithMask32(XLNX_RISK_ENGINE_LATENCY_CONTROL_OFFSET, binShift, mask);
+    }
+
+    return retval;
+}
+
+
+
+
+
+
+uint32_t RiskEngine::GetLatencyHistogram(LatencyHistogram* pHistogram)
+{
+    return ReadLatencyHistogram(false, pHistogram);
+}
+
+
+
+
+
+
+uint32_t RiskEngine::GetIngressLatencyHistogram(LatencyHistogram* pHistogram)
+{
+    return ReadLatencyHistogram(true, pHistogram);
+}
+
+
+
+
+
+uint32_t RiskEngine::ResetLatencyHistogram(void)
+{
+    uint32_t retval = XLNX_OK;
+    uint32_t shift = XLNX_RISK_ENGINE_LATENCY_RESET_SHIFT;
+    uint32_t mask = 0x01;
+    uint32_t value;
+
+    retval = CheckIsInitialised();
+
+    if (retval == XLNX_OK)
+    {
+        mask = mask << shift;
+
+        value = 1;
+        value = value << shift;
+
+        retval = WriteRegWithMask32(XLNX_RISK_ENGINE_LATENCY_CONTROL_OFFSET, value, mask);
+    }
+
+    if (retval == XLNX_OK)
+    {
+        value = 0;
+        value = value << shift;
+        retval = WriteRegWithMask32(XLNX_RISK_ENGINE_LATENCY_CONTROL_OFFSET, value, mask);
+    }
+
+    return retval;
+}
+
+
+
+
+
+
+
+uint32_t RiskEngine::ReadLatencySummary(bool bIngress, LatencySummary* pSummary, TelemetryRegisterSnapshot* pSnapshot)
+{
+    uint32_t retval = XLNX_OK;
+    uint64_t countOffset = XLNX_RISK_ENGINE_STATS_LATENCY_COUNT_OFFSET;
+    uint64_t minOffset = XLNX_RISK_ENGINE_STATS_LATENCY_MIN_OFFSET;
+    uint64_t maxOffset = XLNX_RISK_ENGINE_STATS_LATENCY_MAX_OFFSET;
+    uint64_t sumLowerOffset = XLNX_RISK_ENGINE_STATS_LATENCY_SUM_LOWER_OFFSET;
+    uint64_t sumUpperOffset = XLNX_RISK_ENGINE_STATS_LATENCY_SUM_UPPER_OFFSET;
+    uint32_t sumLower = 0;
+    uint32_t sumUpper = 0;
+
+    if (bIngress)
+    {
+        countOffset = XLNX_RISK_ENGINE_STATS_INGRESS_LATENCY_COUNT_OFFSET;
+        minOffset = XLNX_RISK_ENGINE_STATS_INGRESS_LATENCY_MIN_OFFSET;
+        maxOffset = XLNX_RISK_ENGINE_STATS_INGRESS_LATENCY_MAX_OFFSET;
+        sumLowerOffset = XLNX_RISK_ENGINE_STATS_INGRESS_LATENCY_SUM_LOWER_OFFSET;
+        sumUpperOffset = XLNX_RISK_ENGINE_STATS_INGRESS_LATENCY_SUM_UPPER_OFFSET;
+    }
+
+    retval = CheckIsInitialised();
+
+    if (retval == XLNX_OK)
+    {
+        retval = ReadStatsReg32(pSnapshot, countOffset, &pSummary->numSamples);
+    }
+
+    if (retval == XLNX_OK)
+    {
+        retval = ReadStatsReg32(pSnapshot, minOffset, &pSummary->minLatency);
+    }
+
+    if (retval == XLNX_OK)
+    {
+        retval = ReadStatsReg32(pSnapshot, maxOffset, &pSummary->maxLatency);
+    }
+
+    if (retval == XLNX_OK)
+    {
+        retval = ReadStatsReg32(pSnapshot, sumLowerOffset, &sumLower);
+    }
+
+    if (retval == XLNX_OK)
+    {
+        retval = ReadStatsReg32(pSnapshot, sumUpperOffset, &sumUpper);
+    }
+
+    if (retval == XLNX_OK)
+    {
+        pSummary->totalLatency = ((uint64_t)sumUpper << 32) | sumLower;
+    }
+
+    return retval;
+}
+
+
+
+
+
+
+uint32_t RiskEngine::ReadLatencyHistogram(bool bIngress, LatencyHistogram* pHistogram)
+{
+    uint32_t retval = XLNX_OK;
+    uint32_t control = 0;
+    uint32_t mask = XLNX_RISK_ENGINE_LATENCY_BIN_SELECT_MASK << XLNX_RISK_ENGINE_LATENCY_BIN_SELECT_SHIFT;
+    uint64_t binOffset = XLNX_RISK_ENGINE_STATS_LATENCY_BIN_OFFSET;
+    LatencySummary summary;
+    uint32_t value;
+    uint32_t i;
+
+    if (bIngress)
+    {
+        binOffset = XLNX_RISK_ENGINE_STATS_INGRESS_LATENCY_BIN_OFFSET;
+    }
+
+    retval = CheckIsInitialised();
+
+    if (retval == XLNX_OK)
+    {
+        retval = ReadReg32(XLNX_RISK_ENGINE_LATENCY_CONTROL_OFFSET, &control);
+    }
+
+    if (retval == XLNX_OK)
+    {
+        pHistogram->binShift = control & XLNX_RISK_ENGINE_LATENCY_BIN_SHIFT_MASK;
+
+        retval = ReadLatencySummary(bIngress, &summary);
+    }
+
+    if (retval == XLNX_OK)
+    {
+        pHistogram->numSamples = summary.numSamples;
+        pHistogram->minLatency = summary.minLatency;
+        pHistogram->maxLatency = summary.maxLatency;
+        pHistogram->totalLatency = summary.totalLatency;
+    }
+
+    //the bins share a single status register per probe, each is selected in turn via the control register
+    for (i = 0; (i < XLNX_RISK_ENGINE_NUM_LATENCY_BINS) && (retval == XLNX_OK); i++)
+    {
+        value = i << XLNX_RISK_ENGINE_LATENCY_BIN_SELECT_SHIFT;
+
+        retval = WriteRegWithMask32(XLNX_RISK_ENGINE_LATENCY_CONTROL_OFFSET, value, mask);
+
+        if (retval == XLNX_OK)
+        {
+            retval = ReadReg32(binOffset, &pHistogram->bins[i]);
+        }
+    }
+
+    return retval;
+}
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+uint32_t RiskEngine::CheckIsInitialised(void)
+{
+    uint32_t retval = XLNX_OK;
+
+    if (m_initialisedMagicNumber != IS_INITIALISED_MAGIC_NUMBER)
+    {
+        retval = XLNX_RISK_ENGINE_ERROR_NOT_INITIALISED;
+    }
+
+    return retval;
+}
+
+
+
+
+
+
+
+
+uint32_t RiskEngine::SetTelemetry(Telemetry* pTelemetry)
+{
+    m_pTelemetry = pTelemetry;
+
+    return XLNX_OK;
+}
+
+
+
+
+
+
+void RiskEngine::IsInitialised(bool* pbIsInitialised)
+{
+    if (CheckIsInitialised() == XLNX_OK)
+    {
+        *pbIsInitialised = true;
+    }
+    else
+    {
+        *pbIsInitialised = false;
+    }
+}
+
+
+
+
+
+
+uint32_t RiskEngine::CheckSymbolIndex(uint32_t symbolIndex)
+{
+    uint32_t retval = XLNX_OK;
+
+    if (symbolIndex >= MAX_NUM_SYMBOLS)
+    {
+        retval = XLNX_RISK_ENGINE_ERROR_SYMBOL_INDEX_OUT_OF_RANGE;
+    }
+
+    return retval;
+}
+
+
+
+
+
+
+uint32_t RiskEngine::WriteLimit(uint32_t symbolIndex, uint32_t field, uint32_t value)
+{
+    uint32_t retval = XLNX_OK;
+    uint32_t selectValue;
+
+    //HW applies a limit table write when it sees the strobe bit toggle, so we need
+    //to read back the current strobe state and invert it...
+    retval = ReadReg32(XLNX_RISK_ENGINE_LIMIT_SELECT_OFFSET, &selectValue);
+
+    if (retval == XLNX_OK)
+    {
+        //value MUST be in place before the strobe toggles
+        retval = WriteReg32(XLNX_RISK_ENGINE_LIMIT_VALUE_OFFSET, value);
+    }
+
+    if (retval == XLNX_OK)
+    {
+        selectValue = (selectValue ^ XLNX_RISK_ENGINE_LIMIT_SELECT_STROBE_MASK) & XLNX_RISK_ENGINE_LIMIT_SELECT_STROBE_MASK;
+        selectValue |= (field << XLNX_RISK_ENGINE_LIMIT_SELECT_FIELD_SHIFT);
+        selectValue |= (symbolIndex & XLNX_RISK_ENGINE_LIMIT_SELECT_SYMBOL_MASK);
+
+        retval = WriteReg32(XLNX_RISK_ENGINE_LIMIT_SELECT_OFFSET, selectValue);
+    }
+
+    return retval;
+}
+
+
+
+
+
+
+uint32_t RiskEngine::SetResetControlBit(uint32_t shift, bool bSet)
+{
+    uint32_t retval = XLNX_OK;
+    uint32_t value;
+    uint32_t mask = 0x01;
+
+    if (bSet)
+    {
+        value = 1;
+    }
+    else
+    {
+        value = 0;
+    }
+
+    value = value << shift;
+    mask = mask << shift;
+
+    retval = WriteRegWithMask32(XLNX_RISK_ENGINE_RESET_CONTROL_OFFSET, value, mask);
+
+    return retval;
+}
+
+
+
+
+
+
+uint32_t RiskEngine::GetResetControlBit(uint32_t shift, bool* pbSet)
+{
+    uint32_t retval = XLNX_OK;
+    uint32_t value;
+
+    retval = ReadReg32(XLNX_RISK_ENGINE_RESET_CONTROL_OFFSET, &value);
+
+    if (retval == XLNX_OK)
+    {
+        *pbSet = (((value >> shift) & 0x01) != 0);
+    }
+
+    return retval;
+}
+
+
+
+
+
+
+
+
+
+
+
+uint32_t RiskEngine::FreezeData(void)
+{
+    uint32_t retval = XLNX_OK;
+    uint32_t value;
+    uint32_t mask = 0x01;
+    uint32_t shift = 31;
+
+    //set the capture-freeze bit
+    value = 1;
+
+    value = value << shift;
+    mask = mask << shift;
+
+    retval = WriteRegWithMask32(XLNX_RISK_ENGINE_CAPTURE_CONTROL_OFFSET, value, mask);
+
+
+    return retval;
+}
+
+
+
+
+
+
+uint32_t RiskEngine::UnfreezeData(void)
+{
+    uint32_t retval = XLNX_OK;
+    uint32_t value;
+    uint32_t mask = 0x01;
+    uint32_t shift = 31;
+
+    //clear the capture-freeze bit
+    value = 0;
+
+    value = value << shift;
+    mask = mask << shift;
+
+    retval = WriteRegWithMask32(XLNX_RISK_ENGINE_CAPTURE_CONTROL_OFFSET, value, mask);
+
+
+    return retval;
+}
+
+
+
+
+
+
+
+
+
+
+uint32_t RiskEngine::ReadReg32(uint64_t offset, uint32_t* value)
+{
+    uint32_t retval = XLNX_OK;
+    uint64_t address;
+
+
+    address = m_cuAddress + offset;
+
+    retval = m_pDeviceInterface->ReadReg32(address, value);
+
+
+
+
+    if (retval != XLNX_OK)
+    {
+        retval = XLNX_RISK_ENGINE_ERROR_IO_FAILED;
+    }
+
+    return retval;
+}
+
+
+
+
+
+
+uint32_t RiskEngine::ReadStatsReg32(TelemetryRegisterSnapshot* pSnapshot, uint64_t offset, uint32_t* value)
+{
+    uint32_t retval = XLNX_OK;
+
+    if ((pSnapshot == nullptr) || (pSnapshot->ReadReg32(m_cuAddress + offset, value) != XLNX_OK))
+    {
+        retval = ReadReg32(offset, value);
+    }
+
+    return retval;
+}
+
+
+
+
+
+
+uint32_t RiskEngine::WriteReg32(uint64_t offset, uint32_t value)
+{
+    uint32_t retval = XLNX_OK;
+    uint64_t address;
+
+
+    address = m_cuAddress + offset;
+
+    retval = m_pDeviceInterface->WriteReg32(address, value);
+
+
+    if (retval != XLNX_OK)
+    {
+        retval = XLNX_RISK_ENGINE_ERROR_IO_FAILED;
+    }
+
+    return retval;
+}
+
+
+
+
+uint32_t RiskEngine::WriteRegWithMask32(uint64_t offset, uint32_t value, uint32_t mask)
+{
+    uint32_t retval = XLNX_OK;
+    uint64_t address;
+
+
+    address = m_cuAddress + offset;
+
+    retval = m_pDeviceInterface->WriteRegWithMask32(address, value, mask);
+
+    if (retval != XLNX_OK)
+    {
+        retval = XLNX_RISK_ENGINE_ERROR_IO_FAILED;
+    }
+
+    return retval;
+}
+
+
+
+
+
+
+uint32_t RiskEngine::BlockReadReg32(uint64_t offset, uint32_t* buffer, uint32_t numWords)
+{
+    uint32_t retval = XLNX_OK;
+    uint64_t address;
+
+
+    address = m_cuAddress + offset;
+
+    retval = m_pDeviceInterface->BlockReadReg32(address, buffer, numWords);
+
+
+    if (retval != XLNX_OK)
+    {
+        retval = XLNX_RISK_ENGINE_ERROR_IO_FAILED;
+    }
+
+    return retval;
+}
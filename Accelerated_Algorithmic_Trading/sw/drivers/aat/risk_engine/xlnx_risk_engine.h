@@ -0,0 +1,324 @@
+/*
+ * Copyright 2021 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef XLNX_RISK_ENGINE_H
+#define XLNX_RISK_ENGINE_H
+
+
+#include <cstdint>
+
+#include "xlnx_device_interface.h"
+#include "xlnx_telemetry_register_snapshot.h"
+
+#include "xlnx_risk_engine_address_map.h"
+#include "xlnx_risk_engine_error_codes.h"
+
+
+namespace XLNX
+{
+
+class RiskEngine
+{
+
+
+public:
+    RiskEngine();
+    virtual ~RiskEngine();
+
+
+public:
+    uint32_t Initialise(DeviceInterface* pDeviceInterface, const char* cuName);
+
+
+
+
+
+
+public:
+    //Summary of one latency probe, see the Latency section below
+    typedef struct
+    {
+        uint32_t numSamples;
+        uint32_t minLatency;
+        uint32_t maxLatency;
+        uint64_t totalLatency;              //sum of all samples, mean is totalLatency / numSamples
+    }LatencySummary;
+
+    typedef struct
+    {
+        uint32_t numRxResponses;
+        uint32_t numRxOperations;
+        uint32_t numTxOperations;
+
+        uint32_t numRejectKillSwitch;       //number of orders rejected while kill switch engaged
+        uint32_t numRejectQuantity;         //number of orders rejected for exceeding max order quantity
+        uint32_t numRejectNotional;         //number of orders rejected for exceeding max order notional
+        uint32_t numRejectPriceBand;        //number of orders rejected for price outside band from top of book
+        uint32_t numRejectPosition;         //number of orders rejected for exceeding per-symbol position limit
+        uint32_t numRejectGlobalPosition;   //number of orders rejected for exceeding global position limit
+        uint32_t numRejectRate;             //number of orders rejected by per-symbol rate throttle
+        uint32_t numRejectGlobalRate;       //number of orders rejected by global rate throttle
+
+        uint32_t numClockTickEvents;
+
+        LatencySummary egressLatency;       //wire to leaving this kernel
+        LatencySummary ingressLatency;      //wire to entering this kernel
+    } Stats;
+
+    uint32_t GetStats(Stats* pStats);
+    uint32_t ResetStats(void);
+
+
+
+
+
+public:
+    static const uint32_t MAX_NUM_SYMBOLS = 256;
+
+    static const uint32_t MAX_RATE_TOKENS = 0xFFFF;
+
+    typedef enum
+    {
+        CHECK_QUANTITY          = 0x01,
+        CHECK_NOTIONAL          = 0x02,
+        CHECK_PRICE_BAND        = 0x04,
+        CHECK_POSITION          = 0x08,
+        CHECK_GLOBAL_POSITION   = 0x10,
+        CHECK_RATE              = 0x20,
+        CHECK_GLOBAL_RATE       = 0x40,
+
+        CHECK_ALL               = 0x7F
+
+    }RiskCheck;
+
+
+
+    typedef enum
+    {
+        REJECT_NONE             = 0,
+        REJECT_KILL_SWITCH      = 1,
+        REJECT_QUANTITY         = 2,
+        REJECT_NOTIONAL         = 3,
+        REJECT_PRICE_BAND       = 4,
+        REJECT_POSITION         = 5,
+        REJECT_GLOBAL_POSITION  = 6,
+        REJECT_RATE             = 7,
+        REJECT_GLOBAL_RATE      = 8
+
+    }RejectReason;
+
+
+
+    typedef struct
+    {
+        uint32_t maxQuantity;           //max quantity of a single order
+        uint64_t maxNotional;           //max quantity * price of a single order
+        uint32_t maxPosition;           //max absolute position should every open order on one side fill
+        uint32_t priceBand;             //max distance of order price from same side top of book
+        uint32_t rateTokensPerTick;     //order tokens added to bucket per clock tick event
+        uint32_t rateBucketDepth;       //max order tokens held in bucket (i.e. burst size)
+
+    }SymbolLimits;
+
+
+
+    typedef enum
+    {
+        ORDER_SIDE_BID = 0,
+        ORDER_SIDE_ASK = 1
+
+    }OrderSide;
+
+
+
+    typedef enum
+    {
+        ORDER_OPERATION_ADD     = 0,
+        ORDER_OPERATION_MODIFY  = 1,
+        ORDER_OPERATION_DELETE  = 2
+
+    }OrderOperation;
+
+
+
+    typedef struct
+    {
+        uint32_t       symbolIndex;
+        OrderSide      orderSide;
+        OrderOperation orderOperation;
+        uint32_t       orderID;
+        uint32_t       orderPrice;
+        uint32_t       orderQuantity;
+
+    } RiskEngineData;
+
+
+
+
+public:
+    //Risk checks are individually enabled by bitmask of RiskCheck values
+    uint32_t SetChecksEnabled(uint32_t checkMask);
+    uint32_t GetChecksEnabled(uint32_t* pCheckMask);
+
+    //Kill switch - when engaged ALL new and modified orders are rejected,
+    //              deletes are always allowed to pass
+    uint32_t SetKillSwitch(bool bEngaged);
+    uint32_t GetKillSwitch(bool* pbEngaged);
+
+    uint32_t SetSymbolLimits(uint32_t symbolIndex, SymbolLimits* pLimits);
+    uint32_t GetSymbolLimits(uint32_t symbolIndex, SymbolLimits* pLimits);
+
+    uint32_t SetGlobalPositionLimit(uint32_t limit);
+    uint32_t GetGlobalPositionLimit(uint32_t* pLimit);
+
+    uint32_t SetGlobalRateLimit(uint32_t tokensPerTick, uint32_t bucketDepth);
+    uint32_t GetGlobalRateLimit(uint32_t* pTokensPerTick, uint32_t* pBucketDepth);
+
+    //Sum across all symbols of the worst case position should every open order on one side fill
+    uint32_t GetGlobalPosition(uint32_t* pPosition);
+
+    uint32_t GetLastReject(uint32_t* pSymbolIndex, RejectReason* pReason);
+
+    //Clears filled positions, open order exposure and rate buckets for all symbols
+    uint32_t ResetPositions(void);
+
+    uint32_t ReadData(RiskEngineData* pData);
+
+
+
+
+
+
+public:
+    uint32_t Start(void);
+    uint32_t Stop(void);
+    uint32_t IsRunning(bool* pbIsRunning);
+
+
+
+
+
+
+
+public: //Latency
+
+    //Cycles from packet arrival at the LineHandler port filter to the checked order operation forwarded to OrderEntry,
+    //collected in a histogram of XLNX_RISK_ENGINE_NUM_LATENCY_BINS bins each (1 << binShift) cycles wide,
+    //the last bin also holds any sample beyond the histogram range.
+    //Samples are taken against this kernel's own time base, which is not synchronised with the LineHandler time base
+    //that stamped the packet, so both histograms carry the same unknown offset and only their difference is meaningful.
+    //The ingress histogram covers the same cycles up to the point the order operation is pulled from the PricingEngine stream,
+    //so the difference of the two means approximates the time spent inside this kernel, to within the few cycles
+    //either probe may read the kernel time base late and any difference in the messages the two probes sample
+    typedef struct
+    {
+        uint32_t numSamples;
+        uint32_t minLatency;
+        uint32_t maxLatency;
+        uint64_t totalLatency;              //sum of all samples, mean is totalLatency / numSamples
+        uint32_t binShift;
+        uint32_t bins[XLNX_RISK_ENGINE_NUM_LATENCY_BINS];
+    }LatencyHistogram;
+
+    uint32_t SetLatencyBinShift(uint32_t binShift);
+    uint32_t GetLatencyHistogram(LatencyHistogram* pHistogram);
+    uint32_t GetIngressLatencyHistogram(LatencyHistogram* pHistogram);
+    uint32_t ResetLatencyHistogram(void);
+
+
+
+
+
+
+
+public: //Telemetry
+    //While pTelemetry is sampling, GetStats takes the registers covered by its blocks from the latest
+    //snapshot instead of the device.  NULL (the default) always reads the device.
+    uint32_t SetTelemetry(Telemetry* pTelemetry);
+
+
+
+
+
+
+
+
+public:
+    void IsInitialised(bool* pbIsInitialised);
+    uint32_t GetCUIndex(uint32_t* pCUIndex);
+    uint32_t GetCUAddress(uint64_t* pCUAddress);
+
+
+
+
+
+
+
+
+protected:
+    uint32_t CheckIsInitialised(void);
+
+    uint32_t ReadLatencySummary(bool bIngress, LatencySummary* pSummary, TelemetryRegisterSnapshot* pSnapshot = nullptr);
+    uint32_t ReadLatencyHistogram(bool bIngress, LatencyHistogram* pHistogram);
+
+    uint32_t CheckSymbolIndex(uint32_t symbolIndex);
+
+    uint32_t WriteLimit(uint32_t symbolIndex, uint32_t field, uint32_t value);
+
+    uint32_t SetResetControlBit(uint32_t shift, bool bSet);
+    uint32_t GetResetControlBit(uint32_t shift, bool* pbSet);
+
+    uint32_t FreezeData(void);
+    uint32_t UnfreezeData(void);
+
+
+
+
+
+protected:
+    uint32_t ReadReg32(uint64_t offset, uint32_t* value);
+    //from pSnapshot if it covers the register, otherwise from the device
+    uint32_t ReadStatsReg32(TelemetryRegisterSnapshot* pSnapshot, uint64_t offset, uint32_t* value);
+    uint32_t WriteReg32(uint64_t offset, uint32_t value);
+    uint32_t WriteRegWithMask32(uint64_t offset, uint32_t value, uint32_t mask);
+    uint32_t BlockReadReg32(uint64_t offset, uint32_t* buffer, uint32_t numWords);
+
+
+
+
+
+protected:
+    uint32_t m_initialisedMagicNumber;
+    uint64_t m_cuAddress;
+    uint32_t m_cuIndex;
+    DeviceInterface* m_pDeviceInterface;
+    Telemetry* m_pTelemetry;
+
+    char m_cuName[DeviceInterface::MAX_CU_NAME_LENGTH + 1];
+
+    //the HW limit table is write-only from the host, keep a shadow copy for readback
+    SymbolLimits m_symbolLimits[MAX_NUM_SYMBOLS];
+
+};
+
+
+
+} //end namespace XLNX
+
+
+
+#endif //XLNX_RISK_ENGINE_H
@@ -0,0 +1,118 @@
+/*
+ * Copyright 2021 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef XLNX_RISK_ENGINE_ADDRESS_MAP_H
+#define XLNX_RISK_ENGINE_ADDRESS_MAP_H
+
+
+
+
+ /* The following are the standard kernel control registers */
+#define XLNX_RISK_ENGINE_KERNEL_CONTROL_OFFSET							(0x00000000)
+#define XLNX_RISK_ENGINE_KERNEL_GLOBAL_INTERRUPT_ENABLE_OFFSET			(0x00000004)
+#define XLNX_RISK_ENGINE_KERNEL_IP_INTERRUPT_ENABLE_OFFSET				(0x00000008)
+#define XLNX_RISK_ENGINE_KERNEL_IP_INTERRUPT_STATUS_OFFSET				(0x0000000C)
+
+
+#define XLNX_RISK_ENGINE_RESET_CONTROL_OFFSET                           (0x00000010)
+
+#define XLNX_RISK_ENGINE_CHECK_CONFIG_OFFSET                            (0x00000018)
+
+#define XLNX_RISK_ENGINE_CAPTURE_CONTROL_OFFSET                         (0x00000020)
+
+#define XLNX_RISK_ENGINE_GLOBAL_POSITION_LIMIT_OFFSET                   (0x00000028)
+#define XLNX_RISK_ENGINE_GLOBAL_RATE_LIMIT_OFFSET                       (0x00000030)
+
+#define XLNX_RISK_ENGINE_LIMIT_SELECT_OFFSET                            (0x00000038)
+#define XLNX_RISK_ENGINE_LIMIT_VALUE_OFFSET                             (0x00000040)
+
+#define XLNX_RISK_ENGINE_STATUS_FLAGS_OFFSET                            (0x00000050)
+
+#define XLNX_RISK_ENGINE_STATS_RX_RESPONSE_COUNT_OFFSET                 (0x00000058)
+#define XLNX_RISK_ENGINE_STATS_RX_OPERATIONS_COUNT_OFFSET               (0x00000068)
+#define XLNX_RISK_ENGINE_STATS_TX_OPERATIONS_COUNT_OFFSET               (0x00000078)
+#define XLNX_RISK_ENGINE_STATS_REJECT_KILL_SWITCH_COUNT_OFFSET          (0x00000088)
+#define XLNX_RISK_ENGINE_STATS_REJECT_QUANTITY_COUNT_OFFSET             (0x00000098)
+#define XLNX_RISK_ENGINE_STATS_REJECT_NOTIONAL_COUNT_OFFSET             (0x000000A8)
+#define XLNX_RISK_ENGINE_STATS_REJECT_PRICE_BAND_COUNT_OFFSET           (0x000000B8)
+#define XLNX_RISK_ENGINE_STATS_REJECT_POSITION_COUNT_OFFSET             (0x000000C8)
+#define XLNX_RISK_ENGINE_STATS_REJECT_GLOBAL_POSITION_COUNT_OFFSET      (0x000000D8)
+#define XLNX_RISK_ENGINE_STATS_REJECT_RATE_COUNT_OFFSET                 (0x000000E8)
+#define XLNX_RISK_ENGINE_STATS_CLOCK_TICK_EVENTS_COUNT_OFFSET           (0x000000F8)
+
+#define XLNX_RISK_ENGINE_GLOBAL_POSITION_OFFSET                         (0x00000108)
+#define XLNX_RISK_ENGINE_LAST_REJECT_OFFSET                             (0x00000118)
+#define XLNX_RISK_ENGINE_STATS_REJECT_GLOBAL_RATE_COUNT_OFFSET          (0x00000128)
+
+
+#define XLNX_RISK_ENGINE_CAPTURE_OFFSET                                 (0x00000138)
+#define XLNX_RISK_ENGINE_NUM_CAPTURE_REGISTERS                          (6)
+
+
+/* Wire-to-stage latency histograms at stage egress and ingress, see hw/common/include/aat_latency.hpp */
+#define XLNX_RISK_ENGINE_LATENCY_CONTROL_OFFSET                     (0x00000048)
+#define XLNX_RISK_ENGINE_STATS_LATENCY_COUNT_OFFSET                 (0x000001C0)
+#define XLNX_RISK_ENGINE_STATS_LATENCY_MIN_OFFSET                   (0x000001D0)
+#define XLNX_RISK_ENGINE_STATS_LATENCY_MAX_OFFSET                   (0x000001E0)
+#define XLNX_RISK_ENGINE_STATS_LATENCY_BIN_OFFSET                   (0x000001F0)
+#define XLNX_RISK_ENGINE_STATS_LATENCY_SUM_LOWER_OFFSET             (0x00000200)
+#define XLNX_RISK_ENGINE_STATS_LATENCY_SUM_UPPER_OFFSET             (0x00000210)
+#define XLNX_RISK_ENGINE_STATS_INGRESS_LATENCY_COUNT_OFFSET         (0x00000220)
+#define XLNX_RISK_ENGINE_STATS_INGRESS_LATENCY_MIN_OFFSET           (0x00000230)
+#define XLNX_RISK_ENGINE_STATS_INGRESS_LATENCY_MAX_OFFSET           (0x00000240)
+#define XLNX_RISK_ENGINE_STATS_INGRESS_LATENCY_BIN_OFFSET           (0x00000250)
+#define XLNX_RISK_ENGINE_STATS_INGRESS_LATENCY_SUM_LOWER_OFFSET     (0x00000260)
+#define XLNX_RISK_ENGINE_STATS_INGRESS_LATENCY_SUM_UPPER_OFFSET     (0x00000270)
+
+#define XLNX_RISK_ENGINE_NUM_LATENCY_BINS                           (16)
+#define XLNX_RISK_ENGINE_LATENCY_BIN_SHIFT_MASK                     (0x1F)
+#define XLNX_RISK_ENGINE_LATENCY_BIN_SELECT_SHIFT                   (8)
+#define XLNX_RISK_ENGINE_LATENCY_BIN_SELECT_MASK                    (0x0F)
+#define XLNX_RISK_ENGINE_LATENCY_RESET_SHIFT                        (31)
+
+
+
+
+
+/* Bit definitions for the above registers */
+#define XLNX_RISK_ENGINE_RESET_CONTROL_HALT_BIT                         (0)
+#define XLNX_RISK_ENGINE_RESET_CONTROL_RESET_DATA_BIT                   (1)
+#define XLNX_RISK_ENGINE_RESET_CONTROL_RESET_COUNT_BIT                  (2)
+#define XLNX_RISK_ENGINE_RESET_CONTROL_KILL_SWITCH_BIT                  (3)
+
+#define XLNX_RISK_ENGINE_LIMIT_SELECT_SYMBOL_MASK                       (0x000000FF)
+#define XLNX_RISK_ENGINE_LIMIT_SELECT_FIELD_SHIFT                       (8)
+#define XLNX_RISK_ENGINE_LIMIT_SELECT_STROBE_MASK                       (0x80000000)
+
+#define XLNX_RISK_ENGINE_LIMIT_FIELD_MAX_QUANTITY                       (0)
+#define XLNX_RISK_ENGINE_LIMIT_FIELD_MAX_NOTIONAL_LO                    (1)
+#define XLNX_RISK_ENGINE_LIMIT_FIELD_MAX_NOTIONAL_HI                    (2)
+#define XLNX_RISK_ENGINE_LIMIT_FIELD_MAX_POSITION                       (3)
+#define XLNX_RISK_ENGINE_LIMIT_FIELD_PRICE_BAND                         (4)
+#define XLNX_RISK_ENGINE_LIMIT_FIELD_RATE                               (5)
+
+
+
+
+
+
+
+
+
+
+
+#endif
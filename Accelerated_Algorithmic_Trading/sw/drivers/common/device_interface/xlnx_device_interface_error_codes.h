@@ -48,5 +48,6 @@
 #define XLNX_DEV_INTERFACE_ERROR_FAILED_TO_UNMAP_BUFFER                 (0x00000018)
 #define XLNX_DEV_INTERFACE_ERROR_FAILED_TO_SYNC_BUFFER                  (0x00000019)
 #define XLNX_DEV_INTERFACE_ERROR_POLL_STREAM_FAILED                     (0x0000001A)
+#define XLNX_DEV_INTERFACE_ERROR_CU_LIMIT_REACHED                       (0x0000001B)
 #endif
 
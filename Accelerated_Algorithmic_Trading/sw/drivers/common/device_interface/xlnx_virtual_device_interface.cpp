@@ -43,6 +43,12 @@ static const uint32_t VIRTUAL_DEVICE_BUFFER_DESCRIPTOR_MAGIC_NUMBER = 0x4BA782CF
 VirtualDeviceInterface::VirtualDeviceInterface()
 {
 	m_numCUs = 0;
+	m_bStrictCUNames = false;
+
+	for (uint32_t i = 0; i < MAX_SUPPORTED_CUS; i++)
+	{
+		m_cus[i] = nullptr;
+	}
 
 	//set up some dummy MAC addresses...
 	for (uint32_t i = 0; i < MACAddresses::NUM_SUPPORTED_MAC_ADDRESSES; i++)
@@ -63,7 +69,11 @@ VirtualDeviceInterface::VirtualDeviceInterface()
 
 VirtualDeviceInterface::~VirtualDeviceInterface()
 {
-
+	for (uint32_t i = 0; i < MAX_SUPPORTED_CUS; i++)
+	{
+		delete m_cus[i];
+		m_cus[i] = nullptr;
+	}
 }
 
 
@@ -93,7 +103,7 @@ void VirtualDeviceInterface::Close(void)
 
 uint32_t VirtualDeviceInterface::ReadReg32(uint64_t address, uint32_t* value)
 {
-	return InternalRead32(m_regMap, address, value);
+	return InternalReadReg32(address, value);
 }
 
 
@@ -101,7 +111,7 @@ uint32_t VirtualDeviceInterface::ReadReg32(uint64_t address, uint32_t* value)
 
 uint32_t VirtualDeviceInterface::WriteReg32(uint64_t address, uint32_t value)
 {
-	return InternalWrite32(m_regMap, address, value);
+	return InternalWriteReg32(address, value);
 }
 
 
@@ -113,17 +123,26 @@ uint32_t VirtualDeviceInterface::WriteRegWithMask32(uint64_t address, uint32_t v
 {
 	uint32_t retval = XLNX_OK;
 	uint32_t regValue;
+	uint32_t cuIndex;
+	uint64_t offset;
 
-	retval = InternalRead32(m_regMap, address, &regValue);
-	
-	if (retval == XLNX_OK)
+	if (ConvertAddressToCUIndexOffset(address, &cuIndex, &offset) == XLNX_OK)
 	{
-		regValue = regValue & ~mask;
-		value = value & mask;
+		retval = InternalWriteCURegWithMask32(m_cus[cuIndex], offset, value, mask);
+	}
+	else
+	{
+		retval = InternalReadReg32(address, &regValue);
 
-		regValue = regValue | value;
+		if (retval == XLNX_OK)
+		{
+			regValue = regValue & ~mask;
+			value = value & mask;
+
+			regValue = regValue | value;
 
-		retval = InternalWrite32(m_regMap, address, regValue);
+			retval = InternalWriteReg32(address, regValue);
+		}
 	}
 
 	return retval;
@@ -135,15 +154,25 @@ uint32_t VirtualDeviceInterface::WriteRegWithMask32(uint64_t address, uint32_t v
 uint32_t VirtualDeviceInterface::BlockReadReg32(uint64_t address, uint32_t* buffer, uint32_t numWords)
 {
 	uint32_t retval = XLNX_OK;
+	uint32_t cuIndex;
+	uint64_t offset;
 
-
-	for (uint64_t i = 0; i < numWords; i++)
+	if ((ConvertAddressToCUIndexOffset(address, &cuIndex, &offset) == XLNX_OK) &&
+		((offset + ((uint64_t)numWords * sizeof(uint32_t))) <= MAX_SUPPORTED_CU_SIZE))
 	{
-		retval = InternalRead32(m_regMap, (address + (i * 4)), &buffer[i]);
-
-		if (retval != XLNX_OK)
+		retval = InternalBlockReadCUReg32(m_cus[cuIndex], offset, buffer, numWords);
+	}
+	else
+	{
+		//block is outside of (or straddles) a CU...
+		for (uint64_t i = 0; i < numWords; i++)
 		{
-			break; //out of loop 
+			retval = InternalReadReg32((address + (i * 4)), &buffer[i]);
+
+			if (retval != XLNX_OK)
+			{
+				break; //out of loop 
+			}
 		}
 	}
 
@@ -159,15 +188,25 @@ uint32_t VirtualDeviceInterface::BlockReadReg32(uint64_t address, uint32_t* buff
 uint32_t VirtualDeviceInterface::BlockWriteReg32(uint64_t address, uint32_t* buffer, uint32_t numWords)
 {
 	uint32_t retval = XLNX_OK;
+	uint32_t cuIndex;
+	uint64_t offset;
 
-
-	for (uint64_t i = 0; i < numWords; i++)
+	if ((ConvertAddressToCUIndexOffset(address, &cuIndex, &offset) == XLNX_OK) &&
+		((offset + ((uint64_t)numWords * sizeof(uint32_t))) <= MAX_SUPPORTED_CU_SIZE))
 	{
-		retval = InternalWrite32(m_regMap, (address + (i * 4)), buffer[i]);
-
-		if (retval != XLNX_OK)
+		retval = InternalBlockWriteCUReg32(m_cus[cuIndex], offset, buffer, numWords);
+	}
+	else
+	{
+		//block is outside of (or straddles) a CU...
+		for (uint64_t i = 0; i < numWords; i++)
 		{
-			break; //out of loop 
+			retval = InternalWriteReg32((address + (i * 4)), buffer[i]);
+
+			if (retval != XLNX_OK)
+			{
+				break; //out of loop 
+			}
 		}
 	}
 
@@ -300,6 +339,7 @@ uint32_t VirtualDeviceInterface::DownloadBitstream(char* filePath)
 uint32_t VirtualDeviceInterface::InternalRead32(std::map<uint64_t, uint32_t>& map, uint64_t address, uint32_t* value)
 {
 	std::map<uint64_t, uint32_t>::iterator it;
+	std::lock_guard<std::mutex> lock(m_mapMutex);
 
 	it = map.find(address);
 
@@ -323,6 +363,7 @@ uint32_t VirtualDeviceInterface::InternalRead32(std::map<uint64_t, uint32_t>& ma
 uint32_t VirtualDeviceInterface::InternalWrite32(std::map<uint64_t, uint32_t>& map, uint64_t address, uint32_t value)
 {
 	std::map<uint64_t, uint32_t>::iterator it;
+	std::lock_guard<std::mutex> lock(m_mapMutex);
 
 	it = map.find(address);
 
@@ -346,6 +387,261 @@ uint32_t VirtualDeviceInterface::InternalWrite32(std::map<uint64_t, uint32_t>& m
 
 
 
+uint32_t VirtualDeviceInterface::InternalReadReg32(uint64_t address, uint32_t* value)
+{
+	uint32_t retval = XLNX_OK;
+	uint32_t cuIndex;
+	uint64_t offset;
+
+	if (ConvertAddressToCUIndexOffset(address, &cuIndex, &offset) == XLNX_OK)
+	{
+		retval = InternalReadCUReg32(m_cus[cuIndex], offset, value);
+	}
+	else
+	{
+		retval = InternalRead32(m_regMap, address, value);
+	}
+
+	return retval;
+}
+
+
+
+
+
+
+uint32_t VirtualDeviceInterface::InternalWriteReg32(uint64_t address, uint32_t value)
+{
+	uint32_t retval = XLNX_OK;
+	uint32_t cuIndex;
+	uint64_t offset;
+
+	if (ConvertAddressToCUIndexOffset(address, &cuIndex, &offset) == XLNX_OK)
+	{
+		retval = InternalWriteCUReg32(m_cus[cuIndex], offset, value);
+	}
+	else
+	{
+		retval = InternalWrite32(m_regMap, address, value);
+	}
+
+	return retval;
+}
+
+
+
+
+
+uint32_t VirtualDeviceInterface::InternalReadCUReg32(VirtualCU* pCU, uint64_t offset, uint32_t* value)
+{
+	uint32_t retval = XLNX_OK;
+	VirtualDeviceCU* pHandler;
+
+	pHandler = pCU->pHandler.load(std::memory_order_acquire);
+
+	if (pHandler != nullptr)
+	{
+		retval = pHandler->ReadReg32(offset, value);
+	}
+	else
+	{
+		*value = pCU->registers[offset / sizeof(uint32_t)].load(std::memory_order_acquire);
+	}
+
+	return retval;
+}
+
+
+
+
+
+uint32_t VirtualDeviceInterface::InternalWriteCUReg32(VirtualCU* pCU, uint64_t offset, uint32_t value)
+{
+	uint32_t retval = XLNX_OK;
+	VirtualDeviceCU* pHandler;
+
+	pHandler = pCU->pHandler.load(std::memory_order_acquire);
+
+	if (pHandler != nullptr)
+	{
+		retval = pHandler->WriteReg32(offset, value);
+	}
+	else
+	{
+		pCU->registers[offset / sizeof(uint32_t)].store(value, std::memory_order_release);
+	}
+
+	return retval;
+}
+
+
+
+
+
+uint32_t VirtualDeviceInterface::InternalWriteCURegWithMask32(VirtualCU* pCU, uint64_t offset, uint32_t value, uint32_t mask)
+{
+	uint32_t retval = XLNX_OK;
+	VirtualDeviceCU* pHandler;
+	uint32_t regValue;
+	uint32_t newValue;
+
+	pHandler = pCU->pHandler.load(std::memory_order_acquire);
+
+	if (pHandler != nullptr)
+	{
+		retval = pHandler->ReadReg32(offset, &regValue);
+
+		if (retval == XLNX_OK)
+		{
+			retval = pHandler->WriteReg32(offset, (regValue & ~mask) | (value & mask));
+		}
+	}
+	else
+	{
+		//compare-and-swap so that bits another thread changes in the meantime are not lost
+		std::atomic<uint32_t>& reg = pCU->registers[offset / sizeof(uint32_t)];
+
+		regValue = reg.load(std::memory_order_relaxed);
+
+		do
+		{
+			newValue = (regValue & ~mask) | (value & mask);
+
+		} while (reg.compare_exchange_weak(regValue, newValue, std::memory_order_acq_rel, std::memory_order_relaxed) == false);
+	}
+
+	return retval;
+}
+
+
+
+
+
+uint32_t VirtualDeviceInterface::InternalBlockReadCUReg32(VirtualCU* pCU, uint64_t offset, uint32_t* buffer, uint32_t numWords)
+{
+	uint32_t retval = XLNX_OK;
+	VirtualDeviceCU* pHandler;
+	std::atomic<uint32_t>* pRegisters;
+
+	pHandler = pCU->pHandler.load(std::memory_order_acquire);
+
+	if (pHandler != nullptr)
+	{
+		for (uint64_t i = 0; i < numWords; i++)
+		{
+			retval = pHandler->ReadReg32(offset + (i * 4), &buffer[i]);
+
+			if (retval != XLNX_OK)
+			{
+				break; //out of loop
+			}
+		}
+	}
+	else
+	{
+		//NOTE - as on the real device, a block access is a run of individual 32-bit accesses rather
+		//       than a snapshot.  Relaxed loads compile down to a plain copy.
+		pRegisters = &pCU->registers[offset / sizeof(uint32_t)];
+
+		for (uint32_t i = 0; i < numWords; i++)
+		{
+			buffer[i] = pRegisters[i].load(std::memory_order_relaxed);
+		}
+
+		std::atomic_thread_fence(std::memory_order_acquire);
+	}
+
+	return retval;
+}
+
+
+
+
+
+uint32_t VirtualDeviceInterface::InternalBlockWriteCUReg32(VirtualCU* pCU, uint64_t offset, uint32_t* buffer, uint32_t numWords)
+{
+	uint32_t retval = XLNX_OK;
+	VirtualDeviceCU* pHandler;
+	std::atomic<uint32_t>* pRegisters;
+
+	pHandler = pCU->pHandler.load(std::memory_order_acquire);
+
+	if (pHandler != nullptr)
+	{
+		for (uint64_t i = 0; i < numWords; i++)
+		{
+			retval = pHandler->WriteReg32(offset + (i * 4), buffer[i]);
+
+			if (retval != XLNX_OK)
+			{
+				break; //out of loop
+			}
+		}
+	}
+	else
+	{
+		pRegisters = &pCU->registers[offset / sizeof(uint32_t)];
+
+		std::atomic_thread_fence(std::memory_order_release);
+
+		for (uint32_t i = 0; i < numWords; i++)
+		{
+			pRegisters[i].store(buffer[i], std::memory_order_relaxed);
+		}
+	}
+
+	return retval;
+}
+
+
+
+
+
+
+uint32_t VirtualDeviceInterface::AddCU(const char* cuName, VirtualDeviceCU* pCU)
+{
+	uint32_t retval = XLNX_OK;
+	uint32_t cuIndex = 0;
+	std::lock_guard<std::mutex> lock(m_cuRegistryMutex);
+
+	if (cuName == nullptr)
+	{
+		retval = XLNX_DEV_INTERFACE_ERROR_INVALID_PARAMETER;
+	}
+
+	if (retval == XLNX_OK)
+	{
+		retval = InternalAddNewCUIfNecessary(cuName);
+	}
+
+	if (retval == XLNX_OK)
+	{
+		retval = InternalGetCUIndex(cuName, &cuIndex);
+	}
+
+	if (retval == XLNX_OK)
+	{
+		m_cus[cuIndex]->pHandler.store(pCU, std::memory_order_release);
+	}
+
+	return retval;
+}
+
+
+
+
+
+
+void VirtualDeviceInterface::SetStrictCUNames(bool bStrict)
+{
+	m_bStrictCUNames = bStrict;
+}
+
+
+
+
+
+
 uint32_t VirtualDeviceInterface::GetArgumentMemTopologyIndex(const char* cuName, uint32_t cuArgIndex, uint32_t* pTopologyIndex)
 {
 	uint32_t retval = XLNX_OK;
@@ -516,11 +812,11 @@ uint32_t VirtualDeviceInterface::GetCUAddress(const char* cuName, uint64_t* addr
 {
 	uint32_t retval = XLNX_OK;
 	uint32_t index = 0;
-	std::map<const char*, uint32_t>::iterator it;
+	std::lock_guard<std::mutex> lock(m_cuRegistryMutex);
 
 
 
-	if (retval == XLNX_OK)
+	if ((retval == XLNX_OK) && (m_bStrictCUNames == false))
 	{
 		retval = InternalAddNewCUIfNecessary(cuName);
 	}
@@ -549,11 +845,11 @@ uint32_t VirtualDeviceInterface::GetCUAddress(const char* cuName, uint64_t* addr
 uint32_t VirtualDeviceInterface::GetCUIndex(const char* cuName, uint32_t* cuIndex)
 {
 	uint32_t retval = XLNX_OK;
-	std::map<const char*, uint32_t>::iterator it;
+	std::lock_guard<std::mutex> lock(m_cuRegistryMutex);
 
 
 
-	if (retval == XLNX_OK)
+	if ((retval == XLNX_OK) && (m_bStrictCUNames == false))
 	{
 
 		retval = InternalAddNewCUIfNecessary(cuName);
@@ -575,8 +871,7 @@ uint32_t VirtualDeviceInterface::InternalAddNewCUIfNecessary(const char* cuName)
 {
 	uint32_t retval = XLNX_OK;
 	uint32_t cuIndex;
-	uint64_t cuAddress;
-	std::map<const char*, uint32_t>::iterator it;
+	VirtualCU* pCU;
 
 
 	//here we will try to retrieve the cuIndex for the given cuName.
@@ -591,17 +886,34 @@ uint32_t VirtualDeviceInterface::InternalAddNewCUIfNecessary(const char* cuName)
 
 	if (retval == XLNX_DEV_INTERFACE_ERROR_CU_NAME_NOT_FOUND)
 	{
-		cuIndex = m_numCUs;
-		m_numCUs++;
+		cuIndex = m_numCUs.load(std::memory_order_relaxed);
+
+		if (cuIndex < MAX_SUPPORTED_CUS)
+		{
+			pCU = new VirtualCU;
+
+			for (uint32_t i = 0; i < CU_REGISTER_FILE_NUM_WORDS; i++)
+			{
+				pCU->registers[i].store(0, std::memory_order_relaxed);
+			}
+
+			pCU->pHandler.store(nullptr, std::memory_order_relaxed);
 
-		cuAddress = CU_START_ADDRESS + (CU_OFFSET * cuIndex);
+			m_cus[cuIndex] = pCU;
 
-		//insert brand new elements with the associated value...
-		m_cuNameToIndexMap.insert(std::make_pair(cuName, cuIndex));
-		m_cuIndexToAddressMap.insert(std::make_pair(cuIndex, cuAddress));
+			//insert brand new elements with the associated value...
+			m_cuNameToIndexMap.insert(std::make_pair(cuName, cuIndex));
 
-		//update our return code to indicate everything is OK...
-		retval = XLNX_OK;		
+			//publish the new CU to the (lock-free) register access paths...
+			m_numCUs.store(cuIndex + 1, std::memory_order_release);
+
+			//update our return code to indicate everything is OK...
+			retval = XLNX_OK;
+		}
+		else
+		{
+			retval = XLNX_DEV_INTERFACE_ERROR_CU_LIMIT_REACHED;
+		}
 	}
 		
 
@@ -614,7 +926,7 @@ uint32_t VirtualDeviceInterface::InternalAddNewCUIfNecessary(const char* cuName)
 uint32_t VirtualDeviceInterface::InternalGetCUIndex(const char* cuName, uint32_t* index)
 {
 	uint32_t retval = XLNX_OK;
-	std::map<const char*, uint32_t>::iterator it;
+	std::map<std::string, uint32_t>::iterator it;
 
 
 	if (retval == XLNX_OK)
@@ -643,26 +955,33 @@ uint32_t VirtualDeviceInterface::InternalGetCUIndex(const char* cuName, uint32_t
 uint32_t VirtualDeviceInterface::InternalGetCUBaseAddress(uint32_t cuIndex, uint64_t* baseAddress)
 {
 	uint32_t retval = XLNX_OK;
-	std::map<uint32_t, uint64_t>::iterator it;
 
+	if (cuIndex < m_numCUs.load(std::memory_order_acquire))
+	{
+		*baseAddress = CU_START_ADDRESS + (CU_OFFSET * cuIndex);
+	}
+	else
+	{
+		retval = XLNX_DEV_INTERFACE_ERROR_CU_INDEX_NOT_FOUND;
+	}
+
+	return retval;
+}
 
 
-	if (retval == XLNX_OK)
-	{
-		it = m_cuIndexToAddressMap.find(cuIndex);
 
-		//if the index already existed in the map...
-		if (it != m_cuIndexToAddressMap.end())
-		{
-			*baseAddress = it->second;
-		}
-		else
-		{
-			retval = XLNX_DEV_INTERFACE_ERROR_CU_INDEX_NOT_FOUND;
-		}
+
+
+VirtualDeviceInterface::VirtualCU* VirtualDeviceInterface::InternalGetCU(uint32_t cuIndex)
+{
+	VirtualCU* pCU = nullptr;
+
+	if (cuIndex < m_numCUs.load(std::memory_order_acquire))
+	{
+		pCU = m_cus[cuIndex];
 	}
 
-	return retval;
+	return pCU;
 }
 
 
@@ -671,20 +990,26 @@ uint32_t VirtualDeviceInterface::InternalGetCUBaseAddress(uint32_t cuIndex, uint
 
 
 
+
 uint32_t VirtualDeviceInterface::ReadCUReg32(uint32_t cuIndex, uint64_t offset, uint32_t* value)
 {
 	uint32_t retval = XLNX_OK;
-	uint64_t cuBaseAddress = 0;
+	VirtualCU* pCU;
 
+	pCU = InternalGetCU(cuIndex);
 
-	if (retval == XLNX_OK)
+	if (pCU == nullptr)
 	{
-		retval = InternalGetCUBaseAddress(cuIndex, &cuBaseAddress);
+		retval = XLNX_DEV_INTERFACE_ERROR_CU_INDEX_NOT_FOUND;
+	}
+	else if ((offset + sizeof(uint32_t)) > MAX_SUPPORTED_CU_SIZE)
+	{
+		retval = XLNX_DEV_INTERFACE_ERROR_OFFSET_OUT_OF_RANGE_FOR_CU;
 	}
 
 	if (retval == XLNX_OK)
 	{
-		retval = InternalRead32(m_regMap, cuBaseAddress + offset, value);
+		retval = InternalReadCUReg32(pCU, offset, value);
 	}
 
 	return retval;
@@ -696,20 +1021,26 @@ uint32_t VirtualDeviceInterface::ReadCUReg32(uint32_t cuIndex, uint64_t offset,
 
 
 
+
 uint32_t VirtualDeviceInterface::WriteCUReg32(uint32_t cuIndex, uint64_t offset, uint32_t value)
 {
 	uint32_t retval = XLNX_OK;
-	uint64_t cuBaseAddress = 0;
+	VirtualCU* pCU;
 
+	pCU = InternalGetCU(cuIndex);
 
-	if (retval == XLNX_OK)
+	if (pCU == nullptr)
 	{
-		retval = InternalGetCUBaseAddress(cuIndex, &cuBaseAddress);
+		retval = XLNX_DEV_INTERFACE_ERROR_CU_INDEX_NOT_FOUND;
+	}
+	else if ((offset + sizeof(uint32_t)) > MAX_SUPPORTED_CU_SIZE)
+	{
+		retval = XLNX_DEV_INTERFACE_ERROR_OFFSET_OUT_OF_RANGE_FOR_CU;
 	}
 
 	if (retval == XLNX_OK)
 	{
-		retval = InternalWrite32(m_regMap, cuBaseAddress + offset, value);
+		retval = InternalWriteCUReg32(pCU, offset, value);
 	}
 
 	return retval;
@@ -723,30 +1054,26 @@ uint32_t VirtualDeviceInterface::WriteCUReg32(uint32_t cuIndex, uint64_t offset,
 
 
 
+
 uint32_t VirtualDeviceInterface::WriteCURegWithMask32(uint32_t cuIndex, uint64_t offset, uint32_t value, uint32_t mask)
 {
 	uint32_t retval = XLNX_OK;
-	uint64_t cuBaseAddress = 0;
-	uint32_t regValue;
+	VirtualCU* pCU;
 
-	if (retval == XLNX_OK)
+	pCU = InternalGetCU(cuIndex);
+
+	if (pCU == nullptr)
 	{
-		retval = InternalGetCUBaseAddress(cuIndex, &cuBaseAddress);
+		retval = XLNX_DEV_INTERFACE_ERROR_CU_INDEX_NOT_FOUND;
 	}
-
-	if (retval == XLNX_OK)
+	else if ((offset + sizeof(uint32_t)) > MAX_SUPPORTED_CU_SIZE)
 	{
-		retval = InternalRead32(m_regMap, cuBaseAddress + offset, &regValue);
+		retval = XLNX_DEV_INTERFACE_ERROR_OFFSET_OUT_OF_RANGE_FOR_CU;
 	}
-	
+
 	if (retval == XLNX_OK)
 	{
-		regValue = regValue & ~mask;
-		value = value & mask;
-
-		regValue = regValue | value;
-
-		retval = InternalWrite32(m_regMap, cuBaseAddress + offset, regValue);
+		retval = InternalWriteCURegWithMask32(pCU, offset, value, mask);
 	}
 
 	return retval;
@@ -756,31 +1083,28 @@ uint32_t VirtualDeviceInterface::WriteCURegWithMask32(uint32_t cuIndex, uint64_t
 
 
 
+
 uint32_t VirtualDeviceInterface::BlockReadCUReg32(uint32_t cuIndex, uint64_t offset, uint32_t* buffer, uint32_t numWords)
 {
 	uint32_t retval = XLNX_OK;
-	uint64_t cuBaseAddress = 0;
+	VirtualCU* pCU;
 
+	pCU = InternalGetCU(cuIndex);
 
-	if (retval == XLNX_OK)
+	if (pCU == nullptr)
+	{
+		retval = XLNX_DEV_INTERFACE_ERROR_CU_INDEX_NOT_FOUND;
+	}
+	else if ((offset + ((uint64_t)numWords * sizeof(uint32_t))) > MAX_SUPPORTED_CU_SIZE)
 	{
-		retval = InternalGetCUBaseAddress(cuIndex, &cuBaseAddress);
+		retval = XLNX_DEV_INTERFACE_ERROR_OFFSET_OUT_OF_RANGE_FOR_CU;
 	}
 
 	if (retval == XLNX_OK)
 	{
-		for (uint64_t i = 0; i < numWords; i++)
-		{
-			retval = InternalRead32(m_regMap, (cuBaseAddress + offset + (i * 4)), &buffer[i]);
-
-			if (retval != XLNX_OK)
-			{
-				break; //out of loop 
-			}
-		}
+		retval = InternalBlockReadCUReg32(pCU, offset, buffer, numWords);
 	}
 
-
 	return retval;
 }
 
@@ -789,27 +1113,26 @@ uint32_t VirtualDeviceInterface::BlockReadCUReg32(uint32_t cuIndex, uint64_t off
 
 
 
+
 uint32_t VirtualDeviceInterface::BlockWriteCUReg32(uint32_t cuIndex, uint64_t offset, uint32_t* buffer, uint32_t numWords)
 {
 	uint32_t retval = XLNX_OK;
-	uint64_t cuBaseAddress = 0;
+	VirtualCU* pCU;
 
-	if (retval == XLNX_OK)
+	pCU = InternalGetCU(cuIndex);
+
+	if (pCU == nullptr)
 	{
-		retval = InternalGetCUBaseAddress(cuIndex, &cuBaseAddress);
+		retval = XLNX_DEV_INTERFACE_ERROR_CU_INDEX_NOT_FOUND;
 	}
-	
-	if (retval == XLNX_OK)
+	else if ((offset + ((uint64_t)numWords * sizeof(uint32_t))) > MAX_SUPPORTED_CU_SIZE)
 	{
-		for (uint64_t i = 0; i < numWords; i++)
-		{
-			retval = InternalWrite32(m_regMap, (cuBaseAddress + offset + (i * 4)), buffer[i]);
+		retval = XLNX_DEV_INTERFACE_ERROR_OFFSET_OUT_OF_RANGE_FOR_CU;
+	}
 
-			if (retval != XLNX_OK)
-			{
-				break; //out of loop 
-			}
-		}
+	if (retval == XLNX_OK)
+	{
+		retval = InternalBlockWriteCUReg32(pCU, offset, buffer, numWords);
 	}
 
 	return retval;
@@ -819,6 +1142,7 @@ uint32_t VirtualDeviceInterface::BlockWriteCUReg32(uint32_t cuIndex, uint64_t of
 
 
 
+
 uint32_t VirtualDeviceInterface::OpenStream(const char* cuName, uint32_t cuStreamArgIndex, StreamDirection direction, StreamHandleType* streamHandle)
 {
 	uint32_t retval = XLNX_OK;
@@ -975,37 +1299,35 @@ xuid_t* VirtualDeviceInterface::GetBitstreamUUID(void)
 uint32_t VirtualDeviceInterface::ConvertAddressToCUIndexOffset(uint64_t address, uint32_t* cuIndex, uint64_t* offset)
 {
 	uint32_t retval = XLNX_OK;
-	std::map<uint32_t, uint64_t>::iterator it;
-	uint64_t kernelBaseAddress;
-	bool bFound = false;
+	uint64_t index;
 
-	for (it = m_cuIndexToAddressMap.begin(); it != m_cuIndexToAddressMap.end(); it++)
+	//CUs are laid out back to back from CU_START_ADDRESS, so the decode is just arithmetic...
+	if (address >= CU_START_ADDRESS)
 	{
-		kernelBaseAddress = it->second;
+		index = (address - CU_START_ADDRESS) / CU_OFFSET;
 
-		if ((address >= kernelBaseAddress) && (address < (kernelBaseAddress + MAX_SUPPORTED_CU_SIZE)))
+		if (index < m_numCUs.load(std::memory_order_acquire))
 		{
-			*cuIndex = it->first;
-			*offset = address - kernelBaseAddress;
-
-			bFound = true;
-			break; //out of loop
+			*cuIndex = (uint32_t)index;
+			*offset = (address - CU_START_ADDRESS) % CU_OFFSET;
+		}
+		else
+		{
+			retval = XLNX_DEV_INTERFACE_ERROR_CU_INDEX_NOT_FOUND;
 		}
 	}
-
-
-	if (bFound == false)
+	else
 	{
 		retval = XLNX_DEV_INTERFACE_ERROR_CU_INDEX_NOT_FOUND;
 	}
 
-
 	return retval;
 }
 
 
 
 
+
 BufferDescriptor* VirtualDeviceInterface::AllocateBufferHostOnly(uint32_t sizeInBytes, uint32_t bankInfo)
 {
 	VirtualDeviceBufferDescriptor* pVirtualDescriptor = nullptr;
@@ -15,9 +15,12 @@
  */
 
 #ifndef XLNX_VIRTUAL_DEVICE_INTERFACE_H
-#define XLNX_VIRTIAL_DEVICE_INTERFACE_H
+#define XLNX_VIRTUAL_DEVICE_INTERFACE_H
 
 #include <map>
+#include <string>
+#include <mutex>
+#include <atomic>
 
 #include "xlnx_device_interface.h"
 
@@ -42,6 +45,21 @@ namespace XLNX
 
 
 
+//A VirtualDeviceCU can be attached to a CU of the virtual device to service the register accesses
+//made to that CU (e.g. by a software model of the kernel) instead of them landing in plain storage.
+class VirtualDeviceCU
+{
+public:
+	virtual ~VirtualDeviceCU() {}
+
+	virtual uint32_t ReadReg32(uint64_t offset, uint32_t* value) = 0;
+	virtual uint32_t WriteReg32(uint64_t offset, uint32_t value) = 0;
+};
+
+
+
+
+
 class VirtualDeviceInterface : public DeviceInterface
 {
 
@@ -146,30 +164,70 @@ public:
 
 
 
+public: //CU Emulation
+	//Adds a CU to the virtual device. If pCU is non-null, all register accesses to the CU are passed to it.
+	uint32_t AddCU(const char* cuName, VirtualDeviceCU* pCU);
 
-private:
-	//NOTE - maintaining TWO seperate maps - one for registers, and one for memory...
-	std::map<uint64_t, uint32_t> m_regMap;
-	std::map<uint64_t, uint32_t> m_memMap;
-
-	uint32_t InternalRead32(std::map<uint64_t, uint32_t>& map, uint64_t address, uint32_t* value);
-	uint32_t InternalWrite32(std::map<uint64_t, uint32_t>& map, uint64_t address, uint32_t value);
+	//By default, looking up an unknown CU name creates it.  In strict mode the lookup fails instead,
+	//so only CUs added via AddCU(...) are visible (as would be the case with a real bitstream)
+	void SetStrictCUNames(bool bStrict);
 
 
 
 
 private:
-	uint32_t m_numCUs;
-	std::map<const char*, uint32_t> m_cuNameToIndexMap;
-	std::map<uint32_t, uint64_t> m_cuIndexToAddressMap;
+	static const uint32_t MAX_SUPPORTED_CUS = 64;
+	static const uint32_t CU_REGISTER_FILE_NUM_WORDS = (uint32_t)(MAX_SUPPORTED_CU_SIZE / sizeof(uint32_t));
 
 	static const uint64_t CU_START_ADDRESS = 0x01C00000;
-	static const uint64_t CU_OFFSET		   = 0x00010000;
+	static const uint64_t CU_OFFSET		   = MAX_SUPPORTED_CU_SIZE;
+
+
+	//Each CU owns a flat register file covering its whole address range.  The registers are atomic
+	//so emulated kernels running on their own threads can update them while the host polls.
+	typedef struct
+	{
+		std::atomic<uint32_t> registers[CU_REGISTER_FILE_NUM_WORDS];
+		std::atomic<VirtualDeviceCU*> pHandler;
+
+	}VirtualCU;
+
+
+	//NOTE - CUs are only ever appended.  An entry is fully set up before m_numCUs is incremented,
+	//       so the register access paths can index m_cus[] without taking a lock.
+	VirtualCU* m_cus[MAX_SUPPORTED_CUS];
+	std::atomic<uint32_t> m_numCUs;
+
+	std::map<std::string, uint32_t> m_cuNameToIndexMap;
+	std::mutex m_cuRegistryMutex;
+	bool m_bStrictCUNames;
 
 
 	uint32_t InternalAddNewCUIfNecessary(const char* cuName);
 	uint32_t InternalGetCUIndex(const char* cuName, uint32_t* index);
 	uint32_t InternalGetCUBaseAddress(uint32_t cuIndex, uint64_t* baseAddress);
+	VirtualCU* InternalGetCU(uint32_t cuIndex);
+
+	uint32_t InternalReadCUReg32(VirtualCU* pCU, uint64_t offset, uint32_t* value);
+	uint32_t InternalWriteCUReg32(VirtualCU* pCU, uint64_t offset, uint32_t value);
+	uint32_t InternalWriteCURegWithMask32(VirtualCU* pCU, uint64_t offset, uint32_t value, uint32_t mask);
+	uint32_t InternalBlockReadCUReg32(VirtualCU* pCU, uint64_t offset, uint32_t* buffer, uint32_t numWords);
+	uint32_t InternalBlockWriteCUReg32(VirtualCU* pCU, uint64_t offset, uint32_t* buffer, uint32_t numWords);
+
+
+
+
+private:
+	//NOTE - register addresses that do not fall inside a CU, and all device memory, are kept sparsely in maps...
+	std::map<uint64_t, uint32_t> m_regMap;
+	std::map<uint64_t, uint32_t> m_memMap;
+	std::mutex m_mapMutex;
+
+	uint32_t InternalRead32(std::map<uint64_t, uint32_t>& map, uint64_t address, uint32_t* value);
+	uint32_t InternalWrite32(std::map<uint64_t, uint32_t>& map, uint64_t address, uint32_t value);
+
+	uint32_t InternalReadReg32(uint64_t address, uint32_t* value);
+	uint32_t InternalWriteReg32(uint64_t address, uint32_t value);
 	
 	MACAddresses m_macAddresses;
 
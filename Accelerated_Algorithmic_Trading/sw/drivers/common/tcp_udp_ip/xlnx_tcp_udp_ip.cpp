@@ -47,6 +47,7 @@ TCPUDPIP::TCPUDPIP()
 	m_bTCPSynthesized = false;
 	m_bUDPSynthesized = false;
 
+	m_udpCapabilities = 0;
 }
 
 
@@ -110,6 +111,13 @@ uint32_t TCPUDPIP::Initialise(DeviceInterface* pDeviceInterface, const char* cuN
 	}
 
 
+	if ((retval == XLNX_OK) && m_bUDPSynthesized)
+	{
+		//The RTL UDP stack has no capabilities register and reads back 0 here...
+		retval = ReadReg32(XLNX_TCP_UDP_IP_UDP_CAPABILITIES_OFFSET, &m_udpCapabilities);
+	}
+
+
 
 	if (retval == XLNX_OK)
 	{
@@ -191,6 +199,27 @@ uint32_t TCPUDPIP::CheckUDPIsSynthesized(void)
 
 
 
+uint32_t TCPUDPIP::CheckUDPGroupFilterIsSupported(void)
+{
+	uint32_t retval = XLNX_OK;
+
+	retval = CheckUDPIsSynthesized();
+
+	if (retval == XLNX_OK)
+	{
+		//NOTE - the group table offsets are not decoded by a UDP block without the filter,
+		//       so report it rather than let the caller believe the groups are being filtered.
+		if ((m_udpCapabilities & CAPABILITY_UDP_GROUP_FILTER) == 0)
+		{
+			retval = XLNX_TCP_UDP_IP_ERROR_NOT_SUPPORTED_BY_HW;
+		}
+	}
+
+	return retval;
+}
+
+
+
 uint32_t TCPUDPIP::CheckConfigurationIsAllowed(void)
 {
 	uint32_t retval = XLNX_OK;
@@ -74,10 +74,15 @@ public: //IGMP
 	uint32_t SetIGMPEnabled(bool bEnabled);
 	uint32_t GetIGMPEnabled(bool* pbEnabled);
 
-	static const uint32_t NUM_MULTICAST_ADDRESSES_SUPPORTED = 4;
+	static const uint32_t NUM_MULTICAST_ADDRESSES_SUPPORTED = 64;
 
-	uint32_t AddIPv4MulticastAddress(uint8_t a, uint8_t b, uint8_t c, uint8_t d);
-	uint32_t DeleteIPv4MulticastAddress(uint8_t a, uint8_t b, uint8_t c, uint8_t d);
+	//With IGMPv3, bDeferReport holds back the join/leave report so the HW can send the
+	//group records of several operations in a single report.  The held records are sent
+	//with the next operation that does not defer (or by SendIGMPReport), or by the HW
+	//once it has queued one record per table entry.  Ignored with IGMPv2.
+	uint32_t AddIPv4MulticastAddress(uint8_t a, uint8_t b, uint8_t c, uint8_t d, bool bDeferReport = false);
+	uint32_t DeleteIPv4MulticastAddress(uint8_t a, uint8_t b, uint8_t c, uint8_t d, bool bDeferReport = false);
+	uint32_t SendIGMPReport(void);
 
 	//Internally the HW block maintain a table of multicast addresses.  The following function
 	//reads the specified index in the table.  NOTE - the table is a SPARSE TABLE, meaning
@@ -158,6 +163,26 @@ public: //UDP Handler
 	uint32_t GetUDPListeningPorts(uint16_t enabledPorts[NUM_LISTENING_PORTS_SUPPORTED], uint32_t* pNumEnabledPorts);
 
 
+	//When the group filter is enabled, multicast datagrams are only accepted if their (group address, port)
+	//pair is in the group table. Unicast datagrams are always filtered on the listening port alone.
+	//
+	//The group table is only present when the UDP block reports CAPABILITY_UDP_GROUP_FILTER (the HLS UDP block),
+	//otherwise these functions return XLNX_TCP_UDP_IP_ERROR_NOT_SUPPORTED_BY_HW.  Port 0 is not a valid group port.
+	static const uint32_t CAPABILITY_UDP_GROUP_FILTER = (1 << 0);
+
+	uint32_t GetUDPCapabilities(uint32_t* pCapabilities);
+
+	uint32_t SetUDPGroupFilterEnabled(bool bEnabled);
+	uint32_t GetUDPGroupFilterEnabled(bool* pbEnabled);
+
+	uint32_t AddUDPMulticastGroup(uint8_t a, uint8_t b, uint8_t c, uint8_t d, uint16_t port);
+	uint32_t DeleteUDPMulticastGroup(uint8_t a, uint8_t b, uint8_t c, uint8_t d, uint16_t port);
+	uint32_t DeleteAllUDPMulticastGroups(void);
+
+	static const uint32_t NUM_UDP_MULTICAST_GROUPS_SUPPORTED = 64;
+	uint32_t GetUDPMulticastGroups(uint32_t groupAddresses[NUM_UDP_MULTICAST_GROUPS_SUPPORTED], uint16_t groupPorts[NUM_UDP_MULTICAST_GROUPS_SUPPORTED], uint32_t* pNumGroups);
+
+
 
 public: //Stats
 
@@ -206,6 +231,7 @@ public: //Stats
 		uint32_t numTxDatagrams;
 		uint32_t numRxDatagrams;
 		uint32_t numRxDatagramsInvalidPort;
+		uint32_t numRxDatagramsInvalidGroup;
 	}UDPStats;
 
 	typedef struct
@@ -276,6 +302,7 @@ protected:
 	uint32_t CheckIsInitialised(void);
 	uint32_t CheckTCPIsSynthesized(void);
 	uint32_t CheckUDPIsSynthesized(void);
+	uint32_t CheckUDPGroupFilterIsSupported(void);
 	uint32_t CheckConfigurationIsAllowed(void);
 
 
@@ -299,6 +326,8 @@ protected:
 	bool m_bTCPSynthesized;
 	bool m_bUDPSynthesized;
 
+	uint32_t m_udpCapabilities;
+
 
 protected: 
 	bool m_bConfigurationAllowed;
@@ -309,6 +338,7 @@ protected:
 protected: //UDP
 
 	void CalculateUDPPortCAMOffsets(uint16_t port, uint32_t* pWordIndex, uint32_t* pBitIndex);
+	uint32_t FindUDPMulticastGroup(uint32_t groupAddress, uint16_t port, uint32_t* pIndex, bool* pbFound);
 
 	
 protected: //IGMP
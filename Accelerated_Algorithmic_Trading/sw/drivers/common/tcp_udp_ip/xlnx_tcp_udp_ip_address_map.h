@@ -146,10 +146,18 @@
 #define XLNX_TCP_UDP_IP_UDP_STATS_DATAGRAMS_TRANSMITTED 	        (XLNX_TCP_UDP_IP_UDP_REG_BLOCK_START_OFFSET + 0X00000010)
 #define XLNX_TCP_UDP_IP_UDP_STATS_DATAGRAMS_RECEIVED 		        (XLNX_TCP_UDP_IP_UDP_REG_BLOCK_START_OFFSET + 0X00000020)
 #define XLNX_TCP_UDP_IP_UDP_STATS_DATAGRAMS_RECEIVED_INVALID_PORT   (XLNX_TCP_UDP_IP_UDP_REG_BLOCK_START_OFFSET + 0X00000030)
+#define XLNX_TCP_UDP_IP_UDP_STATS_DATAGRAMS_RECEIVED_INVALID_GROUP  (XLNX_TCP_UDP_IP_UDP_REG_BLOCK_START_OFFSET + 0X00000040)
 
-#define XLNX_TCP_UDP_IP_NUM_UDP_STATS_REGISTERS					    (3) 
+#define XLNX_TCP_UDP_IP_NUM_UDP_STATS_REGISTERS					    (4) 
+#define XLNX_TCP_UDP_IP_UDP_GROUP_FILTER_ENABLE_OFFSET              (XLNX_TCP_UDP_IP_UDP_REG_BLOCK_START_OFFSET + 0x00000050)
+#define XLNX_TCP_UDP_IP_UDP_CAPABILITIES_OFFSET                     (XLNX_TCP_UDP_IP_UDP_REG_BLOCK_START_OFFSET + 0x00000060)
 #define XLNX_TCP_UDP_IP_UDP_LISTEN_PORT_CAM_OFFSET                  (XLNX_TCP_UDP_IP_UDP_REG_BLOCK_START_OFFSET + 0x00002000)
 
+//Multicast group table, 2 words per entry - group address then port (port 0 = entry unused)
+//Only present with TCPUDPIP::CAPABILITY_UDP_GROUP_FILTER.  Must stay inside the 16KB UDP window, the TCP block follows it.
+#define XLNX_TCP_UDP_IP_UDP_GROUP_TABLE_OFFSET                      (XLNX_TCP_UDP_IP_UDP_REG_BLOCK_START_OFFSET + 0x00001000)
+#define XLNX_TCP_UDP_IP_UDP_GROUP_TABLE_ENTRY_SIZE                  (0x00000008)
+
 
 
 
@@ -37,6 +37,11 @@
 #define XLNX_TCP_UDP_IP_ERROR_FEATURE_NOT_SYNTHESIZED_IN_HW			        (0x0000000A)
 #define XLNX_TCP_UDP_IP_ERROR_CONFIGURATION_DISABLED_DUE_TO_HW_LIMITATIONS  (0x0000000B)
 #define XLNX_TCP_UDP_IP_ERROR_UNSUPPORTED_IGMP_VERSION                      (0x0000000C)
+#define XLNX_TCP_UDP_IP_ERROR_NO_FREE_UDP_GROUP_ENTRIES                     (0x0000000D)
+#define XLNX_TCP_UDP_IP_ERROR_UDP_GROUP_NOT_ENABLED                         (0x0000000E)
+#define XLNX_TCP_UDP_IP_ERROR_UDP_GROUP_ALREADY_ENABLED                     (0x0000000F)
+#define XLNX_TCP_UDP_IP_ERROR_INVALID_PARAMETER                             (0x00000010)
+#define XLNX_TCP_UDP_IP_ERROR_NOT_SUPPORTED_BY_HW                           (0x00000011)
 
 
 
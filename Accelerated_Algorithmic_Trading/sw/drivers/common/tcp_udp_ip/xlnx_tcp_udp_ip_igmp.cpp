@@ -33,6 +33,8 @@ static const uint32_t IGMP_OPCODE_ADD		= 0x01;
 static const uint32_t IGMP_OPCODE_DELETE	= 0x02;
 static const uint32_t IGMP_OPCODE_READ		= 0x03;
 
+static const uint32_t IGMP_OPCODE_DEFER_REPORT_FLAG	= 0x04;
+
 
 
 uint32_t TCPUDPIP::SetIGMPEnabled(bool bEnabled)
@@ -115,11 +117,12 @@ uint32_t TCPUDPIP::GetIGMPEnabled(bool* pbEnabled)
 
 
 
-uint32_t TCPUDPIP::AddIPv4MulticastAddress(uint8_t a, uint8_t b, uint8_t c, uint8_t d)
+uint32_t TCPUDPIP::AddIPv4MulticastAddress(uint8_t a, uint8_t b, uint8_t c, uint8_t d, bool bDeferReport)
 {
 	uint32_t retval = XLNX_OK;
 	uint32_t value;
 	uint32_t numValidEntries;
+	uint32_t opcode = IGMP_OPCODE_ADD;
 
 	retval = CheckIsInitialised();
 
@@ -156,7 +159,12 @@ uint32_t TCPUDPIP::AddIPv4MulticastAddress(uint8_t a, uint8_t b, uint8_t c, uint
 
 	if (retval == XLNX_OK)
 	{
-		retval = WriteReg32(XLNX_TCP_UDP_IP_IGMP_HOST_OPCODE_REG_OFFSET, IGMP_OPCODE_ADD);
+		if (bDeferReport)
+		{
+			opcode |= IGMP_OPCODE_DEFER_REPORT_FLAG;
+		}
+
+		retval = WriteReg32(XLNX_TCP_UDP_IP_IGMP_HOST_OPCODE_REG_OFFSET, opcode);
 	}
 
 
@@ -184,10 +192,11 @@ uint32_t TCPUDPIP::AddIPv4MulticastAddress(uint8_t a, uint8_t b, uint8_t c, uint
 
 
 
-uint32_t TCPUDPIP::DeleteIPv4MulticastAddress(uint8_t a, uint8_t b, uint8_t c, uint8_t d)
+uint32_t TCPUDPIP::DeleteIPv4MulticastAddress(uint8_t a, uint8_t b, uint8_t c, uint8_t d, bool bDeferReport)
 {
 	uint32_t retval = XLNX_OK;
 	uint32_t value;
+	uint32_t opcode = IGMP_OPCODE_DELETE;
 
 
 	retval = CheckIsInitialised();
@@ -208,7 +217,12 @@ uint32_t TCPUDPIP::DeleteIPv4MulticastAddress(uint8_t a, uint8_t b, uint8_t c, u
 
 	if (retval == XLNX_OK)
 	{
-		retval = WriteReg32(XLNX_TCP_UDP_IP_IGMP_HOST_OPCODE_REG_OFFSET, IGMP_OPCODE_DELETE);
+		if (bDeferReport)
+		{
+			opcode |= IGMP_OPCODE_DEFER_REPORT_FLAG;
+		}
+
+		retval = WriteReg32(XLNX_TCP_UDP_IP_IGMP_HOST_OPCODE_REG_OFFSET, opcode);
 	}
 
 
@@ -236,6 +250,42 @@ uint32_t TCPUDPIP::DeleteIPv4MulticastAddress(uint8_t a, uint8_t b, uint8_t c, u
 
 
 
+uint32_t TCPUDPIP::SendIGMPReport(void)
+{
+	uint32_t retval = XLNX_OK;
+
+	retval = CheckIsInitialised();
+
+	if (retval == XLNX_OK)
+	{
+		retval = CheckConfigurationIsAllowed();
+	}
+
+	//A NOOP sends any group records held back by a deferred add/delete...
+	if (retval == XLNX_OK)
+	{
+		retval = WriteReg32(XLNX_TCP_UDP_IP_IGMP_HOST_OPCODE_REG_OFFSET, IGMP_OPCODE_NOOP);
+	}
+
+	if (retval == XLNX_OK)
+	{
+		retval = WriteReg32(XLNX_TCP_UDP_IP_IGMP_HOST_OP_TOGGLE_REG_OFFSET, 0x01);
+	}
+
+	if (retval == XLNX_OK)
+	{
+		retval = WriteReg32(XLNX_TCP_UDP_IP_IGMP_HOST_OP_TOGGLE_REG_OFFSET, 0x00);
+	}
+
+	return retval;
+}
+
+
+
+
+
+
+
 uint32_t TCPUDPIP::ReadIGMPEntry(uint32_t index, uint8_t* a, uint8_t* b, uint8_t* c, uint8_t* d)
 {
 	uint32_t retval = XLNX_OK;
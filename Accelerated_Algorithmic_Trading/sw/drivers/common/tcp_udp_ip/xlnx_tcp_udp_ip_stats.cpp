@@ -299,6 +299,12 @@ uint32_t TCPUDPIP::GetUDPStats(UDPStats* pStats)
 				offset = XLNX_TCP_UDP_IP_UDP_STATS_DATAGRAMS_RECEIVED_INVALID_PORT;
 				retval = ReadReg32(offset, &buffer[2]);
 			}
+
+			if (retval == XLNX_OK)
+			{
+				offset = XLNX_TCP_UDP_IP_UDP_STATS_DATAGRAMS_RECEIVED_INVALID_GROUP;
+				retval = ReadReg32(offset, &buffer[3]);
+			}
 		}
 		else
 		{
@@ -318,6 +324,7 @@ uint32_t TCPUDPIP::GetUDPStats(UDPStats* pStats)
 		pStats->numTxDatagrams				= buffer[0];
 		pStats->numRxDatagrams				= buffer[1];
 		pStats->numRxDatagramsInvalidPort	= buffer[2];
+		pStats->numRxDatagramsInvalidGroup	= buffer[3];
 	}
 
 	return retval;
@@ -319,3 +319,388 @@ uint32_t TCPUDPIP::GetUDPListeningPorts(uint16_t enabledPorts[NUM_LISTENING_PORT
 	return retval;
 }
 
+
+
+
+
+
+
+
+
+uint32_t TCPUDPIP::GetUDPCapabilities(uint32_t* pCapabilities)
+{
+	uint32_t retval = XLNX_OK;
+
+	retval = CheckIsInitialised();
+
+	if (retval == XLNX_OK)
+	{
+		retval = CheckUDPIsSynthesized();
+	}
+
+	if (retval == XLNX_OK)
+	{
+		*pCapabilities = m_udpCapabilities;
+	}
+
+	return retval;
+}
+
+
+
+
+
+
+
+
+uint32_t TCPUDPIP::SetUDPGroupFilterEnabled(bool bEnabled)
+{
+	uint32_t retval = XLNX_OK;
+	uint64_t offset;
+	uint32_t value;
+	uint32_t mask;
+
+	retval = CheckIsInitialised();
+
+	if (retval == XLNX_OK)
+	{
+		retval = CheckUDPGroupFilterIsSupported();
+	}
+
+	if (retval == XLNX_OK)
+	{
+		retval = CheckConfigurationIsAllowed();
+	}
+
+	if (retval == XLNX_OK)
+	{
+		offset = XLNX_TCP_UDP_IP_UDP_GROUP_FILTER_ENABLE_OFFSET;
+		mask = 0x00000001;
+
+		if (bEnabled)
+		{
+			value = 0x00000001;
+		}
+		else
+		{
+			value = 0x00000000;
+		}
+
+		retval = WriteRegWithMask32(offset, value, mask);
+	}
+
+	return retval;
+}
+
+
+
+
+
+
+
+
+uint32_t TCPUDPIP::GetUDPGroupFilterEnabled(bool* pbEnabled)
+{
+	uint32_t retval = XLNX_OK;
+	uint64_t offset;
+	uint32_t value;
+	uint32_t mask;
+
+	retval = CheckIsInitialised();
+
+	if (retval == XLNX_OK)
+	{
+		retval = CheckUDPGroupFilterIsSupported();
+	}
+
+	if (retval == XLNX_OK)
+	{
+		offset = XLNX_TCP_UDP_IP_UDP_GROUP_FILTER_ENABLE_OFFSET;
+		mask = 0x00000001;
+
+		retval = ReadReg32(offset, &value);
+
+		if (retval == XLNX_OK)
+		{
+			if ((value & mask) != 0)
+			{
+				*pbEnabled = true;
+			}
+			else
+			{
+				*pbEnabled = false;
+			}
+		}
+	}
+
+	return retval;
+}
+
+
+
+
+
+
+
+
+uint32_t TCPUDPIP::FindUDPMulticastGroup(uint32_t groupAddress, uint16_t port, uint32_t* pIndex, bool* pbFound)
+{
+	uint32_t retval = XLNX_OK;
+	uint64_t offset;
+	uint32_t entryAddress;
+	uint32_t entryPort;
+	uint32_t i;
+
+	//NOTE - searching for port 0 returns the first free entry, callers must reject port 0 from the user...
+
+	*pbFound = false;
+
+	for (i = 0; i < NUM_UDP_MULTICAST_GROUPS_SUPPORTED; i++)
+	{
+		offset = XLNX_TCP_UDP_IP_UDP_GROUP_TABLE_OFFSET + (i * XLNX_TCP_UDP_IP_UDP_GROUP_TABLE_ENTRY_SIZE);
+
+		retval = ReadReg32(offset + 4, &entryPort);
+
+		if (retval == XLNX_OK)
+		{
+			retval = ReadReg32(offset, &entryAddress);
+		}
+
+		if (retval != XLNX_OK)
+		{
+			break; //out of loop
+		}
+
+		if ((entryPort == port) && ((port == 0) || (entryAddress == groupAddress)))
+		{
+			*pIndex = i;
+			*pbFound = true;
+			break; //out of loop
+		}
+	}
+
+	return retval;
+}
+
+
+
+
+
+
+
+
+uint32_t TCPUDPIP::AddUDPMulticastGroup(uint8_t a, uint8_t b, uint8_t c, uint8_t d, uint16_t port)
+{
+	uint32_t retval = XLNX_OK;
+	uint64_t offset;
+	uint32_t groupAddress;
+	uint32_t index = 0;
+	bool bFound = false;
+
+	retval = CheckIsInitialised();
+
+	if (retval == XLNX_OK)
+	{
+		retval = CheckUDPGroupFilterIsSupported();
+	}
+
+	if (retval == XLNX_OK)
+	{
+		retval = CheckConfigurationIsAllowed();
+	}
+
+	if ((retval == XLNX_OK) && (port == 0))
+	{
+		retval = XLNX_TCP_UDP_IP_ERROR_INVALID_PARAMETER;
+	}
+
+	if (retval == XLNX_OK)
+	{
+		groupAddress = (a << 24) | (b << 16) | (c << 8) | d;
+
+		//First check to see if the specified group has already been added...
+		retval = FindUDPMulticastGroup(groupAddress, port, &index, &bFound);
+
+		if ((retval == XLNX_OK) && bFound)
+		{
+			retval = XLNX_TCP_UDP_IP_ERROR_UDP_GROUP_ALREADY_ENABLED;
+		}
+	}
+
+	if (retval == XLNX_OK)
+	{
+		retval = FindUDPMulticastGroup(0, 0, &index, &bFound);
+
+		if ((retval == XLNX_OK) && (bFound == false))
+		{
+			retval = XLNX_TCP_UDP_IP_ERROR_NO_FREE_UDP_GROUP_ENTRIES;
+		}
+	}
+
+	if (retval == XLNX_OK)
+	{
+		//Address must be written first - the entry becomes valid when the port is written...
+		offset = XLNX_TCP_UDP_IP_UDP_GROUP_TABLE_OFFSET + (index * XLNX_TCP_UDP_IP_UDP_GROUP_TABLE_ENTRY_SIZE);
+
+		retval = WriteReg32(offset, groupAddress);
+
+		if (retval == XLNX_OK)
+		{
+			retval = WriteReg32(offset + 4, port);
+		}
+	}
+
+	return retval;
+}
+
+
+
+
+
+
+
+
+uint32_t TCPUDPIP::DeleteUDPMulticastGroup(uint8_t a, uint8_t b, uint8_t c, uint8_t d, uint16_t port)
+{
+	uint32_t retval = XLNX_OK;
+	uint64_t offset;
+	uint32_t groupAddress;
+	uint32_t index = 0;
+	bool bFound = false;
+
+	retval = CheckIsInitialised();
+
+	if (retval == XLNX_OK)
+	{
+		retval = CheckUDPGroupFilterIsSupported();
+	}
+
+	if (retval == XLNX_OK)
+	{
+		retval = CheckConfigurationIsAllowed();
+	}
+
+	if ((retval == XLNX_OK) && (port == 0))
+	{
+		retval = XLNX_TCP_UDP_IP_ERROR_INVALID_PARAMETER;
+	}
+
+	if (retval == XLNX_OK)
+	{
+		groupAddress = (a << 24) | (b << 16) | (c << 8) | d;
+
+		retval = FindUDPMulticastGroup(groupAddress, port, &index, &bFound);
+
+		if ((retval == XLNX_OK) && (bFound == false))
+		{
+			retval = XLNX_TCP_UDP_IP_ERROR_UDP_GROUP_NOT_ENABLED;
+		}
+	}
+
+	if (retval == XLNX_OK)
+	{
+		offset = XLNX_TCP_UDP_IP_UDP_GROUP_TABLE_OFFSET + (index * XLNX_TCP_UDP_IP_UDP_GROUP_TABLE_ENTRY_SIZE);
+
+		retval = WriteReg32(offset + 4, 0);
+	}
+
+	return retval;
+}
+
+
+
+
+
+
+
+
+uint32_t TCPUDPIP::DeleteAllUDPMulticastGroups(void)
+{
+	uint32_t retval = XLNX_OK;
+	uint64_t offset;
+	uint32_t i;
+
+	retval = CheckIsInitialised();
+
+	if (retval == XLNX_OK)
+	{
+		retval = CheckUDPGroupFilterIsSupported();
+	}
+
+	if (retval == XLNX_OK)
+	{
+		retval = CheckConfigurationIsAllowed();
+	}
+
+	if (retval == XLNX_OK)
+	{
+		for (i = 0; i < NUM_UDP_MULTICAST_GROUPS_SUPPORTED; i++)
+		{
+			offset = XLNX_TCP_UDP_IP_UDP_GROUP_TABLE_OFFSET + (i * XLNX_TCP_UDP_IP_UDP_GROUP_TABLE_ENTRY_SIZE);
+
+			retval = WriteReg32(offset + 4, 0);
+
+			if (retval != XLNX_OK)
+			{
+				break; //out of loop
+			}
+		}
+	}
+
+	return retval;
+}
+
+
+
+
+
+
+
+
+uint32_t TCPUDPIP::GetUDPMulticastGroups(uint32_t groupAddresses[NUM_UDP_MULTICAST_GROUPS_SUPPORTED], uint16_t groupPorts[NUM_UDP_MULTICAST_GROUPS_SUPPORTED], uint32_t* pNumGroups)
+{
+	uint32_t retval = XLNX_OK;
+	uint64_t offset;
+	uint32_t entryAddress;
+	uint32_t entryPort;
+	uint32_t numGroups = 0;
+	uint32_t i;
+
+	retval = CheckIsInitialised();
+
+	if (retval == XLNX_OK)
+	{
+		retval = CheckUDPGroupFilterIsSupported();
+	}
+
+	if (retval == XLNX_OK)
+	{
+		for (i = 0; i < NUM_UDP_MULTICAST_GROUPS_SUPPORTED; i++)
+		{
+			offset = XLNX_TCP_UDP_IP_UDP_GROUP_TABLE_OFFSET + (i * XLNX_TCP_UDP_IP_UDP_GROUP_TABLE_ENTRY_SIZE);
+
+			retval = ReadReg32(offset, &entryAddress);
+
+			if (retval == XLNX_OK)
+			{
+				retval = ReadReg32(offset + 4, &entryPort);
+			}
+
+			if (retval != XLNX_OK)
+			{
+				break; //out of loop
+			}
+
+			if (entryPort != 0)
+			{
+				groupAddresses[numGroups] = entryAddress;
+				groupPorts[numGroups] = (uint16_t)entryPort;
+				numGroups++;
+			}
+		}
+
+		*pNumGroups = numGroups;
+	}
+
+	return retval;
+}
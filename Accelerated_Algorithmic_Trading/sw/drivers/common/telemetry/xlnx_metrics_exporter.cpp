@@ -0,0 +1,772 @@
+/*
+ * Copyright 2021 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <cstdio>
+#include <cstring>
+#include <cinttypes>
+
+#include "xlnx_metrics_exporter.h"
+#include "xlnx_telemetry_shared_memory.h"
+using namespace XLNX;
+
+
+
+
+MetricsExporter::MetricsExporter()
+{
+    m_bInitialised = false;
+    m_pTelemetry = nullptr;
+    m_pReader = nullptr;
+    m_pRegion = nullptr;
+
+    m_numMetrics = 0;
+
+    m_lastSequence = 0;
+    m_lastTimestampNanoseconds = 0;
+    m_lastIntervalNanoseconds = 0;
+    m_bPrimed = false;
+
+    m_bKeepRunning = false;
+    m_intervalMilliseconds = 0;
+    m_bStartedTelemetry = false;
+
+    m_bServerRunning = false;
+    m_serverPort = 0;
+
+    m_numSamples = 0;
+    m_numStaleSamples = 0;
+    m_numErrorSamples = 0;
+    m_numCounterWraps = 0;
+    m_numCounterResets = 0;
+    m_numServerRequests = 0;
+}
+
+
+
+
+MetricsExporter::~MetricsExporter()
+{
+    Uninitialise();
+}
+
+
+
+
+
+uint32_t MetricsExporter::Initialise(Telemetry* pTelemetry, const char* sharedMemoryName)
+{
+    uint32_t retval = XLNX_OK;
+    void* pMapping = nullptr;
+
+    Uninitialise();
+
+    if ((pTelemetry == nullptr) || (sharedMemoryName == nullptr))
+    {
+        retval = XLNX_TELEMETRY_ERROR_INVALID_PARAMETER;
+    }
+
+
+    if (retval == XLNX_OK)
+    {
+        retval = pTelemetry->GetReader(&m_pReader);
+    }
+
+
+    if (retval == XLNX_OK)
+    {
+        retval = TelemetryCreateSharedMemory(sharedMemoryName, sizeof(MetricsSharedRegion), &pMapping);
+    }
+
+
+    if (retval == XLNX_OK)
+    {
+        m_pRegion = (MetricsSharedRegion*)pMapping;
+        m_sharedMemoryName = sharedMemoryName;
+
+        m_pRegion->version = XLNX_METRICS_SHARED_VERSION;
+        m_pRegion->sequence.store(0, std::memory_order_relaxed);
+
+        //readers check the magic number, so it goes in last
+        std::atomic_thread_fence(std::memory_order_release);
+        m_pRegion->magic = XLNX_METRICS_SHARED_MAGIC;
+
+
+        m_pTelemetry = pTelemetry;
+        m_numMetrics = 0;
+        m_lastSequence = 0;
+        m_lastTimestampNanoseconds = 0;
+        m_lastIntervalNanoseconds = 0;
+        m_bPrimed = false;
+
+        m_numSamples = 0;
+        m_numStaleSamples = 0;
+        m_numErrorSamples = 0;
+        m_numCounterWraps = 0;
+        m_numCounterResets = 0;
+        m_numServerRequests = 0;
+
+        m_bInitialised = true;
+    }
+    else
+    {
+        m_pReader = nullptr;
+    }
+
+    return retval;
+}
+
+
+
+
+
+uint32_t MetricsExporter::Uninitialise(void)
+{
+    StopServer();
+
+    Stop();
+
+    TelemetryDestroySharedMemory(m_sharedMemoryName.c_str(), (void*)m_pRegion, sizeof(MetricsSharedRegion));
+
+    m_pRegion = nullptr;
+    m_sharedMemoryName.clear();
+
+    m_pTelemetry = nullptr;
+    m_pReader = nullptr;
+    m_bInitialised = false;
+
+    return XLNX_OK;
+}
+
+
+
+
+
+uint32_t MetricsExporter::IsInitialised(bool* pbIsInitialised)
+{
+    *pbIsInitialised = m_bInitialised;
+
+    return XLNX_OK;
+}
+
+
+
+
+
+uint32_t MetricsExporter::CheckInitialised(void)
+{
+    uint32_t retval = XLNX_OK;
+
+    if (m_bInitialised == false)
+    {
+        retval = XLNX_TELEMETRY_ERROR_NOT_INITIALISED;
+    }
+
+    return retval;
+}
+
+
+
+
+
+uint32_t MetricsExporter::GetSharedMemoryName(const char** ppName)
+{
+    uint32_t retval = XLNX_OK;
+
+    retval = CheckInitialised();
+
+    if (retval == XLNX_OK)
+    {
+        *ppName = m_sharedMemoryName.c_str();
+    }
+
+    return retval;
+}
+
+
+
+
+
+uint32_t MetricsExporter::AddCounter(const char* name, const char* blockName, uint32_t wordIndex)
+{
+    return AddMetric(name, blockName, wordIndex, XLNX_METRICS_TYPE_COUNTER);
+}
+
+
+
+
+
+uint32_t MetricsExporter::AddGauge(const char* name, const char* blockName, uint32_t wordIndex)
+{
+    return AddMetric(name, blockName, wordIndex, XLNX_METRICS_TYPE_GAUGE);
+}
+
+
+
+
+
+uint32_t MetricsExporter::AddMetric(const char* name, const char* blockName, uint32_t wordIndex, uint32_t type)
+{
+    uint32_t retval = XLNX_OK;
+    TelemetrySharedBlock blockInfo;
+    uint32_t blockIndex;
+    bool bIsRunning;
+    uint32_t i;
+
+    retval = CheckInitialised();
+
+
+    if (retval == XLNX_OK)
+    {
+        IsRunning(&bIsRunning);
+
+        if (bIsRunning)
+        {
+            retval = XLNX_TELEMETRY_ERROR_ALREADY_RUNNING;
+        }
+    }
+
+
+    if (retval == XLNX_OK)
+    {
+        if ((name == nullptr) || (name[0] == '\0') || (strlen(name) >= XLNX_METRICS_MAX_NAME_LENGTH) || (blockName == nullptr))
+        {
+            retval = XLNX_TELEMETRY_ERROR_INVALID_PARAMETER;
+        }
+    }
+
+
+    if (retval == XLNX_OK)
+    {
+        retval = m_pReader->FindBlock(blockName, &blockIndex);
+    }
+
+
+    if (retval == XLNX_OK)
+    {
+        retval = m_pReader->GetBlockInfo(blockIndex, &blockInfo);
+    }
+
+
+    if (retval == XLNX_OK)
+    {
+        if (wordIndex >= blockInfo.numWords)
+        {
+            retval = XLNX_TELEMETRY_ERROR_INVALID_PARAMETER;
+        }
+    }
+
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+
+    if (retval == XLNX_OK)
+    {
+        for (i = 0; i < m_numMetrics; i++)
+        {
+            if (strcmp(m_descriptors[i].name, name) == 0)
+            {
+                retval = XLNX_TELEMETRY_ERROR_INVALID_PARAMETER;
+                break;
+            }
+        }
+    }
+
+
+    if (retval == XLNX_OK)
+    {
+        if (m_numMetrics >= XLNX_METRICS_MAX_METRICS)
+        {
+            retval = XLNX_TELEMETRY_ERROR_TOO_MANY_METRICS;
+        }
+    }
+
+
+    if (retval == XLNX_OK)
+    {
+        memset(&m_metrics[m_numMetrics], 0, sizeof(Metric));
+        m_metrics[m_numMetrics].snapshotWordIndex = blockInfo.dataWordOffset + wordIndex;
+        m_metrics[m_numMetrics].type = type;
+
+        memset(&m_descriptors[m_numMetrics], 0, sizeof(MetricsSharedDescriptor));
+        strncpy(m_descriptors[m_numMetrics].name, name, XLNX_METRICS_MAX_NAME_LENGTH - 1);
+        m_descriptors[m_numMetrics].type = type;
+
+        m_pRegion->descriptors[m_numMetrics] = m_descriptors[m_numMetrics];
+
+        m_numMetrics++;
+
+        //the count goes last so a reader never sees an unfilled descriptor
+        std::atomic_thread_fence(std::memory_order_release);
+        m_pRegion->numMetrics = m_numMetrics;
+
+        //the new metric needs seeding from the next snapshot
+        m_bPrimed = false;
+    }
+
+    return retval;
+}
+
+
+
+
+
+uint32_t MetricsExporter::GetNumMetrics(uint32_t* pNumMetrics)
+{
+    uint32_t retval = XLNX_OK;
+
+    retval = CheckInitialised();
+
+    if (retval == XLNX_OK)
+    {
+        *pNumMetrics = m_numMetrics;
+    }
+
+    return retval;
+}
+
+
+
+
+
+uint32_t MetricsExporter::GetMetric(uint32_t index, MetricsSharedDescriptor* pDescriptor, MetricsSharedValue* pValue)
+{
+    uint32_t retval = XLNX_OK;
+
+    retval = CheckInitialised();
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    if (retval == XLNX_OK)
+    {
+        if (index >= m_numMetrics)
+        {
+            retval = XLNX_TELEMETRY_ERROR_METRIC_NOT_FOUND;
+        }
+    }
+
+    if (retval == XLNX_OK)
+    {
+        *pDescriptor = m_descriptors[index];
+        pValue->value = m_metrics[index].value;
+        pValue->ratePerSecond = m_metrics[index].ratePerSecond;
+    }
+
+    return retval;
+}
+
+
+
+
+
+uint32_t MetricsExporter::Sample(void)
+{
+    uint32_t retval = XLNX_OK;
+    Metric* pMetric;
+    uint32_t raw;
+    uint32_t delta;
+    uint64_t intervalNanoseconds = 0;
+    uint32_t i;
+
+    retval = CheckInitialised();
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+
+    if (retval == XLNX_OK)
+    {
+        retval = m_pReader->ReadSnapshot(&m_snapshot);
+
+        if (retval == XLNX_TELEMETRY_ERROR_NO_SNAPSHOT)
+        {
+            m_numStaleSamples++;
+        }
+    }
+
+
+    if (retval == XLNX_OK)
+    {
+        if (m_snapshot.sequence == m_lastSequence)
+        {
+            m_numStaleSamples++;
+            return retval;
+        }
+
+        m_lastSequence = m_snapshot.sequence;
+
+
+        //one or more spans could not be read, so some of the registers are stale - they will be
+        //picked up (including any increments in the meantime) from the next good snapshot
+        if (m_snapshot.status & XLNX_TELEMETRY_STATUS_READ_ERROR)
+        {
+            m_numErrorSamples++;
+            return retval;
+        }
+
+
+        if (m_bPrimed)
+        {
+            intervalNanoseconds = m_snapshot.timestampNanoseconds - m_lastTimestampNanoseconds;
+        }
+
+
+        for (i = 0; i < m_numMetrics; i++)
+        {
+            pMetric = &m_metrics[i];
+            raw = m_snapshot.data[pMetric->snapshotWordIndex];
+
+            if ((pMetric->type == XLNX_METRICS_TYPE_GAUGE) || (m_bPrimed == false))
+            {
+                pMetric->value = raw;
+                pMetric->ratePerSecond = 0.0;
+            }
+            else
+            {
+                delta = raw - pMetric->lastRaw; //unsigned arithmetic takes care of a single wrap
+
+                if (delta >= COUNTER_WRAP_THRESHOLD)
+                {
+                    //went backwards - counter has been cleared, so everything it holds is new
+                    delta = raw;
+                    m_numCounterResets++;
+                }
+                else if (raw < pMetric->lastRaw)
+                {
+                    m_numCounterWraps++;
+                }
+
+                pMetric->value += delta;
+
+                if (intervalNanoseconds > 0)
+                {
+                    pMetric->ratePerSecond = ((double)delta * 1000000000.0) / (double)intervalNanoseconds;
+                }
+            }
+
+            pMetric->lastRaw = raw;
+        }
+
+
+        m_bPrimed = true;
+        m_lastTimestampNanoseconds = m_snapshot.timestampNanoseconds;
+        m_lastIntervalNanoseconds = intervalNanoseconds;
+
+        Publish(m_snapshot.timestampNanoseconds, intervalNanoseconds);
+
+        m_numSamples++;
+    }
+
+    return retval;
+}
+
+
+
+
+
+void MetricsExporter::Publish(uint64_t timestampNanoseconds, uint64_t intervalNanoseconds)
+{
+    MetricsSharedBuffer* pBuffer;
+    uint64_t sequence;
+    uint32_t i;
+
+    //NOTE - called with m_mutex held
+
+    //fill the buffer that readers are NOT currently being pointed at...
+    sequence = m_pRegion->sequence.load(std::memory_order_relaxed) + 1;
+    pBuffer = &m_pRegion->buffers[sequence % XLNX_METRICS_NUM_BUFFERS];
+
+    pBuffer->sequence = sequence;
+    std::atomic_thread_fence(std::memory_order_release);
+
+    pBuffer->timestampNanoseconds = timestampNanoseconds;
+    pBuffer->intervalNanoseconds = intervalNanoseconds;
+
+    for (i = 0; i < m_numMetrics; i++)
+    {
+        pBuffer->values[i].value = m_metrics[i].value;
+        pBuffer->values[i].ratePerSecond = m_metrics[i].ratePerSecond;
+    }
+
+    //...then point readers at it
+    m_pRegion->sequence.store(sequence, std::memory_order_release);
+}
+
+
+
+
+
+uint32_t MetricsExporter::Start(uint32_t intervalMilliseconds)
+{
+    uint32_t retval = XLNX_OK;
+    bool bIsRunning;
+
+    retval = CheckInitialised();
+
+
+    if (retval == XLNX_OK)
+    {
+        if (intervalMilliseconds == 0)
+        {
+            retval = XLNX_TELEMETRY_ERROR_INVALID_PARAMETER;
+        }
+    }
+
+
+    if (retval == XLNX_OK)
+    {
+        IsRunning(&bIsRunning);
+
+        if (bIsRunning)
+        {
+            retval = XLNX_TELEMETRY_ERROR_ALREADY_RUNNING;
+        }
+    }
+
+
+    if (retval == XLNX_OK)
+    {
+        m_pTelemetry->IsRunning(&bIsRunning);
+
+        if (bIsRunning == false)
+        {
+            retval = m_pTelemetry->Start(intervalMilliseconds);
+
+            m_bStartedTelemetry = (retval == XLNX_OK);
+        }
+    }
+
+
+    if (retval == XLNX_OK)
+    {
+        m_intervalMilliseconds = intervalMilliseconds;
+        m_bKeepRunning = true;
+
+        m_thread = std::thread(&MetricsExporter::ThreadFunc, this);
+    }
+
+    return retval;
+}
+
+
+
+
+
+uint32_t MetricsExporter::Stop(void)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_threadMutex);
+        m_bKeepRunning = false;
+    }
+
+    m_threadCondition.notify_all();
+
+    if (m_thread.joinable())
+    {
+        m_thread.join();
+    }
+
+    if (m_bStartedTelemetry)
+    {
+        m_pTelemetry->Stop();
+        m_bStartedTelemetry = false;
+    }
+
+    return XLNX_OK;
+}
+
+
+
+
+
+uint32_t MetricsExporter::IsRunning(bool* pbIsRunning)
+{
+    *pbIsRunning = m_thread.joinable();
+
+    return XLNX_OK;
+}
+
+
+
+
+
+uint32_t MetricsExporter::GetInterval(uint32_t* pIntervalMilliseconds)
+{
+    *pIntervalMilliseconds = m_intervalMilliseconds;
+
+    return XLNX_OK;
+}
+
+
+
+
+
+void MetricsExporter::ThreadFunc(void)
+{
+    std::unique_lock<std::mutex> lock(m_threadMutex);
+
+    while (m_bKeepRunning)
+    {
+        lock.unlock();
+
+        Sample();
+
+        lock.lock();
+
+        m_threadCondition.wait_for(lock, std::chrono::milliseconds(m_intervalMilliseconds), [this] { return (m_bKeepRunning == false); });
+    }
+}
+
+
+
+
+
+uint32_t MetricsExporter::StartServer(uint16_t port)
+{
+    uint32_t retval = XLNX_OK;
+
+    retval = CheckInitialised();
+
+
+    if (retval == XLNX_OK)
+    {
+        if (m_bServerRunning)
+        {
+            retval = XLNX_TELEMETRY_ERROR_SERVER_ALREADY_RUNNING;
+        }
+        else if (port == 0)
+        {
+            retval = XLNX_TELEMETRY_ERROR_INVALID_PARAMETER;
+        }
+    }
+
+
+    if (retval == XLNX_OK)
+    {
+        //served from the server's reactor - formatting the text never blocks, and the server sends it
+        //without tying up a thread per client
+        m_server.SetResponseCallback(ServerResponseCallback, this);
+
+        //bind and listen happen before this returns, so a port that is already in use is reported here
+        if (m_server.StartAsThread(port, nullptr) == false)
+        {
+            retval = XLNX_TELEMETRY_ERROR_FAILED_TO_START_SERVER;
+        }
+    }
+
+
+    if (retval == XLNX_OK)
+    {
+        m_bServerRunning = true;
+        m_serverPort = port;
+    }
+
+    return retval;
+}
+
+
+
+
+
+uint32_t MetricsExporter::StopServer(void)
+{
+    if (m_bServerRunning)
+    {
+        m_server.Stop();
+
+        m_bServerRunning = false;
+        m_serverPort = 0;
+    }
+
+    return XLNX_OK;
+}
+
+
+
+
+
+uint32_t MetricsExporter::IsServerRunning(bool* pbIsRunning, uint16_t* pPort)
+{
+    *pbIsRunning = m_bServerRunning;
+    *pPort = m_serverPort;
+
+    return XLNX_OK;
+}
+
+
+
+
+
+uint32_t MetricsExporter::FormatText(std::string* pText)
+{
+    uint32_t retval = XLNX_OK;
+    char line[XLNX_METRICS_MAX_NAME_LENGTH + 64];
+    uint32_t i;
+
+    retval = CheckInitialised();
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    if (retval == XLNX_OK)
+    {
+        pText->clear();
+
+        snprintf(line, sizeof(line), "# sequence %" PRIu64 " timestamp_ns %" PRIu64 " interval_ns %" PRIu64 "\n",
+                 m_lastSequence, m_lastTimestampNanoseconds, m_lastIntervalNanoseconds);
+        pText->append(line);
+
+        for (i = 0; i < m_numMetrics; i++)
+        {
+            snprintf(line, sizeof(line), "%s %" PRIu64 " %.3f\n", m_descriptors[i].name, m_metrics[i].value, m_metrics[i].ratePerSecond);
+            pText->append(line);
+        }
+    }
+
+    return retval;
+}
+
+
+
+
+
+void MetricsExporter::ServerResponseCallback(void* pDataObject, std::string* pResponse)
+{
+    MetricsExporter* pExporter = (MetricsExporter*)pDataObject;
+
+    pExporter->m_numServerRequests++;
+
+    if (pExporter->FormatText(pResponse) != XLNX_OK)
+    {
+        pResponse->clear(); //connection is just closed
+    }
+
+    //NOTE - the server sends the response and closes the socket once it has gone
+}
+
+
+
+
+
+uint32_t MetricsExporter::GetStats(Stats* pStats)
+{
+    pStats->numSamples          = m_numSamples;
+    pStats->numStaleSamples     = m_numStaleSamples;
+    pStats->numErrorSamples     = m_numErrorSamples;
+    pStats->numCounterWraps     = m_numCounterWraps;
+    pStats->numCounterResets    = m_numCounterResets;
+    pStats->numServerRequests   = m_numServerRequests;
+
+    return XLNX_OK;
+}
@@ -0,0 +1,190 @@
+/*
+ * Copyright 2021 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef XLNX_METRICS_EXPORTER_H
+#define XLNX_METRICS_EXPORTER_H
+
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+
+#include "xlnx_tcp_server.h"
+
+#include "xlnx_telemetry.h"
+#include "xlnx_metrics_shared.h"
+#include "xlnx_telemetry_error_codes.h"
+
+
+namespace XLNX
+{
+
+
+//Turns the raw register snapshots published by Telemetry into monitoring metrics.
+//
+//The HW counters are 32 bits wide and wrap, so each one is tracked between samples and extended to
+//64 bits, and a per-second rate is derived from the change and the snapshot timestamps.  Results are
+//published into their own double-buffered shared memory region (see xlnx_metrics_shared.h) and can
+//optionally be served as plain text over TCP.
+//
+//Everything runs on the exporter's own threads and only ever reads the telemetry snapshots, so neither
+//the device nor the threads driving the trading path see any extra work from monitoring.
+class MetricsExporter
+{
+public:
+    MetricsExporter();
+    virtual ~MetricsExporter();
+
+
+public:
+    uint32_t Initialise(Telemetry* pTelemetry, const char* sharedMemoryName = XLNX_METRICS_DEFAULT_SHARED_NAME);
+    uint32_t Uninitialise(void);
+    uint32_t IsInitialised(bool* pbIsInitialised);
+
+    uint32_t GetSharedMemoryName(const char** ppName);
+
+
+
+public: //Metrics
+    //wordIndex selects a register within a block registered with Telemetry::AddBlock()
+    uint32_t AddCounter(const char* name, const char* blockName, uint32_t wordIndex);
+    uint32_t AddGauge(const char* name, const char* blockName, uint32_t wordIndex);
+
+    uint32_t GetNumMetrics(uint32_t* pNumMetrics);
+
+    //latest published value of a metric
+    uint32_t GetMetric(uint32_t index, MetricsSharedDescriptor* pDescriptor, MetricsSharedValue* pValue);
+
+
+
+public: //Sampling
+    //Samples at the given interval.  If telemetry snapshots are not already being taken, they are
+    //started at the same interval, and stopped again by Stop().
+    uint32_t Start(uint32_t intervalMilliseconds);
+    uint32_t Stop(void);
+    uint32_t IsRunning(bool* pbIsRunning);
+
+    uint32_t GetInterval(uint32_t* pIntervalMilliseconds);
+
+    //processes the latest telemetry snapshot now (normally done by the sampling thread)
+    uint32_t Sample(void);
+
+
+
+public: //Text Endpoint
+    //Each connection is sent every metric as a "<name> <value> <rate/sec>" line and then closed.
+    uint32_t StartServer(uint16_t port);
+    uint32_t StopServer(void);
+    uint32_t IsServerRunning(bool* pbIsRunning, uint16_t* pPort);
+
+    uint32_t FormatText(std::string* pText);
+
+
+
+public: //Stats
+    typedef struct
+    {
+        uint64_t numSamples;            //snapshots turned into metrics
+        uint64_t numStaleSamples;       //sample points where telemetry had not published anything new
+        uint64_t numErrorSamples;       //snapshots skipped because they were flagged with read errors
+        uint64_t numCounterWraps;
+        uint64_t numCounterResets;      //counters that went backwards by too much to be a wrap (e.g. cleared)
+        uint64_t numServerRequests;
+
+    }Stats;
+
+    uint32_t GetStats(Stats* pStats);
+
+
+
+protected:
+    uint32_t CheckInitialised(void);
+
+    uint32_t AddMetric(const char* name, const char* blockName, uint32_t wordIndex, uint32_t type);
+
+    void Publish(uint64_t timestampNanoseconds, uint64_t intervalNanoseconds);
+
+    void ThreadFunc(void);
+
+    static void ServerResponseCallback(void* pDataObject, std::string* pResponse);
+
+
+
+protected:
+    //a counter moving backwards by less than this is treated as having been reset rather than wrapped -
+    //at the sample rates used, no counter could advance by 2^31 in a single interval
+    static const uint32_t COUNTER_WRAP_THRESHOLD = 0x80000000;
+
+    typedef struct
+    {
+        uint32_t snapshotWordIndex;     //index into TelemetrySharedBuffer::data
+        uint32_t type;
+        uint32_t lastRaw;
+        uint64_t value;
+        double ratePerSecond;
+
+    }Metric;
+
+
+    bool m_bInitialised;
+    Telemetry* m_pTelemetry;
+    TelemetryReader* m_pReader;
+
+    std::string m_sharedMemoryName;
+    MetricsSharedRegion* m_pRegion;
+
+    //guards the metric list and values, and the shared region buffers
+    std::mutex m_mutex;
+
+    Metric m_metrics[XLNX_METRICS_MAX_METRICS];
+    MetricsSharedDescriptor m_descriptors[XLNX_METRICS_MAX_METRICS];
+    uint32_t m_numMetrics;
+
+    TelemetrySharedBuffer m_snapshot;
+    uint64_t m_lastSequence;
+    uint64_t m_lastTimestampNanoseconds;
+    uint64_t m_lastIntervalNanoseconds;
+    bool m_bPrimed;                     //true once a first snapshot has seeded the counter values
+
+    std::thread m_thread;
+    std::atomic<bool> m_bKeepRunning;
+    std::mutex m_threadMutex;
+    std::condition_variable m_threadCondition;
+    uint32_t m_intervalMilliseconds;
+    bool m_bStartedTelemetry;
+
+    TCPServer m_server;
+    bool m_bServerRunning;
+    uint16_t m_serverPort;
+
+    std::atomic<uint64_t> m_numSamples;
+    std::atomic<uint64_t> m_numStaleSamples;
+    std::atomic<uint64_t> m_numErrorSamples;
+    std::atomic<uint64_t> m_numCounterWraps;
+    std::atomic<uint64_t> m_numCounterResets;
+    std::atomic<uint64_t> m_numServerRequests;
+};
+
+
+
+} //namespace XLNX
+
+
+
+#endif
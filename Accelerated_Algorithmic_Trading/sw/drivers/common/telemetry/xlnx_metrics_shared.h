@@ -0,0 +1,106 @@
+/*
+ * Copyright 2021 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef XLNX_METRICS_SHARED_H
+#define XLNX_METRICS_SHARED_H
+
+#include <cstdint>
+#include <atomic>
+
+
+//Layout of the shared memory region that MetricsExporter publishes into.  This is the schema external
+//monitoring reads, so fields may only be appended (bumping XLNX_METRICS_SHARED_VERSION).
+//
+//Publishing follows the same double-buffer scheme as the telemetry region (see xlnx_telemetry_shared.h):
+//load sequence, copy buffers[sequence & 1], and keep the copy if sequence (and the buffer's own copy of
+//it) are unchanged afterwards.
+
+
+namespace XLNX
+{
+
+
+#define XLNX_METRICS_SHARED_MAGIC               (0x5254454D)     //"METR"
+#define XLNX_METRICS_SHARED_VERSION             (1)
+
+#define XLNX_METRICS_DEFAULT_SHARED_NAME        "/xlnx_aat_metrics"
+
+#define XLNX_METRICS_MAX_METRICS                (256)
+#define XLNX_METRICS_MAX_NAME_LENGTH            (48)
+
+#define XLNX_METRICS_NUM_BUFFERS                (2)
+
+
+//monotonically increasing 32-bit HW counter, published extended to 64 bits along with its rate
+#define XLNX_METRICS_TYPE_COUNTER               (0)
+
+//instantaneous value (status flags, min/max, credit levels...), published as read with no rate
+#define XLNX_METRICS_TYPE_GAUGE                 (1)
+
+
+
+typedef struct
+{
+    char        name[XLNX_METRICS_MAX_NAME_LENGTH];
+    uint32_t    type;
+    uint32_t    reserved;
+
+}MetricsSharedDescriptor;
+
+
+
+typedef struct
+{
+    uint64_t    value;
+    double      ratePerSecond;      //change per second over the last sample interval, 0 for gauges
+
+}MetricsSharedValue;
+
+
+
+typedef struct
+{
+    uint64_t            sequence;
+    uint64_t            timestampNanoseconds;   //CLOCK_MONOTONIC time the underlying registers were read
+    uint64_t            intervalNanoseconds;    //time since the previous sample the rates were computed over
+    MetricsSharedValue  values[XLNX_METRICS_MAX_METRICS];
+
+}MetricsSharedBuffer;
+
+
+
+typedef struct
+{
+    uint32_t                magic;
+    uint32_t                version;
+    uint32_t                numMetrics;
+    uint32_t                reserved;
+
+    std::atomic<uint64_t>   sequence;
+
+    MetricsSharedDescriptor descriptors[XLNX_METRICS_MAX_METRICS];
+    MetricsSharedBuffer     buffers[XLNX_METRICS_NUM_BUFFERS];
+
+}MetricsSharedRegion;
+
+
+
+} //namespace XLNX
+
+
+
+#endif
@@ -0,0 +1,662 @@
+/*
+ * Copyright 2021 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <cstring>
+#include <chrono>
+
+#include "xlnx_telemetry.h"
+#include "xlnx_telemetry_shared_memory.h"
+using namespace XLNX;
+
+
+
+
+Telemetry::Telemetry()
+{
+    m_bInitialised = false;
+    m_pDeviceInterface = nullptr;
+    m_pRegion = nullptr;
+
+    m_numBlocks = 0;
+    m_numSpans = 0;
+    m_numDataWords = 0;
+
+    m_bKeepRunning = false;
+    m_intervalMilliseconds = 0;
+
+    m_numSnapshots = 0;
+    m_numDeviceReads = 0;
+    m_numDeviceReadErrors = 0;
+    m_lastSnapshotNanoseconds = 0;
+    m_maxSnapshotNanoseconds = 0;
+}
+
+
+
+
+Telemetry::~Telemetry()
+{
+    Uninitialise();
+}
+
+
+
+
+
+uint32_t Telemetry::Initialise(DeviceInterface* pDeviceInterface, const char* sharedMemoryName)
+{
+    uint32_t retval = XLNX_OK;
+
+    Uninitialise();
+
+    if ((pDeviceInterface == nullptr) || (sharedMemoryName == nullptr))
+    {
+        retval = XLNX_TELEMETRY_ERROR_INVALID_PARAMETER;
+    }
+
+
+    if (retval == XLNX_OK)
+    {
+        retval = CreateSharedMemory(sharedMemoryName);
+    }
+
+
+    if (retval == XLNX_OK)
+    {
+        retval = m_reader.Attach(m_pRegion);
+    }
+
+
+    if (retval == XLNX_OK)
+    {
+        m_pDeviceInterface = pDeviceInterface;
+        m_numBlocks = 0;
+        m_numSpans = 0;
+        m_numDataWords = 0;
+
+        ResetStats();
+
+        m_bInitialised = true;
+    }
+    else
+    {
+        DestroySharedMemory();
+    }
+
+    return retval;
+}
+
+
+
+
+
+uint32_t Telemetry::Uninitialise(void)
+{
+    Stop();
+
+    m_reader.Close();
+
+    DestroySharedMemory();
+
+    m_bInitialised = false;
+    m_pDeviceInterface = nullptr;
+
+    return XLNX_OK;
+}
+
+
+
+
+
+uint32_t Telemetry::IsInitialised(bool* pbIsInitialised)
+{
+    *pbIsInitialised = m_bInitialised;
+
+    return XLNX_OK;
+}
+
+
+
+
+
+uint32_t Telemetry::CheckInitialised(void)
+{
+    uint32_t retval = XLNX_OK;
+
+    if (m_bInitialised == false)
+    {
+        retval = XLNX_TELEMETRY_ERROR_NOT_INITIALISED;
+    }
+
+    return retval;
+}
+
+
+
+
+
+uint32_t Telemetry::GetSharedMemoryName(const char** ppName)
+{
+    uint32_t retval = XLNX_OK;
+
+    retval = CheckInitialised();
+
+    if (retval == XLNX_OK)
+    {
+        *ppName = m_sharedMemoryName.c_str();
+    }
+
+    return retval;
+}
+
+
+
+
+
+uint32_t Telemetry::CreateSharedMemory(const char* sharedMemoryName)
+{
+    uint32_t retval = XLNX_OK;
+    void* pMapping = nullptr;
+
+    retval = TelemetryCreateSharedMemory(sharedMemoryName, sizeof(TelemetrySharedRegion), &pMapping);
+
+    if (retval == XLNX_OK)
+    {
+        m_pRegion = (TelemetrySharedRegion*)pMapping;
+        m_sharedMemoryName = sharedMemoryName;
+
+        m_pRegion->version = XLNX_TELEMETRY_SHARED_VERSION;
+        m_pRegion->sequence.store(0, std::memory_order_relaxed);
+
+        //readers check the magic number, so it goes in last
+        std::atomic_thread_fence(std::memory_order_release);
+        m_pRegion->magic = XLNX_TELEMETRY_SHARED_MAGIC;
+    }
+
+    return retval;
+}
+
+
+
+
+
+void Telemetry::DestroySharedMemory(void)
+{
+    TelemetryDestroySharedMemory(m_sharedMemoryName.c_str(), (void*)m_pRegion, sizeof(TelemetrySharedRegion));
+
+    m_pRegion = nullptr;
+    m_sharedMemoryName.clear();
+}
+
+
+
+
+
+uint32_t Telemetry::AddBlock(const char* name, uint64_t address, uint32_t numWords)
+{
+    uint32_t retval = XLNX_OK;
+    bool bIsRunning;
+    uint32_t i;
+
+    retval = CheckInitialised();
+
+
+    if (retval == XLNX_OK)
+    {
+        //the layout of the snapshot buffers changes when a block is added, so this is a setup-time operation
+        IsRunning(&bIsRunning);
+
+        if (bIsRunning)
+        {
+            retval = XLNX_TELEMETRY_ERROR_ALREADY_RUNNING;
+        }
+    }
+
+
+    if (retval == XLNX_OK)
+    {
+        if ((name == nullptr) || (strlen(name) >= XLNX_TELEMETRY_MAX_BLOCK_NAME_LENGTH) || (name[0] == '\0') ||
+            (numWords == 0) || ((address % sizeof(uint32_t)) != 0))
+        {
+            retval = XLNX_TELEMETRY_ERROR_INVALID_PARAMETER;
+        }
+    }
+
+
+    std::lock_guard<std::mutex> lock(m_snapshotMutex);
+
+
+    if (retval == XLNX_OK)
+    {
+        for (i = 0; i < m_numBlocks; i++)
+        {
+            if (strcmp(m_blocks[i].name, name) == 0)
+            {
+                retval = XLNX_TELEMETRY_ERROR_INVALID_PARAMETER;
+                break;
+            }
+        }
+    }
+
+
+    if (retval == XLNX_OK)
+    {
+        if (m_numBlocks >= XLNX_TELEMETRY_MAX_BLOCKS)
+        {
+            retval = XLNX_TELEMETRY_ERROR_TOO_MANY_BLOCKS;
+        }
+    }
+
+
+    if (retval == XLNX_OK)
+    {
+        memset(&m_blocks[m_numBlocks], 0, sizeof(TelemetrySharedBlock));
+        strncpy(m_blocks[m_numBlocks].name, name, XLNX_TELEMETRY_MAX_BLOCK_NAME_LENGTH - 1);
+        m_blocks[m_numBlocks].address = address;
+        m_blocks[m_numBlocks].numWords = numWords;
+
+        retval = BuildSpans(m_numBlocks + 1);
+    }
+
+
+    if (retval == XLNX_OK)
+    {
+        m_numBlocks++;
+    }
+
+    return retval;
+}
+
+
+
+
+
+uint32_t Telemetry::BuildSpans(uint32_t numBlocks)
+{
+    uint32_t retval = XLNX_OK;
+    uint32_t order[XLNX_TELEMETRY_MAX_BLOCKS];
+    Span spans[XLNX_TELEMETRY_MAX_BLOCKS];
+    uint32_t spanIndex[XLNX_TELEMETRY_MAX_BLOCKS];
+    uint32_t numSpans = 0;
+    uint32_t numDataWords = 0;
+    uint64_t blockEnd;
+    uint64_t spanEnd;
+    uint32_t i;
+    uint32_t j;
+    uint32_t block;
+
+
+    //sort the blocks by address (there are only ever a few tens of them)
+    for (i = 0; i < numBlocks; i++)
+    {
+        j = i;
+
+        while ((j > 0) && (m_blocks[order[j - 1]].address > m_blocks[i].address))
+        {
+            order[j] = order[j - 1];
+            j--;
+        }
+
+        order[j] = i;
+    }
+
+
+    //...then walk them in order, extending the current span whenever the next block starts within
+    //MAX_SPAN_GAP_BYTES of its end (this also takes care of blocks that overlap)
+    for (i = 0; i < numBlocks; i++)
+    {
+        block = order[i];
+        blockEnd = m_blocks[block].address + ((uint64_t)m_blocks[block].numWords * sizeof(uint32_t));
+
+        if (numSpans > 0)
+        {
+            spanEnd = spans[numSpans - 1].address + ((uint64_t)spans[numSpans - 1].numWords * sizeof(uint32_t));
+
+            if (m_blocks[block].address <= (spanEnd + MAX_SPAN_GAP_BYTES))
+            {
+                if (blockEnd > spanEnd)
+                {
+                    spans[numSpans - 1].numWords = (uint32_t)((blockEnd - spans[numSpans - 1].address) / sizeof(uint32_t));
+                }
+
+                spanIndex[block] = numSpans - 1;
+                continue;
+            }
+        }
+
+        spans[numSpans].address = m_blocks[block].address;
+        spans[numSpans].numWords = m_blocks[block].numWords;
+        spanIndex[block] = numSpans;
+        numSpans++;
+    }
+
+
+    for (i = 0; i < numSpans; i++)
+    {
+        spans[i].dataWordOffset = numDataWords;
+        numDataWords += spans[i].numWords;
+    }
+
+
+    if (numDataWords > XLNX_TELEMETRY_MAX_WORDS)
+    {
+        retval = XLNX_TELEMETRY_ERROR_TOO_MANY_WORDS;
+    }
+
+
+    if (retval == XLNX_OK)
+    {
+        for (i = 0; i < numBlocks; i++)
+        {
+            m_blocks[i].dataWordOffset = spans[spanIndex[i]].dataWordOffset +
+                                         (uint32_t)((m_blocks[i].address - spans[spanIndex[i]].address) / sizeof(uint32_t));
+        }
+
+        memcpy(m_spans, spans, numSpans * sizeof(Span));
+        m_numSpans = numSpans;
+        m_numDataWords = numDataWords;
+
+
+        //publish the new descriptors - the block count goes last so a reader never sees an unfilled entry
+        memcpy(m_pRegion->blocks, m_blocks, numBlocks * sizeof(TelemetrySharedBlock));
+        m_pRegion->numDataWords = numDataWords;
+
+        std::atomic_thread_fence(std::memory_order_release);
+        m_pRegion->numBlocks = numBlocks;
+    }
+
+    return retval;
+}
+
+
+
+
+
+uint32_t Telemetry::GetNumBlocks(uint32_t* pNumBlocks)
+{
+    uint32_t retval = XLNX_OK;
+
+    retval = CheckInitialised();
+
+    if (retval == XLNX_OK)
+    {
+        *pNumBlocks = m_numBlocks;
+    }
+
+    return retval;
+}
+
+
+
+
+
+uint32_t Telemetry::GetNumSpans(uint32_t* pNumSpans)
+{
+    uint32_t retval = XLNX_OK;
+
+    retval = CheckInitialised();
+
+    if (retval == XLNX_OK)
+    {
+        *pNumSpans = m_numSpans;
+    }
+
+    return retval;
+}
+
+
+
+
+
+uint32_t Telemetry::GetNumDataWords(uint32_t* pNumWords)
+{
+    uint32_t retval = XLNX_OK;
+
+    retval = CheckInitialised();
+
+    if (retval == XLNX_OK)
+    {
+        *pNumWords = m_numDataWords;
+    }
+
+    return retval;
+}
+
+
+
+
+
+uint32_t Telemetry::Snapshot(void)
+{
+    uint32_t retval = XLNX_OK;
+    TelemetrySharedBuffer* pBuffer;
+    uint64_t sequence;
+    uint32_t status = 0;
+    uint64_t elapsedNanoseconds;
+    uint32_t i;
+
+    retval = CheckInitialised();
+
+
+    if (retval == XLNX_OK)
+    {
+        std::lock_guard<std::mutex> lock(m_snapshotMutex);
+
+        //fill the buffer that readers are NOT currently being pointed at...
+        sequence = m_pRegion->sequence.load(std::memory_order_relaxed) + 1;
+        pBuffer = &m_pRegion->buffers[sequence % XLNX_TELEMETRY_NUM_BUFFERS];
+
+        pBuffer->sequence = sequence;
+        std::atomic_thread_fence(std::memory_order_release);
+
+        std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+
+        for (i = 0; i < m_numSpans; i++)
+        {
+            if (m_pDeviceInterface->BlockReadReg32(m_spans[i].address, &pBuffer->data[m_spans[i].dataWordOffset], m_spans[i].numWords) != XLNX_OK)
+            {
+                status |= XLNX_TELEMETRY_STATUS_READ_ERROR;
+                m_numDeviceReadErrors++;
+            }
+        }
+
+        std::chrono::steady_clock::time_point endTime = std::chrono::steady_clock::now();
+
+        pBuffer->timestampNanoseconds = (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(endTime.time_since_epoch()).count();
+        pBuffer->status = status;
+
+
+        //...then point readers at it
+        m_pRegion->sequence.store(sequence, std::memory_order_release);
+
+
+        elapsedNanoseconds = (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(endTime - startTime).count();
+
+        m_lastSnapshotNanoseconds = elapsedNanoseconds;
+
+        if (elapsedNanoseconds > m_maxSnapshotNanoseconds)
+        {
+            m_maxSnapshotNanoseconds = elapsedNanoseconds;
+        }
+
+        m_numDeviceReads += m_numSpans;
+        m_numSnapshots++;
+
+        if (status != 0)
+        {
+            retval = XLNX_TELEMETRY_ERROR_DEVICE_READ_FAILED;
+        }
+    }
+
+    return retval;
+}
+
+
+
+
+
+uint32_t Telemetry::Start(uint32_t intervalMilliseconds)
+{
+    uint32_t retval = XLNX_OK;
+    bool bIsRunning;
+
+    retval = CheckInitialised();
+
+
+    if (retval == XLNX_OK)
+    {
+        if (intervalMilliseconds == 0)
+        {
+            retval = XLNX_TELEMETRY_ERROR_INVALID_PARAMETER;
+        }
+    }
+
+
+    if (retval == XLNX_OK)
+    {
+        IsRunning(&bIsRunning);
+
+        if (bIsRunning)
+        {
+            retval = XLNX_TELEMETRY_ERROR_ALREADY_RUNNING;
+        }
+    }
+
+
+    if (retval == XLNX_OK)
+    {
+        m_intervalMilliseconds = intervalMilliseconds;
+        m_bKeepRunning = true;
+
+        m_thread = std::thread(&Telemetry::ThreadFunc, this);
+    }
+
+    return retval;
+}
+
+
+
+
+
+uint32_t Telemetry::Stop(void)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_threadMutex);
+        m_bKeepRunning = false;
+    }
+
+    m_threadCondition.notify_all();
+
+    if (m_thread.joinable())
+    {
+        m_thread.join();
+    }
+
+    return XLNX_OK;
+}
+
+
+
+
+
+uint32_t Telemetry::IsRunning(bool* pbIsRunning)
+{
+    *pbIsRunning = m_thread.joinable();
+
+    return XLNX_OK;
+}
+
+
+
+
+
+uint32_t Telemetry::GetInterval(uint32_t* pIntervalMilliseconds)
+{
+    *pIntervalMilliseconds = m_intervalMilliseconds;
+
+    return XLNX_OK;
+}
+
+
+
+
+
+uint32_t Telemetry::GetReader(TelemetryReader** ppReader)
+{
+    uint32_t retval = XLNX_OK;
+
+    retval = CheckInitialised();
+
+    if (retval == XLNX_OK)
+    {
+        *ppReader = &m_reader;
+    }
+
+    return retval;
+}
+
+
+
+
+
+uint32_t Telemetry::GetStats(Stats* pStats)
+{
+    pStats->numSnapshots            = m_numSnapshots;
+    pStats->numDeviceReads          = m_numDeviceReads;
+    pStats->numDeviceReadErrors     = m_numDeviceReadErrors;
+    pStats->lastSnapshotNanoseconds = m_lastSnapshotNanoseconds;
+    pStats->maxSnapshotNanoseconds  = m_maxSnapshotNanoseconds;
+
+    return XLNX_OK;
+}
+
+
+
+
+
+uint32_t Telemetry::ResetStats(void)
+{
+    m_numSnapshots = 0;
+    m_numDeviceReads = 0;
+    m_numDeviceReadErrors = 0;
+    m_lastSnapshotNanoseconds = 0;
+    m_maxSnapshotNanoseconds = 0;
+
+    return XLNX_OK;
+}
+
+
+
+
+
+void Telemetry::ThreadFunc(void)
+{
+    std::unique_lock<std::mutex> lock(m_threadMutex);
+
+    while (m_bKeepRunning)
+    {
+        lock.unlock();
+
+        //a failed read is flagged in the snapshot status, so keep sampling regardless
+        Snapshot();
+
+        lock.lock();
+
+        //wait on the condition rather than sleeping so that Stop() does not have to wait out the interval
+        m_threadCondition.wait_for(lock, std::chrono::milliseconds(m_intervalMilliseconds), [this] { return (m_bKeepRunning == false); });
+    }
+}
@@ -0,0 +1,172 @@
+/*
+ * Copyright 2021 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+
+#ifndef XLNX_TELEMETRY_H
+#define XLNX_TELEMETRY_H
+
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+
+#include "xlnx_device_interface.h"
+
+#include "xlnx_telemetry_shared.h"
+#include "xlnx_telemetry_reader.h"
+#include "xlnx_telemetry_error_codes.h"
+
+
+namespace XLNX
+{
+
+
+//Periodically snapshots a set of named register blocks (typically the status/stats registers of each
+//kernel) and publishes them into a double-buffered shared memory region (see xlnx_telemetry_shared.h).
+//
+//Blocks are sorted by address and merged into as few contiguous spans as possible, each of which is
+//fetched with a single BlockReadReg32() call, so the cost of a snapshot is a handful of bus transactions
+//regardless of how many counters are being watched.  Shell commands and external processes then read the
+//published snapshots through TelemetryReader instead of going to the device themselves.
+class Telemetry
+{
+public:
+    Telemetry();
+    virtual ~Telemetry();
+
+
+public:
+    uint32_t Initialise(DeviceInterface* pDeviceInterface, const char* sharedMemoryName = XLNX_TELEMETRY_DEFAULT_SHARED_NAME);
+    uint32_t Uninitialise(void);
+    uint32_t IsInitialised(bool* pbIsInitialised);
+
+    uint32_t GetSharedMemoryName(const char** ppName);
+
+
+
+public: //Blocks
+    //Registers numWords consecutive 32-bit registers starting at the absolute device address.
+    //Registers lying in the gaps between blocks may also be read when spans are merged, so blocks
+    //should not be placed next to registers that have side effects when read (e.g. clear-on-read).
+    uint32_t AddBlock(const char* name, uint64_t address, uint32_t numWords);
+
+    uint32_t GetNumBlocks(uint32_t* pNumBlocks);
+    uint32_t GetNumSpans(uint32_t* pNumSpans);
+    uint32_t GetNumDataWords(uint32_t* pNumWords);
+
+
+
+public: //Sampling
+    //reads every span from the device and publishes the result as the latest snapshot
+    uint32_t Snapshot(void);
+
+    uint32_t Start(uint32_t intervalMilliseconds);
+    uint32_t Stop(void);
+    uint32_t IsRunning(bool* pbIsRunning);
+
+    uint32_t GetInterval(uint32_t* pIntervalMilliseconds);
+
+
+
+public: //Readback
+    //gives in-process consumers (e.g. shell commands) access to the published snapshots
+    uint32_t GetReader(TelemetryReader** ppReader);
+
+
+
+public: //Stats
+    typedef struct
+    {
+        uint64_t numSnapshots;
+        uint64_t numDeviceReads;            //BlockReadReg32 calls issued
+        uint64_t numDeviceReadErrors;
+        uint64_t lastSnapshotNanoseconds;   //time taken to read all spans for the most recent snapshot
+        uint64_t maxSnapshotNanoseconds;
+
+    }Stats;
+
+    uint32_t GetStats(Stats* pStats);
+    uint32_t ResetStats(void);
+
+
+
+protected:
+    uint32_t CheckInitialised(void);
+
+    uint32_t CreateSharedMemory(const char* sharedMemoryName);
+    void DestroySharedMemory(void);
+
+    //rebuilds the span list from the current set of blocks, and updates the block descriptors
+    //held in the shared memory region to match
+    uint32_t BuildSpans(uint32_t numBlocks);
+
+    void ThreadFunc(void);
+
+
+
+protected:
+    //gap (in bytes) below which two neighbouring blocks are read as one span - reading a few
+    //unwanted registers is far cheaper than issuing another bus transaction
+    static const uint32_t MAX_SPAN_GAP_BYTES = 256;
+
+    typedef struct
+    {
+        uint64_t address;
+        uint32_t numWords;
+        uint32_t dataWordOffset;
+
+    }Span;
+
+
+    bool m_bInitialised;
+    DeviceInterface* m_pDeviceInterface;
+
+    std::string m_sharedMemoryName;
+    TelemetrySharedRegion* m_pRegion;
+    TelemetryReader m_reader;
+
+    //guards the block/span lists and the shared region buffers against concurrent snapshots
+    std::mutex m_snapshotMutex;
+
+    TelemetrySharedBlock m_blocks[XLNX_TELEMETRY_MAX_BLOCKS];
+    uint32_t m_numBlocks;
+    Span m_spans[XLNX_TELEMETRY_MAX_BLOCKS];
+    uint32_t m_numSpans;
+    uint32_t m_numDataWords;
+
+    std::thread m_thread;
+    std::atomic<bool> m_bKeepRunning;
+    std::mutex m_threadMutex;
+    std::condition_variable m_threadCondition;
+    uint32_t m_intervalMilliseconds;
+
+    std::atomic<uint64_t> m_numSnapshots;
+    std::atomic<uint64_t> m_numDeviceReads;
+    std::atomic<uint64_t> m_numDeviceReadErrors;
+    std::atomic<uint64_t> m_lastSnapshotNanoseconds;
+    std::atomic<uint64_t> m_maxSnapshotNanoseconds;
+};
+
+
+
+} //namespace XLNX
+
+
+
+#endif
@@ -0,0 +1,48 @@
+/*
+ * Copyright 2021 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+
+#ifndef XLNX_TELEMETRY_ERROR_CODES_H
+#define XLNX_TELEMETRY_ERROR_CODES_H
+
+#ifndef XLNX_OK
+#define XLNX_OK														(0x00000000)
+#endif
+
+#define XLNX_TELEMETRY_ERROR_NOT_INITIALISED                        (0x00000001)
+#define XLNX_TELEMETRY_ERROR_INVALID_PARAMETER                      (0x00000002)
+#define XLNX_TELEMETRY_ERROR_TOO_MANY_BLOCKS                        (0x00000003)
+#define XLNX_TELEMETRY_ERROR_TOO_MANY_WORDS                         (0x00000004)
+#define XLNX_TELEMETRY_ERROR_BLOCK_NOT_FOUND                        (0x00000005)
+#define XLNX_TELEMETRY_ERROR_ALREADY_RUNNING                        (0x00000006)
+#define XLNX_TELEMETRY_ERROR_FAILED_TO_CREATE_SHARED_MEMORY         (0x00000007)
+#define XLNX_TELEMETRY_ERROR_FAILED_TO_OPEN_SHARED_MEMORY           (0x00000008)
+#define XLNX_TELEMETRY_ERROR_INCOMPATIBLE_SHARED_MEMORY             (0x00000009)
+#define XLNX_TELEMETRY_ERROR_NO_SNAPSHOT                            (0x0000000A)
+#define XLNX_TELEMETRY_ERROR_SNAPSHOT_BUSY                          (0x0000000B)
+#define XLNX_TELEMETRY_ERROR_BUFFER_TOO_SMALL                       (0x0000000C)
+#define XLNX_TELEMETRY_ERROR_DEVICE_READ_FAILED                     (0x0000000D)
+#define XLNX_TELEMETRY_ERROR_TOO_MANY_METRICS                       (0x0000000E)
+#define XLNX_TELEMETRY_ERROR_METRIC_NOT_FOUND                       (0x0000000F)
+#define XLNX_TELEMETRY_ERROR_SERVER_ALREADY_RUNNING                 (0x00000010)
+#define XLNX_TELEMETRY_ERROR_FAILED_TO_START_SERVER                 (0x00000011)
+#define XLNX_TELEMETRY_ERROR_NOT_RUNNING                            (0x00000012)
+
+
+
+
+#endif
@@ -0,0 +1,380 @@
+/*
+ * Copyright 2021 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <cstring>
+
+#include "xlnx_telemetry_reader.h"
+#include "xlnx_telemetry_shared_memory.h"
+using namespace XLNX;
+
+
+
+
+TelemetryReader::TelemetryReader()
+{
+    m_pRegion = nullptr;
+    m_bMapped = false;
+}
+
+
+
+
+TelemetryReader::~TelemetryReader()
+{
+    Close();
+}
+
+
+
+
+
+uint32_t TelemetryReader::Open(const char* sharedMemoryName)
+{
+    uint32_t retval = XLNX_OK;
+    const void* pMapping = nullptr;
+    const TelemetrySharedRegion* pRegion;
+
+    Close();
+
+    if (sharedMemoryName == nullptr)
+    {
+        retval = XLNX_TELEMETRY_ERROR_INVALID_PARAMETER;
+    }
+
+
+    if (retval == XLNX_OK)
+    {
+        retval = TelemetryOpenSharedMemory(sharedMemoryName, sizeof(TelemetrySharedRegion), &pMapping);
+    }
+
+
+    if (retval == XLNX_OK)
+    {
+        pRegion = (const TelemetrySharedRegion*)pMapping;
+
+        if ((pRegion->magic != XLNX_TELEMETRY_SHARED_MAGIC) || (pRegion->version != XLNX_TELEMETRY_SHARED_VERSION))
+        {
+            TelemetryCloseSharedMemory(pMapping, sizeof(TelemetrySharedRegion));
+            retval = XLNX_TELEMETRY_ERROR_INCOMPATIBLE_SHARED_MEMORY;
+        }
+    }
+
+
+    if (retval == XLNX_OK)
+    {
+        m_pRegion = pRegion;
+        m_bMapped = true;
+    }
+
+    return retval;
+}
+
+
+
+
+
+uint32_t TelemetryReader::Attach(const TelemetrySharedRegion* pRegion)
+{
+    uint32_t retval = XLNX_OK;
+
+    Close();
+
+    if (pRegion == nullptr)
+    {
+        retval = XLNX_TELEMETRY_ERROR_INVALID_PARAMETER;
+    }
+    else
+    {
+        m_pRegion = pRegion;
+        m_bMapped = false;
+    }
+
+    return retval;
+}
+
+
+
+
+
+uint32_t TelemetryReader::Close(void)
+{
+    if ((m_pRegion != nullptr) && m_bMapped)
+    {
+        TelemetryCloseSharedMemory(m_pRegion, sizeof(TelemetrySharedRegion));
+    }
+
+    m_pRegion = nullptr;
+    m_bMapped = false;
+
+    return XLNX_OK;
+}
+
+
+
+
+
+uint32_t TelemetryReader::IsOpen(bool* pbIsOpen)
+{
+    *pbIsOpen = (m_pRegion != nullptr);
+
+    return XLNX_OK;
+}
+
+
+
+
+
+uint32_t TelemetryReader::CheckIsOpen(void)
+{
+    uint32_t retval = XLNX_OK;
+
+    if (m_pRegion == nullptr)
+    {
+        retval = XLNX_TELEMETRY_ERROR_NOT_INITIALISED;
+    }
+
+    return retval;
+}
+
+
+
+
+
+uint32_t TelemetryReader::GetNumBlocks(uint32_t* pNumBlocks)
+{
+    uint32_t retval = XLNX_OK;
+
+    retval = CheckIsOpen();
+
+    if (retval == XLNX_OK)
+    {
+        *pNumBlocks = m_pRegion->numBlocks;
+    }
+
+    return retval;
+}
+
+
+
+
+
+uint32_t TelemetryReader::GetBlockInfo(uint32_t blockIndex, TelemetrySharedBlock* pBlockInfo)
+{
+    uint32_t retval = XLNX_OK;
+
+    retval = CheckIsOpen();
+
+    if (retval == XLNX_OK)
+    {
+        if (blockIndex >= m_pRegion->numBlocks)
+        {
+            retval = XLNX_TELEMETRY_ERROR_BLOCK_NOT_FOUND;
+        }
+    }
+
+    if (retval == XLNX_OK)
+    {
+        *pBlockInfo = m_pRegion->blocks[blockIndex];
+
+        pBlockInfo->name[XLNX_TELEMETRY_MAX_BLOCK_NAME_LENGTH - 1] = '\0';
+    }
+
+    return retval;
+}
+
+
+
+
+
+uint32_t TelemetryReader::FindBlock(const char* name, uint32_t* pBlockIndex)
+{
+    uint32_t retval = XLNX_OK;
+    uint32_t i;
+
+    retval = CheckIsOpen();
+
+    if (retval == XLNX_OK)
+    {
+        retval = XLNX_TELEMETRY_ERROR_BLOCK_NOT_FOUND;
+
+        for (i = 0; i < m_pRegion->numBlocks; i++)
+        {
+            if (strncmp(m_pRegion->blocks[i].name, name, XLNX_TELEMETRY_MAX_BLOCK_NAME_LENGTH) == 0)
+            {
+                *pBlockIndex = i;
+                retval = XLNX_OK;
+                break;
+            }
+        }
+    }
+
+    return retval;
+}
+
+
+
+
+
+uint32_t TelemetryReader::GetSequence(uint64_t* pSequence)
+{
+    uint32_t retval = XLNX_OK;
+
+    retval = CheckIsOpen();
+
+    if (retval == XLNX_OK)
+    {
+        *pSequence = m_pRegion->sequence.load(std::memory_order_acquire);
+    }
+
+    return retval;
+}
+
+
+
+
+
+uint32_t TelemetryReader::CopyLatest(uint32_t dataWordOffset, uint32_t numWords, uint32_t* pBuffer,
+                                     uint64_t* pSequence, uint64_t* pTimestampNanoseconds, uint32_t* pStatus)
+{
+    uint32_t retval = XLNX_TELEMETRY_ERROR_SNAPSHOT_BUSY;
+    const TelemetrySharedBuffer* pSharedBuffer;
+    uint64_t sequence;
+    uint64_t bufferSequence;
+    uint64_t timestamp;
+    uint32_t status;
+    uint32_t attempt;
+
+    for (attempt = 0; attempt < MAX_COPY_ATTEMPTS; attempt++)
+    {
+        sequence = m_pRegion->sequence.load(std::memory_order_acquire);
+
+        if (sequence == 0)
+        {
+            retval = XLNX_TELEMETRY_ERROR_NO_SNAPSHOT;
+            break;
+        }
+
+        pSharedBuffer = &m_pRegion->buffers[sequence % XLNX_TELEMETRY_NUM_BUFFERS];
+
+        bufferSequence  = pSharedBuffer->sequence;
+        timestamp       = pSharedBuffer->timestampNanoseconds;
+        status          = pSharedBuffer->status;
+
+        memcpy(pBuffer, &pSharedBuffer->data[dataWordOffset], numWords * sizeof(uint32_t));
+
+        //if the writer has not moved on far enough to start reusing this buffer, what we copied is intact
+        std::atomic_thread_fence(std::memory_order_acquire);
+
+        if ((m_pRegion->sequence.load(std::memory_order_relaxed) == sequence) && (bufferSequence == sequence))
+        {
+            *pSequence = sequence;
+            *pTimestampNanoseconds = timestamp;
+            *pStatus = status;
+            retval = XLNX_OK;
+            break;
+        }
+    }
+
+    return retval;
+}
+
+
+
+
+
+uint32_t TelemetryReader::ReadSnapshot(TelemetrySharedBuffer* pBuffer)
+{
+    uint32_t retval = XLNX_OK;
+    uint64_t sequence;
+    uint64_t timestamp;
+    uint32_t status;
+
+    retval = CheckIsOpen();
+
+    if (retval == XLNX_OK)
+    {
+        retval = CopyLatest(0, XLNX_TELEMETRY_MAX_WORDS, pBuffer->data, &sequence, &timestamp, &status);
+    }
+
+    if (retval == XLNX_OK)
+    {
+        pBuffer->sequence = sequence;
+        pBuffer->timestampNanoseconds = timestamp;
+        pBuffer->status = status;
+        pBuffer->reserved = 0;
+    }
+
+    return retval;
+}
+
+
+
+
+
+uint32_t TelemetryReader::ReadBlock(uint32_t blockIndex, uint32_t* pBuffer, uint32_t maxWords, uint32_t* pNumWords,
+                                    uint64_t* pSequence, uint64_t* pTimestampNanoseconds)
+{
+    uint32_t retval = XLNX_OK;
+    TelemetrySharedBlock blockInfo;
+    uint32_t status;
+
+    retval = GetBlockInfo(blockIndex, &blockInfo);
+
+    if (retval == XLNX_OK)
+    {
+        if (((uint64_t)blockInfo.dataWordOffset + blockInfo.numWords) > XLNX_TELEMETRY_MAX_WORDS)
+        {
+            retval = XLNX_TELEMETRY_ERROR_INCOMPATIBLE_SHARED_MEMORY;
+        }
+        else if (blockInfo.numWords > maxWords)
+        {
+            retval = XLNX_TELEMETRY_ERROR_BUFFER_TOO_SMALL;
+        }
+    }
+
+    if (retval == XLNX_OK)
+    {
+        retval = CopyLatest(blockInfo.dataWordOffset, blockInfo.numWords, pBuffer, pSequence, pTimestampNanoseconds, &status);
+    }
+
+    if (retval == XLNX_OK)
+    {
+        *pNumWords = blockInfo.numWords;
+    }
+
+    return retval;
+}
+
+
+
+
+
+uint32_t TelemetryReader::ReadBlock(const char* name, uint32_t* pBuffer, uint32_t maxWords, uint32_t* pNumWords,
+                                    uint64_t* pSequence, uint64_t* pTimestampNanoseconds)
+{
+    uint32_t retval = XLNX_OK;
+    uint32_t blockIndex;
+
+    retval = FindBlock(name, &blockIndex);
+
+    if (retval == XLNX_OK)
+    {
+        retval = ReadBlock(blockIndex, pBuffer, maxWords, pNumWords, pSequence, pTimestampNanoseconds);
+    }
+
+    return retval;
+}
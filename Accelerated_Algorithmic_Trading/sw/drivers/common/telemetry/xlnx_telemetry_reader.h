@@ -0,0 +1,102 @@
+/*
+ * Copyright 2021 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+
+#ifndef XLNX_TELEMETRY_READER_H
+#define XLNX_TELEMETRY_READER_H
+
+#include <cstdint>
+
+#include "xlnx_telemetry_shared.h"
+#include "xlnx_telemetry_error_codes.h"
+
+
+namespace XLNX
+{
+
+
+//Consumes the register snapshots published by Telemetry.  Nothing here touches the device - a reader can
+//live in the same process as the writer (see Attach) or in any other process on the host (see Open), and
+//any number of readers can poll the snapshots at whatever rate they like without adding device traffic.
+class TelemetryReader
+{
+public:
+    TelemetryReader();
+    virtual ~TelemetryReader();
+
+
+public:
+    //maps the shared memory region created by a Telemetry object in another process
+    uint32_t Open(const char* sharedMemoryName = XLNX_TELEMETRY_DEFAULT_SHARED_NAME);
+
+    //uses a region that is already mapped into this process
+    uint32_t Attach(const TelemetrySharedRegion* pRegion);
+
+    uint32_t Close(void);
+    uint32_t IsOpen(bool* pbIsOpen);
+
+
+
+public: //Block Descriptors
+    uint32_t GetNumBlocks(uint32_t* pNumBlocks);
+    uint32_t GetBlockInfo(uint32_t blockIndex, TelemetrySharedBlock* pBlockInfo);
+    uint32_t FindBlock(const char* name, uint32_t* pBlockIndex);
+
+
+
+public: //Snapshots
+    //sequence number of the latest published snapshot, 0 if none have been published yet
+    uint32_t GetSequence(uint64_t* pSequence);
+
+    //copies the whole of the latest snapshot, so that all blocks come from the same point in time
+    uint32_t ReadSnapshot(TelemetrySharedBuffer* pBuffer);
+
+    //copies the registers of a single block from the latest snapshot
+    uint32_t ReadBlock(uint32_t blockIndex, uint32_t* pBuffer, uint32_t maxWords, uint32_t* pNumWords,
+                       uint64_t* pSequence, uint64_t* pTimestampNanoseconds);
+
+    uint32_t ReadBlock(const char* name, uint32_t* pBuffer, uint32_t maxWords, uint32_t* pNumWords,
+                       uint64_t* pSequence, uint64_t* pTimestampNanoseconds);
+
+
+
+protected:
+    uint32_t CheckIsOpen(void);
+
+    //copies numWords starting at dataWordOffset out of the latest snapshot, retrying if the writer
+    //overtook us while we were copying
+    uint32_t CopyLatest(uint32_t dataWordOffset, uint32_t numWords, uint32_t* pBuffer,
+                        uint64_t* pSequence, uint64_t* pTimestampNanoseconds, uint32_t* pStatus);
+
+
+
+protected:
+    //a reader only fails to get a stable copy if the writer publishes twice while it is copying,
+    //so a handful of retries is plenty unless the writer is being driven flat out
+    static const uint32_t MAX_COPY_ATTEMPTS = 16;
+
+    const TelemetrySharedRegion* m_pRegion;
+    bool m_bMapped;         //true if we mapped the region (and must unmap it), false if it was attached
+};
+
+
+
+} //namespace XLNX
+
+
+
+#endif
@@ -0,0 +1,151 @@
+/*
+ * Copyright 2021 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "xlnx_telemetry_register_snapshot.h"
+using namespace XLNX;
+
+
+
+
+TelemetryRegisterSnapshot::TelemetryRegisterSnapshot()
+{
+    m_bLoaded = false;
+    m_numBlocks = 0;
+}
+
+
+
+
+TelemetryRegisterSnapshot::~TelemetryRegisterSnapshot()
+{
+    //nothing to do
+}
+
+
+
+
+
+uint32_t TelemetryRegisterSnapshot::Load(Telemetry* pTelemetry)
+{
+    uint32_t retval = XLNX_OK;
+    TelemetryReader* pReader = nullptr;
+    bool bIsRunning = false;
+    uint32_t i;
+
+    m_bLoaded = false;
+    m_numBlocks = 0;
+
+    if (pTelemetry == nullptr)
+    {
+        retval = XLNX_TELEMETRY_ERROR_INVALID_PARAMETER;
+    }
+
+
+    if (retval == XLNX_OK)
+    {
+        retval = pTelemetry->IsRunning(&bIsRunning);
+    }
+
+    if (retval == XLNX_OK)
+    {
+        //a snapshot left behind by a sampler that has since been stopped could be arbitrarily old
+        if (bIsRunning == false)
+        {
+            retval = XLNX_TELEMETRY_ERROR_NOT_RUNNING;
+        }
+    }
+
+    if (retval == XLNX_OK)
+    {
+        retval = pTelemetry->GetReader(&pReader);
+    }
+
+    if (retval == XLNX_OK)
+    {
+        retval = pReader->GetNumBlocks(&m_numBlocks);
+    }
+
+    for (i = 0; (i < m_numBlocks) && (retval == XLNX_OK); i++)
+    {
+        retval = pReader->GetBlockInfo(i, &m_blocks[i]);
+    }
+
+    if (retval == XLNX_OK)
+    {
+        retval = pReader->ReadSnapshot(&m_buffer);
+    }
+
+    if (retval == XLNX_OK)
+    {
+        if (m_buffer.status & XLNX_TELEMETRY_STATUS_READ_ERROR)
+        {
+            retval = XLNX_TELEMETRY_ERROR_DEVICE_READ_FAILED;
+        }
+    }
+
+
+    if (retval == XLNX_OK)
+    {
+        m_bLoaded = true;
+    }
+    else
+    {
+        m_numBlocks = 0;
+    }
+
+    return retval;
+}
+
+
+
+
+
+uint32_t TelemetryRegisterSnapshot::IsLoaded(bool* pbIsLoaded)
+{
+    *pbIsLoaded = m_bLoaded;
+
+    return XLNX_OK;
+}
+
+
+
+
+
+uint32_t TelemetryRegisterSnapshot::ReadReg32(uint64_t address, uint32_t* pValue)
+{
+    uint32_t retval = XLNX_TELEMETRY_ERROR_BLOCK_NOT_FOUND;
+    uint64_t byteOffset;
+    uint32_t i;
+
+    for (i = 0; i < m_numBlocks; i++)
+    {
+        if ((address >= m_blocks[i].address) && (address < (m_blocks[i].address + ((uint64_t)m_blocks[i].numWords * sizeof(uint32_t)))))
+        {
+            byteOffset = address - m_blocks[i].address;
+
+            if ((byteOffset % sizeof(uint32_t)) == 0)
+            {
+                *pValue = m_buffer.data[m_blocks[i].dataWordOffset + (byteOffset / sizeof(uint32_t))];
+                retval = XLNX_OK;
+            }
+
+            break;
+        }
+    }
+
+    return retval;
+}
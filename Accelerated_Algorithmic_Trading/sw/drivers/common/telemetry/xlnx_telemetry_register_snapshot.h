@@ -0,0 +1,68 @@
+/*
+ * Copyright 2021 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef XLNX_TELEMETRY_REGISTER_SNAPSHOT_H
+#define XLNX_TELEMETRY_REGISTER_SNAPSHOT_H
+
+#include <cstdint>
+
+#include "xlnx_telemetry.h"
+#include "xlnx_telemetry_shared.h"
+#include "xlnx_telemetry_error_codes.h"
+
+
+namespace XLNX
+{
+
+
+//Local copy of the latest published telemetry snapshot, looked up by device address.  The driver GetStats
+//calls load one of these on entry so that, while the sampler is running, every register covered by a telemetry
+//block comes from the same snapshot and costs no device access.  Registers outside the blocks, or all of them
+//if the sampler is stopped, are still read from the device by the caller.
+class TelemetryRegisterSnapshot
+{
+public:
+    TelemetryRegisterSnapshot();
+    virtual ~TelemetryRegisterSnapshot();
+
+
+public:
+    //copies the block descriptors and the latest snapshot, fails (leaving nothing loaded) if pTelemetry is
+    //NULL, is not sampling, has not yet published a snapshot or could not read part of the latest one
+    uint32_t Load(Telemetry* pTelemetry);
+
+    uint32_t IsLoaded(bool* pbIsLoaded);
+
+    //value of the 32-bit register at the absolute device address, fails if no block covers it
+    uint32_t ReadReg32(uint64_t address, uint32_t* pValue);
+
+
+
+protected:
+    bool m_bLoaded;
+    uint32_t m_numBlocks;
+    TelemetrySharedBlock m_blocks[XLNX_TELEMETRY_MAX_BLOCKS];
+    TelemetrySharedBuffer m_buffer;
+};
+
+
+
+} //namespace XLNX
+
+
+
+#endif
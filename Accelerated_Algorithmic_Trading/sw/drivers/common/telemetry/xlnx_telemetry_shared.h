@@ -0,0 +1,105 @@
+/*
+ * Copyright 2021 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+
+#ifndef XLNX_TELEMETRY_SHARED_H
+#define XLNX_TELEMETRY_SHARED_H
+
+#include <cstdint>
+#include <atomic>
+
+
+//Layout of the shared memory region that Telemetry publishes register snapshots into.  It is mapped by
+//both the writer (the process that owns the device) and any number of readers, so it must only contain
+//fixed size POD data plus lock-free atomics - no pointers.
+//
+//Two snapshot buffers are kept.  The writer always fills the buffer the current sequence number does NOT
+//point at, then publishes it by incrementing the sequence number.  A reader copies the buffer selected by
+//the sequence number it loaded, and accepts the copy if the sequence number is unchanged afterwards
+//(i.e. the writer did not start reusing that buffer while it was being copied).
+
+
+namespace XLNX
+{
+
+
+#define XLNX_TELEMETRY_SHARED_MAGIC             (0x4D4C4554)     //"TELM"
+#define XLNX_TELEMETRY_SHARED_VERSION           (1)
+
+#define XLNX_TELEMETRY_DEFAULT_SHARED_NAME      "/xlnx_aat_telemetry"
+
+#define XLNX_TELEMETRY_MAX_BLOCKS               (32)
+#define XLNX_TELEMETRY_MAX_WORDS                (1024)
+#define XLNX_TELEMETRY_MAX_BLOCK_NAME_LENGTH    (32)
+
+#define XLNX_TELEMETRY_NUM_BUFFERS              (2)
+
+
+//the writer could not read one or more spans from the device, the affected words hold stale values
+#define XLNX_TELEMETRY_STATUS_READ_ERROR        (0x00000001)
+
+
+
+typedef struct
+{
+    char        name[XLNX_TELEMETRY_MAX_BLOCK_NAME_LENGTH];
+    uint64_t    address;            //absolute device address of the first register
+    uint32_t    numWords;
+    uint32_t    dataWordOffset;     //index of the first register within TelemetrySharedBuffer::data
+
+}TelemetrySharedBlock;
+
+
+
+typedef struct
+{
+    uint64_t    sequence;           //sequence number this buffer was published with
+    uint64_t    timestampNanoseconds;
+    uint32_t    status;
+    uint32_t    reserved;
+    uint32_t    data[XLNX_TELEMETRY_MAX_WORDS];
+
+}TelemetrySharedBuffer;
+
+
+
+typedef struct
+{
+    uint32_t                magic;
+    uint32_t                version;
+    uint32_t                numBlocks;
+    uint32_t                numDataWords;
+
+    //0 = nothing published yet, otherwise the latest snapshot lives in buffers[sequence & 1]
+    std::atomic<uint64_t>   sequence;
+
+    TelemetrySharedBlock    blocks[XLNX_TELEMETRY_MAX_BLOCKS];
+    TelemetrySharedBuffer   buffers[XLNX_TELEMETRY_NUM_BUFFERS];
+
+}TelemetrySharedRegion;
+
+
+
+static_assert(ATOMIC_LLONG_LOCK_FREE == 2, "telemetry sequence number must be lock-free to be shared between processes");
+
+
+
+} //namespace XLNX
+
+
+
+#endif
@@ -0,0 +1,164 @@
+/*
+ * Copyright 2021 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <cstring>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "xlnx_telemetry_shared_memory.h"
+#include "xlnx_telemetry_error_codes.h"
+using namespace XLNX;
+
+
+
+
+uint32_t XLNX::TelemetryCreateSharedMemory(const char* name, size_t size, void** ppRegion)
+{
+    uint32_t retval = XLNX_OK;
+    int fd;
+    void* pMapping = MAP_FAILED;
+
+    //NOTE - if a previous instance exited without cleaning up, we simply take over its region
+    fd = shm_open(name, O_CREAT | O_RDWR, S_IRUSR | S_IWUSR | S_IRGRP | S_IROTH);
+
+    if (fd < 0)
+    {
+        retval = XLNX_TELEMETRY_ERROR_FAILED_TO_CREATE_SHARED_MEMORY;
+    }
+
+
+    if (retval == XLNX_OK)
+    {
+        if (ftruncate(fd, size) != 0)
+        {
+            retval = XLNX_TELEMETRY_ERROR_FAILED_TO_CREATE_SHARED_MEMORY;
+        }
+    }
+
+
+    if (retval == XLNX_OK)
+    {
+        pMapping = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+
+        if (pMapping == MAP_FAILED)
+        {
+            retval = XLNX_TELEMETRY_ERROR_FAILED_TO_CREATE_SHARED_MEMORY;
+        }
+    }
+
+
+    if (fd >= 0)
+    {
+        close(fd);
+    }
+
+
+    if (retval == XLNX_OK)
+    {
+        memset(pMapping, 0, size);
+
+        *ppRegion = pMapping;
+    }
+    else if (fd >= 0)
+    {
+        shm_unlink(name);
+    }
+
+    return retval;
+}
+
+
+
+
+
+void XLNX::TelemetryDestroySharedMemory(const char* name, void* pRegion, size_t size)
+{
+    if (pRegion != nullptr)
+    {
+        munmap(pRegion, size);
+
+        shm_unlink(name);
+    }
+}
+
+
+
+
+
+uint32_t XLNX::TelemetryOpenSharedMemory(const char* name, size_t size, const void** ppRegion)
+{
+    uint32_t retval = XLNX_OK;
+    int fd;
+    struct stat fileStat;
+    void* pMapping = MAP_FAILED;
+
+    fd = shm_open(name, O_RDONLY, 0);
+
+    if (fd < 0)
+    {
+        retval = XLNX_TELEMETRY_ERROR_FAILED_TO_OPEN_SHARED_MEMORY;
+    }
+
+
+    if (retval == XLNX_OK)
+    {
+        if ((fstat(fd, &fileStat) != 0) || ((size_t)fileStat.st_size < size))
+        {
+            retval = XLNX_TELEMETRY_ERROR_INCOMPATIBLE_SHARED_MEMORY;
+        }
+    }
+
+
+    if (retval == XLNX_OK)
+    {
+        pMapping = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+
+        if (pMapping == MAP_FAILED)
+        {
+            retval = XLNX_TELEMETRY_ERROR_FAILED_TO_OPEN_SHARED_MEMORY;
+        }
+    }
+
+
+    if (fd >= 0)
+    {
+        close(fd);
+    }
+
+
+    if (retval == XLNX_OK)
+    {
+        *ppRegion = pMapping;
+    }
+
+    return retval;
+}
+
+
+
+
+
+void XLNX::TelemetryCloseSharedMemory(const void* pRegion, size_t size)
+{
+    if (pRegion != nullptr)
+    {
+        munmap((void*)pRegion, size);
+    }
+}
@@ -0,0 +1,49 @@
+/*
+ * Copyright 2021 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef XLNX_TELEMETRY_SHARED_MEMORY_H
+#define XLNX_TELEMETRY_SHARED_MEMORY_H
+
+#include <cstdint>
+#include <cstddef>
+
+
+namespace XLNX
+{
+
+
+//Thin wrappers around the POSIX shared memory calls used to publish telemetry regions.
+//The creating side owns the name and removes it again when it is finished with the region.
+
+//creates (or takes over a stale instance of) the named region, maps it read/write and zeroes it
+uint32_t TelemetryCreateSharedMemory(const char* name, size_t size, void** ppRegion);
+
+//unmaps the region and removes the name
+void TelemetryDestroySharedMemory(const char* name, void* pRegion, size_t size);
+
+//maps an existing region read-only, failing if it is smaller than expected
+uint32_t TelemetryOpenSharedMemory(const char* name, size_t size, const void** ppRegion);
+
+void TelemetryCloseSharedMemory(const void* pRegion, size_t size);
+
+
+
+} //namespace XLNX
+
+
+
+#endif
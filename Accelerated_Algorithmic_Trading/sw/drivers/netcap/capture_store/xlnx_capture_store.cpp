@@ -0,0 +1,664 @@
+/*
+ * Copyright 2021 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cstring>
+#include <algorithm>
+
+#include <fcntl.h>
+#include <glob.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "xlnx_capture_store.h"
+#include "xlnx_capture_store_error_codes.h"
+
+using namespace XLNX;
+
+
+
+#define ETHERNET_HEADER_LENGTH      (14)
+#define ETHERTYPE_VLAN              (0x8100)
+#define ETHERTYPE_QINQ              (0x88A8)
+#define ETHERTYPE_IPV4              (0x0800)
+#define IPV4_HEADER_MIN_LENGTH      (20)
+#define IP_PROTOCOL_TCP             (6)
+#define IP_PROTOCOL_UDP             (17)
+
+#define OUTPUT_FILE_BUFFER_SIZE     (4 * 1024 * 1024)
+
+
+
+
+static uint16_t ReadBigEndian16(const uint8_t* pData)
+{
+    return (uint16_t)((pData[0] << 8) | pData[1]);
+}
+
+
+
+
+static uint32_t ReadBigEndian32(const uint8_t* pData)
+{
+    return ((uint32_t)pData[0] << 24) | ((uint32_t)pData[1] << 16) | ((uint32_t)pData[2] << 8) | (uint32_t)pData[3];
+}
+
+
+
+
+static uint64_t GetRecordTimestamp(const pcaprec_hdr_t* pRecordHeader, bool bNanosecondTimestamps)
+{
+    uint64_t subSecondNanoseconds = pRecordHeader->ts_nsec;
+
+    if (bNanosecondTimestamps == false)
+    {
+        subSecondNanoseconds *= 1000; //field holds microseconds
+    }
+
+    return ((uint64_t)pRecordHeader->ts_sec * 1000000000) + subSecondNanoseconds;
+}
+
+
+
+
+
+CaptureStore::CaptureStore()
+{
+    m_bIsOpen = false;
+}
+
+
+
+
+CaptureStore::~CaptureStore()
+{
+    Close();
+}
+
+
+
+
+uint32_t CaptureStore::Open(const char* capturePath)
+{
+    uint32_t retval = XLNX_OK;
+    std::vector<std::string> paths;
+    Segment segment;
+
+    Close();
+
+    retval = FindSegmentPaths(capturePath, &paths);
+
+    for (size_t i = 0; (i < paths.size()) && (retval == XLNX_OK); i++)
+    {
+        retval = LoadSegment(paths[i], &segment);
+
+        if (retval == XLNX_OK)
+        {
+            m_segments.push_back(segment);
+        }
+    }
+
+    if (retval == XLNX_OK)
+    {
+        m_bIsOpen = true;
+    }
+    else
+    {
+        Close();
+    }
+
+    return retval;
+}
+
+
+
+
+uint32_t CaptureStore::Close(void)
+{
+    m_segments.clear();
+    m_bIsOpen = false;
+
+    return XLNX_OK;
+}
+
+
+
+
+uint32_t CaptureStore::GetNumSegments(uint32_t* pNumSegments)
+{
+    uint32_t retval = XLNX_OK;
+
+    retval = CheckIsOpen();
+
+    if (retval == XLNX_OK)
+    {
+        *pNumSegments = (uint32_t)m_segments.size();
+    }
+
+    return retval;
+}
+
+
+
+
+uint32_t CaptureStore::GetSegmentInfo(uint32_t segmentIndex, SegmentInfo* pInfo)
+{
+    uint32_t retval = XLNX_OK;
+
+    retval = CheckIsOpen();
+
+    if (retval == XLNX_OK)
+    {
+        if (segmentIndex >= m_segments.size())
+        {
+            retval = XLNX_CAPTURE_STORE_ERROR_INVALID_PARAMETER;
+        }
+    }
+
+    if (retval == XLNX_OK)
+    {
+        *pInfo = m_segments[segmentIndex].info;
+    }
+
+    return retval;
+}
+
+
+
+
+uint32_t CaptureStore::Extract(uint64_t startTimestamp, uint64_t endTimestamp, FlowFilter* pFilter, const char* outputPath, ExtractStats* pStats)
+{
+    uint32_t retval = XLNX_OK;
+    FILE* pOutputFile = nullptr;
+    bool bPastEnd = false;
+
+    memset(pStats, 0, sizeof(*pStats));
+
+    retval = CheckIsOpen();
+
+    if (retval == XLNX_OK)
+    {
+        if (startTimestamp > endTimestamp)
+        {
+            retval = XLNX_CAPTURE_STORE_ERROR_INVALID_PARAMETER;
+        }
+    }
+
+    if (retval == XLNX_OK)
+    {
+        pOutputFile = fopen(outputPath, "wb");
+
+        if (pOutputFile == nullptr)
+        {
+            retval = XLNX_CAPTURE_STORE_ERROR_FAILED_TO_OPEN_OUTPUT_FILE;
+        }
+    }
+
+    if (retval == XLNX_OK)
+    {
+        setvbuf(pOutputFile, nullptr, _IOFBF, OUTPUT_FILE_BUFFER_SIZE);
+
+        //all segments of a capture share the same file header
+        if (fwrite(&m_segments[0].fileHeader, sizeof(pcap_hdr_t), 1, pOutputFile) != 1)
+        {
+            retval = XLNX_CAPTURE_STORE_ERROR_OUTPUT_FILE_WRITE_FAILED;
+        }
+    }
+
+
+    for (size_t i = 0; (i < m_segments.size()) && (retval == XLNX_OK) && (bPastEnd == false); i++)
+    {
+        if (m_segments[i].info.bHasPackets == false)
+        {
+            continue;
+        }
+
+        if (m_segments[i].info.firstTimestamp > endTimestamp)
+        {
+            break; //out of loop - this and all later segments are after the window
+        }
+
+        //if the next segment already starts before the window, there is nothing for us in this one
+        if (((i + 1) < m_segments.size()) && m_segments[i + 1].info.bHasPackets && (m_segments[i + 1].info.firstTimestamp < startTimestamp))
+        {
+            continue;
+        }
+
+        retval = ExtractFromSegment(&m_segments[i], startTimestamp, endTimestamp, pFilter, pOutputFile, &bPastEnd, pStats);
+    }
+
+
+    if (pOutputFile != nullptr)
+    {
+        if ((fclose(pOutputFile) != 0) && (retval == XLNX_OK))
+        {
+            retval = XLNX_CAPTURE_STORE_ERROR_OUTPUT_FILE_WRITE_FAILED;
+        }
+    }
+
+    return retval;
+}
+
+
+
+
+uint32_t CaptureStore::CheckIsOpen(void)
+{
+    uint32_t retval = XLNX_OK;
+
+    if (m_bIsOpen == false)
+    {
+        retval = XLNX_CAPTURE_STORE_ERROR_NOT_OPEN;
+    }
+
+    return retval;
+}
+
+
+
+
+uint32_t CaptureStore::FindSegmentPaths(const char* capturePath, std::vector<std::string>* pPaths)
+{
+    uint32_t retval = XLNX_OK;
+    static const size_t SUFFIX_LENGTH = strlen(PCAP_FILE_SUFFIX);
+    struct stat fileStat;
+    std::string pattern;
+    glob_t globResult;
+
+    pPaths->clear();
+
+    if (stat(capturePath, &fileStat) == 0)
+    {
+        //a capture that was not segmented
+        pPaths->push_back(capturePath);
+    }
+    else
+    {
+        //<name>.pcap -> <name>_[0-9]...[0-9].pcap, matching PCAP_SEGMENT_NUMBER_FORMAT
+        pattern = capturePath;
+
+        if ((pattern.size() >= SUFFIX_LENGTH) && (pattern.compare(pattern.size() - SUFFIX_LENGTH, SUFFIX_LENGTH, PCAP_FILE_SUFFIX) == 0))
+        {
+            pattern.erase(pattern.size() - SUFFIX_LENGTH);
+        }
+
+        pattern += "_[0-9][0-9][0-9][0-9][0-9][0-9]";
+        pattern += PCAP_FILE_SUFFIX;
+
+        //glob() returns the names sorted, which is also segment order
+        if (glob(pattern.c_str(), 0, nullptr, &globResult) == 0)
+        {
+            for (size_t i = 0; i < globResult.gl_pathc; i++)
+            {
+                pPaths->push_back(globResult.gl_pathv[i]);
+            }
+
+            globfree(&globResult);
+        }
+    }
+
+    if (pPaths->empty())
+    {
+        retval = XLNX_CAPTURE_STORE_ERROR_NO_SEGMENTS_FOUND;
+    }
+
+    return retval;
+}
+
+
+
+
+uint32_t CaptureStore::LoadSegment(const std::string& path, Segment* pSegment)
+{
+    uint32_t retval = XLNX_OK;
+    int fd;
+    struct stat fileStat;
+    pcaprec_hdr_t recordHeader;
+
+    pSegment->info.path = path;
+    pSegment->info.fileSize = 0;
+    pSegment->info.firstTimestamp = 0;
+    pSegment->info.numIndexEntries = 0;
+    pSegment->info.bHasPackets = false;
+    pSegment->index.clear();
+
+    fd = open(path.c_str(), O_RDONLY);
+
+    if (fd < 0)
+    {
+        retval = XLNX_CAPTURE_STORE_ERROR_FAILED_TO_OPEN_SEGMENT;
+    }
+
+    if (retval == XLNX_OK)
+    {
+        if ((fstat(fd, &fileStat) != 0) ||
+            (pread(fd, &pSegment->fileHeader, sizeof(pcap_hdr_t), 0) != (ssize_t)sizeof(pcap_hdr_t)))
+        {
+            retval = XLNX_CAPTURE_STORE_ERROR_INVALID_SEGMENT;
+        }
+    }
+
+    if (retval == XLNX_OK)
+    {
+        pSegment->info.fileSize = (uint64_t)fileStat.st_size;
+
+        //only native byte order files are supported
+        if (pSegment->fileHeader.magic_number == PCAP_MAGIC_NUMBER_NANOSECONDS)
+        {
+            pSegment->bNanosecondTimestamps = true;
+        }
+        else if (pSegment->fileHeader.magic_number == PCAP_MAGIC_NUMBER_MICROSECONDS)
+        {
+            pSegment->bNanosecondTimestamps = false;
+        }
+        else
+        {
+            retval = XLNX_CAPTURE_STORE_ERROR_INVALID_SEGMENT;
+        }
+    }
+
+    if (retval == XLNX_OK)
+    {
+        if (pread(fd, &recordHeader, sizeof(recordHeader), sizeof(pcap_hdr_t)) == (ssize_t)sizeof(recordHeader))
+        {
+            pSegment->info.firstTimestamp = GetRecordTimestamp(&recordHeader, pSegment->bNanosecondTimestamps);
+            pSegment->info.bHasPackets = true;
+        }
+    }
+
+    if (fd >= 0)
+    {
+        close(fd);
+    }
+
+    if (retval == XLNX_OK)
+    {
+        retval = LoadIndex(path + PCAP_INDEX_FILE_SUFFIX, pSegment);
+    }
+
+    return retval;
+}
+
+
+
+
+uint32_t CaptureStore::LoadIndex(const std::string& path, Segment* pSegment)
+{
+    uint32_t retval = XLNX_OK;
+    FILE* pIndexFile;
+    pcap_index_hdr_t indexHeader;
+    pcap_index_entry_t indexEntry;
+
+    //a missing or unreadable index is not an error, the segment is just searched from the start
+    pIndexFile = fopen(path.c_str(), "rb");
+
+    if (pIndexFile != nullptr)
+    {
+        if ((fread(&indexHeader, sizeof(indexHeader), 1, pIndexFile) == 1) &&
+            (indexHeader.magic_number == PCAP_INDEX_MAGIC_NUMBER) &&
+            (indexHeader.version_major == PCAP_INDEX_VERSION_MAJOR))
+        {
+            //entries past the end of the segment belong to data that had not been written when it was closed
+            while ((fread(&indexEntry, sizeof(indexEntry), 1, pIndexFile) == 1) && (indexEntry.offset < pSegment->info.fileSize))
+            {
+                pSegment->index.push_back(indexEntry);
+            }
+        }
+
+        fclose(pIndexFile);
+    }
+
+    pSegment->info.numIndexEntries = (uint32_t)pSegment->index.size();
+
+    return retval;
+}
+
+
+
+
+uint64_t CaptureStore::FindStartOffset(Segment* pSegment, uint64_t startTimestamp)
+{
+    uint64_t offset = sizeof(pcap_hdr_t);
+    std::vector<pcap_index_entry_t>::iterator it;
+
+    //first entry at or after the start of the window...
+    it = std::lower_bound(pSegment->index.begin(), pSegment->index.end(), startTimestamp,
+                          [](const pcap_index_entry_t& entry, uint64_t timestamp) { return entry.timestamp < timestamp; });
+
+    //...packets between the previous entry and that one may still be in the window, so start from the previous entry
+    if (it != pSegment->index.begin())
+    {
+        --it;
+        offset = it->offset;
+    }
+
+    return offset;
+}
+
+
+
+
+uint32_t CaptureStore::ExtractFromSegment(Segment* pSegment, uint64_t startTimestamp, uint64_t endTimestamp, FlowFilter* pFilter, FILE* pOutputFile, bool* pbPastEnd, ExtractStats* pStats)
+{
+    uint32_t retval = XLNX_OK;
+    int fd;
+    void* pMapping = MAP_FAILED;
+    size_t fileSize = (size_t)pSegment->info.fileSize;
+    const uint8_t* pFileData;
+    uint64_t offset;
+    pcaprec_hdr_t recordHeader;
+    uint64_t timestamp;
+    size_t recordLength;
+
+    fd = open(pSegment->info.path.c_str(), O_RDONLY);
+
+    if (fd < 0)
+    {
+        retval = XLNX_CAPTURE_STORE_ERROR_FAILED_TO_OPEN_SEGMENT;
+    }
+
+    if (retval == XLNX_OK)
+    {
+        pMapping = mmap(nullptr, fileSize, PROT_READ, MAP_PRIVATE, fd, 0);
+
+        if (pMapping == MAP_FAILED)
+        {
+            retval = XLNX_CAPTURE_STORE_ERROR_FAILED_TO_MAP_SEGMENT;
+        }
+    }
+
+    if (fd >= 0)
+    {
+        close(fd);
+    }
+
+
+    if (retval == XLNX_OK)
+    {
+        madvise(pMapping, fileSize, MADV_SEQUENTIAL);
+
+        pFileData = (const uint8_t*)pMapping;
+
+        pStats->numSegmentsSearched++;
+
+        offset = FindStartOffset(pSegment, startTimestamp);
+
+        while ((offset + sizeof(recordHeader)) <= fileSize)
+        {
+            memcpy(&recordHeader, pFileData + offset, sizeof(recordHeader));
+
+            recordLength = sizeof(recordHeader) + recordHeader.incl_len;
+
+            if ((offset + recordLength) > fileSize)
+            {
+                break; //out of loop - record is still being written
+            }
+
+            pStats->numRecordsScanned++;
+
+            timestamp = GetRecordTimestamp(&recordHeader, pSegment->bNanosecondTimestamps);
+
+            if (timestamp > endTimestamp)
+            {
+                *pbPastEnd = true;
+                break; //out of loop
+            }
+
+            if (timestamp >= startTimestamp)
+            {
+                if ((pFilter == nullptr) || MatchFlow(pFileData + offset + sizeof(recordHeader), recordHeader.incl_len, pSegment->fileHeader.network, pFilter))
+                {
+                    //records are copied unchanged
+                    if (fwrite(pFileData + offset, recordLength, 1, pOutputFile) != 1)
+                    {
+                        retval = XLNX_CAPTURE_STORE_ERROR_OUTPUT_FILE_WRITE_FAILED;
+                        break; //out of loop
+                    }
+
+                    pStats->numRecordsExtracted++;
+                    pStats->numBytesExtracted += recordLength;
+                }
+            }
+
+            offset += recordLength;
+        }
+
+        munmap(pMapping, fileSize);
+    }
+
+    return retval;
+}
+
+
+
+
+bool CaptureStore::MatchFlow(const uint8_t* pFrame, uint32_t frameLength, uint32_t linkType, FlowFilter* pFilter)
+{
+    bool bMatch = true;
+    uint32_t offset = 0;
+    uint16_t etherType = ETHERTYPE_IPV4;
+    bool bHasVLAN = false;
+    uint16_t vlanID = 0;
+    bool bHasIPv4 = false;
+    uint32_t headerLength;
+    uint8_t ipProtocol = 0;
+    uint32_t srcAddress = 0;
+    uint32_t dstAddress = 0;
+    bool bHasPorts = false;
+    uint16_t srcPort = 0;
+    uint16_t dstPort = 0;
+
+
+    if (linkType == LINKTYPE_ETHERNET)
+    {
+        if (frameLength >= ETHERNET_HEADER_LENGTH)
+        {
+            etherType = ReadBigEndian16(pFrame + 12);
+            offset = ETHERNET_HEADER_LENGTH;
+
+            while (((etherType == ETHERTYPE_VLAN) || (etherType == ETHERTYPE_QINQ)) && ((offset + 4) <= frameLength))
+            {
+                if (bHasVLAN == false)
+                {
+                    vlanID = ReadBigEndian16(pFrame + offset) & 0x0FFF; //outer tag
+                    bHasVLAN = true;
+                }
+
+                etherType = ReadBigEndian16(pFrame + offset + 2);
+                offset += 4;
+            }
+        }
+        else
+        {
+            etherType = 0;
+        }
+    }
+
+
+    if ((etherType == ETHERTYPE_IPV4) && ((offset + IPV4_HEADER_MIN_LENGTH) <= frameLength) && ((pFrame[offset] >> 4) == 4))
+    {
+        bHasIPv4 = true;
+
+        headerLength = (pFrame[offset] & 0x0F) * 4;
+        ipProtocol = pFrame[offset + 9];
+        srcAddress = ReadBigEndian32(pFrame + offset + 12);
+        dstAddress = ReadBigEndian32(pFrame + offset + 16);
+
+        //ports are only present in the first fragment
+        if (((ipProtocol == IP_PROTOCOL_TCP) || (ipProtocol == IP_PROTOCOL_UDP)) &&
+            ((ReadBigEndian16(pFrame + offset + 6) & 0x1FFF) == 0) &&
+            ((offset + headerLength + 4) <= frameLength))
+        {
+            bHasPorts = true;
+            srcPort = ReadBigEndian16(pFrame + offset + headerLength);
+            dstPort = ReadBigEndian16(pFrame + offset + headerLength + 2);
+        }
+    }
+
+
+    if (pFilter->matchFlags & FLOW_MATCH_VLAN)
+    {
+        bMatch = bMatch && bHasVLAN && (vlanID == pFilter->vlanID);
+    }
+
+    if (pFilter->matchFlags & (FLOW_MATCH_SRC_ADDRESS | FLOW_MATCH_DST_ADDRESS | FLOW_MATCH_ADDRESS | FLOW_MATCH_IP_PROTOCOL))
+    {
+        bMatch = bMatch && bHasIPv4;
+    }
+
+    if (pFilter->matchFlags & FLOW_MATCH_SRC_ADDRESS)
+    {
+        bMatch = bMatch && ((srcAddress & pFilter->srcMask) == (pFilter->srcAddress & pFilter->srcMask));
+    }
+
+    if (pFilter->matchFlags & FLOW_MATCH_DST_ADDRESS)
+    {
+        bMatch = bMatch && ((dstAddress & pFilter->dstMask) == (pFilter->dstAddress & pFilter->dstMask));
+    }
+
+    if (pFilter->matchFlags & FLOW_MATCH_ADDRESS)
+    {
+        bMatch = bMatch && (((srcAddress & pFilter->addressMask) == (pFilter->address & pFilter->addressMask)) ||
+                            ((dstAddress & pFilter->addressMask) == (pFilter->address & pFilter->addressMask)));
+    }
+
+    if (pFilter->matchFlags & FLOW_MATCH_IP_PROTOCOL)
+    {
+        bMatch = bMatch && (ipProtocol == pFilter->ipProtocol);
+    }
+
+    if (pFilter->matchFlags & (FLOW_MATCH_SRC_PORT | FLOW_MATCH_DST_PORT | FLOW_MATCH_PORT))
+    {
+        bMatch = bMatch && bHasPorts;
+    }
+
+    if (pFilter->matchFlags & FLOW_MATCH_SRC_PORT)
+    {
+        bMatch = bMatch && (srcPort == pFilter->srcPort);
+    }
+
+    if (pFilter->matchFlags & FLOW_MATCH_DST_PORT)
+    {
+        bMatch = bMatch && (dstPort == pFilter->dstPort);
+    }
+
+    if (pFilter->matchFlags & FLOW_MATCH_PORT)
+    {
+        bMatch = bMatch && ((srcPort == pFilter->port) || (dstPort == pFilter->port));
+    }
+
+    return bMatch;
+}
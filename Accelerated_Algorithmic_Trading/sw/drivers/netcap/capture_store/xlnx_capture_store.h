@@ -0,0 +1,146 @@
+/*
+ * Copyright 2021 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef XLNX_CAPTURE_STORE_H
+#define XLNX_CAPTURE_STORE_H
+
+
+#include <cstdio>
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "xlnx_network_capture_pcap_headers.h"
+
+#include "xlnx_capture_store_error_codes.h"
+
+
+
+
+namespace XLNX
+{
+
+
+//Read side of the capture files written by PCAPWriter. Opens either a single PCAP file or a set of
+//rotating segments, and uses the sidecar time index of each segment to seek straight to the packets
+//in a time window rather than scanning the capture from the start.
+//
+//Packet timestamps are expected to increase through the capture, as they do for captures taken from
+//the HW timestamp counter. Segments without an index are still searched, from their first packet.
+class CaptureStore
+{
+
+
+public:
+    CaptureStore();
+    virtual ~CaptureStore();
+
+
+
+public:
+    //capturePath is the path that was given to PCAPWriter::Start(), i.e. <name>.pcap for a set of
+    //<name>_NNNNNN.pcap segments, or the file itself when the capture was not segmented
+    uint32_t Open(const char* capturePath);
+    uint32_t Close(void);
+
+
+
+public:
+    typedef struct
+    {
+        std::string path;
+        uint64_t fileSize;
+        uint64_t firstTimestamp;        //nanoseconds, only valid if bHasPackets is set
+        uint32_t numIndexEntries;
+        bool bHasPackets;
+    }SegmentInfo;
+
+    uint32_t GetNumSegments(uint32_t* pNumSegments);
+    uint32_t GetSegmentInfo(uint32_t segmentIndex, SegmentInfo* pInfo);
+
+
+
+public: //Extraction
+
+    static const uint32_t FLOW_MATCH_VLAN           = (1 << 0);
+    static const uint32_t FLOW_MATCH_SRC_ADDRESS    = (1 << 1);
+    static const uint32_t FLOW_MATCH_DST_ADDRESS    = (1 << 2);
+    static const uint32_t FLOW_MATCH_ADDRESS        = (1 << 3);   //source or destination
+    static const uint32_t FLOW_MATCH_IP_PROTOCOL    = (1 << 4);
+    static const uint32_t FLOW_MATCH_SRC_PORT       = (1 << 5);
+    static const uint32_t FLOW_MATCH_DST_PORT       = (1 << 6);
+    static const uint32_t FLOW_MATCH_PORT           = (1 << 7);   //source or destination
+
+    typedef struct
+    {
+        uint32_t matchFlags;            //FLOW_MATCH_xxx bits, fields whose flag is clear are ignored
+        uint16_t vlanID;
+        uint32_t srcAddress;
+        uint32_t srcMask;
+        uint32_t dstAddress;
+        uint32_t dstMask;
+        uint32_t address;
+        uint32_t addressMask;
+        uint8_t ipProtocol;
+        uint16_t srcPort;
+        uint16_t dstPort;
+        uint16_t port;
+    }FlowFilter;
+
+    typedef struct
+    {
+        uint64_t numSegmentsSearched;
+        uint64_t numRecordsScanned;
+        uint64_t numRecordsExtracted;
+        uint64_t numBytesExtracted;
+    }ExtractStats;
+
+    //Writes every packet with startTimestamp <= timestamp <= endTimestamp (nanoseconds) to a new PCAP
+    //file at outputPath. If pFilter is not null, only packets of the matching flow are written.
+    uint32_t Extract(uint64_t startTimestamp, uint64_t endTimestamp, FlowFilter* pFilter, const char* outputPath, ExtractStats* pStats);
+
+
+
+protected:
+    typedef struct
+    {
+        SegmentInfo info;
+        bool bNanosecondTimestamps;
+        pcap_hdr_t fileHeader;
+        std::vector<pcap_index_entry_t> index;
+    }Segment;
+
+    uint32_t CheckIsOpen(void);
+    uint32_t FindSegmentPaths(const char* capturePath, std::vector<std::string>* pPaths);
+    uint32_t LoadSegment(const std::string& path, Segment* pSegment);
+    uint32_t LoadIndex(const std::string& path, Segment* pSegment);
+    uint64_t FindStartOffset(Segment* pSegment, uint64_t startTimestamp);
+    uint32_t ExtractFromSegment(Segment* pSegment, uint64_t startTimestamp, uint64_t endTimestamp, FlowFilter* pFilter, FILE* pOutputFile, bool* pbPastEnd, ExtractStats* pStats);
+    bool MatchFlow(const uint8_t* pFrame, uint32_t frameLength, uint32_t linkType, FlowFilter* pFilter);
+
+protected:
+    std::vector<Segment> m_segments;
+    bool m_bIsOpen;
+};
+
+
+
+} //namespace XLNX
+
+
+
+#endif
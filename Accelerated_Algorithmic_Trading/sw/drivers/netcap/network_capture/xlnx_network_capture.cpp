@@ -35,6 +35,7 @@ NetworkCapture::NetworkCapture()
     m_pDeviceInterface              = nullptr;
     m_cuAddress                     = 0;
     m_cuIndex                       = 0;
+    m_capabilities                  = 0;
     m_initialisedMagicNumber        = 0;
 
 
@@ -45,12 +46,14 @@ NetworkCapture::NetworkCapture()
     m_pBufferDescriptor             = nullptr;
     m_bufferHostVirtualAddress      = nullptr;
     m_bufferHWAddress               = INVALID_HW_BUFFER_ADDRESS;
+    m_bufferSize                    = DEFAULT_RING_SIZE_MEGABYTES * BYTES_PER_MEGABYTE;
 
     m_clockFrequencyMHz             = 0;
 
     m_bKeepRunning                  = false;
     m_bYield                        = false;
     m_numCapturedPackets            = 0;
+    m_numDiscardedRecords           = 0;
     m_pollRateMilliseconds          = 0; 
 
     m_hwEmulationPollDelaySeconds   = HW_EMU_POLL_DELAY_DEFAULT_SECONDS;
@@ -141,6 +144,22 @@ uint32_t NetworkCapture::Initialise(DeviceInterface* pDeviceInterface, const cha
 
 
 
+    if (retval == XLNX_OK)
+    {
+        //The ring format (and any registers that go with it) depend on the kernel in the loaded bitstream...
+        retval = ReadReg32(XLNX_NETWORK_CAPTURE_CAPABILITIES_OFFSET, &m_capabilities);
+
+        if (retval == XLNX_OK)
+        {
+            if ((m_capabilities & CAPABILITY_PACKED_RECORDS) == 0)
+            {
+                m_bufferSize = LEGACY_BUFFER_SIZE;
+            }
+        }
+    }
+
+
+
     if (retval == XLNX_OK)
     {
         m_initialisedMagicNumber = XLNX_NETWORK_CAPTURE_INITIALISED_MAGIC_NUMBER;
@@ -502,7 +521,7 @@ uint32_t NetworkCapture::SetupBufferObjectsFromHostBank(void)
 
     //The HW kernel is connected to HOST-BANK.  This means we only have to allocate a buffer on the host...
 
-    m_pBufferDescriptor = m_pDeviceInterface->AllocateBufferHostOnly(BUFFER_SIZE, m_bufferMemTopologyIndex);
+    m_pBufferDescriptor = m_pDeviceInterface->AllocateBufferHostOnly(m_bufferSize, m_bufferMemTopologyIndex);
 
     if (m_pBufferDescriptor == nullptr)
     {
@@ -539,7 +558,7 @@ uint32_t NetworkCapture::SetupBufferObjectsFromCardRAM(void)
 
 	// The HW kernel is connected to CARD RAM.  This means we need to allocate a BUFFER PAIR (i.e. HOST + CARD)
 
-	m_pBufferDescriptor = m_pDeviceInterface->AllocateBufferPair(BUFFER_SIZE, m_bufferMemTopologyIndex);
+	m_pBufferDescriptor = m_pDeviceInterface->AllocateBufferPair(m_bufferSize, m_bufferMemTopologyIndex);
 	if (m_pBufferDescriptor == nullptr)
 	{
 		retval = XLNX_NETWORK_CAPTURE_ERROR_FAILED_TO_ALLOCATE_BUFFER_OBJECT;
@@ -623,6 +642,13 @@ uint32_t NetworkCapture::SetHWBufferAddress(uint64_t address)
 		retval = WriteReg32(XLNX_NETWORK_CAPTURE_BUFFER_ADDRESS_UPPER_WORD_OFFSET, upperWord);
 	}
 
+
+	//The HW wraps back to the start of the ring when it reaches this size
+	if ((retval == XLNX_OK) && (m_capabilities & CAPABILITY_PACKED_RECORDS))
+	{
+		retval = WriteReg32(XLNX_NETWORK_CAPTURE_BUFFER_SIZE_OFFSET, m_bufferSize / XLNX_NETWORK_CAPTURE_RECORD_ALIGNMENT);
+	}
+
 	return retval;
 }
 
@@ -725,6 +751,82 @@ uint64_t NetworkCapture::GetBufferHWAddress(void)
 
 
 
+uint32_t NetworkCapture::SetRingSize(uint32_t megabytes)
+{
+    uint32_t retval = XLNX_OK;
+
+    retval = CheckIsInitialised();
+
+
+    if (retval == XLNX_OK)
+    {
+        if ((m_capabilities & CAPABILITY_PACKED_RECORDS) == 0)
+        {
+            retval = XLNX_NETWORK_CAPTURE_ERROR_NOT_SUPPORTED_BY_HW;
+        }
+    }
+
+
+    if (retval == XLNX_OK)
+    {
+        if ((megabytes == 0) || (megabytes > MAX_RING_SIZE_MEGABYTES))
+        {
+            retval = XLNX_NETWORK_CAPTURE_ERROR_INVALID_PARAMETER;
+        }
+    }
+
+
+    if (retval == XLNX_OK)
+    {
+        //NOTE - the HW keeps writing to the ring after capture has been stopped,
+        //       so we can't safely free and reallocate it once it has been setup.
+        if (m_bNeedToSetupBuffer == false)
+        {
+            retval = XLNX_NETWORK_CAPTURE_ERROR_BUFFER_ALREADY_ALLOCATED;
+        }
+    }
+
+
+    if (retval == XLNX_OK)
+    {
+        m_bufferSize = megabytes * BYTES_PER_MEGABYTE;
+    }
+
+    return retval;
+}
+
+
+
+
+uint32_t NetworkCapture::GetRingSize(uint32_t* pMegabytes)
+{
+    uint32_t retval = XLNX_OK;
+
+    *pMegabytes = m_bufferSize / BYTES_PER_MEGABYTE;
+
+    return retval;
+}
+
+
+
+
+uint32_t NetworkCapture::GetCapabilities(uint32_t* pCapabilities)
+{
+    uint32_t retval = XLNX_OK;
+
+    retval = CheckIsInitialised();
+
+    if (retval == XLNX_OK)
+    {
+        *pCapabilities = m_capabilities;
+    }
+
+    return retval;
+}
+
+
+
+
 uint32_t NetworkCapture::GetTailPointer(uint32_t* pTailPointer)
 {
     uint32_t retval = XLNX_OK;
@@ -846,6 +948,19 @@ uint32_t NetworkCapture::GetNumCapturedPackets(uint32_t* pNumPackets)
 
 
 
+uint32_t NetworkCapture::GetNumDiscardedRecords(uint32_t* pNumRecords)
+{
+    uint32_t retval = XLNX_OK;
+
+    retval = CheckIsInitialised();
+
+    *pNumRecords = m_numDiscardedRecords;
+
+    return retval;
+}
+
+
+
 void NetworkCapture::SetHWEmulationPollDelay(uint32_t delaySeconds)
 {
     m_hwEmulationPollDelaySeconds = delaySeconds;
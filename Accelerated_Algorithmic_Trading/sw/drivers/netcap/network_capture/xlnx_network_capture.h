@@ -64,6 +64,27 @@ public:
     uint32_t Stop(void);
     uint32_t IsRunning(bool* pbIsRunning);
     uint32_t GetNumCapturedPackets(uint32_t* pNumPackets);
+    uint32_t GetNumDiscardedRecords(uint32_t* pNumRecords);
+
+
+public: //HW Capabilities
+
+    //Read from the kernel when the driver is initialised.  A kernel that reads back no capabilities is driven
+    //in legacy mode...a fixed size ring of 2KB chunks, one packet per chunk.
+    static const uint32_t CAPABILITY_PACKED_RECORDS     = (1 << 0);     //packed variable-length record ring, BUFFER_SIZE register
+    static const uint32_t CAPABILITY_FILTER             = (1 << 1);     //capture filter and snap length, see below
+
+    uint32_t GetCapabilities(uint32_t* pCapabilities);
+
+
+public: //Capture Ring
+
+    //The capture ring is allocated the first time capture is started, so its size
+    //can only be changed before then.  A legacy kernel has a fixed ring size that cannot be changed.
+    static const uint32_t DEFAULT_RING_SIZE_MEGABYTES = 16;
+    static const uint32_t MAX_RING_SIZE_MEGABYTES = 1024;
+    uint32_t SetRingSize(uint32_t megabytes);
+    uint32_t GetRingSize(uint32_t* pMegabytes);
    
 
 public: //Thread Control
@@ -84,6 +105,81 @@ public: //Thread Control
     void GetHWEmulationPollDelay(uint32_t* pDelaySeconds);
 
 
+public: //Capture Filter
+
+    //When the filter is enabled, each packet is compared against the rule table in index order and the first
+    //matching rule decides whether it is captured, and how many bytes of it.  Packets that match no rule take
+    //the default action.  A snap length of 0 captures the whole packet.
+    //
+    //For 802.1Q tagged frames, the VLAN ID is taken from the tag and the ether type is the one that follows it.
+    //IP address matches are made under the supplied mask.  FILTER_MATCH_PORT matches either the source or
+    //destination port, which makes it convenient for capturing both directions of a session.
+    //
+    //The filter is only present when the kernel reports CAPABILITY_FILTER, otherwise these functions
+    //return XLNX_NETWORK_CAPTURE_ERROR_NOT_SUPPORTED_BY_HW and the kernel captures every packet in full.
+    static const uint32_t NUM_FILTER_RULES_SUPPORTED    = 16;
+
+    static const uint32_t FILTER_MATCH_ETHERTYPE        = (1 << 0);
+    static const uint32_t FILTER_MATCH_VLAN             = (1 << 1);
+    static const uint32_t FILTER_MATCH_SRC_ADDRESS      = (1 << 2);
+    static const uint32_t FILTER_MATCH_DST_ADDRESS      = (1 << 3);
+    static const uint32_t FILTER_MATCH_IP_PROTOCOL      = (1 << 4);
+    static const uint32_t FILTER_MATCH_SRC_PORT         = (1 << 5);
+    static const uint32_t FILTER_MATCH_DST_PORT         = (1 << 6);
+    static const uint32_t FILTER_MATCH_PORT             = (1 << 7);
+
+    typedef struct
+    {
+        uint32_t matchFlags;        //FILTER_MATCH_xxx bits, fields whose flag is clear are ignored
+        bool bCapture;              //action on match - capture or drop
+        uint16_t snapLength;
+        uint16_t etherType;
+        uint16_t vlanID;
+        uint32_t srcAddress;
+        uint32_t srcMask;
+        uint32_t dstAddress;
+        uint32_t dstMask;
+        uint8_t ipProtocol;
+        uint16_t srcPort;
+        uint16_t dstPort;
+        uint16_t port;
+    }FilterRule;
+
+    uint32_t SetFilterEnabled(bool bEnabled);
+    uint32_t GetFilterEnabled(bool* pbEnabled);
+    uint32_t SetFilterDefault(bool bCapture, uint16_t snapLength);
+    uint32_t GetFilterDefault(bool* pbCapture, uint16_t* pSnapLength);
+
+    uint32_t SetFilterRule(uint32_t index, FilterRule* pRule);
+    uint32_t GetFilterRule(uint32_t index, FilterRule* pRule, bool* pbValid);
+    uint32_t DeleteFilterRule(uint32_t index);
+    uint32_t DeleteAllFilterRules(void);
+
+    uint32_t GetFilterStats(uint32_t* pNumMatched, uint32_t* pNumDropped);
+
+
+public: //File Writer
+
+    //The following control how captured packets are buffered on their way to the PCAP file,
+    //see PCAPWriter. They take effect the next time capture is started.
+    uint32_t SetFileBufferSize(uint32_t numBytes);
+    uint32_t GetFileBufferSize(uint32_t* pNumBytes);
+    uint32_t SetFileDirectIO(bool bEnabled);
+    uint32_t GetFileDirectIO(bool* pbEnabled);
+    uint32_t SetFileFlushTimeout(uint32_t milliseconds);
+    uint32_t GetFileFlushTimeout(uint32_t* pMilliseconds);
+
+    //Rotating segment files and the sidecar time index, see PCAPWriter
+    uint32_t SetFileSegmentSize(uint32_t megabytes);
+    uint32_t GetFileSegmentSize(uint32_t* pMegabytes);
+    uint32_t SetFileSegmentDuration(uint32_t seconds);
+    uint32_t GetFileSegmentDuration(uint32_t* pSeconds);
+    uint32_t SetFileIndexInterval(uint32_t numPackets);
+    uint32_t GetFileIndexInterval(uint32_t* pNumPackets);
+
+    uint32_t GetFileWriterStats(PCAPWriter::Stats* pStats);
+
+
 public:
     void IsInitialised(bool* pbIsInitialised);
 
@@ -95,6 +191,7 @@ public:
 
 protected:
     uint32_t CheckIsInitialised(void);
+    uint32_t CheckFilterIsSupported(void);
     uint32_t CheckIsRunning(void);
     uint32_t CheckIsNotRunning(void);
 
@@ -128,8 +225,10 @@ protected: //Thread
     uint32_t StopThread(void);
     uint32_t IsThreadRunning(bool* pbIsRunning);
     void ThreadFunc(void);
-    uint32_t GetTailChunkIndex(uint32_t* pChunkIndex);
-    uint32_t WritePacketsToPCAPFile(uint32_t chunkStartIndex, uint32_t numChunks);
+    uint32_t GetTailByteOffset(uint32_t* pByteOffset);
+    uint32_t TransferRecords(uint32_t startByteOffset, uint32_t numBytes);
+    uint32_t WritePacketsToPCAPFile(uint32_t startByteOffset, uint32_t numBytes);
+    uint32_t WriteLegacyChunksToPCAPFile(uint32_t startByteOffset, uint32_t numBytes);
 
 
 
@@ -152,12 +251,11 @@ protected:
 protected:
     static const uint32_t KERNEL_MEMORY_ARGUMENT_BUFFER_INDEX = 2;
 
-    static const uint32_t CHUNK_SIZE = 0x800;   //A chunk contains packet data + metadata
-
-    static const uint32_t NUM_CHUNKS = 64;      // This needs to match the ring size defined in HW
-                                                //TODO probably needs to be larger...
+    static const uint32_t BYTES_PER_MEGABYTE = 1024 * 1024;
 
-    static const uint32_t BUFFER_SIZE = CHUNK_SIZE * NUM_CHUNKS;
+    static const uint32_t LEGACY_CHUNK_SIZE = 0x800;    //A chunk contains packet data + metadata
+    static const uint32_t LEGACY_NUM_CHUNKS = 64;       //This needs to match the ring size defined in HW
+    static const uint32_t LEGACY_BUFFER_SIZE = LEGACY_CHUNK_SIZE * LEGACY_NUM_CHUNKS;
 
 
     //The current HW timestamp counter increments every 4 clock cycles
@@ -185,6 +283,7 @@ protected:
     uint32_t m_initialisedMagicNumber;
     uint64_t m_cuAddress;
     uint32_t m_cuIndex;
+    uint32_t m_capabilities;
     DeviceInterface* m_pDeviceInterface;
 
 
@@ -197,6 +296,7 @@ protected:
     BufferDescriptor* m_pBufferDescriptor;
     void* m_bufferHostVirtualAddress;
     uint64_t m_bufferHWAddress;
+    uint32_t m_bufferSize;
 
 
 protected:
@@ -209,6 +309,7 @@ protected:
     bool m_bKeepRunning;
     bool m_bYield;
     uint32_t m_numCapturedPackets;
+    uint32_t m_numDiscardedRecords;
     uint32_t m_pollRateMilliseconds;
 
     uint32_t m_hwEmulationPollDelaySeconds;
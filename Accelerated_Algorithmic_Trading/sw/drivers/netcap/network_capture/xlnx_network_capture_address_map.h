@@ -36,6 +36,32 @@
 #define XLNX_NETWORK_CAPTURE_BUFFER_ADDRESS_LOWER_WORD_OFFSET                   (0x000000B0)
 #define XLNX_NETWORK_CAPTURE_BUFFER_ADDRESS_UPPER_WORD_OFFSET                   (0x000000B4)
 
+#define XLNX_NETWORK_CAPTURE_BUFFER_SIZE_OFFSET                                 (0x000000C0) //in 64-byte units
+
+
+//Features implemented by the kernel, see NetworkCapture::CAPABILITY_xxx.  Kernels that predate this
+//register read back 0 here, and have neither the packed record ring nor any of the registers that go with it.
+#define XLNX_NETWORK_CAPTURE_CAPABILITIES_OFFSET                                (0x000000D0)
+
+
+//Capture filter, only present with NetworkCapture::CAPABILITY_FILTER - [0] enable, [1] capture unmatched packets, [31:16] snap length for unmatched packets
+#define XLNX_NETWORK_CAPTURE_FILTER_CONTROL_OFFSET                              (0x000000C4)
+#define XLNX_NETWORK_CAPTURE_FILTER_STATS_MATCHED_OFFSET                        (0x000000C8)
+#define XLNX_NETWORK_CAPTURE_FILTER_STATS_DROPPED_OFFSET                        (0x000000CC)
+
+//Capture filter rule table, 8 words per rule:
+//  +0x00   [0] valid, [1] capture (else drop), [15:8] match flags, [31:16] snap length
+//  +0x04   [15:0] ether type, [27:16] VLAN ID
+//  +0x08   source address
+//  +0x0C   source address mask
+//  +0x10   destination address
+//  +0x14   destination address mask
+//  +0x18   [15:0] source port, [31:16] destination port
+//  +0x1C   [7:0] IP protocol, [31:16] port (either direction)
+#define XLNX_NETWORK_CAPTURE_FILTER_RULE_TABLE_OFFSET                           (0x00001000)
+#define XLNX_NETWORK_CAPTURE_FILTER_RULE_ENTRY_SIZE                             (0x00000020)
+#define XLNX_NETWORK_CAPTURE_FILTER_RULE_NUM_WORDS                              (8)
+
 
 
 
@@ -37,6 +37,10 @@
 #define XLNX_NETWORK_CAPTURE_ERROR_PCAP_FILE_NOT_OPEN                       (0x0000000A)
 #define XLNX_NETWORK_CAPTURE_ERROR_ALREADY_RUNNING                          (0x0000000B)
 #define XLNX_NETWORK_CAPTURE_ERROR_NOT_RUNNING                              (0x0000000C)
+#define XLNX_NETWORK_CAPTURE_ERROR_FAILED_TO_ALLOCATE_WRITE_BUFFER          (0x0000000D)
+#define XLNX_NETWORK_CAPTURE_ERROR_PCAP_FILE_WRITE_FAILED                   (0x0000000E)
+#define XLNX_NETWORK_CAPTURE_ERROR_BUFFER_ALREADY_ALLOCATED                 (0x0000000F)
+#define XLNX_NETWORK_CAPTURE_ERROR_NOT_SUPPORTED_BY_HW                      (0x00000010)
 
 
 
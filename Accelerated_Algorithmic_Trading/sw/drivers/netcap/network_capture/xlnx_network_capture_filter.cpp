@@ -0,0 +1,312 @@
+/*
+ * Copyright 2021 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "xlnx_network_capture.h"
+#include "xlnx_network_capture_address_map.h"
+#include "xlnx_network_capture_internal.h"
+using namespace XLNX;
+
+
+
+
+uint32_t NetworkCapture::SetFilterEnabled(bool bEnabled)
+{
+    uint32_t retval = XLNX_OK;
+    uint32_t value = 0;
+    uint32_t mask;
+
+    retval = CheckFilterIsSupported();
+
+    if (retval == XLNX_OK)
+    {
+        if (bEnabled)
+        {
+            value = XLNX_NETWORK_CAPTURE_FILTER_CONTROL_ENABLE;
+        }
+
+        mask = XLNX_NETWORK_CAPTURE_FILTER_CONTROL_ENABLE;
+
+        retval = WriteRegWithMask32(XLNX_NETWORK_CAPTURE_FILTER_CONTROL_OFFSET, value, mask);
+    }
+
+    return retval;
+}
+
+
+
+
+uint32_t NetworkCapture::GetFilterEnabled(bool* pbEnabled)
+{
+    uint32_t retval = XLNX_OK;
+    uint32_t value;
+
+    retval = CheckFilterIsSupported();
+
+    if (retval == XLNX_OK)
+    {
+        retval = ReadReg32(XLNX_NETWORK_CAPTURE_FILTER_CONTROL_OFFSET, &value);
+    }
+
+    if (retval == XLNX_OK)
+    {
+        *pbEnabled = ((value & XLNX_NETWORK_CAPTURE_FILTER_CONTROL_ENABLE) != 0);
+    }
+
+    return retval;
+}
+
+
+
+
+uint32_t NetworkCapture::SetFilterDefault(bool bCapture, uint16_t snapLength)
+{
+    uint32_t retval = XLNX_OK;
+    uint32_t value;
+    uint32_t mask;
+
+    retval = CheckFilterIsSupported();
+
+    if (retval == XLNX_OK)
+    {
+        value = ((uint32_t)snapLength) << XLNX_NETWORK_CAPTURE_FILTER_CONTROL_SNAP_LENGTH_LSB;
+
+        if (bCapture)
+        {
+            value |= XLNX_NETWORK_CAPTURE_FILTER_CONTROL_CAPTURE_UNMATCHED;
+        }
+
+        //leave the enable bit untouched
+        mask = ~((uint32_t)XLNX_NETWORK_CAPTURE_FILTER_CONTROL_ENABLE);
+
+        retval = WriteRegWithMask32(XLNX_NETWORK_CAPTURE_FILTER_CONTROL_OFFSET, value, mask);
+    }
+
+    return retval;
+}
+
+
+
+
+uint32_t NetworkCapture::GetFilterDefault(bool* pbCapture, uint16_t* pSnapLength)
+{
+    uint32_t retval = XLNX_OK;
+    uint32_t value;
+
+    retval = CheckFilterIsSupported();
+
+    if (retval == XLNX_OK)
+    {
+        retval = ReadReg32(XLNX_NETWORK_CAPTURE_FILTER_CONTROL_OFFSET, &value);
+    }
+
+    if (retval == XLNX_OK)
+    {
+        *pbCapture = ((value & XLNX_NETWORK_CAPTURE_FILTER_CONTROL_CAPTURE_UNMATCHED) != 0);
+        *pSnapLength = (uint16_t)(value >> XLNX_NETWORK_CAPTURE_FILTER_CONTROL_SNAP_LENGTH_LSB);
+    }
+
+    return retval;
+}
+
+
+
+
+
+
+
+uint32_t NetworkCapture::SetFilterRule(uint32_t index, FilterRule* pRule)
+{
+    uint32_t retval = XLNX_OK;
+    uint32_t words[XLNX_NETWORK_CAPTURE_FILTER_RULE_NUM_WORDS];
+    uint64_t entryOffset;
+
+    retval = CheckFilterIsSupported();
+
+    if (retval == XLNX_OK)
+    {
+        if ((index >= NUM_FILTER_RULES_SUPPORTED) ||
+            ((pRule->matchFlags & ~((uint32_t)XLNX_NETWORK_CAPTURE_FILTER_RULE_MATCH_FLAGS_MASK)) != 0) ||
+            (pRule->vlanID > XLNX_NETWORK_CAPTURE_FILTER_RULE_VLAN_ID_MASK))
+        {
+            retval = XLNX_NETWORK_CAPTURE_ERROR_INVALID_PARAMETER;
+        }
+    }
+
+
+    if (retval == XLNX_OK)
+    {
+        words[0] = XLNX_NETWORK_CAPTURE_FILTER_RULE_VALID                                           |
+                   (pRule->matchFlags << XLNX_NETWORK_CAPTURE_FILTER_RULE_MATCH_FLAGS_LSB)          |
+                   (((uint32_t)pRule->snapLength) << XLNX_NETWORK_CAPTURE_FILTER_RULE_SNAP_LENGTH_LSB);
+
+        if (pRule->bCapture)
+        {
+            words[0] |= XLNX_NETWORK_CAPTURE_FILTER_RULE_CAPTURE;
+        }
+
+        words[1] = ((uint32_t)pRule->vlanID << 16) | pRule->etherType;
+        words[2] = pRule->srcAddress;
+        words[3] = pRule->srcMask;
+        words[4] = pRule->dstAddress;
+        words[5] = pRule->dstMask;
+        words[6] = ((uint32_t)pRule->dstPort << 16) | pRule->srcPort;
+        words[7] = ((uint32_t)pRule->port << 16) | pRule->ipProtocol;
+
+
+        entryOffset = XLNX_NETWORK_CAPTURE_FILTER_RULE_TABLE_OFFSET + (index * XLNX_NETWORK_CAPTURE_FILTER_RULE_ENTRY_SIZE);
+
+        //NOTE - the control word (which holds the valid bit) is written LAST so that the HW
+        //       never sees a valid rule whose match fields are only partially updated.
+        //       Any existing rule is invalidated first for the same reason.
+        retval = WriteReg32(entryOffset, 0);
+
+        for (uint32_t i = 1; i < XLNX_NETWORK_CAPTURE_FILTER_RULE_NUM_WORDS; i++)
+        {
+            if (retval == XLNX_OK)
+            {
+                retval = WriteReg32(entryOffset + (i * sizeof(uint32_t)), words[i]);
+            }
+        }
+
+        if (retval == XLNX_OK)
+        {
+            retval = WriteReg32(entryOffset, words[0]);
+        }
+    }
+
+    return retval;
+}
+
+
+
+
+uint32_t NetworkCapture::GetFilterRule(uint32_t index, FilterRule* pRule, bool* pbValid)
+{
+    uint32_t retval = XLNX_OK;
+    uint32_t words[XLNX_NETWORK_CAPTURE_FILTER_RULE_NUM_WORDS];
+    uint64_t entryOffset;
+
+    retval = CheckFilterIsSupported();
+
+    if (retval == XLNX_OK)
+    {
+        if (index >= NUM_FILTER_RULES_SUPPORTED)
+        {
+            retval = XLNX_NETWORK_CAPTURE_ERROR_INVALID_PARAMETER;
+        }
+    }
+
+
+    if (retval == XLNX_OK)
+    {
+        entryOffset = XLNX_NETWORK_CAPTURE_FILTER_RULE_TABLE_OFFSET + (index * XLNX_NETWORK_CAPTURE_FILTER_RULE_ENTRY_SIZE);
+
+        retval = BlockReadReg32(entryOffset, words, XLNX_NETWORK_CAPTURE_FILTER_RULE_NUM_WORDS);
+    }
+
+
+    if (retval == XLNX_OK)
+    {
+        *pbValid = ((words[0] & XLNX_NETWORK_CAPTURE_FILTER_RULE_VALID) != 0);
+
+        pRule->matchFlags   = (words[0] >> XLNX_NETWORK_CAPTURE_FILTER_RULE_MATCH_FLAGS_LSB) & XLNX_NETWORK_CAPTURE_FILTER_RULE_MATCH_FLAGS_MASK;
+        pRule->bCapture     = ((words[0] & XLNX_NETWORK_CAPTURE_FILTER_RULE_CAPTURE) != 0);
+        pRule->snapLength   = (uint16_t)(words[0] >> XLNX_NETWORK_CAPTURE_FILTER_RULE_SNAP_LENGTH_LSB);
+        pRule->etherType    = (uint16_t)(words[1] & 0xFFFF);
+        pRule->vlanID       = (uint16_t)((words[1] >> 16) & XLNX_NETWORK_CAPTURE_FILTER_RULE_VLAN_ID_MASK);
+        pRule->srcAddress   = words[2];
+        pRule->srcMask      = words[3];
+        pRule->dstAddress   = words[4];
+        pRule->dstMask      = words[5];
+        pRule->srcPort      = (uint16_t)(words[6] & 0xFFFF);
+        pRule->dstPort      = (uint16_t)(words[6] >> 16);
+        pRule->ipProtocol   = (uint8_t)(words[7] & 0xFF);
+        pRule->port         = (uint16_t)(words[7] >> 16);
+    }
+
+    return retval;
+}
+
+
+
+
+uint32_t NetworkCapture::DeleteFilterRule(uint32_t index)
+{
+    uint32_t retval = XLNX_OK;
+    uint64_t entryOffset;
+
+    retval = CheckFilterIsSupported();
+
+    if (retval == XLNX_OK)
+    {
+        if (index >= NUM_FILTER_RULES_SUPPORTED)
+        {
+            retval = XLNX_NETWORK_CAPTURE_ERROR_INVALID_PARAMETER;
+        }
+    }
+
+    if (retval == XLNX_OK)
+    {
+        entryOffset = XLNX_NETWORK_CAPTURE_FILTER_RULE_TABLE_OFFSET + (index * XLNX_NETWORK_CAPTURE_FILTER_RULE_ENTRY_SIZE);
+
+        retval = WriteReg32(entryOffset, 0);
+    }
+
+    return retval;
+}
+
+
+
+
+uint32_t NetworkCapture::DeleteAllFilterRules(void)
+{
+    uint32_t retval = XLNX_OK;
+
+    for (uint32_t i = 0; i < NUM_FILTER_RULES_SUPPORTED; i++)
+    {
+        retval = DeleteFilterRule(i);
+
+        if (retval != XLNX_OK)
+        {
+            break; //out of loop
+        }
+    }
+
+    return retval;
+}
+
+
+
+
+uint32_t NetworkCapture::GetFilterStats(uint32_t* pNumMatched, uint32_t* pNumDropped)
+{
+    uint32_t retval = XLNX_OK;
+
+    retval = CheckFilterIsSupported();
+
+    if (retval == XLNX_OK)
+    {
+        retval = ReadReg32(XLNX_NETWORK_CAPTURE_FILTER_STATS_MATCHED_OFFSET, pNumMatched);
+    }
+
+    if (retval == XLNX_OK)
+    {
+        retval = ReadReg32(XLNX_NETWORK_CAPTURE_FILTER_STATS_DROPPED_OFFSET, pNumDropped);
+    }
+
+    return retval;
+}
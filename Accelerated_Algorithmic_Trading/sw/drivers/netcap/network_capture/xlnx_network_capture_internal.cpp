@@ -39,6 +39,28 @@ uint32_t NetworkCapture::CheckIsInitialised(void)
 
 
 
+uint32_t NetworkCapture::CheckFilterIsSupported(void)
+{
+    uint32_t retval = XLNX_OK;
+
+    retval = CheckIsInitialised();
+
+    if (retval == XLNX_OK)
+    {
+        //NOTE - a kernel without the filter ignores writes to the filter registers and captures everything,
+        //       so report it rather than let the caller believe the traffic is being filtered.
+        if ((m_capabilities & CAPABILITY_FILTER) == 0)
+        {
+            retval = XLNX_NETWORK_CAPTURE_ERROR_NOT_SUPPORTED_BY_HW;
+        }
+    }
+
+    return retval;
+}
+
+
+
+
 uint32_t NetworkCapture::CheckIsRunning(void)
 {
     uint32_t retval = XLNX_OK;
@@ -7,22 +7,67 @@
 #define XLNX_NETWORK_CAPTURE_INITIALISED_MAGIC_NUMBER   (0x71540326)
 
 
+//The capture ring is a sequence of PACKED, VARIABLE-LENGTH records.  Each record starts on a
+//64-byte (512-bit) boundary with a PacketRecordHeader, immediately followed by the packet data,
+//and is padded up to the next 64-byte boundary.  A 60-byte frame therefore occupies 128 bytes
+//of the ring rather than a fixed 2KB slot.  When the capture filter applies a snap length, only
+//the first packetLengthInBytes bytes are stored and wireLengthInBytes holds the original length.
+//
+//Records never straddle the end of the ring.  If the next record will not fit in the space that
+//remains, the HW writes a PAD record covering the rest of the ring and wraps back to offset 0.
+
+#define XLNX_NETWORK_CAPTURE_RECORD_ALIGNMENT           (64)
+
+#define XLNX_NETWORK_CAPTURE_RECORD_FLAG_PAD            (1 << 0)    //record carries no packet data
+
+
+
+typedef struct _PacketRecordHeader
+{
+    uint16_t recordLengthInWords;   //total record length in 64-byte units, including this header and padding
+    uint16_t flags;
+    uint16_t packetLengthInBytes;
+    uint16_t wireLengthInBytes;     //length of the packet on the wire, before any snap length was applied (0 = not truncated)
+    uint32_t timestampLower;        //in kernel clock cycles
+    uint32_t timestampUpper;
+
+}PacketRecordHeader;
+
+
+
+//Kernels without XLNX_NETWORK_CAPTURE_CAPABILITY_PACKED_RECORDS write a fixed ring of 2KB chunks, one packet per chunk.
 //Each chunk contains both PACKET_DATA and PACKET_METADATA.
 //The PACKET_DATA starts at the beginning of the chunk  (offset 0x0000 - 0x07BF) (1984 bytes)
 //The PACKET_METADATA starts at a fixed offset          (offset 0x07C0 - 0x07CB) (12 bytes)
 
-#define XLNX_NETWORK_CAPTURE_METADATA_OFFSET            (0x07C0)
+#define XLNX_NETWORK_CAPTURE_LEGACY_METADATA_OFFSET     (0x07C0)
 
 
 
-typedef struct _PacketMetadata
+typedef struct _LegacyPacketMetadata
 {
     uint32_t packetLengthInBytes;
     uint32_t packetNum;
     uint32_t timestampLower; //in kernel clock cycles
     uint32_t timestampUpper;
 
-}PacketMetadata;
+}LegacyPacketMetadata;
+
+
+
+//Capture filter control register bits
+#define XLNX_NETWORK_CAPTURE_FILTER_CONTROL_ENABLE              (1 << 0)
+#define XLNX_NETWORK_CAPTURE_FILTER_CONTROL_CAPTURE_UNMATCHED   (1 << 1)
+#define XLNX_NETWORK_CAPTURE_FILTER_CONTROL_SNAP_LENGTH_LSB     (16)
+
+//Capture filter rule control word bits
+#define XLNX_NETWORK_CAPTURE_FILTER_RULE_VALID                  (1 << 0)
+#define XLNX_NETWORK_CAPTURE_FILTER_RULE_CAPTURE                (1 << 1)
+#define XLNX_NETWORK_CAPTURE_FILTER_RULE_MATCH_FLAGS_LSB        (8)
+#define XLNX_NETWORK_CAPTURE_FILTER_RULE_MATCH_FLAGS_MASK       (0xFF)
+#define XLNX_NETWORK_CAPTURE_FILTER_RULE_SNAP_LENGTH_LSB        (16)
+
+#define XLNX_NETWORK_CAPTURE_FILTER_RULE_VLAN_ID_MASK           (0x0FFF)
 
 
 
@@ -30,7 +75,9 @@ typedef struct _PacketMetadata
 //It refers to the "next free" location where data will be written.
 //However HW writes data to card RAM in 64-byte (512-bit) units,
 //and this pointer increments by 1 each time a 64-byte unit is written.
-//Therefore to get the byte offset, we must multiply the tail pointer value by 64
+//Therefore to get the byte offset, we must multiply the tail pointer value by 64.
+//With the packed record ring, the pointer is only advanced once a complete record has been written, so it always
+//lands on a record boundary.  With the legacy chunk ring it may point part way through a chunk that is being written.
 #define XLNX_NETWORK_CAPTURE_TAIL_POINTER_MULTIPLIER    (64)
 
 
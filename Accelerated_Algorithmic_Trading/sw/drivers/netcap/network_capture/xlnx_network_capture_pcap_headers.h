@@ -49,6 +49,48 @@ typedef struct pcaprec_hdr_s
 
 
 
+/* Sidecar index written alongside each capture segment, see PCAPWriter. The index header is followed by
+   pcap_index_entry_t records in file order, one for every N-th packet, each giving the packet timestamp in
+   nanoseconds and the file offset of its record header. */
+
+typedef struct pcap_index_hdr_s
+{
+    uint32_t magic_number;   /* PCAP_INDEX_MAGIC_NUMBER */
+    uint16_t version_major;
+    uint16_t version_minor;
+    uint32_t interval;       /* packets between index entries */
+    uint32_t reserved;
+
+} pcap_index_hdr_t;
+
+
+
+
+
+typedef struct pcap_index_entry_s
+{
+    uint64_t timestamp;      /* nanoseconds */
+    uint64_t offset;         /* file offset of the record header */
+
+} pcap_index_entry_t;
+
+
+
+#define PCAP_MAGIC_NUMBER_MICROSECONDS  0xA1B2C3D4
+#define PCAP_MAGIC_NUMBER_NANOSECONDS   0xA1B23C4D
+
+#define PCAP_INDEX_MAGIC_NUMBER         0x58444950  /* "PIDX" */
+#define PCAP_INDEX_VERSION_MAJOR        1
+#define PCAP_INDEX_VERSION_MINOR        0
+#define PCAP_INDEX_FILE_SUFFIX          ".idx"
+
+/* A capture to <name>.pcap that rotates is written as <name>_000000.pcap, <name>_000001.pcap, ... */
+#define PCAP_FILE_SUFFIX                ".pcap"
+#define PCAP_SEGMENT_NUMBER_FORMAT      "_%06u"
+
+
+
+
 #define LINKTYPE_ETHERNET   1
 #define LINKTYPE_RAW        101
 #define LINKTYPE_IPV4       228
@@ -15,6 +15,13 @@
  */
 
 
+#include <cstdlib>
+#include <cstring>
+#include <cerrno>
+
+#include <fcntl.h>
+#include <unistd.h>
+
 #include "xlnx_network_capture_pcap_headers.h"
 #include "xlnx_network_capture_pcap_writer.h"
 #include "xlnx_network_capture_error_codes.h"
@@ -24,7 +31,52 @@ using namespace XLNX;
 
 PCAPWriter::PCAPWriter()
 {
-    m_pFile = nullptr;
+    m_fd = -1;
+    m_tailFd = -1;
+    m_bDirectIO = false;
+    m_bDirectIOActive = false;
+    m_bufferSize = DEFAULT_BUFFER_SIZE;
+    m_flushTimeoutMilliseconds = DEFAULT_FLUSH_TIMEOUT_MILLISECONDS;
+    m_segmentSizeMegabytes = 0;
+    m_segmentDurationSeconds = 0;
+    m_indexInterval = DEFAULT_INDEX_INTERVAL;
+
+    m_segmentSizeLimit = 0;
+    m_segmentDurationLimit = 0;
+    m_segmentIndexInterval = 0;
+    m_segmentNumber = 0;
+    m_segmentNumBytes = 0;
+    m_segmentNumPackets = 0;
+    m_segmentStartTimestamp = 0;
+    m_pIndexFile = nullptr;
+
+    for (uint32_t i = 0; i < NUM_BUFFERS; i++)
+    {
+        m_pBuffers[i] = nullptr;
+    }
+
+    m_activeBufferIndex = 0;
+    m_activeBufferLength = 0;
+    m_activeBufferFlushedLength = 0;
+
+    m_bWriterKeepRunning = false;
+    m_bWriteRequested = false;
+    m_writeBufferIndex = 0;
+    m_writeBufferLength = 0;
+    m_writeTailLength = 0;
+    m_writeTailOffset = 0;
+    m_writeError = XLNX_OK;
+
+    m_numPackets = 0;
+    m_numBytes = 0;
+    m_numBytesWritten = 0;
+    m_numBufferWrites = 0;
+    m_maxBacklogBytes = 0;
+    m_numStalls = 0;
+    m_stallNanoseconds = 0;
+    m_writeNanoseconds = 0;
+    m_numSegments = 0;
+    m_numIndexEntries = 0;
 }
 
 
@@ -39,38 +91,471 @@ PCAPWriter::~PCAPWriter()
 uint32_t PCAPWriter::Start(char* filePath)
 {
     uint32_t retval = XLNX_OK;
-   
 
-    m_pFile = fopen(filePath, "wb");
+    //a writer can only have one file open at a time
+    Stop();
+
+    m_numPackets = 0;
+    m_numBytes = 0;
+    m_numBytesWritten = 0;
+    m_numBufferWrites = 0;
+    m_maxBacklogBytes = 0;
+    m_numStalls = 0;
+    m_stallNanoseconds = 0;
+    m_writeNanoseconds = 0;
+    m_numSegments = 0;
+    m_numIndexEntries = 0;
+    m_writeError = XLNX_OK;
 
-    if (m_pFile != nullptr)
+    m_filePath = filePath;
+    m_segmentSizeLimit = (uint64_t)m_segmentSizeMegabytes * 1024 * 1024;
+    m_segmentDurationLimit = (uint64_t)m_segmentDurationSeconds * 1000000000;
+    m_segmentIndexInterval = m_indexInterval;
+    m_segmentNumber = 0;
+
+    retval = AllocateBuffers();
+
+    if (retval == XLNX_OK)
     {
-        retval = WriteFileHeader();
+        m_activeBufferIndex = 0;
+        m_activeBufferLength = 0;
+        m_activeBufferFlushedLength = 0;
+        m_startTime = std::chrono::steady_clock::now();
+
+        m_bWriterKeepRunning = true;
+        m_bWriteRequested = false;
+        m_writerThread = std::thread(&PCAPWriter::WriterThreadFunc, this);
+
+        retval = OpenSegment();
+    }
+
+    if (retval != XLNX_OK)
+    {
+        Stop();
+    }
+
+    return retval;
+}
+
+
+
+
+uint32_t PCAPWriter::Stop()
+{
+    uint32_t retval = XLNX_OK;
+
+    retval = CloseSegment();
+
+    if (m_writerThread.joinable())
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_bWriterKeepRunning = false;
+        }
+        m_condition.notify_all();
+
+        m_writerThread.join();
+    }
+
+    FreeBuffers();
+
+    if (retval == XLNX_OK)
+    {
+        retval = m_writeError;
+    }
+
+    return retval;
+}
+
+
+
+
+bool PCAPWriter::SegmentsEnabled(void)
+{
+    return ((m_segmentSizeLimit > 0) || (m_segmentDurationLimit > 0));
+}
+
+
+
+
+void PCAPWriter::GetSegmentPath(uint32_t segmentNumber, std::string* pPath)
+{
+    static const size_t SUFFIX_LENGTH = strlen(PCAP_FILE_SUFFIX);
+    char segmentNumberString[32];
+
+    *pPath = m_filePath;
+
+    if (SegmentsEnabled())
+    {
+        //<name>.pcap -> <name>_NNNNNN.pcap
+        if ((pPath->size() >= SUFFIX_LENGTH) && (pPath->compare(pPath->size() - SUFFIX_LENGTH, SUFFIX_LENGTH, PCAP_FILE_SUFFIX) == 0))
+        {
+            pPath->erase(pPath->size() - SUFFIX_LENGTH);
+        }
+
+        snprintf(segmentNumberString, sizeof(segmentNumberString), PCAP_SEGMENT_NUMBER_FORMAT, segmentNumber);
+
+        pPath->append(segmentNumberString);
+        pPath->append(PCAP_FILE_SUFFIX);
     }
-    else
+}
+
+
+
+
+uint32_t PCAPWriter::OpenSegment(void)
+{
+    uint32_t retval = XLNX_OK;
+    int flags = O_WRONLY | O_CREAT | O_TRUNC;
+    std::string segmentPath;
+    std::string indexPath;
+    pcap_index_hdr_t indexHeader;
+
+    GetSegmentPath(m_segmentNumber, &segmentPath);
+
+#ifdef O_DIRECT
+    if (m_bDirectIO)
+    {
+        flags |= O_DIRECT;
+    }
+#endif
+
+    m_fd = open(segmentPath.c_str(), flags, 0644);
+
+#ifdef O_DIRECT
+    if ((m_fd < 0) && m_bDirectIO && (errno == EINVAL))
+    {
+        //filesystem does not support direct I/O (e.g. tmpfs), fall back to buffered writes
+        m_fd = open(segmentPath.c_str(), flags & ~O_DIRECT, 0644);
+        flags &= ~O_DIRECT;
+    }
+#endif
+
+    if (m_fd < 0)
     {
         retval = XLNX_NETWORK_CAPTURE_ERROR_FAILED_TO_OPEN_PCAP_FILE_FOR_WRITING;
     }
-   
 
 
+    if (retval == XLNX_OK)
+    {
+#ifdef O_DIRECT
+        m_bDirectIOActive = ((flags & O_DIRECT) != 0);
+#else
+        m_bDirectIOActive = false;
+#endif
+
+        m_segmentNumBytes = 0;
+        m_segmentNumPackets = 0;
+        m_segmentStartTimestamp = 0;
+        m_numSegments++;
+
+        if (m_bDirectIOActive)
+        {
+            //for tails that have to go out before the block they are in is complete, see CheckFlushTimeout()
+            m_tailFd = open(segmentPath.c_str(), O_WRONLY);
+
+            if (m_tailFd < 0)
+            {
+                retval = XLNX_NETWORK_CAPTURE_ERROR_FAILED_TO_OPEN_PCAP_FILE_FOR_WRITING;
+            }
+        }
+    }
+
+    if (retval == XLNX_OK)
+    {
+        retval = WriteFileHeader();
+    }
+
+
+    if ((retval == XLNX_OK) && (m_segmentIndexInterval > 0))
+    {
+        indexPath = segmentPath + PCAP_INDEX_FILE_SUFFIX;
+
+        m_pIndexFile = fopen(indexPath.c_str(), "wb");
+
+        if (m_pIndexFile == nullptr)
+        {
+            retval = XLNX_NETWORK_CAPTURE_ERROR_FAILED_TO_OPEN_PCAP_FILE_FOR_WRITING;
+        }
+
+        if (retval == XLNX_OK)
+        {
+            indexHeader.magic_number    = PCAP_INDEX_MAGIC_NUMBER;
+            indexHeader.version_major   = PCAP_INDEX_VERSION_MAJOR;
+            indexHeader.version_minor   = PCAP_INDEX_VERSION_MINOR;
+            indexHeader.interval        = m_segmentIndexInterval;
+            indexHeader.reserved        = 0;
+
+            if (fwrite(&indexHeader, sizeof(indexHeader), 1, m_pIndexFile) != 1)
+            {
+                retval = XLNX_NETWORK_CAPTURE_ERROR_PCAP_FILE_WRITE_FAILED;
+            }
+        }
+    }
+
     return retval;
 }
 
 
 
 
-uint32_t PCAPWriter::Stop()
+uint32_t PCAPWriter::CloseSegment(void)
 {
     uint32_t retval = XLNX_OK;
+    size_t tailLength;
+    int flags;
 
-    if (m_pFile != nullptr)
+    if (m_fd >= 0)
     {
-        fflush(m_pFile);
-        fclose(m_pFile);
-        m_pFile = nullptr;
+        //push out whatever is buffered...with direct I/O this may leave an unaligned tail behind
+        retval = SubmitActiveBuffer(false);
+
+        if (retval == XLNX_OK)
+        {
+            //the writer thread must be finished with the file before we touch it from this thread
+            retval = WaitForWriterIdle();
+        }
+
+        tailLength = m_activeBufferLength;
+
+        if ((retval == XLNX_OK) && (tailLength > 0))
+        {
+            //the final partial block cannot be written with O_DIRECT
+            flags = fcntl(m_fd, F_GETFL);
+#ifdef O_DIRECT
+            fcntl(m_fd, F_SETFL, flags & ~O_DIRECT);
+#else
+            (void)flags;
+#endif
+            retval = WriteToFile(m_pBuffers[m_activeBufferIndex], tailLength);
+
+            if (retval == XLNX_OK)
+            {
+                m_numBytesWritten += tailLength;
+            }
+        }
+
+        //the writer thread is idle, so the entries for the tail are written from here along with it
+        if (retval == XLNX_OK)
+        {
+            retval = WriteIndexEntries(m_activeBufferIndex);
+        }
+
+        m_indexEntries[m_activeBufferIndex].clear();
+        m_activeBufferLength = 0;
+        m_activeBufferFlushedLength = 0;
+
+        close(m_fd);
+        m_fd = -1;
+    }
+
+    if (m_tailFd >= 0)
+    {
+        close(m_tailFd);
+        m_tailFd = -1;
+    }
+
+
+    if (m_pIndexFile != nullptr)
+    {
+        if ((fclose(m_pIndexFile) != 0) && (retval == XLNX_OK))
+        {
+            retval = XLNX_NETWORK_CAPTURE_ERROR_PCAP_FILE_WRITE_FAILED;
+        }
+
+        m_pIndexFile = nullptr;
+    }
+
+    return retval;
+}
+
+
+
+
+uint32_t PCAPWriter::WriteIndexEntries(uint32_t bufferIndex)
+{
+    uint32_t retval = XLNX_OK;
+    std::vector<pcap_index_entry_t>& indexEntries = m_indexEntries[bufferIndex];
+
+    if ((m_pIndexFile != nullptr) && (indexEntries.empty() == false))
+    {
+        if (fwrite(indexEntries.data(), sizeof(pcap_index_entry_t), indexEntries.size(), m_pIndexFile) == indexEntries.size())
+        {
+            m_numIndexEntries += indexEntries.size();
+        }
+        else
+        {
+            retval = XLNX_NETWORK_CAPTURE_ERROR_PCAP_FILE_WRITE_FAILED;
+        }
     }
 
+    indexEntries.clear();
+
+    return retval;
+}
+
+
+
+
+uint32_t PCAPWriter::SetSegmentSize(uint32_t megabytes)
+{
+    m_segmentSizeMegabytes = megabytes;
+
+    return XLNX_OK;
+}
+
+
+
+
+uint32_t PCAPWriter::GetSegmentSize(uint32_t* pMegabytes)
+{
+    *pMegabytes = m_segmentSizeMegabytes;
+
+    return XLNX_OK;
+}
+
+
+
+
+uint32_t PCAPWriter::SetSegmentDuration(uint32_t seconds)
+{
+    m_segmentDurationSeconds = seconds;
+
+    return XLNX_OK;
+}
+
+
+
+
+uint32_t PCAPWriter::GetSegmentDuration(uint32_t* pSeconds)
+{
+    *pSeconds = m_segmentDurationSeconds;
+
+    return XLNX_OK;
+}
+
+
+
+
+uint32_t PCAPWriter::SetIndexInterval(uint32_t numPackets)
+{
+    m_indexInterval = numPackets;
+
+    return XLNX_OK;
+}
+
+
+
+
+uint32_t PCAPWriter::GetIndexInterval(uint32_t* pNumPackets)
+{
+    *pNumPackets = m_indexInterval;
+
+    return XLNX_OK;
+}
+
+
+
+
+
+uint32_t PCAPWriter::SetBufferSize(uint32_t numBytes)
+{
+    uint32_t retval = XLNX_OK;
+
+    if ((numBytes < MIN_BUFFER_SIZE) || ((numBytes % DIRECT_IO_ALIGNMENT) != 0))
+    {
+        retval = XLNX_NETWORK_CAPTURE_ERROR_INVALID_PARAMETER;
+    }
+
+    if (retval == XLNX_OK)
+    {
+        m_bufferSize = numBytes;
+    }
+
+    return retval;
+}
+
+
+
+
+uint32_t PCAPWriter::GetBufferSize(uint32_t* pNumBytes)
+{
+    *pNumBytes = m_bufferSize;
+
+    return XLNX_OK;
+}
+
+
+
+
+uint32_t PCAPWriter::SetDirectIO(bool bEnabled)
+{
+    m_bDirectIO = bEnabled;
+
+    return XLNX_OK;
+}
+
+
+
+
+uint32_t PCAPWriter::GetDirectIO(bool* pbEnabled)
+{
+    *pbEnabled = m_bDirectIO;
+
+    return XLNX_OK;
+}
+
+
+
+
+uint32_t PCAPWriter::SetFlushTimeout(uint32_t milliseconds)
+{
+    m_flushTimeoutMilliseconds = milliseconds;
+
+    return XLNX_OK;
+}
+
+
+
+
+uint32_t PCAPWriter::GetFlushTimeout(uint32_t* pMilliseconds)
+{
+    *pMilliseconds = m_flushTimeoutMilliseconds;
+
+    return XLNX_OK;
+}
+
+
+
+
+uint32_t PCAPWriter::CheckFlushTimeout(void)
+{
+    uint32_t retval = XLNX_OK;
+    bool bWriterBusy;
+    uint64_t fillMilliseconds;
+
+    retval = CheckFileIsOpen();
+
+    //with direct I/O the only data may be a tail that an earlier timeout has already written
+    if ((retval == XLNX_OK) && (m_activeBufferLength > m_activeBufferFlushedLength))
+    {
+        fillMilliseconds = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - m_activeBufferFillStartTime).count();
+
+        if (fillMilliseconds >= m_flushTimeoutMilliseconds)
+        {
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                bWriterBusy = m_bWriteRequested;
+            }
+
+            //if the writer is still busy the data will go out with its next buffer anyway
+            if (bWriterBusy == false)
+            {
+                retval = SubmitActiveBuffer(true);
+            }
+        }
+    }
 
     return retval;
 }
@@ -83,7 +568,7 @@ uint32_t PCAPWriter::CheckFileIsOpen(void)
 {
     uint32_t retval = XLNX_OK;
 
-    if (m_pFile == nullptr)
+    if (m_fd < 0)
     {
         retval = XLNX_NETWORK_CAPTURE_ERROR_PCAP_FILE_NOT_OPEN;
     }
@@ -104,7 +589,7 @@ uint32_t PCAPWriter::WriteFileHeader(void)
 
     if (retval == XLNX_OK)
     {
-        fileHeader.magic_number     = 0xA1B23C4D;   //nanosecond variant
+        fileHeader.magic_number     = PCAP_MAGIC_NUMBER_NANOSECONDS;
         fileHeader.version_major    = 2;
         fileHeader.version_minor    = 4;
         fileHeader.thiszone         = 0;
@@ -112,8 +597,13 @@ uint32_t PCAPWriter::WriteFileHeader(void)
         fileHeader.snaplen          = MAX_PACKET_LENGTH;
         fileHeader.network          = LINKTYPE_ETHERNET;
 
-        fwrite(&fileHeader, sizeof(fileHeader), 1, m_pFile);
-        fflush(m_pFile);
+        //the header goes out with the first buffer rather than as a write of its own
+        m_activeBufferFillStartTime = std::chrono::steady_clock::now();
+        memcpy(m_pBuffers[m_activeBufferIndex], &fileHeader, sizeof(fileHeader));
+        m_activeBufferLength = sizeof(fileHeader);
+
+        m_numBytes += sizeof(fileHeader);
+        m_segmentNumBytes += sizeof(fileHeader);
     }
    
 
@@ -125,9 +615,21 @@ uint32_t PCAPWriter::WriteFileHeader(void)
 
 
 uint32_t PCAPWriter::WritePacket(uint8_t* pPacketData, uint32_t dataLength, uint64_t timestampNanoseconds)
+{
+    return WritePacket(pPacketData, dataLength, dataLength, timestampNanoseconds);
+}
+
+
+
+
+uint32_t PCAPWriter::WritePacket(uint8_t* pPacketData, uint32_t dataLength, uint32_t originalLength, uint64_t timestampNanoseconds)
 {
     uint32_t retval = XLNX_OK;
     pcaprec_hdr_t packetHeader;
+    pcap_index_entry_t indexEntry;
+    uint8_t* pBuffer;
+    size_t recordLength;
+    uint64_t backlogBytes;
     
     uint64_t seconds;
     uint64_t nanoseconds;
@@ -142,7 +644,7 @@ uint32_t PCAPWriter::WritePacket(uint8_t* pPacketData, uint32_t dataLength, uint
 
         packetHeader.ts_sec     = (uint32_t)seconds;
         packetHeader.ts_nsec    = (uint32_t)nanoseconds;
-        packetHeader.orig_len   = dataLength;
+        packetHeader.orig_len   = originalLength;
 
         if (dataLength > MAX_PACKET_LENGTH)
         {
@@ -152,17 +654,389 @@ uint32_t PCAPWriter::WritePacket(uint8_t* pPacketData, uint32_t dataLength, uint
         {
             packetHeader.incl_len = dataLength;
         }
+
+        recordLength = sizeof(packetHeader) + packetHeader.incl_len;
+
+        //start a new segment if this packet would take the current one over its size or time limit
+        if (SegmentsEnabled() && (m_segmentNumPackets > 0))
+        {
+            if (((m_segmentSizeLimit > 0) && ((m_segmentNumBytes + recordLength) > m_segmentSizeLimit)) ||
+                ((m_segmentDurationLimit > 0) && (timestampNanoseconds >= m_segmentStartTimestamp) && ((timestampNanoseconds - m_segmentStartTimestamp) >= m_segmentDurationLimit)))
+            {
+                retval = CloseSegment();
+
+                if (retval == XLNX_OK)
+                {
+                    m_segmentNumber++;
+                    retval = OpenSegment();
+                }
+            }
+        }
+    }
+
+    if (retval == XLNX_OK)
+    {
+        if (m_segmentNumPackets == 0)
+        {
+            m_segmentStartTimestamp = timestampNanoseconds;
+        }
+
+        //records are never split across buffers
+        if ((m_activeBufferLength + recordLength) > m_bufferSize)
+        {
+            retval = SubmitActiveBuffer(false);
+        }
+    }
+
+    if (retval == XLNX_OK)
+    {
+        //only noted here, the writer thread writes it out with the buffer
+        if ((m_pIndexFile != nullptr) && ((m_segmentNumPackets % m_segmentIndexInterval) == 0))
+        {
+            indexEntry.timestamp    = timestampNanoseconds;
+            indexEntry.offset       = m_segmentNumBytes;
+
+            m_indexEntries[m_activeBufferIndex].push_back(indexEntry);
+        }
+    }
+
+    if (retval == XLNX_OK)
+    {
+        if (m_activeBufferLength == m_activeBufferFlushedLength)
+        {
+            m_activeBufferFillStartTime = std::chrono::steady_clock::now();
+        }
+
+        pBuffer = m_pBuffers[m_activeBufferIndex] + m_activeBufferLength;
    
         //write the packet header...
-        fwrite(&packetHeader, sizeof(packetHeader), 1, m_pFile);
+        memcpy(pBuffer, &packetHeader, sizeof(packetHeader));
 
         //...and then the data...
-        fwrite(pPacketData, 1, packetHeader.incl_len, m_pFile);
+        memcpy(pBuffer + sizeof(packetHeader), pPacketData, packetHeader.incl_len);
+
+        m_activeBufferLength += recordLength;
+
+        m_numPackets++;
+        m_numBytes += recordLength;
+
+        m_segmentNumPackets++;
+        m_segmentNumBytes += recordLength;
+
+        backlogBytes = m_numBytes - m_numBytesWritten;
+
+        if (backlogBytes > m_maxBacklogBytes)
+        {
+            m_maxBacklogBytes = backlogBytes;
+        }
+    }
+
+
+    return retval;
+}
+
+
+
+
+uint32_t PCAPWriter::GetStats(Stats* pStats)
+{
+    uint32_t retval = XLNX_OK;
+
+    pStats->numPackets          = m_numPackets;
+    pStats->numBytes            = m_numBytes;
+    pStats->numBytesWritten     = m_numBytesWritten;
+    pStats->numBufferWrites     = m_numBufferWrites;
+    pStats->maxBacklogBytes     = m_maxBacklogBytes;
+    pStats->numStalls           = m_numStalls;
+    pStats->stallNanoseconds    = m_stallNanoseconds;
+    pStats->writeNanoseconds    = m_writeNanoseconds;
+    pStats->numSegments         = m_numSegments;
+    pStats->numIndexEntries     = m_numIndexEntries;
+
+    pStats->backlogBytes = 0;
+    if (pStats->numBytes > pStats->numBytesWritten)
+    {
+        pStats->backlogBytes = pStats->numBytes - pStats->numBytesWritten;
+    }
 
-        fflush(m_pFile);
+    pStats->elapsedNanoseconds = 0;
+    if (m_fd >= 0)
+    {
+        pStats->elapsedNanoseconds = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - m_startTime).count();
     }
 
+    return retval;
+}
+
+
+
+
+uint32_t PCAPWriter::AllocateBuffers(void)
+{
+    uint32_t retval = XLNX_OK;
+    void* pBuffer;
+
+    for (uint32_t i = 0; (i < NUM_BUFFERS) && (retval == XLNX_OK); i++)
+    {
+        //aligned for O_DIRECT, which requires the memory as well as the file offset and length to be aligned
+        if (posix_memalign(&pBuffer, DIRECT_IO_ALIGNMENT, m_bufferSize) == 0)
+        {
+            m_pBuffers[i] = (uint8_t*)pBuffer;
+        }
+        else
+        {
+            retval = XLNX_NETWORK_CAPTURE_ERROR_FAILED_TO_ALLOCATE_WRITE_BUFFER;
+        }
+
+        //enough for a buffer full of the smallest records, so the capture thread never allocates
+        if ((retval == XLNX_OK) && (m_segmentIndexInterval > 0))
+        {
+            m_indexEntries[i].clear();
+            m_indexEntries[i].reserve((m_bufferSize / (sizeof(pcaprec_hdr_t) * m_segmentIndexInterval)) + 1);
+        }
+    }
+
+    if (retval != XLNX_OK)
+    {
+        FreeBuffers();
+    }
 
     return retval;
 }
 
+
+
+
+void PCAPWriter::FreeBuffers(void)
+{
+    for (uint32_t i = 0; i < NUM_BUFFERS; i++)
+    {
+        free(m_pBuffers[i]);
+        m_pBuffers[i] = nullptr;
+
+        m_indexEntries[i].clear();
+    }
+}
+
+
+
+
+uint32_t PCAPWriter::SubmitActiveBuffer(bool bWriteTail)
+{
+    uint32_t retval = XLNX_OK;
+    uint32_t nextBufferIndex;
+    size_t submitLength;
+    size_t remainderLength = 0;
+    size_t tailLength = 0;
+    uint64_t remainderOffset;
+    std::vector<pcap_index_entry_t>::iterator it;
+
+    //the other buffer must have been written out before it can be refilled
+    retval = WaitForWriterIdle();
+
+    if (retval == XLNX_OK)
+    {
+        submitLength = m_activeBufferLength;
+
+        if (m_bDirectIOActive)
+        {
+            submitLength = m_activeBufferLength & ~((size_t)DIRECT_IO_ALIGNMENT - 1);
+            remainderLength = m_activeBufferLength - submitLength;
+        }
+
+        if (bWriteTail && (remainderLength > m_activeBufferFlushedLength))
+        {
+            tailLength = remainderLength;
+        }
+
+        nextBufferIndex = (m_activeBufferIndex + 1) % NUM_BUFFERS;
+
+        if ((submitLength > 0) || (tailLength > 0))
+        {
+            if (remainderLength > 0)
+            {
+                memcpy(m_pBuffers[nextBufferIndex], m_pBuffers[m_activeBufferIndex] + submitLength, remainderLength);
+
+                //...and the index entries for records in the remainder go with it, so that the index never
+                //points past what is on disk
+                remainderOffset = m_segmentNumBytes - remainderLength;
+
+                it = m_indexEntries[m_activeBufferIndex].end();
+                while ((it != m_indexEntries[m_activeBufferIndex].begin()) && ((it - 1)->offset >= remainderOffset))
+                {
+                    it--;
+                }
+
+                m_indexEntries[nextBufferIndex].assign(it, m_indexEntries[m_activeBufferIndex].end());
+                m_indexEntries[m_activeBufferIndex].erase(it, m_indexEntries[m_activeBufferIndex].end());
+            }
+
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_writeBufferIndex = m_activeBufferIndex;
+                m_writeBufferLength = submitLength;
+                m_writeTailLength = tailLength;
+                m_writeTailOffset = m_segmentNumBytes - remainderLength;
+                m_bWriteRequested = true;
+            }
+            m_condition.notify_all();
+
+            m_numBufferWrites++;
+
+            //any tail flushed earlier lies inside the aligned part just submitted
+            m_activeBufferFlushedLength = tailLength;
+
+            m_activeBufferIndex = nextBufferIndex;
+            m_activeBufferLength = remainderLength;
+            m_activeBufferFillStartTime = std::chrono::steady_clock::now();
+        }
+    }
+
+    return retval;
+}
+
+
+
+
+uint32_t PCAPWriter::WaitForWriterIdle(void)
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+
+    if (m_bWriteRequested)
+    {
+        std::chrono::steady_clock::time_point stallStartTime = std::chrono::steady_clock::now();
+
+        m_condition.wait(lock, [this] { return (m_bWriteRequested == false); });
+
+        m_numStalls++;
+        m_stallNanoseconds += std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - stallStartTime).count();
+    }
+
+    return m_writeError;
+}
+
+
+
+
+uint32_t PCAPWriter::WriteToFile(const uint8_t* pData, size_t numBytes)
+{
+    uint32_t retval = XLNX_OK;
+    ssize_t numBytesWritten;
+
+    while ((numBytes > 0) && (retval == XLNX_OK))
+    {
+        numBytesWritten = write(m_fd, pData, numBytes);
+
+        if (numBytesWritten > 0)
+        {
+            pData += numBytesWritten;
+            numBytes -= (size_t)numBytesWritten;
+        }
+        else if ((numBytesWritten < 0) && (errno == EINTR))
+        {
+            continue;
+        }
+        else
+        {
+            retval = XLNX_NETWORK_CAPTURE_ERROR_PCAP_FILE_WRITE_FAILED;
+        }
+    }
+
+    return retval;
+}
+
+
+
+
+uint32_t PCAPWriter::WriteToFileAt(int fd, const uint8_t* pData, size_t numBytes, uint64_t offset)
+{
+    uint32_t retval = XLNX_OK;
+    ssize_t numBytesWritten;
+
+    while ((numBytes > 0) && (retval == XLNX_OK))
+    {
+        numBytesWritten = pwrite(fd, pData, numBytes, (off_t)offset);
+
+        if (numBytesWritten > 0)
+        {
+            pData += numBytesWritten;
+            numBytes -= (size_t)numBytesWritten;
+            offset += (uint64_t)numBytesWritten;
+        }
+        else if ((numBytesWritten < 0) && (errno == EINTR))
+        {
+            continue;
+        }
+        else
+        {
+            retval = XLNX_NETWORK_CAPTURE_ERROR_PCAP_FILE_WRITE_FAILED;
+        }
+    }
+
+    return retval;
+}
+
+
+
+
+void PCAPWriter::WriterThreadFunc(void)
+{
+    uint32_t retval;
+    const uint8_t* pData;
+    size_t numBytes;
+    size_t tailLength;
+    uint64_t tailOffset;
+    uint32_t bufferIndex;
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+
+    while (true)
+    {
+        m_condition.wait(lock, [this] { return (m_bWriteRequested || (m_bWriterKeepRunning == false)); });
+
+        if (m_bWriteRequested == false)
+        {
+            break; //asked to stop with nothing outstanding
+        }
+
+        bufferIndex = m_writeBufferIndex;
+        pData = m_pBuffers[bufferIndex];
+        numBytes = m_writeBufferLength;
+        tailLength = m_writeTailLength;
+        tailOffset = m_writeTailOffset;
+
+        //the capture thread keeps filling the other buffer while this one is written
+        lock.unlock();
+
+        std::chrono::steady_clock::time_point writeStartTime = std::chrono::steady_clock::now();
+
+        retval = WriteToFile(pData, numBytes);
+
+        //the unaligned tail is written through the buffered descriptor at its place in the file...it has also
+        //been carried over to the next buffer, which writes it again (and counts it) as part of a full block
+        if ((retval == XLNX_OK) && (tailLength > 0))
+        {
+            retval = WriteToFileAt(m_tailFd, pData + numBytes, tailLength, tailOffset);
+        }
+
+        m_writeNanoseconds += std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - writeStartTime).count();
+
+        if (retval == XLNX_OK)
+        {
+            m_numBytesWritten += numBytes;
+
+            //index entries only once their records are in the file
+            retval = WriteIndexEntries(bufferIndex);
+        }
+
+        lock.lock();
+
+        if (retval != XLNX_OK)
+        {
+            m_writeError = retval;
+        }
+
+        m_bWriteRequested = false;
+        m_condition.notify_all();
+    }
+}
@@ -20,11 +20,29 @@
 
 #include <cstdio>
 #include <cstdint>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <string>
+#include <vector>
+
+#include "xlnx_network_capture_pcap_headers.h"
 
 
 namespace XLNX
 {
 
+//Packets are appended to one of two large aligned buffers in user space. A full buffer (or one that
+//has been partially filled for longer than the flush timeout) is handed to a dedicated writer thread,
+//so that disk I/O overlaps with the capture thread filling the other buffer. The capture thread only
+//blocks if the writer thread has not yet finished with the previous buffer.
+//
+//The capture can optionally be split into segment files that rotate on size or on packet time, and each
+//segment gets a sidecar index of (timestamp, file offset) pairs so that a time window can be located
+//without scanning the capture, see CaptureStore.  Index entries travel with the buffer holding their
+//records and are written by the writer thread once those records are on disk.
 class PCAPWriter
 {
 
@@ -40,22 +58,158 @@ public:
 
 
 
+public: //Segments and Index
+
+    static const uint32_t DEFAULT_INDEX_INTERVAL = 1024;
+
+    //The following settings take effect on the next call to Start().
+    //A segment size or duration of 0 disables that limit. With both disabled the capture is written to
+    //a single file at the path passed to Start(), otherwise <name>.pcap becomes <name>_000000.pcap,
+    //<name>_000001.pcap, ...  A segment is never left empty, so a single packet larger than the size
+    //limit still gets written.  Durations are measured with packet timestamps.
+    //An index interval of N adds an entry to <segment>.idx for every N-th packet, 0 disables the index.
+    uint32_t SetSegmentSize(uint32_t megabytes);
+    uint32_t GetSegmentSize(uint32_t* pMegabytes);
+    uint32_t SetSegmentDuration(uint32_t seconds);
+    uint32_t GetSegmentDuration(uint32_t* pSeconds);
+    uint32_t SetIndexInterval(uint32_t numPackets);
+    uint32_t GetIndexInterval(uint32_t* pNumPackets);
+
+
+
+public: //Buffering
+
+    static const uint32_t DEFAULT_BUFFER_SIZE = 4 * 1024 * 1024;
+    static const uint32_t MIN_BUFFER_SIZE = 256 * 1024;
+    static const uint32_t DEFAULT_FLUSH_TIMEOUT_MILLISECONDS = 100;
+    static const uint32_t DIRECT_IO_ALIGNMENT = 4096;
+
+    //The following settings take effect on the next call to Start().
+    //The buffer size must be a multiple of DIRECT_IO_ALIGNMENT.
+    //When direct I/O is enabled, the file is opened with O_DIRECT so that writes bypass the page cache,
+    //any unaligned tail at each flush is carried over to the next buffer and written again from there.
+    //A flush on timeout also writes that tail through a second, buffered descriptor so that it reaches
+    //the file without waiting for the next aligned block.
+    uint32_t SetBufferSize(uint32_t numBytes);
+    uint32_t GetBufferSize(uint32_t* pNumBytes);
+    uint32_t SetDirectIO(bool bEnabled);
+    uint32_t GetDirectIO(bool* pbEnabled);
+    uint32_t SetFlushTimeout(uint32_t milliseconds);
+    uint32_t GetFlushTimeout(uint32_t* pMilliseconds);
+
+    //Should be called periodically by the capture thread, hands a partially filled buffer to the writer
+    //thread once it has held data for longer than the flush timeout. Never blocks.
+    uint32_t CheckFlushTimeout(void);
+
+
+
 public:
     static const uint32_t MAX_PACKET_LENGTH = 65536;
    
     uint32_t WritePacket(uint8_t* pPacketData, uint32_t dataLength, uint64_t timestampNanoseconds);
 
+    //For packets that were truncated before capture, originalLength is the length of the packet on the wire
+    uint32_t WritePacket(uint8_t* pPacketData, uint32_t dataLength, uint32_t originalLength, uint64_t timestampNanoseconds);
+
+
+
+public: //Stats
+    typedef struct
+    {
+        uint64_t numPackets;            //packets accepted
+        uint64_t numBytes;              //bytes accepted, including file and record headers
+        uint64_t numBytesWritten;       //bytes written to the file
+        uint64_t numBufferWrites;       //buffers handed to the writer thread
+        uint64_t backlogBytes;          //bytes accepted but not yet written
+        uint64_t maxBacklogBytes;
+        uint64_t numStalls;             //times the capture thread waited for the writer thread
+        uint64_t stallNanoseconds;
+        uint64_t writeNanoseconds;      //time spent in write system calls
+        uint64_t elapsedNanoseconds;    //since Start()
+        uint64_t numSegments;           //segment files opened since Start()
+        uint64_t numIndexEntries;
+    }Stats;
+
+    uint32_t GetStats(Stats* pStats);
+
+
 
 protected:
     uint32_t CheckFileIsOpen(void);
     uint32_t WriteFileHeader(void);
 
-protected:
-    FILE* m_pFile;
-
-
+    bool SegmentsEnabled(void);
+    void GetSegmentPath(uint32_t segmentNumber, std::string* pPath);
+    uint32_t OpenSegment(void);
+    uint32_t CloseSegment(void);
+    uint32_t WriteIndexEntries(uint32_t bufferIndex);
 
+    uint32_t AllocateBuffers(void);
+    void FreeBuffers(void);
+    uint32_t SubmitActiveBuffer(bool bWriteTail);
+    uint32_t WaitForWriterIdle(void);
+    uint32_t WriteToFile(const uint8_t* pData, size_t numBytes);
+    uint32_t WriteToFileAt(int fd, const uint8_t* pData, size_t numBytes, uint64_t offset);
+    void WriterThreadFunc(void);
 
+protected:
+    static const uint32_t NUM_BUFFERS = 2;
+
+    int m_fd;
+    int m_tailFd;   //same file without O_DIRECT, only open while direct I/O is active
+    bool m_bDirectIO;
+    bool m_bDirectIOActive;
+    uint32_t m_bufferSize;
+    uint32_t m_flushTimeoutMilliseconds;
+    uint32_t m_segmentSizeMegabytes;
+    uint32_t m_segmentDurationSeconds;
+    uint32_t m_indexInterval;
+
+    //current capture, owned by the capture thread. The limits are latched from the settings above by Start()
+    std::string m_filePath;
+    uint64_t m_segmentSizeLimit;
+    uint64_t m_segmentDurationLimit;
+    uint32_t m_segmentIndexInterval;
+    uint32_t m_segmentNumber;
+    uint64_t m_segmentNumBytes;
+    uint64_t m_segmentNumPackets;
+    uint64_t m_segmentStartTimestamp;
+
+    //only opened and closed while the writer thread is idle, written by the writer thread
+    FILE* m_pIndexFile;
+
+    //owned by the capture thread
+    uint8_t* m_pBuffers[NUM_BUFFERS];
+    std::vector<pcap_index_entry_t> m_indexEntries[NUM_BUFFERS];  //for the records held in each buffer
+    uint32_t m_activeBufferIndex;
+    size_t m_activeBufferLength;
+    size_t m_activeBufferFlushedLength;     //carried over tail that is already in the file
+    std::chrono::steady_clock::time_point m_activeBufferFillStartTime;
+    std::chrono::steady_clock::time_point m_startTime;
+
+    //shared with the writer thread, protected by m_mutex
+    std::thread m_writerThread;
+    std::mutex m_mutex;
+    std::condition_variable m_condition;
+    bool m_bWriterKeepRunning;
+    bool m_bWriteRequested;
+    uint32_t m_writeBufferIndex;
+    size_t m_writeBufferLength;
+    size_t m_writeTailLength;
+    uint64_t m_writeTailOffset;
+    uint32_t m_writeError;
+
+    //counters may be read from another thread via GetStats()
+    std::atomic<uint64_t> m_numPackets;
+    std::atomic<uint64_t> m_numBytes;
+    std::atomic<uint64_t> m_numBytesWritten;
+    std::atomic<uint64_t> m_numBufferWrites;
+    std::atomic<uint64_t> m_maxBacklogBytes;
+    std::atomic<uint64_t> m_numStalls;
+    std::atomic<uint64_t> m_stallNanoseconds;
+    std::atomic<uint64_t> m_writeNanoseconds;
+    std::atomic<uint64_t> m_numSegments;
+    std::atomic<uint64_t> m_numIndexEntries;
 };
 
 
@@ -63,4 +217,4 @@ protected:
 
 
 
-#endif
\ No newline at end of file
+#endif
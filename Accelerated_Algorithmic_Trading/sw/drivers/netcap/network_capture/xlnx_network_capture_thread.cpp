@@ -123,26 +123,134 @@ uint32_t NetworkCapture::GetPollRate(uint32_t* pMilliseconds)
 
 
 
-uint32_t NetworkCapture::GetTailChunkIndex(uint32_t* pChunkIndex)
+uint32_t NetworkCapture::SetFileBufferSize(uint32_t numBytes)
+{
+    return m_pcapWriter.SetBufferSize(numBytes);
+}
+
+
+
+
+uint32_t NetworkCapture::GetFileBufferSize(uint32_t* pNumBytes)
+{
+    return m_pcapWriter.GetBufferSize(pNumBytes);
+}
+
+
+
+
+uint32_t NetworkCapture::SetFileDirectIO(bool bEnabled)
+{
+    return m_pcapWriter.SetDirectIO(bEnabled);
+}
+
+
+
+
+uint32_t NetworkCapture::GetFileDirectIO(bool* pbEnabled)
+{
+    return m_pcapWriter.GetDirectIO(pbEnabled);
+}
+
+
+
+
+uint32_t NetworkCapture::SetFileFlushTimeout(uint32_t milliseconds)
+{
+    return m_pcapWriter.SetFlushTimeout(milliseconds);
+}
+
+
+
+
+uint32_t NetworkCapture::GetFileFlushTimeout(uint32_t* pMilliseconds)
+{
+    return m_pcapWriter.GetFlushTimeout(pMilliseconds);
+}
+
+
+
+
+uint32_t NetworkCapture::SetFileSegmentSize(uint32_t megabytes)
+{
+    return m_pcapWriter.SetSegmentSize(megabytes);
+}
+
+
+
+
+uint32_t NetworkCapture::GetFileSegmentSize(uint32_t* pMegabytes)
+{
+    return m_pcapWriter.GetSegmentSize(pMegabytes);
+}
+
+
+
+
+uint32_t NetworkCapture::SetFileSegmentDuration(uint32_t seconds)
+{
+    return m_pcapWriter.SetSegmentDuration(seconds);
+}
+
+
+
+
+uint32_t NetworkCapture::GetFileSegmentDuration(uint32_t* pSeconds)
+{
+    return m_pcapWriter.GetSegmentDuration(pSeconds);
+}
+
+
+
+
+uint32_t NetworkCapture::SetFileIndexInterval(uint32_t numPackets)
+{
+    return m_pcapWriter.SetIndexInterval(numPackets);
+}
+
+
+
+
+uint32_t NetworkCapture::GetFileIndexInterval(uint32_t* pNumPackets)
+{
+    return m_pcapWriter.GetIndexInterval(pNumPackets);
+}
+
+
+
+
+uint32_t NetworkCapture::GetFileWriterStats(PCAPWriter::Stats* pStats)
+{
+    return m_pcapWriter.GetStats(pStats);
+}
+
+
+
+
+uint32_t NetworkCapture::GetTailByteOffset(uint32_t* pByteOffset)
 {
     uint32_t retval = XLNX_OK;
     uint32_t tailPointer;
-    uint32_t byteOffset;
 
     retval = GetTailPointer(&tailPointer);
 
 
     if (retval == XLNX_OK)
     {
-        //NOTE - the HW tail pointer increments for every 64 bytes written to card RAM.
-        //       This means that if a packet is in the middle of being written to card RAM,
-        //       the pointer could be mid-way through a chunk.
-        //       
-        //       We want to disregard any partially written chunks.  This can be taken care
-        //       of by performing an INTEGER DIVISION... 
-
-        byteOffset = tailPointer * XLNX_NETWORK_CAPTURE_TAIL_POINTER_MULTIPLIER;
-        *pChunkIndex = byteOffset / CHUNK_SIZE;
+        //NOTE - the HW tail pointer increments for every 64 bytes written to card RAM,
+        //       but is only moved on once a whole record has been written.  This means
+        //       it never points part way through a record that is still being written.
+
+        *pByteOffset = tailPointer * XLNX_NETWORK_CAPTURE_TAIL_POINTER_MULTIPLIER;
+
+
+        //NOTE - a legacy kernel moves the pointer on as each 64 bytes is written, so if a packet is in
+        //       the middle of being written the pointer could be mid-way through a chunk.  We want to
+        //       disregard any partially written chunk, which is taken care of by rounding down...
+        if ((m_capabilities & CAPABILITY_PACKED_RECORDS) == 0)
+        {
+            *pByteOffset = (*pByteOffset / LEGACY_CHUNK_SIZE) * LEGACY_CHUNK_SIZE;
+        }
     }
     
 
@@ -152,54 +260,172 @@ uint32_t NetworkCapture::GetTailChunkIndex(uint32_t* pChunkIndex)
 
 
 
+uint32_t NetworkCapture::TransferRecords(uint32_t startByteOffset, uint32_t numBytes)
+{
+    uint32_t retval = XLNX_OK;
+
+    //NOTE - Only need to do a sync if kernel is connected to CARD-RAM
+    if (m_bUsingHostBank == false)
+    {
+        retval = m_pDeviceInterface->SyncBuffer(m_pBufferDescriptor, DeviceInterface::SyncDirection::FROM_DEVICE, numBytes, startByteOffset);
+    }
+
 
+    if (retval == XLNX_OK)
+    {
+        if (m_capabilities & CAPABILITY_PACKED_RECORDS)
+        {
+            retval = WritePacketsToPCAPFile(startByteOffset, numBytes);
+        }
+        else
+        {
+            retval = WriteLegacyChunksToPCAPFile(startByteOffset, numBytes);
+        }
+    }
 
-uint32_t NetworkCapture::WritePacketsToPCAPFile(uint32_t chunkStartIndex, uint32_t numChunks)
+    return retval;
+}
+
+
+
+
+
+
+uint32_t NetworkCapture::WritePacketsToPCAPFile(uint32_t startByteOffset, uint32_t numBytes)
 {
     uint32_t retval = XLNX_OK;
-    PacketMetadata metadata;
-    uint32_t* pWordBuffer;
-    uint32_t chunkStartByteOffset;
-    uint32_t metadataByteOffset;
+    PacketRecordHeader header;
+    uint8_t* pByteBuffer;
+    uint32_t recordByteOffset;
+    uint32_t endByteOffset;
+    uint32_t recordLengthInBytes;
+    uint32_t wireLengthInBytes;
     uint8_t* pPacketData;
     uint64_t timestampClockCycles;
     uint64_t timestampNanoseconds;
 
 
 
-    pWordBuffer = (uint32_t*)m_bufferHostVirtualAddress;
+    pByteBuffer = (uint8_t*)m_bufferHostVirtualAddress;
+
+    recordByteOffset    = startByteOffset;
+    endByteOffset       = startByteOffset + numBytes;
 
-    for (uint32_t i = 0; i < numChunks; i++)
+    while (recordByteOffset < endByteOffset)
     {
-        chunkStartByteOffset    = ((chunkStartIndex + i) * CHUNK_SIZE);
-        metadataByteOffset      = (chunkStartByteOffset + XLNX_NETWORK_CAPTURE_METADATA_OFFSET);
+        header = *(PacketRecordHeader*)&pByteBuffer[recordByteOffset];
 
-        metadata.packetLengthInBytes    = pWordBuffer[(metadataByteOffset / 4) + 0];
-        metadata.packetNum              = pWordBuffer[(metadataByteOffset / 4) + 1];
-        metadata.timestampLower         = pWordBuffer[(metadataByteOffset / 4) + 2]; 
-        metadata.timestampUpper         = pWordBuffer[(metadataByteOffset / 4) + 3];
+        recordLengthInBytes = header.recordLengthInWords * XLNX_NETWORK_CAPTURE_RECORD_ALIGNMENT;
 
-        timestampClockCycles = (((uint64_t)metadata.timestampUpper) << 32) | metadata.timestampLower;
 
-        //The current HW timestamp counter increments every 4 clock cycles
-        //so we need to multiply by 4 to get the correct time.
-        timestampClockCycles = timestampClockCycles * TIMESTAMP_CLOCKS_MULTIPLIER;
+        //A header that does not describe a sensible record means the HW has lapped us and overwritten
+        //data we had not yet read.  There is no way to find the next record boundary, so the rest of
+        //this region is discarded and we pick up again from the current tail.
+        if ((recordLengthInBytes == 0) ||
+            (recordLengthInBytes > (endByteOffset - recordByteOffset)) ||
+            (((header.flags & XLNX_NETWORK_CAPTURE_RECORD_FLAG_PAD) == 0) && ((sizeof(header) + header.packetLengthInBytes) > recordLengthInBytes)))
+        {
+            m_numDiscardedRecords++;
+            break; //out of loop
+        }
 
-        ConvertClockCyclesToNanoseconds(timestampClockCycles, &timestampNanoseconds);
 
-        pPacketData = (uint8_t*)&pWordBuffer[chunkStartByteOffset / 4];
+        if ((header.flags & XLNX_NETWORK_CAPTURE_RECORD_FLAG_PAD) == 0)
+        {
+            timestampClockCycles = (((uint64_t)header.timestampUpper) << 32) | header.timestampLower;
 
-        retval = m_pcapWriter.WritePacket(pPacketData, metadata.packetLengthInBytes, timestampNanoseconds);
+            //The current HW timestamp counter increments every 4 clock cycles
+            //so we need to multiply by 4 to get the correct time.
+            timestampClockCycles = timestampClockCycles * TIMESTAMP_CLOCKS_MULTIPLIER;
 
-        if (retval == XLNX_OK)
-        {
-            m_numCapturedPackets++;
+            ConvertClockCyclesToNanoseconds(timestampClockCycles, &timestampNanoseconds);
+
+            pPacketData = &pByteBuffer[recordByteOffset + sizeof(header)];
+
+            wireLengthInBytes = header.wireLengthInBytes;
+            if (wireLengthInBytes < header.packetLengthInBytes)
+            {
+                wireLengthInBytes = header.packetLengthInBytes; //packet was not truncated by a snap length
+            }
+
+            retval = m_pcapWriter.WritePacket(pPacketData, header.packetLengthInBytes, wireLengthInBytes, timestampNanoseconds);
+
+            if (retval == XLNX_OK)
+            {
+                m_numCapturedPackets++;
+            }
+
+            if (retval != XLNX_OK)
+            {
+                break; //out of loop
+            }
         }
 
-        if (retval != XLNX_OK)
+        recordByteOffset += recordLengthInBytes;
+    }
+
+
+
+    return retval;
+}
+
+
+
+
+uint32_t NetworkCapture::WriteLegacyChunksToPCAPFile(uint32_t startByteOffset, uint32_t numBytes)
+{
+    uint32_t retval = XLNX_OK;
+    LegacyPacketMetadata metadata;
+    uint8_t* pByteBuffer;
+    uint32_t chunkByteOffset;
+    uint32_t endByteOffset;
+    uint8_t* pPacketData;
+    uint64_t timestampClockCycles;
+    uint64_t timestampNanoseconds;
+
+
+
+    pByteBuffer = (uint8_t*)m_bufferHostVirtualAddress;
+
+    chunkByteOffset     = startByteOffset;
+    endByteOffset       = startByteOffset + numBytes;
+
+    while (chunkByteOffset < endByteOffset)
+    {
+        metadata = *(LegacyPacketMetadata*)&pByteBuffer[chunkByteOffset + XLNX_NETWORK_CAPTURE_LEGACY_METADATA_OFFSET];
+
+
+        //a length that runs into the metadata means the HW has overwritten the chunk while we were reading it
+        if (metadata.packetLengthInBytes > XLNX_NETWORK_CAPTURE_LEGACY_METADATA_OFFSET)
         {
-            break; //out of loop
+            m_numDiscardedRecords++;
         }
+        else
+        {
+            timestampClockCycles = (((uint64_t)metadata.timestampUpper) << 32) | metadata.timestampLower;
+
+            //The current HW timestamp counter increments every 4 clock cycles
+            //so we need to multiply by 4 to get the correct time.
+            timestampClockCycles = timestampClockCycles * TIMESTAMP_CLOCKS_MULTIPLIER;
+
+            ConvertClockCyclesToNanoseconds(timestampClockCycles, &timestampNanoseconds);
+
+            pPacketData = &pByteBuffer[chunkByteOffset];
+
+            retval = m_pcapWriter.WritePacket(pPacketData, metadata.packetLengthInBytes, timestampNanoseconds);
+
+            if (retval == XLNX_OK)
+            {
+                m_numCapturedPackets++;
+            }
+
+            if (retval != XLNX_OK)
+            {
+                break; //out of loop
+            }
+        }
+
+        chunkByteOffset += LEGACY_CHUNK_SIZE;
     }
 
 
@@ -214,11 +440,8 @@ void NetworkCapture::ThreadFunc(void)
 {
     uint32_t retval = XLNX_OK;
     PCAPWriter pcapWriter;
-    uint32_t lastChunkIndex;
-    uint32_t currentChunkIndex;
-    uint32_t numChunksToTransfer;
-    uint32_t numBytesToTransfer;
-    uint32_t startOffset;
+    uint32_t lastByteOffset;
+    uint32_t currentByteOffset;
 
 #ifdef XCL_EMULATION_MODE
     std::chrono::time_point<std::chrono::system_clock> currentTime = std::chrono::system_clock::now();
@@ -227,10 +450,11 @@ void NetworkCapture::ThreadFunc(void)
 
 
     m_numCapturedPackets = 0;
+    m_numDiscardedRecords = 0;
 
 
-    //NOTE - chunk indexes refer to the "next free" location that will be written to by the HW...
-    retval = GetTailChunkIndex(&lastChunkIndex);
+    //NOTE - byte offsets refer to the "next free" location that will be written to by the HW...
+    retval = GetTailByteOffset(&lastByteOffset);
 
 
     
@@ -265,104 +489,51 @@ void NetworkCapture::ThreadFunc(void)
 
 
 
-            retval = GetTailChunkIndex(&currentChunkIndex);
+            retval = GetTailByteOffset(&currentByteOffset);
 
             if (retval == XLNX_OK)
             {
-                if (currentChunkIndex != lastChunkIndex)
+                if (currentByteOffset != lastByteOffset)
                 {
                     //we have new packets...
 
 
-                    if (currentChunkIndex > lastChunkIndex)
+                    if (currentByteOffset > lastByteOffset)
                     {
-                        numChunksToTransfer = currentChunkIndex - lastChunkIndex;
-
-
-                        //NOTE - Only need to do a sync if kernel is connected to CARD-RAM
-                        if (m_bUsingHostBank == false)
-                        {
-                            startOffset = lastChunkIndex * CHUNK_SIZE;
-                            numBytesToTransfer = numChunksToTransfer * CHUNK_SIZE;
-
-                            retval = m_pDeviceInterface->SyncBuffer(m_pBufferDescriptor, DeviceInterface::SyncDirection::FROM_DEVICE, numBytesToTransfer, startOffset);
-                        }
-                 
-
-                        if (retval == XLNX_OK)
-                        {
-                            retval = WritePacketsToPCAPFile(lastChunkIndex, numChunksToTransfer);
-                        }
-
-
-
+                        retval = TransferRecords(lastByteOffset, currentByteOffset - lastByteOffset);
                     }
-                    else if (currentChunkIndex < lastChunkIndex)
+                    else if (currentByteOffset < lastByteOffset)
                     {
                         //the buffer has wrapped around...we may need to do 2 transfers...
 
+                        //first transfer is from last offset to end of buffer....
+                        retval = TransferRecords(lastByteOffset, m_bufferSize - lastByteOffset);
 
-                        //first transfer is from last index to end of buffer....
-                        numChunksToTransfer = NUM_CHUNKS - lastChunkIndex;
 
-
-                        //NOTE - Only need to do a sync if kernel is connected to CARD-RAM
-                        if (m_bUsingHostBank == false)
-                        {
-                            startOffset = lastChunkIndex * CHUNK_SIZE;
-                            numBytesToTransfer = numChunksToTransfer * CHUNK_SIZE;
-
-                            retval = m_pDeviceInterface->SyncBuffer(m_pBufferDescriptor, DeviceInterface::SyncDirection::FROM_DEVICE, numBytesToTransfer, startOffset);
-                        }
-
-
-                        
-                        if (retval == XLNX_OK)
-                        {
-                            retval = WritePacketsToPCAPFile(lastChunkIndex, numChunksToTransfer);
-                        }
-
-
-
-
-
-                        if (retval == XLNX_OK)
+                        //second transfer is from start of buffer to current offset...
+                        if ((retval == XLNX_OK) && (currentByteOffset > 0))
                         {
-                            //second transfer if from start of buffer to current index...
-
-                            numChunksToTransfer = currentChunkIndex;
-
-                            if (numBytesToTransfer > 0)
-                            {
-
-                                //NOTE - Only need to do a sync if kernel is connected to CARD-RAM
-                                if (m_bUsingHostBank == false)
-                                {
-                                    startOffset = 0;
-                                    numBytesToTransfer = numChunksToTransfer * CHUNK_SIZE;
-
-                                    retval = m_pDeviceInterface->SyncBuffer(m_pBufferDescriptor, DeviceInterface::SyncDirection::FROM_DEVICE, numBytesToTransfer, startOffset);
-                                }
-
-                                if (retval == XLNX_OK)
-                                {
-                                    retval = WritePacketsToPCAPFile(0, numChunksToTransfer);
-                                }
-                            }
+                            retval = TransferRecords(0, currentByteOffset);
                         }
-
                     }
 
 
 
-                    //finally update our position index so we know where to start next time...
-                    lastChunkIndex = currentChunkIndex;
+                    //finally update our position so we know where to start next time...
+                    lastByteOffset = currentByteOffset;
                     
                 }
                 
             }
 
 
+            //make sure buffered packets still reach the file when traffic is sparse
+            if (retval == XLNX_OK)
+            {
+                retval = m_pcapWriter.CheckFlushTimeout();
+            }
+
+
             if (m_pollRateMilliseconds > 0)
             {
                 std::this_thread::sleep_for(std::chrono::milliseconds(m_pollRateMilliseconds));
@@ -38,6 +38,34 @@ static const char* LINE_STRING = "----------------------------------------------
 
 
 
+//Each kernel driver has its own LatencySummary type, all with the same fields
+#define COPY_LATENCY_SUMMARY(DST, SRC)  {                                           \
+                                            (DST).numSamples = (SRC).numSamples;    \
+                                            (DST).minLatency = (SRC).minLatency;    \
+                                            (DST).maxLatency = (SRC).maxLatency;    \
+                                            (DST).totalLatency = (SRC).totalLatency;\
+                                        }
+
+
+typedef struct
+{
+    uint32_t numSamples;
+    uint32_t minLatency;
+    uint32_t maxLatency;
+    uint64_t totalLatency;
+}AATLatencyProbe;
+
+
+typedef struct
+{
+    const char* name;
+    bool bValid;
+    AATLatencyProbe ingress;
+    AATLatencyProbe egress;
+}AATLatencyStage;
+
+
+
 
 
 
@@ -131,6 +159,9 @@ static int AAT_GetStatusCommand(Shell* pShell, int argc, char* argv[], void* pOb
     pAAT->pricingEngine.IsInitialised(&bIsInitialised);
     AAT_PrintInitialisedTableRow(pShell, (char*)"Pricing Engine", bIsInitialised);
 
+    pAAT->riskEngine.IsInitialised(&bIsInitialised);
+    AAT_PrintInitialisedTableRow(pShell, (char*)"Risk Engine", bIsInitialised);
+
     pAAT->orderEntry.IsInitialised(&bIsInitialised);
     AAT_PrintInitialisedTableRow(pShell, (char*)"Order Entry", bIsInitialised);
 
@@ -308,6 +339,159 @@ static int AAT_StopCapture(Shell* pShell, int argc, char* argv[], void* pObjectD
 
 
 
+static double AAT_GetMeanLatency(AATLatencyProbe* pProbe)
+{
+    double mean = 0.0;
+
+    if (pProbe->numSamples > 0)
+    {
+        mean = (double)pProbe->totalLatency / pProbe->numSamples;
+    }
+
+    return mean;
+}
+
+
+
+
+
+
+static void AAT_PrintLatencyProbeRow(Shell* pShell, const char* stageName, const char* probeName, AATLatencyProbe* pProbe, const char* deltaString)
+{
+    pShell->printf("| %-16s | %-7s | %10u | %10u | %10.1f | %10u | %10s |\n",
+                   stageName,
+                   probeName,
+                   pProbe->numSamples,
+                   (pProbe->numSamples > 0) ? pProbe->minLatency : 0,
+                   AAT_GetMeanLatency(pProbe),
+                   pProbe->maxLatency,
+                   deltaString);
+}
+
+
+
+
+
+
+static int AAT_GetLatencyCommand(Shell* pShell, int argc, char* argv[], void* pObjectData)
+{
+    int retval = 0;
+    AAT* pAAT = (AAT*)pObjectData;
+    LineHandler::Stats lineHandlerStats;
+    FeedHandler::Stats feedHandlerStats;
+    OrderBook::Stats orderBookStats;
+    PricingEngine::Stats pricingEngineStats;
+    RiskEngine::Stats riskEngineStats;
+    OrderEntry::Stats orderEntryStats;
+    AATLatencyStage stages[6];
+    char deltaString[32];
+    uint32_t numStages = sizeof(stages) / sizeof(stages[0]);
+    uint32_t i;
+
+    XLNX_UNUSED_ARG(argc);
+    XLNX_UNUSED_ARG(argv);
+
+    //stages in the order a packet flows through the pipeline, all probes measure cycles from the
+    //LineHandler port filter timestamp...each kernel runs its own time base from its own reset, so
+    //outside the LineHandler the values carry an unknown offset.  Only the egress - ingress delta of
+    //the same kernel cancels it, deltas between kernels would not and are not shown
+    stages[0].name = "Line Handler";
+    stages[0].bValid = (pAAT->lineHandler.GetStats(&lineHandlerStats) == XLNX_OK);
+    COPY_LATENCY_SUMMARY(stages[0].ingress, lineHandlerStats.ingressLatency);
+    COPY_LATENCY_SUMMARY(stages[0].egress, lineHandlerStats.egressLatency);
+
+    stages[1].name = "Feed Handler";
+    stages[1].bValid = (pAAT->feedHandler.GetStats(&feedHandlerStats) == XLNX_OK);
+    COPY_LATENCY_SUMMARY(stages[1].ingress, feedHandlerStats.ingressLatency);
+    COPY_LATENCY_SUMMARY(stages[1].egress, feedHandlerStats.egressLatency);
+
+    stages[2].name = "Order Book";
+    stages[2].bValid = (pAAT->orderBook.GetStats(&orderBookStats) == XLNX_OK);
+    COPY_LATENCY_SUMMARY(stages[2].ingress, orderBookStats.ingressLatency);
+    COPY_LATENCY_SUMMARY(stages[2].egress, orderBookStats.egressLatency);
+
+    stages[3].name = "Pricing Engine";
+    stages[3].bValid = (pAAT->pricingEngine.GetStats(&pricingEngineStats) == XLNX_OK);
+    COPY_LATENCY_SUMMARY(stages[3].ingress, pricingEngineStats.ingressLatency);
+    COPY_LATENCY_SUMMARY(stages[3].egress, pricingEngineStats.egressLatency);
+
+    stages[4].name = "Risk Engine";
+    stages[4].bValid = (pAAT->riskEngine.GetStats(&riskEngineStats) == XLNX_OK);
+    COPY_LATENCY_SUMMARY(stages[4].ingress, riskEngineStats.ingressLatency);
+    COPY_LATENCY_SUMMARY(stages[4].egress, riskEngineStats.egressLatency);
+
+    stages[5].name = "Order Entry";
+    stages[5].bValid = (pAAT->orderEntry.GetStats(&orderEntryStats) == XLNX_OK);
+    COPY_LATENCY_SUMMARY(stages[5].ingress, orderEntryStats.ingressLatency);
+    COPY_LATENCY_SUMMARY(stages[5].egress, orderEntryStats.egressLatency);
+
+
+    pShell->printf("\n");
+    pShell->printf("Cycles from packet arrival at the LineHandler port filter, against the time base of each kernel.\n");
+    pShell->printf("Kernel time bases are not synchronised, so outside the Line Handler the values include a fixed\n");
+    pShell->printf("unknown offset and only the Delta (time spent inside the stage, egress - ingress) is comparable.\n");
+    pShell->printf("Deltas are approximate to within a few cycles per probe, probes read the kernel time base up to\n");
+    pShell->printf("the depth of its FIFO late and ingress probes also sample messages later dropped or rejected.\n");
+    pShell->printf("+-%.16s-+-%.7s-+-%.10s-+-%.10s-+-%.10s-+-%.10s-+-%.10s-+\n", LINE_STRING, LINE_STRING, LINE_STRING, LINE_STRING, LINE_STRING, LINE_STRING, LINE_STRING);
+    pShell->printf("| %-16s | %-7s | %10s | %10s | %10s | %10s | %10s |\n", "Stage", "Probe", "Samples", "Min", "Mean", "Max", "Delta");
+    pShell->printf("+-%.16s-+-%.7s-+-%.10s-+-%.10s-+-%.10s-+-%.10s-+-%.10s-+\n", LINE_STRING, LINE_STRING, LINE_STRING, LINE_STRING, LINE_STRING, LINE_STRING, LINE_STRING);
+
+    for (i = 0; i < numStages; i++)
+    {
+        if (stages[i].bValid)
+        {
+            snprintf(deltaString, sizeof(deltaString), "%+.1f", AAT_GetMeanLatency(&stages[i].egress) - AAT_GetMeanLatency(&stages[i].ingress));
+
+            AAT_PrintLatencyProbeRow(pShell, stages[i].name, "ingress", &stages[i].ingress, "-");
+            AAT_PrintLatencyProbeRow(pShell, "", "egress", &stages[i].egress, deltaString);
+        }
+        else
+        {
+            pShell->printf("| %-16s | %-7s | %10s | %10s | %10s | %10s | %10s |\n", stages[i].name, "-", "n/a", "n/a", "n/a", "n/a", "n/a");
+        }
+    }
+
+    pShell->printf("+-%.16s-+-%.7s-+-%.10s-+-%.10s-+-%.10s-+-%.10s-+-%.10s-+\n", LINE_STRING, LINE_STRING, LINE_STRING, LINE_STRING, LINE_STRING, LINE_STRING, LINE_STRING);
+
+    return retval;
+}
+
+
+
+
+
+
+static int AAT_ResetLatencyCommand(Shell* pShell, int argc, char* argv[], void* pObjectData)
+{
+    int retval = 0;
+    AAT* pAAT = (AAT*)pObjectData;
+
+    XLNX_UNUSED_ARG(argc);
+    XLNX_UNUSED_ARG(argv);
+
+    //kernels that are not present are skipped, so the individual results are not checked
+    pAAT->lineHandler.ResetLatencyHistogram();
+    pAAT->feedHandler.ResetLatencyHistogram();
+    pAAT->orderBook.ResetLatencyHistogram();
+    pAAT->pricingEngine.ResetLatencyHistogram();
+    pAAT->riskEngine.ResetLatencyHistogram();
+    pAAT->orderEntry.ResetLatencyHistogram();
+
+    pShell->printf("OK\n");
+
+    return retval;
+}
+
+
+
+
+
+
+
+
+
+
+
 CommandTableElement XLNX_AAT_COMMAND_TABLE[] =
 {
     {"getstatus",       AAT_GetStatusCommand,           "",                 "Get the status of the individual objects"      },
@@ -317,6 +501,9 @@ CommandTableElement XLNX_AAT_COMMAND_TABLE[] =
     {/*-------------------------------------------------------------------------------------------------------------------*/},
     {"startcapture",    AAT_StartCapture,               "<filepath>",       "Starts capturing packets to specified file"    },
     {"stopcapture",     AAT_StopCapture,                "",                 "Stop capturing packets"                        },
+    {/*-------------------------------------------------------------------------------------------------------------------*/},
+    {"latency",         AAT_GetLatencyCommand,          "",                 "Print per-stage latency waterfall"             },
+    {"resetlatency",    AAT_ResetLatencyCommand,        "",                 "Reset latency histograms in all kernels"       },
 };
 
 
@@ -27,6 +27,7 @@
 #include "xlnx_shell_order_book_data_mover.h"
 #include "xlnx_shell_order_entry.h"
 #include "xlnx_shell_pricing_engine.h"
+#include "xlnx_shell_risk_engine.h"
 #include "xlnx_shell_tcp_udp_ip.h"
 #include "xlnx_shell_clock_tick_generator.h"
 #include "xlnx_shell_line_handler.h"
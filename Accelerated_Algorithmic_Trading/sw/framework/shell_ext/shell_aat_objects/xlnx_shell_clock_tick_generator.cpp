@@ -58,6 +58,8 @@ static char* ClockTickGenerator_ErrorCodeToString(uint32_t errorCode)
         STR_CASE(XLNX_CLOCK_TICK_GENERATOR_ERROR_CU_INDEX_NOT_FOUND)
         STR_CASE(XLNX_CLOCK_TICK_GENERATOR_ERROR_STREAM_INDEX_OUT_OF_RANGE)
         STR_CASE(XLNX_CLOCK_TICK_GENERATOR_ERROR_INTERVAL_TOO_LARGE)
+        STR_CASE(XLNX_CLOCK_TICK_GENERATOR_ERROR_TIMER_INDEX_OUT_OF_RANGE)
+        STR_CASE(XLNX_CLOCK_TICK_GENERATOR_ERROR_TIMER_TARGET_OUT_OF_RANGE)
 
 
         default:
@@ -204,6 +206,168 @@ static int ClockTickGenerator_SetInterval(Shell* pShell, int argc, char* argv[],
 
 
 
+static int ClockTickGenerator_ArmTimer(Shell* pShell, int argc, char* argv[], void* pObjectData)
+{
+    int retval = 0;
+    bool bOKToContinue = true;
+    ClockTickGenerator* pClockTickGen = (ClockTickGenerator*)pObjectData;
+    uint32_t timerIndex;
+    uint32_t microseconds;
+    uint32_t target;
+    uint32_t symbolIndex;
+    uint32_t eventCode;
+    bool bPeriodic;
+
+
+    if (argc != 7)
+    {
+        pShell->printf("Usage: %s <timer> <usecs> <target> <symbol> <code> <periodic>\n", argv[0]);
+        bOKToContinue = false;
+    }
+
+
+    if (bOKToContinue)
+    {
+        bOKToContinue = pShell->parseUInt32(argv[1], &timerIndex);
+        if (bOKToContinue == false)
+        {
+            pShell->printf("[ERROR] Failed to parse timer index parameter");
+        }
+    }
+
+
+    if (bOKToContinue)
+    {
+        bOKToContinue = pShell->parseUInt32(argv[2], &microseconds);
+        if (bOKToContinue == false)
+        {
+            pShell->printf("[ERROR] Failed to parse timer interval parameter");
+        }
+    }
+
+
+    if (bOKToContinue)
+    {
+        bOKToContinue = pShell->parseUInt32(argv[3], &target);
+        if (bOKToContinue == false)
+        {
+            pShell->printf("[ERROR] Failed to parse target parameter");
+        }
+    }
+
+
+    if (bOKToContinue)
+    {
+        bOKToContinue = pShell->parseUInt32(argv[4], &symbolIndex);
+        if (bOKToContinue == false)
+        {
+            pShell->printf("[ERROR] Failed to parse symbol index parameter");
+        }
+    }
+
+
+    if (bOKToContinue)
+    {
+        bOKToContinue = pShell->parseUInt32(argv[5], &eventCode);
+        if (bOKToContinue == false)
+        {
+            pShell->printf("[ERROR] Failed to parse event code parameter");
+        }
+    }
+
+
+    if (bOKToContinue)
+    {
+        bOKToContinue = pShell->parseBool(argv[6], &bPeriodic);
+        if (bOKToContinue == false)
+        {
+            pShell->printf("[ERROR] Failed to parse periodic parameter");
+        }
+    }
+
+
+    if (bOKToContinue)
+    {
+        retval = pClockTickGen->ArmTimer(timerIndex, microseconds, target, symbolIndex, eventCode, bPeriodic);
+
+        if (retval == XLNX_OK)
+        {
+            pShell->printf("OK\n");
+        }
+        else
+        {
+            pShell->printf("[ERROR] %s (0x%08X)\n", ClockTickGenerator_ErrorCodeToString(retval), retval);
+        }
+    }
+
+    if (bOKToContinue == false)
+    {
+        retval = Shell::COMMAND_PARSING_ERROR;
+    }
+
+
+    return retval;
+}
+
+
+
+
+static int ClockTickGenerator_CancelTimer(Shell* pShell, int argc, char* argv[], void* pObjectData)
+{
+    int retval = 0;
+    bool bOKToContinue = true;
+    ClockTickGenerator* pClockTickGen = (ClockTickGenerator*)pObjectData;
+    uint32_t timerIndex;
+
+
+    if (argc != 2)
+    {
+        pShell->printf("Usage: %s <timer>\n", argv[0]);
+        bOKToContinue = false;
+    }
+
+
+    if (bOKToContinue)
+    {
+        bOKToContinue = pShell->parseUInt32(argv[1], &timerIndex);
+        if (bOKToContinue == false)
+        {
+            pShell->printf("[ERROR] Failed to parse timer index parameter");
+        }
+    }
+
+
+    if (bOKToContinue)
+    {
+        retval = pClockTickGen->CancelTimer(timerIndex);
+
+        if (retval == XLNX_OK)
+        {
+            pShell->printf("OK\n");
+        }
+        else
+        {
+            pShell->printf("[ERROR] %s (0x%08X)\n", ClockTickGenerator_ErrorCodeToString(retval), retval);
+        }
+    }
+
+    if (bOKToContinue == false)
+    {
+        retval = Shell::COMMAND_PARSING_ERROR;
+    }
+
+
+    return retval;
+}
+
+
+
+
+
+
+
+
+
 static int ClockTickGenerator_GetStatus(Shell* pShell, int argc, char* argv[], void* pObjectData)
 {
     int retval = 0;
@@ -213,6 +377,7 @@ static int ClockTickGenerator_GetStatus(Shell* pShell, int argc, char* argv[], v
     uint32_t cuIndex;
     uint32_t clockFreqMHz;
     ClockTickGenerator::Stats stats;
+    ClockTickGenerator::TimerStats timerStats;
     bool bTickEnabled;
     uint32_t tickIntervalMicroseconds;
     uint32_t tickIntervalClockCycles;
@@ -347,6 +512,25 @@ static int ClockTickGenerator_GetStatus(Shell* pShell, int argc, char* argv[], v
 
 
 
+    if (retval == XLNX_OK)
+    {
+        retval = pClockTickGen->GetTimerStats(&timerStats);
+    }
+
+
+    if (retval == XLNX_OK)
+    {
+        pShell->printf("\n");
+        pShell->printf("+-%.25s-+-%.20s-+\n", LINE_STRING, LINE_STRING);
+        pShell->printf("| %-25s | %20u |\n", "Timers Armed", timerStats.numArmed);
+        pShell->printf("| %-25s | %20u |\n", "Timers Cancelled", timerStats.numCancelled);
+        pShell->printf("| %-25s | %20u |\n", "Timer Events Fired", timerStats.numFired);
+        pShell->printf("| %-25s | %20u |\n", "Timer Events Dropped", timerStats.numDropped);
+        pShell->printf("+-%.25s-+-%.20s-+\n", LINE_STRING, LINE_STRING);
+    }
+
+
+
     if (retval != XLNX_OK)
     {
         pShell->printf("[ERROR] retval = %s (0x%08X)\n", ClockTickGenerator_ErrorCodeToString(retval), retval);
@@ -368,6 +552,8 @@ CommandTableElement XLNX_CLOCK_TICK_GENERATOR_COMMAND_TABLE[] =
 {
     {"setenable",           ClockTickGenerator_SetEnable,               "<index> <bool>",               "Enable/disable a tick stream"      },
     {"setinterval",         ClockTickGenerator_SetInterval,             "<index> <usecs>",              "Set the tick event interval"       },
+    {"armtimer",            ClockTickGenerator_ArmTimer,                "<timer> <usecs> <target> <symbol> <code> <periodic>", "Arm a timer wheel slot" },
+    {"canceltimer",         ClockTickGenerator_CancelTimer,             "<timer>",                      "Cancel a timer wheel slot"         },
     {/*-----------------------------------------------------------------------------------------------------------------------------------*/},
     {"getstatus",	        ClockTickGenerator_GetStatus,			    "",					            "Get block status"			        },
     
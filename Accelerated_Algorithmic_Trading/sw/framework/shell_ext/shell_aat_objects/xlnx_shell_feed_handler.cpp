@@ -57,6 +57,7 @@ static char* FeedHandler_ErrorCodeToString(uint32_t errorCode)
         STR_CASE(XLNX_FEED_HANDLER_ERROR_SECURITY_INDEX_OUT_OF_RANGE)
         STR_CASE(XLNX_FEED_HANDLER_ERROR_NO_SECURITY_AT_SPECIFIED_INDEX)
         STR_CASE(XLNX_FEED_HANDLER_ERROR_INVALID_SECURITY_ID)
+        STR_CASE(XLNX_FEED_HANDLER_ERROR_INVALID_PARAMETER)
 
 
         default:
@@ -733,6 +734,157 @@ static int FeedHandler_ReadData(Shell* pShell, int argc, char* argv[], void* pOb
 
 
 
+static int FeedHandler_GetLatency(Shell* pShell, int argc, char* argv[], void* pObjectData)
+{
+    int retval = 0;
+    FeedHandler* pFeedHandler = (FeedHandler*)pObjectData;
+    FeedHandler::LatencyHistogram ingressHistogram;
+    FeedHandler::LatencyHistogram egressHistogram;
+    double ingressMean = 0.0;
+    double egressMean = 0.0;
+    uint64_t binStart;
+    uint64_t binEnd;
+    char rangeString[32];
+    uint32_t i;
+
+    XLNX_UNUSED_ARG(argc);
+    XLNX_UNUSED_ARG(argv);
+
+    retval = pFeedHandler->GetIngressLatencyHistogram(&ingressHistogram);
+
+    if (retval == XLNX_OK)
+    {
+        retval = pFeedHandler->GetLatencyHistogram(&egressHistogram);
+    }
+
+    if (retval == XLNX_OK)
+    {
+        if (ingressHistogram.numSamples > 0)
+        {
+            ingressMean = (double)ingressHistogram.totalLatency / ingressHistogram.numSamples;
+        }
+
+        if (egressHistogram.numSamples > 0)
+        {
+            egressMean = (double)egressHistogram.totalLatency / egressHistogram.numSamples;
+        }
+
+        pShell->printf("\n");
+        pShell->printf("+-%.26s-+-%.10s-+-%.10s-+\n", LINE_STRING, LINE_STRING, LINE_STRING);
+        pShell->printf("| %-26s | %10s | %10s |\n", "Cycles from wire", "Ingress", "Egress");
+        pShell->printf("+-%.26s-+-%.10s-+-%.10s-+\n", LINE_STRING, LINE_STRING, LINE_STRING);
+        pShell->printf("| %-26s | %10u | %10u |\n", "Samples", ingressHistogram.numSamples, egressHistogram.numSamples);
+        pShell->printf("| %-26s | %10u | %10u |\n", "Min Latency", (ingressHistogram.numSamples > 0) ? ingressHistogram.minLatency : 0,
+                                                                 (egressHistogram.numSamples > 0) ? egressHistogram.minLatency : 0);
+        pShell->printf("| %-26s | %10u | %10u |\n", "Max Latency", ingressHistogram.maxLatency, egressHistogram.maxLatency);
+        pShell->printf("| %-26s | %10.1f | %10.1f |\n", "Mean Latency", ingressMean, egressMean);
+        pShell->printf("+-%.26s-+-%.10s-+-%.10s-+\n", LINE_STRING, LINE_STRING, LINE_STRING);
+
+        //both probes share the bin width set via setlatencybin
+        for (i = 0; i < XLNX_FEED_HANDLER_NUM_LATENCY_BINS; i++)
+        {
+            binStart = (uint64_t)i << egressHistogram.binShift;
+            binEnd = ((uint64_t)(i + 1) << egressHistogram.binShift) - 1;
+
+            if (i == (XLNX_FEED_HANDLER_NUM_LATENCY_BINS - 1))
+            {
+                snprintf(rangeString, sizeof(rangeString), "%llu+", (unsigned long long)binStart);
+            }
+            else
+            {
+                snprintf(rangeString, sizeof(rangeString), "%llu-%llu", (unsigned long long)binStart, (unsigned long long)binEnd);
+            }
+
+            pShell->printf("| %-26s | %10u | %10u |\n", rangeString, ingressHistogram.bins[i], egressHistogram.bins[i]);
+        }
+
+        pShell->printf("+-%.26s-+-%.10s-+-%.10s-+\n", LINE_STRING, LINE_STRING, LINE_STRING);
+    }
+    else
+    {
+        pShell->printf("[ERROR] %s (0x%08X)\n", FeedHandler_ErrorCodeToString(retval), retval);
+    }
+
+    return retval;
+}
+
+
+
+
+
+
+static int FeedHandler_SetLatencyBin(Shell* pShell, int argc, char* argv[], void* pObjectData)
+{
+    int retval = 0;
+    FeedHandler* pFeedHandler = (FeedHandler*)pObjectData;
+    bool bOKToContinue = true;
+    uint32_t binShift;
+
+    if (argc != 2)
+    {
+        pShell->printf("Usage: %s <shift>\n", argv[0]);
+        bOKToContinue = false;
+    }
+
+    if (bOKToContinue)
+    {
+        bOKToContinue = pShell->parseUInt32(argv[1], &binShift);
+    }
+
+    if (bOKToContinue)
+    {
+        retval = pFeedHandler->SetLatencyBinShift(binShift);
+
+        if (retval == XLNX_OK)
+        {
+            pShell->printf("OK\n");
+        }
+        else
+        {
+            pShell->printf("[ERROR] %s (0x%08X)\n", FeedHandler_ErrorCodeToString(retval), retval);
+        }
+    }
+
+    if (bOKToContinue == false)
+    {
+        retval = Shell::COMMAND_PARSING_ERROR;
+    }
+
+    return retval;
+}
+
+
+
+
+
+
+static int FeedHandler_ResetLatency(Shell* pShell, int argc, char* argv[], void* pObjectData)
+{
+    int retval = 0;
+    FeedHandler* pFeedHandler = (FeedHandler*)pObjectData;
+
+    XLNX_UNUSED_ARG(argc);
+    XLNX_UNUSED_ARG(argv);
+
+    retval = pFeedHandler->ResetLatencyHistogram();
+
+    if (retval == XLNX_OK)
+    {
+        pShell->printf("OK\n");
+    }
+    else
+    {
+        pShell->printf("[ERROR] %s (0x%08X)\n", FeedHandler_ErrorCodeToString(retval), retval);
+    }
+
+    return retval;
+}
+
+
+
+
+
+
 CommandTableElement XLNX_FEED_HANDLER_COMMAND_TABLE[] =
 {
     {"add",			        FeedHandler_AddSecurity,			"<securityID>",	                "Add a security at first available index"   },
@@ -748,9 +900,11 @@ CommandTableElement XLNX_FEED_HANDLER_COMMAND_TABLE[] =
     {"refresh",             FeedHandler_Refresh,                "",                             "Refreshes the internal security ID cache"  },
     {"resetstats",          FeedHandler_ResetStats,             "",                             "Reset stat counters"                       },
     {/*-----------------------------------------------------------------------------------------------------------------------------------*/},
-    {"readdata",            FeedHandler_ReadData,               "",                             "Read last data captured"                   }       
-
-
+    {"readdata",            FeedHandler_ReadData,               "",                             "Read last data captured"                   },
+    {/*-------------------------------------------------------------------------------------------------------------------------------*/},
+    {"getlatency",          FeedHandler_GetLatency,             "",                         "Print ingress and egress latency histograms"   },
+    {"setlatencybin",       FeedHandler_SetLatencyBin,          "<shift>",                  "Set latency bin width (1 << shift cycles)"     },
+    {"resetlatency",        FeedHandler_ResetLatency,           "",                         "Reset latency histograms"                      }
 };
 
 
@@ -94,8 +94,8 @@ static int OrderBookDataMover_GetStatus(Shell* pShell, int argc, char* argv[], v
     uint32_t headIndex;
     uint32_t tailIndex;
 
-    uint32_t throttleRate;
-    OrderBookDataMover::ThrottleStats throttleStats;
+    uint32_t creditLimit;
+    OrderBookDataMover::CreditStats creditStats;
 
     OrderBookDataMover::DMAStats dmaH2CStats;
     OrderBookDataMover::DMAStats dmaC2HStats;
@@ -416,23 +416,23 @@ static int OrderBookDataMover_GetStatus(Shell* pShell, int argc, char* argv[], v
 
     if (retval == XLNX_OK)
     {
-        retval = pDataMover->GetThrottleRate(&throttleRate);
+        retval = pDataMover->GetCreditLimit(&creditLimit);
 
         if (retval == XLNX_OK)
         {
-            pShell->printf("| %-35s | %20u |\n", "Throttle Rate (Clock Cycles)", throttleRate);
+            pShell->printf("| %-35s | %20u |\n", "Credit Limit (0 = Default)", creditLimit);
         }
     }
 
 
     if (retval == XLNX_OK)
     {
-        retval = pDataMover->GetThrottleStats(&throttleStats);
+        retval = pDataMover->GetCreditStats(&creditStats);
         
         if (retval == XLNX_OK)
         {
-            pShell->printf("| %-35s | %20u |\n", "Throttle Counter", throttleStats.throttleCounter);
-            pShell->printf("| %-35s | %20u |\n", "Throttle Events", throttleStats.throttleEvents);
+            pShell->printf("| %-35s | %20u |\n", "Credits Available", creditStats.creditsAvailable);
+            pShell->printf("| %-35s | %20u |\n", "Credit Stalls", creditStats.creditStalls);
         }
     }
 
@@ -851,26 +851,26 @@ static int OrderBookDataMover_ThreadYield(Shell* pShell, int argc, char* argv[],
 
 
 
-static int OrderBookDataMover_SetThrottle(Shell* pShell, int argc, char* argv[], void* pObjectData)
+static int OrderBookDataMover_SetCredits(Shell* pShell, int argc, char* argv[], void* pObjectData)
 {
     int retval = XLNX_OK;
     OrderBookDataMover* pDataMover = (OrderBookDataMover*)pObjectData;
     bool bOKToContinue = true;
-    uint32_t throttleRateClockCycles;
+    uint32_t creditLimit;
 
     if (argc != 2)
     {
-        pShell->printf("Usage: %s <clkcycles>\n", argv[0]);
+        pShell->printf("Usage: %s <limit>\n", argv[0]);
         bOKToContinue = false;
     }
 
 
     if (bOKToContinue)
     {
-        bOKToContinue = pShell->parseUInt32(argv[1], &throttleRateClockCycles);
+        bOKToContinue = pShell->parseUInt32(argv[1], &creditLimit);
         if (bOKToContinue == false)
         {
-            pShell->printf("[ERROR] Failed to parse throttle rate (clock cycles) parameter\n");
+            pShell->printf("[ERROR] Failed to parse credit limit parameter\n");
         }
     }
 
@@ -878,7 +878,7 @@ static int OrderBookDataMover_SetThrottle(Shell* pShell, int argc, char* argv[],
 
     if (bOKToContinue)
     {
-        retval = pDataMover->SetThrottleRate(throttleRateClockCycles);
+        retval = pDataMover->SetCreditLimit(creditLimit);
 
         if (retval == XLNX_OK)
         {
@@ -1017,7 +1017,7 @@ CommandTableElement XLNX_ORDER_BOOK_DATA_MOVER_COMMAND_TABLE[] =
     {"threadstart",         OrderBookDataMover_ThreadStart,         "",                         "Start the pricing engine thread"               },
     {"threadstop",          OrderBookDataMover_ThreadStop,          "",                         "Stop the princing engine thread"               },
     {"threadyield",         OrderBookDataMover_ThreadYield,         "<bool>",                   "Controls thread yielding to other threads"     },
-    {"setthrottle",         OrderBookDataMover_SetThrottle,         "<clkcycles>",              "Set the HW throttle rate on reading H2C ring"  },
+    {"setcredits",          OrderBookDataMover_SetCredits,          "<limit>",                  "Set max HW operations in flight to OE"         },
     {"resetdmastats",       OrderBookDataMover_ResetDMAStats,       "",                         "Reset DMA stats counters"                      },
     {"setdmachunksize",     OrderBookDataMover_SetDMAChunkSize,     "<numelements>",            "Sets the number of elements DMA'd at a time"   },
     {"sethwemupolldelay",   OrderBookDataMover_SetHWEmuPollDelay,   "<seconds>",                "Sets a poll delay - only used in HW emulation" }  
@@ -135,6 +135,8 @@ static int OrderEntry_PrintStats(Shell* pShell, OrderEntry* pOrderEntry)
         pShell->printf("| %-26s | %10u |\n", "Rx Meta Frames",          statsCounters.numRxMetaFrames);
         pShell->printf("| %-26s | %10u |\n", "Notifications Received",  statsCounters.numNotificationsReceived);
         pShell->printf("| %-26s | %10u |\n", "Read Requests Sent",      statsCounters.numReadRequestsSent);
+        pShell->printf("| %-26s | %10u |\n", "Rx Exec Reports",         statsCounters.numRxExecReports);
+        pShell->printf("| %-26s | %10u |\n", "Rx Exec Rejects",         statsCounters.numRxExecRejects);
         pShell->printf("+-%.26s-+-%.10s-+\n", LINE_STRING, LINE_STRING);
         pShell->printf("| %-26s | %10u |\n", "Clock Tick Events",       statsCounters.numClockTickEvents);
         pShell->printf("+-%.26s-+-%.10s-+\n", LINE_STRING, LINE_STRING);
@@ -572,6 +574,157 @@ static int OrderEntry_SetChecksumGeneration(Shell* pShell, int argc, char* argv[
 
 
 
+static int OrderEntry_GetLatency(Shell* pShell, int argc, char* argv[], void* pObjectData)
+{
+    int retval = 0;
+    OrderEntry* pOrderEntry = (OrderEntry*)pObjectData;
+    OrderEntry::LatencyHistogram ingressHistogram;
+    OrderEntry::LatencyHistogram egressHistogram;
+    double ingressMean = 0.0;
+    double egressMean = 0.0;
+    uint64_t binStart;
+    uint64_t binEnd;
+    char rangeString[32];
+    uint32_t i;
+
+    XLNX_UNUSED_ARG(argc);
+    XLNX_UNUSED_ARG(argv);
+
+    retval = pOrderEntry->GetIngressLatencyHistogram(&ingressHistogram);
+
+    if (retval == XLNX_OK)
+    {
+        retval = pOrderEntry->GetLatencyHistogram(&egressHistogram);
+    }
+
+    if (retval == XLNX_OK)
+    {
+        if (ingressHistogram.numSamples > 0)
+        {
+            ingressMean = (double)ingressHistogram.totalLatency / ingressHistogram.numSamples;
+        }
+
+        if (egressHistogram.numSamples > 0)
+        {
+            egressMean = (double)egressHistogram.totalLatency / egressHistogram.numSamples;
+        }
+
+        pShell->printf("\n");
+        pShell->printf("+-%.26s-+-%.10s-+-%.10s-+\n", LINE_STRING, LINE_STRING, LINE_STRING);
+        pShell->printf("| %-26s | %10s | %10s |\n", "Cycles from wire", "Ingress", "Egress");
+        pShell->printf("+-%.26s-+-%.10s-+-%.10s-+\n", LINE_STRING, LINE_STRING, LINE_STRING);
+        pShell->printf("| %-26s | %10u | %10u |\n", "Samples", ingressHistogram.numSamples, egressHistogram.numSamples);
+        pShell->printf("| %-26s | %10u | %10u |\n", "Min Latency", (ingressHistogram.numSamples > 0) ? ingressHistogram.minLatency : 0,
+                                                                 (egressHistogram.numSamples > 0) ? egressHistogram.minLatency : 0);
+        pShell->printf("| %-26s | %10u | %10u |\n", "Max Latency", ingressHistogram.maxLatency, egressHistogram.maxLatency);
+        pShell->printf("| %-26s | %10.1f | %10.1f |\n", "Mean Latency", ingressMean, egressMean);
+        pShell->printf("+-%.26s-+-%.10s-+-%.10s-+\n", LINE_STRING, LINE_STRING, LINE_STRING);
+
+        //both probes share the bin width set via setlatencybin
+        for (i = 0; i < XLNX_ORDER_ENTRY_NUM_LATENCY_BINS; i++)
+        {
+            binStart = (uint64_t)i << egressHistogram.binShift;
+            binEnd = ((uint64_t)(i + 1) << egressHistogram.binShift) - 1;
+
+            if (i == (XLNX_ORDER_ENTRY_NUM_LATENCY_BINS - 1))
+            {
+                snprintf(rangeString, sizeof(rangeString), "%llu+", (unsigned long long)binStart);
+            }
+            else
+            {
+                snprintf(rangeString, sizeof(rangeString), "%llu-%llu", (unsigned long long)binStart, (unsigned long long)binEnd);
+            }
+
+            pShell->printf("| %-26s | %10u | %10u |\n", rangeString, ingressHistogram.bins[i], egressHistogram.bins[i]);
+        }
+
+        pShell->printf("+-%.26s-+-%.10s-+-%.10s-+\n", LINE_STRING, LINE_STRING, LINE_STRING);
+    }
+    else
+    {
+        pShell->printf("[ERROR] %s (0x%08X)\n", OrderEntry_ErrorCodeToString(retval), retval);
+    }
+
+    return retval;
+}
+
+
+
+
+
+
+static int OrderEntry_SetLatencyBin(Shell* pShell, int argc, char* argv[], void* pObjectData)
+{
+    int retval = 0;
+    OrderEntry* pOrderEntry = (OrderEntry*)pObjectData;
+    bool bOKToContinue = true;
+    uint32_t binShift;
+
+    if (argc != 2)
+    {
+        pShell->printf("Usage: %s <shift>\n", argv[0]);
+        bOKToContinue = false;
+    }
+
+    if (bOKToContinue)
+    {
+        bOKToContinue = pShell->parseUInt32(argv[1], &binShift);
+    }
+
+    if (bOKToContinue)
+    {
+        retval = pOrderEntry->SetLatencyBinShift(binShift);
+
+        if (retval == XLNX_OK)
+        {
+            pShell->printf("OK\n");
+        }
+        else
+        {
+            pShell->printf("[ERROR] %s (0x%08X)\n", OrderEntry_ErrorCodeToString(retval), retval);
+        }
+    }
+
+    if (bOKToContinue == false)
+    {
+        retval = Shell::COMMAND_PARSING_ERROR;
+    }
+
+    return retval;
+}
+
+
+
+
+
+
+static int OrderEntry_ResetLatency(Shell* pShell, int argc, char* argv[], void* pObjectData)
+{
+    int retval = 0;
+    OrderEntry* pOrderEntry = (OrderEntry*)pObjectData;
+
+    XLNX_UNUSED_ARG(argc);
+    XLNX_UNUSED_ARG(argv);
+
+    retval = pOrderEntry->ResetLatencyHistogram();
+
+    if (retval == XLNX_OK)
+    {
+        pShell->printf("OK\n");
+    }
+    else
+    {
+        pShell->printf("[ERROR] %s (0x%08X)\n", OrderEntry_ErrorCodeToString(retval), retval);
+    }
+
+    return retval;
+}
+
+
+
+
+
+
 CommandTableElement XLNX_ORDER_ENTRY_COMMAND_TABLE[] =
 {
     {"getstatus",       OrderEntry_GetStatus,               "",                         "Get block status"                              },
@@ -580,8 +733,11 @@ CommandTableElement XLNX_ORDER_ENTRY_COMMAND_TABLE[] =
     {"connect",         OrderEntry_Connect,                 "<ipaddr> <port>",          "Establish connection to remote system"         },
     {"disconnect",      OrderEntry_Disconnect,              "",                         "Close connection to remote system"             },
     {"reconnect",       OrderEntry_Reconnect,               "",                         "Close and re-open existing connection"         },
-    {"setcsumgen",      OrderEntry_SetChecksumGeneration,   "<bool>",                   "Control partial checksum generation"           },    
-
+    {"setcsumgen",      OrderEntry_SetChecksumGeneration,   "<bool>",                   "Control partial checksum generation"           },
+    {/*-------------------------------------------------------------------------------------------------------------------------------*/},
+    {"getlatency",          OrderEntry_GetLatency,              "",                         "Print ingress and egress latency histograms"   },
+    {"setlatencybin",       OrderEntry_SetLatencyBin,           "<shift>",                  "Set latency bin width (1 << shift cycles)"     },
+    {"resetlatency",        OrderEntry_ResetLatency,            "",                         "Reset latency histograms"                      }
 };
 
 
@@ -31,6 +31,7 @@ static const char* LINE_STRING = "----------------------------------------------
 static const char* NONE_STRING  = "NONE";
 static const char* PEG_STRING   = "PEG";
 static const char* LIMIT_STRING = "LIMIT";
+static const char* CUSTOM_STRING = "CUSTOM";
 
 
 
@@ -176,6 +177,12 @@ static char* PricingEngine_PricingStrategyToString(PricingEngine::PricingStrateg
             break;
         }
 
+        case(PricingEngine::PricingStrategy::STRATEGY_CUSTOM):
+        {
+            pString = (char*)CUSTOM_STRING;
+            break;
+        }
+
         default:
         {
             pString = (char*)"UNKNOWN";
@@ -216,6 +223,10 @@ static bool PricingEngine_ParsePricingStrategy(char* pToken, PricingEngine::Pric
     {
         *pStrategy = PricingEngine::PricingStrategy::STRATEGY_LIMIT;
     }
+    else if (strcmp(pToken, CUSTOM_STRING) == 0)
+    {
+        *pStrategy = PricingEngine::PricingStrategy::STRATEGY_CUSTOM;
+    }
     else
     {
         bOKToContinue = false;
@@ -257,10 +268,19 @@ static int PricingEngine_PrintStats(Shell* pShell, PricingEngine* pPricingEngine
         pShell->printf("| %-26s | %10u |\n", "Strategy NONE",       statsCounters.numStrategyNone);
         pShell->printf("| %-26s | %10u |\n", "Strategy PEG",        statsCounters.numStrategyPeg);
         pShell->printf("| %-26s | %10u |\n", "Strategy LIMIT",      statsCounters.numStrategyLimit);
+        pShell->printf("| %-26s | %10u |\n", "Strategy CUSTOM",     statsCounters.numStrategyCustom);
         pShell->printf("| %-26s | %10u |\n", "Strategy UNKNOWN",    statsCounters.numStrategyUnknown);
         pShell->printf("+-%.26s-+-%.10s-+\n", LINE_STRING, LINE_STRING);
         pShell->printf("| %-26s | %10u |\n", "Clock Tick Events",    statsCounters.numClockTickEvents);
         pShell->printf("+-%.26s-+-%.10s-+\n", LINE_STRING, LINE_STRING);
+        pShell->printf("| %-26s | %10u |\n", "Credits Available",   statsCounters.numCreditsAvailable);
+        pShell->printf("| %-26s | %10u |\n", "Credit Stalls",       statsCounters.numCreditStalls);
+        pShell->printf("+-%.26s-+-%.10s-+\n", LINE_STRING, LINE_STRING);
+        pShell->printf("| %-26s | %10u |\n", "Exec Reports",        statsCounters.numExecReports);
+        pShell->printf("| %-26s | %10u |\n", "Exec Fills",          statsCounters.numExecFills);
+        pShell->printf("| %-26s | %10u |\n", "Exec Rejects",        statsCounters.numExecRejects);
+        pShell->printf("| %-26s | %10u |\n", "Exec Unmatched",      statsCounters.numExecUnmatched);
+        pShell->printf("+-%.26s-+-%.10s-+\n", LINE_STRING, LINE_STRING);
 
 
     }
@@ -286,6 +306,8 @@ static int PricingEngine_GetStatus(Shell* pShell, int argc, char* argv[], void*
     uint32_t captureSymbolIndex;
     bool bGlobalStrategyEnabled;
     PricingEngine::PricingStrategy globalStrategy;
+    uint32_t creditLimit;
+    uint32_t orderLifetime;
 
     XLNX_UNUSED_ARG(argc);
     XLNX_UNUSED_ARG(argv);
@@ -404,6 +426,28 @@ static int PricingEngine_GetStatus(Shell* pShell, int argc, char* argv[], void*
     }
 
 
+    if (retval == XLNX_OK)
+    {
+        retval = pPricingEngine->GetCreditLimit(&creditLimit);
+
+        if (retval == XLNX_OK)
+        {
+            pShell->printf("| %-30s | %20u |\n", "Credit Limit (0 = Default)", creditLimit);
+        }
+    }
+
+
+    if (retval == XLNX_OK)
+    {
+        retval = pPricingEngine->GetOrderLifetime(&orderLifetime);
+
+        if (retval == XLNX_OK)
+        {
+            pShell->printf("| %-30s | %20u |\n", "Order Lifetime (Revolutions)", orderLifetime);
+        }
+    }
+
+
     if (retval == XLNX_OK)
     {
         pShell->printf("+-%.30s-+-%.20s-+\n", LINE_STRING, LINE_STRING);
@@ -567,7 +611,7 @@ static int PricingEngine_SetGlobalStrategy(Shell* pShell, int argc, char* argv[]
 
     if (argc != 2)
     {
-        pShell->printf("Usage: %s <none|peg|limit>\n", argv[0]);
+        pShell->printf("Usage: %s <none|peg|limit|custom>\n", argv[0]);
         bOKToContinue = false;
     }
 
@@ -605,14 +649,404 @@ static int PricingEngine_SetGlobalStrategy(Shell* pShell, int argc, char* argv[]
 
 
 
+static int PricingEngine_SetStrategy(Shell* pShell, int argc, char* argv[], void* pObjectData)
+{
+    int retval = 0;
+    bool bOKToContinue = true;
+    PricingEngine* pPricingEngine = (PricingEngine*)pObjectData;
+    uint32_t symbolIndex;
+    PricingEngine::PricingStrategy strategy;
+
+    if (argc != 3)
+    {
+        pShell->printf("Usage: %s <symbolIndex> <none|peg|limit|custom>\n", argv[0]);
+        bOKToContinue = false;
+    }
+
+    if (bOKToContinue)
+    {
+        bOKToContinue = pShell->parseUInt32(argv[1], &symbolIndex);
+    }
+
+    if (bOKToContinue)
+    {
+        bOKToContinue = PricingEngine_ParsePricingStrategy(argv[2], &strategy);
+    }
+
+    if (bOKToContinue)
+    {
+        retval = pPricingEngine->SetSymbolStrategy(symbolIndex, strategy);
+
+        if (retval == XLNX_OK)
+        {
+            pShell->printf("OK\n");
+        }
+        else
+        {
+            pShell->printf("[ERROR] %s (0x%08X)\n", PricingEngine_ErrorCodeToString(retval), retval);
+        }
+    }
+
+    if (bOKToContinue == false)
+    {
+        retval = Shell::COMMAND_PARSING_ERROR;
+    }
+
+    return retval;
+}
+
+
+
+
+
+
+static int PricingEngine_SetThreshold(Shell* pShell, int argc, char* argv[], void* pObjectData)
+{
+    int retval = 0;
+    bool bOKToContinue = true;
+    PricingEngine* pPricingEngine = (PricingEngine*)pObjectData;
+    uint32_t symbolIndex;
+    bool bEnabled;
+    uint32_t threshold = 0;
+
+    if ((argc != 3) && (argc != 4))
+    {
+        pShell->printf("Usage: %s <symbolIndex> <bool> [position]\n", argv[0]);
+        bOKToContinue = false;
+    }
+
+    if (bOKToContinue)
+    {
+        bOKToContinue = pShell->parseUInt32(argv[1], &symbolIndex);
+    }
+
+    if (bOKToContinue)
+    {
+        bOKToContinue = pShell->parseBool(argv[2], &bEnabled);
+    }
+
+    if (bOKToContinue && (argc == 4))
+    {
+        bOKToContinue = pShell->parseUInt32(argv[3], &threshold);
+    }
+
+    if (bOKToContinue)
+    {
+        retval = pPricingEngine->SetSymbolPositionThreshold(symbolIndex, bEnabled, threshold);
+
+        if (retval == XLNX_OK)
+        {
+            pShell->printf("OK\n");
+        }
+        else
+        {
+            pShell->printf("[ERROR] %s (0x%08X)\n", PricingEngine_ErrorCodeToString(retval), retval);
+        }
+    }
+
+    if (bOKToContinue == false)
+    {
+        retval = Shell::COMMAND_PARSING_ERROR;
+    }
+
+    return retval;
+}
+
+
+
+
+
+
+static int PricingEngine_SetCredits(Shell* pShell, int argc, char* argv[], void* pObjectData)
+{
+    int retval = 0;
+    PricingEngine* pPricingEngine = (PricingEngine*)pObjectData;
+    bool bOKToContinue = true;
+    uint32_t creditLimit;
+
+    if (argc != 2)
+    {
+        pShell->printf("Usage: %s <limit>\n", argv[0]);
+        bOKToContinue = false;
+    }
+
+    if (bOKToContinue)
+    {
+        bOKToContinue = pShell->parseUInt32(argv[1], &creditLimit);
+    }
+
+    if (bOKToContinue)
+    {
+        retval = pPricingEngine->SetCreditLimit(creditLimit);
+
+        if (retval == XLNX_OK)
+        {
+            pShell->printf("OK\n");
+        }
+        else
+        {
+            pShell->printf("[ERROR] %s (0x%08X)\n", PricingEngine_ErrorCodeToString(retval), retval);
+        }
+    }
+
+    if (bOKToContinue == false)
+    {
+        retval = Shell::COMMAND_PARSING_ERROR;
+    }
+
+    return retval;
+}
+
+
+
+
+
+
+static int PricingEngine_SetLifetime(Shell* pShell, int argc, char* argv[], void* pObjectData)
+{
+    int retval = 0;
+    PricingEngine* pPricingEngine = (PricingEngine*)pObjectData;
+    bool bOKToContinue = true;
+    uint32_t revolutions;
+
+    if (argc != 2)
+    {
+        pShell->printf("Usage: %s <revolutions>\n", argv[0]);
+        bOKToContinue = false;
+    }
+
+    if (bOKToContinue)
+    {
+        bOKToContinue = pShell->parseUInt32(argv[1], &revolutions);
+    }
+
+    if (bOKToContinue)
+    {
+        retval = pPricingEngine->SetOrderLifetime(revolutions);
+
+        if (retval == XLNX_OK)
+        {
+            pShell->printf("OK\n");
+        }
+        else
+        {
+            pShell->printf("[ERROR] %s (0x%08X)\n", PricingEngine_ErrorCodeToString(retval), retval);
+        }
+    }
+
+    if (bOKToContinue == false)
+    {
+        retval = Shell::COMMAND_PARSING_ERROR;
+    }
+
+    return retval;
+}
+
+
+
+
+
+
+static int PricingEngine_GetLatency(Shell* pShell, int argc, char* argv[], void* pObjectData)
+{
+    int retval = 0;
+    PricingEngine* pPricingEngine = (PricingEngine*)pObjectData;
+    PricingEngine::LatencyHistogram ingressHistogram;
+    PricingEngine::LatencyHistogram egressHistogram;
+    PricingEngine::Stats statsCounters;
+    PricingEngine::LatencySummary* strategySummary[3];
+    double ingressMean = 0.0;
+    double egressMean = 0.0;
+    double strategyMean[3] = { 0.0, 0.0, 0.0 };
+    uint64_t binStart;
+    uint64_t binEnd;
+    char rangeString[32];
+    uint32_t i;
+
+    XLNX_UNUSED_ARG(argc);
+    XLNX_UNUSED_ARG(argv);
+
+    retval = pPricingEngine->GetIngressLatencyHistogram(&ingressHistogram);
+
+    if (retval == XLNX_OK)
+    {
+        retval = pPricingEngine->GetLatencyHistogram(&egressHistogram);
+    }
+
+    if (retval == XLNX_OK)
+    {
+        retval = pPricingEngine->GetStats(&statsCounters);
+    }
+
+    if (retval == XLNX_OK)
+    {
+        if (ingressHistogram.numSamples > 0)
+        {
+            ingressMean = (double)ingressHistogram.totalLatency / ingressHistogram.numSamples;
+        }
+
+        if (egressHistogram.numSamples > 0)
+        {
+            egressMean = (double)egressHistogram.totalLatency / egressHistogram.numSamples;
+        }
+
+        pShell->printf("\n");
+        pShell->printf("+-%.26s-+-%.10s-+-%.10s-+\n", LINE_STRING, LINE_STRING, LINE_STRING);
+        pShell->printf("| %-26s | %10s | %10s |\n", "Cycles from wire", "Ingress", "Egress");
+        pShell->printf("+-%.26s-+-%.10s-+-%.10s-+\n", LINE_STRING, LINE_STRING, LINE_STRING);
+        pShell->printf("| %-26s | %10u | %10u |\n", "Samples", ingressHistogram.numSamples, egressHistogram.numSamples);
+        pShell->printf("| %-26s | %10u | %10u |\n", "Min Latency", (ingressHistogram.numSamples > 0) ? ingressHistogram.minLatency : 0,
+                                                                 (egressHistogram.numSamples > 0) ? egressHistogram.minLatency : 0);
+        pShell->printf("| %-26s | %10u | %10u |\n", "Max Latency", ingressHistogram.maxLatency, egressHistogram.maxLatency);
+        pShell->printf("| %-26s | %10.1f | %10.1f |\n", "Mean Latency", ingressMean, egressMean);
+        pShell->printf("+-%.26s-+-%.10s-+-%.10s-+\n", LINE_STRING, LINE_STRING, LINE_STRING);
+
+        //both probes share the bin width set via setlatencybin
+        for (i = 0; i < XLNX_PRICING_ENGINE_NUM_LATENCY_BINS; i++)
+        {
+            binStart = (uint64_t)i << egressHistogram.binShift;
+            binEnd = ((uint64_t)(i + 1) << egressHistogram.binShift) - 1;
+
+            if (i == (XLNX_PRICING_ENGINE_NUM_LATENCY_BINS - 1))
+            {
+                snprintf(rangeString, sizeof(rangeString), "%llu+", (unsigned long long)binStart);
+            }
+            else
+            {
+                snprintf(rangeString, sizeof(rangeString), "%llu-%llu", (unsigned long long)binStart, (unsigned long long)binEnd);
+            }
+
+            pShell->printf("| %-26s | %10u | %10u |\n", rangeString, ingressHistogram.bins[i], egressHistogram.bins[i]);
+        }
+
+        pShell->printf("+-%.26s-+-%.10s-+-%.10s-+\n", LINE_STRING, LINE_STRING, LINE_STRING);
+
+        //egress split by the strategy that placed the order, measured from the same wire timestamp
+        strategySummary[0] = &statsCounters.pegLatency;
+        strategySummary[1] = &statsCounters.limitLatency;
+        strategySummary[2] = &statsCounters.customLatency;
+
+        for (i = 0; i < 3; i++)
+        {
+            if (strategySummary[i]->numSamples > 0)
+            {
+                strategyMean[i] = (double)strategySummary[i]->totalLatency / strategySummary[i]->numSamples;
+            }
+        }
+
+        pShell->printf("\n");
+        pShell->printf("+-%.26s-+-%.10s-+-%.10s-+-%.10s-+\n", LINE_STRING, LINE_STRING, LINE_STRING, LINE_STRING);
+        pShell->printf("| %-26s | %10s | %10s | %10s |\n", "Egress by strategy", "PEG", "LIMIT", "CUSTOM");
+        pShell->printf("+-%.26s-+-%.10s-+-%.10s-+-%.10s-+\n", LINE_STRING, LINE_STRING, LINE_STRING, LINE_STRING);
+        pShell->printf("| %-26s | %10u | %10u | %10u |\n", "Samples", strategySummary[0]->numSamples, strategySummary[1]->numSamples, strategySummary[2]->numSamples);
+        pShell->printf("| %-26s | %10u | %10u | %10u |\n", "Min Latency", (strategySummary[0]->numSamples > 0) ? strategySummary[0]->minLatency : 0,
+                                                                       (strategySummary[1]->numSamples > 0) ? strategySummary[1]->minLatency : 0,
+                                                                       (strategySummary[2]->numSamples > 0) ? strategySummary[2]->minLatency : 0);
+        pShell->printf("| %-26s | %10u | %10u | %10u |\n", "Max Latency", strategySummary[0]->maxLatency, strategySummary[1]->maxLatency, strategySummary[2]->maxLatency);
+        pShell->printf("| %-26s | %10.1f | %10.1f | %10.1f |\n", "Mean Latency", strategyMean[0], strategyMean[1], strategyMean[2]);
+        pShell->printf("+-%.26s-+-%.10s-+-%.10s-+-%.10s-+\n", LINE_STRING, LINE_STRING, LINE_STRING, LINE_STRING);
+    }
+    else
+    {
+        pShell->printf("[ERROR] %s (0x%08X)\n", PricingEngine_ErrorCodeToString(retval), retval);
+    }
+
+    return retval;
+}
+
+
+
+
+
+
+static int PricingEngine_SetLatencyBin(Shell* pShell, int argc, char* argv[], void* pObjectData)
+{
+    int retval = 0;
+    PricingEngine* pPricingEngine = (PricingEngine*)pObjectData;
+    bool bOKToContinue = true;
+    uint32_t binShift;
+
+    if (argc != 2)
+    {
+        pShell->printf("Usage: %s <shift>\n", argv[0]);
+        bOKToContinue = false;
+    }
+
+    if (bOKToContinue)
+    {
+        bOKToContinue = pShell->parseUInt32(argv[1], &binShift);
+    }
+
+    if (bOKToContinue)
+    {
+        retval = pPricingEngine->SetLatencyBinShift(binShift);
+
+        if (retval == XLNX_OK)
+        {
+            pShell->printf("OK\n");
+        }
+        else
+        {
+            pShell->printf("[ERROR] %s (0x%08X)\n", PricingEngine_ErrorCodeToString(retval), retval);
+        }
+    }
+
+    if (bOKToContinue == false)
+    {
+        retval = Shell::COMMAND_PARSING_ERROR;
+    }
+
+    return retval;
+}
+
+
+
+
+
+
+static int PricingEngine_ResetLatency(Shell* pShell, int argc, char* argv[], void* pObjectData)
+{
+    int retval = 0;
+    PricingEngine* pPricingEngine = (PricingEngine*)pObjectData;
+
+    XLNX_UNUSED_ARG(argc);
+    XLNX_UNUSED_ARG(argv);
+
+    retval = pPricingEngine->ResetLatencyHistogram();
+
+    if (retval == XLNX_OK)
+    {
+        pShell->printf("OK\n");
+    }
+    else
+    {
+        pShell->printf("[ERROR] %s (0x%08X)\n", PricingEngine_ErrorCodeToString(retval), retval);
+    }
+
+    return retval;
+}
+
+
+
+
+
+
 CommandTableElement XLNX_PRICING_ENGINE_COMMAND_TABLE[] =
 {
     {"setglobalmode",       PricingEngine_SetGlobalMode,        "<bool>",                   "Enables/Disable global pricing strategy"   },
-    {"setglobalstrategy",   PricingEngine_SetGlobalStrategy,    "<none|peg|limit>",         "Sets strategy to be applied to ALL symbols"},
+    {"setglobalstrategy",   PricingEngine_SetGlobalStrategy,    "<none|peg|limit|custom>",  "Sets strategy to be applied to ALL symbols"},
+    {"setstrategy",         PricingEngine_SetStrategy,          "<symbol> <strategy>",      "Sets strategy for a single symbol"         },
+    {"setthreshold",        PricingEngine_SetThreshold,         "<symbol> <bool> [pos]",    "Position threshold for PEG/LIMIT orders"   },
+    {"setcredits",          PricingEngine_SetCredits,           "<limit>",                  "Set max operations in flight to OE"        },
+    {"setlifetime",         PricingEngine_SetLifetime,          "<revolutions>",            "Cancel orders after lifetime (0 = off)"    },
     {/*-------------------------------------------------------------------------------------------------------------------------------*/},
     {"getstatus",	        PricingEngine_GetStatus,	        "",			                "Get block status"	                        },
     {"readdata",	        PricingEngine_ReadData,		        "",		                    "Read data"	                                },
-    {"resetstats",          PricingEngine_ResetStats,           "",                         "Reset stats counters"                      }
+    {"resetstats",          PricingEngine_ResetStats,           "",                         "Reset stats counters"                      },
+    {/*-------------------------------------------------------------------------------------------------------------------------------*/},
+    {"getlatency",          PricingEngine_GetLatency,           "",                         "Print ingress and egress latency histograms"   },
+    {"setlatencybin",       PricingEngine_SetLatencyBin,        "<shift>",                  "Set latency bin width (1 << shift cycles)"     },
+    {"resetlatency",        PricingEngine_ResetLatency,         "",                         "Reset latency histograms"                      }
 };
 
 
@@ -0,0 +1,1055 @@
+/*
+ * Copyright 2021 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "xlnx_shell_risk_engine.h"
+#include "xlnx_shell_utils.h"
+
+#include "xlnx_risk_engine.h"
+#include "xlnx_risk_engine_error_codes.h"
+using namespace XLNX;
+
+
+
+
+
+static const char* LINE_STRING = "--------------------------------------------------------------------";
+
+
+
+#define STR_CASE(TAG)	case(TAG):					\
+						{							\
+							pString = (char*) #TAG;	\
+							break;					\
+						}
+
+
+
+
+
+static char* RiskEngine_ErrorCodeToString(uint32_t errorCode)
+{
+    char* pString;
+
+    switch (errorCode)
+    {
+        STR_CASE(XLNX_OK)
+        STR_CASE(XLNX_RISK_ENGINE_ERROR_NOT_INITIALISED)
+        STR_CASE(XLNX_RISK_ENGINE_ERROR_IO_FAILED)
+        STR_CASE(XLNX_RISK_ENGINE_ERROR_INVALID_PARAMETER)
+        STR_CASE(XLNX_RISK_ENGINE_ERROR_CU_NAME_NOT_FOUND)
+        STR_CASE(XLNX_RISK_ENGINE_ERROR_CU_INDEX_NOT_FOUND)
+        STR_CASE(XLNX_RISK_ENGINE_ERROR_SYMBOL_INDEX_OUT_OF_RANGE)
+        STR_CASE(XLNX_RISK_ENGINE_ERROR_RATE_LIMIT_OUT_OF_RANGE)
+
+
+        default:
+        {
+            pString = (char*)"UKNOWN_ERROR";
+            break;
+        }
+    }
+
+    return pString;
+}
+
+
+
+
+
+
+static char* RiskEngine_RejectReasonToString(RiskEngine::RejectReason reason)
+{
+    char* pString;
+
+    switch (reason)
+    {
+        case(RiskEngine::RejectReason::REJECT_NONE):
+        {
+            pString = (char*)"NONE";
+            break;
+        }
+
+        case(RiskEngine::RejectReason::REJECT_KILL_SWITCH):
+        {
+            pString = (char*)"KILL SWITCH";
+            break;
+        }
+
+        case(RiskEngine::RejectReason::REJECT_QUANTITY):
+        {
+            pString = (char*)"QUANTITY";
+            break;
+        }
+
+        case(RiskEngine::RejectReason::REJECT_NOTIONAL):
+        {
+            pString = (char*)"NOTIONAL";
+            break;
+        }
+
+        case(RiskEngine::RejectReason::REJECT_PRICE_BAND):
+        {
+            pString = (char*)"PRICE BAND";
+            break;
+        }
+
+        case(RiskEngine::RejectReason::REJECT_POSITION):
+        {
+            pString = (char*)"POSITION";
+            break;
+        }
+
+        case(RiskEngine::RejectReason::REJECT_GLOBAL_POSITION):
+        {
+            pString = (char*)"GLOBAL POSITION";
+            break;
+        }
+
+        case(RiskEngine::RejectReason::REJECT_RATE):
+        {
+            pString = (char*)"RATE";
+            break;
+        }
+
+        case(RiskEngine::RejectReason::REJECT_GLOBAL_RATE):
+        {
+            pString = (char*)"GLOBAL RATE";
+            break;
+        }
+
+        default:
+        {
+            pString = (char*)"UNKNOWN";
+            break;
+        }
+    }
+
+    return pString;
+}
+
+
+
+
+
+
+static char* RiskEngine_OrderSideToString(RiskEngine::OrderSide orderSide)
+{
+    char* pString;
+
+    switch (orderSide)
+    {
+        case(RiskEngine::OrderSide::ORDER_SIDE_BID):
+        {
+            pString = (char*)"BID";
+            break;
+        }
+
+        case(RiskEngine::OrderSide::ORDER_SIDE_ASK):
+        {
+            pString = (char*)"ASK";
+            break;
+        }
+
+        default:
+        {
+            pString = (char*)"UNKNOWN";
+            break;
+        }
+    }
+
+    return pString;
+}
+
+
+
+
+
+
+static char* RiskEngine_OrderOperationToString(RiskEngine::OrderOperation orderOperation)
+{
+    char* pString;
+
+    switch (orderOperation)
+    {
+        case(RiskEngine::OrderOperation::ORDER_OPERATION_ADD):
+        {
+            pString = (char*)"ADD";
+            break;
+        }
+
+        case(RiskEngine::OrderOperation::ORDER_OPERATION_MODIFY):
+        {
+            pString = (char*)"MODIFY";
+            break;
+        }
+
+        case(RiskEngine::OrderOperation::ORDER_OPERATION_DELETE):
+        {
+            pString = (char*)"DELETE";
+            break;
+        }
+
+        default:
+        {
+            pString = (char*)"UNKNOWN";
+            break;
+        }
+    }
+
+    return pString;
+}
+
+
+
+
+
+
+
+
+
+
+
+
+
+static int RiskEngine_PrintStats(Shell* pShell, RiskEngine* pRiskEngine)
+{
+    int retval = 0;
+    RiskEngine::Stats statsCounters;
+
+    retval = pRiskEngine->GetStats(&statsCounters);
+
+    if (retval == XLNX_OK)
+    {
+        pShell->printf("\n");
+        pShell->printf("+-%.26s-+-%.10s-+\n", LINE_STRING, LINE_STRING);
+        pShell->printf("| %-26s | %-10s |\n", "Counter Name", "Value");
+        pShell->printf("+-%.26s-+-%.10s-+\n", LINE_STRING, LINE_STRING);
+        pShell->printf("| %-26s | %10u |\n", "Rx Responses",            statsCounters.numRxResponses);
+        pShell->printf("| %-26s | %10u |\n", "Rx Operations",           statsCounters.numRxOperations);
+        pShell->printf("| %-26s | %10u |\n", "Tx Operations",           statsCounters.numTxOperations);
+        pShell->printf("+-%.26s-+-%.10s-+\n", LINE_STRING, LINE_STRING);
+        pShell->printf("| %-26s | %10u |\n", "Reject Kill Switch",      statsCounters.numRejectKillSwitch);
+        pShell->printf("| %-26s | %10u |\n", "Reject Quantity",         statsCounters.numRejectQuantity);
+        pShell->printf("| %-26s | %10u |\n", "Reject Notional",         statsCounters.numRejectNotional);
+        pShell->printf("| %-26s | %10u |\n", "Reject Price Band",       statsCounters.numRejectPriceBand);
+        pShell->printf("| %-26s | %10u |\n", "Reject Position",         statsCounters.numRejectPosition);
+        pShell->printf("| %-26s | %10u |\n", "Reject Global Position",  statsCounters.numRejectGlobalPosition);
+        pShell->printf("| %-26s | %10u |\n", "Reject Rate",             statsCounters.numRejectRate);
+        pShell->printf("| %-26s | %10u |\n", "Reject Global Rate",      statsCounters.numRejectGlobalRate);
+        pShell->printf("+-%.26s-+-%.10s-+\n", LINE_STRING, LINE_STRING);
+        pShell->printf("| %-26s | %10u |\n", "Clock Tick Events",       statsCounters.numClockTickEvents);
+        pShell->printf("+-%.26s-+-%.10s-+\n", LINE_STRING, LINE_STRING);
+    }
+
+    return retval;
+}
+
+
+
+
+
+
+
+
+static int RiskEngine_GetStatus(Shell* pShell, int argc, char* argv[], void* pObjectData)
+{
+    int retval = 0;
+    RiskEngine* pRiskEngine = (RiskEngine*)pObjectData;
+    bool bIsInitialised;
+    uint32_t cuIndex = 0;
+    uint64_t cuAddress;
+    bool bIsRunning;
+    bool bKillSwitchEngaged;
+    uint32_t checkMask;
+    uint32_t globalPositionLimit;
+    uint32_t globalPosition;
+    uint32_t tokensPerTick;
+    uint32_t bucketDepth;
+    uint32_t rejectSymbolIndex;
+    RiskEngine::RejectReason rejectReason;
+
+    XLNX_UNUSED_ARG(argc);
+    XLNX_UNUSED_ARG(argv);
+
+
+    pRiskEngine->IsInitialised(&bIsInitialised);
+    if (bIsInitialised == false)
+    {
+        retval = XLNX_RISK_ENGINE_ERROR_NOT_INITIALISED;
+    }
+
+
+    if (retval == XLNX_OK)
+    {
+        pShell->printf("+-%.30s-+-%.20s-+\n", LINE_STRING, LINE_STRING);
+    }
+
+
+
+    if (retval == XLNX_OK)
+    {
+        retval = pRiskEngine->GetCUIndex(&cuIndex);
+
+        if (retval == XLNX_OK)
+        {
+            pShell->printf("| %-30s | %20u |\n", "CU Index", cuIndex);
+        }
+    }
+
+
+
+    if (retval == XLNX_OK)
+    {
+        retval = pRiskEngine->GetCUAddress(&cuAddress);
+
+        if (retval == XLNX_OK)
+        {
+            pShell->printf("| %-30s |   0x%016" PRIX64 " |\n", "CU Address", cuAddress);
+        }
+    }
+
+
+
+    if (retval == XLNX_OK)
+    {
+        retval = pRiskEngine->IsRunning(&bIsRunning);
+
+        if (retval == XLNX_OK)
+        {
+            pShell->printf("| %-30s | %20s |\n", "IsRunning", pShell->boolToString(bIsRunning));
+        }
+    }
+
+
+
+    if (retval == XLNX_OK)
+    {
+        pShell->printf("+-%.30s-+-%.20s-+\n", LINE_STRING, LINE_STRING);
+    }
+
+
+
+    if (retval == XLNX_OK)
+    {
+        retval = pRiskEngine->GetKillSwitch(&bKillSwitchEngaged);
+
+        if (retval == XLNX_OK)
+        {
+            pShell->printf("| %-30s | %20s |\n", "Kill Switch Engaged", pShell->boolToString(bKillSwitchEngaged));
+        }
+    }
+
+
+
+    if (retval == XLNX_OK)
+    {
+        retval = pRiskEngine->GetChecksEnabled(&checkMask);
+
+        if (retval == XLNX_OK)
+        {
+            pShell->printf("| %-30s |           0x%08X |\n", "Checks Enabled", checkMask);
+        }
+    }
+
+
+
+    if (retval == XLNX_OK)
+    {
+        retval = pRiskEngine->GetGlobalPositionLimit(&globalPositionLimit);
+
+        if (retval == XLNX_OK)
+        {
+            pShell->printf("| %-30s | %20u |\n", "Global Position Limit", globalPositionLimit);
+        }
+    }
+
+
+
+    if (retval == XLNX_OK)
+    {
+        retval = pRiskEngine->GetGlobalRateLimit(&tokensPerTick, &bucketDepth);
+
+        if (retval == XLNX_OK)
+        {
+            pShell->printf("| %-30s | %20u |\n", "Global Rate Tokens Per Tick", tokensPerTick);
+            pShell->printf("| %-30s | %20u |\n", "Global Rate Bucket Depth", bucketDepth);
+        }
+    }
+
+
+
+    if (retval == XLNX_OK)
+    {
+        pShell->printf("+-%.30s-+-%.20s-+\n", LINE_STRING, LINE_STRING);
+    }
+
+
+
+    if (retval == XLNX_OK)
+    {
+        retval = pRiskEngine->GetGlobalPosition(&globalPosition);
+
+        if (retval == XLNX_OK)
+        {
+            pShell->printf("| %-30s | %20u |\n", "Global Position", globalPosition);
+        }
+    }
+
+
+
+    if (retval == XLNX_OK)
+    {
+        retval = pRiskEngine->GetLastReject(&rejectSymbolIndex, &rejectReason);
+
+        if (retval == XLNX_OK)
+        {
+            pShell->printf("| %-30s | %20s |\n", "Last Reject Reason", RiskEngine_RejectReasonToString(rejectReason));
+            pShell->printf("| %-30s | %20u |\n", "Last Reject Symbol Index", rejectSymbolIndex);
+        }
+    }
+
+
+
+    if (retval == XLNX_OK)
+    {
+        pShell->printf("+-%.30s-+-%.20s-+\n", LINE_STRING, LINE_STRING);
+        pShell->printf("\n");
+    }
+
+
+
+    if (retval == XLNX_OK)
+    {
+        retval = RiskEngine_PrintStats(pShell, pRiskEngine);
+    }
+
+
+
+    if (retval != XLNX_OK)
+    {
+        pShell->printf("[ERROR] retval = %s (0x%08X)\n", RiskEngine_ErrorCodeToString(retval), retval);
+    }
+
+
+    return retval;
+}
+
+
+
+
+
+
+
+
+
+
+static int RiskEngine_ReadData(Shell* pShell, int argc, char* argv[], void* pObjectData)
+{
+    int retval = 0;
+    RiskEngine* pRiskEngine = (RiskEngine*)pObjectData;
+    RiskEngine::RiskEngineData data;
+
+    XLNX_UNUSED_ARG(argc);
+    XLNX_UNUSED_ARG(argv);
+
+
+    retval = pRiskEngine->ReadData(&data);
+
+
+    if (retval == XLNX_OK)
+    {
+        pShell->printf("+----------------------+------------+\n");
+        pShell->printf("| Symbol Index         | %10u |\n", data.symbolIndex);
+        pShell->printf("| Order Side           | %10s |\n", RiskEngine_OrderSideToString(data.orderSide));
+        pShell->printf("| Order Operation      | %10s |\n", RiskEngine_OrderOperationToString(data.orderOperation));
+        pShell->printf("| Order ID             | %10u |\n", data.orderID);
+        pShell->printf("| Order Price          | %10.2f |\n", (double)(data.orderPrice / 100.0));
+        pShell->printf("| Order Quantity       | %10u |\n", data.orderQuantity);
+        pShell->printf("+----------------------+------------+\n");
+    }
+    else
+    {
+        pShell->printf("[ERROR] retval = %s (0x%08X)\n", RiskEngine_ErrorCodeToString(retval), retval);
+    }
+
+    return retval;
+}
+
+
+
+
+
+
+
+
+static int RiskEngine_ResetStats(Shell* pShell, int argc, char* argv[], void* pObjectData)
+{
+    int retval = 0;
+    RiskEngine* pRiskEngine = (RiskEngine*)pObjectData;
+
+    XLNX_UNUSED_ARG(argc);
+    XLNX_UNUSED_ARG(argv);
+
+    retval = pRiskEngine->ResetStats();
+
+    if (retval == XLNX_OK)
+    {
+        pShell->printf("OK\n");
+    }
+    else
+    {
+        pShell->printf("[ERROR] %s (0x%08X)\n", RiskEngine_ErrorCodeToString(retval), retval);
+    }
+
+    return retval;
+}
+
+
+
+
+
+
+
+
+static int RiskEngine_ResetPositions(Shell* pShell, int argc, char* argv[], void* pObjectData)
+{
+    int retval = 0;
+    RiskEngine* pRiskEngine = (RiskEngine*)pObjectData;
+
+    XLNX_UNUSED_ARG(argc);
+    XLNX_UNUSED_ARG(argv);
+
+    retval = pRiskEngine->ResetPositions();
+
+    if (retval == XLNX_OK)
+    {
+        pShell->printf("OK\n");
+    }
+    else
+    {
+        pShell->printf("[ERROR] %s (0x%08X)\n", RiskEngine_ErrorCodeToString(retval), retval);
+    }
+
+    return retval;
+}
+
+
+
+
+
+
+
+
+static int RiskEngine_SetKillSwitch(Shell* pShell, int argc, char* argv[], void* pObjectData)
+{
+    int retval = 0;
+    RiskEngine* pRiskEngine = (RiskEngine*)pObjectData;
+    bool bOKToContinue = true;
+    bool bEngaged;
+
+    if (argc != 2)
+    {
+        pShell->printf("Usage: %s <bool>\n", argv[0]);
+        bOKToContinue = false;
+    }
+
+    if (bOKToContinue)
+    {
+        bOKToContinue = pShell->parseBool(argv[1], &bEngaged);
+    }
+
+    if (bOKToContinue)
+    {
+        retval = pRiskEngine->SetKillSwitch(bEngaged);
+
+        if (retval == XLNX_OK)
+        {
+            pShell->printf("OK\n");
+        }
+        else
+        {
+            pShell->printf("[ERROR] %s (0x%08X)\n", RiskEngine_ErrorCodeToString(retval), retval);
+        }
+    }
+
+    if (bOKToContinue == false)
+    {
+        retval = Shell::COMMAND_PARSING_ERROR;
+    }
+
+    return retval;
+}
+
+
+
+
+
+
+
+
+static int RiskEngine_SetChecks(Shell* pShell, int argc, char* argv[], void* pObjectData)
+{
+    int retval = 0;
+    RiskEngine* pRiskEngine = (RiskEngine*)pObjectData;
+    bool bOKToContinue = true;
+    uint32_t checkMask;
+
+    if (argc != 2)
+    {
+        pShell->printf("Usage: %s <mask>\n", argv[0]);
+        bOKToContinue = false;
+    }
+
+    if (bOKToContinue)
+    {
+        bOKToContinue = pShell->parseUInt32(argv[1], &checkMask);
+    }
+
+    if (bOKToContinue)
+    {
+        retval = pRiskEngine->SetChecksEnabled(checkMask);
+
+        if (retval == XLNX_OK)
+        {
+            pShell->printf("OK\n");
+        }
+        else
+        {
+            pShell->printf("[ERROR] %s (0x%08X)\n", RiskEngine_ErrorCodeToString(retval), retval);
+        }
+    }
+
+    if (bOKToContinue == false)
+    {
+        retval = Shell::COMMAND_PARSING_ERROR;
+    }
+
+    return retval;
+}
+
+
+
+
+
+
+
+
+static int RiskEngine_SetLimits(Shell* pShell, int argc, char* argv[], void* pObjectData)
+{
+    int retval = 0;
+    RiskEngine* pRiskEngine = (RiskEngine*)pObjectData;
+    bool bOKToContinue = true;
+    uint32_t symbolIndex;
+    RiskEngine::SymbolLimits limits;
+
+    if (argc != 8)
+    {
+        pShell->printf("Usage: %s <symbolIndex> <maxQty> <maxNotional> <maxPosition> <priceBand> <tokensPerTick> <bucketDepth>\n", argv[0]);
+        bOKToContinue = false;
+    }
+
+    if (bOKToContinue)
+    {
+        bOKToContinue = pShell->parseUInt32(argv[1], &symbolIndex);
+    }
+
+    if (bOKToContinue)
+    {
+        bOKToContinue = pShell->parseUInt32(argv[2], &limits.maxQuantity);
+    }
+
+    if (bOKToContinue)
+    {
+        bOKToContinue = pShell->parseUInt64(argv[3], &limits.maxNotional);
+    }
+
+    if (bOKToContinue)
+    {
+        bOKToContinue = pShell->parseUInt32(argv[4], &limits.maxPosition);
+    }
+
+    if (bOKToContinue)
+    {
+        bOKToContinue = pShell->parseUInt32(argv[5], &limits.priceBand);
+    }
+
+    if (bOKToContinue)
+    {
+        bOKToContinue = pShell->parseUInt32(argv[6], &limits.rateTokensPerTick);
+    }
+
+    if (bOKToContinue)
+    {
+        bOKToContinue = pShell->parseUInt32(argv[7], &limits.rateBucketDepth);
+    }
+
+    if (bOKToContinue)
+    {
+        retval = pRiskEngine->SetSymbolLimits(symbolIndex, &limits);
+
+        if (retval == XLNX_OK)
+        {
+            pShell->printf("OK\n");
+        }
+        else
+        {
+            pShell->printf("[ERROR] %s (0x%08X)\n", RiskEngine_ErrorCodeToString(retval), retval);
+        }
+    }
+
+    if (bOKToContinue == false)
+    {
+        retval = Shell::COMMAND_PARSING_ERROR;
+    }
+
+    return retval;
+}
+
+
+
+
+
+
+
+
+static int RiskEngine_GetLimits(Shell* pShell, int argc, char* argv[], void* pObjectData)
+{
+    int retval = 0;
+    RiskEngine* pRiskEngine = (RiskEngine*)pObjectData;
+    bool bOKToContinue = true;
+    uint32_t symbolIndex;
+    RiskEngine::SymbolLimits limits;
+
+    if (argc != 2)
+    {
+        pShell->printf("Usage: %s <symbolIndex>\n", argv[0]);
+        bOKToContinue = false;
+    }
+
+    if (bOKToContinue)
+    {
+        bOKToContinue = pShell->parseUInt32(argv[1], &symbolIndex);
+    }
+
+    if (bOKToContinue)
+    {
+        retval = pRiskEngine->GetSymbolLimits(symbolIndex, &limits);
+
+        if (retval == XLNX_OK)
+        {
+            pShell->printf("+-%.26s-+-%.20s-+\n", LINE_STRING, LINE_STRING);
+            pShell->printf("| %-26s | %20u |\n", "Symbol Index", symbolIndex);
+            pShell->printf("+-%.26s-+-%.20s-+\n", LINE_STRING, LINE_STRING);
+            pShell->printf("| %-26s | %20u |\n", "Max Quantity", limits.maxQuantity);
+            pShell->printf("| %-26s | %20" PRIu64 " |\n", "Max Notional", limits.maxNotional);
+            pShell->printf("| %-26s | %20u |\n", "Max Position", limits.maxPosition);
+            pShell->printf("| %-26s | %20u |\n", "Price Band", limits.priceBand);
+            pShell->printf("| %-26s | %20u |\n", "Rate Tokens Per Tick", limits.rateTokensPerTick);
+            pShell->printf("| %-26s | %20u |\n", "Rate Bucket Depth", limits.rateBucketDepth);
+            pShell->printf("+-%.26s-+-%.20s-+\n", LINE_STRING, LINE_STRING);
+        }
+        else
+        {
+            pShell->printf("[ERROR] %s (0x%08X)\n", RiskEngine_ErrorCodeToString(retval), retval);
+        }
+    }
+
+    if (bOKToContinue == false)
+    {
+        retval = Shell::COMMAND_PARSING_ERROR;
+    }
+
+    return retval;
+}
+
+
+
+
+
+
+
+
+static int RiskEngine_SetGlobalPositionLimit(Shell* pShell, int argc, char* argv[], void* pObjectData)
+{
+    int retval = 0;
+    RiskEngine* pRiskEngine = (RiskEngine*)pObjectData;
+    bool bOKToContinue = true;
+    uint32_t limit;
+
+    if (argc != 2)
+    {
+        pShell->printf("Usage: %s <limit>\n", argv[0]);
+        bOKToContinue = false;
+    }
+
+    if (bOKToContinue)
+    {
+        bOKToContinue = pShell->parseUInt32(argv[1], &limit);
+    }
+
+    if (bOKToContinue)
+    {
+        retval = pRiskEngine->SetGlobalPositionLimit(limit);
+
+        if (retval == XLNX_OK)
+        {
+            pShell->printf("OK\n");
+        }
+        else
+        {
+            pShell->printf("[ERROR] %s (0x%08X)\n", RiskEngine_ErrorCodeToString(retval), retval);
+        }
+    }
+
+    if (bOKToContinue == false)
+    {
+        retval = Shell::COMMAND_PARSING_ERROR;
+    }
+
+    return retval;
+}
+
+
+
+
+
+
+
+
+static int RiskEngine_SetGlobalRateLimit(Shell* pShell, int argc, char* argv[], void* pObjectData)
+{
+    int retval = 0;
+    RiskEngine* pRiskEngine = (RiskEngine*)pObjectData;
+    bool bOKToContinue = true;
+    uint32_t tokensPerTick;
+    uint32_t bucketDepth;
+
+    if (argc != 3)
+    {
+        pShell->printf("Usage: %s <tokensPerTick> <bucketDepth>\n", argv[0]);
+        bOKToContinue = false;
+    }
+
+    if (bOKToContinue)
+    {
+        bOKToContinue = pShell->parseUInt32(argv[1], &tokensPerTick);
+    }
+
+    if (bOKToContinue)
+    {
+        bOKToContinue = pShell->parseUInt32(argv[2], &bucketDepth);
+    }
+
+    if (bOKToContinue)
+    {
+        retval = pRiskEngine->SetGlobalRateLimit(tokensPerTick, bucketDepth);
+
+        if (retval == XLNX_OK)
+        {
+            pShell->printf("OK\n");
+        }
+        else
+        {
+            pShell->printf("[ERROR] %s (0x%08X)\n", RiskEngine_ErrorCodeToString(retval), retval);
+        }
+    }
+
+    if (bOKToContinue == false)
+    {
+        retval = Shell::COMMAND_PARSING_ERROR;
+    }
+
+    return retval;
+}
+
+
+
+
+
+
+static int RiskEngine_GetLatency(Shell* pShell, int argc, char* argv[], void* pObjectData)
+{
+    int retval = 0;
+    RiskEngine* pRiskEngine = (RiskEngine*)pObjectData;
+    RiskEngine::LatencyHistogram ingressHistogram;
+    RiskEngine::LatencyHistogram egressHistogram;
+    double ingressMean = 0.0;
+    double egressMean = 0.0;
+    uint64_t binStart;
+    uint64_t binEnd;
+    char rangeString[32];
+    uint32_t i;
+
+    XLNX_UNUSED_ARG(argc);
+    XLNX_UNUSED_ARG(argv);
+
+    retval = pRiskEngine->GetIngressLatencyHistogram(&ingressHistogram);
+
+    if (retval == XLNX_OK)
+    {
+        retval = pRiskEngine->GetLatencyHistogram(&egressHistogram);
+    }
+
+    if (retval == XLNX_OK)
+    {
+        if (ingressHistogram.numSamples > 0)
+        {
+            ingressMean = (double)ingressHistogram.totalLatency / ingressHistogram.numSamples;
+        }
+
+        if (egressHistogram.numSamples > 0)
+        {
+            egressMean = (double)egressHistogram.totalLatency / egressHistogram.numSamples;
+        }
+
+        pShell->printf("\n");
+        pShell->printf("+-%.26s-+-%.10s-+-%.10s-+\n", LINE_STRING, LINE_STRING, LINE_STRING);
+        pShell->printf("| %-26s | %10s | %10s |\n", "Cycles from wire", "Ingress", "Egress");
+        pShell->printf("+-%.26s-+-%.10s-+-%.10s-+\n", LINE_STRING, LINE_STRING, LINE_STRING);
+        pShell->printf("| %-26s | %10u | %10u |\n", "Samples", ingressHistogram.numSamples, egressHistogram.numSamples);
+        pShell->printf("| %-26s | %10u | %10u |\n", "Min Latency", (ingressHistogram.numSamples > 0) ? ingressHistogram.minLatency : 0,
+                                                                 (egressHistogram.numSamples > 0) ? egressHistogram.minLatency : 0);
+        pShell->printf("| %-26s | %10u | %10u |\n", "Max Latency", ingressHistogram.maxLatency, egressHistogram.maxLatency);
+        pShell->printf("| %-26s | %10.1f | %10.1f |\n", "Mean Latency", ingressMean, egressMean);
+        pShell->printf("+-%.26s-+-%.10s-+-%.10s-+\n", LINE_STRING, LINE_STRING, LINE_STRING);
+
+        //both probes share the bin width set via setlatencybin
+        for (i = 0; i < XLNX_RISK_ENGINE_NUM_LATENCY_BINS; i++)
+        {
+            binStart = (uint64_t)i << egressHistogram.binShift;
+            binEnd = ((uint64_t)(i + 1) << egressHistogram.binShift) - 1;
+
+            if (i == (XLNX_RISK_ENGINE_NUM_LATENCY_BINS - 1))
+            {
+                snprintf(rangeString, sizeof(rangeString), "%llu+", (unsigned long long)binStart);
+            }
+            else
+            {
+                snprintf(rangeString, sizeof(rangeString), "%llu-%llu", (unsigned long long)binStart, (unsigned long long)binEnd);
+            }
+
+            pShell->printf("| %-26s | %10u | %10u |\n", rangeString, ingressHistogram.bins[i], egressHistogram.bins[i]);
+        }
+
+        pShell->printf("+-%.26s-+-%.10s-+-%.10s-+\n", LINE_STRING, LINE_STRING, LINE_STRING);
+    }
+    else
+    {
+        pShell->printf("[ERROR] %s (0x%08X)\n", RiskEngine_ErrorCodeToString(retval), retval);
+    }
+
+    return retval;
+}
+
+
+
+
+
+
+static int RiskEngine_SetLatencyBin(Shell* pShell, int argc, char* argv[], void* pObjectData)
+{
+    int retval = 0;
+    RiskEngine* pRiskEngine = (RiskEngine*)pObjectData;
+    bool bOKToContinue = true;
+    uint32_t binShift;
+
+    if (argc != 2)
+    {
+        pShell->printf("Usage: %s <shift>\n", argv[0]);
+        bOKToContinue = false;
+    }
+
+    if (bOKToContinue)
+    {
+        bOKToContinue = pShell->parseUInt32(argv[1], &binShift);
+    }
+
+    if (bOKToContinue)
+    {
+        retval = pRiskEngine->SetLatencyBinShift(binShift);
+
+        if (retval == XLNX_OK)
+        {
+            pShell->printf("OK\n");
+        }
+        else
+        {
+            pShell->printf("[ERROR] %s (0x%08X)\n", RiskEngine_ErrorCodeToString(retval), retval);
+        }
+    }
+
+    if (bOKToContinue == false)
+    {
+        retval = Shell::COMMAND_PARSING_ERROR;
+    }
+
+    return retval;
+}
+
+
+
+
+
+
+static int RiskEngine_ResetLatency(Shell* pShell, int argc, char* argv[], void* pObjectData)
+{
+    int retval = 0;
+    RiskEngine* pRiskEngine = (RiskEngine*)pObjectData;
+
+    XLNX_UNUSED_ARG(argc);
+    XLNX_UNUSED_ARG(argv);
+
+    retval = pRiskEngine->ResetLatencyHistogram();
+
+    if (retval == XLNX_OK)
+    {
+        pShell->printf("OK\n");
+    }
+    else
+    {
+        pShell->printf("[ERROR] %s (0x%08X)\n", RiskEngine_ErrorCodeToString(retval), retval);
+    }
+
+    return retval;
+}
+
+
+
+
+
+
+CommandTableElement XLNX_RISK_ENGINE_COMMAND_TABLE[] =
+{
+    {"setchecks",           RiskEngine_SetChecks,               "<mask>",                                           "Enable risk checks by bitmask"             },
+    {"setlimits",           RiskEngine_SetLimits,               "<sym> <qty> <notional> <pos> <band> <tpt> <depth>","Set per-symbol risk limits"                },
+    {"getlimits",           RiskEngine_GetLimits,               "<sym>",                                            "Get per-symbol risk limits"                },
+    {"setglobalposition",   RiskEngine_SetGlobalPositionLimit,  "<limit>",                                          "Set global position limit"                 },
+    {"setglobalrate",       RiskEngine_SetGlobalRateLimit,      "<tokensPerTick> <bucketDepth>",                    "Set global order rate throttle"            },
+    {"killswitch",          RiskEngine_SetKillSwitch,           "<bool>",                                           "Engage/release kill switch"                },
+    {"resetpositions",      RiskEngine_ResetPositions,          "",                                                 "Clear positions and open exposure"         },
+    {/*--------------------------------------------------------------------------------------------------------------------------------------------------*/},
+    {"getstatus",           RiskEngine_GetStatus,               "",                                                 "Get block status"                          },
+    {"readdata",            RiskEngine_ReadData,                "",                                                 "Read data"                                 },
+    {"resetstats",          RiskEngine_ResetStats,              "",                                                 "Reset stats counters"                      },
+    {/*--------------------------------------------------------------------------------------------------------------------------------------------------*/},
+    {"getlatency",          RiskEngine_GetLatency,              "",                                                 "Print ingress and egress latency histograms"},
+    {"setlatencybin",       RiskEngine_SetLatencyBin,           "<shift>",                                          "Set latency bin width (1 << shift cycles)" },
+    {"resetlatency",        RiskEngine_ResetLatency,            "",                                                 "Reset latency histograms"                  }
+};
+
+
+const uint32_t XLNX_RISK_ENGINE_COMMAND_TABLE_LENGTH = (uint32_t)(sizeof(XLNX_RISK_ENGINE_COMMAND_TABLE) / sizeof(XLNX_RISK_ENGINE_COMMAND_TABLE[0]));
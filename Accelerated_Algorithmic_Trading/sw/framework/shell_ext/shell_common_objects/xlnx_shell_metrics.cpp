@@ -0,0 +1,334 @@
+/*
+ * Copyright 2021 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "xlnx_shell_metrics.h"
+#include "xlnx_shell_telemetry.h"
+#include "xlnx_shell_utils.h"
+
+#include "xlnx_metrics_exporter.h"
+#include "xlnx_telemetry_error_codes.h"
+using namespace XLNX;
+
+
+
+
+
+
+
+
+static const char* LINE_STRING = "--------------------------------------------------------------------------------------------------";
+
+
+#define DEFAULT_INTERVAL_MILLISECONDS       (1000)
+
+
+
+
+
+static int Metrics_GetStatus(Shell* pShell, int argc, char* argv[], void* pObjectData)
+{
+    int retval = XLNX_OK;
+    MetricsExporter* pExporter = (MetricsExporter*)pObjectData;
+    MetricsExporter::Stats stats;
+    const char* pName;
+    bool bIsRunning;
+    bool bServerRunning;
+    uint16_t serverPort;
+    uint32_t intervalMilliseconds;
+    uint32_t numMetrics;
+
+    XLNX_UNUSED_ARG(argc);
+    XLNX_UNUSED_ARG(argv);
+
+
+    retval = pExporter->GetSharedMemoryName(&pName);
+
+    if (retval == XLNX_OK)
+    {
+        pExporter->IsRunning(&bIsRunning);
+        pExporter->GetInterval(&intervalMilliseconds);
+        pExporter->GetNumMetrics(&numMetrics);
+        pExporter->IsServerRunning(&bServerRunning, &serverPort);
+        pExporter->GetStats(&stats);
+
+        pShell->printf("+-%.35s-+-%.20s-+\n", LINE_STRING, LINE_STRING);
+        pShell->printf("| %-35s | %20s |\n", "Shared Memory", pName);
+        pShell->printf("| %-35s | %20s |\n", "Is Running", pShell->boolToString(bIsRunning));
+        pShell->printf("| %-35s | %20u |\n", "Interval (ms)", intervalMilliseconds);
+        pShell->printf("| %-35s | %20u |\n", "Metrics", numMetrics);
+        pShell->printf("+-%.35s-+-%.20s-+\n", LINE_STRING, LINE_STRING);
+        pShell->printf("| %-35s | %20s |\n", "Text Server Running", pShell->boolToString(bServerRunning));
+        pShell->printf("| %-35s | %20u |\n", "Text Server Port", serverPort);
+        pShell->printf("+-%.35s-+-%.20s-+\n", LINE_STRING, LINE_STRING);
+        pShell->printf("| %-35s | %20" PRIu64 " |\n", "Samples", stats.numSamples);
+        pShell->printf("| %-35s | %20" PRIu64 " |\n", "Stale Samples", stats.numStaleSamples);
+        pShell->printf("| %-35s | %20" PRIu64 " |\n", "Error Samples", stats.numErrorSamples);
+        pShell->printf("| %-35s | %20" PRIu64 " |\n", "Counter Wraps", stats.numCounterWraps);
+        pShell->printf("| %-35s | %20" PRIu64 " |\n", "Counter Resets", stats.numCounterResets);
+        pShell->printf("| %-35s | %20" PRIu64 " |\n", "Text Server Requests", stats.numServerRequests);
+        pShell->printf("+-%.35s-+-%.20s-+\n", LINE_STRING, LINE_STRING);
+    }
+
+
+    if (retval != XLNX_OK)
+    {
+        pShell->printf("[ERROR] retval = %s (0x%08X)\n", Telemetry_ErrorCodeToString(retval), retval);
+    }
+
+    return retval;
+}
+
+
+
+
+
+static int Metrics_Start(Shell* pShell, int argc, char* argv[], void* pObjectData)
+{
+    int retval = XLNX_OK;
+    MetricsExporter* pExporter = (MetricsExporter*)pObjectData;
+    bool bOKToContinue = true;
+    uint32_t intervalMilliseconds = DEFAULT_INTERVAL_MILLISECONDS;
+
+    if (argc > 2)
+    {
+        pShell->printf("Usage: %s [milliseconds]\n", argv[0]);
+        bOKToContinue = false;
+    }
+
+
+    if (bOKToContinue && (argc == 2))
+    {
+        bOKToContinue = pShell->parseUInt32(argv[1], &intervalMilliseconds);
+        if (bOKToContinue == false)
+        {
+            pShell->printf("[ERROR] Failed to parse milliseconds parameter\n");
+        }
+    }
+
+
+    if (bOKToContinue)
+    {
+        retval = pExporter->Start(intervalMilliseconds);
+
+        if (retval == XLNX_OK)
+        {
+            pShell->printf("OK\n");
+        }
+        else
+        {
+            pShell->printf("[ERROR] retval = %s (0x%08X)\n", Telemetry_ErrorCodeToString(retval), retval);
+        }
+    }
+
+    return retval;
+}
+
+
+
+
+
+static int Metrics_Stop(Shell* pShell, int argc, char* argv[], void* pObjectData)
+{
+    int retval = XLNX_OK;
+    MetricsExporter* pExporter = (MetricsExporter*)pObjectData;
+
+    XLNX_UNUSED_ARG(argc);
+    XLNX_UNUSED_ARG(argv);
+
+    retval = pExporter->Stop();
+
+    if (retval == XLNX_OK)
+    {
+        pShell->printf("OK\n");
+    }
+    else
+    {
+        pShell->printf("[ERROR] retval = %s (0x%08X)\n", Telemetry_ErrorCodeToString(retval), retval);
+    }
+
+    return retval;
+}
+
+
+
+
+
+static int Metrics_Sample(Shell* pShell, int argc, char* argv[], void* pObjectData)
+{
+    int retval = XLNX_OK;
+    MetricsExporter* pExporter = (MetricsExporter*)pObjectData;
+
+    XLNX_UNUSED_ARG(argc);
+    XLNX_UNUSED_ARG(argv);
+
+    retval = pExporter->Sample();
+
+    if (retval == XLNX_OK)
+    {
+        pShell->printf("OK\n");
+    }
+    else
+    {
+        pShell->printf("[ERROR] retval = %s (0x%08X)\n", Telemetry_ErrorCodeToString(retval), retval);
+    }
+
+    return retval;
+}
+
+
+
+
+
+static int Metrics_Dump(Shell* pShell, int argc, char* argv[], void* pObjectData)
+{
+    int retval = XLNX_OK;
+    MetricsExporter* pExporter = (MetricsExporter*)pObjectData;
+    MetricsSharedDescriptor descriptor;
+    MetricsSharedValue value;
+    uint32_t numMetrics = 0;
+    uint32_t i;
+
+    XLNX_UNUSED_ARG(argc);
+    XLNX_UNUSED_ARG(argv);
+
+    retval = pExporter->GetNumMetrics(&numMetrics);
+
+    if (retval == XLNX_OK)
+    {
+        pShell->printf("+-%.40s-+-%.7s-+-%.20s-+-%.16s-+\n", LINE_STRING, LINE_STRING, LINE_STRING, LINE_STRING);
+        pShell->printf("| %-40s | %-7s | %20s | %16s |\n", "Metric", "Type", "Value", "Rate (/s)");
+        pShell->printf("+-%.40s-+-%.7s-+-%.20s-+-%.16s-+\n", LINE_STRING, LINE_STRING, LINE_STRING, LINE_STRING);
+
+        for (i = 0; i < numMetrics; i++)
+        {
+            if (pExporter->GetMetric(i, &descriptor, &value) == XLNX_OK)
+            {
+                if (descriptor.type == XLNX_METRICS_TYPE_COUNTER)
+                {
+                    pShell->printf("| %-40s | %-7s | %20" PRIu64 " | %16.1f |\n", descriptor.name, "counter", value.value, value.ratePerSecond);
+                }
+                else
+                {
+                    pShell->printf("| %-40s | %-7s | %20" PRIu64 " | %16s |\n", descriptor.name, "gauge", value.value, "");
+                }
+            }
+        }
+
+        pShell->printf("+-%.40s-+-%.7s-+-%.20s-+-%.16s-+\n", LINE_STRING, LINE_STRING, LINE_STRING, LINE_STRING);
+    }
+    else
+    {
+        pShell->printf("[ERROR] retval = %s (0x%08X)\n", Telemetry_ErrorCodeToString(retval), retval);
+    }
+
+    return retval;
+}
+
+
+
+
+
+static int Metrics_StartServer(Shell* pShell, int argc, char* argv[], void* pObjectData)
+{
+    int retval = XLNX_OK;
+    MetricsExporter* pExporter = (MetricsExporter*)pObjectData;
+    bool bOKToContinue = true;
+    uint16_t port;
+
+    if (argc != 2)
+    {
+        pShell->printf("Usage: %s <port>\n", argv[0]);
+        bOKToContinue = false;
+    }
+
+
+    if (bOKToContinue)
+    {
+        bOKToContinue = pShell->parseUInt16(argv[1], &port);
+        if (bOKToContinue == false)
+        {
+            pShell->printf("[ERROR] Failed to parse port parameter\n");
+        }
+    }
+
+
+    if (bOKToContinue)
+    {
+        retval = pExporter->StartServer(port);
+
+        if (retval == XLNX_OK)
+        {
+            pShell->printf("OK\n");
+        }
+        else
+        {
+            pShell->printf("[ERROR] retval = %s (0x%08X)\n", Telemetry_ErrorCodeToString(retval), retval);
+        }
+    }
+
+    return retval;
+}
+
+
+
+
+
+static int Metrics_StopServer(Shell* pShell, int argc, char* argv[], void* pObjectData)
+{
+    int retval = XLNX_OK;
+    MetricsExporter* pExporter = (MetricsExporter*)pObjectData;
+
+    XLNX_UNUSED_ARG(argc);
+    XLNX_UNUSED_ARG(argv);
+
+    retval = pExporter->StopServer();
+
+    if (retval == XLNX_OK)
+    {
+        pShell->printf("OK\n");
+    }
+    else
+    {
+        pShell->printf("[ERROR] retval = %s (0x%08X)\n", Telemetry_ErrorCodeToString(retval), retval);
+    }
+
+    return retval;
+}
+
+
+
+
+
+
+
+
+CommandTableElement XLNX_METRICS_COMMAND_TABLE[] =
+{
+    {"getstatus",	        Metrics_GetStatus,	            "",			                    "Get metrics exporter status"	                },
+    {"start",               Metrics_Start,                  "[milliseconds]",               "Start exporting metrics"                       },
+    {"stop",                Metrics_Stop,                   "",                             "Stop exporting metrics"                        },
+    {"sample",              Metrics_Sample,                 "",                             "Sample the latest telemetry snapshot now"      },
+    {/*-----------------------------------------------------------------------------------------------------------------------------------*/},
+    {"dump",                Metrics_Dump,                   "",                             "Print the latest metric values and rates"      },
+    {/*-----------------------------------------------------------------------------------------------------------------------------------*/},
+    {"startserver",         Metrics_StartServer,            "<port>",                       "Serve metrics as text over TCP"                },
+    {"stopserver",          Metrics_StopServer,             "",                             "Stop serving metrics"                          }
+
+};
+
+
+const uint32_t XLNX_METRICS_COMMAND_TABLE_LENGTH = (uint32_t)(sizeof(XLNX_METRICS_COMMAND_TABLE) / sizeof(XLNX_METRICS_COMMAND_TABLE[0]));
@@ -58,6 +58,11 @@ static char* TCP_UDP_IP_ErrorCodeToString(uint32_t errorCode)
 		STR_CASE(XLNX_TCP_UDP_IP_ERROR_FEATURE_NOT_SYNTHESIZED_IN_HW)
 		STR_CASE(XLNX_TCP_UDP_IP_ERROR_CONFIGURATION_DISABLED_DUE_TO_HW_LIMITATIONS)
 		STR_CASE(XLNX_TCP_UDP_IP_ERROR_UNSUPPORTED_IGMP_VERSION)
+		STR_CASE(XLNX_TCP_UDP_IP_ERROR_NO_FREE_UDP_GROUP_ENTRIES)
+		STR_CASE(XLNX_TCP_UDP_IP_ERROR_UDP_GROUP_NOT_ENABLED)
+		STR_CASE(XLNX_TCP_UDP_IP_ERROR_UDP_GROUP_ALREADY_ENABLED)
+		STR_CASE(XLNX_TCP_UDP_IP_ERROR_INVALID_PARAMETER)
+		STR_CASE(XLNX_TCP_UDP_IP_ERROR_NOT_SUPPORTED_BY_HW)
 
 		default:
 		{
@@ -424,22 +429,24 @@ static int TCP_UDP_IP_AddMulticastIPv4Address(Shell* pShell, int argc, char* arg
 	bool bOKToContinue = true;
 	TCPUDPIP* pTCPUDPIP;
 	uint8_t dottedQuad[4];
+	int i;
 
 
 	pTCPUDPIP = (TCPUDPIP*)pObjectData;
 
 
-	if (argc != 2)
+	if (argc < 2)
 	{
-		pShell->printf("Usage: %s <ipaddr>\n", argv[0]);
+		pShell->printf("Usage: %s <ipaddr> [<ipaddr> ...]\n", argv[0]);
 		bOKToContinue = false;
 	}
 
 
 
-	if (bOKToContinue)
+	//Parse all addresses up front so that a bad argument does not leave a partial batch...
+	for (i = 1; (i < argc) && bOKToContinue; i++)
 	{
-		bOKToContinue = ParseIPv4Address(pShell, argv[1], &dottedQuad[0], &dottedQuad[1], &dottedQuad[2], &dottedQuad[3]);
+		bOKToContinue = ParseIPv4Address(pShell, argv[i], &dottedQuad[0], &dottedQuad[1], &dottedQuad[2], &dottedQuad[3]);
 	}
 
 
@@ -451,7 +458,20 @@ static int TCP_UDP_IP_AddMulticastIPv4Address(Shell* pShell, int argc, char* arg
 		//does not yet fully support this.  To prevent errors being caused in the HW emulation, we will skip the actual API call
 		//when we are running in emulation mode.
 #ifndef XCL_EMULATION_MODE
-		retval = pTCPUDPIP->AddIPv4MulticastAddress(dottedQuad[0], dottedQuad[1], dottedQuad[2], dottedQuad[3]);
+		//With multiple addresses, the reports of all but the last are deferred so that
+		//the HW sends a single IGMPv3 report carrying every group record
+		for (i = 1; (i < argc) && (retval == XLNX_OK); i++)
+		{
+			ParseIPv4Address(pShell, argv[i], &dottedQuad[0], &dottedQuad[1], &dottedQuad[2], &dottedQuad[3]);
+
+			retval = pTCPUDPIP->AddIPv4MulticastAddress(dottedQuad[0], dottedQuad[1], dottedQuad[2], dottedQuad[3], (i < (argc - 1)));
+		}
+
+		//If we failed part way through, don't leave the records of the earlier addresses held back
+		if (retval != XLNX_OK)
+		{
+			pTCPUDPIP->SendIGMPReport();
+		}
 #else
 		pShell->printf("[INFO] Skipping multicast address add in emulation mode\n");
 #endif
@@ -489,22 +509,24 @@ static int TCP_UDP_IP_DeleteMulticastIP4vAddress(Shell* pShell, int argc, char*
 	bool bOKToContinue = true;
 	TCPUDPIP* pTCPUDPIP;
 	uint8_t dottedQuad[4];
+	int i;
 
 
 	pTCPUDPIP = (TCPUDPIP*)pObjectData;
 
 
-	if (argc != 2)
+	if (argc < 2)
 	{
-		pShell->printf("Usage: %s <ipaddr>\n", argv[0]);
+		pShell->printf("Usage: %s <ipaddr> [<ipaddr> ...]\n", argv[0]);
 		bOKToContinue = false;
 	}
 
 
 
-	if (bOKToContinue)
+	//Parse all addresses up front so that a bad argument does not leave a partial batch...
+	for (i = 1; (i < argc) && bOKToContinue; i++)
 	{
-		bOKToContinue = ParseIPv4Address(pShell, argv[1], &dottedQuad[0], &dottedQuad[1], &dottedQuad[2], &dottedQuad[3]);
+		bOKToContinue = ParseIPv4Address(pShell, argv[i], &dottedQuad[0], &dottedQuad[1], &dottedQuad[2], &dottedQuad[3]);
 	}
 
 
@@ -516,7 +538,20 @@ static int TCP_UDP_IP_DeleteMulticastIP4vAddress(Shell* pShell, int argc, char*
 		//does not yet fully support this.  To prevent errors being caused in the HW emulation, we will skip the actual API call
 		//when we are running in emulation mode.
 #ifndef XCL_EMULATION_MODE
-		retval = pTCPUDPIP->DeleteIPv4MulticastAddress(dottedQuad[0], dottedQuad[1], dottedQuad[2], dottedQuad[3]);
+		//With multiple addresses, the reports of all but the last are deferred so that
+		//the HW sends a single IGMPv3 report carrying every group record
+		for (i = 1; (i < argc) && (retval == XLNX_OK); i++)
+		{
+			ParseIPv4Address(pShell, argv[i], &dottedQuad[0], &dottedQuad[1], &dottedQuad[2], &dottedQuad[3]);
+
+			retval = pTCPUDPIP->DeleteIPv4MulticastAddress(dottedQuad[0], dottedQuad[1], dottedQuad[2], dottedQuad[3], (i < (argc - 1)));
+		}
+
+		//If we failed part way through, don't leave the records of the earlier addresses held back
+		if (retval != XLNX_OK)
+		{
+			pTCPUDPIP->SendIGMPReport();
+		}
 #else
 		pShell->printf("[INFO] Skipping multicast address delete in emulation mode\n");
 #endif
@@ -716,6 +751,227 @@ static int TCP_UDP_IP_DeleteAllListeningPorts(Shell* pShell, int argc, char* arg
 
 
 
+static int TCP_UDP_IP_SetGroupFilterEnabled(Shell* pShell, int argc, char* argv[], void* pObjectData)
+{
+	int retval = XLNX_OK;
+	bool bOKToContinue = true;
+	TCPUDPIP* pTCPUDPIP;
+	bool bEnabled = false;
+
+	pTCPUDPIP = (TCPUDPIP*)pObjectData;
+
+	if (argc != 2)
+	{
+		pShell->printf("Usage: %s <bool>\n", argv[0]);
+		bOKToContinue = false;
+	}
+
+	if (bOKToContinue)
+	{
+		bOKToContinue = pShell->parseBool(argv[1], &bEnabled);
+		if (bOKToContinue == false)
+		{
+			pShell->printf("[ERROR] Failed to parse bool parameter\n");
+		}
+	}
+
+
+
+	if (bOKToContinue)
+	{
+		retval = pTCPUDPIP->SetUDPGroupFilterEnabled(bEnabled);
+
+		if (retval == XLNX_OK)
+		{
+			pShell->printf("OK\n");
+		}
+		else
+		{
+			bOKToContinue = false;
+			pShell->printf("[ERROR] retval = %s (0x%08X)\n", TCP_UDP_IP_ErrorCodeToString(retval), retval);
+		}
+	}
+
+	if (bOKToContinue == false)
+	{
+		retval = Shell::COMMAND_PARSING_ERROR;
+	}
+
+
+	return retval;
+}
+
+
+
+
+
+
+
+
+
+static int TCP_UDP_IP_AddMulticastGroup(Shell* pShell, int argc, char* argv[], void* pObjectData)
+{
+	int retval = 0;
+	bool bOKToContinue = true;
+	TCPUDPIP* pTCPUDPIP;
+	uint8_t dottedQuad[4];
+	uint16_t port;
+
+
+	pTCPUDPIP = (TCPUDPIP*)pObjectData;
+
+
+	if (argc != 3)
+	{
+		pShell->printf("Usage: %s <ipaddr> <portnum>\n", argv[0]);
+		bOKToContinue = false;
+	}
+
+
+	if (bOKToContinue)
+	{
+		bOKToContinue = ParseIPv4Address(pShell, argv[1], &dottedQuad[0], &dottedQuad[1], &dottedQuad[2], &dottedQuad[3]);
+	}
+
+	if (bOKToContinue)
+	{
+		bOKToContinue = ParsePort(pShell, argv[2], &port);
+	}
+
+
+	if (bOKToContinue)
+	{
+		retval = pTCPUDPIP->AddUDPMulticastGroup(dottedQuad[0], dottedQuad[1], dottedQuad[2], dottedQuad[3], port);
+
+		if (retval == XLNX_OK)
+		{
+			pShell->printf("OK\n");
+		}
+		else
+		{
+			bOKToContinue = false;
+			pShell->printf("[ERROR] retval = %s (0x%08X)\n", TCP_UDP_IP_ErrorCodeToString(retval), retval);
+		}
+	}
+
+	if (bOKToContinue == false)
+	{
+		retval = Shell::COMMAND_PARSING_ERROR;
+	}
+
+
+	return retval;
+}
+
+
+
+
+
+
+
+
+
+static int TCP_UDP_IP_DeleteMulticastGroup(Shell* pShell, int argc, char* argv[], void* pObjectData)
+{
+	int retval = 0;
+	bool bOKToContinue = true;
+	TCPUDPIP* pTCPUDPIP;
+	uint8_t dottedQuad[4];
+	uint16_t port;
+
+
+	pTCPUDPIP = (TCPUDPIP*)pObjectData;
+
+
+	if (argc != 3)
+	{
+		pShell->printf("Usage: %s <ipaddr> <portnum>\n", argv[0]);
+		bOKToContinue = false;
+	}
+
+
+	if (bOKToContinue)
+	{
+		bOKToContinue = ParseIPv4Address(pShell, argv[1], &dottedQuad[0], &dottedQuad[1], &dottedQuad[2], &dottedQuad[3]);
+	}
+
+	if (bOKToContinue)
+	{
+		bOKToContinue = ParsePort(pShell, argv[2], &port);
+	}
+
+
+	if (bOKToContinue)
+	{
+		retval = pTCPUDPIP->DeleteUDPMulticastGroup(dottedQuad[0], dottedQuad[1], dottedQuad[2], dottedQuad[3], port);
+
+		if (retval == XLNX_OK)
+		{
+			pShell->printf("OK\n");
+		}
+		else
+		{
+			bOKToContinue = false;
+			pShell->printf("[ERROR] retval = %s (0x%08X)\n", TCP_UDP_IP_ErrorCodeToString(retval), retval);
+		}
+	}
+
+	if (bOKToContinue == false)
+	{
+		retval = Shell::COMMAND_PARSING_ERROR;
+	}
+
+
+	return retval;
+}
+
+
+
+
+
+
+static int TCP_UDP_IP_DeleteAllMulticastGroups(Shell* pShell, int argc, char* argv[], void* pObjectData)
+{
+	int retval = 0;
+	bool bOKToContinue = true;
+	TCPUDPIP* pTCPUDPIP;
+
+	XLNX_UNUSED_ARG(argc);
+	XLNX_UNUSED_ARG(argv);
+
+	pTCPUDPIP = (TCPUDPIP*)pObjectData;
+
+
+
+	if (bOKToContinue)
+	{
+		retval = pTCPUDPIP->DeleteAllUDPMulticastGroups();
+
+		if (retval == XLNX_OK)
+		{
+			pShell->printf("OK\n");
+		}
+		else
+		{
+			bOKToContinue = false;
+			pShell->printf("[ERROR] retval = %s (0x%08X)\n", TCP_UDP_IP_ErrorCodeToString(retval), retval);
+		}
+	}
+
+	if (bOKToContinue == false)
+	{
+		retval = Shell::COMMAND_PARSING_ERROR;
+	}
+
+
+	return retval;
+}
+
+
+
+
+
+
 
 
 static int TCP_UDP_IP_SetICMPEnabled(Shell* pShell, int argc, char* argv[], void* pObjectData)
@@ -896,12 +1152,14 @@ static int TCP_UDP_IP_PrintStats(Shell* pShell, int argc, char* argv[], void* pO
 			pShell->printf("| UDP   | Datagrams Tx               | %10u |\n", statsCounters.udp.numTxDatagrams);
 			pShell->printf("|       | Datagrams Rx               | %10u |\n", statsCounters.udp.numRxDatagrams);
 			pShell->printf("|       | Datagrams Rx Invalid Port  | %10u |\n", statsCounters.udp.numRxDatagramsInvalidPort);
+			pShell->printf("|       | Datagrams Rx Invalid Group | %10u |\n", statsCounters.udp.numRxDatagramsInvalidGroup);
 		}
 		else
 		{
 			pShell->printf("| UDP   | Datagrams Tx               | %10s |\n", NOT_AVAILABLE_STRING);
 			pShell->printf("|       | Datagrams Rx               | %10s |\n", NOT_AVAILABLE_STRING);
 			pShell->printf("|       | Datagrams Rx Invalid Port  | %10s |\n", NOT_AVAILABLE_STRING);
+			pShell->printf("|       | Datagrams Rx Invalid Group | %10s |\n", NOT_AVAILABLE_STRING);
 		}
 		
 		pShell->printf("+-------+----------------------------+------------+\n");
@@ -1486,6 +1744,70 @@ static int TCP_UDP_IP_GetStatus(Shell* pShell, int argc, char* argv[], void* pOb
 
 
 
+	if (retval == XLNX_OK)
+	{
+		if (bUDPSynthesized)
+		{
+			uint32_t groupAddresses[TCPUDPIP::NUM_UDP_MULTICAST_GROUPS_SUPPORTED];
+			uint16_t groupPorts[TCPUDPIP::NUM_UDP_MULTICAST_GROUPS_SUPPORTED];
+			uint32_t numGroups = 0;
+			bool bGroupFilterEnabled = false;
+			uint32_t udpCapabilities = 0;
+
+			retval = pTCPUDPIP->GetUDPCapabilities(&udpCapabilities);
+
+			if ((retval == XLNX_OK) && ((udpCapabilities & TCPUDPIP::CAPABILITY_UDP_GROUP_FILTER) == 0))
+			{
+				pShell->printf("\n\n");
+
+				pShell->printf("+-----------------------------+\n");
+				pShell->printf("| %-27s |\n", "UDP Multicast Groups");
+				pShell->printf("+-----------------------------+\n");
+				pShell->printf("| %-27s |\n", "Not Supported By HW");
+				pShell->printf("+-----------------------------+\n");
+			}
+			else if (retval == XLNX_OK)
+			{
+				retval = pTCPUDPIP->GetUDPGroupFilterEnabled(&bGroupFilterEnabled);
+
+				if (retval == XLNX_OK)
+				{
+					retval = pTCPUDPIP->GetUDPMulticastGroups(groupAddresses, groupPorts, &numGroups);
+				}
+			}
+
+			if ((retval == XLNX_OK) && (udpCapabilities & TCPUDPIP::CAPABILITY_UDP_GROUP_FILTER))
+			{
+				pShell->printf("\n\n");
+
+				pShell->printf("+-----------------------------+\n");
+				pShell->printf("| UDP Multicast Groups (%-5s)|\n", pShell->boolToString(bGroupFilterEnabled));
+				pShell->printf("+-----------------------------+\n");
+
+				if (numGroups > 0)
+				{
+					for (uint32_t i = 0; i < numGroups; i++)
+					{
+						pShell->printf("| %3u.%3u.%3u.%3u : %-9u |\n", (groupAddresses[i] >> 24) & 0xFF,
+																		  (groupAddresses[i] >> 16) & 0xFF,
+																		  (groupAddresses[i] >> 8) & 0xFF,
+																		  groupAddresses[i] & 0xFF,
+																		  groupPorts[i]);
+					}
+				}
+				else
+				{
+					pShell->printf("| %-27s |\n", "No Groups Configured");
+				}
+
+				pShell->printf("+-----------------------------+\n");
+			}
+		}
+	}
+
+
+
+
 
 
 
@@ -1567,14 +1889,18 @@ CommandTableElement XLNX_TCP_UDP_IP_COMMAND_TABLE[] =
 	{"setigmp",				TCP_UDP_IP_SetIGMPEnabled,					"<bool>",				"Enable/disable IGMP"						},
 	{"setigmpver",			TCP_UDP_IP_SetIGMPVersion,					"<ver>",				"Set the IGMP version (2 or 3)"				},
 	{"igmpprint",			TCP_UDP_IP_PrintIGMPTable,					"",						"Print the contents of the IGMP table"		},
-	{"addmcast",			TCP_UDP_IP_AddMulticastIPv4Address,			"<ipaddr>",				"Add a multicast IP address"				},
-	{"deletemcast",			TCP_UDP_IP_DeleteMulticastIP4vAddress,		"<ipaddr>",				"Delete a multicast IP address"				},
+	{"addmcast",			TCP_UDP_IP_AddMulticastIPv4Address,			"<ipaddr> [...]",		"Add multicast IP addresses"				},
+	{"deletemcast",			TCP_UDP_IP_DeleteMulticastIP4vAddress,		"<ipaddr> [...]",		"Delete multicast IP addresses"				},
 	{/*-----------------------------------------------------------------------------------------------------------------------------------*/},
 	{"seticmp",				TCP_UDP_IP_SetICMPEnabled,					"<bool>",				"Enable/disable ICMP"						},
 	{/*-----------------------------------------------------------------------------------------------------------------------------------*/},
 	{"addport",				TCP_UDP_IP_AddListeningPort,				"<portnum>",			"Add a UDP listening port"					},
 	{"deleteport",			TCP_UDP_IP_DeleteListeningPort,				"<portnum>",			"Delete a UDP listening port"				},
 	{"deleteallports",		TCP_UDP_IP_DeleteAllListeningPorts,			"",						"Deletes ALL UDP listening ports"			},
+	{"setgroupfilter",		TCP_UDP_IP_SetGroupFilterEnabled,			"<bool>",				"Enable/disable UDP multicast group filter"	},
+	{"addgroup",			TCP_UDP_IP_AddMulticastGroup,				"<ipaddr> <portnum>",	"Add a UDP multicast group"					},
+	{"deletegroup",			TCP_UDP_IP_DeleteMulticastGroup,			"<ipaddr> <portnum>",	"Delete a UDP multicast group"				},
+	{"deleteallgroups",		TCP_UDP_IP_DeleteAllMulticastGroups,		"",						"Deletes ALL UDP multicast groups"			},
 	{/*-----------------------------------------------------------------------------------------------------------------------------------*/},
 	{"arpprint",			TCP_UDP_IP_PrintARPTable,					"",						"Print the contents of the ARP table"		},
 	{"arpadd",				TCP_UDP_IP_AddARPEntry,						"<ipaddr> <macaddr>",	"Add an ARP entry"							},
@@ -0,0 +1,438 @@
+/*
+ * Copyright 2021 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+
+#include "xlnx_shell_telemetry.h"
+#include "xlnx_shell_utils.h"
+
+#include "xlnx_telemetry.h"
+#include "xlnx_telemetry_error_codes.h"
+using namespace XLNX;
+
+
+
+
+
+
+
+
+#define STR_CASE(TAG)	case(TAG):					\
+                        {							\
+                            pString = (char*) #TAG;	\
+                            break;					\
+                        }
+
+
+static const char* LINE_STRING = "--------------------------------------------------------------------------------------------------";
+
+
+#define DEFAULT_INTERVAL_MILLISECONDS       (100)
+
+
+
+char* Telemetry_ErrorCodeToString(uint32_t errorCode)
+{
+    char* pString;
+
+    switch (errorCode)
+    {
+        STR_CASE(XLNX_OK)
+        STR_CASE(XLNX_TELEMETRY_ERROR_NOT_INITIALISED)
+        STR_CASE(XLNX_TELEMETRY_ERROR_INVALID_PARAMETER)
+        STR_CASE(XLNX_TELEMETRY_ERROR_TOO_MANY_BLOCKS)
+        STR_CASE(XLNX_TELEMETRY_ERROR_TOO_MANY_WORDS)
+        STR_CASE(XLNX_TELEMETRY_ERROR_BLOCK_NOT_FOUND)
+        STR_CASE(XLNX_TELEMETRY_ERROR_ALREADY_RUNNING)
+        STR_CASE(XLNX_TELEMETRY_ERROR_FAILED_TO_CREATE_SHARED_MEMORY)
+        STR_CASE(XLNX_TELEMETRY_ERROR_FAILED_TO_OPEN_SHARED_MEMORY)
+        STR_CASE(XLNX_TELEMETRY_ERROR_INCOMPATIBLE_SHARED_MEMORY)
+        STR_CASE(XLNX_TELEMETRY_ERROR_NO_SNAPSHOT)
+        STR_CASE(XLNX_TELEMETRY_ERROR_SNAPSHOT_BUSY)
+        STR_CASE(XLNX_TELEMETRY_ERROR_BUFFER_TOO_SMALL)
+        STR_CASE(XLNX_TELEMETRY_ERROR_DEVICE_READ_FAILED)
+        STR_CASE(XLNX_TELEMETRY_ERROR_TOO_MANY_METRICS)
+        STR_CASE(XLNX_TELEMETRY_ERROR_METRIC_NOT_FOUND)
+        STR_CASE(XLNX_TELEMETRY_ERROR_SERVER_ALREADY_RUNNING)
+        STR_CASE(XLNX_TELEMETRY_ERROR_FAILED_TO_START_SERVER)
+        STR_CASE(XLNX_TELEMETRY_ERROR_NOT_RUNNING)
+
+        default:
+        {
+            pString = (char*)"UKNOWN_ERROR";
+            break;
+        }
+    }
+
+    return pString;
+}
+
+
+
+
+
+static int Telemetry_GetStatus(Shell* pShell, int argc, char* argv[], void* pObjectData)
+{
+    int retval = XLNX_OK;
+    Telemetry* pTelemetry = (Telemetry*)pObjectData;
+    Telemetry::Stats stats;
+    TelemetryReader* pReader;
+    const char* pName;
+    bool bIsRunning;
+    uint32_t intervalMilliseconds;
+    uint32_t numBlocks;
+    uint32_t numSpans;
+    uint32_t numWords;
+    uint64_t sequence;
+
+    XLNX_UNUSED_ARG(argc);
+    XLNX_UNUSED_ARG(argv);
+
+
+    retval = pTelemetry->GetSharedMemoryName(&pName);
+
+    if (retval == XLNX_OK)
+    {
+        pTelemetry->IsRunning(&bIsRunning);
+        pTelemetry->GetInterval(&intervalMilliseconds);
+        pTelemetry->GetNumBlocks(&numBlocks);
+        pTelemetry->GetNumSpans(&numSpans);
+        pTelemetry->GetNumDataWords(&numWords);
+        pTelemetry->GetStats(&stats);
+        pTelemetry->GetReader(&pReader);
+        pReader->GetSequence(&sequence);
+
+        pShell->printf("+-%.35s-+-%.20s-+\n", LINE_STRING, LINE_STRING);
+        pShell->printf("| %-35s | %20s |\n", "Shared Memory", pName);
+        pShell->printf("| %-35s | %20s |\n", "Is Running", pShell->boolToString(bIsRunning));
+        pShell->printf("| %-35s | %20u |\n", "Interval (ms)", intervalMilliseconds);
+        pShell->printf("+-%.35s-+-%.20s-+\n", LINE_STRING, LINE_STRING);
+        pShell->printf("| %-35s | %20u |\n", "Blocks", numBlocks);
+        pShell->printf("| %-35s | %20u |\n", "Device Reads per Snapshot", numSpans);
+        pShell->printf("| %-35s | %20u |\n", "Words per Snapshot", numWords);
+        pShell->printf("+-%.35s-+-%.20s-+\n", LINE_STRING, LINE_STRING);
+        pShell->printf("| %-35s | %20" PRIu64 " |\n", "Latest Sequence", sequence);
+        pShell->printf("| %-35s | %20" PRIu64 " |\n", "Snapshots", stats.numSnapshots);
+        pShell->printf("| %-35s | %20" PRIu64 " |\n", "Device Reads", stats.numDeviceReads);
+        pShell->printf("| %-35s | %20" PRIu64 " |\n", "Device Read Errors", stats.numDeviceReadErrors);
+        pShell->printf("| %-35s | %20.3f |\n", "Last Snapshot (us)", (double)stats.lastSnapshotNanoseconds / 1000.0);
+        pShell->printf("| %-35s | %20.3f |\n", "Max Snapshot (us)", (double)stats.maxSnapshotNanoseconds / 1000.0);
+        pShell->printf("+-%.35s-+-%.20s-+\n", LINE_STRING, LINE_STRING);
+    }
+
+
+    if (retval != XLNX_OK)
+    {
+        pShell->printf("[ERROR] retval = %s (0x%08X)\n", Telemetry_ErrorCodeToString(retval), retval);
+    }
+
+    return retval;
+}
+
+
+
+
+
+static int Telemetry_Start(Shell* pShell, int argc, char* argv[], void* pObjectData)
+{
+    int retval = XLNX_OK;
+    Telemetry* pTelemetry = (Telemetry*)pObjectData;
+    bool bOKToContinue = true;
+    uint32_t intervalMilliseconds = DEFAULT_INTERVAL_MILLISECONDS;
+
+    if (argc > 2)
+    {
+        pShell->printf("Usage: %s [milliseconds]\n", argv[0]);
+        bOKToContinue = false;
+    }
+
+
+    if (bOKToContinue && (argc == 2))
+    {
+        bOKToContinue = pShell->parseUInt32(argv[1], &intervalMilliseconds);
+        if (bOKToContinue == false)
+        {
+            pShell->printf("[ERROR] Failed to parse milliseconds parameter\n");
+        }
+    }
+
+
+    if (bOKToContinue)
+    {
+        retval = pTelemetry->Start(intervalMilliseconds);
+
+        if (retval == XLNX_OK)
+        {
+            pShell->printf("OK\n");
+        }
+        else
+        {
+            pShell->printf("[ERROR] retval = %s (0x%08X)\n", Telemetry_ErrorCodeToString(retval), retval);
+        }
+    }
+
+    return retval;
+}
+
+
+
+
+
+static int Telemetry_Stop(Shell* pShell, int argc, char* argv[], void* pObjectData)
+{
+    int retval = XLNX_OK;
+    Telemetry* pTelemetry = (Telemetry*)pObjectData;
+
+    XLNX_UNUSED_ARG(argc);
+    XLNX_UNUSED_ARG(argv);
+
+    retval = pTelemetry->Stop();
+
+    if (retval == XLNX_OK)
+    {
+        pShell->printf("OK\n");
+    }
+    else
+    {
+        pShell->printf("[ERROR] retval = %s (0x%08X)\n", Telemetry_ErrorCodeToString(retval), retval);
+    }
+
+    return retval;
+}
+
+
+
+
+
+static int Telemetry_Snapshot(Shell* pShell, int argc, char* argv[], void* pObjectData)
+{
+    int retval = XLNX_OK;
+    Telemetry* pTelemetry = (Telemetry*)pObjectData;
+
+    XLNX_UNUSED_ARG(argc);
+    XLNX_UNUSED_ARG(argv);
+
+    retval = pTelemetry->Snapshot();
+
+    if (retval == XLNX_OK)
+    {
+        pShell->printf("OK\n");
+    }
+    else
+    {
+        pShell->printf("[ERROR] retval = %s (0x%08X)\n", Telemetry_ErrorCodeToString(retval), retval);
+    }
+
+    return retval;
+}
+
+
+
+
+
+static int Telemetry_ListBlocks(Shell* pShell, int argc, char* argv[], void* pObjectData)
+{
+    int retval = XLNX_OK;
+    Telemetry* pTelemetry = (Telemetry*)pObjectData;
+    TelemetryReader* pReader;
+    TelemetrySharedBlock blockInfo;
+    uint32_t numBlocks = 0;
+    uint32_t i;
+
+    XLNX_UNUSED_ARG(argc);
+    XLNX_UNUSED_ARG(argv);
+
+    retval = pTelemetry->GetReader(&pReader);
+
+    if (retval == XLNX_OK)
+    {
+        retval = pReader->GetNumBlocks(&numBlocks);
+    }
+
+
+    if (retval == XLNX_OK)
+    {
+        pShell->printf("+-%.31s-+-%.18s-+-%.8s-+\n", LINE_STRING, LINE_STRING, LINE_STRING);
+        pShell->printf("| %-31s | %-18s | %8s |\n", "Block", "Address", "Words");
+        pShell->printf("+-%.31s-+-%.18s-+-%.8s-+\n", LINE_STRING, LINE_STRING, LINE_STRING);
+
+        for (i = 0; i < numBlocks; i++)
+        {
+            if (pReader->GetBlockInfo(i, &blockInfo) == XLNX_OK)
+            {
+                pShell->printf("| %-31s | 0x%016" PRIX64 " | %8u |\n", blockInfo.name, blockInfo.address, blockInfo.numWords);
+            }
+        }
+
+        pShell->printf("+-%.31s-+-%.18s-+-%.8s-+\n", LINE_STRING, LINE_STRING, LINE_STRING);
+    }
+    else
+    {
+        pShell->printf("[ERROR] retval = %s (0x%08X)\n", Telemetry_ErrorCodeToString(retval), retval);
+    }
+
+    return retval;
+}
+
+
+
+
+
+static void Telemetry_PrintBlock(Shell* pShell, TelemetrySharedBlock* pBlockInfo, TelemetrySharedBuffer* pSnapshot)
+{
+    uint32_t i;
+    uint32_t value;
+
+    pShell->printf("+-%.18s-+-%.10s-+-%.10s-+\n", LINE_STRING, LINE_STRING, LINE_STRING);
+    pShell->printf("| %-44s |\n", pBlockInfo->name);
+    pShell->printf("+-%.18s-+-%.10s-+-%.10s-+\n", LINE_STRING, LINE_STRING, LINE_STRING);
+
+    for (i = 0; i < pBlockInfo->numWords; i++)
+    {
+        value = pSnapshot->data[pBlockInfo->dataWordOffset + i];
+
+        pShell->printf("| 0x%016" PRIX64 " | 0x%08X | %10u |\n", pBlockInfo->address + (i * sizeof(uint32_t)), value, value);
+    }
+
+    pShell->printf("+-%.18s-+-%.10s-+-%.10s-+\n", LINE_STRING, LINE_STRING, LINE_STRING);
+}
+
+
+
+
+
+static int Telemetry_Dump(Shell* pShell, int argc, char* argv[], void* pObjectData)
+{
+    int retval = XLNX_OK;
+    Telemetry* pTelemetry = (Telemetry*)pObjectData;
+    TelemetryReader* pReader;
+    TelemetrySharedBlock blockInfo;
+    static TelemetrySharedBuffer snapshot;
+    uint32_t numBlocks = 0;
+    uint32_t blockIndex;
+    uint32_t i;
+    bool bOKToContinue = true;
+
+    if (argc > 2)
+    {
+        pShell->printf("Usage: %s [block]\n", argv[0]);
+        bOKToContinue = false;
+    }
+
+
+    if (bOKToContinue)
+    {
+        retval = pTelemetry->GetReader(&pReader);
+    }
+
+
+    //NOTE - everything printed comes from the latest published snapshot, the device is not accessed here
+    if (bOKToContinue && (retval == XLNX_OK))
+    {
+        retval = pReader->ReadSnapshot(&snapshot);
+    }
+
+
+    if (bOKToContinue && (retval == XLNX_OK))
+    {
+        pShell->printf("Sequence = %" PRIu64 ", Status = 0x%08X\n", snapshot.sequence, snapshot.status);
+
+        if (argc == 2)
+        {
+            retval = pReader->FindBlock(argv[1], &blockIndex);
+
+            if (retval == XLNX_OK)
+            {
+                retval = pReader->GetBlockInfo(blockIndex, &blockInfo);
+            }
+
+            if (retval == XLNX_OK)
+            {
+                Telemetry_PrintBlock(pShell, &blockInfo, &snapshot);
+            }
+        }
+        else
+        {
+            pReader->GetNumBlocks(&numBlocks);
+
+            for (i = 0; i < numBlocks; i++)
+            {
+                if (pReader->GetBlockInfo(i, &blockInfo) == XLNX_OK)
+                {
+                    Telemetry_PrintBlock(pShell, &blockInfo, &snapshot);
+                }
+            }
+        }
+    }
+
+
+    if (retval != XLNX_OK)
+    {
+        pShell->printf("[ERROR] retval = %s (0x%08X)\n", Telemetry_ErrorCodeToString(retval), retval);
+    }
+
+    return retval;
+}
+
+
+
+
+
+static int Telemetry_ResetStats(Shell* pShell, int argc, char* argv[], void* pObjectData)
+{
+    int retval = XLNX_OK;
+    Telemetry* pTelemetry = (Telemetry*)pObjectData;
+
+    XLNX_UNUSED_ARG(argc);
+    XLNX_UNUSED_ARG(argv);
+
+    retval = pTelemetry->ResetStats();
+
+    if (retval == XLNX_OK)
+    {
+        pShell->printf("OK\n");
+    }
+    else
+    {
+        pShell->printf("[ERROR] retval = %s (0x%08X)\n", Telemetry_ErrorCodeToString(retval), retval);
+    }
+
+    return retval;
+}
+
+
+
+
+
+
+
+
+CommandTableElement XLNX_TELEMETRY_COMMAND_TABLE[] =
+{
+    {"getstatus",	        Telemetry_GetStatus,	        "",			                    "Get telemetry sampler status"	                },
+    {"start",               Telemetry_Start,                "[milliseconds]",               "Start periodic register snapshots"             },
+    {"stop",                Telemetry_Stop,                 "",                             "Stop periodic register snapshots"              },
+    {"snapshot",            Telemetry_Snapshot,             "",                             "Take a single register snapshot now"           },
+    {/*-----------------------------------------------------------------------------------------------------------------------------------*/},
+    {"listblocks",          Telemetry_ListBlocks,           "",                             "List the register blocks being sampled"        },
+    {"dump",                Telemetry_Dump,                 "[block]",                      "Print the latest snapshot"                     },
+    {/*-----------------------------------------------------------------------------------------------------------------------------------*/},
+    {"resetstats",          Telemetry_ResetStats,           "",                             "Reset sampler stats"                           }
+
+};
+
+
+const uint32_t XLNX_TELEMETRY_COMMAND_TABLE_LENGTH = (uint32_t)(sizeof(XLNX_TELEMETRY_COMMAND_TABLE) / sizeof(XLNX_TELEMETRY_COMMAND_TABLE[0]));
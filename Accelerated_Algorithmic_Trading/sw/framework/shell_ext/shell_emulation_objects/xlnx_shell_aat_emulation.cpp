@@ -0,0 +1,315 @@
+/*
+ * Copyright 2021 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+
+#include "xlnx_shell_aat_emulation.h"
+#include "xlnx_shell_utils.h"
+
+#include "xlnx_aat_emulation.h"
+#include "xlnx_aat_emulation_error_codes.h"
+using namespace XLNX;
+
+
+
+
+
+
+
+
+#define STR_CASE(TAG)	case(TAG):					\
+                        {							\
+                            pString = (char*) #TAG;	\
+                            break;					\
+                        }
+
+
+static const char* LINE_STRING = "--------------------------------------------------------------------------------------------------";
+
+
+char* AATEmulation_ErrorCodeToString(uint32_t errorCode)
+{
+    char* pString;
+
+    switch (errorCode)
+    {
+        STR_CASE(XLNX_OK)
+        STR_CASE(XLNX_AAT_EMULATION_ERROR_NOT_INITIALISED)
+        STR_CASE(XLNX_AAT_EMULATION_ERROR_INVALID_PARAMETER)
+        STR_CASE(XLNX_AAT_EMULATION_ERROR_FAILED_TO_ADD_CU)
+        STR_CASE(XLNX_AAT_EMULATION_ERROR_ALREADY_RUNNING)
+        STR_CASE(XLNX_AAT_EMULATION_ERROR_NOT_RUNNING)
+        STR_CASE(XLNX_AAT_EMULATION_ERROR_NO_SOURCE)
+        STR_CASE(XLNX_AAT_EMULATION_ERROR_FAILED_TO_OPEN_SOURCE)
+
+        default:
+        {
+            pString = (char*)"UKNOWN_ERROR";
+            break;
+        }
+    }
+
+    return pString;
+}
+
+
+
+
+
+static int AATEmulation_GetStatus(Shell* pShell, int argc, char* argv[], void* pObjectData)
+{
+    int retval = XLNX_OK;
+    AATEmulation* pEmulation = (AATEmulation*)pObjectData;
+    AATEmulation::Stats stats;
+    bool bIsInitialised;
+    bool bIsRunning;
+    const char* pSource;
+    uint32_t numLoops;
+    double elapsedSeconds;
+
+    XLNX_UNUSED_ARG(argc);
+    XLNX_UNUSED_ARG(argv);
+
+
+
+    pEmulation->IsInitialised(&bIsInitialised);
+
+    if (bIsInitialised == false)
+    {
+        retval = XLNX_AAT_EMULATION_ERROR_NOT_INITIALISED;
+    }
+
+
+
+    if (retval == XLNX_OK)
+    {
+        retval = pEmulation->GetStats(&stats);
+    }
+
+
+
+    if (retval == XLNX_OK)
+    {
+        pEmulation->IsRunning(&bIsRunning);
+        pEmulation->GetSource(&pSource);
+        pEmulation->GetSourceLoops(&numLoops);
+
+        elapsedSeconds = (double)stats.elapsedNanoseconds / 1000000000.0;
+
+        pShell->printf("+-%.35s-+-%.20s-+\n", LINE_STRING, LINE_STRING);
+        pShell->printf("| %-35s | %20s |\n", "Source", pSource);
+        pShell->printf("| %-35s | %20u |\n", "Source Loops (0 = forever)", numLoops);
+        pShell->printf("| %-35s | %20s |\n", "Is Running", pShell->boolToString(bIsRunning));
+        pShell->printf("+-%.35s-+-%.20s-+\n", LINE_STRING, LINE_STRING);
+        pShell->printf("| %-35s | %20" PRIu64 " |\n", "Packets Injected", stats.numPacketsInjected);
+        pShell->printf("| %-35s | %20" PRIu64 " |\n", "Bytes Injected", stats.numBytesInjected);
+        pShell->printf("| %-35s | %20" PRIu64 " |\n", "Loops Completed", stats.numSourceLoops);
+        pShell->printf("| %-35s | %20" PRIu64 " |\n", "Packets Dropped", stats.numSourceDrops);
+        pShell->printf("+-%.35s-+-%.20s-+\n", LINE_STRING, LINE_STRING);
+        pShell->printf("| %-35s | %20" PRIu64 " |\n", "FeedHandler -> OrderBook", stats.numFeedOperations);
+        pShell->printf("| %-35s | %20" PRIu64 " |\n", "OrderBook -> RiskEngine", stats.numBookResponses);
+        pShell->printf("| %-35s | %20" PRIu64 " |\n", "OrderBook -> DataMover", stats.numDataMoverResponses);
+        pShell->printf("| %-35s | %20" PRIu64 " |\n", "PricingEngine -> RiskEngine", stats.numPricingOperations);
+        pShell->printf("| %-35s | %20" PRIu64 " |\n", "RiskEngine -> OrderEntry", stats.numRiskOperations);
+        pShell->printf("| %-35s | %20" PRIu64 " |\n", "DataMover -> OrderEntry (host)", stats.numHostOperations);
+        pShell->printf("+-%.35s-+-%.20s-+\n", LINE_STRING, LINE_STRING);
+        pShell->printf("| %-35s | %20u |\n", "TCP Connections", stats.numConnections);
+        pShell->printf("| %-35s | %20" PRIu64 " |\n", "TX Messages", stats.numTxMessages);
+        pShell->printf("| %-35s | %20" PRIu64 " |\n", "TX Bytes", stats.numTxBytes);
+        pShell->printf("+-%.35s-+-%.20s-+\n", LINE_STRING, LINE_STRING);
+        pShell->printf("| %-35s | %20.3f |\n", "Elapsed (seconds)", elapsedSeconds);
+
+        if (stats.elapsedNanoseconds > 0)
+        {
+            pShell->printf("| %-35s | %20.0f |\n", "Packets/sec", (double)stats.numPacketsInjected / elapsedSeconds);
+        }
+
+        pShell->printf("+-%.35s-+-%.20s-+\n", LINE_STRING, LINE_STRING);
+    }
+
+
+
+    if (retval != XLNX_OK)
+    {
+        pShell->printf("[ERROR] retval = %s (0x%08X)\n", AATEmulation_ErrorCodeToString(retval), retval);
+    }
+
+
+    return retval;
+}
+
+
+
+
+
+static int AATEmulation_Start(Shell* pShell, int argc, char* argv[], void* pObjectData)
+{
+    int retval = XLNX_OK;
+    AATEmulation* pEmulation = (AATEmulation*)pObjectData;
+    bool bOKToContinue = true;
+
+    if (argc > 2)
+    {
+        pShell->printf("Usage: %s [source]\n", argv[0]);
+        bOKToContinue = false;
+    }
+
+
+    if (bOKToContinue)
+    {
+        if (argc == 2)
+        {
+            retval = pEmulation->SetSource(argv[1]);
+        }
+
+        if (retval == XLNX_OK)
+        {
+            retval = pEmulation->Start();
+        }
+
+        if (retval == XLNX_OK)
+        {
+            pShell->printf("OK\n");
+        }
+        else
+        {
+            pShell->printf("[ERROR] retval = %s (0x%08X)\n", AATEmulation_ErrorCodeToString(retval), retval);
+        }
+    }
+
+    return retval;
+}
+
+
+
+
+
+static int AATEmulation_Stop(Shell* pShell, int argc, char* argv[], void* pObjectData)
+{
+    int retval = XLNX_OK;
+    AATEmulation* pEmulation = (AATEmulation*)pObjectData;
+
+    XLNX_UNUSED_ARG(argc);
+    XLNX_UNUSED_ARG(argv);
+
+    retval = pEmulation->Stop();
+
+    if (retval == XLNX_OK)
+    {
+        pShell->printf("OK\n");
+    }
+    else
+    {
+        pShell->printf("[ERROR] retval = %s (0x%08X)\n", AATEmulation_ErrorCodeToString(retval), retval);
+    }
+
+    return retval;
+}
+
+
+
+
+
+static int AATEmulation_SetSource(Shell* pShell, int argc, char* argv[], void* pObjectData)
+{
+    int retval = XLNX_OK;
+    AATEmulation* pEmulation = (AATEmulation*)pObjectData;
+
+    if (argc != 2)
+    {
+        pShell->printf("Usage: %s <pcapfile | udp:[group:]port>\n", argv[0]);
+    }
+    else
+    {
+        retval = pEmulation->SetSource(argv[1]);
+
+        if (retval == XLNX_OK)
+        {
+            pShell->printf("OK\n");
+        }
+        else
+        {
+            pShell->printf("[ERROR] retval = %s (0x%08X)\n", AATEmulation_ErrorCodeToString(retval), retval);
+        }
+    }
+
+    return retval;
+}
+
+
+
+
+
+static int AATEmulation_SetLoops(Shell* pShell, int argc, char* argv[], void* pObjectData)
+{
+    int retval = XLNX_OK;
+    AATEmulation* pEmulation = (AATEmulation*)pObjectData;
+    bool bOKToContinue = true;
+    uint32_t numLoops;
+
+    if (argc != 2)
+    {
+        pShell->printf("Usage: %s <loops>\n", argv[0]);
+        bOKToContinue = false;
+    }
+
+
+    if (bOKToContinue)
+    {
+        bOKToContinue = pShell->parseUInt32(argv[1], &numLoops);
+        if (bOKToContinue == false)
+        {
+            pShell->printf("[ERROR] Failed to parse loops parameter\n");
+        }
+    }
+
+
+    if (bOKToContinue)
+    {
+        retval = pEmulation->SetSourceLoops(numLoops);
+        if (retval == XLNX_OK)
+        {
+            pShell->printf("OK\n");
+        }
+        else
+        {
+            pShell->printf("[ERROR] retval = %s (0x%08X)\n", AATEmulation_ErrorCodeToString(retval), retval);
+        }
+    }
+
+    return retval;
+}
+
+
+
+
+
+
+
+
+CommandTableElement XLNX_AAT_EMULATION_COMMAND_TABLE[] =
+{
+    {"getstatus",	        AATEmulation_GetStatus,	        "",			                    "Get emulated pipeline status"	                },
+    {"start",               AATEmulation_Start,             "[source]",                     "Start feeding the emulated FeedHandler"        },
+    {"stop",                AATEmulation_Stop,              "",                             "Stop feeding the emulated FeedHandler"         },
+    {/*-----------------------------------------------------------------------------------------------------------------------------------*/},
+    {"setsource",           AATEmulation_SetSource,         "<pcapfile | udp:[group:]port>","Sets the market data source"                   },
+    {"setloops",            AATEmulation_SetLoops,          "<loops>",                      "PCAP replay count (0 = forever)"               }
+
+};
+
+
+const uint32_t XLNX_AAT_EMULATION_COMMAND_TABLE_LENGTH = (uint32_t)(sizeof(XLNX_AAT_EMULATION_COMMAND_TABLE) / sizeof(XLNX_AAT_EMULATION_COMMAND_TABLE[0]));
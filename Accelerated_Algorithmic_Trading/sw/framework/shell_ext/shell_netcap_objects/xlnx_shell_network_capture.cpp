@@ -14,6 +14,8 @@
  * limitations under the License.
  */
 
+#include <cinttypes>
+#include <cstring>
 #include <chrono>
 #include <thread>
 using namespace std;
@@ -63,6 +65,10 @@ char* NetworkCapture_ErrorCodeToString(uint32_t errorCode)
         STR_CASE(XLNX_NETWORK_CAPTURE_ERROR_PCAP_FILE_NOT_OPEN)
         STR_CASE(XLNX_NETWORK_CAPTURE_ERROR_ALREADY_RUNNING)
         STR_CASE(XLNX_NETWORK_CAPTURE_ERROR_NOT_RUNNING)
+        STR_CASE(XLNX_NETWORK_CAPTURE_ERROR_FAILED_TO_ALLOCATE_WRITE_BUFFER)
+        STR_CASE(XLNX_NETWORK_CAPTURE_ERROR_PCAP_FILE_WRITE_FAILED)
+        STR_CASE(XLNX_NETWORK_CAPTURE_ERROR_BUFFER_ALREADY_ALLOCATED)
+        STR_CASE(XLNX_NETWORK_CAPTURE_ERROR_NOT_SUPPORTED_BY_HW)
 
         default:
         {
@@ -90,9 +96,24 @@ static int NetworkCapture_GetStatus(Shell* pShell, int argc, char* argv[], void*
     bool bIsRunning;
     uint32_t tailPointer;
     uint32_t numPackets;
+    uint32_t numDiscardedRecords;
+    uint32_t ringSizeMegabytes;
+    uint32_t capabilities;
     uint32_t pollRateMilliseconds;
     bool bYieldEnabled;
     uint32_t hwEmuPollDelaySeconds;
+    uint32_t fileBufferSize;
+    bool bDirectIO;
+    uint32_t flushTimeoutMilliseconds;
+    uint32_t segmentSizeMegabytes;
+    uint32_t segmentDurationSeconds;
+    uint32_t indexInterval;
+    PCAPWriter::Stats writerStats;
+    bool bFilterEnabled;
+    bool bFilterCaptureUnmatched;
+    uint16_t filterSnapLength;
+    uint32_t numFilterMatched;
+    uint32_t numFilterDropped;
    
     XLNX_UNUSED_ARG(argc);
     XLNX_UNUSED_ARG(argv);
@@ -202,6 +223,36 @@ static int NetworkCapture_GetStatus(Shell* pShell, int argc, char* argv[], void*
     }
 
 
+    if (retval == XLNX_OK)
+    {
+        retval = pNetworkCapture->GetCapabilities(&capabilities);
+
+        if (retval == XLNX_OK)
+        {
+            pShell->printf("| %-35s |           0x%08X |\n", "HW Capabilities", capabilities);
+        }
+    }
+
+
+    if (retval == XLNX_OK)
+    {
+        if (capabilities & NetworkCapture::CAPABILITY_PACKED_RECORDS)
+        {
+            retval = pNetworkCapture->GetRingSize(&ringSizeMegabytes);
+
+            if (retval == XLNX_OK)
+            {
+                pShell->printf("| %-35s | %20s |\n", "Ring Format", "Packed Records");
+                pShell->printf("| %-35s | %20u |\n", "Ring Size (MB)", ringSizeMegabytes);
+            }
+        }
+        else
+        {
+            pShell->printf("| %-35s | %20s |\n", "Ring Format", "2KB Chunks (Legacy)");
+        }
+    }
+
+
     if (retval == XLNX_OK)
     {
         pShell->printf("+-%.35s-+-%.20s-+\n", LINE_STRING, LINE_STRING);
@@ -296,6 +347,91 @@ static int NetworkCapture_GetStatus(Shell* pShell, int argc, char* argv[], void*
     }
 
 
+    if (retval == XLNX_OK)
+    {
+        retval = pNetworkCapture->GetNumDiscardedRecords(&numDiscardedRecords);
+
+        if (retval == XLNX_OK)
+        {
+            pShell->printf("| %-35s | %20u |\n", "Num Discarded Records", numDiscardedRecords);
+        }
+    }
+
+
+    if ((retval == XLNX_OK) && ((capabilities & NetworkCapture::CAPABILITY_FILTER) == 0))
+    {
+        pShell->printf("| %-35s | %20s |\n", "Capture Filter", "Not Supported By HW");
+    }
+    else if (retval == XLNX_OK)
+    {
+        retval = pNetworkCapture->GetFilterEnabled(&bFilterEnabled);
+
+        if (retval == XLNX_OK)
+        {
+            retval = pNetworkCapture->GetFilterDefault(&bFilterCaptureUnmatched, &filterSnapLength);
+        }
+
+        if (retval == XLNX_OK)
+        {
+            retval = pNetworkCapture->GetFilterStats(&numFilterMatched, &numFilterDropped);
+        }
+
+        if (retval == XLNX_OK)
+        {
+            pShell->printf("| %-35s | %20s |\n", "Capture Filter Enabled", pShell->boolToString(bFilterEnabled));
+            pShell->printf("| %-35s | %20s |\n", "Capture Filter Default Action", bFilterCaptureUnmatched ? "capture" : "drop");
+            pShell->printf("| %-35s | %20u |\n", "Capture Filter Default Snap Length", filterSnapLength);
+            pShell->printf("| %-35s | %20u |\n", "Capture Filter Matched Packets", numFilterMatched);
+            pShell->printf("| %-35s | %20u |\n", "Capture Filter Dropped Packets", numFilterDropped);
+        }
+    }
+
+
+    if (retval == XLNX_OK)
+    {
+        pNetworkCapture->GetFileBufferSize(&fileBufferSize);
+        pNetworkCapture->GetFileDirectIO(&bDirectIO);
+        pNetworkCapture->GetFileFlushTimeout(&flushTimeoutMilliseconds);
+
+        pShell->printf("| %-35s | %20u |\n", "File Buffer Size (bytes)", fileBufferSize);
+        pShell->printf("| %-35s | %20s |\n", "File Direct I/O", pShell->boolToString(bDirectIO));
+        pShell->printf("| %-35s | %20u |\n", "File Flush Timeout (ms)", flushTimeoutMilliseconds);
+
+        pNetworkCapture->GetFileSegmentSize(&segmentSizeMegabytes);
+        pNetworkCapture->GetFileSegmentDuration(&segmentDurationSeconds);
+        pNetworkCapture->GetFileIndexInterval(&indexInterval);
+
+        pShell->printf("| %-35s | %20u |\n", "File Segment Size (MB)", segmentSizeMegabytes);
+        pShell->printf("| %-35s | %20u |\n", "File Segment Duration (secs)", segmentDurationSeconds);
+        pShell->printf("| %-35s | %20u |\n", "File Index Interval (packets)", indexInterval);
+
+        retval = pNetworkCapture->GetFileWriterStats(&writerStats);
+
+        if (retval == XLNX_OK)
+        {
+            pShell->printf("| %-35s | %20" PRIu64 " |\n", "File Segments", writerStats.numSegments);
+            pShell->printf("| %-35s | %20" PRIu64 " |\n", "File Index Entries", writerStats.numIndexEntries);
+            pShell->printf("| %-35s | %20" PRIu64 " |\n", "File Bytes Written", writerStats.numBytesWritten);
+            pShell->printf("| %-35s | %20" PRIu64 " |\n", "File Backlog (bytes)", writerStats.backlogBytes);
+            pShell->printf("| %-35s | %20" PRIu64 " |\n", "File Max Backlog (bytes)", writerStats.maxBacklogBytes);
+            pShell->printf("| %-35s | %20" PRIu64 " |\n", "File Buffer Writes", writerStats.numBufferWrites);
+            pShell->printf("| %-35s | %20" PRIu64 " |\n", "File Writer Stalls", writerStats.numStalls);
+            pShell->printf("| %-35s | %20" PRIu64 " |\n", "File Writer Stall Time (us)", writerStats.stallNanoseconds / 1000);
+
+            //disk throughput while writing, and average rate since capture was started
+            if (writerStats.writeNanoseconds > 0)
+            {
+                pShell->printf("| %-35s | %20.1f |\n", "File Write Throughput (MB/s)", (double)writerStats.numBytesWritten * 1000.0 / (double)writerStats.writeNanoseconds);
+            }
+
+            if (writerStats.elapsedNanoseconds > 0)
+            {
+                pShell->printf("| %-35s | %20.1f |\n", "File Capture Rate (MB/s)", (double)writerStats.numBytes * 1000.0 / (double)writerStats.elapsedNanoseconds);
+            }
+        }
+    }
+
+
     if (retval == XLNX_OK)
     {
         pShell->printf("+-%.35s-+-%.20s-+\n", LINE_STRING, LINE_STRING);
@@ -534,16 +670,903 @@ static int NetworkCapture_SetHWEmuPollDelay(Shell* pShell, int argc, char* argv[
 
 
 
-CommandTableElement XLNX_NETWORK_CAPTURE_COMMAND_TABLE[] =
+static int NetworkCapture_SetFileBuffer(Shell* pShell, int argc, char* argv[], void* pObjectData)
 {
-    {"getstatus",	        NetworkCapture_GetStatus,	        "",			                "Get block status"	                            },
-    {"start",               NetworkCapture_Start,               "<filepath>",               "Start capturing packets to specified file"     },
-    {"stop",                NetworkCapture_Stop,                "",                         "Stop capturing packets"                        },
-    {/*-----------------------------------------------------------------------------------------------------------------------------------*/},
-    {"setpollrate",         NetworkCapture_SetPollRate,         "<milliseconds>",           "Sets the rate the capture thread polls HW"     },
-    {"setyield",            NetworkCapture_SetThreadYield,      "<bool>",                   "Controls capture thread yielding to others"    },
+    int retval = XLNX_OK;
+    NetworkCapture* pNetworkCapture = (NetworkCapture*)pObjectData;
+    bool bOKToContinue = true;
+    uint32_t numBytes;
+
+    if (argc != 2)
+    {
+        pShell->printf("Usage: %s <bytes>\n", argv[0]);
+        bOKToContinue = false;
+    }
+
+
+    if (bOKToContinue)
+    {
+        bOKToContinue = pShell->parseUInt32(argv[1], &numBytes);
+        if (bOKToContinue == false)
+        {
+            pShell->printf("[ERROR] Failed to parse bytes parameter\n");
+        }
+    }
+
+
+    if (bOKToContinue)
+    {
+        retval = pNetworkCapture->SetFileBufferSize(numBytes);
+        if (retval == XLNX_OK)
+        {
+            pShell->printf("OK\n");
+        }
+        else
+        {
+            pShell->printf("[ERROR] retval = %s (0x%08X)\n", NetworkCapture_ErrorCodeToString(retval), retval);
+        }
+    }
+
+
+    if (bOKToContinue == false)
+    {
+        retval = Shell::COMMAND_PARSING_ERROR;
+    }
+
+    return retval;
+}
+
+
+
+
+static int NetworkCapture_SetDirectIO(Shell* pShell, int argc, char* argv[], void* pObjectData)
+{
+    int retval = XLNX_OK;
+    NetworkCapture* pNetworkCapture = (NetworkCapture*)pObjectData;
+    bool bOKToContinue = true;
+    bool bEnabled;
+
+    if (argc != 2)
+    {
+        pShell->printf("Usage: %s <bool>\n", argv[0]);
+        bOKToContinue = false;
+    }
+
+    if (bOKToContinue)
+    {
+        bOKToContinue = pShell->parseBool(argv[1], &bEnabled);
+        if (bOKToContinue == false)
+        {
+            pShell->printf("[ERROR] Failed to parse bool parameter\n");
+        }
+    }
+
+
+    if (bOKToContinue)
+    {
+        retval = pNetworkCapture->SetFileDirectIO(bEnabled);
+
+        if (retval == XLNX_OK)
+        {
+            pShell->printf("OK\n");
+        }
+        else
+        {
+            pShell->printf("[ERROR] retval = %s (0x%08X)\n", NetworkCapture_ErrorCodeToString(retval), retval);
+        }
+    }
+
+    if (bOKToContinue == false)
+    {
+        retval = Shell::COMMAND_PARSING_ERROR;
+    }
+
+    return retval;
+}
+
+
+
+
+static int NetworkCapture_SetFlushTimeout(Shell* pShell, int argc, char* argv[], void* pObjectData)
+{
+    int retval = XLNX_OK;
+    NetworkCapture* pNetworkCapture = (NetworkCapture*)pObjectData;
+    bool bOKToContinue = true;
+    uint32_t milliseconds;
+
+    if (argc != 2)
+    {
+        pShell->printf("Usage: %s <milliseconds>\n", argv[0]);
+        bOKToContinue = false;
+    }
+
+
+    if (bOKToContinue)
+    {
+        bOKToContinue = pShell->parseUInt32(argv[1], &milliseconds);
+        if (bOKToContinue == false)
+        {
+            pShell->printf("[ERROR] Failed to parse milliseconds parameter\n");
+        }
+    }
+
+
+    if (bOKToContinue)
+    {
+        retval = pNetworkCapture->SetFileFlushTimeout(milliseconds);
+        if (retval == XLNX_OK)
+        {
+            pShell->printf("OK\n");
+        }
+        else
+        {
+            pShell->printf("[ERROR] retval = %s (0x%08X)\n", NetworkCapture_ErrorCodeToString(retval), retval);
+        }
+    }
+
+
+    if (bOKToContinue == false)
+    {
+        retval = Shell::COMMAND_PARSING_ERROR;
+    }
+
+    return retval;
+}
+
+
+
+
+static int NetworkCapture_SetSegmentSize(Shell* pShell, int argc, char* argv[], void* pObjectData)
+{
+    int retval = XLNX_OK;
+    NetworkCapture* pNetworkCapture = (NetworkCapture*)pObjectData;
+    bool bOKToContinue = true;
+    uint32_t megabytes;
+
+    if (argc != 2)
+    {
+        pShell->printf("Usage: %s <megabytes>\n", argv[0]);
+        bOKToContinue = false;
+    }
+
+
+    if (bOKToContinue)
+    {
+        bOKToContinue = pShell->parseUInt32(argv[1], &megabytes);
+        if (bOKToContinue == false)
+        {
+            pShell->printf("[ERROR] Failed to parse megabytes parameter\n");
+        }
+    }
+
+
+    if (bOKToContinue)
+    {
+        retval = pNetworkCapture->SetFileSegmentSize(megabytes);
+        if (retval == XLNX_OK)
+        {
+            pShell->printf("OK\n");
+        }
+        else
+        {
+            pShell->printf("[ERROR] retval = %s (0x%08X)\n", NetworkCapture_ErrorCodeToString(retval), retval);
+        }
+    }
+
+
+    if (bOKToContinue == false)
+    {
+        retval = Shell::COMMAND_PARSING_ERROR;
+    }
+
+    return retval;
+}
+
+
+
+
+static int NetworkCapture_SetSegmentDuration(Shell* pShell, int argc, char* argv[], void* pObjectData)
+{
+    int retval = XLNX_OK;
+    NetworkCapture* pNetworkCapture = (NetworkCapture*)pObjectData;
+    bool bOKToContinue = true;
+    uint32_t seconds;
+
+    if (argc != 2)
+    {
+        pShell->printf("Usage: %s <seconds>\n", argv[0]);
+        bOKToContinue = false;
+    }
+
+
+    if (bOKToContinue)
+    {
+        bOKToContinue = pShell->parseUInt32(argv[1], &seconds);
+        if (bOKToContinue == false)
+        {
+            pShell->printf("[ERROR] Failed to parse seconds parameter\n");
+        }
+    }
+
+
+    if (bOKToContinue)
+    {
+        retval = pNetworkCapture->SetFileSegmentDuration(seconds);
+        if (retval == XLNX_OK)
+        {
+            pShell->printf("OK\n");
+        }
+        else
+        {
+            pShell->printf("[ERROR] retval = %s (0x%08X)\n", NetworkCapture_ErrorCodeToString(retval), retval);
+        }
+    }
+
+
+    if (bOKToContinue == false)
+    {
+        retval = Shell::COMMAND_PARSING_ERROR;
+    }
+
+    return retval;
+}
+
+
+
+
+static int NetworkCapture_SetIndexInterval(Shell* pShell, int argc, char* argv[], void* pObjectData)
+{
+    int retval = XLNX_OK;
+    NetworkCapture* pNetworkCapture = (NetworkCapture*)pObjectData;
+    bool bOKToContinue = true;
+    uint32_t packets;
+
+    if (argc != 2)
+    {
+        pShell->printf("Usage: %s <packets>\n", argv[0]);
+        bOKToContinue = false;
+    }
+
+
+    if (bOKToContinue)
+    {
+        bOKToContinue = pShell->parseUInt32(argv[1], &packets);
+        if (bOKToContinue == false)
+        {
+            pShell->printf("[ERROR] Failed to parse packets parameter\n");
+        }
+    }
+
+
+    if (bOKToContinue)
+    {
+        retval = pNetworkCapture->SetFileIndexInterval(packets);
+        if (retval == XLNX_OK)
+        {
+            pShell->printf("OK\n");
+        }
+        else
+        {
+            pShell->printf("[ERROR] retval = %s (0x%08X)\n", NetworkCapture_ErrorCodeToString(retval), retval);
+        }
+    }
+
+
+    if (bOKToContinue == false)
+    {
+        retval = Shell::COMMAND_PARSING_ERROR;
+    }
+
+    return retval;
+}
+
+
+
+
+
+
+
+static int NetworkCapture_SetRingSize(Shell* pShell, int argc, char* argv[], void* pObjectData)
+{
+    int retval = XLNX_OK;
+    NetworkCapture* pNetworkCapture = (NetworkCapture*)pObjectData;
+    bool bOKToContinue = true;
+    uint32_t megabytes;
+
+    if (argc != 2)
+    {
+        pShell->printf("Usage: %s <megabytes>\n", argv[0]);
+        bOKToContinue = false;
+    }
+
+
+    if (bOKToContinue)
+    {
+        bOKToContinue = pShell->parseUInt32(argv[1], &megabytes);
+        if (bOKToContinue == false)
+        {
+            pShell->printf("[ERROR] Failed to parse megabytes parameter\n");
+        }
+    }
+
+
+    if (bOKToContinue)
+    {
+        retval = pNetworkCapture->SetRingSize(megabytes);
+        if (retval == XLNX_OK)
+        {
+            pShell->printf("OK\n");
+        }
+        else
+        {
+            pShell->printf("[ERROR] retval = %s (0x%08X)\n", NetworkCapture_ErrorCodeToString(retval), retval);
+        }
+    }
+
+
+    if (bOKToContinue == false)
+    {
+        retval = Shell::COMMAND_PARSING_ERROR;
+    }
+
+    return retval;
+}
+
+
+
+
+
+
+
+static bool NetworkCapture_ParseFilterAction(Shell* pShell, char* pToken, bool* pbCapture)
+{
+    bool bOKToContinue = true;
+
+    if (strcmp(pToken, "capture") == 0)
+    {
+        *pbCapture = true;
+    }
+    else if (strcmp(pToken, "drop") == 0)
+    {
+        *pbCapture = false;
+    }
+    else
+    {
+        pShell->printf("[ERROR] Action must be capture or drop\n");
+        bOKToContinue = false;
+    }
+
+    return bOKToContinue;
+}
+
+
+
+
+static bool NetworkCapture_ParseSnapLength(Shell* pShell, char* pToken, uint16_t* pSnapLength)
+{
+    bool bOKToContinue = true;
+
+    bOKToContinue = pShell->parseUInt16(pToken, pSnapLength);
+    if (bOKToContinue == false)
+    {
+        pShell->printf("[ERROR] Failed to parse snaplen parameter\n");
+    }
+
+    return bOKToContinue;
+}
+
+
+
+
+//Parses <a.b.c.d>[/<prefix length>] into an address and mask - no prefix length means an exact match
+static bool NetworkCapture_ParseFilterAddress(Shell* pShell, char* pToken, uint32_t* pAddress, uint32_t* pMask)
+{
+    bool bOKToContinue = true;
+    uint8_t a, b, c, d;
+    uint32_t prefixLength = 32;
+    char* pSlash;
+
+    pSlash = strchr(pToken, '/');
+
+    if (pSlash != nullptr)
+    {
+        *pSlash = '\0';
+
+        bOKToContinue = pShell->parseUInt32(pSlash + 1, &prefixLength);
+        if ((bOKToContinue == false) || (prefixLength > 32))
+        {
+            pShell->printf("[ERROR] Invalid prefix length\n");
+            bOKToContinue = false;
+        }
+    }
+
+    if (bOKToContinue)
+    {
+        bOKToContinue = ParseIPv4Address(pShell, pToken, &a, &b, &c, &d);
+    }
+
+    if (bOKToContinue)
+    {
+        *pMask = (prefixLength == 0) ? 0 : (0xFFFFFFFF << (32 - prefixLength));
+        *pAddress = (((uint32_t)a << 24) | ((uint32_t)b << 16) | ((uint32_t)c << 8) | (uint32_t)d) & *pMask;
+    }
+
+    return bOKToContinue;
+}
+
+
+
+
+static bool NetworkCapture_ParseFilterMatch(Shell* pShell, char* pToken, NetworkCapture::FilterRule* pRule)
+{
+    bool bOKToContinue = true;
+    char* pValue;
+    uint16_t value;
+
+    pValue = strchr(pToken, '=');
+
+    if (pValue == nullptr)
+    {
+        pShell->printf("[ERROR] Expected <field>=<value>, got %s\n", pToken);
+        bOKToContinue = false;
+    }
+
+
+    if (bOKToContinue)
+    {
+        *pValue = '\0';
+        pValue++;
+
+        if (strcmp(pToken, "ethertype") == 0)
+        {
+            bOKToContinue = pShell->parseHex16(pValue, &pRule->etherType);
+            pRule->matchFlags |= NetworkCapture::FILTER_MATCH_ETHERTYPE;
+        }
+        else if (strcmp(pToken, "vlan") == 0)
+        {
+            bOKToContinue = pShell->parseUInt16(pValue, &pRule->vlanID);
+            pRule->matchFlags |= NetworkCapture::FILTER_MATCH_VLAN;
+        }
+        else if (strcmp(pToken, "src") == 0)
+        {
+            bOKToContinue = NetworkCapture_ParseFilterAddress(pShell, pValue, &pRule->srcAddress, &pRule->srcMask);
+            pRule->matchFlags |= NetworkCapture::FILTER_MATCH_SRC_ADDRESS;
+        }
+        else if (strcmp(pToken, "dst") == 0)
+        {
+            bOKToContinue = NetworkCapture_ParseFilterAddress(pShell, pValue, &pRule->dstAddress, &pRule->dstMask);
+            pRule->matchFlags |= NetworkCapture::FILTER_MATCH_DST_ADDRESS;
+        }
+        else if (strcmp(pToken, "proto") == 0)
+        {
+            if (strcmp(pValue, "tcp") == 0)
+            {
+                pRule->ipProtocol = 6;
+            }
+            else if (strcmp(pValue, "udp") == 0)
+            {
+                pRule->ipProtocol = 17;
+            }
+            else
+            {
+                bOKToContinue = pShell->parseUInt16(pValue, &value);
+                if (bOKToContinue && (value > 0xFF))
+                {
+                    bOKToContinue = false;
+                }
+                pRule->ipProtocol = (uint8_t)value;
+            }
+            pRule->matchFlags |= NetworkCapture::FILTER_MATCH_IP_PROTOCOL;
+        }
+        else if (strcmp(pToken, "sport") == 0)
+        {
+            bOKToContinue = ParsePort(pShell, pValue, &pRule->srcPort);
+            pRule->matchFlags |= NetworkCapture::FILTER_MATCH_SRC_PORT;
+        }
+        else if (strcmp(pToken, "dport") == 0)
+        {
+            bOKToContinue = ParsePort(pShell, pValue, &pRule->dstPort);
+            pRule->matchFlags |= NetworkCapture::FILTER_MATCH_DST_PORT;
+        }
+        else if (strcmp(pToken, "port") == 0)
+        {
+            bOKToContinue = ParsePort(pShell, pValue, &pRule->port);
+            pRule->matchFlags |= NetworkCapture::FILTER_MATCH_PORT;
+        }
+        else
+        {
+            pShell->printf("[ERROR] Unknown match field %s\n", pToken);
+            bOKToContinue = false;
+        }
+
+        if (bOKToContinue == false)
+        {
+            pShell->printf("[ERROR] Failed to parse %s match\n", pToken);
+        }
+    }
+
+    return bOKToContinue;
+}
+
+
+
+
+static int NetworkCapture_SetFilterEnabled(Shell* pShell, int argc, char* argv[], void* pObjectData)
+{
+    int retval = XLNX_OK;
+    NetworkCapture* pNetworkCapture = (NetworkCapture*)pObjectData;
+    bool bOKToContinue = true;
+    bool bEnabled;
+
+    if (argc != 2)
+    {
+        pShell->printf("Usage: %s <bool>\n", argv[0]);
+        bOKToContinue = false;
+    }
+
+    if (bOKToContinue)
+    {
+        bOKToContinue = pShell->parseBool(argv[1], &bEnabled);
+        if (bOKToContinue == false)
+        {
+            pShell->printf("[ERROR] Failed to parse bool parameter\n");
+        }
+    }
+
+
+    if (bOKToContinue)
+    {
+        retval = pNetworkCapture->SetFilterEnabled(bEnabled);
+
+        if (retval == XLNX_OK)
+        {
+            pShell->printf("OK\n");
+        }
+        else
+        {
+            pShell->printf("[ERROR] retval = %s (0x%08X)\n", NetworkCapture_ErrorCodeToString(retval), retval);
+        }
+    }
+
+    if (bOKToContinue == false)
+    {
+        retval = Shell::COMMAND_PARSING_ERROR;
+    }
+
+    return retval;
+}
+
+
+
+
+static int NetworkCapture_SetFilterDefault(Shell* pShell, int argc, char* argv[], void* pObjectData)
+{
+    int retval = XLNX_OK;
+    NetworkCapture* pNetworkCapture = (NetworkCapture*)pObjectData;
+    bool bOKToContinue = true;
+    bool bCapture;
+    uint16_t snapLength = 0;
+
+    if ((argc != 2) && (argc != 3))
+    {
+        pShell->printf("Usage: %s <capture|drop> [snaplen]\n", argv[0]);
+        bOKToContinue = false;
+    }
+
+    if (bOKToContinue)
+    {
+        bOKToContinue = NetworkCapture_ParseFilterAction(pShell, argv[1], &bCapture);
+    }
+
+    if (bOKToContinue && (argc == 3))
+    {
+        bOKToContinue = NetworkCapture_ParseSnapLength(pShell, argv[2], &snapLength);
+    }
+
+
+    if (bOKToContinue)
+    {
+        retval = pNetworkCapture->SetFilterDefault(bCapture, snapLength);
+
+        if (retval == XLNX_OK)
+        {
+            pShell->printf("OK\n");
+        }
+        else
+        {
+            pShell->printf("[ERROR] retval = %s (0x%08X)\n", NetworkCapture_ErrorCodeToString(retval), retval);
+        }
+    }
+
+    if (bOKToContinue == false)
+    {
+        retval = Shell::COMMAND_PARSING_ERROR;
+    }
+
+    return retval;
+}
+
+
+
+
+static int NetworkCapture_SetFilterRule(Shell* pShell, int argc, char* argv[], void* pObjectData)
+{
+    int retval = XLNX_OK;
+    NetworkCapture* pNetworkCapture = (NetworkCapture*)pObjectData;
+    bool bOKToContinue = true;
+    uint32_t index;
+    NetworkCapture::FilterRule rule;
+
+    memset(&rule, 0, sizeof(rule));
+
+    if (argc < 4)
+    {
+        pShell->printf("Usage: %s <index> <capture|drop> <snaplen> [<field>=<value> ...]\n", argv[0]);
+        pShell->printf("       fields: ethertype=<hex> vlan=<id> src=<ip>[/len] dst=<ip>[/len]\n");
+        pShell->printf("               proto=<tcp|udp|num> sport=<port> dport=<port> port=<port>\n");
+        bOKToContinue = false;
+    }
+
+    if (bOKToContinue)
+    {
+        bOKToContinue = pShell->parseUInt32(argv[1], &index);
+        if (bOKToContinue == false)
+        {
+            pShell->printf("[ERROR] Failed to parse index parameter\n");
+        }
+    }
+
+    if (bOKToContinue)
+    {
+        bOKToContinue = NetworkCapture_ParseFilterAction(pShell, argv[2], &rule.bCapture);
+    }
+
+    if (bOKToContinue)
+    {
+        bOKToContinue = NetworkCapture_ParseSnapLength(pShell, argv[3], &rule.snapLength);
+    }
+
+    for (int i = 4; (i < argc) && bOKToContinue; i++)
+    {
+        bOKToContinue = NetworkCapture_ParseFilterMatch(pShell, argv[i], &rule);
+    }
+
+
+    if (bOKToContinue)
+    {
+        retval = pNetworkCapture->SetFilterRule(index, &rule);
+
+        if (retval == XLNX_OK)
+        {
+            pShell->printf("OK\n");
+        }
+        else
+        {
+            pShell->printf("[ERROR] retval = %s (0x%08X)\n", NetworkCapture_ErrorCodeToString(retval), retval);
+        }
+    }
+
+    if (bOKToContinue == false)
+    {
+        retval = Shell::COMMAND_PARSING_ERROR;
+    }
+
+    return retval;
+}
+
+
+
+
+static int NetworkCapture_DeleteFilterRule(Shell* pShell, int argc, char* argv[], void* pObjectData)
+{
+    int retval = XLNX_OK;
+    NetworkCapture* pNetworkCapture = (NetworkCapture*)pObjectData;
+    bool bOKToContinue = true;
+    uint32_t index;
+
+    if (argc != 2)
+    {
+        pShell->printf("Usage: %s <index>\n", argv[0]);
+        bOKToContinue = false;
+    }
+
+    if (bOKToContinue)
+    {
+        bOKToContinue = pShell->parseUInt32(argv[1], &index);
+        if (bOKToContinue == false)
+        {
+            pShell->printf("[ERROR] Failed to parse index parameter\n");
+        }
+    }
+
+
+    if (bOKToContinue)
+    {
+        retval = pNetworkCapture->DeleteFilterRule(index);
+
+        if (retval == XLNX_OK)
+        {
+            pShell->printf("OK\n");
+        }
+        else
+        {
+            pShell->printf("[ERROR] retval = %s (0x%08X)\n", NetworkCapture_ErrorCodeToString(retval), retval);
+        }
+    }
+
+    if (bOKToContinue == false)
+    {
+        retval = Shell::COMMAND_PARSING_ERROR;
+    }
+
+    return retval;
+}
+
+
+
+
+static int NetworkCapture_DeleteAllFilterRules(Shell* pShell, int argc, char* argv[], void* pObjectData)
+{
+    int retval = XLNX_OK;
+    NetworkCapture* pNetworkCapture = (NetworkCapture*)pObjectData;
+
+    XLNX_UNUSED_ARG(argc);
+    XLNX_UNUSED_ARG(argv);
+
+    retval = pNetworkCapture->DeleteAllFilterRules();
+
+    if (retval == XLNX_OK)
+    {
+        pShell->printf("OK\n");
+    }
+    else
+    {
+        pShell->printf("[ERROR] retval = %s (0x%08X)\n", NetworkCapture_ErrorCodeToString(retval), retval);
+    }
+
+    return retval;
+}
+
+
+
+
+static void NetworkCapture_FormatFilterAddress(char* buffer, size_t bufferSize, uint32_t address, uint32_t mask)
+{
+    uint32_t prefixLength = 0;
+
+    while ((prefixLength < 32) && (mask & (0x80000000 >> prefixLength)))
+    {
+        prefixLength++;
+    }
+
+    snprintf(buffer, bufferSize, "%u.%u.%u.%u/%u", (address >> 24) & 0xFF,
+                                                   (address >> 16) & 0xFF,
+                                                   (address >> 8) & 0xFF,
+                                                   address & 0xFF,
+                                                   prefixLength);
+}
+
+
+
+
+static int NetworkCapture_GetFilter(Shell* pShell, int argc, char* argv[], void* pObjectData)
+{
+    int retval = XLNX_OK;
+    NetworkCapture* pNetworkCapture = (NetworkCapture*)pObjectData;
+    NetworkCapture::FilterRule rule;
+    bool bValid;
+    static const uint32_t BUFFER_SIZE = 32;
+    char etherTypeBuffer[BUFFER_SIZE];
+    char vlanBuffer[BUFFER_SIZE];
+    char srcBuffer[BUFFER_SIZE];
+    char dstBuffer[BUFFER_SIZE];
+    char protoBuffer[BUFFER_SIZE];
+    char srcPortBuffer[BUFFER_SIZE];
+    char dstPortBuffer[BUFFER_SIZE];
+    char portBuffer[BUFFER_SIZE];
+
+    XLNX_UNUSED_ARG(argc);
+    XLNX_UNUSED_ARG(argv);
+
+    pShell->printf("+-----+---------+-------+-------+------+--------------------+--------------------+-------+-------+-------+-------+\n");
+    pShell->printf("| Idx | Action  | Snap  | EType | VLAN | Source             | Destination        | Proto | SPort | DPort | Port  |\n");
+    pShell->printf("+-----+---------+-------+-------+------+--------------------+--------------------+-------+-------+-------+-------+\n");
+
+    for (uint32_t i = 0; i < NetworkCapture::NUM_FILTER_RULES_SUPPORTED; i++)
+    {
+        retval = pNetworkCapture->GetFilterRule(i, &rule, &bValid);
+
+        if (retval != XLNX_OK)
+        {
+            break; //out of loop
+        }
+
+        if (bValid == false)
+        {
+            continue;
+        }
+
+        //fields that take no part in the match are shown as "*"
+        snprintf(etherTypeBuffer, BUFFER_SIZE, (rule.matchFlags & NetworkCapture::FILTER_MATCH_ETHERTYPE) ? "%04X" : "*", rule.etherType);
+        snprintf(vlanBuffer, BUFFER_SIZE, (rule.matchFlags & NetworkCapture::FILTER_MATCH_VLAN) ? "%u" : "*", rule.vlanID);
+        snprintf(protoBuffer, BUFFER_SIZE, (rule.matchFlags & NetworkCapture::FILTER_MATCH_IP_PROTOCOL) ? "%u" : "*", rule.ipProtocol);
+        snprintf(srcPortBuffer, BUFFER_SIZE, (rule.matchFlags & NetworkCapture::FILTER_MATCH_SRC_PORT) ? "%u" : "*", rule.srcPort);
+        snprintf(dstPortBuffer, BUFFER_SIZE, (rule.matchFlags & NetworkCapture::FILTER_MATCH_DST_PORT) ? "%u" : "*", rule.dstPort);
+        snprintf(portBuffer, BUFFER_SIZE, (rule.matchFlags & NetworkCapture::FILTER_MATCH_PORT) ? "%u" : "*", rule.port);
+
+        if (rule.matchFlags & NetworkCapture::FILTER_MATCH_SRC_ADDRESS)
+        {
+            NetworkCapture_FormatFilterAddress(srcBuffer, BUFFER_SIZE, rule.srcAddress, rule.srcMask);
+        }
+        else
+        {
+            snprintf(srcBuffer, BUFFER_SIZE, "*");
+        }
+
+        if (rule.matchFlags & NetworkCapture::FILTER_MATCH_DST_ADDRESS)
+        {
+            NetworkCapture_FormatFilterAddress(dstBuffer, BUFFER_SIZE, rule.dstAddress, rule.dstMask);
+        }
+        else
+        {
+            snprintf(dstBuffer, BUFFER_SIZE, "*");
+        }
+
+        pShell->printf("| %3u | %-7s | %5u | %5s | %4s | %-18s | %-18s | %5s | %5s | %5s | %5s |\n", i,
+                       rule.bCapture ? "capture" : "drop",
+                       rule.snapLength,
+                       etherTypeBuffer,
+                       vlanBuffer,
+                       srcBuffer,
+                       dstBuffer,
+                       protoBuffer,
+                       srcPortBuffer,
+                       dstPortBuffer,
+                       portBuffer);
+    }
+
+    pShell->printf("+-----+---------+-------+-------+------+--------------------+--------------------+-------+-------+-------+-------+\n");
+
+
+    if (retval != XLNX_OK)
+    {
+        pShell->printf("[ERROR] retval = %s (0x%08X)\n", NetworkCapture_ErrorCodeToString(retval), retval);
+    }
+
+    return retval;
+}
+
+
+
+
+
+
+
+CommandTableElement XLNX_NETWORK_CAPTURE_COMMAND_TABLE[] =
+{
+    {"getstatus",	        NetworkCapture_GetStatus,	        "",			                "Get block status"	                            },
+    {"start",               NetworkCapture_Start,               "<filepath>",               "Start capturing packets to specified file"     },
+    {"stop",                NetworkCapture_Stop,                "",                         "Stop capturing packets"                        },
+    {/*-----------------------------------------------------------------------------------------------------------------------------------*/},
+    {"setpollrate",         NetworkCapture_SetPollRate,         "<milliseconds>",           "Sets the rate the capture thread polls HW"     },
+    {"setyield",            NetworkCapture_SetThreadYield,      "<bool>",                   "Controls capture thread yielding to others"    },
+    {"setringsize",         NetworkCapture_SetRingSize,         "<megabytes>",              "Sets the HW capture ring size (before start)"  },
+    {/*-----------------------------------------------------------------------------------------------------------------------------------*/},
+    {"getfilter",           NetworkCapture_GetFilter,           "",                         "List the capture filter rules"                 },
+    {"setfilter",           NetworkCapture_SetFilterEnabled,    "<bool>",                   "Enable/disable the HW capture filter"          },
+    {"setfilterdefault",    NetworkCapture_SetFilterDefault,    "<capture|drop> [snaplen]", "Action for packets matching no filter rule"    },
+    {"setfilterrule",       NetworkCapture_SetFilterRule,       "<idx> <action> <snap> ...","Sets a capture filter rule (no args for help)" },
+    {"delfilterrule",       NetworkCapture_DeleteFilterRule,    "<index>",                  "Deletes a capture filter rule"                 },
+    {"delallfilterrules",   NetworkCapture_DeleteAllFilterRules,"",                         "Deletes all capture filter rules"              },
+    {/*-----------------------------------------------------------------------------------------------------------------------------------*/},
+    {"sethwemupolldelay",   NetworkCapture_SetHWEmuPollDelay,   "<seconds>",                "Sets a poll delay - only used in HW emulation" },
     {/*-----------------------------------------------------------------------------------------------------------------------------------*/},
-    {"sethwemupolldelay",   NetworkCapture_SetHWEmuPollDelay,   "<seconds>",                "Sets a poll delay - only used in HW emulation" }
+    {"setfilebuffer",       NetworkCapture_SetFileBuffer,       "<bytes>",                  "Sets the size of each PCAP file write buffer"  },
+    {"setdirectio",         NetworkCapture_SetDirectIO,         "<bool>",                   "Write PCAP file with O_DIRECT"                 },
+    {"setflushtimeout",     NetworkCapture_SetFlushTimeout,     "<milliseconds>",           "Max time packets are held before writing"      },
+    {"setsegmentsize",      NetworkCapture_SetSegmentSize,      "<megabytes>",              "Rotate PCAP segment files by size (0 = off)"   },
+    {"setsegmentduration",  NetworkCapture_SetSegmentDuration,  "<seconds>",                "Rotate PCAP segment files by time (0 = off)"   },
+    {"setindexinterval",    NetworkCapture_SetIndexInterval,    "<packets>",                "Packets between time index entries (0 = off)"  }
    
 };
 
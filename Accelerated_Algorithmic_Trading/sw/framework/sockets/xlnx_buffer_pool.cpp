@@ -0,0 +1,169 @@
+/*
+ * Copyright 2021 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "xlnx_buffer_pool.h"
+using namespace XLNX;
+
+
+
+
+BufferPool::BufferPool()
+{
+    m_pStorage = nullptr;
+    m_numBuffers = 0;
+    m_bufferSize = 0;
+}
+
+
+
+
+BufferPool::~BufferPool()
+{
+    Uninitialise();
+}
+
+
+
+
+
+uint32_t BufferPool::Initialise(uint32_t numBuffers, uint32_t bufferSize)
+{
+    uint32_t retval = XLNX_OK;
+    uint32_t i;
+
+    Uninitialise();
+
+    if ((numBuffers == 0) || (bufferSize == 0))
+    {
+        retval = XLNX_SOCKET_ERROR_INVALID_PARAMETER;
+    }
+
+
+    if (retval == XLNX_OK)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        m_pStorage = new uint8_t[(size_t)numBuffers * bufferSize];
+        m_numBuffers = numBuffers;
+        m_bufferSize = bufferSize;
+
+        m_freeList.reserve(numBuffers);
+
+        for (i = 0; i < numBuffers; i++)
+        {
+            m_freeList.push_back(&m_pStorage[(size_t)i * bufferSize]);
+        }
+    }
+
+    return retval;
+}
+
+
+
+
+
+uint32_t BufferPool::Uninitialise(void)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    delete[] m_pStorage;
+
+    m_pStorage = nullptr;
+    m_numBuffers = 0;
+    m_bufferSize = 0;
+    m_freeList.clear();
+
+    return XLNX_OK;
+}
+
+
+
+
+
+uint32_t BufferPool::GetBufferSize(uint32_t* pBufferSize)
+{
+    *pBufferSize = m_bufferSize;
+
+    return XLNX_OK;
+}
+
+
+
+
+
+uint32_t BufferPool::GetNumFreeBuffers(uint32_t* pNumFreeBuffers)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    *pNumFreeBuffers = (uint32_t)m_freeList.size();
+
+    return XLNX_OK;
+}
+
+
+
+
+
+uint32_t BufferPool::Acquire(uint8_t** ppBuffer)
+{
+    uint32_t retval = XLNX_OK;
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    if (m_pStorage == nullptr)
+    {
+        retval = XLNX_SOCKET_ERROR_BUFFER_POOL_NOT_INITIALISED;
+    }
+    else if (m_freeList.empty())
+    {
+        retval = XLNX_SOCKET_ERROR_BUFFER_POOL_EMPTY;
+    }
+    else
+    {
+        *ppBuffer = m_freeList.back();
+        m_freeList.pop_back();
+    }
+
+    return retval;
+}
+
+
+
+
+
+uint32_t BufferPool::Release(uint8_t* pBuffer)
+{
+    uint32_t retval = XLNX_OK;
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    if ((m_pStorage == nullptr) || (pBuffer < m_pStorage) || (pBuffer >= &m_pStorage[(size_t)m_numBuffers * m_bufferSize]))
+    {
+        retval = XLNX_SOCKET_ERROR_INVALID_PARAMETER;
+    }
+    else if (((size_t)(pBuffer - m_pStorage) % m_bufferSize) != 0)
+    {
+        //inside the pool but not the start of a buffer, would hand out overlapping memory if accepted
+        retval = XLNX_SOCKET_ERROR_INVALID_PARAMETER;
+    }
+    else
+    {
+        m_freeList.push_back(pBuffer);
+    }
+
+    return retval;
+}
@@ -0,0 +1,68 @@
+/*
+ * Copyright 2021 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef XLNX_BUFFER_POOL_H
+#define XLNX_BUFFER_POOL_H
+
+#include <stdint.h>
+
+#include <mutex>
+#include <vector>
+
+#include "xlnx_socket_error_codes.h"
+
+namespace XLNX
+{
+
+
+//Fixed number of fixed size buffers, all allocated up front.  Receive paths take a buffer for the
+//duration of a callback and hand it straight back, so nothing is allocated per packet/connection.
+class BufferPool
+{
+
+public:
+    BufferPool();
+    virtual ~BufferPool();
+
+public:
+    uint32_t Initialise(uint32_t numBuffers, uint32_t bufferSize);
+    uint32_t Uninitialise(void);
+
+    uint32_t GetBufferSize(uint32_t* pBufferSize);
+    uint32_t GetNumFreeBuffers(uint32_t* pNumFreeBuffers);
+
+public:
+    uint32_t Acquire(uint8_t** ppBuffer);
+    uint32_t Release(uint8_t* pBuffer);
+
+
+protected:
+    std::mutex m_mutex;
+
+    uint8_t* m_pStorage;
+    uint32_t m_numBuffers;
+    uint32_t m_bufferSize;
+
+    std::vector<uint8_t*> m_freeList;
+};
+
+
+
+} //end namespace XLNX
+
+
+#endif //XLNX_BUFFER_POOL_H
@@ -69,12 +69,10 @@ int sockClose(SOCKET sock)
 
 #ifdef __linux__
 
-    retval = shutdown(sock, SHUT_RDWR);
+    //NOTE - shutdown fails on sockets that were never connected (e.g. UDP), but they still need closing
+    shutdown(sock, SHUT_RDWR);
 
-    if (retval == 0)
-    {
-        retval = close(sock);
-    }
+    retval = close(sock);
 
 #endif
 
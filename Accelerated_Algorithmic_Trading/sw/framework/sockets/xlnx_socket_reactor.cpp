@@ -0,0 +1,383 @@
+/*
+ * Copyright 2021 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <stdio.h>
+#include <errno.h>
+
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+
+#include "xlnx_socket_reactor.h"
+using namespace XLNX;
+
+
+
+
+SocketReactor::SocketReactor()
+{
+    uint32_t i;
+
+    m_bRunning = false;
+    m_numThreads = 0;
+    m_nextWorkerIndex = 0;
+    m_stopEventFd = -1;
+
+    for (i = 0; i < MAX_NUM_THREADS; i++)
+    {
+        m_workers[i].epollFd = -1;
+    }
+}
+
+
+
+
+SocketReactor::~SocketReactor()
+{
+    Stop();
+}
+
+
+
+
+
+uint32_t SocketReactor::Start(uint32_t numThreads)
+{
+    uint32_t retval = XLNX_OK;
+    struct epoll_event event;
+    uint32_t i;
+
+    if (m_bRunning)
+    {
+        retval = XLNX_SOCKET_ERROR_ALREADY_RUNNING;
+    }
+    else if ((numThreads == 0) || (numThreads > MAX_NUM_THREADS))
+    {
+        retval = XLNX_SOCKET_ERROR_INVALID_PARAMETER;
+    }
+
+
+    if (retval == XLNX_OK)
+    {
+        //one eventfd is shared by all of the workers - once written it stays readable, so every
+        //worker wakes up from epoll_wait and sees the running flag has been cleared
+        m_stopEventFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+
+        if (m_stopEventFd < 0)
+        {
+            retval = XLNX_SOCKET_ERROR_FAILED_TO_CREATE_EPOLL;
+        }
+    }
+
+
+    for (i = 0; (i < numThreads) && (retval == XLNX_OK); i++)
+    {
+        m_workers[i].epollFd = epoll_create1(EPOLL_CLOEXEC);
+
+        if (m_workers[i].epollFd < 0)
+        {
+            retval = XLNX_SOCKET_ERROR_FAILED_TO_CREATE_EPOLL;
+        }
+        else
+        {
+            event.events = EPOLLIN;
+            event.data.ptr = nullptr;
+
+            if (epoll_ctl(m_workers[i].epollFd, EPOLL_CTL_ADD, m_stopEventFd, &event) != 0)
+            {
+                retval = XLNX_SOCKET_ERROR_FAILED_TO_CREATE_EPOLL;
+            }
+        }
+    }
+
+
+    if (retval == XLNX_OK)
+    {
+        m_numThreads = numThreads;
+        m_nextWorkerIndex = 0;
+        m_bRunning = true;
+
+        for (i = 0; i < numThreads; i++)
+        {
+            m_workers[i].thread = std::thread(&SocketReactor::ThreadFunc, this, i);
+        }
+    }
+    else if (retval != XLNX_SOCKET_ERROR_ALREADY_RUNNING)
+    {
+        for (i = 0; i < MAX_NUM_THREADS; i++)
+        {
+            if (m_workers[i].epollFd >= 0)
+            {
+                close(m_workers[i].epollFd);
+                m_workers[i].epollFd = -1;
+            }
+        }
+
+        if (m_stopEventFd >= 0)
+        {
+            close(m_stopEventFd);
+            m_stopEventFd = -1;
+        }
+    }
+
+    return retval;
+}
+
+
+
+
+
+uint32_t SocketReactor::Stop(void)
+{
+    uint64_t value = 1;
+    uint32_t i;
+    ssize_t numBytesWritten;
+
+    if (m_bRunning)
+    {
+        m_bRunning = false;
+
+        numBytesWritten = write(m_stopEventFd, &value, sizeof(value));
+        (void)numBytesWritten;
+
+        for (i = 0; i < m_numThreads; i++)
+        {
+            if (m_workers[i].thread.joinable())
+            {
+                m_workers[i].thread.join();
+            }
+
+            FreeDeferred(&m_workers[i]);
+
+            close(m_workers[i].epollFd);
+            m_workers[i].epollFd = -1;
+        }
+
+        close(m_stopEventFd);
+        m_stopEventFd = -1;
+
+        m_numThreads = 0;
+
+
+        //anything not removed by its owner is simply forgotten - the sockets themselves are not ours to close
+        std::lock_guard<std::mutex> lock(m_registrationMutex);
+
+        for (std::map<SOCKET, Registration*>::iterator it = m_registrations.begin(); it != m_registrations.end(); ++it)
+        {
+            delete it->second;
+        }
+
+        m_registrations.clear();
+    }
+
+    return XLNX_OK;
+}
+
+
+
+
+
+uint32_t SocketReactor::IsRunning(bool* pbIsRunning)
+{
+    *pbIsRunning = m_bRunning;
+
+    return XLNX_OK;
+}
+
+
+
+
+
+uint32_t SocketReactor::GetNumThreads(uint32_t* pNumThreads)
+{
+    *pNumThreads = m_numThreads;
+
+    return XLNX_OK;
+}
+
+
+
+
+
+uint32_t SocketReactor::AddSocket(SOCKET sock, uint32_t events, EventCallbackType callback, void* pDataObject)
+{
+    uint32_t retval = XLNX_OK;
+    Registration* pRegistration = nullptr;
+    struct epoll_event event;
+
+    if (m_bRunning == false)
+    {
+        retval = XLNX_SOCKET_ERROR_NOT_RUNNING;
+    }
+    else if ((sock == INVALID_SOCKET) || (callback == nullptr))
+    {
+        retval = XLNX_SOCKET_ERROR_INVALID_PARAMETER;
+    }
+
+
+    if (retval == XLNX_OK)
+    {
+        pRegistration = new Registration;
+
+        pRegistration->sock = sock;
+        pRegistration->callback = callback;
+        pRegistration->pDataObject = pDataObject;
+        pRegistration->workerIndex = m_nextWorkerIndex++ % m_numThreads;
+        pRegistration->bRemoved = false;
+
+        std::lock_guard<std::mutex> lock(m_registrationMutex);
+
+        if (m_registrations.find(sock) != m_registrations.end())
+        {
+            retval = XLNX_SOCKET_ERROR_INVALID_PARAMETER;
+        }
+        else
+        {
+            //registered before the epoll add so that a callback straight away can already remove itself
+            m_registrations[sock] = pRegistration;
+
+            event.events = events;
+            event.data.ptr = pRegistration;
+
+            if (epoll_ctl(m_workers[pRegistration->workerIndex].epollFd, EPOLL_CTL_ADD, sock, &event) != 0)
+            {
+                m_registrations.erase(sock);
+                retval = XLNX_SOCKET_ERROR_FAILED_TO_ADD_SOCKET;
+            }
+        }
+
+        if (retval != XLNX_OK)
+        {
+            delete pRegistration;
+        }
+    }
+
+    return retval;
+}
+
+
+
+
+
+uint32_t SocketReactor::RemoveSocket(SOCKET sock)
+{
+    uint32_t retval = XLNX_OK;
+    Registration* pRegistration = nullptr;
+    Worker* pWorker;
+    std::map<SOCKET, Registration*>::iterator it;
+
+    {
+        std::lock_guard<std::mutex> lock(m_registrationMutex);
+
+        it = m_registrations.find(sock);
+
+        if (it == m_registrations.end())
+        {
+            retval = XLNX_SOCKET_ERROR_SOCKET_NOT_FOUND;
+        }
+        else
+        {
+            pRegistration = it->second;
+            m_registrations.erase(it);
+        }
+    }
+
+
+    if (retval == XLNX_OK)
+    {
+        if (m_bRunning == false)
+        {
+            delete pRegistration;
+        }
+        else
+        {
+            pWorker = &m_workers[pRegistration->workerIndex];
+
+            epoll_ctl(pWorker->epollFd, EPOLL_CTL_DEL, sock, nullptr);
+
+            {
+                //waits for the callback to finish if it is running on another thread
+                std::lock_guard<std::recursive_mutex> lock(pRegistration->mutex);
+                pRegistration->bRemoved = true;
+            }
+
+            std::lock_guard<std::mutex> lock(pWorker->deferredMutex);
+            pWorker->deferred.push_back(pRegistration);
+        }
+    }
+
+    return retval;
+}
+
+
+
+
+
+void SocketReactor::FreeDeferred(Worker* pWorker)
+{
+    std::lock_guard<std::mutex> lock(pWorker->deferredMutex);
+
+    for (size_t i = 0; i < pWorker->deferred.size(); i++)
+    {
+        delete pWorker->deferred[i];
+    }
+
+    pWorker->deferred.clear();
+}
+
+
+
+
+
+void SocketReactor::ThreadFunc(uint32_t workerIndex)
+{
+    Worker* pWorker = &m_workers[workerIndex];
+    struct epoll_event events[MAX_EVENTS_PER_WAIT];
+    Registration* pRegistration;
+    int numEvents;
+    int i;
+
+    while (m_bRunning)
+    {
+        //nothing from the previous wait is referenced any more, so removed registrations can go
+        FreeDeferred(pWorker);
+
+        numEvents = epoll_wait(pWorker->epollFd, events, MAX_EVENTS_PER_WAIT, -1);
+
+        if ((numEvents < 0) && (errno != EINTR))
+        {
+            printf("[ERROR] epoll_wait failed, errno = %u\n", errno);
+            break; //out of loop
+        }
+
+        for (i = 0; i < numEvents; i++)
+        {
+            pRegistration = (Registration*)events[i].data.ptr;
+
+            if (pRegistration == nullptr)
+            {
+                continue; //stop event - loop condition takes care of it
+            }
+
+            std::lock_guard<std::recursive_mutex> lock(pRegistration->mutex);
+
+            if (pRegistration->bRemoved == false)
+            {
+                (*pRegistration->callback)(pRegistration->pDataObject, pRegistration->sock, events[i].events);
+            }
+        }
+    }
+}
@@ -0,0 +1,121 @@
+/*
+ * Copyright 2021 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef XLNX_SOCKET_REACTOR_H
+#define XLNX_SOCKET_REACTOR_H
+
+#include <stdint.h>
+
+#include <atomic>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "xlnx_socket.h"
+#include "xlnx_socket_error_codes.h"
+
+namespace XLNX
+{
+
+
+//Services any number of non-blocking sockets on a fixed set of threads using epoll (Linux only).
+//
+//Each thread has its own epoll instance and every socket is assigned to exactly one of them when it
+//is added, so a given socket's callback is never called on two threads at once and needs no locking
+//of its own.  Sockets are spread over the threads round robin.
+class SocketReactor
+{
+
+public:
+    SocketReactor();
+    virtual ~SocketReactor();
+
+public:
+    static const uint32_t DEFAULT_NUM_THREADS = 2;
+    static const uint32_t MAX_NUM_THREADS = 16;
+
+    uint32_t Start(uint32_t numThreads = DEFAULT_NUM_THREADS);
+    uint32_t Stop(void);
+    uint32_t IsRunning(bool* pbIsRunning);
+    uint32_t GetNumThreads(uint32_t* pNumThreads);
+
+
+public:
+    //events is the EPOLLIN/EPOLLOUT mask that fired.  Sockets are level triggered, so a callback only
+    //needs to do one batch of work per call - it will be called again if there is more to do.
+    typedef void (*EventCallbackType)(void* pDataObject, SOCKET sock, uint32_t events);
+
+    uint32_t AddSocket(SOCKET sock, uint32_t events, EventCallbackType callback, void* pDataObject);
+
+    //Once this returns the socket's callback is not running and will not be called again, so the
+    //socket can be closed.  May be called from any thread, including from the socket's own callback.
+    uint32_t RemoveSocket(SOCKET sock);
+
+
+protected:
+    static const uint32_t MAX_EVENTS_PER_WAIT = 64;
+
+    typedef struct
+    {
+        SOCKET sock;
+        EventCallbackType callback;
+        void* pDataObject;
+        uint32_t workerIndex;
+        bool bRemoved;
+
+        //held while the callback runs - recursive so the callback can remove its own socket
+        std::recursive_mutex mutex;
+
+    }Registration;
+
+
+    typedef struct
+    {
+        int epollFd;
+        std::thread thread;
+
+        //registrations removed while this worker may still hold a pointer to them from epoll_wait -
+        //freed by the worker itself before its next wait
+        std::mutex deferredMutex;
+        std::vector<Registration*> deferred;
+
+    }Worker;
+
+
+    void ThreadFunc(uint32_t workerIndex);
+    void FreeDeferred(Worker* pWorker);
+
+
+protected:
+    std::atomic<bool> m_bRunning;
+    uint32_t m_numThreads;
+    std::atomic<uint32_t> m_nextWorkerIndex;
+
+    int m_stopEventFd;
+    Worker m_workers[MAX_NUM_THREADS];
+
+    std::mutex m_registrationMutex;
+    std::map<SOCKET, Registration*> m_registrations;
+};
+
+
+
+} //end namespace XLNX
+
+
+#endif //XLNX_SOCKET_REACTOR_H
@@ -15,12 +15,13 @@
  */
 
 
-
 #include <stdio.h>
 #include <stdlib.h>
 #include <errno.h>
 #include <string.h>
 
+#include <sys/epoll.h>
+
 #include <thread>
 
 
@@ -41,10 +42,22 @@ TCPServer::TCPServer()
 
     m_listenSocket = INVALID_SOCKET;
 
-    m_bRunningAsThread = false;
-
     m_callback = nullptr;
 
+    m_dataObjectCallback = nullptr;
+    m_pCallbackDataObject = nullptr;
+
+    m_receiveCallback = nullptr;
+    m_pReceiveCallbackDataObject = nullptr;
+
+    m_responseCallback = nullptr;
+    m_pResponseCallbackDataObject = nullptr;
+
+    m_bEventDriven = false;
+
+    m_numConnectionThreads = 0;
+
+    m_pReactor = &m_ownReactor;
 }
 
 
@@ -65,45 +78,100 @@ TCPServer::~TCPServer()
 
 
 void TCPServer::Start(uint16_t listeningPort, ConnectionEstablishedCallbackType callback)
+{
+    StartAsThread(listeningPort, callback);
+
+    std::unique_lock<std::mutex> lock(m_stopMutex);
+
+    m_stopCondition.wait(lock, [this] { return (m_bRunning == false); });
+}
+
+
+
+
+bool TCPServer::StartAsThread(uint16_t listeningPort, ConnectionEstablishedCallbackType callback)
+{
+    if (!m_bRunning)
+    {
+        m_callback = callback;
+        m_bEventDriven = (m_receiveCallback != nullptr) || (m_responseCallback != nullptr);
+
+        if (Listen(listeningPort))
+        {
+            m_bRunning = true;
+        }
+        else
+        {
+            m_callback = nullptr;
+        }
+    }
+
+    return m_bRunning;
+}
+
+
+
+
+bool TCPServer::IsRunning(void)
+{
+    return m_bRunning;
+}
+
+
+
+
+bool TCPServer::Listen(uint16_t listeningPort)
 {
     struct sockaddr_in serv_addr;
     int retval = 0;
     bool bOKToContinue = true;
+    uint32_t numThreads = 0;
 
-    SOCKET connectionSocket;
 
 
 
+    printf("Starting server...listening on port %u\n", listeningPort);
 
-    if (!m_bRunning)
+
+
+    retval = sockInit();
+    if (retval != 0)
     {
-        m_callback = callback;
+        printf("[ERROR] Failed to initialise socket library\n");
+        bOKToContinue = false;
+    }
 
-        printf("Starting server...listening on port %u\n", listeningPort);
-        m_bRunning = true;
 
 
 
-        retval = sockInit();
-        if (retval != 0)
+
+    if (bOKToContinue)
+    {
+        m_listenSocket = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+        if (m_listenSocket == INVALID_SOCKET)
         {
-            printf("[ERROR] Failed to initialise socket library\n");
+            printf("[ERROR] Failed to create listening socket\n");
             bOKToContinue = false;
         }
+    }
+
+
 
 
 
 
 
-        if (bOKToContinue)
+
+    if (bOKToContinue)
+    {
+        int enable = 1;
+        retval = setsockopt(m_listenSocket, SOL_SOCKET, SO_REUSEADDR, (const char*)&enable, sizeof(int));
+        if (retval != 0)
         {
-            m_listenSocket = socket(AF_INET, SOCK_STREAM, 0);
-            if (m_listenSocket == INVALID_SOCKET)
-            {
-                printf("[ERROR] Failed to create listening socket\n");
-                bOKToContinue = false;
-            }
+            printf("[ERROR] Failed to set SO_REUSEADDR socket option, errno = %u\n", errno);
+            bOKToContinue = false;
         }
+    }
 
 
 
@@ -112,81 +180,96 @@ void TCPServer::Start(uint16_t listeningPort, ConnectionEstablishedCallbackType
 
 
 
-        if (bOKToContinue)
+    if (bOKToContinue)
+    {
+        memset(&serv_addr, '0', sizeof(serv_addr));
+        serv_addr.sin_family = AF_INET;
+        serv_addr.sin_addr.s_addr = htonl(INADDR_ANY);
+        serv_addr.sin_port = htons(listeningPort);
+
+        retval = bind(m_listenSocket, (struct sockaddr*) & serv_addr, sizeof(serv_addr));
+        if (retval != 0)
         {
-            int enable = 1;
-            retval = setsockopt(m_listenSocket, SOL_SOCKET, SO_REUSEADDR, (const char*)&enable, sizeof(int));
-            if (retval != 0)
-            {
-                printf("[ERROR] Failed to set SO_REUSEADDR socket option, errno = %u\n", errno);
-                bOKToContinue = false;
-            }
+            printf("[ERROR] Socket bind call failed, errno = %u\n", errno);
+            bOKToContinue = false;
         }
+    }
 
 
 
 
+    if (bOKToContinue)
+    {
+        retval = listen(m_listenSocket, MAX_CONNECTIONS);
+        if (retval != 0)
+        {
+            printf("[ERROR] Socket listen call failed, errno = %u\n", errno);
+            bOKToContinue = false;
+        }
+    }
 
 
 
 
-        if (bOKToContinue)
+    if (bOKToContinue && (m_pReactor == &m_ownReactor))
+    {
+        if (m_ownReactor.Start() != XLNX_OK)
         {
-            memset(&serv_addr, '0', sizeof(serv_addr));
-            serv_addr.sin_family = AF_INET;
-            serv_addr.sin_addr.s_addr = htonl(INADDR_ANY);
-            serv_addr.sin_port = htons(listeningPort);
-
-            retval = bind(m_listenSocket, (struct sockaddr*) & serv_addr, sizeof(serv_addr));
-            if (retval != 0)
-            {
-                printf("[ERROR] Socket bind call failed, errno = %u\n", errno);
-                bOKToContinue = false;
-            }
+            printf("[ERROR] Failed to start socket reactor\n");
+            bOKToContinue = false;
         }
+    }
+
 
 
 
+    if (bOKToContinue && (m_receiveCallback != nullptr))
+    {
+        //a reactor thread only ever handles one socket at a time, so one receive buffer per thread is enough
+        m_pReactor->GetNumThreads(&numThreads);
 
-        if (bOKToContinue)
+        if (m_bufferPool.Initialise(numThreads, RECEIVE_BUFFER_SIZE) != XLNX_OK)
         {
-            retval = listen(m_listenSocket, MAX_CONNECTIONS);
-            if (retval != 0)
-            {
-                printf("[ERROR] Socket listen call failed, errno = %u\n", errno);
-                bOKToContinue = false;
-            }
+            printf("[ERROR] Failed to allocate receive buffers\n");
+            bOKToContinue = false;
         }
+    }
 
 
 
-        if (bOKToContinue)
-        {
-            while (m_bRunning)
-            {
-                connectionSocket = accept(m_listenSocket, (struct sockaddr*)NULL, NULL);
 
-                if (connectionSocket != INVALID_SOCKET)
-                {
-                    std::thread t = std::thread(&TCPServer::InternalConnectionEstablishedCallback, this, connectionSocket);
-                    t.detach();
-                }
-            }
+    if (bOKToContinue)
+    {
+        if (m_pReactor->AddSocket(m_listenSocket, EPOLLIN, ListenSocketCallback, this) != XLNX_OK)
+        {
+            printf("[ERROR] Failed to add listening socket to reactor\n");
+            bOKToContinue = false;
         }
     }
-}
 
 
 
 
-void TCPServer::StartAsThread(uint16_t listeningPort, ConnectionEstablishedCallbackType callback)
-{
-    if (!m_bRunning)
+    if (bOKToContinue == false)
     {
-        m_thread = std::thread(&TCPServer::Start, this, listeningPort, callback);
-        m_bRunningAsThread = true;
+        if (m_listenSocket != INVALID_SOCKET)
+        {
+            sockClose(m_listenSocket);
+            m_listenSocket = INVALID_SOCKET;
+        }
+
+        if (m_pReactor == &m_ownReactor)
+        {
+            m_ownReactor.Stop();
+        }
+
+        m_bufferPool.Uninitialise();
+
+        sockQuit();
     }
 
+
+    return bOKToContinue;
 }
 
 
@@ -196,34 +279,231 @@ void TCPServer::StartAsThread(uint16_t listeningPort, ConnectionEstablishedCallb
 
 void TCPServer::Stop(void)
 {
+    std::set<SOCKET> connections;
+
     if (m_bRunning)
     {
         printf("Stopping Server...\n");
         m_bRunning = false;
 
+        //no new connections once this returns...
         if (m_listenSocket != INVALID_SOCKET)
         {
+            m_pReactor->RemoveSocket(m_listenSocket);
+
             sockClose(m_listenSocket);
             m_listenSocket = INVALID_SOCKET;
         }
 
 
-        sockQuit();
+        //...then drop the ones we have.
+        if (m_bEventDriven)
+        {
+            {
+                std::lock_guard<std::mutex> lock(m_connectionMutex);
+                connections = m_connections;
+            }
+
+            for (std::set<SOCKET>::iterator it = connections.begin(); it != connections.end(); ++it)
+            {
+                CloseConnection(*it, true);
+            }
+        }
+        else
+        {
+            //connection threads close their own sockets - shutting them down unblocks any callback that
+            //is stuck waiting on its client, and then we wait for the threads to finish.  Done under the
+            //lock so a socket can't be closed (and its descriptor reused) while we are shutting it down.
+            std::unique_lock<std::mutex> lock(m_connectionMutex);
+
+            for (std::set<SOCKET>::iterator it = m_connections.begin(); it != m_connections.end(); ++it)
+            {
+                shutdown(*it, SHUT_RDWR);
+            }
 
+            m_connectionThreadsCondition.wait(lock, [this] { return (m_numConnectionThreads == 0); });
+        }
 
-        if (m_bRunningAsThread)
+
+        if (m_pReactor == &m_ownReactor)
         {
-            m_thread.join();
-            m_bRunningAsThread = false;
+            m_ownReactor.Stop();
         }
 
+        m_bufferPool.Uninitialise();
+
+
+        sockQuit();
+
 
         m_callback = nullptr;
+
+
+        {
+            std::lock_guard<std::mutex> lock(m_stopMutex);
+        }
+
+        m_stopCondition.notify_all();
+    }
+
+
+
+
+}
+
+
+
+
+
+void TCPServer::SetConnectionCallback(DataObjectConnectionCallbackType callback, void* pDataObject)
+{
+    m_dataObjectCallback = callback;
+    m_pCallbackDataObject = pDataObject;
+}
+
+
+
+
+
+void TCPServer::SetReceiveCallback(DataObjectReceiveCallbackType callback, void* pDataObject)
+{
+    m_receiveCallback = callback;
+    m_pReceiveCallbackDataObject = pDataObject;
+}
+
+
+
+
+
+void TCPServer::SetResponseCallback(DataObjectResponseCallbackType callback, void* pDataObject)
+{
+    m_responseCallback = callback;
+    m_pResponseCallbackDataObject = pDataObject;
+}
+
+
+
+
+
+void TCPServer::SetReactor(SocketReactor* pReactor)
+{
+    if (!m_bRunning)
+    {
+        m_pReactor = (pReactor != nullptr) ? pReactor : &m_ownReactor;
+    }
+}
+
+
+
+
+
+void TCPServer::ListenSocketCallback(void* pDataObject, SOCKET sock, uint32_t events)
+{
+    TCPServer* pServer = (TCPServer*)pDataObject;
+
+    (void)sock;
+    (void)events;
+
+    pServer->AcceptConnections();
+}
+
+
+
+
+
+void TCPServer::AcceptConnections(void)
+{
+    SOCKET connectionSocket;
+    int flags;
+
+    //connections for the event driven callback are serviced on the reactor as they become readable, while
+    //the connection callbacks block on their socket and so each get a thread of their own
+    if (m_bEventDriven)
+    {
+        flags = SOCK_NONBLOCK | SOCK_CLOEXEC;
+    }
+    else
+    {
+        flags = SOCK_CLOEXEC;
+    }
+
+
+    while (m_bRunning)
+    {
+        connectionSocket = accept4(m_listenSocket, (struct sockaddr*)NULL, NULL, flags);
+
+        if (connectionSocket == INVALID_SOCKET)
+        {
+            break; //out of loop - nothing more waiting (or listening socket being closed)
+        }
+
+
+        {
+            std::lock_guard<std::mutex> lock(m_connectionMutex);
+            m_connections.insert(connectionSocket);
+
+            if (m_bEventDriven == false)
+            {
+                m_numConnectionThreads++;
+            }
+        }
+
+        if (m_bEventDriven && (m_responseCallback != nullptr))
+        {
+            StartResponse(connectionSocket);
+        }
+        else if (m_bEventDriven)
+        {
+            if (m_pReactor->AddSocket(connectionSocket, EPOLLIN, ConnectionSocketCallback, this) != XLNX_OK)
+            {
+                CloseConnection(connectionSocket, false);
+            }
+        }
+        else
+        {
+            std::thread(&TCPServer::ConnectionThread, this, connectionSocket).detach();
+        }
+    }
+}
+
+
+
+
+
+void TCPServer::ConnectionSocketCallback(void* pDataObject, SOCKET sock, uint32_t events)
+{
+    TCPServer* pServer = (TCPServer*)pDataObject;
+
+    (void)events;
+
+    if (pServer->m_responseCallback != nullptr)
+    {
+        //only registered for EPOLLOUT - errors and hangups also land here, and show up as the send failing
+        if (pServer->SendResponse(sock))
+        {
+            pServer->CloseConnection(sock, false);
+        }
     }
+    else
+    {
+        pServer->InternalReceive(sock);
+    }
+}
 
 
 
 
+
+void TCPServer::ConnectionThread(SOCKET sock)
+{
+    InternalConnectionEstablishedCallback(sock);
+
+
+    //let Stop() know we are done with the server
+    std::lock_guard<std::mutex> lock(m_connectionMutex);
+
+    m_numConnectionThreads--;
+    m_connectionThreadsCondition.notify_all();
 }
 
 
@@ -236,14 +516,168 @@ void TCPServer::InternalConnectionEstablishedCallback(SOCKET sock)
     {
         (*m_callback)(sock);
     }
+    else if (m_dataObjectCallback != nullptr)
+    {
+        (*m_dataObjectCallback)(m_pCallbackDataObject, sock);
+    }
 
 
     //once this callback returns, we will assume the user has finished with the socket
     //so we can close it...
-    sockClose(sock);
+    CloseConnection(sock, false);
 
 }
 
 
 
 
+
+void TCPServer::InternalReceive(SOCKET sock)
+{
+    uint8_t* pBuffer;
+    ssize_t numBytesReceived;
+    bool bClose = false;
+
+    if (m_bufferPool.Acquire(&pBuffer) == XLNX_OK)
+    {
+        numBytesReceived = recv(sock, pBuffer, RECEIVE_BUFFER_SIZE, 0);
+
+        if (numBytesReceived > 0)
+        {
+            (*m_receiveCallback)(m_pReceiveCallbackDataObject, sock, pBuffer, (uint32_t)numBytesReceived);
+        }
+        else if ((numBytesReceived == 0) || ((errno != EAGAIN) && (errno != EWOULDBLOCK) && (errno != EINTR)))
+        {
+            bClose = true; //client has gone away
+        }
+
+        m_bufferPool.Release(pBuffer);
+    }
+
+    if (bClose)
+    {
+        CloseConnection(sock, false);
+    }
+}
+
+
+
+
+
+void TCPServer::StartResponse(SOCKET sock)
+{
+    std::string response;
+
+    (*m_responseCallback)(m_pResponseCallbackDataObject, &response);
+
+    {
+        std::lock_guard<std::mutex> lock(m_connectionMutex);
+
+        PendingResponse& pending = m_pendingResponses[sock];
+        pending.data.swap(response);
+        pending.offset = 0;
+    }
+
+
+    //most responses fit in the socket's send buffer and go straight away.  Anything left over is sent from
+    //the reactor as the client drains it, rather than holding up the thread that accepts connections.
+    if (SendResponse(sock))
+    {
+        CloseConnection(sock, false);
+    }
+    else if (m_pReactor->AddSocket(sock, EPOLLOUT, ConnectionSocketCallback, this) != XLNX_OK)
+    {
+        CloseConnection(sock, false);
+    }
+}
+
+
+
+
+
+//returns true once there is nothing more to send - either it has all gone or the client has
+bool TCPServer::SendResponse(SOCKET sock)
+{
+    std::map<SOCKET, PendingResponse>::iterator it;
+    ssize_t numBytesSent;
+    bool bFinished = false;
+
+    std::lock_guard<std::mutex> lock(m_connectionMutex);
+
+    it = m_pendingResponses.find(sock);
+
+    if (it == m_pendingResponses.end())
+    {
+        bFinished = true;
+    }
+
+
+    while (bFinished == false)
+    {
+        PendingResponse& pending = it->second;
+
+        if (pending.offset >= pending.data.size())
+        {
+            bFinished = true;
+            break; //out of loop - all sent
+        }
+
+        numBytesSent = send(sock, pending.data.data() + pending.offset, pending.data.size() - pending.offset, MSG_NOSIGNAL | MSG_DONTWAIT);
+
+        if (numBytesSent > 0)
+        {
+            pending.offset += (size_t)numBytesSent;
+        }
+        else if ((numBytesSent < 0) && ((errno == EAGAIN) || (errno == EWOULDBLOCK)))
+        {
+            break; //out of loop - socket buffer is full, carry on when it is writable
+        }
+        else if ((numBytesSent < 0) && (errno == EINTR))
+        {
+            continue;
+        }
+        else
+        {
+            bFinished = true; //client has gone away
+        }
+    }
+
+
+    if (bFinished && (it != m_pendingResponses.end()))
+    {
+        m_pendingResponses.erase(it);
+    }
+
+    return bFinished;
+}
+
+
+
+
+
+void TCPServer::CloseConnection(SOCKET sock, bool bShutdownFirst)
+{
+    size_t numErased;
+
+    {
+        std::lock_guard<std::mutex> lock(m_connectionMutex);
+        numErased = m_connections.erase(sock);
+        m_pendingResponses.erase(sock);
+    }
+
+
+    if (numErased > 0)
+    {
+        if (bShutdownFirst)
+        {
+            shutdown(sock, SHUT_RDWR);
+        }
+
+        if (m_bEventDriven)
+        {
+            m_pReactor->RemoveSocket(sock);
+        }
+
+        sockClose(sock);
+    }
+}
@@ -22,13 +22,24 @@
 
 
 #include <stdint.h>
-#include <thread>
+
+#include <atomic>
+#include <condition_variable>
+#include <map>
+#include <mutex>
+#include <set>
+#include <string>
 
 #include "xlnx_socket.h"
+#include "xlnx_socket_reactor.h"
+#include "xlnx_buffer_pool.h"
 
 namespace XLNX
 {
 
+//With a receive or response callback, accepted connections are serviced by a SocketReactor, so the number
+//of threads involved is fixed no matter how many clients connect.  The older connection callbacks block on
+//their socket, so each of those connections still gets a thread of its own.
 class TCPServer
 {
 
@@ -40,26 +51,108 @@ public:
 
     typedef void (*ConnectionEstablishedCallbackType)(SOCKET sock);
 
+    //Start() blocks until Stop() is called from elsewhere.  StartAsThread() returns once the server is
+    //listening, or straight away with false if the port could not be bound or listened on.
     void Start(uint16_t listeningPort, ConnectionEstablishedCallbackType callback);
-    void StartAsThread(uint16_t listeningPort, ConnectionEstablishedCallbackType callback);
+    bool StartAsThread(uint16_t listeningPort, ConnectionEstablishedCallbackType callback);
     void Stop(void);
+    bool IsRunning(void);
+
+
+public:
+    //Alternative to the callback passed to Start()/StartAsThread() for callers that need their own object
+    //back when a connection arrives.  Used when no callback is passed to Start()/StartAsThread().
+    //
+    //Connection callbacks run to completion on their own thread (on a blocking socket) and the connection is
+    //closed when they return.  Stop() shuts the socket down and waits for any callbacks still running.
+    typedef void (*DataObjectConnectionCallbackType)(void* pDataObject, SOCKET sock);
+    void SetConnectionCallback(DataObjectConnectionCallbackType callback, void* pDataObject);
+
+
+public:
+    //Event driven alternative to the connection callbacks, and used in preference to them when set.  The
+    //connection stays open and the callback is called whenever data arrives on it, with a pooled buffer that
+    //is only valid for the duration of the call.  Replies can be sent on sock, which is non-blocking.  The
+    //connection is closed when the client closes it.
+    typedef void (*DataObjectReceiveCallbackType)(void* pDataObject, SOCKET sock, uint8_t* pBuffer, uint32_t dataLength);
+    void SetReceiveCallback(DataObjectReceiveCallbackType callback, void* pDataObject);
 
 
 public:
-    static const uint32_t MAX_CONNECTIONS = 10;
+    //Event driven server for endpoints that answer every connection the same way without reading a request.
+    //The callback is called on the reactor thread when a connection is accepted and must not block - it just
+    //fills in pResponse.  The server sends it without blocking, carries on when the socket is writable again
+    //if the client is slow to take it all, and closes the connection once it has gone.  Used in preference
+    //to the receive callback if both are set.
+    typedef void (*DataObjectResponseCallbackType)(void* pDataObject, std::string* pResponse);
+    void SetResponseCallback(DataObjectResponseCallbackType callback, void* pDataObject);
+
+
+public:
+    //By default each server runs its own reactor.  Servers can instead share one that the caller has already
+    //started, so that all of a process's sockets are handled on the same fixed set of threads.
+    //Must be called before the server is started.
+    void SetReactor(SocketReactor* pReactor);
+
+
+public:
+    static const uint32_t MAX_CONNECTIONS = 10;             //listen backlog
+    static const uint32_t RECEIVE_BUFFER_SIZE = 4096;
 
 protected:
+    bool Listen(uint16_t listeningPort);
+
+    static void ListenSocketCallback(void* pDataObject, SOCKET sock, uint32_t events);
+    static void ConnectionSocketCallback(void* pDataObject, SOCKET sock, uint32_t events);
+
+    void AcceptConnections(void);
+    void ConnectionThread(SOCKET sock);
     void InternalConnectionEstablishedCallback(SOCKET sock);
+    void InternalReceive(SOCKET sock);
+    void StartResponse(SOCKET sock);
+    bool SendResponse(SOCKET sock);
+    void CloseConnection(SOCKET sock, bool bShutdownFirst);
 
 protected:
 
-    bool m_bRunning;
+    std::atomic<bool> m_bRunning;
     SOCKET m_listenSocket;
 
     ConnectionEstablishedCallbackType m_callback;
 
-    std::thread m_thread;
-    bool m_bRunningAsThread;
+    DataObjectConnectionCallbackType m_dataObjectCallback;
+    void* m_pCallbackDataObject;
+
+    DataObjectReceiveCallbackType m_receiveCallback;
+    void* m_pReceiveCallbackDataObject;
+
+    DataObjectResponseCallbackType m_responseCallback;
+    void* m_pResponseCallbackDataObject;
+
+    bool m_bEventDriven;
+
+    SocketReactor m_ownReactor;
+    SocketReactor* m_pReactor;
+
+    BufferPool m_bufferPool;
+
+    //open connections - whoever takes a socket out of here is the one that closes it
+    std::mutex m_connectionMutex;
+    std::set<SOCKET> m_connections;
+
+    typedef struct
+    {
+        std::string data;
+        size_t offset;          //bytes already sent
+
+    }PendingResponse;
+
+    std::map<SOCKET, PendingResponse> m_pendingResponses;  //response callback connections still being sent to
+    uint32_t m_numConnectionThreads;
+    std::condition_variable m_connectionThreadsCondition;
+
+    std::mutex m_stopMutex;
+    std::condition_variable m_stopCondition;
 
 
 };
@@ -76,5 +169,3 @@ protected:
 
 
 #endif //XLNX_TCP_SERVER_H
-
-
@@ -17,6 +17,10 @@
 
 #include <stdio.h>
 #include <string.h>
+#include <ctype.h>
+#include <errno.h>
+
+#include <sys/epoll.h>
 
 #include "xlnx_socket.h"
 #include "xlnx_udp_server.h"
@@ -28,10 +32,14 @@ UDPServer::UDPServer()
 	m_socket = INVALID_SOCKET;
 	m_bRunning = false;
 	m_packetIndex = 0;
-	m_bRunningAsThread = false;
 	
 	m_receiveCallback = nullptr;
 	m_pReceiveCallbackDataObject = nullptr;
+
+	m_pReactor = &m_ownReactor;
+
+	m_numBatches = 0;
+	m_numTruncatedPackets = 0;
 }
 
 
@@ -47,102 +55,136 @@ UDPServer::~UDPServer()
 
 
 void UDPServer::Start(uint16_t listeningPort)
+{
+	StartAsThread(listeningPort);
+
+	std::unique_lock<std::mutex> lock(m_stopMutex);
+
+	m_stopCondition.wait(lock, [this] { return (m_bRunning == false); });
+}
+
+
+void UDPServer::StartAsThread(uint16_t listeningPort)
+{
+	if (!m_bRunning)
+	{
+		if (Open(listeningPort))
+		{
+			m_bRunning = true;
+		}
+	}
+
+}
+
+
+bool UDPServer::IsRunning(void)
+{
+	return m_bRunning;
+}
+
+
+
+
+bool UDPServer::Open(uint16_t listeningPort)
 {
 	bool bOKToContinue = true;
 	int retval = 0;
 	struct sockaddr_in serverAddr;
-	struct sockaddr_in clientAddr;
-	socklen_t clientAddrLength;
+	uint32_t i;
 
-	clientAddrLength = sizeof(clientAddr);
 
+	retval = sockInit();
+	if (retval != 0)
+	{
+		printf("[ERROR] Failed to initialise socket library\n");
+		bOKToContinue = false;
+	}
 
 
-	if (m_bRunning == false)
+	if (bOKToContinue)
 	{
-		retval = sockInit();
-		if (retval != 0)
+		m_socket = socket(AF_INET, SOCK_DGRAM | SOCK_NONBLOCK | SOCK_CLOEXEC, IPPROTO_UDP);
+		if (m_socket == INVALID_SOCKET)
 		{
-			printf("[ERROR] Failed to initialise socket library\n");
+			printf("[ERROR] Failed to create socket\n");
 			bOKToContinue = false;
 		}
+	}
 
 
-		if (bOKToContinue)
+	if (bOKToContinue)
+	{
+		memset(&serverAddr, '0', sizeof(serverAddr));
+		serverAddr.sin_family = AF_INET;
+		serverAddr.sin_addr.s_addr = htonl(INADDR_ANY);
+		serverAddr.sin_port = htons(listeningPort);
+
+		retval = bind(m_socket, (struct sockaddr*) &serverAddr, sizeof(serverAddr));
+		if (retval != 0)
 		{
-			m_socket = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
-			if (m_socket == INVALID_SOCKET)
-			{
-				printf("[ERROR] Failed to create socket\n");
-				bOKToContinue = false;
-			}
+			printf("[ERROR] Socket bind call failed, errno = %u\n", errno);
+			bOKToContinue = false;
 		}
+	}
 
 
-		if (bOKToContinue)
+	if (bOKToContinue)
+	{
+		//the message headers always point at the same buffers, only the lengths/flags change per call
+		memset(m_recvMessages, 0, sizeof(m_recvMessages));
+
+		for (i = 0; i < RECEIVE_BATCH_SIZE; i++)
 		{
-			memset(&serverAddr, '0', sizeof(serverAddr));
-			serverAddr.sin_family = AF_INET;
-			serverAddr.sin_addr.s_addr = htonl(INADDR_ANY);
-			serverAddr.sin_port = htons(listeningPort);
+			m_recvIOVecs[i].iov_base = m_recvBuffers[i];
+			m_recvIOVecs[i].iov_len = MAX_RECEIVE_LENGTH;
 
-			retval = bind(m_socket, (struct sockaddr*) &serverAddr, sizeof(serverAddr));
-			if (retval != 0)
-			{
-				printf("[ERROR] Socket bind call failed, errno = %u\n", errno);
-				bOKToContinue = false;
-			}
+			m_recvMessages[i].msg_hdr.msg_iov = &m_recvIOVecs[i];
+			m_recvMessages[i].msg_hdr.msg_iovlen = 1;
 		}
+	}
 
 
-
-
-		if (bOKToContinue)
+	if (bOKToContinue && (m_pReactor == &m_ownReactor))
+	{
+		if (m_ownReactor.Start(1) != XLNX_OK)
 		{
-			m_bRunning = true;
-			printf("Starting server...listening on port %u\n", listeningPort);
-
-			while (m_bRunning)
-			{
-				//try to receive some data, this is a blocking call
-				retval = recvfrom(m_socket, (char*)m_recvBuffer, MAX_RECEIVE_LENGTH, 0, (struct sockaddr*) &clientAddr, &clientAddrLength);
-				if(retval > 0)
-				{
-					if (m_receiveCallback != nullptr)
-					{
-						(*m_receiveCallback)(m_pReceiveCallbackDataObject, m_recvBuffer, retval);
-					}
-					else
-					{
-						HexDumpPacket(m_packetIndex, m_recvBuffer, retval);
-						
-					}
-
-					m_packetIndex++;
-					
-				}
-				else
-				{
-					printf("[ERROR] Receive Error: 0x%08X\n", retval);
-				}
+			printf("[ERROR] Failed to start socket reactor\n");
+			bOKToContinue = false;
+		}
+	}
 
-			}
 
+	if (bOKToContinue)
+	{
+		if (m_pReactor->AddSocket(m_socket, EPOLLIN, SocketCallback, this) != XLNX_OK)
+		{
+			printf("[ERROR] Failed to add socket to reactor\n");
+			bOKToContinue = false;
 		}
-
 	}
 
-}
-
 
-void UDPServer::StartAsThread(uint16_t listeningPort)
-{
-	if (!m_bRunning)
+	if (bOKToContinue)
 	{
-		m_thread = std::thread(&UDPServer::Start, this, listeningPort);
-		m_bRunningAsThread = true;
+		printf("Starting server...listening on port %u\n", listeningPort);
 	}
+	else
+	{
+		if (m_socket != INVALID_SOCKET)
+		{
+			sockClose(m_socket);
+			m_socket = INVALID_SOCKET;
+		}
 
+		if (m_pReactor == &m_ownReactor)
+		{
+			m_ownReactor.Stop();
+		}
+
+		sockQuit();
+	}
+
+	return bOKToContinue;
 }
 
 
@@ -159,25 +201,120 @@ void UDPServer::Stop(void)
 
 		if (m_socket != INVALID_SOCKET)
 		{
+			m_pReactor->RemoveSocket(m_socket);
+
 			sockClose(m_socket);
 			m_socket = INVALID_SOCKET;
 		}
 
+		if (m_pReactor == &m_ownReactor)
+		{
+			m_ownReactor.Stop();
+		}
+
 
 		sockQuit();
 
-		if (m_bRunningAsThread)
+
 		{
-			m_thread.join();
-			m_bRunningAsThread = false;
+			std::lock_guard<std::mutex> lock(m_stopMutex);
 		}
 
+		m_stopCondition.notify_all();
+	}
+}
+
+
+
+
+void UDPServer::SetReactor(SocketReactor* pReactor)
+{
+	if (!m_bRunning)
+	{
+		m_pReactor = (pReactor != nullptr) ? pReactor : &m_ownReactor;
 	}
 }
 
 
 
 
+void UDPServer::SocketCallback(void* pDataObject, SOCKET sock, uint32_t events)
+{
+	UDPServer* pServer = (UDPServer*)pDataObject;
+
+	(void)sock;
+	(void)events;
+
+	pServer->ReceiveBatches();
+}
+
+
+
+
+void UDPServer::ReceiveBatches(void)
+{
+	int numMessages;
+	uint32_t dataLength;
+	uint32_t batch;
+	int i;
+
+	for (batch = 0; batch < MAX_BATCHES_PER_EVENT; batch++)
+	{
+		numMessages = recvmmsg(m_socket, m_recvMessages, RECEIVE_BATCH_SIZE, MSG_DONTWAIT, nullptr);
+
+		if (numMessages <= 0)
+		{
+			if ((numMessages < 0) && (errno != EAGAIN) && (errno != EWOULDBLOCK) && (errno != EINTR))
+			{
+				printf("[ERROR] Receive Error: errno = %u\n", errno);
+			}
+
+			break; //out of loop - socket drained
+		}
+
+		m_numBatches++;
+
+		for (i = 0; i < numMessages; i++)
+		{
+			dataLength = m_recvMessages[i].msg_len;
+
+			if (m_recvMessages[i].msg_hdr.msg_flags & MSG_TRUNC)
+			{
+				m_numTruncatedPackets++;
+			}
+
+			if (m_receiveCallback != nullptr)
+			{
+				(*m_receiveCallback)(m_pReceiveCallbackDataObject, m_recvBuffers[i], dataLength);
+			}
+			else
+			{
+				HexDumpPacket(m_packetIndex, m_recvBuffers[i], dataLength);
+			}
+
+			m_packetIndex++;
+		}
+
+		if ((uint32_t)numMessages < RECEIVE_BATCH_SIZE)
+		{
+			break; //out of loop - nothing more waiting, save the extra syscall
+		}
+	}
+}
+
+
+
+
+void UDPServer::GetStats(Stats* pStats)
+{
+	pStats->numPackets = m_packetIndex;
+	pStats->numBatches = m_numBatches;
+	pStats->numTruncatedPackets = m_numTruncatedPackets;
+}
+
+
+
+
 
 
 
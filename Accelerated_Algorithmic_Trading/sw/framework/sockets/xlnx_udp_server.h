@@ -20,9 +20,12 @@
 
 #include <stdint.h>
 
-#include <thread>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
 
 #include "xlnx_socket.h"
+#include "xlnx_socket_reactor.h"
 
 namespace XLNX
 {
@@ -37,30 +40,70 @@ public:
 
 
 public:
+	//Start() blocks until Stop() is called from elsewhere.  StartAsThread() returns once the socket is
+	//bound - datagrams are received on the reactor thread either way.
 	void Start(uint16_t listeningPort);
 	void StartAsThread(uint16_t listeningPort);
 	void Stop(void);
+	bool IsRunning(void);
+
+	//By default the server runs its own single threaded reactor, but can share one that the caller has
+	//already started.  Must be called before the server is started.
+	void SetReactor(SocketReactor* pReactor);
 
 
 public:
+    //pBuffer is only valid for the duration of the callback
     typedef void (*ReceiveCallbackType)(void* pDataObject, uint8_t* pBuffer, uint32_t dataLength);
     void SetReceiveCallback(ReceiveCallbackType callback, void* pDataObject);
 
+public:
+	typedef struct
+	{
+		uint64_t numPackets;
+		uint64_t numBatches;			//recvmmsg calls that returned data
+		uint64_t numTruncatedPackets;	//datagrams longer than MAX_RECEIVE_LENGTH
+
+	}Stats;
+
+	void GetStats(Stats* pStats);
+
 public:
 	static void HexDumpPacket(uint32_t packetIndex, uint8_t* pBuffer, uint32_t dataLength);
 
 
+protected:
+	bool Open(uint16_t listeningPort);
+
+	static void SocketCallback(void* pDataObject, SOCKET sock, uint32_t events);
+	void ReceiveBatches(void);
+
+
 protected:
 	SOCKET m_socket;
-	bool m_bRunning;
+	std::atomic<bool> m_bRunning;
+
+	static const uint32_t MAX_RECEIVE_LENGTH = 2048;
 
-	static const uint32_t MAX_RECEIVE_LENGTH = 1024;
-	uint8_t m_recvBuffer[MAX_RECEIVE_LENGTH];
+	//datagrams are pulled off the socket this many at a time with a single recvmmsg call.  The socket is only
+	//ever serviced by one reactor thread, so one set of buffers is all that is needed.
+	static const uint32_t RECEIVE_BATCH_SIZE = 32;
+	static const uint32_t MAX_BATCHES_PER_EVENT = 4;	//bounds the time spent on one socket before the reactor moves on
+
+	uint8_t m_recvBuffers[RECEIVE_BATCH_SIZE][MAX_RECEIVE_LENGTH];
+	struct iovec m_recvIOVecs[RECEIVE_BATCH_SIZE];
+	struct mmsghdr m_recvMessages[RECEIVE_BATCH_SIZE];
 
 	uint32_t m_packetIndex;
 
-	std::thread m_thread;
-	bool m_bRunningAsThread;
+	SocketReactor m_ownReactor;
+	SocketReactor* m_pReactor;
+
+	std::mutex m_stopMutex;
+	std::condition_variable m_stopCondition;
+
+	std::atomic<uint64_t> m_numBatches;
+	std::atomic<uint64_t> m_numTruncatedPackets;
 
 
 protected: